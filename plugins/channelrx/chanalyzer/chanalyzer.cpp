@@ -91,6 +91,11 @@ void ChannelAnalyzer::stop()
 	m_thread.wait();
 }
 
+void ChannelAnalyzer::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool ChannelAnalyzer::handleMessage(const Message& cmd)
 {
     if (MsgConfigureChannelAnalyzer::match(cmd))
@@ -63,6 +63,7 @@ public:
     void stopWork();
     bool isRunning() const { return m_running; }
     void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void setCompactSamples(bool compactSamples) { m_sampleFifo.setCompact(compactSamples); }
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     int getChannelSampleRate() const;
     double getMagSq() { return m_sink.getMagSq(); }
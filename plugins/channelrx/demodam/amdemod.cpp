@@ -110,6 +110,11 @@ void AMDemod::stop()
 	m_thread.wait();
 }
 
+void AMDemod::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool AMDemod::handleMessage(const Message& cmd)
 {
 	if (MsgConfigureAMDemod::match(cmd))
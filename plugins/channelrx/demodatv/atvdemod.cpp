@@ -22,9 +22,13 @@
 #include <stdio.h>
 #include <complex.h>
 
+#include "SWGChannelSettings.h"
+
 #include "dsp/dspengine.h"
+#include "dsp/videoframeencoder.h"
 #include "device/deviceapi.h"
 
+#include "atvdemodwebapiadapter.h"
 #include "atvdemod.h"
 
 MESSAGE_CLASS_DEFINITION(ATVDemod::MsgConfigureATVDemod, Message)
@@ -94,6 +98,11 @@ void ATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
     m_basebandSink->feed(begin, end);
 }
 
+void ATVDemod::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool ATVDemod::handleMessage(const Message& cmd)
 {
     if (MsgConfigureATVDemod::match(cmd))
@@ -148,6 +157,7 @@ void ATVDemod::applySettings(const ATVDemodSettings& settings, bool force)
             << "m_halfFrames:" << settings.m_halfFrames
             << "m_levelSynchroTop:" << settings.m_levelSynchroTop
             << "m_levelBlack:" << settings.m_levelBlack
+            << "m_blockMode:" << settings.m_blockMode
             << "m_rgbColor:" << settings.m_rgbColor
             << "m_title:" << settings.m_title
             << "m_udpAddress:" << settings.m_udpAddress
@@ -159,3 +169,83 @@ void ATVDemod::applySettings(const ATVDemodSettings& settings, bool force)
 
     m_settings = settings;
 }
+
+QByteArray ATVDemod::serialize() const
+{
+    return m_settings.serialize();
+}
+
+bool ATVDemod::deserialize(const QByteArray& data)
+{
+    if (m_settings.deserialize(data))
+    {
+        MsgConfigureATVDemod *msg = MsgConfigureATVDemod::create(m_settings, true);
+        m_inputMessageQueue.push(msg);
+        return true;
+    }
+    else
+    {
+        m_settings.resetToDefaults();
+        MsgConfigureATVDemod *msg = MsgConfigureATVDemod::create(m_settings, true);
+        m_inputMessageQueue.push(msg);
+        return false;
+    }
+}
+
+int ATVDemod::webapiSettingsGet(
+        SWGSDRangel::SWGChannelSettings& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setAtvDemodSettings(new SWGSDRangel::SWGATVDemodSettings());
+    response.getAtvDemodSettings()->init();
+    ATVDemodWebAPIAdapter::webapiFormatChannelSettings(response, m_settings);
+    return 200;
+}
+
+int ATVDemod::webapiSettingsPutPatch(
+        bool force,
+        const QStringList& channelSettingsKeys,
+        SWGSDRangel::SWGChannelSettings& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    ATVDemodSettings settings = m_settings;
+    ATVDemodWebAPIAdapter::webapiUpdateChannelSettings(settings, channelSettingsKeys, response);
+
+    MsgConfigureATVDemod *msg = MsgConfigureATVDemod::create(settings, force);
+    m_inputMessageQueue.push(msg);
+
+    if (getMessageQueueToGUI()) // forward to GUI if any
+    {
+        MsgConfigureATVDemod *msgToGUI = MsgConfigureATVDemod::create(settings, force);
+        getMessageQueueToGUI()->push(msgToGUI);
+    }
+
+    ATVDemodWebAPIAdapter::webapiFormatChannelSettings(response, settings);
+
+    return 200;
+}
+
+int ATVDemod::webapiVideoFrameGet(
+        const QString& format,
+        int scale,
+        int quality,
+        quint64 since,
+        QByteArray& frame,
+        QString& mimeType,
+        quint64& frameIndex,
+        QString& errorMessage)
+{
+    return VideoFrameEncoder::webapiFrameGet(
+        m_basebandSink->getVideoFrameBuffer(),
+        format,
+        scale,
+        quality,
+        since,
+        frame,
+        mimeType,
+        frameIndex,
+        errorMessage
+    );
+}
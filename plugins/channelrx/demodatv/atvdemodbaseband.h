@@ -62,13 +62,17 @@ public:
     void startWork();
     void stopWork();
     void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void setCompactSamples(bool compactSamples) { m_sampleFifo.setCompact(compactSamples); }
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     int getChannelSampleRate() const;
     double getMagSq() const { return m_sink.getMagSq(); }
     void setScopeSink(BasebandSampleSink* scopeSink) { m_sink.setScopeSink(scopeSink); }
+#ifndef SERVER_MODE
     void setTVScreen(TVScreenAnalog *tvScreen) { m_sink.setTVScreen(tvScreen); }
+#endif
     bool getBFOLocked() { return m_sink.getBFOLocked(); }
     void setVideoTabIndex(int videoTabIndex) { m_sink.setVideoTabIndex(videoTabIndex); }
+    VideoFrameBuffer& getVideoFrameBuffer() { return m_sink.getVideoFrameBuffer(); }
     void setBasebandSampleRate(int sampleRate); //!< To be used when supporting thread is stopped
     bool isRunning() const { return m_running; }
 
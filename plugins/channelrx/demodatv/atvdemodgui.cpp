@@ -123,6 +123,7 @@ void ATVDemodGUI::displaySettings()
     ui->vSync->setChecked(m_settings.m_vSync);
     ui->halfImage->setChecked(m_settings.m_halfFrames);
     ui->invertVideo->setChecked(m_settings.m_invertVideo);
+    ui->blockMode->setChecked(m_settings.m_blockMode);
     ui->standard->setCurrentIndex((int) m_settings.m_atvStd);
     lineTimeUpdate();
     topTimeUpdate();
@@ -191,6 +192,14 @@ bool ATVDemodGUI::handleMessage(const Message& message)
 
         return true;
     }
+    else if (ATVDemod::MsgConfigureATVDemod::match(message))
+    {
+        const ATVDemod::MsgConfigureATVDemod& cfg = (ATVDemod::MsgConfigureATVDemod&) message;
+        m_settings = cfg.getSettings();
+        displaySettings();
+
+        return true;
+    }
     else
     {
         return false;
@@ -452,6 +461,12 @@ void ATVDemodGUI::on_halfImage_clicked()
     applySettings();
 }
 
+void ATVDemodGUI::on_blockMode_clicked()
+{
+    m_settings.m_blockMode = ui->blockMode->isChecked();
+    applySettings();
+}
+
 void ATVDemodGUI::on_nbLines_currentIndexChanged(int index)
 {
     m_settings.m_nbLines = ATVDemodSettings::getNumberOfLines(index);
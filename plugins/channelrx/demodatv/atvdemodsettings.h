@@ -66,6 +66,7 @@ struct ATVDemodSettings
     bool          m_halfFrames;           //!< Toggle half frames processing
     float         m_levelSynchroTop;      //!< Horizontal synchronization top level (0.0 to 1.0 scale)
     float         m_levelBlack;           //!< Black level (0.0 to 1.0 scale)
+    bool          m_blockMode;            //!< Process video by whole lines instead of sample by sample
 
     // common channel settings
     quint32 m_rgbColor;
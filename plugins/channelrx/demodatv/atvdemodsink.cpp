@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 #include <complex.h>
+#include <algorithm>
 
 #include "audio/audiooutput.h"
 
@@ -34,7 +35,9 @@ ATVDemodSink::ATVDemodSink() :
 	m_samplesPerLineFrac(0.0f),
     m_videoTabIndex(0),
     m_scopeSink(nullptr),
+#ifndef SERVER_MODE
     m_registeredTVScreen(nullptr),
+#endif
     m_numberSamplesPerHTop(0),
     m_fieldIndex(0),
     m_synchroSamples(0),
@@ -50,6 +53,11 @@ ATVDemodSink::ATVDemodSink() :
     m_hSyncErrorCount(0),
     m_amSampleIndex(0),
     m_lineIndex(0),
+    m_lineOffset(0),
+    m_lineStartFrac(0.0f),
+    m_blockSyncLocked(false),
+    m_blockLinesWithoutSync(0),
+    m_blockRowIndex(0),
     m_ampAverage(4800),
     m_bfoPLL(200/1000000, 100/1000000, 0.01),
     m_bfoFilter(200.0, 1000000.0, 0.9),
@@ -97,6 +105,10 @@ void ATVDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
         demod(c);
     }
 
+    if (blockMode()) {
+        processBlockLines();
+    }
+
     if ((m_videoTabIndex == 1) && (m_scopeSink)) // do only if scope tab is selected and scope is available
     {
         m_scopeSink->feed(m_scopeSampleBuffer.begin(), m_scopeSampleBuffer.end(), false); // m_ssb = positive only
@@ -297,6 +309,13 @@ void ATVDemodSink::demod(Complex& c)
         m_scopeSampleBuffer.push_back(Sample(sample * (SDR_RX_SCALEF - 1.0f), 0.0f));
     }
 
+    if (blockMode()) // whole lines are processed at the end of the feed block
+    {
+        m_lineSamples.push_back(sample);
+        return;
+    }
+#ifndef SERVER_MODE
+
     //********** gray level **********
     // -0.3 -> 0.7 / 0.7
     sampleVideo = (int) ((sample - m_settings.m_levelBlack) * m_sampleRangeCorrection);
@@ -310,6 +329,7 @@ void ATVDemodSink::demod(Complex& c)
     {
         processSample(sample, sampleVideo);
     }
+#endif
 }
 
 void ATVDemodSink::applyStandard(int sampleRate, ATVDemodSettings::ATVStd atvStd, float lineDuration)
@@ -449,6 +469,7 @@ void ATVDemodSink::applyChannelSettings(int channelSampleRate, int channelFreque
 
     applyStandard(m_channelSampleRate, m_settings.m_atvStd, ATVDemodSettings::getNominalLineTime(m_settings.m_nbLines, m_settings.m_fps));
 
+#ifndef SERVER_MODE
     if (m_registeredTVScreen)
     {
         m_registeredTVScreen->resizeTVScreen(
@@ -457,7 +478,9 @@ void ATVDemodSink::applyChannelSettings(int channelSampleRate, int channelFreque
         );
 		m_tvScreenBuffer = m_registeredTVScreen->getBackBuffer();
     }
+#endif
 
+    applyVideoFrameSize(m_settings.m_nbLines);
     m_fieldIndex = 0;
 
     m_channelSampleRate = channelSampleRate;
@@ -483,6 +506,7 @@ void ATVDemodSink::applySettings(const ATVDemodSettings& settings, bool force)
             << "m_halfFrames:" << settings.m_halfFrames
             << "m_levelSynchroTop:" << settings.m_levelSynchroTop
             << "m_levelBlack:" << settings.m_levelBlack
+            << "m_blockMode:" << settings.m_blockMode
             << "m_rgbColor:" << settings.m_rgbColor
             << "m_title:" << settings.m_title
             << "m_udpAddress:" << settings.m_udpAddress
@@ -526,6 +550,7 @@ void ATVDemodSink::applySettings(const ATVDemodSettings& settings, bool force)
         applyStandard(m_channelSampleRate, settings.m_atvStd,
             ATVDemodSettings::getNominalLineTime(settings.m_nbLines, settings.m_fps));
 
+#ifndef SERVER_MODE
         if (m_registeredTVScreen)
         {
             m_registeredTVScreen->resizeTVScreen(
@@ -534,9 +559,15 @@ void ATVDemodSink::applySettings(const ATVDemodSettings& settings, bool force)
             );
 			m_tvScreenBuffer = m_registeredTVScreen->getBackBuffer();
         }
+#endif
 
+        applyVideoFrameSize(settings.m_nbLines);
         m_fieldIndex = 0;
     }
+    else if (settings.m_blockMode != m_settings.m_blockMode)
+    {
+        applyVideoFrameSize(settings.m_nbLines);
+    }
 
     if ((settings.m_fmDeviation != m_settings.m_fmDeviation) || force) {
         m_objPhaseDiscri.setFMScaling(1.0f / settings.m_fmDeviation);
@@ -548,3 +579,218 @@ void ATVDemodSink::applySettings(const ATVDemodSettings& settings, bool force)
 
     m_settings = settings;
 }
+
+void ATVDemodSink::applyVideoFrameSize(int nbLines)
+{
+    m_videoFrameBuffer.resize(m_samplesPerLine - m_numberSamplesPerLineSignals, nbLines - m_numberOfBlackLines);
+    m_lineSamples.clear();
+    m_lineOffset = 0;
+    m_lineStartFrac = 0.0f;
+    m_blockSyncLocked = false;
+    m_blockLinesWithoutSync = 0;
+    m_blockRowIndex = 0;
+}
+
+void ATVDemodSink::processBlockLines()
+{
+    const float lineLength = m_samplesPerLine + m_samplesPerLineFrac;
+    const int htop = m_numberSamplesPerHTop > 0 ? m_numberSamplesPerHTop : 1;
+
+    while (true)
+    {
+        // next line start is searched around its expected position: narrowly when locked else over a whole line
+        float expectedLineStart = m_lineStartFrac + lineLength;
+        int searchHalfWidth = m_blockSyncLocked ? htop : m_samplesPerLine / 2;
+        int searchStart = (int) expectedLineStart - searchHalfWidth;
+        int searchEnd = (int) expectedLineStart + searchHalfWidth;
+
+        if ((int) m_lineSamples.size() - m_lineOffset < searchEnd + htop + 2) { // wait for more samples
+            break;
+        }
+
+        processBlockLine();
+
+        float nextLineStart = expectedLineStart;
+        float syncPos;
+        bool syncFound = m_settings.m_hSync && findHSync(searchStart, searchEnd, syncPos);
+        m_blockSyncLocked = false;
+
+        if (syncFound)
+        {
+            float hSyncShift = syncPos - expectedLineStart;
+
+            if (fabs(hSyncShift) > htop)
+            {
+                m_hSyncErrorCount++;
+
+                if (m_hSyncErrorCount >= 4)
+                {
+                    // Fast sync: shift is too large, needs to be fixed ASAP
+                    nextLineStart = syncPos;
+                    m_hSyncErrorCount = 0;
+                }
+            }
+            else
+            {
+                // Slow sync: slight adjustment is needed
+                nextLineStart += hSyncShift * 0.2f;
+                m_hSyncErrorCount = 0;
+                m_blockSyncLocked = true;
+            }
+        }
+
+        m_lineIndex++;
+
+        if (m_settings.m_atvStd == ATVDemodSettings::ATVStdHSkip)
+        {
+            processBlockEOLHSkip(syncFound);
+        }
+        else
+        {
+            bool newFrame;
+            m_blockRowIndex = nextRowClassic(newFrame);
+
+            if (newFrame) {
+                publishFrame();
+            }
+        }
+
+        int consumed = (int) nextLineStart;
+        m_lineOffset += consumed;
+        m_lineStartFrac = nextLineStart - consumed;
+    }
+
+    // drop the consumed lines once per block
+    m_lineSamples.erase(m_lineSamples.begin(), m_lineSamples.begin() + m_lineOffset);
+    m_lineOffset = 0;
+}
+
+void ATVDemodSink::processBlockLine()
+{
+    // line starts at m_lineStartFrac between samples 0 and 1 of the line
+    const float *lineSamples = m_lineSamples.data() + m_lineOffset;
+    const float frac = m_lineStartFrac;
+
+    if (m_settings.m_vSync)
+    {
+        m_fieldDetectSampleCount = countBelow(lineSamples + m_fieldDetectStartPos + 1,
+            m_fieldDetectEndPos - m_fieldDetectStartPos - 1, m_settings.m_levelSynchroTop);
+        m_vSyncDetectSampleCount = countBelow(lineSamples + m_vSyncDetectStartPos + 1,
+            m_vSyncDetectEndPos - m_vSyncDetectStartPos - 1, m_settings.m_levelSynchroTop);
+    }
+
+    uint8_t *row = m_videoFrameBuffer.getBackRow(m_blockRowIndex);
+
+    if (!row) { // line outside of the image
+        return;
+    }
+
+    // Resample the image part of the line on the line start with a constant fraction
+    // and convert to gray level in one pass that the compiler can vectorize
+    const float *imageSamples = lineSamples + m_numberSamplesPerHSync;
+    const int width = m_videoFrameBuffer.getWidth();
+    const float levelBlack = m_settings.m_levelBlack;
+    const float rangeCorrection = m_sampleRangeCorrection;
+
+    for (int i = 0; i < width; i++)
+    {
+        float sample = imageSamples[i] + frac * (imageSamples[i+1] - imageSamples[i]);
+        float sampleVideo = (sample - levelBlack) * rangeCorrection;
+        sampleVideo = (sampleVideo < 0.0f) ? 0.0f : (sampleVideo > 255.0f) ? 255.0f : sampleVideo;
+        row[i] = (uint8_t) sampleVideo;
+    }
+}
+
+bool ATVDemodSink::findHSync(int searchStart, int searchEnd, float& syncPos)
+{
+    const int htop = m_numberSamplesPerHTop > 0 ? m_numberSamplesPerHTop : 1;
+    const float *samples = m_lineSamples.data() + m_lineOffset;
+    const float level = m_settings.m_levelSynchroTop;
+    searchStart = searchStart < 2 ? 2 : searchStart;
+    int nbPositions = searchEnd - searchStart;
+
+    if (nbPositions <= 0) {
+        return false;
+    }
+
+    // Correlation with the sync pulse (a box of htop samples) at each position of the window
+    // is the difference of running sums htop samples apart
+    int nbSums = nbPositions + htop;
+    m_lineSums.resize(nbSums + 1);
+    m_syncCorr.resize(nbPositions);
+    float *sums = m_lineSums.data();
+    float *corr = m_syncCorr.data();
+    sums[0] = 0.0f;
+
+    for (int i = 0; i < nbSums; i++) {
+        sums[i+1] = sums[i] + samples[searchStart + i];
+    }
+
+    for (int i = 0; i < nbPositions; i++) {
+        corr[i] = sums[i + htop] - sums[i];
+    }
+
+    int best = std::min_element(corr, corr + nbPositions) - corr;
+
+    if (corr[best] > level * htop) { // no pulse below synchro top level
+        return false;
+    }
+
+    // Refine on the falling edge crossing the synchro top level
+    int pos = searchStart + best;
+    syncPos = pos;
+
+    for (int k = pos - 1; k <= pos + 2; k++)
+    {
+        if ((samples[k-1] >= level) && (samples[k] < level))
+        {
+            syncPos = (k - 1) + (samples[k-1] - level) / (samples[k-1] - samples[k]);
+            break;
+        }
+    }
+
+    return true;
+}
+
+// Vertical sync is the first horizontal sync after a line without horizontal sync
+void ATVDemodSink::processBlockEOLHSkip(bool syncFound)
+{
+    if ((syncFound && (m_blockLinesWithoutSync > 0))
+        || (!m_settings.m_vSync && (m_lineIndex >= m_settings.m_nbLines)))
+    {
+        publishFrame();
+        m_lineIndex = 0;
+    }
+
+    m_blockLinesWithoutSync = syncFound ? 0 : m_blockLinesWithoutSync + 1;
+    m_blockRowIndex = m_lineIndex;
+}
+
+void ATVDemodSink::publishFrame()
+{
+#ifndef SERVER_MODE
+    if (m_registeredTVScreen && m_tvScreenBuffer)
+    {
+        int width = m_videoFrameBuffer.getWidth();
+
+        for (int row = 0; row < m_videoFrameBuffer.getHeight(); row++) {
+            m_tvScreenBuffer->setRow(row, m_videoFrameBuffer.getBackRow(row), width);
+        }
+
+        m_tvScreenBuffer = m_registeredTVScreen->swapBuffers();
+    }
+#endif
+
+    m_videoFrameBuffer.swap();
+}
+
+int ATVDemodSink::countBelow(const float *samples, int nbSamples, float level)
+{
+    int count = 0;
+
+    for (int i = 0; i < nbSamples; i++) {
+        count += samples[i] < level;
+    }
+
+    return count;
+}
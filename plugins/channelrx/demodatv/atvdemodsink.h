@@ -31,9 +31,12 @@
 #include "dsp/phaselock.h"
 #include "dsp/recursivefilters.h"
 #include "dsp/phasediscri.h"
+#include "dsp/videoframebuffer.h"
 #include "audio/audiofifo.h"
 #include "util/movingaverage.h"
+#ifndef SERVER_MODE
 #include "gui/tvscreenanalog.h"
+#endif
 
 #include "atvdemodsettings.h"
 
@@ -45,10 +48,13 @@ public:
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
 
   	void setScopeSink(BasebandSampleSink* scopeSink) { m_scopeSink = scopeSink; }
+#ifndef SERVER_MODE
     void setTVScreen(TVScreenAnalog *tvScreen) { m_registeredTVScreen = tvScreen; } //!< set by the GUI
+#endif
     double getMagSq() const { return m_magSqAverage; } //!< Beware this is scaled to 2^30
     bool getBFOLocked();
     void setVideoTabIndex(int videoTabIndex) { m_videoTabIndex = videoTabIndex; }
+    VideoFrameBuffer& getVideoFrameBuffer() { return m_videoFrameBuffer; } //!< complete frames produced in block mode (always in server mode)
 
     void applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force = false);
     void applySettings(const ATVDemodSettings& settings, bool force = false);
@@ -108,8 +114,10 @@ private:
     SampleVector m_scopeSampleBuffer;
 
     //*************** ATV PARAMETERS  ***************
+#ifndef SERVER_MODE
     TVScreenAnalog *m_registeredTVScreen;
 	std::shared_ptr<TVScreenAnalogBuffer> m_tvScreenBuffer;
+#endif
 
     //int m_intNumberSamplePerLine;
     int m_numberSamplesPerHTop;        //!< number of samples per horizontal synchronization pulse (pulse in ultra-black) - integer value
@@ -166,6 +174,18 @@ private:
 
     float m_sampleRangeCorrection;
 
+    //*************** BLOCK MODE  ***************
+
+    std::vector<float> m_lineSamples;  //!< demodulated samples not yet consumed by complete lines
+    int m_lineOffset;                  //!< index of the current line start in m_lineSamples (compacted at the end of feed)
+    std::vector<float> m_lineSums;     //!< running sums of the sync search window
+    std::vector<float> m_syncCorr;     //!< correlation with the sync pulse at each position of the search window
+    float m_lineStartFrac;             //!< position of the current line start after m_lineOffset (0.0 to 1.0)
+    bool m_blockSyncLocked;            //!< sync found near the expected position on last line: search narrowly
+    int m_blockLinesWithoutSync;
+    int m_blockRowIndex;               //!< row of the current line in the frame
+    VideoFrameBuffer m_videoFrameBuffer;
+
     //*************** RF  ***************
 
     MovingAverageUtil<double, double, 32> m_magSqAverage;
@@ -186,6 +206,18 @@ private:
 
     void demod(Complex& c);
     void applyStandard(int sampleRate, ATVDemodSettings::ATVStd atvStd, float lineDuration);
+    void applyVideoFrameSize(int nbLines);
+    void processBlockLines();
+    void processBlockLine();
+    bool findHSync(int searchStart, int searchEnd, float& syncPos);
+    void processBlockEOLHSkip(bool syncFound);
+    void publishFrame();
+    static int countBelow(const float *samples, int nbSamples, float level);
+
+#ifdef SERVER_MODE
+    bool blockMode() const { return true; } //!< there is no screen to draw on sample by sample
+#else
+    bool blockMode() const { return m_settings.m_blockMode; }
 
     inline void processSample(float& sample, int& sampleVideo)
     {
@@ -260,11 +292,22 @@ private:
     // Standard vertical sync
     inline void processEOLClassic()
     {
-        if (m_lineIndex == m_numberOfVSyncLines + 3 && m_fieldIndex == 0)
-        {
+        bool newFrame;
+        int rowIndex = nextRowClassic(newFrame);
+
+        if (newFrame) {
 			m_tvScreenBuffer = m_registeredTVScreen->swapBuffers();
         }
 
+		m_tvScreenBuffer->selectRow(rowIndex, m_sampleOffsetFrac);
+	}
+#endif
+
+    // Standard vertical sync: row of the next line. newFrame is set when the current frame is complete.
+    inline int nextRowClassic(bool& newFrame)
+    {
+        newFrame = (m_lineIndex == m_numberOfVSyncLines + 3) && (m_fieldIndex == 0);
+
         if (m_vSyncDetectSampleCount > m_vSyncDetectThreshold &&
             (m_lineIndex < 3 || m_lineIndex > m_numberOfVSyncLines + 1) && m_settings.m_vSync)
         {
@@ -295,9 +338,10 @@ private:
         if (m_interleaved)
             rowIndex = rowIndex * 2 - m_fieldIndex;
 
-		m_tvScreenBuffer->selectRow(rowIndex, m_sampleOffsetFrac);
+        return rowIndex;
 	}
 
+#ifndef SERVER_MODE
     // Vertical sync is obtained by skipping horizontal sync on the line that triggers vertical sync (new frame)
     inline void processEOLHSkip()
     {
@@ -310,6 +354,7 @@ private:
 
 		m_tvScreenBuffer->selectRow(m_lineIndex, m_sampleOffsetFrac);
     }
+#endif
 };
 
 #endif // INCLUDE_ATVDEMODSINK_H
\ No newline at end of file
@@ -54,6 +54,7 @@ void ATVDemodWebAPIAdapter::webapiFormatChannelSettings(
     response.getAtvDemodSettings()->setBlnFftFiltering(settings.m_fftFiltering ? 1 : 0);
     response.getAtvDemodSettings()->setBlnHSync(settings.m_hSync ? 1 : 0);
     response.getAtvDemodSettings()->setBlnInvertVideo(settings.m_invertVideo ? 1 : 0);
+    response.getAtvDemodSettings()->setBlockMode(settings.m_blockMode ? 1 : 0);
     response.getAtvDemodSettings()->setBlnVSync(settings.m_vSync ? 1 : 0);
     response.getAtvDemodSettings()->setEnmAtvStandard((int) settings.m_atvStd);
     response.getAtvDemodSettings()->setEnmModulation((int) settings.m_atvModulation);
@@ -91,6 +92,9 @@ void ATVDemodWebAPIAdapter::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("blnInvertVideo")) {
         settings.m_invertVideo = response.getAtvDemodSettings()->getBlnInvertVideo() != 0;
     }
+    if (channelSettingsKeys.contains("blockMode")) {
+        settings.m_blockMode = response.getAtvDemodSettings()->getBlockMode() != 0;
+    }
     if (channelSettingsKeys.contains("blnVSync")) {
         settings.m_vSync = response.getAtvDemodSettings()->getBlnVSync() != 0;
     }
@@ -108,6 +108,11 @@ void BFMDemod::stop()
 	m_thread->wait();
 }
 
+void BFMDemod::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool BFMDemod::handleMessage(const Message& cmd)
 {
     if (MsgConfigureBFMDemod::match(cmd))
@@ -42,7 +42,7 @@
 #include "bfmdemodreport.h"
 #include "bfmdemodsettings.h"
 #include "bfmdemod.h"
-#include "rdstmc.h"
+#include "rds/rdstmc.h"
 #include "ui_bfmdemodgui.h"
 
 BFMDemodGUI* BFMDemodGUI::create(PluginAPI* pluginAPI, DeviceUISet *deviceUIset, BasebandSampleSink *rxChannel)
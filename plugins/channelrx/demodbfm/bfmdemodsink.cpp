@@ -29,7 +29,7 @@
 #include "dsp/basebandsamplesink.h"
 #include "util/db.h"
 
-#include "rdsparser.h"
+#include "rds/rdsparser.h"
 #include "bfmdemodsink.h"
 
 const Real BFMDemodSink::default_deemphasis = 50.0; // 50 us
@@ -41,7 +41,6 @@ BFMDemodSink::BFMDemodSink() :
     m_audioSampleRate(48000),
     m_audioBufferFill(0),
     m_audioFifo(48000),
-    m_pilotPLL(19000/384000, 50/384000, 0.01),
     m_deemphasisFilterX(default_deemphasis * 48000 * 1.0e-6),
     m_deemphasisFilterY(default_deemphasis * 48000 * 1.0e-6),
 	m_fmExcursion(default_excursion)
@@ -57,12 +56,6 @@ BFMDemodSink::BFMDemodSink() :
     m_interpolatorDistance = 0.0f;
     m_interpolatorDistanceRemain = 0.0f;
 
-    m_interpolatorRDSDistance = 0.0f;
-    m_interpolatorRDSDistanceRemain = 0.0f;
-
-    m_interpolatorStereoDistance = 0.0f;
-    m_interpolatorStereoDistanceRemain = 0.0f;
-
     m_spectrumSink = nullptr;
     m_m1Arg = 0;
 
@@ -86,13 +79,14 @@ BFMDemodSink::~BFMDemodSink()
 
 void BFMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-	Complex ci, cs, cr;
+	Complex ci;
 	fftfilt::cmplx *rf;
 	int rf_out;
 	double msq;
 	Real demod;
 
 	m_sampleBuffer.clear();
+	m_mpxBuffer.clear();
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
@@ -135,67 +129,52 @@ void BFMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
 				m_sampleBuffer.push_back(Sample(demod * SDR_RX_SCALEF, 0.0));
 			}
 
-			if (m_settings.m_rdsActive)
-			{
-				//Complex r(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0);
-				Complex r(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0);
+			m_mpxBuffer.push_back(demod);
+		}
+	}
 
-				if (m_interpolatorRDS.decimate(&m_interpolatorRDSDistanceRemain, r, &cr))
-				{
-					bool bit;
+	// Composite is processed by blocks. Stereo and RDS subcarriers come out at their own rates.
+	m_composite.feed(m_mpxBuffer);
 
-					if (m_rdsDemod.process(cr.real(), bit))
-					{
-						if (m_rdsDecoder.frameSync(bit)) {
-						    m_rdsParser.parseGroup(m_rdsDecoder.getGroup());
-						}
-					}
+	if (m_settings.m_showPilot)
+	{
+		const std::vector<Real>& pilot38 = m_composite.getPilot38();
 
-					m_interpolatorRDSDistanceRemain += m_interpolatorRDSDistance;
-				}
-			}
+		for (std::vector<Real>::const_iterator it = pilot38.begin(); it != pilot38.end(); ++it) {
+			m_sampleBuffer.push_back(Sample(*it * SDR_RX_SCALEF, 0.0)); // debug 38 kHz pilot
+		}
+	}
 
-			Real sampleStereo = 0.0f;
+	if (m_settings.m_rdsActive)
+	{
+		const std::vector<Real>& rds = m_composite.getRDS();
 
-			// Process stereo if stereo mode is selected
+		for (std::vector<Real>::const_iterator it = rds.begin(); it != rds.end(); ++it)
+		{
+			bool bit;
 
-			if (m_settings.m_audioStereo)
+			if (m_rdsDemod.process(*it, bit))
 			{
-				m_pilotPLL.process(demod, m_pilotPLLSamples);
-
-				if (m_settings.m_showPilot) {
-					m_sampleBuffer.push_back(Sample(m_pilotPLLSamples[1] * SDR_RX_SCALEF, 0.0)); // debug 38 kHz pilot
-				}
-
-				if (m_settings.m_lsbStereo)
-				{
-					// 1.17 * 0.7 = 0.819
-					Complex s(demod * m_pilotPLLSamples[1], demod * m_pilotPLLSamples[2]);
-
-					if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
-					{
-						sampleStereo = cs.real() + cs.imag();
-						m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
-					}
-				}
-				else
-				{
-					Complex s(demod * 1.17 * m_pilotPLLSamples[1], 0);
-
-					if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
-					{
-						sampleStereo = cs.real();
-						m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
-					}
+				if (m_rdsDecoder.frameSync(bit)) {
+					m_rdsParser.parseGroup(m_rdsDecoder.getGroup());
 				}
 			}
+		}
+	}
+
+	const std::vector<Real>& mono = m_composite.getMono();
+	const std::vector<Real>& stereo = m_composite.getStereo();
 
-			Complex e(demod, 0);
+	{
+		for (unsigned int k = 0; k < mono.size(); k++)
+		{
+			Complex e(mono[k], k < stereo.size() ? stereo[k] : 0.0f);
 
 			if (m_interpolator.decimate(&m_interpolatorDistanceRemain, e, &ci))
 			{
 				if (m_settings.m_audioStereo)
 				{
+					Real sampleStereo = ci.imag();
 					Real deemph_l, deemph_r; // Pre-emphasis is applied on each channel before multiplexing
 					m_deemphasisFilterX.process(ci.real() + sampleStereo, deemph_l);
 					m_deemphasisFilterY.process(ci.real() - sampleStereo, deemph_r);
@@ -257,18 +236,23 @@ void BFMDemodSink::applyAudioSampleRate(int sampleRate)
 
     qDebug("BFMDemodSink::applyAudioSampleRate: %u", sampleRate);
 
-    m_interpolator.create(16, m_channelSampleRate, m_settings.m_afBandwidth);
-    m_interpolatorDistanceRemain = (Real) m_channelSampleRate / sampleRate;
-    m_interpolatorDistance =  (Real) m_channelSampleRate / (Real) sampleRate;
-
-    m_interpolatorStereo.create(16, m_channelSampleRate, m_settings.m_afBandwidth);
-    m_interpolatorStereoDistanceRemain = (Real) m_channelSampleRate / sampleRate;
-    m_interpolatorStereoDistance =  (Real) m_channelSampleRate / (Real) sampleRate;
+    m_audioSampleRate = sampleRate;
+    applyCompositeSettings();
 
     m_deemphasisFilterX.configure(default_deemphasis * sampleRate * 1.0e-6);
     m_deemphasisFilterY.configure(default_deemphasis * sampleRate * 1.0e-6);
+}
 
-    m_audioSampleRate = sampleRate;
+void BFMDemodSink::applyCompositeSettings()
+{
+    m_composite.configure(m_channelSampleRate, m_audioSampleRate, m_settings.m_afBandwidth);
+
+    // final resampling from the composite engine audio rate to the audio device rate
+    m_interpolator.create(16, m_composite.getAudioRate(), m_settings.m_afBandwidth);
+    m_interpolatorDistanceRemain = m_composite.getAudioRate() / (Real) m_audioSampleRate;
+    m_interpolatorDistance = m_composite.getAudioRate() / (Real) m_audioSampleRate;
+
+    m_rdsDemod.setSampleRate(m_composite.getRDSRate());
 }
 
 void BFMDemodSink::applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force)
@@ -285,24 +269,12 @@ void BFMDemodSink::applyChannelSettings(int channelSampleRate, int channelFreque
 
     if ((channelSampleRate != m_channelSampleRate) || force)
     {
-        m_pilotPLL.configure(19000.0/channelSampleRate, 50.0/channelSampleRate, 0.01);
-
-        m_interpolator.create(16, channelSampleRate, m_settings.m_afBandwidth);
-        m_interpolatorDistanceRemain = (Real) channelSampleRate / m_audioSampleRate;
-        m_interpolatorDistance =  (Real) channelSampleRate / (Real) m_audioSampleRate;
-
-        m_interpolatorStereo.create(16, channelSampleRate, m_settings.m_afBandwidth);
-        m_interpolatorStereoDistanceRemain = (Real) channelSampleRate / m_audioSampleRate;
-        m_interpolatorStereoDistance =  (Real) channelSampleRate / (Real) m_audioSampleRate;
-
-        m_interpolatorRDS.create(4, channelSampleRate, 600.0);
-        m_interpolatorRDSDistanceRemain = (Real) channelSampleRate / 250000.0;
-        m_interpolatorRDSDistance =  (Real) channelSampleRate / 250000.0;
-
         Real lowCut = -(m_settings.m_rfBandwidth / 2.0) / channelSampleRate;
         Real hiCut  = (m_settings.m_rfBandwidth / 2.0) / channelSampleRate;
         m_rfFilter->create_filter(lowCut, hiCut);
         m_phaseDiscri.setFMScaling(channelSampleRate / m_fmExcursion);
+        m_channelSampleRate = channelSampleRate;
+        applyCompositeSettings();
     }
 
     m_channelSampleRate = channelSampleRate;
@@ -326,26 +298,11 @@ void BFMDemodSink::applySettings(const BFMDemodSettings& settings, bool force)
             << " m_useReverseAPI: " << settings.m_useReverseAPI
             << " force: " << force;
 
-    if ((settings.m_audioStereo && (settings.m_audioStereo != m_settings.m_audioStereo)) || force) {
-        m_pilotPLL.configure(19000.0/m_channelSampleRate, 50.0/m_channelSampleRate, 0.01);
-    }
-
-    if ((settings.m_afBandwidth != m_settings.m_afBandwidth) || force)
-    {
-        m_interpolator.create(16, m_channelSampleRate, settings.m_afBandwidth);
-        m_interpolatorDistanceRemain = (Real) m_channelSampleRate / m_audioSampleRate;
-        m_interpolatorDistance =  (Real) m_channelSampleRate / (Real) m_audioSampleRate;
-
-        m_interpolatorStereo.create(16, m_channelSampleRate, settings.m_afBandwidth);
-        m_interpolatorStereoDistanceRemain = (Real) m_channelSampleRate / m_audioSampleRate;
-        m_interpolatorStereoDistance =  (Real) m_channelSampleRate / (Real) m_audioSampleRate;
-
-        m_interpolatorRDS.create(4, m_channelSampleRate, 600.0);
-        m_interpolatorRDSDistanceRemain = (Real) m_channelSampleRate / 250000.0;
-        m_interpolatorRDSDistance =  (Real) m_channelSampleRate / 250000.0;
+    bool compositeChange = (settings.m_afBandwidth != m_settings.m_afBandwidth) || force;
 
-        m_lowpass.create(21, m_audioSampleRate, settings.m_afBandwidth);
-    }
+    m_composite.setStereo(settings.m_audioStereo, settings.m_lsbStereo);
+    m_composite.setRDS(settings.m_rdsActive);
+    m_composite.setShowPilot(settings.m_showPilot && settings.m_audioStereo);
 
     if ((settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force)
     {
@@ -360,4 +317,8 @@ void BFMDemodSink::applySettings(const BFMDemodSettings& settings, bool force)
     }
 
     m_settings = settings;
+
+    if (compositeChange) {
+        applyCompositeSettings();
+    }
 }
@@ -23,17 +23,16 @@
 #include "dsp/channelsamplesink.h"
 #include "dsp/nco.h"
 #include "dsp/interpolator.h"
-#include "dsp/lowpass.h"
 #include "dsp/movingaverage.h"
 #include "dsp/fftfilt.h"
-#include "dsp/phaselock.h"
 #include "dsp/filterrc.h"
 #include "dsp/phasediscri.h"
+#include "dsp/bfmcomposite.h"
 #include "audio/audiofifo.h"
+#include "rds/rdsparser.h"
+#include "rds/rdsdecoder.h"
+#include "rds/rdsdemod.h"
 
-#include "rdsparser.h"
-#include "rdsdecoder.h"
-#include "rdsdemod.h"
 #include "bfmdemodsettings.h"
 
 class BasebandSampleSink;
@@ -49,8 +48,8 @@ public:
 
 	double getMagSq() const { return m_magsq; }
 
-	bool getPilotLock() const { return m_pilotPLL.locked(); }
-	Real getPilotLevel() const { return m_pilotPLL.get_pilot_level(); }
+	bool getPilotLock() const { return m_composite.getPilotLock(); }
+	Real getPilotLevel() const { return m_composite.getPilotLevel(); }
 
 	Real getDecoderQua() const { return m_rdsDecoder.m_qua; }
 	bool getDecoderSynced() const { return m_rdsDecoder.synced(); }
@@ -113,19 +112,12 @@ private:
 	SampleVector m_sampleBuffer;
 
 	NCO m_nco;
-	Interpolator m_interpolator; //!< Interpolator between fixed demod bandwidth and audio bandwidth (rational)
+	BFMComposite m_composite;    //!< MPX to L+R, L-R and RDS baseband at reduced rates
+	std::vector<Real> m_mpxBuffer;
+	Interpolator m_interpolator; //!< Interpolator between composite audio rate and audio sample rate (rational). I: L+R, Q: L-R
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
 
-	Interpolator m_interpolatorStereo; //!< Twin Interpolator for stereo subcarrier
-	Real m_interpolatorStereoDistance;
-	Real m_interpolatorStereoDistanceRemain;
-
-	Interpolator m_interpolatorRDS; //!< Twin Interpolator for stereo subcarrier
-	Real m_interpolatorRDSDistance;
-	Real m_interpolatorRDSDistanceRemain;
-
-	Lowpass<Real> m_lowpass;
 	fftfilt* m_rfFilter;
 	static const int filtFftLen = 1024;
 
@@ -140,9 +132,6 @@ private:
     int    m_magsqCount;
     MagSqLevelsStore m_magSqLevelStore;
 
-	RDSPhaseLock m_pilotPLL;
-	Real m_pilotPLLSamples[4];
-
 	RDSDemod m_rdsDemod;
 	RDSDecoder m_rdsDecoder;
 	RDSParser m_rdsParser;
@@ -156,6 +145,8 @@ private:
 
 	PhaseDiscriminators m_phaseDiscri;
 
+	void applyCompositeSettings();
+
     BasebandSampleSink *m_spectrumSink;
 };
 
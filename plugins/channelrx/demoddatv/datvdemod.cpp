@@ -19,8 +19,12 @@
 
 #include <QDebug>
 
+#include "SWGChannelSettings.h"
+
 #include "device/deviceapi.h"
+#include "dsp/videoframeencoder.h"
 
+#include "datvdemodwebapiadapter.h"
 #include "datvdemod.h"
 
 const QString DATVDemod::m_channelIdURI = "sdrangel.channel.demoddatv";
@@ -80,6 +84,11 @@ void DATVDemod::stop()
 	m_thread->wait();
 }
 
+void DATVDemod::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool DATVDemod::handleMessage(const Message& cmd)
 {
     if (MsgConfigureDATVDemod::match(cmd))
@@ -123,3 +132,61 @@ uint32_t DATVDemod::getNumberOfDeviceStreams() const
 {
     return m_deviceAPI->getNbSourceStreams();
 }
+
+int DATVDemod::webapiSettingsGet(
+        SWGSDRangel::SWGChannelSettings& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setDatvDemodSettings(new SWGSDRangel::SWGDATVDemodSettings());
+    response.getDatvDemodSettings()->init();
+    DATVDemodWebAPIAdapter::webapiFormatChannelSettings(response, m_settings);
+    return 200;
+}
+
+int DATVDemod::webapiSettingsPutPatch(
+        bool force,
+        const QStringList& channelSettingsKeys,
+        SWGSDRangel::SWGChannelSettings& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    DATVDemodSettings settings = m_settings;
+    DATVDemodWebAPIAdapter::webapiUpdateChannelSettings(settings, channelSettingsKeys, response);
+
+    MsgConfigureDATVDemod *msg = MsgConfigureDATVDemod::create(settings, force);
+    m_inputMessageQueue.push(msg);
+
+    if (getMessageQueueToGUI()) // forward to GUI if any
+    {
+        MsgConfigureDATVDemod *msgToGUI = MsgConfigureDATVDemod::create(settings, force);
+        getMessageQueueToGUI()->push(msgToGUI);
+    }
+
+    DATVDemodWebAPIAdapter::webapiFormatChannelSettings(response, settings);
+
+    return 200;
+}
+
+int DATVDemod::webapiVideoFrameGet(
+        const QString& format,
+        int scale,
+        int quality,
+        quint64 since,
+        QByteArray& frame,
+        QString& mimeType,
+        quint64& frameIndex,
+        QString& errorMessage)
+{
+    return VideoFrameEncoder::webapiFrameGet(
+        m_basebandSink->getVideoFrameBuffer(),
+        format,
+        scale,
+        quality,
+        since,
+        frame,
+        mimeType,
+        frameIndex,
+        errorMessage
+    );
+}
@@ -52,6 +52,7 @@ public:
 	virtual void start();
 	virtual void stop();
 	virtual bool handleMessage(const Message& cmd);
+	virtual void setCompactSamples(bool compactSamples);
 
     virtual int getNbSinkStreams() const { return 1; }
     virtual int getNbSourceStreams() const { return 0; }
@@ -64,8 +65,29 @@ public:
         return m_settings.m_centerFrequency;
     }
 
+    virtual int webapiSettingsGet(
+            SWGSDRangel::SWGChannelSettings& response,
+            QString& errorMessage);
+
+    virtual int webapiSettingsPutPatch(
+            bool force,
+            const QStringList& channelSettingsKeys,
+            SWGSDRangel::SWGChannelSettings& response,
+            QString& errorMessage);
+
+    virtual int webapiVideoFrameGet(
+            const QString& format,
+            int scale,
+            int quality,
+            quint64 since,
+            QByteArray& frame,
+            QString& mimeType,
+            quint64& frameIndex,
+            QString& errorMessage);
+
     void SetTVScreen(TVScreen *objScreen) { m_basebandSink->setTVScreen(objScreen); }
     DATVideostream *SetVideoRender(DATVideoRender *objScreen) { return m_basebandSink->SetVideoRender(objScreen); }
+    VideoFrameBuffer& getVideoFrameBuffer() { return m_basebandSink->getVideoFrameBuffer(); } //!< decoded frames for the API
     bool audioActive() { return m_basebandSink->audioActive(); }
     bool audioDecodeOK() { return m_basebandSink->audioDecodeOK(); }
     bool videoActive() { return m_basebandSink->videoActive(); }
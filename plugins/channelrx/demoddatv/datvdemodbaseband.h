@@ -82,6 +82,7 @@ public:
     ~DATVDemodBaseband();
     void reset();
     void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void setCompactSamples(bool compactSamples) { m_sampleFifo.setCompact(compactSamples); }
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     int getChannelSampleRate() const;
     double getMagSq() const { return m_sink.getMagSq(); }
@@ -89,6 +90,7 @@ public:
     void setMessageQueueToGUI(MessageQueue *messageQueue) { m_sink.setMessageQueueToGUI(messageQueue); }
     void setBasebandSampleRate(int sampleRate); //!< To be used when supporting thread is stopped
     DATVideostream *SetVideoRender(DATVideoRender *objScreen) { return m_sink.SetVideoRender(objScreen); }
+    VideoFrameBuffer& getVideoFrameBuffer() { return m_sink.getVideoFrameBuffer(); }
     bool audioActive() { return m_sink.audioActive(); }
     bool audioDecodeOK() { return m_sink.audioDecodeOK(); }
     bool videoActive() { return m_sink.videoActive(); }
@@ -110,6 +110,13 @@ bool DATVDemodGUI::handleMessage(const Message& message)
         displaySystemConfiguration();
         return true;
     }
+    else if (DATVDemod::MsgConfigureDATVDemod::match(message))
+    {
+        const DATVDemod::MsgConfigureDATVDemod& cfg = (DATVDemod::MsgConfigureDATVDemod&) message;
+        m_settings = cfg.getSettings();
+        displaySettings();
+        return true;
+    }
     else
     {
         return false;
@@ -339,6 +346,7 @@ void DATVDemodGUI::displaySettings()
     ui->udpTS->setChecked(m_settings.m_udpTS);
     ui->udpTSAddress->setText(m_settings.m_udpTSAddress);
     ui->udpTSPort->setText(tr("%1").arg(m_settings.m_udpTSPort));
+    ui->keyFramesOnly->setChecked(m_settings.m_keyFramesOnly);
 
     blockApplySettings(false);
     m_objChannelMarker.blockSignals(false);
@@ -692,6 +700,12 @@ void DATVDemodGUI::on_udpTS_clicked(bool checked)
     applySettings();
 }
 
+void DATVDemodGUI::on_keyFramesOnly_clicked(bool checked)
+{
+    m_settings.m_keyFramesOnly = checked;
+    applySettings();
+}
+
 void DATVDemodGUI::on_StreamMetaDataChanged(DataTSMetaData2 *objMetaData)
 {
     QString strMetaData="";
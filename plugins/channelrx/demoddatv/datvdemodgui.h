@@ -96,6 +96,7 @@ private slots:
     void on_udpTS_clicked(bool checked);
     void on_udpTSAddress_editingFinished();
     void on_udpTSPort_editingFinished();
+    void on_keyFramesOnly_clicked(bool checked);
 
 private:
     Ui::DATVDemodGUI* ui;
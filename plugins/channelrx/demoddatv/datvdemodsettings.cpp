@@ -55,6 +55,7 @@ void DATVDemodSettings::resetToDefaults()
     m_audioDeviceName = AudioDeviceManager::m_defaultDeviceName;
     m_audioVolume = 0;
     m_videoMute = false;
+    m_keyFramesOnly = false;
     m_udpTSAddress = "127.0.0.1";
     m_udpTSPort = 8882;
     m_udpTS = false;
@@ -103,6 +104,7 @@ QByteArray DATVDemodSettings::serialize() const
     s.writeU32(29, m_reverseAPIPort);
     s.writeU32(30, m_reverseAPIDeviceIndex);
     s.writeU32(31, m_reverseAPIChannelIndex);
+    s.writeBool(32, m_keyFramesOnly);
 
     return s.final();
 }
@@ -184,6 +186,7 @@ bool DATVDemodSettings::deserialize(const QByteArray& data)
         m_reverseAPIDeviceIndex = utmp > 99 ? 99 : utmp;
         d.readU32(31, &utmp, 0);
         m_reverseAPIChannelIndex = utmp > 99 ? 99 : utmp;
+        d.readBool(32, &m_keyFramesOnly, false);
 
         validateSystemConfiguration();
 
@@ -217,7 +220,8 @@ void DATVDemodSettings::debug(const QString& msg) const
         << " m_audioMute: " << m_audioMute
         << " m_audioDeviceName: " << m_audioDeviceName
         << " m_audioVolume: " << m_audioVolume
-        << " m_videoMute: " << m_videoMute;
+        << " m_videoMute: " << m_videoMute
+        << " m_keyFramesOnly: " << m_keyFramesOnly;
 }
 
 bool DATVDemodSettings::isDifferent(const DATVDemodSettings& other)
@@ -93,6 +93,7 @@ struct DATVDemodSettings
     int m_excursion;
     int m_audioVolume;
     bool m_videoMute;
+    bool m_keyFramesOnly; //!< decode key frames only (lower CPU for thumbnails)
     QString m_udpTSAddress;
     quint32 m_udpTSPort;
     bool m_udpTS;
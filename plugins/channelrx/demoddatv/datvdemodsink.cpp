@@ -48,6 +48,7 @@ DATVDemodSink::DATVDemodSink() :
 {
     //*************** DATV PARAMETERS  ***************
     m_blnInitialized=false;
+    m_objPipeline=nullptr;
     CleanUpDATVFramework(false);
     m_objVideoStream = new DATVideostream();
     m_objRFFilter = new fftfilt(-256000.0 / 1024000.0, 256000.0 / 1024000.0, m_rfFilterFftLength);
@@ -90,6 +91,8 @@ DATVideostream *DATVDemodSink::SetVideoRender(DATVideoRender *objScreen)
 {
     m_objRegisteredVideoRender = objScreen;
     m_objRegisteredVideoRender->setAudioFIFO(&m_audioFifo);
+    m_objRegisteredVideoRender->setFrameExport(&m_videoFrameBuffer);
+    m_objRegisteredVideoRender->setKeyFramesOnly(m_settings.m_keyFramesOnly);
     m_objRenderThread = new DATVideoRenderThread(m_objRegisteredVideoRender, m_objVideoStream);
     return m_objVideoStream;
 }
@@ -175,6 +178,11 @@ bool DATVDemodSink::PlayVideo(bool blnStartStop)
 
 void DATVDemodSink::CleanUpDATVFramework(bool blnRelease)
 {
+    // Pipeline stages run in their own threads: always stop them
+    if (m_objPipeline != nullptr) {
+        m_objPipeline->stop();
+    }
+
     if (blnRelease == true)
     {
         if (m_objScheduler != nullptr)
@@ -376,7 +384,7 @@ void DATVDemodSink::CleanUpDATVFramework(bool blnRelease)
 
         if(p_fecframes != nullptr)
         {
-            delete (leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> >*) p_fecframes;
+            delete (leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> >*) p_fecframes;
         }
 
         if(p_bbframes != nullptr)
@@ -386,12 +394,12 @@ void DATVDemodSink::CleanUpDATVFramework(bool blnRelease)
 
         if(p_s2_deinterleaver != nullptr)
         {
-            delete (leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>*) p_s2_deinterleaver;
+            delete (leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::llr_sb>*) p_s2_deinterleaver;
         }
 
         if(r_fecdec != nullptr)
         {
-            delete (leansdr::s2_fecdec<bool, leansdr::hard_sb>*) r_fecdec;
+            delete (leansdr::s2_fecdec_soft*) r_fecdec;
         }
 
         if(p_deframer != nullptr)
@@ -404,8 +412,19 @@ void DATVDemodSink::CleanUpDATVFramework(bool blnRelease)
             delete r_scope_symbols_dvbs2;
         }
     }
+    else if (r_fecdec != nullptr) // the LDPC worker threads must not outlive a re-init
+    {
+        ((leansdr::s2_fecdec_soft*) r_fecdec)->shutdown();
+        delete (leansdr::s2_fecdec_soft*) r_fecdec;
+    }
+
+    // The bridges are registered in the front scheduler: delete them only once it has been shut down
+    if (m_objPipeline != nullptr) {
+        delete m_objPipeline;
+    }
 
     m_objScheduler=nullptr;
+    m_objPipeline=nullptr;
 
     // INPUT
 
@@ -765,9 +784,30 @@ void DATVDemodSink::InitDATVFramework()
         r_scope_symbols->calculate_cstln_points();
     }
 
+    // PIPELINE
+    // With more than one core the inner code (deconvolution and MPEG sync) and the outer code
+    // (deinterleaving, Reed-Solomon and derandomization) run in their own threads.
+
+    leansdr::scheduler *schInner = m_objScheduler;
+    leansdr::scheduler *schOuter = m_objScheduler;
+    leansdr::pipebuf<leansdr::eucl_ss> *p_innerSymbols = p_symbols;
+
+    if (std::thread::hardware_concurrency() > 1)
+    {
+        m_objPipeline = new leansdr::pipeline(m_objScheduler);
+        schInner = m_objPipeline->add_stage("DVB-S inner code");
+        schOuter = m_objPipeline->add_stage("DVB-S outer code");
+        p_innerSymbols = m_objPipeline->link(
+            m_objScheduler, *p_symbols,
+            schInner, "PSK soft-symbols inner",
+            getPipelineBufferSize(m_objCfg.Fm, BUF_SYMBOLS),
+            getPipelineBatch(m_objCfg.Fm, BUF_SYMBOLS)
+        );
+    }
+
     // DECONVOLUTION AND SYNCHRONIZATION
 
-    p_bytes = new leansdr::pipebuf<leansdr::u8>(m_objScheduler, "bytes", BUF_BYTES);
+    p_bytes = new leansdr::pipebuf<leansdr::u8>(schInner, "bytes", BUF_BYTES);
 
     r_deconv = nullptr;
 
@@ -780,7 +820,7 @@ void DATVDemodSink::InitDATVFramework()
         }
 
         //To uncomment -> Linking Problem : undefined symbol: _ZN7leansdr21viterbi_dec_interfaceIhhiiE6updateEPiS2_
-        r = new leansdr::viterbi_sync(m_objScheduler, (*p_symbols), (*p_bytes), m_objDemodulator->cstln, m_objCfg.fec);
+        r = new leansdr::viterbi_sync(schInner, (*p_innerSymbols), (*p_bytes), m_objDemodulator->cstln, m_objCfg.fec);
 
         if (m_objCfg.fastlock) {
             r->resync_period = 1;
@@ -788,30 +828,43 @@ void DATVDemodSink::InitDATVFramework()
     }
     else
     {
-        r_deconv = make_deconvol_sync_simple(m_objScheduler, (*p_symbols), (*p_bytes), m_objCfg.fec);
+        r_deconv = make_deconvol_sync_simple(schInner, (*p_innerSymbols), (*p_bytes), m_objCfg.fec);
         r_deconv->fastlock = m_objCfg.fastlock;
     }
 
     //******* -> if ( m_objCfg.hdlc )
 
-    p_mpegbytes = new leansdr::pipebuf<leansdr::u8> (m_objScheduler, "mpegbytes", BUF_MPEGBYTES);
-    p_lock = new leansdr::pipebuf<int> (m_objScheduler, "lock", BUF_SLOW);
-    p_locktime = new leansdr::pipebuf<leansdr::u32> (m_objScheduler, "locktime", BUF_PACKETS);
+    p_mpegbytes = new leansdr::pipebuf<leansdr::u8> (schInner, "mpegbytes", BUF_MPEGBYTES);
+    p_lock = new leansdr::pipebuf<int> (schInner, "lock", BUF_SLOW);
+    p_locktime = new leansdr::pipebuf<leansdr::u32> (schInner, "locktime", BUF_PACKETS);
 
-    r_sync_mpeg = new leansdr::mpeg_sync<leansdr::u8, 0>(m_objScheduler, *p_bytes, *p_mpegbytes, r_deconv, p_lock, p_locktime);
+    r_sync_mpeg = new leansdr::mpeg_sync<leansdr::u8, 0>(schInner, *p_bytes, *p_mpegbytes, r_deconv, p_lock, p_locktime);
     r_sync_mpeg->fastlock = m_objCfg.fastlock;
 
     // DEINTERLEAVING
 
-    p_rspackets = new leansdr::pipebuf<leansdr::rspacket<leansdr::u8> >(m_objScheduler, "RS-enc packets", BUF_PACKETS);
-    r_deinter = new leansdr::deinterleaver<leansdr::u8>(m_objScheduler, *p_mpegbytes, *p_rspackets);
+    leansdr::pipebuf<leansdr::u8> *p_outerBytes = p_mpegbytes;
+
+    if (m_objPipeline)
+    {
+        // Byte rate is at most the symbol rate (up to 8 bits per symbol)
+        p_outerBytes = m_objPipeline->link(
+            schInner, *p_mpegbytes,
+            schOuter, "mpegbytes outer",
+            getPipelineBufferSize(m_objCfg.Fm, BUF_MPEGBYTES),
+            getPipelineBatch(m_objCfg.Fm, BUF_MPEGBYTES)
+        );
+    }
+
+    p_rspackets = new leansdr::pipebuf<leansdr::rspacket<leansdr::u8> >(schOuter, "RS-enc packets", BUF_PACKETS);
+    r_deinter = new leansdr::deinterleaver<leansdr::u8>(schOuter, *p_outerBytes, *p_rspackets);
 
     // REED-SOLOMON
 
-    p_vbitcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits processed", BUF_PACKETS);
-    p_verrcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits corrected", BUF_PACKETS);
-    p_rtspackets = new leansdr::pipebuf<leansdr::tspacket>(m_objScheduler, "rand TS packets", BUF_PACKETS);
-    r_rsdec = new leansdr::rs_decoder<leansdr::u8, 0>(m_objScheduler, *p_rspackets, *p_rtspackets, p_vbitcount, p_verrcount);
+    p_vbitcount = new leansdr::pipebuf<int>(schOuter, "Bits processed", BUF_PACKETS);
+    p_verrcount = new leansdr::pipebuf<int>(schOuter, "Bits corrected", BUF_PACKETS);
+    p_rtspackets = new leansdr::pipebuf<leansdr::tspacket>(schOuter, "rand TS packets", BUF_PACKETS);
+    r_rsdec = new leansdr::rs_decoder<leansdr::u8, 0>(schOuter, *p_rspackets, *p_rtspackets, p_vbitcount, p_verrcount);
 
     // BER ESTIMATION
 
@@ -827,11 +880,25 @@ void DATVDemodSink::InitDATVFramework()
      */
 
     // DERANDOMIZATION
-    p_tspackets = new leansdr::pipebuf<leansdr::tspacket>(m_objScheduler, "TS packets", BUF_PACKETS);
-    r_derand = new leansdr::derandomizer(m_objScheduler, *p_rtspackets, *p_tspackets);
+    p_tspackets = new leansdr::pipebuf<leansdr::tspacket>(schOuter, "TS packets", BUF_PACKETS);
+    r_derand = new leansdr::derandomizer(schOuter, *p_rtspackets, *p_tspackets);
 
     // OUTPUT
-    r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_tspackets, m_objVideoStream, &m_udpStream);
+    // Video and UDP streams are fed from the DSP thread
+    leansdr::pipebuf<leansdr::tspacket> *p_outputPackets = p_tspackets;
+
+    if (m_objPipeline)
+    {
+        p_outputPackets = m_objPipeline->link(
+            schOuter, *p_tspackets,
+            m_objScheduler, "TS packets output",
+            getPipelineBufferSize(m_objCfg.Fm / (8*188), BUF_PACKETS),
+            1
+        );
+        m_objPipeline->start();
+    }
+
+    r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_outputPackets, m_objVideoStream, &m_udpStream);
 
     m_blnDVBInitialized = true;
 }
@@ -1071,44 +1138,54 @@ void DATVDemodSink::InitDATVS2Framework()
         r_scope_symbols_dvbs2->calculate_cstln_points();
     }
 
-    // Bit-flipping mode.
-    // Deinterleave into hard bits.
+    // PIPELINE
+    // With more than one core deinterleaving, FEC decoding and deframing run in their own thread.
+
+    leansdr::scheduler *schFEC = m_objScheduler;
+    leansdr::pipebuf< leansdr::plslot<leansdr::llr_ss> > *p_fecSlots = (leansdr::pipebuf< leansdr::plslot<leansdr::llr_ss> > *) p_slots_dvbs2;
+
+    if (std::thread::hardware_concurrency() > 1)
+    {
+        m_objPipeline = new leansdr::pipeline(m_objScheduler);
+        schFEC = m_objPipeline->add_stage("DVB-S2 FEC");
+        p_fecSlots = m_objPipeline->link(
+            m_objScheduler, *p_fecSlots,
+            schFEC, "PL slots FEC",
+            getPipelineBufferSize(m_objCfg.Fm / leansdr::plslot<leansdr::llr_ss>::LENGTH, BUF_SLOTS),
+            getPipelineBatch(m_objCfg.Fm / leansdr::plslot<leansdr::llr_ss>::LENGTH, BUF_SLOTS)
+        );
+    }
+
+    // Soft decision mode.
+    // Deinterleave into LLRs and decode LDPC with the min-sum decoder thread pool.
 
-    p_bbframes = new leansdr::pipebuf<leansdr::bbframe>(m_objScheduler, "BB frames", BUF_FRAMES);
+    p_bbframes = new leansdr::pipebuf<leansdr::bbframe>(schFEC, "BB frames", BUF_FRAMES);
 
-    p_fecframes = new leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> >(m_objScheduler, "FEC frames", BUF_FRAMES);
+    p_fecframes = new leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> >(schFEC, "FEC frames", BUF_FRAMES);
 
-    p_s2_deinterleaver = new leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>(
-        m_objScheduler,
-        *(leansdr::pipebuf< leansdr::plslot<leansdr::llr_ss> > *) p_slots_dvbs2,
-        *(leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> > * ) p_fecframes
+    p_s2_deinterleaver = new leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::llr_sb>(
+        schFEC,
+        *p_fecSlots,
+        *(leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> > * ) p_fecframes
     );
 
-    p_vbitcount= new leansdr::pipebuf<int>(m_objScheduler, "Bits processed", BUF_S2PACKETS);
-    p_verrcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits corrected", BUF_S2PACKETS);
+    p_vbitcount= new leansdr::pipebuf<int>(schFEC, "Bits processed", BUF_S2PACKETS);
+    p_verrcount = new leansdr::pipebuf<int>(schFEC, "Bits corrected", BUF_S2PACKETS);
 
-    r_fecdec =  new leansdr::s2_fecdec<bool, leansdr::hard_sb>(
-        m_objScheduler, *(leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> > * ) p_fecframes,
+    r_fecdec =  new leansdr::s2_fecdec_soft(
+        schFEC, *(leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> > * ) p_fecframes,
         *(leansdr::pipebuf<leansdr::bbframe> *) p_bbframes,
+        0, // one thread less than the number of cores
         p_vbitcount,
         p_verrcount
     );
-    leansdr::s2_fecdec<bool, leansdr::hard_sb> *fecdec = (leansdr::s2_fecdec<bool, leansdr::hard_sb> * ) r_fecdec;
-
-    fecdec->bitflips=0;
-
-    /*
-    fecdec->bitflips = cfg.ldpc_bf; //int TODO
-    if ( ! cfg.ldpc_bf )
-    fprintf(stderr, "Warning: No LDPC error correction selected.\n")
-    */
 
     // Deframe BB frames to TS packets
-    p_lock = new leansdr::pipebuf<int> (m_objScheduler, "lock", BUF_SLOW);
-    p_locktime = new leansdr::pipebuf<leansdr::u32> (m_objScheduler, "locktime", BUF_S2PACKETS);
-    p_tspackets = new leansdr::pipebuf<leansdr::tspacket>(m_objScheduler, "TS packets", BUF_S2PACKETS);
+    p_lock = new leansdr::pipebuf<int> (schFEC, "lock", BUF_SLOW);
+    p_locktime = new leansdr::pipebuf<leansdr::u32> (schFEC, "locktime", BUF_S2PACKETS);
+    p_tspackets = new leansdr::pipebuf<leansdr::tspacket>(schFEC, "TS packets", BUF_S2PACKETS);
 
-    p_deframer = new leansdr::s2_deframer(m_objScheduler,*(leansdr::pipebuf<leansdr::bbframe> *) p_bbframes, *p_tspackets, p_lock, p_locktime);
+    p_deframer = new leansdr::s2_deframer(schFEC,*(leansdr::pipebuf<leansdr::bbframe> *) p_bbframes, *p_tspackets, p_lock, p_locktime);
 
 /*
  if ( cfg.fd_gse >= 0 ) deframer.fd_gse = cfg.fd_gse;
@@ -1116,7 +1193,21 @@ void DATVDemodSink::InitDATVS2Framework()
     //**********************************************
 
     // OUTPUT
-    r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_tspackets, m_objVideoStream, &m_udpStream);
+    // Video and UDP streams are fed from the DSP thread
+    leansdr::pipebuf<leansdr::tspacket> *p_outputPackets = p_tspackets;
+
+    if (m_objPipeline)
+    {
+        p_outputPackets = m_objPipeline->link(
+            schFEC, *p_tspackets,
+            m_objScheduler, "TS packets output",
+            getPipelineBufferSize(m_objCfg.Fm / (8*188), BUF_S2PACKETS),
+            1
+        );
+        m_objPipeline->start();
+    }
+
+    r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_outputPackets, m_objVideoStream, &m_udpStream);
 
     m_blnDVBInitialized = true;
 }
@@ -1322,6 +1413,13 @@ void DATVDemodSink::applySettings(const DATVDemodSettings& settings, bool force)
         }
     }
 
+    if ((settings.m_keyFramesOnly) != (m_settings.m_keyFramesOnly) || force)
+    {
+        if (m_objRegisteredVideoRender) {
+            m_objRegisteredVideoRender->setKeyFramesOnly(settings.m_keyFramesOnly);
+        }
+    }
+
     if ((m_settings.m_rfBandwidth != settings.m_rfBandwidth)
         || force)
     {
@@ -1358,6 +1456,20 @@ void DATVDemodSink::applySettings(const DATVDemodSettings& settings, bool force)
     m_settings = settings;
 }
 
+// Items passed between pipeline stages at once: about 1 ms worth but at most a quarter of the buffer
+unsigned long DATVDemodSink::getPipelineBatch(float itemRate, unsigned long bufSize)
+{
+    unsigned long batch = itemRate / 1000.0f;
+    return std::max(1UL, std::min(batch, bufSize / 4));
+}
+
+// Buffers between pipeline stages absorb about 100 ms of thread scheduling jitter
+unsigned long DATVDemodSink::getPipelineBufferSize(float itemRate, unsigned long minSize)
+{
+    unsigned long size = itemRate / 10.0f;
+    return std::max(size, minSize);
+}
+
 int DATVDemodSink::getLeanDVBCodeRateFromDATV(DATVDemodSettings::DATVCodeRate datvCodeRate)
 {
     if (datvCodeRate == DATVDemodSettings::DATVCodeRate::FEC12) {
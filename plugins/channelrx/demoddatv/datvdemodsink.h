@@ -26,6 +26,7 @@
 
 #include "leansdr/hdlc.h"
 #include "leansdr/iess.h"
+#include "leansdr/pipeline.h"
 
 #include "datvconstellation.h"
 #include "datvdvbs2constellation.h"
@@ -71,6 +72,7 @@ public:
     bool isCstlnSetByModcod() const { return m_cstlnSetByModcod; }
     void setMessageQueueToGUI(MessageQueue *messageQueue) { m_messageQueueToGUI = messageQueue; }
     AudioFifo *getAudioFifo() { return &m_audioFifo; }
+    VideoFrameBuffer& getVideoFrameBuffer() { return m_videoFrameBuffer; } //!< frames decoded by the registered video render
 
     void applySettings(const DATVDemodSettings& settings, bool force = false);
 	void applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force = false);
@@ -141,6 +143,8 @@ private:
 
     static int getLeanDVBCodeRateFromDATV(DATVDemodSettings::DATVCodeRate datvCodeRate);
     static int getLeanDVBModulationFromDATV(DATVDemodSettings::DATVModulation datvModulation);
+    static unsigned long getPipelineBatch(float itemRate, unsigned long bufSize);
+    static unsigned long getPipelineBufferSize(float itemRate, unsigned long minSize);
 
     MessageQueue *getMessageQueueToGUI() { return m_messageQueueToGUI; }
 
@@ -166,6 +170,7 @@ private:
     //************** LEANDBV Scheduler ***************
 
     leansdr::scheduler * m_objScheduler;
+    leansdr::pipeline * m_objPipeline; //!< Stages running in their own threads (nullptr on single core)
     struct config m_objCfg;
 
     bool m_blnDVBInitialized;
@@ -278,6 +283,7 @@ private:
     DATVideostream *m_objVideoStream;
     DATVUDPStream m_udpStream;
     DATVideoRenderThread *m_objRenderThread;
+    VideoFrameBuffer m_videoFrameBuffer;
 
     // Audio
 	AudioFifo m_audioFifo;
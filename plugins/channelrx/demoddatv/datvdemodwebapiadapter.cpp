@@ -73,6 +73,7 @@ void DATVDemodWebAPIAdapter::webapiFormatChannelSettings(
     response.getDatvDemodSettings()->setUdpTsAddress(new QString(settings.m_udpTSAddress));
     response.getDatvDemodSettings()->setUdpTsPort(settings.m_udpTSPort);
     response.getDatvDemodSettings()->setVideoMute(settings.m_videoMute ? 1 : 0);
+    response.getDatvDemodSettings()->setKeyFramesOnly(settings.m_keyFramesOnly ? 1 : 0);
     response.getDatvDemodSettings()->setViterbi(settings.m_viterbi ? 1 : 0);
 }
 
@@ -147,6 +148,9 @@ void DATVDemodWebAPIAdapter::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("videoMute")) {
         settings.m_videoMute = response.getDatvDemodSettings()->getVideoMute() != 0;
     }
+    if (channelSettingsKeys.contains("keyFramesOnly")) {
+        settings.m_keyFramesOnly = response.getDatvDemodSettings()->getKeyFramesOnly() != 0;
+    }
     if (channelSettingsKeys.contains("viterbi")) {
         settings.m_viterbi = response.getDatvDemodSettings()->getViterbi() != 0;
     }
@@ -49,6 +49,7 @@ DATVideoRender::DATVideoRender(QWidget *parent) : TVScreen(true, parent), m_pare
     m_audioStreamIndex = -1;
     m_audioMute = false;
     m_videoMute = false;
+    m_keyFramesOnly = false;
     m_audioVolume = 0;
     m_updateAudioResampler = false;
 
@@ -61,6 +62,8 @@ DATVideoRender::DATVideoRender(QWidget *parent) : TVScreen(true, parent), m_pare
     m_audioDecodeOK = false;
     m_videoDecodeOK = false;
 
+    m_videoFrameBuffer = nullptr;
+
     // for (int i = 0; i < m_audioFifoBufferSize; i++)
     // {
     //     m_audioFifoBuffer[2*i]   = 8192.0f * sin((M_PI * i)/(m_audioFifoBufferSize/1000.0f));
@@ -507,6 +510,8 @@ bool DATVideoRender::RenderStream()
         av_frame_unref(m_frame);
 
         gotFrame = 0;
+        // non key frames are dropped by the decoder itself so it costs almost nothing
+        m_videoDecoderCtx->skip_frame = m_keyFramesOnly ? AVDISCARD_NONKEY : AVDISCARD_DEFAULT;
 
         if (new_decode(m_videoDecoderCtx, m_frame, &gotFrame, &packet) >= 0)
         {
@@ -591,6 +596,10 @@ bool DATVideoRender::RenderStream()
                     return false;
                 }
 
+                if (m_videoFrameBuffer) {
+                    exportFrame();
+                }
+
                 renderImage(m_pbytDecodedData[0]);
                 av_frame_unref(m_frame);
                 m_frameCount++;
@@ -712,6 +721,22 @@ void DATVideoRender::setResampler()
         << " out_sample_fmt: " << AV_SAMPLE_FMT_S16;
 }
 
+void DATVideoRender::exportFrame()
+{
+    int width = m_frame->width;
+    int rowSize = 3 * width; // RGB24
+
+    m_videoFrameBuffer->resize(width, m_frame->height, VideoFrameBuffer::PixelRGB24);
+
+    for (int row = 0; row < m_frame->height; row++)
+    {
+        const uint8_t *src = m_pbytDecodedData[0] + row * m_pintDecodedLineSize[0];
+        std::copy(src, src + rowSize, m_videoFrameBuffer->getBackRow(row));
+    }
+
+    m_videoFrameBuffer->swap(m_frame->key_frame != 0);
+}
+
 bool DATVideoRender::CloseStream(QIODevice *device)
 {
 
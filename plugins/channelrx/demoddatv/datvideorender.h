@@ -25,6 +25,7 @@
 #include <QWidget>
 
 #include "datvideostream.h"
+#include "dsp/videoframebuffer.h"
 #include "gui/tvscreen.h"
 
 extern "C"
@@ -102,6 +103,8 @@ class DATVideoRender : public TVScreen
 
     void setAudioMute(bool audioMute) { m_audioMute = audioMute; }
     void setVideoMute(bool videoMute) { m_videoMute = videoMute; }
+    void setKeyFramesOnly(bool keyFramesOnly) { m_keyFramesOnly = keyFramesOnly; } //!< decoder skips all but key frames
+    void setFrameExport(VideoFrameBuffer *videoFrameBuffer) { m_videoFrameBuffer = videoFrameBuffer; } //!< decoded frames are also published there
     void setAudioVolume(int audioVolume);
 
     bool getAudioDecodeOK() const { return m_audioDecodeOK; }
@@ -133,6 +136,7 @@ class DATVideoRender : public TVScreen
     int m_audioFifoBufferIndex;
     bool m_audioMute;
     bool m_videoMute;
+    bool m_keyFramesOnly;
     float m_audioVolume;
     bool m_updateAudioResampler;
 
@@ -149,12 +153,15 @@ class DATVideoRender : public TVScreen
     bool m_audioDecodeOK;
     bool m_videoDecodeOK;
 
+    VideoFrameBuffer *m_videoFrameBuffer;
+
     bool InitializeFFMPEG();
     bool PreprocessStream();
     void ResetMetaData();
 
     int new_decode(AVCodecContext *avctx, AVFrame *frame, int *got_frame, AVPacket *pkt);
     void setResampler();
+    void exportFrame();
 
   protected:
     virtual bool eventFilter(QObject *obj, QEvent *event);
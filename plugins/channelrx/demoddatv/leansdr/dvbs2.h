@@ -30,9 +30,15 @@
 
 #include "crc.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
 #include "dvb.h"
 #include "softword.h"
 #include "ldpc.h"
+#include "ldpc_minsum.h"
 #include "sdr.h"
 
 namespace leansdr
@@ -2428,6 +2434,270 @@ struct s2_fecdec_helper : runnable
     pipewriter<int> *bitcount, *errcount;
 }; // s2_fecdec_helper
 
+// S2 SOFT FEC DECODER AND BASEBAND DESCRAMBLER
+// In process alternative to s2_fecdec_helper.
+// LDPC is decoded from LLRs with the layered min-sum decoder (ldpc_minsum.h).
+// Frames are decoded concurrently by a pool of worker threads and delivered
+// in order. BCH decoding and descrambling run in the scheduler thread.
+
+struct s2_fecdec_soft : runnable
+{
+    int max_iterations; // LDPC iterations limit
+
+    s2_fecdec_soft(scheduler *sch,
+                   pipebuf<fecframe<llr_sb>> &_in,
+                   pipebuf<bbframe> &_out,
+                   int nthreads = 0, // 0: one less than the number of cores
+                   pipebuf<int> *_bitcount = NULL,
+                   pipebuf<int> *_errcount = NULL)
+        : runnable(sch, "S2 fecdec soft"),
+          max_iterations(25),
+          in(_in), out(_out),
+          bitcount(opt_writer(_bitcount, 1)),
+          errcount(opt_writer(_errcount, 1)),
+          head(0),
+          tail(0),
+          stopping(false)
+    {
+        if (nthreads <= 0)
+        {
+            unsigned int ncores = std::thread::hardware_concurrency();
+            nthreads = ncores > 1 ? std::min(ncores - 1, 8U) : 1;
+        }
+
+        memset(codes, 0, sizeof(codes));
+        jobs.resize(2 * nthreads); // Keep every thread busy while the oldest frame is delivered
+
+        for (int i = 0; i < nthreads; ++i) {
+            workers.push_back(std::thread(&s2_fecdec_soft::work, this));
+        }
+
+        if (sch->debug)
+            fprintf(stderr, "S2 fecdec soft: %d threads with %s kernels\n",
+                    nthreads, ldpc_minsum_decoder::kernels_name());
+    }
+
+    ~s2_fecdec_soft()
+    {
+        shutdown();
+
+        for (int sf = 0; sf <= 1; ++sf)
+            for (int fec = 0; fec < FEC_COUNT; ++fec)
+                delete codes[sf][fec];
+    }
+
+    void shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        work_cond.notify_all();
+        done_cond.notify_all();
+
+        for (std::thread &worker : workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            while (in.readable() >= 1 && submit(in.rd()))
+                in.read(1);
+
+            bool delivered = false;
+
+            while (out.writable() >= 1 &&
+                   opt_writable(bitcount, 1) && opt_writable(errcount, 1) &&
+                   collect())
+                delivered = true;
+
+            // All jobs in flight and more input waiting: wait for the oldest
+            // frame rather than leaving the scheduler without progress.
+            if (!delivered && in.readable() >= 1 && out.writable() >= 1 &&
+                opt_writable(bitcount, 1) && opt_writable(errcount, 1) &&
+                wait_oldest())
+                continue;
+
+            break;
+        }
+    }
+
+  private:
+    enum job_state
+    {
+        JOB_FREE,
+        JOB_PENDING,
+        JOB_BUSY,
+        JOB_DONE
+    };
+
+    struct job
+    {
+        job_state state;
+        const ldpc_minsum_code *code;
+        int iterations;
+        fecframe<llr_sb> frame;
+        uint8_t hard[64800 / 8];
+
+        job() : state(JOB_FREE), code(NULL), iterations(0) {}
+    };
+
+    // Queue a frame for decoding. Return false if all jobs are in flight.
+    bool submit(const fecframe<llr_sb> *pin)
+    {
+        job &j = jobs[tail];
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (j.state != JOB_FREE)
+                return false;
+        }
+
+        const modcod_info *mcinfo = check_modcod(pin->pls.modcod);
+        const fec_info *fi = &fec_infos[pin->pls.sf][mcinfo->rate];
+
+        if (!fi->ldpc)
+            return true; // Not decodable: drop
+
+        ldpc_minsum_code *&code = codes[pin->pls.sf][mcinfo->rate];
+
+        if (!code)
+            code = new ldpc_minsum_code(fi->ldpc, fi->kldpc, pin->pls.framebits());
+
+        j.code = code;
+        j.frame.pls = pin->pls;
+        memcpy(j.frame.bytes, pin->bytes, (pin->pls.framebits() / 8) * sizeof(llr_sb));
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            j.state = JOB_PENDING;
+        }
+
+        work_cond.notify_one();
+        tail = (tail + 1) % jobs.size();
+        return true;
+    }
+
+    // Deliver the oldest frame if decoded. Return false otherwise.
+    bool collect()
+    {
+        job &j = jobs[head];
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (j.state != JOB_DONE)
+                return false;
+        }
+
+        const s2_pls *pls = &j.frame.pls;
+        const modcod_info *mcinfo = check_modcod(pls->modcod);
+        const fec_info *fi = &fec_infos[pls->sf][mcinfo->rate];
+        if (sch->debug2)
+            fprintf(stderr, "LDPCITER = %d\n", j.iterations);
+        // BCH decode
+        size_t cwbytes = fi->kldpc / 8;
+        bch_interface *bch = s2bch.bchs[pls->sf][mcinfo->rate];
+        int ncorr = bch->decode(j.hard, cwbytes);
+        if (sch->debug2)
+            fprintf(stderr, "BCHCORR = %d\n", ncorr);
+        bool corrupted = (ncorr < 0);
+        // Report VBER
+        opt_write(bitcount, fi->Kbch);
+        opt_write(errcount, (ncorr >= 0) ? ncorr : fi->Kbch);
+        if (!corrupted)
+        {
+            // Descramble and output
+            bbframe *pout = out.wr();
+            pout->pls = *pls;
+            bbscrambling.transform(j.hard, fi->Kbch / 8, pout->bytes);
+            out.written(1);
+        }
+        if (sch->debug)
+            fprintf(stderr, "%c", corrupted ? '!' : (j.iterations != 0 || ncorr) ? '.' : '_');
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            j.state = JOB_FREE;
+        }
+
+        head = (head + 1) % jobs.size();
+        return true;
+    }
+
+    // Block until the oldest frame is decoded. Return false on shutdown.
+    bool wait_oldest()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if (jobs[head].state == JOB_FREE)
+            return false; // Nothing in flight
+
+        while (!stopping && jobs[head].state != JOB_DONE)
+            done_cond.wait(lock);
+
+        return !stopping;
+    }
+
+    // Oldest pending job or NULL. Call with mutex locked.
+    job *next_pending()
+    {
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            job &j = jobs[(head + i) % jobs.size()];
+            if (j.state == JOB_PENDING)
+                return &j;
+        }
+
+        return NULL;
+    }
+
+    // Worker thread
+    void work()
+    {
+        ldpc_minsum_decoder decoder;
+        std::unique_lock<std::mutex> lock(mutex);
+
+        for (;;)
+        {
+            job *j = NULL;
+
+            while (!stopping && !(j = next_pending()))
+                work_cond.wait(lock);
+
+            if (stopping)
+                return;
+
+            j->state = JOB_BUSY;
+            lock.unlock();
+            j->iterations = decoder.decode(*j->code, (const int8_t *)j->frame.bytes, j->hard, max_iterations);
+            lock.lock();
+            j->state = JOB_DONE;
+            done_cond.notify_all();
+        }
+    }
+
+    pipereader<fecframe<llr_sb>> in;
+    pipewriter<bbframe> out;
+    pipewriter<int> *bitcount, *errcount;
+    s2_bch_engines s2bch;
+    s2_bbscrambling bbscrambling;
+    ldpc_minsum_code *codes[2][FEC_COUNT]; // [shortframes][fec], built on first use
+    std::vector<job> jobs;                 // Ring of frames in flight
+    size_t head;                           // Oldest job
+    size_t tail;                           // Next job to fill
+    std::vector<std::thread> workers;
+    std::mutex mutex;                      // Protects job states
+    std::condition_variable work_cond;
+    std::condition_variable done_cond;
+    bool stopping;
+}; // s2_fecdec_soft
+
 // S2 FRAMER
 // EN 302 307-1 section 5.1 Mode adaptation
 
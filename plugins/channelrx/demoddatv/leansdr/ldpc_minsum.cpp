@@ -0,0 +1,389 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "ldpc_minsum.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LDPC_MINSUM_X86
+#include <immintrin.h>
+#endif
+
+namespace leansdr
+{
+
+namespace
+{
+
+struct minsum_kernels
+{
+    const char *name;
+    // Check node update of one layer over PADDED_LANES lanes.
+    // On input q[e] holds the gathered posteriors and r[e] the previous messages.
+    // On output r[e] holds the new messages and q[e] the message variation to add to the posteriors.
+    void (*check_update)(int8_t *const *q, int8_t *const *r, int deg, int offset);
+    void (*add_saturate)(int8_t *dst, const int8_t *src, int n);
+};
+
+inline int8_t sat8(int v)
+{
+    return v < -128 ? -128 : v > 127 ? 127 : v;
+}
+
+void check_update_generic(int8_t *const *q, int8_t *const *r, int deg, int offset)
+{
+    for (int t = 0; t < ldpc_minsum_code::PADDED_LANES; ++t)
+    {
+        int min1 = 127, min2 = 127, idx = 0, sgn = 0;
+
+        for (int e = 0; e < deg; ++e)
+        {
+            int8_t v = sat8(q[e][t] - r[e][t]);
+            q[e][t] = v;
+            int mag = v < 0 ? -v : v;
+            mag = mag > 127 ? 127 : mag;
+            min2 = std::min(min2, std::max(min1, mag));
+            min1 = std::min(min1, mag);
+
+            if (mag == min1) {
+                idx = e;
+            }
+
+            sgn ^= v;
+        }
+
+        for (int e = 0; e < deg; ++e)
+        {
+            int mag = (e == idx) ? min2 : min1;
+            mag = mag > offset ? mag - offset : 0;
+            int8_t m = ((sgn ^ q[e][t]) & 0x80) ? -mag : mag;
+            q[e][t] = sat8(m - r[e][t]);
+            r[e][t] = m;
+        }
+    }
+}
+
+void add_saturate_generic(int8_t *dst, const int8_t *src, int n)
+{
+    for (int i = 0; i < n; ++i) {
+        dst[i] = sat8(dst[i] + src[i]);
+    }
+}
+
+const minsum_kernels kernels_generic = {
+    "generic",
+    check_update_generic,
+    add_saturate_generic
+};
+
+#ifdef LDPC_MINSUM_X86
+
+__attribute__((target("avx2")))
+void check_update_avx2(int8_t *const *q, int8_t *const *r, int deg, int offset)
+{
+    const __m256i v127 = _mm256_set1_epi8(127);
+    const __m256i vOne = _mm256_set1_epi8(1);
+    const __m256i vOffset = _mm256_set1_epi8(offset);
+
+    for (int t = 0; t < ldpc_minsum_code::PADDED_LANES; t += 32)
+    {
+        __m256i min1 = v127;
+        __m256i min2 = v127;
+        __m256i idx = _mm256_setzero_si256();
+        __m256i sgn = _mm256_setzero_si256();
+
+        for (int e = 0; e < deg; ++e)
+        {
+            __m256i v = _mm256_subs_epi8(
+                _mm256_loadu_si256((const __m256i *) &q[e][t]),
+                _mm256_loadu_si256((const __m256i *) &r[e][t]));
+            _mm256_storeu_si256((__m256i *) &q[e][t], v);
+            __m256i mag = _mm256_min_epu8(_mm256_abs_epi8(v), v127);
+            min2 = _mm256_min_epu8(min2, _mm256_max_epu8(min1, mag));
+            min1 = _mm256_min_epu8(min1, mag);
+            idx = _mm256_blendv_epi8(idx, _mm256_set1_epi8(e), _mm256_cmpeq_epi8(mag, min1));
+            sgn = _mm256_xor_si256(sgn, v);
+        }
+
+        for (int e = 0; e < deg; ++e)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i *) &q[e][t]);
+            __m256i rOld = _mm256_loadu_si256((const __m256i *) &r[e][t]);
+            __m256i mag = _mm256_blendv_epi8(min1, min2, _mm256_cmpeq_epi8(idx, _mm256_set1_epi8(e)));
+            mag = _mm256_subs_epu8(mag, vOffset);
+            __m256i m = _mm256_sign_epi8(mag, _mm256_or_si256(_mm256_xor_si256(sgn, v), vOne));
+            _mm256_storeu_si256((__m256i *) &q[e][t], _mm256_subs_epi8(m, rOld));
+            _mm256_storeu_si256((__m256i *) &r[e][t], m);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void add_saturate_avx2(int8_t *dst, const int8_t *src, int n)
+{
+    int i = 0;
+
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_adds_epi8(
+            _mm256_loadu_si256((const __m256i *) &dst[i]),
+            _mm256_loadu_si256((const __m256i *) &src[i]));
+        _mm256_storeu_si256((__m256i *) &dst[i], v);
+    }
+
+    add_saturate_generic(&dst[i], &src[i], n - i);
+}
+
+const minsum_kernels kernels_avx2 = {
+    "AVX2",
+    check_update_avx2,
+    add_saturate_avx2
+};
+
+#endif // LDPC_MINSUM_X86
+
+const minsum_kernels &select_kernels()
+{
+#ifdef LDPC_MINSUM_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return kernels_avx2;
+    }
+#endif
+    return kernels_generic;
+}
+
+const minsum_kernels &kernels()
+{
+    static const minsum_kernels &selected = select_kernels();
+    return selected;
+}
+
+// dst[t] = src[(t-shift) mod LANES]
+inline void gather(int8_t *dst, const int8_t *src, int shift)
+{
+    const int L = ldpc_minsum_code::LANES;
+    memcpy(dst + shift, src, L - shift);
+    memcpy(dst, src + L - shift, shift);
+}
+
+// dst[(t-shift) mod LANES] += delta[t]
+inline void scatter_add(int8_t *dst, const int8_t *delta, int shift, const minsum_kernels &k)
+{
+    const int L = ldpc_minsum_code::LANES;
+    k.add_saturate(dst, delta + shift, L - shift);
+    k.add_saturate(dst + L - shift, delta, shift);
+}
+
+} // namespace
+
+void ldpc_minsum_code::build(const std::vector<std::vector<int>> &rows)
+{
+    int nrows = rows.size();
+
+    if (k != nrows * LANES) {
+        fatal("ldpc_minsum_code: bad table");
+    }
+    if (q * LANES != n - k) {
+        fatal("ldpc_minsum_code: bad q");
+    }
+
+    layers.resize(q + 1);
+
+    for (int s = 0; s < q; ++s)
+    {
+        layers[s] = edges.size();
+
+        for (int r = 0; r < nrows; ++r)
+        {
+            for (int a : rows[r])
+            {
+                if (a % q == s) {
+                    edges.push_back(edge{r, a / q, false});
+                }
+            }
+        }
+
+        // Parity accumulator: check s+q*t involves parity bits s+q*t and s+q*t-1
+        edges.push_back(edge{nrows + s, 0, false});
+
+        if (s > 0) {
+            edges.push_back(edge{nrows + s - 1, 0, false});
+        } else {
+            edges.push_back(edge{nrows + q - 1, 1, true});
+        }
+
+        max_degree = std::max(max_degree, (int) edges.size() - layers[s]);
+    }
+
+    layers[q] = edges.size();
+
+    if (max_degree > 127) { // edge index is tracked on 8 bits
+        fatal("ldpc_minsum_code: check node degree too large");
+    }
+}
+
+ldpc_minsum_decoder::ldpc_minsum_decoder() :
+    offset(1)
+{
+}
+
+const char *ldpc_minsum_decoder::kernels_name()
+{
+    return kernels().name;
+}
+
+void ldpc_minsum_decoder::load(const ldpc_minsum_code &code, const int8_t *llrs)
+{
+    const int L = ldpc_minsum_code::LANES;
+    posteriors.resize(code.ngroups * L);
+    messages.assign(code.edges.size() * ldpc_minsum_code::PADDED_LANES, 0);
+    work.assign(code.max_degree * ldpc_minsum_code::PADDED_LANES, 0);
+    qptrs.resize(code.max_degree);
+    rptrs.resize(code.max_degree);
+
+    // Halve the channel LLRs to leave room for the extrinsic information
+    for (int b = 0; b < code.k; ++b) {
+        posteriors[b] = llrs[b] >> 1;
+    }
+
+    int8_t *parity = &posteriors[code.k];
+
+    for (int j = 0; j < code.n - code.k; ++j) {
+        parity[(j % code.q) * L + j / code.q] = llrs[code.k + j] >> 1;
+    }
+}
+
+void ldpc_minsum_decoder::process_layer(const ldpc_minsum_code &code, int layer)
+{
+    const minsum_kernels &k = kernels();
+    const int L = ldpc_minsum_code::LANES;
+    const int P = ldpc_minsum_code::PADDED_LANES;
+    int first = code.layers[layer];
+    int deg = code.layers[layer + 1] - first;
+
+    for (int e = 0; e < deg; ++e)
+    {
+        const ldpc_minsum_code::edge &ed = code.edges[first + e];
+        qptrs[e] = &work[e * P];
+        rptrs[e] = &messages[(first + e) * P];
+        gather(qptrs[e], &posteriors[ed.group * L], ed.shift);
+
+        if (ed.masked) {
+            qptrs[e][0] = 127; // Not connected: certain and neutral
+        }
+    }
+
+    k.check_update(qptrs.data(), rptrs.data(), deg, offset);
+
+    for (int e = 0; e < deg; ++e)
+    {
+        const ldpc_minsum_code::edge &ed = code.edges[first + e];
+
+        if (ed.masked)
+        {
+            qptrs[e][0] = 0;
+            rptrs[e][0] = 0;
+        }
+
+        // Variation is applied rather than the new value because the same group
+        // may be connected more than once to the layer with different shifts.
+        scatter_add(&posteriors[ed.group * L], qptrs[e], ed.shift, k);
+    }
+}
+
+bool ldpc_minsum_decoder::check_syndrome(const ldpc_minsum_code &code)
+{
+    const int L = ldpc_minsum_code::LANES;
+    int8_t *gathered = &work[0];
+    int8_t *acc = &work[ldpc_minsum_code::PADDED_LANES];
+
+    for (int s = 0; s < code.q; ++s)
+    {
+        memset(acc, 0, L);
+
+        for (int e = code.layers[s]; e < code.layers[s + 1]; ++e)
+        {
+            const ldpc_minsum_code::edge &ed = code.edges[e];
+            gather(gathered, &posteriors[ed.group * L], ed.shift);
+
+            if (ed.masked) {
+                gathered[0] = 0;
+            }
+
+            for (int t = 0; t < L; ++t) {
+                acc[t] ^= gathered[t];
+            }
+        }
+
+        int bad = 0;
+
+        for (int t = 0; t < L; ++t) {
+            bad |= acc[t];
+        }
+
+        if (bad & 0x80) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ldpc_minsum_decoder::harden(const ldpc_minsum_code &code, uint8_t *hard)
+{
+    for (int i = 0; i < code.k / 8; ++i)
+    {
+        const int8_t *p = &posteriors[8 * i];
+        hard[i] = ((p[0] & 0x80) >> 0) |
+                  ((p[1] & 0x80) >> 1) |
+                  ((p[2] & 0x80) >> 2) |
+                  ((p[3] & 0x80) >> 3) |
+                  ((p[4] & 0x80) >> 4) |
+                  ((p[5] & 0x80) >> 5) |
+                  ((p[6] & 0x80) >> 6) |
+                  ((p[7] & 0x80) >> 7);
+    }
+}
+
+int ldpc_minsum_decoder::decode(const ldpc_minsum_code &code, const int8_t *llrs, uint8_t *hard, int max_iterations)
+{
+    load(code, llrs);
+    int iterations = -1;
+
+    for (int it = 0; ; ++it)
+    {
+        if (check_syndrome(code))
+        {
+            iterations = it;
+            break;
+        }
+
+        if (it == max_iterations) {
+            break;
+        }
+
+        for (int s = 0; s < code.q; ++s) {
+            process_layer(code, s);
+        }
+    }
+
+    harden(code, hard);
+    return iterations;
+}
+
+} // namespace leansdr
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LEANSDR_LDPC_MINSUM_H
+#define LEANSDR_LDPC_MINSUM_H
+
+#include <vector>
+
+#include "framework.h"
+
+namespace leansdr
+{
+
+// LDPC MIN-SUM CODE
+// Parity check graph of a DVB-S2 code arranged for layered decoding.
+//
+// The check nodes are reordered as c = s + q*t so that each layer s (0..q-1)
+// holds 360 check nodes (lanes t) and every edge of the layer connects the 360
+// lanes to a group of 360 variable nodes through a circular shift.
+// Variable groups 0..nrows-1 are the message bits (bit 360*r+i is lane i of group r).
+// Variable groups nrows..nrows+q-1 are the parity bits (bit k+s+q*t is lane t of group nrows+s).
+
+struct ldpc_minsum_code
+{
+    struct edge
+    {
+        int group;   // Variable group
+        int shift;   // Lane t of the layer reads lane (t-shift) mod 360 of the group
+        bool masked; // Lane 0 is not connected (first check of the parity accumulator)
+    };
+
+    static const int LANES = 360;
+    static const int PADDED_LANES = 384; // Multiple of the widest vector
+
+    int k;       // Message size in bits
+    int n;       // Codeword size in bits
+    int q;       // Number of layers
+    int ngroups; // Number of variable groups
+    int max_degree;
+    std::vector<edge> edges;
+    std::vector<int> layers; // Edges of layer s are [layers[s], layers[s+1])
+
+    // TABLE is a DVB-S2 style table (see ldpc_table in ldpc.h)
+    template <typename TABLE>
+    ldpc_minsum_code(const TABLE *table, int _k, int _n)
+        : k(_k), n(_n), q(table->q), ngroups(table->nrows + table->q), max_degree(0)
+    {
+        std::vector<std::vector<int>> rows(table->nrows);
+
+        for (int r = 0; r < table->nrows; ++r) {
+            rows[r].assign(table->rows[r].cols, table->rows[r].cols + table->rows[r].ncols);
+        }
+
+        build(rows);
+    }
+
+  private:
+    void build(const std::vector<std::vector<int>> &rows);
+};
+
+// LDPC MIN-SUM DECODER
+// Layered offset min-sum decoder working on 8 bit LLRs (positive for 0),
+// 360 check nodes at a time. The check node kernels are selected at run time
+// (AVX2 when available, plain C++ otherwise).
+// An instance holds the working memory of one decoding thread and can decode any code.
+
+struct ldpc_minsum_decoder
+{
+    int offset; // Offset applied to the check node magnitudes (LLR units after input scaling)
+
+    ldpc_minsum_decoder();
+
+    // llrs: n channel LLRs in codeword order (as in fecframe<llr_sb>)
+    // hard: receives the k decoded message bits packed MSB first
+    // Returns the number of iterations that led to a valid codeword or -1 when
+    // max_iterations were not enough (hard still holds the best guess).
+    int decode(const ldpc_minsum_code &code, const int8_t *llrs, uint8_t *hard, int max_iterations);
+
+    static const char *kernels_name();
+
+  private:
+    std::vector<int8_t> posteriors; // [ngroups][LANES]
+    std::vector<int8_t> messages;   // Check to variable messages [edges][PADDED_LANES]
+    std::vector<int8_t> work;       // [max_degree][PADDED_LANES]
+    std::vector<int8_t *> qptrs;
+    std::vector<int8_t *> rptrs;
+
+    void load(const ldpc_minsum_code &code, const int8_t *llrs);
+    void process_layer(const ldpc_minsum_code &code, int layer);
+    bool check_syndrome(const ldpc_minsum_code &code);
+    void harden(const ldpc_minsum_code &code, uint8_t *hard);
+};
+
+} // namespace leansdr
+
+#endif // LEANSDR_LDPC_MINSUM_H
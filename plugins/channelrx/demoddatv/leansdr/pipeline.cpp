@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+
+#include "pipeline.h"
+
+namespace leansdr
+{
+
+pipeline_stage::pipeline_stage(const char *_name, int _timeout_ms) :
+    name(_name),
+    timeout_ms(_timeout_ms),
+    woken(false),
+    stopping(false)
+{
+}
+
+pipeline_stage::~pipeline_stage()
+{
+    stop();
+}
+
+void pipeline_stage::start()
+{
+    if (!thread.joinable())
+        thread = std::thread(&pipeline_stage::loop, this);
+}
+
+void pipeline_stage::stop()
+{
+    bool first;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        first = !stopping;
+        stopping = true;
+    }
+
+    cond.notify_one();
+
+    if (thread.joinable())
+        thread.join();
+
+    if (first)
+        sch.shutdown();
+}
+
+void pipeline_stage::wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        woken = true;
+    }
+
+    cond.notify_one();
+}
+
+void pipeline_stage::loop()
+{
+    if (sch.debug)
+        fprintf(stderr, "pipeline stage %s: started\n", name);
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (!stopping)
+    {
+        cond.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]{ return woken || stopping; });
+
+        if (stopping)
+            break;
+
+        woken = false;
+        lock.unlock();
+        sch.run();
+        lock.lock();
+    }
+}
+
+pipeline::pipeline(scheduler *_front, int _timeout_ms) :
+    front(_front),
+    timeout_ms(_timeout_ms)
+{
+}
+
+pipeline::~pipeline()
+{
+    stop();
+
+    // Stages hold the schedulers the bridging runnables and pipes register with
+    for (runnable_common *r : runnables)
+        delete r;
+    for (pipebuf_common *p : pipes)
+        delete p;
+    for (pipe_bridge_common *b : bridges)
+        delete b;
+    for (pipeline_stage *s : stages)
+        delete s;
+}
+
+scheduler *pipeline::add_stage(const char *name)
+{
+    pipeline_stage *stage = new pipeline_stage(name, timeout_ms);
+    stage->sch.verbose = front->verbose;
+    stage->sch.debug = front->debug;
+    stage->sch.debug2 = front->debug2;
+    stages.push_back(stage);
+    return &stage->sch;
+}
+
+void pipeline::start()
+{
+    for (pipeline_stage *s : stages)
+        s->start();
+}
+
+void pipeline::stop()
+{
+    for (pipeline_stage *s : stages)
+        s->stop();
+}
+
+unsigned long pipeline::dropped() const
+{
+    unsigned long total = 0;
+
+    for (pipe_bridge_common *b : bridges)
+        total += b->dropped;
+
+    return total;
+}
+
+pipeline_stage *pipeline::find_stage(scheduler *sch)
+{
+    for (pipeline_stage *s : stages)
+    {
+        if (&s->sch == sch)
+            return s;
+    }
+
+    return NULL; // Front stage
+}
+
+} // namespace leansdr
@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LEANSDR_PIPELINE_H
+#define LEANSDR_PIPELINE_H
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+#include "framework.h"
+
+namespace leansdr
+{
+
+// PIPELINED SCHEDULING
+// A [pipeline] splits a flowgraph in stages. The first stage is the caller's
+// scheduler, stepped as usual. Each other stage has its own scheduler run
+// to fixpoint in its own thread.
+// Stages do not share [pipebuf]s: a [pipebuf] in one stage is connected to a
+// [pipebuf] in another stage by a [pipe_bridge], a lock-free single producer
+// single consumer ring fed by a [bridge_sender] and drained by a [bridge_receiver].
+// The consuming stage is woken up once per batch of items so that the
+// synchronization cost is paid per batch and not per item. It also wakes up
+// on its own after a timeout so that an incomplete batch is not held forever.
+
+struct pipeline_stage
+{
+    scheduler sch;
+
+    pipeline_stage(const char *_name, int _timeout_ms);
+    ~pipeline_stage();
+
+    void start();
+    void stop(); // Join the thread and shut the runnables down (once)
+    void wake();
+
+  private:
+    void loop();
+
+    const char *name;
+    int timeout_ms;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool woken;
+    bool stopping;
+};
+
+struct pipe_bridge_common
+{
+    unsigned long dropped; // Items lost because the ring was full
+
+    pipe_bridge_common() : dropped(0)
+    {
+    }
+
+    virtual ~pipe_bridge_common()
+    {
+    }
+};
+
+template <typename T>
+struct pipe_bridge : pipe_bridge_common
+{
+    pipe_bridge(unsigned long _size) : buf(new T[_size + 1]),
+                                       size(_size + 1),
+                                       head(0),
+                                       tail(0)
+    {
+    }
+
+    ~pipe_bridge()
+    {
+        delete[] buf;
+    }
+
+    // Producer side. Return the number of items queued.
+    unsigned long push(const T *data, unsigned long n)
+    {
+        unsigned long t = tail.load(std::memory_order_relaxed);
+        unsigned long h = head.load(std::memory_order_acquire);
+        unsigned long room = (h + size - t - 1) % size;
+
+        if (n > room)
+            n = room;
+
+        unsigned long first = std::min(n, size - t);
+        std::copy(data, data + first, buf + t);
+        std::copy(data + first, data + n, buf);
+        tail.store((t + n) % size, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer side. Return the number of items dequeued.
+    unsigned long pop(T *data, unsigned long n)
+    {
+        unsigned long h = head.load(std::memory_order_relaxed);
+        unsigned long t = tail.load(std::memory_order_acquire);
+        unsigned long count = (t + size - h) % size;
+
+        if (n > count)
+            n = count;
+
+        unsigned long first = std::min(n, size - h);
+        std::copy(buf + h, buf + h + first, data);
+        std::copy(buf, buf + n - first, data + first);
+        head.store((h + n) % size, std::memory_order_release);
+        return n;
+    }
+
+  private:
+    T *buf;
+    unsigned long size;
+    std::atomic<unsigned long> head; // Written by the consumer only
+    std::atomic<unsigned long> tail; // Written by the producer only
+};
+
+// Moves everything readable from a pipebuf into a bridge.
+// When the bridge is full the excess is dropped rather than stalling the
+// upstream stage (which for the first stage would overflow the sample input).
+
+template <typename T>
+struct bridge_sender : runnable
+{
+    bridge_sender(scheduler *sch,
+                  pipebuf<T> &_in,
+                  pipe_bridge<T> &_bridge,
+                  pipeline_stage *_consumer, // NULL when the consumer is the polled first stage
+                  unsigned long _batch)
+        : runnable(sch, _in.name),
+          in(_in),
+          bridge(_bridge),
+          consumer(_consumer),
+          batch(_batch),
+          unsignaled(0)
+    {
+    }
+
+    void run()
+    {
+        unsigned long count = in.readable();
+
+        if (!count)
+            return;
+
+        unsigned long n = bridge.push(in.rd(), count);
+
+        if (n < count)
+        {
+            bridge.dropped += count - n;
+            if (sch->debug)
+                fprintf(stderr, "bridge %s: dropped %lu\n", in.buf.name, count - n);
+        }
+
+        in.read(count);
+        unsignaled += n;
+
+        if (consumer && unsignaled >= batch)
+        {
+            consumer->wake();
+            unsignaled = 0;
+        }
+    }
+
+  private:
+    pipereader<T> in;
+    pipe_bridge<T> &bridge;
+    pipeline_stage *consumer;
+    unsigned long batch;
+    unsigned long unsignaled; // Items pushed since the consumer was last woken up
+};
+
+template <typename T>
+struct bridge_receiver : runnable
+{
+    bridge_receiver(scheduler *sch,
+                    pipe_bridge<T> &_bridge,
+                    pipebuf<T> &_out)
+        : runnable(sch, _out.name),
+          bridge(_bridge),
+          out(_out)
+    {
+    }
+
+    void run()
+    {
+        unsigned long n = bridge.pop(out.wr(), out.writable());
+
+        if (n)
+            out.written(n);
+    }
+
+  private:
+    pipe_bridge<T> &bridge;
+    pipewriter<T> out;
+};
+
+struct pipeline
+{
+    pipeline(scheduler *_front, int _timeout_ms = 20);
+    ~pipeline();
+
+    // Create a stage running in its own thread and return its scheduler.
+    scheduler *add_stage(const char *name);
+
+    // Carry the items written to [in] (in scheduler [from]) to a new pipebuf in scheduler [to].
+    // [batch] is the number of items after which the consumer stage is woken up.
+    // The returned pipebuf and the bridging runnables are owned by the pipeline.
+    template <typename T>
+    pipebuf<T> *link(scheduler *from, pipebuf<T> &in,
+                     scheduler *to, const char *name,
+                     unsigned long size, unsigned long batch)
+    {
+        pipe_bridge<T> *bridge = new pipe_bridge<T>(size);
+        pipebuf<T> *out = new pipebuf<T>(to, name, size);
+        bridges.push_back(bridge);
+        pipes.push_back(out);
+        runnables.push_back(new bridge_sender<T>(from, in, *bridge, find_stage(to), std::max(batch, 1UL)));
+        runnables.push_back(new bridge_receiver<T>(to, *bridge, *out));
+        return out;
+    }
+
+    void start();
+    void stop(); // Join all stage threads. Safe to call more than once.
+    unsigned long dropped() const; // Items dropped by all bridges so far
+    int nstages() const { return stages.size(); }
+
+  private:
+    pipeline_stage *find_stage(scheduler *sch);
+
+    scheduler *front;
+    int timeout_ms;
+    std::vector<pipeline_stage *> stages;
+    std::vector<pipe_bridge_common *> bridges;
+    std::vector<pipebuf_common *> pipes;
+    std::vector<runnable_common *> runnables;
+};
+
+} // namespace leansdr
+
+#endif // LEANSDR_PIPELINE_H
@@ -108,6 +108,11 @@ void DSDDemod::stop()
 	m_thread->wait();
 }
 
+void DSDDemod::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool DSDDemod::handleMessage(const Message& cmd)
 {
 	qDebug() << "DSDDemod::handleMessage";
@@ -75,6 +75,8 @@ DSDDemodSink::DSDDemodSink() :
 
 DSDDemodSink::~DSDDemodSink()
 {
+    DSPEngine::instance()->releaseMbeChannel(&m_audioFifo1);
+    DSPEngine::instance()->releaseMbeChannel(&m_audioFifo2);
     delete[] m_sampleBuffer;
 }
 
@@ -84,7 +86,8 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
 
 	m_scopeSampleBuffer.clear();
 
-	m_dsdDecoder.enableMbelib(!DSPEngine::instance()->hasDVSerialSupport()); // disable mbelib if DV serial support is present and activated else enable it
+	bool mbeOffload = DSPEngine::instance()->hasMbeOffloadSupport();
+	m_dsdDecoder.enableMbelib(!mbeOffload); // disable mbelib if frames are decoded by DV serial devices or the vocoder pool else enable it
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
@@ -199,7 +202,7 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
                 m_scopeSampleBuffer.push_back(s);
             }
 
-            if (DSPEngine::instance()->hasDVSerialSupport())
+            if (mbeOffload)
             {
                 if ((m_settings.m_slot1On) && m_dsdDecoder.mbeDVReady1())
                 {
@@ -240,7 +243,7 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
         }
 	}
 
-	if (!DSPEngine::instance()->hasDVSerialSupport())
+	if (!mbeOffload)
 	{
 	    if (m_settings.m_slot1On)
 	    {
@@ -101,6 +101,11 @@ void FreeDVDemod::stop()
 	m_thread->wait();
 }
 
+void FreeDVDemod::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool FreeDVDemod::handleMessage(const Message& cmd)
 {
     if (MsgConfigureFreeDVDemod::match(cmd))
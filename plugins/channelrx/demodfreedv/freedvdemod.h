@@ -83,6 +83,7 @@ public:
 	virtual void start();
 	virtual void stop();
 	virtual bool handleMessage(const Message& cmd);
+	virtual void setCompactSamples(bool compactSamples);
 
     virtual void getIdentifier(QString& id) { id = objectName(); }
     virtual void getTitle(QString& title) { title = m_settings.m_title; }
@@ -110,6 +111,8 @@ public:
 	int getBER() const { return m_basebandSink->getBER(); }
 	float getFrequencyOffset() const { return m_basebandSink->getFrequencyOffset(); }
 	bool isSync() const { return m_basebandSink->isSync(); }
+	bool isAcquiring() const { return m_basebandSink->isAcquiring(); }
+	FreeDVDemodSettings::FreeDVMode getRxMode() const { return m_basebandSink->getRxMode(); }
     void propagateMessageQueueToGUI() { m_basebandSink->setMessageQueueToGUI(getMessageQueueToGUI()); }
 
     virtual int webapiSettingsGet(
@@ -73,6 +73,7 @@ public:
     ~FreeDVDemodBaseband();
     void reset();
     void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void setCompactSamples(bool compactSamples) { m_sampleFifo.setCompact(compactSamples); }
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     int getChannelSampleRate() const;
     int getAudioSampleRate() const { return m_sink.getAudioSampleRate(); }
@@ -89,6 +90,8 @@ public:
 	int getBER() const { return m_sink.getBER(); }
 	float getFrequencyOffset() const { return m_sink.getFrequencyOffset(); }
 	bool isSync() const { return m_sink.isSync(); }
+	bool isAcquiring() const { return m_sink.isAcquiring(); }
+	FreeDVDemodSettings::FreeDVMode getRxMode() const { return m_sink.getRxMode(); }
 
 signals:
 	/**
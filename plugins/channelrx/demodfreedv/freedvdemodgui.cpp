@@ -162,7 +162,8 @@ void FreeDVDemodGUI::on_reSync_clicked(bool checked)
 
 void FreeDVDemodGUI::on_freeDVMode_currentIndexChanged(int index)
 {
-    m_settings.m_freeDVMode = (FreeDVDemodSettings::FreeDVMode) index;
+    // 700D is not proposed on its own: the item following 700C is the auto mode
+    m_settings.m_freeDVMode = index == 4 ? FreeDVDemodSettings::FreeDVModeAuto : (FreeDVDemodSettings::FreeDVMode) index;
     m_channelMarker.setBandwidth(FreeDVDemodSettings::getHiCutoff(m_settings.m_freeDVMode) * 2);
     m_channelMarker.setLowCutoff(FreeDVDemodSettings::getLowCutoff(m_settings.m_freeDVMode));
     m_channelMarker.setSidebands(ChannelMarker::usb);
@@ -394,7 +395,7 @@ void FreeDVDemodGUI::displaySettings()
 
     blockApplySettings(true);
 
-    ui->freeDVMode->setCurrentIndex((int) m_settings.m_freeDVMode);
+    ui->freeDVMode->setCurrentIndex(m_settings.m_freeDVMode == FreeDVDemodSettings::FreeDVModeAuto ? 4 : (int) m_settings.m_freeDVMode);
     ui->agc->setChecked(m_settings.m_agc);
     ui->audioMute->setChecked(m_settings.m_audioMute);
     ui->deltaFrequency->setValue(m_channelMarker.getCenterFrequency());
@@ -482,6 +483,15 @@ void FreeDVDemodGUI::tick()
         ui->syncLabel->setStyleSheet("QLabel { background:rgb(79,79,79); }");
     }
 
+    if (m_settings.m_freeDVMode == FreeDVDemodSettings::FreeDVModeAuto)
+    {
+        if (m_freeDVDemod->isAcquiring()) {
+            ui->syncLabel->setToolTip(tr("Auto: searching"));
+        } else {
+            ui->syncLabel->setToolTip(tr("Auto: locked on %1").arg(FreeDVDemodSettings::getModeName(m_freeDVDemod->getRxMode())));
+        }
+    }
+
     if (m_tickCount % 4 == 0) {
         ui->channelPower->setText(tr("%1 dB").arg(powDbAvg, 0, 'f', 1));
         ui->snrText->setText(tr("%1 dB").arg(snrAvg < -90 ? -90 : snrAvg > 90 ? 90 : snrAvg, 0, 'f', 1));
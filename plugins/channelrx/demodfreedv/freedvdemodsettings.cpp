@@ -134,7 +134,7 @@ bool FreeDVDemodSettings::deserialize(const QByteArray& data)
         m_reverseAPIChannelIndex = utmp > 99 ? 99 : utmp;
 
         d.readS32(23, &tmp, 0);
-        if ((tmp < 0) || (tmp > (int) FreeDVMode::FreeDVMode700D)) {
+        if ((tmp < 0) || (tmp > (int) FreeDVMode::FreeDVModeAuto)) {
             m_freeDVMode = FreeDVMode::FreeDVMode2400A;
         } else {
             m_freeDVMode = (FreeDVMode) tmp;
@@ -159,6 +159,7 @@ int FreeDVDemodSettings::getHiCutoff(FreeDVMode freeDVMode)
         case FreeDVMode700C: // OFDM
         case FreeDVMode700D: // OFDM
         case FreeDVMode1600: // OFDM
+        case FreeDVModeAuto: // OFDM modes
             return 2400.0;
             break;
         case FreeDVMode2400A: // C4FM WB
@@ -178,6 +179,7 @@ int FreeDVDemodSettings::getLowCutoff(FreeDVMode freeDVMode)
         case FreeDVMode700C: // OFDM
         case FreeDVMode700D: // OFDM
         case FreeDVMode1600: // OFDM
+        case FreeDVModeAuto: // OFDM modes
             return 600.0;
             break;
         case FreeDVMode2400A: // C4FM WB
@@ -195,3 +197,23 @@ int FreeDVDemodSettings::getModSampleRate(FreeDVMode freeDVMode)
         return 8000;
     }
 }
+
+QString FreeDVDemodSettings::getModeName(FreeDVMode freeDVMode)
+{
+    switch(freeDVMode)
+    {
+        case FreeDVMode1600:
+            return "1600";
+        case FreeDVMode800XA:
+            return "800XA";
+        case FreeDVMode700C:
+            return "700C";
+        case FreeDVMode700D:
+            return "700D";
+        case FreeDVModeAuto:
+            return "Auto";
+        case FreeDVMode2400A:
+        default:
+            return "2400A";
+    }
+}
@@ -33,6 +33,7 @@ struct FreeDVDemodSettings
         FreeDVMode800XA,
         FreeDVMode700C,
         FreeDVMode700D,
+        FreeDVModeAuto  //!< Acquire 700C and 1600 in parallel and lock on the first one in sync
     } FreeDVMode;
 
     qint32 m_inputFrequencyOffset;
@@ -68,6 +69,7 @@ struct FreeDVDemodSettings
     static int getHiCutoff(FreeDVMode freeDVMode);
     static int getLowCutoff(FreeDVMode freeDVMode);
     static int getModSampleRate(FreeDVMode freeDVMode);
+    static QString getModeName(FreeDVMode freeDVMode);
 };
 
 
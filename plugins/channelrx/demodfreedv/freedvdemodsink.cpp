@@ -28,6 +28,8 @@
 
 const unsigned int FreeDVDemodSink::m_ssbFftLen = 1024;
 const float        FreeDVDemodSink::m_agcTarget = 3276.8f; // -10 dB amplitude => -20 dB power: center of normal signal
+const int          FreeDVDemodSink::m_autoLockFrames = 3;      // consecutive frames in sync to lock a mode in auto mode
+const int          FreeDVDemodSink::m_autoUnlockSeconds = 5;   // time out of sync before a locked mode is dropped in auto mode
 
 FreeDVDemodSink::FreeDVStats::FreeDVStats()
 {
@@ -125,6 +127,17 @@ void FreeDVDemodSink::LevelRMS::accumulate(float level)
     }
 }
 
+FreeDVDemodSink::FreeDVCandidate::FreeDVCandidate(FreeDVDemodSettings::FreeDVMode mode, struct freedv *freeDV) :
+    m_mode(mode),
+    m_freeDV(freeDV),
+    m_modIn(freedv_get_n_max_modem_samples(freeDV)),
+    m_speechOut(freedv_get_n_speech_samples(freeDV)),
+    m_nin(freedv_nin(freeDV)),
+    m_iModem(0),
+    m_syncFrames(0),
+    m_locked(false)
+{}
+
 FreeDVDemodSink::FreeDVDemodSink() :
         m_hiCutoff(6000),
         m_lowCutoff(0),
@@ -150,6 +163,9 @@ FreeDVDemodSink::FreeDVDemodSink() :
         m_iModem(0),
         m_speechOut(0),
         m_modIn(0),
+        m_rxMode(FreeDVDemodSettings::FreeDVMode2400A),
+        m_acquiring(false),
+        m_unsyncFrames(0),
         m_levelInNbSamples(480) // 10ms @ 48 kS/s
 {
 	m_audioBuffer.resize(1<<14);
@@ -174,13 +190,14 @@ FreeDVDemodSink::FreeDVDemodSink() :
 
 FreeDVDemodSink::~FreeDVDemodSink()
 {
+    stopAcquisition();
     delete SSBFilter;
     delete[] m_SSBFilterBuffer;
 }
 
 void FreeDVDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-    if (!m_freeDV) {
+    if (!m_freeDV && !m_acquiring) {
         return;
     }
 
@@ -214,6 +231,8 @@ void FreeDVDemodSink::feed(const SampleVector::const_iterator& begin, const Samp
         }
 	}
 
+	processModemBlock();
+
 	uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 	if (res != m_audioBufferFill)
@@ -289,39 +308,98 @@ void FreeDVDemodSink::processOneSample(Complex &ci)
 
 void FreeDVDemodSink::pushSampleToDV(int16_t sample)
 {
-    qint16 audioSample;
-
     calculateLevel(sample);
+    m_modemBlock.push_back(sample); // modem frames are decoded once per block
+}
 
-    if (m_iModem == m_nin)
+void FreeDVDemodSink::processModemBlock()
+{
+    if (m_acquiring)
     {
-        int nout = freedv_rx(m_freeDV, m_speechOut, m_modIn);
-        m_freeDVStats.collect(m_freeDV);
-        m_freeDVSNR.accumulate(m_freeDVStats.m_snrEst);
+        m_candidateWorkers.run(m_candidates.size(), [this](unsigned int candidateIndex) {
+            acquire(candidateIndex);
+        });
+
+        // no speech until a mode is locked
+        uint32_t nbSilence = (m_modemBlock.size() * m_speechSampleRate) / m_modemSampleRate;
 
-        if (m_settings.m_audioMute)
+        for (uint32_t i = 0; i < nbSilence * m_audioResampler.getDecimation(); i++) {
+            pushSampleToAudio(0);
+        }
+
+        FreeDVCandidate *best = nullptr;
+
+        for (std::vector<FreeDVCandidate>::iterator it = m_candidates.begin(); it != m_candidates.end(); ++it)
         {
-            for (uint32_t i = 0; i < nout * m_audioResampler.getDecimation(); i++) {
-                pushSampleToAudio(0);
+            if (it->m_locked && (!best || (it->m_syncFrames > best->m_syncFrames))) {
+                best = &(*it);
             }
         }
-        else
+
+        if (best) {
+            lockCandidate(*best);
+        }
+    }
+    else if (m_freeDV)
+    {
+        for (std::vector<int16_t>::const_iterator it = m_modemBlock.begin(); it != m_modemBlock.end(); ++it)
         {
-            for (int i = 0; i < nout; i++)
+            m_modIn[m_iModem++] = *it;
+
+            if (m_iModem == m_nin)
             {
-                while (!m_audioResampler.upSample(m_speechOut[i], audioSample)) {
-                    pushSampleToAudio(audioSample);
+                rxFrame();
+
+                if (m_acquiring || !m_freeDV) { // lost sync in auto mode: rest of block is dropped
+                    break;
                 }
+            }
+        }
+    }
 
+    m_modemBlock.clear();
+}
+
+void FreeDVDemodSink::rxFrame()
+{
+    qint16 audioSample;
+    int nout = freedv_rx(m_freeDV, m_speechOut, m_modIn);
+    m_freeDVStats.collect(m_freeDV);
+    m_freeDVSNR.accumulate(m_freeDVStats.m_snrEst);
+
+    if (m_settings.m_audioMute)
+    {
+        for (uint32_t i = 0; i < nout * m_audioResampler.getDecimation(); i++) {
+            pushSampleToAudio(0);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < nout; i++)
+        {
+            while (!m_audioResampler.upSample(m_speechOut[i], audioSample)) {
                 pushSampleToAudio(audioSample);
             }
-        }
 
-        m_iModem = 0;
-        m_iSpeech = 0;
+            pushSampleToAudio(audioSample);
+        }
     }
 
-    m_modIn[m_iModem++] = sample;
+    m_iModem = 0;
+    m_iSpeech = 0;
+    m_nin = freedv_nin(m_freeDV); // may change from frame to frame
+
+    if (m_settings.m_freeDVMode == FreeDVDemodSettings::FreeDVModeAuto)
+    {
+        m_unsyncFrames = m_freeDVStats.m_sync ? 0 : m_unsyncFrames + 1;
+
+        if (m_unsyncFrames > (int) m_freeDVStats.m_fps * m_autoUnlockSeconds)
+        {
+            qDebug("FreeDVDemodSink::rxFrame: %s lost sync: restart acquisition",
+                qPrintable(FreeDVDemodSettings::getModeName(m_rxMode)));
+            startAcquisition();
+        }
+    }
 }
 
 void FreeDVDemodSink::calculateLevel(int16_t& sample)
@@ -416,11 +494,34 @@ void FreeDVDemodSink::applyFreeDVMode(FreeDVDemodSettings::FreeDVMode mode)
 
     // FreeDV object
 
-    if (m_freeDV) {
+    stopAcquisition();
+
+    if (m_freeDV)
+    {
         freedv_close(m_freeDV);
+        m_freeDV = nullptr;
     }
 
+    if (mode == FreeDVDemodSettings::FreeDVModeAuto)
+    {
+        startAcquisition();
+        return;
+    }
+
+    m_freeDV = openFreeDV(mode);
+    m_rxMode = mode;
+
+    if (m_freeDV) {
+        setupFreeDV();
+    } else {
+        qCritical("FreeDVDemodSink::applyFreeDVMode: m_freeDV was not allocated");
+    }
+}
+
+struct freedv *FreeDVDemodSink::openFreeDV(FreeDVDemodSettings::FreeDVMode mode)
+{
     int fdv_mode = -1;
+    struct freedv *freeDV;
 
     switch(mode)
     {
@@ -446,78 +547,171 @@ void FreeDVDemodSink::applyFreeDVMode(FreeDVDemodSettings::FreeDVMode mode)
     {
         struct freedv_advanced adv;
         adv.interleave_frames = 1;
-        m_freeDV = freedv_open_advanced(fdv_mode, &adv);
+        freeDV = freedv_open_advanced(fdv_mode, &adv);
     }
     else
     {
-        m_freeDV = freedv_open(fdv_mode);
+        freeDV = freedv_open(fdv_mode);
     }
 
-    if (m_freeDV)
+    if (freeDV)
     {
-        freedv_set_test_frames(m_freeDV, 0);
-        freedv_set_snr_squelch_thresh(m_freeDV, -100.0);
-        freedv_set_squelch_en(m_freeDV, 0);
-        freedv_set_clip(m_freeDV, 0);
-        freedv_set_ext_vco(m_freeDV, 0);
-        freedv_set_sync(m_freeDV, FREEDV_SYNC_MANUAL);
-
-        freedv_set_callback_txt(m_freeDV, nullptr, nullptr, nullptr);
-        freedv_set_callback_protocol(m_freeDV, nullptr, nullptr, nullptr);
-        freedv_set_callback_data(m_freeDV, nullptr, nullptr, nullptr);
+        freedv_set_test_frames(freeDV, 0);
+        freedv_set_snr_squelch_thresh(freeDV, -100.0);
+        freedv_set_squelch_en(freeDV, 0);
+        freedv_set_clip(freeDV, 0);
+        freedv_set_ext_vco(freeDV, 0);
+        freedv_set_sync(freeDV, FREEDV_SYNC_MANUAL);
+
+        freedv_set_callback_txt(freeDV, nullptr, nullptr, nullptr);
+        freedv_set_callback_protocol(freeDV, nullptr, nullptr, nullptr);
+        freedv_set_callback_data(freeDV, nullptr, nullptr, nullptr);
+    }
 
-        int nSpeechSamples = freedv_get_n_speech_samples(m_freeDV);
-        int nMaxModemSamples = freedv_get_n_max_modem_samples(m_freeDV);
-        int Fs = freedv_get_modem_sample_rate(m_freeDV);
-        int Rs = freedv_get_modem_symbol_rate(m_freeDV);
-        m_freeDVStats.init();
+    return freeDV;
+}
 
-        if (nSpeechSamples > m_nSpeechSamples)
-        {
-            if (m_speechOut) {
-                delete[] m_speechOut;
-            }
+void FreeDVDemodSink::setupFreeDV()
+{
+    int nSpeechSamples = freedv_get_n_speech_samples(m_freeDV);
+    int nMaxModemSamples = freedv_get_n_max_modem_samples(m_freeDV);
+    int Fs = freedv_get_modem_sample_rate(m_freeDV);
+    int Rs = freedv_get_modem_symbol_rate(m_freeDV);
+    m_freeDVStats.init();
 
-            m_speechOut = new int16_t[nSpeechSamples];
-            m_nSpeechSamples = nSpeechSamples;
+    if (nSpeechSamples > m_nSpeechSamples)
+    {
+        if (m_speechOut) {
+            delete[] m_speechOut;
         }
 
-        if (nMaxModemSamples > m_nMaxModemSamples)
-        {
-            if (m_modIn) {
-                delete[] m_modIn;
-            }
+        m_speechOut = new int16_t[nSpeechSamples];
+        m_nSpeechSamples = nSpeechSamples;
+    }
 
-            m_modIn = new int16_t[nMaxModemSamples];
-            m_nMaxModemSamples = nMaxModemSamples;
+    if (nMaxModemSamples > m_nMaxModemSamples)
+    {
+        if (m_modIn) {
+            delete[] m_modIn;
         }
 
-        m_iSpeech = 0;
-        m_iModem = 0;
-        m_nin = freedv_nin(m_freeDV);
+        m_modIn = new int16_t[nMaxModemSamples];
+        m_nMaxModemSamples = nMaxModemSamples;
+    }
+
+    m_iSpeech = 0;
+    m_iModem = 0;
+    m_unsyncFrames = 0;
+    m_nin = freedv_nin(m_freeDV);
 
-        if (m_nin > 0) {
-            m_freeDVStats.m_fps = m_modemSampleRate / m_nin;
+    if (m_nin > 0) {
+        m_freeDVStats.m_fps = m_modemSampleRate / m_nin;
+    }
+
+    qDebug() << "FreeDVDemodSink::setupFreeDV:"
+            << " mode: " << FreeDVDemodSettings::getModeName(m_rxMode)
+            << " m_modemSampleRate: " << m_modemSampleRate
+            << " m_lowCutoff: " << m_lowCutoff
+            << " m_hiCutoff: " << m_hiCutoff
+            << " Fs: " << Fs
+            << " Rs: " << Rs
+            << " m_nSpeechSamples: " << m_nSpeechSamples
+            << " m_nMaxModemSamples: " << m_nMaxModemSamples
+            << " m_nin: " << m_nin
+            << " FPS: " << m_freeDVStats.m_fps;
+}
+
+void FreeDVDemodSink::startAcquisition()
+{
+    // 700D is left out as it is disabled on its own
+    static const FreeDVDemodSettings::FreeDVMode autoModes[] = {
+        FreeDVDemodSettings::FreeDVMode700C,
+        FreeDVDemodSettings::FreeDVMode1600
+    };
+
+    stopAcquisition();
+
+    if (m_freeDV)
+    {
+        freedv_close(m_freeDV);
+        m_freeDV = nullptr;
+    }
+
+    for (unsigned int i = 0; i < sizeof(autoModes)/sizeof(autoModes[0]); i++)
+    {
+        struct freedv *freeDV = openFreeDV(autoModes[i]);
+
+        if (freeDV)
+        {
+            freedv_set_sync(freeDV, FREEDV_SYNC_AUTO); // a false sync must not stick
+            m_candidates.push_back(FreeDVCandidate(autoModes[i], freeDV));
         }
+        else
+        {
+            qWarning("FreeDVDemodSink::startAcquisition: cannot open mode %s",
+                qPrintable(FreeDVDemodSettings::getModeName(autoModes[i])));
+        }
+    }
 
-        qDebug() << "FreeDVDemodSink::applyFreeDVMode:"
-                << " fdv_mode: " << fdv_mode
-                << " m_modemSampleRate: " << m_modemSampleRate
-                << " m_lowCutoff: " << m_lowCutoff
-                << " m_hiCutoff: " << m_hiCutoff
-                << " Fs: " << Fs
-                << " Rs: " << Rs
-                << " m_nSpeechSamples: " << m_nSpeechSamples
-                << " m_nMaxModemSamples: " << m_nMaxModemSamples
-                << " m_nin: " << m_nin
-                << " FPS: " << m_freeDVStats.m_fps;
+    m_freeDVStats.init();
+    m_rxMode = FreeDVDemodSettings::FreeDVModeAuto;
+    m_acquiring = m_candidates.size() != 0;
+    m_candidateWorkers.start(m_candidates.size());
+    qDebug("FreeDVDemodSink::startAcquisition: %u modes", (unsigned int) m_candidates.size());
+}
+
+void FreeDVDemodSink::stopAcquisition()
+{
+    m_candidateWorkers.stop();
+
+    for (std::vector<FreeDVCandidate>::iterator it = m_candidates.begin(); it != m_candidates.end(); ++it)
+    {
+        if (it->m_freeDV) {
+            freedv_close(it->m_freeDV);
+        }
     }
-    else
+
+    m_candidates.clear();
+    m_acquiring = false;
+}
+
+void FreeDVDemodSink::acquire(unsigned int candidateIndex)
+{
+    FreeDVCandidate& candidate = m_candidates[candidateIndex];
+
+    for (std::vector<int16_t>::const_iterator it = m_modemBlock.begin(); it != m_modemBlock.end(); ++it)
     {
-        qCritical("FreeDVDemodSink::applyFreeDVMode: m_freeDV was not allocated");
+        candidate.m_modIn[candidate.m_iModem++] = *it;
+
+        if (candidate.m_iModem == candidate.m_nin)
+        {
+            int sync;
+            float snrEst;
+            freedv_rx(candidate.m_freeDV, candidate.m_speechOut.data(), candidate.m_modIn.data());
+            freedv_get_modem_stats(candidate.m_freeDV, &sync, &snrEst);
+            candidate.m_syncFrames = sync ? candidate.m_syncFrames + 1 : 0;
+            candidate.m_locked |= candidate.m_syncFrames >= m_autoLockFrames;
+            candidate.m_nin = freedv_nin(candidate.m_freeDV);
+            candidate.m_iModem = 0;
+        }
     }
 }
 
+void FreeDVDemodSink::lockCandidate(FreeDVCandidate& candidate)
+{
+    std::vector<int16_t> modIn(candidate.m_modIn.begin(), candidate.m_modIn.begin() + candidate.m_iModem);
+    m_freeDV = candidate.m_freeDV;
+    m_rxMode = candidate.m_mode;
+    candidate.m_freeDV = nullptr; // handed over: not closed with the others
+    stopAcquisition();
+    setupFreeDV();
+
+    // keep the partial frame so that the decoder stays in sync
+    std::copy(modIn.begin(), modIn.end(), m_modIn);
+    m_iModem = modIn.size();
+    qDebug("FreeDVDemodSink::lockCandidate: locked on %s", qPrintable(FreeDVDemodSettings::getModeName(m_rxMode)));
+}
+
 void FreeDVDemodSink::applySettings(const FreeDVDemodSettings& settings, bool force)
 {
     qDebug() << "FreeDVDemodSink::applySettings:"
@@ -568,5 +762,9 @@ void FreeDVDemodSink::getSNRLevels(double& avg, double& peak, int& nbSamples)
 
 void FreeDVDemodSink::resyncFreeDV()
 {
-    freedv_set_sync(m_freeDV, FREEDV_SYNC_UNSYNC);
+    if (m_settings.m_freeDVMode == FreeDVDemodSettings::FreeDVModeAuto) {
+        startAcquisition(); // search all modes again
+    } else if (m_freeDV) {
+        freedv_set_sync(m_freeDV, FREEDV_SYNC_UNSYNC);
+    }
 }
\ No newline at end of file
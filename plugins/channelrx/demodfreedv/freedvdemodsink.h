@@ -27,6 +27,7 @@
 #include "dsp/interpolator.h"
 #include "dsp/fftfilt.h"
 #include "dsp/agc.h"
+#include "dsp/streamworkers.h"
 #include "audio/audiofifo.h"
 #include "audio/audioresampler.h"
 #include "util/doublebufferfifo.h"
@@ -78,6 +79,8 @@ public:
 	int getBER() const { return m_freeDVStats.m_ber; }
 	float getFrequencyOffset() const { return m_freeDVStats.m_freqOffset; }
 	bool isSync() const { return m_freeDVStats.m_sync; }
+	bool isAcquiring() const { return m_acquiring; } //!< Auto mode is searching for a mode in sync
+	FreeDVDemodSettings::FreeDVMode getRxMode() const { return m_rxMode; } //!< Mode being decoded (locked mode in auto mode)
 
 	/**
 	 * Level changed
@@ -122,6 +125,25 @@ private:
 		uint32_t m_fps; //!< frames per second
 	};
 
+	/**
+	 * One of the modes tried in parallel during auto mode acquisition.
+	 * It is fed with the same modem samples as the others and is handed over
+	 * to the main decoder as is (already in sync) when it wins.
+	 */
+	struct FreeDVCandidate
+	{
+		FreeDVCandidate(FreeDVDemodSettings::FreeDVMode mode, struct freedv *freeDV);
+
+		FreeDVDemodSettings::FreeDVMode m_mode;
+		struct freedv *m_freeDV;
+		std::vector<int16_t> m_modIn;
+		std::vector<int16_t> m_speechOut;
+		int m_nin;
+		int m_iModem;
+		int m_syncFrames; //!< consecutive frames in sync
+		bool m_locked;
+	};
+
 	struct FreeDVSNR
 	{
 		FreeDVSNR();
@@ -194,6 +216,12 @@ private:
     AudioResampler m_audioResampler;
 	FreeDVStats m_freeDVStats;
 	FreeDVSNR m_freeDVSNR;
+	FreeDVDemodSettings::FreeDVMode m_rxMode;
+	std::vector<int16_t> m_modemBlock;        //!< modem samples of the current block
+	std::vector<FreeDVCandidate> m_candidates; //!< auto mode acquisition
+	StreamWorkers m_candidateWorkers;
+	bool m_acquiring;
+	int m_unsyncFrames;                        //!< consecutive frames out of sync once locked in auto mode
 	LevelRMS m_levelIn;
 	int m_levelInNbSamples;
     Real m_rmsLevel;
@@ -201,8 +229,18 @@ private:
 
     static const unsigned int m_ssbFftLen;
     static const float m_agcTarget;
+    static const int m_autoLockFrames;
+    static const int m_autoUnlockSeconds;
 
+    static struct freedv *openFreeDV(FreeDVDemodSettings::FreeDVMode mode);
+    void setupFreeDV();
 	void pushSampleToDV(int16_t sample);
+	void processModemBlock();
+	void rxFrame();
+	void startAcquisition();
+	void stopAcquisition();
+	void acquire(unsigned int candidateIndex);
+	void lockCandidate(FreeDVCandidate& candidate);
 	void pushSampleToAudio(int16_t sample);
     void processOneSample(Complex &ci);
     void calculateLevel(int16_t& sample);
@@ -23,6 +23,9 @@
 #include <QDebug>
 #include <QThread>
 
+#include "SWGChannelReport.h"
+#include "SWGLoRaDemodReport.h"
+
 #include "dsp/dspcommands.h"
 #include "device/deviceapi.h"
 
@@ -85,6 +88,11 @@ void LoRaDemod::stop()
 	m_thread->wait();
 }
 
+void LoRaDemod::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool LoRaDemod::handleMessage(const Message& cmd)
 {
 	if (MsgConfigureLoRaDemod::match(cmd))
@@ -149,4 +157,40 @@ void LoRaDemod::applySettings(const LoRaDemodSettings& settings, bool force)
     m_basebandSink->getInputMessageQueue()->push(msg);
 
     m_settings = settings;
-}
\ No newline at end of file
+}
+
+int LoRaDemod::webapiReportGet(
+            SWGSDRangel::SWGChannelReport& response,
+            QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setLoRaDemodReport(new SWGSDRangel::SWGLoRaDemodReport());
+    response.getLoRaDemodReport()->init();
+    webapiFormatChannelReport(response);
+    return 200;
+}
+
+void LoRaDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response)
+{
+    LoRaDemodMultiSF::Frame frame;
+    unsigned int frameCount = m_basebandSink->getLastFrame(frame);
+
+    response.getLoRaDemodReport()->setChannelSampleRate(m_basebandSink->getChannelSampleRate());
+    response.getLoRaDemodReport()->setFrameCount(frameCount);
+
+    if (frameCount > 0)
+    {
+        QString symbols;
+
+        for (unsigned int i = 0; i < frame.m_symbols.size(); i++) {
+            symbols += QString("%1%2").arg(i == 0 ? "" : " ").arg(frame.m_symbols[i], 3, 16, QChar('0'));
+        }
+
+        response.getLoRaDemodReport()->setSpreadFactor(frame.m_spreadFactor);
+        response.getLoRaDemodReport()->setSyncWord(frame.m_syncWord);
+        response.getLoRaDemodReport()->setSnr(frame.m_snr);
+        response.getLoRaDemodReport()->setCfo(frame.m_cfo);
+        response.getLoRaDemodReport()->setNbSymbols(frame.m_symbols.size());
+        *response.getLoRaDemodReport()->getSymbols() = symbols;
+    }
+}
@@ -11,6 +11,7 @@
 #include "dsp/dspengine.h"
 
 #include "lorademod.h"
+#include "lorademodreport.h"
 #include "lorademodgui.h"
 
 LoRaDemodGUI* LoRaDemodGUI::create(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel)
@@ -70,10 +71,33 @@ bool LoRaDemodGUI::deserialize(const QByteArray& data)
 
 bool LoRaDemodGUI::handleMessage(const Message& message)
 {
-    (void) message;
+    if (LoRaDemodReport::MsgReportDecodeFrame::match(message))
+    {
+        const LoRaDemodMultiSF::Frame& frame = ((LoRaDemodReport::MsgReportDecodeFrame&) message).getFrame();
+        ui->FrameText->setText(QString("SF%1 sync %2 %3 dB %4 Hz %5 sym")
+            .arg(frame.m_spreadFactor)
+            .arg(frame.m_syncWord, 2, 16, QChar('0'))
+            .arg(frame.m_snr, 0, 'f', 1)
+            .arg(frame.m_cfo, 0, 'f', 0)
+            .arg(frame.m_symbols.size()));
+        return true;
+    }
+
 	return false;
 }
 
+void LoRaDemodGUI::handleInputMessages()
+{
+    Message* message;
+
+    while ((message = getInputMessageQueue()->pop()) != 0)
+    {
+        if (handleMessage(*message)) {
+            delete message;
+        }
+    }
+}
+
 void LoRaDemodGUI::viewChanged()
 {
 	applySettings();
@@ -98,7 +122,14 @@ void LoRaDemodGUI::on_BW_valueChanged(int value)
 
 void LoRaDemodGUI::on_Spread_valueChanged(int value)
 {
-    (void) value;
+    m_settings.m_spread = value;
+    displaySpread();
+    applySettings();
+}
+
+void LoRaDemodGUI::displaySpread()
+{
+    ui->SpreadText->setText(m_settings.m_spread == LoRaDemodSettings::spreadMultiSF ? "SF7-12" : "6:4 2^8");
 }
 
 void LoRaDemodGUI::onWidgetRolled(QWidget* widget, bool rollDown)
@@ -122,6 +153,8 @@ LoRaDemodGUI::LoRaDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseb
 	m_LoRaDemod = (LoRaDemod*) rxChannel; //new LoRaDemod(m_deviceUISet->m_deviceSourceAPI);
     m_spectrumVis = m_LoRaDemod->getSpectrumVis();
     m_spectrumVis->setGLSpectrum(ui->glSpectrum);
+	m_LoRaDemod->setMessageQueueToGUI(getInputMessageQueue());
+	m_LoRaDemod->propagateMessageQueueToGUI();
 
 	ui->glSpectrum->setCenterFrequency(16000);
 	ui->glSpectrum->setSampleRate(32000);
@@ -144,6 +177,8 @@ LoRaDemodGUI::LoRaDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseb
 
 	displaySettings();
 	applySettings(true);
+
+	connect(getInputMessageQueue(), SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
 }
 
 LoRaDemodGUI::~LoRaDemodGUI()
@@ -182,5 +217,7 @@ void LoRaDemodGUI::displaySettings()
     blockApplySettings(true);
     ui->BWText->setText(QString("%1 Hz").arg(thisBW));
     ui->BW->setValue(m_settings.m_bandwidthIndex);
+    ui->Spread->setValue(m_settings.m_spread);
+    displaySpread();
     blockApplySettings(false);
 }
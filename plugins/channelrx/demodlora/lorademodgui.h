@@ -38,6 +38,7 @@ public:
 
 private slots:
 	void viewChanged();
+	void handleInputMessages();
 	void on_BW_valueChanged(int value);
 	void on_Spread_valueChanged(int value);
 	void onWidgetRolled(QWidget* widget, bool rollDown);
@@ -60,6 +61,7 @@ private:
     void blockApplySettings(bool block);
 	void applySettings(bool force = false);
 	void displaySettings();
+	void displaySpread();
 };
 
 #endif // INCLUDE_LoRaDEMODGUI_H
@@ -0,0 +1,380 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <QDebug>
+#include <QString>
+
+#include "dsp/dspengine.h"
+#include "dsp/fftfactory.h"
+#include "dsp/fftengine.h"
+
+#include "lorademodmultisf.h"
+
+const unsigned int LoRaDemodMultiSF::m_minSF;
+const unsigned int LoRaDemodMultiSF::m_maxSF;
+const unsigned int LoRaDemodMultiSF::m_preambleMinSymbols;
+const unsigned int LoRaDemodMultiSF::m_payloadMaxSymbols;
+const unsigned int LoRaDemodMultiSF::m_bufferSize;
+const unsigned int LoRaDemodMultiSF::m_chunkSize;
+
+LoRaDemodMultiSF::LoRaDemodMultiSF() :
+    m_bandwidth(125000),
+    m_buffer(m_bufferSize),
+    m_sampleCount(0),
+    m_frameCount(0)
+{
+    FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
+    m_detectors.resize(m_maxSF - m_minSF + 1);
+
+    for (unsigned int i = 0; i < m_detectors.size(); i++)
+    {
+        Detector& detector = m_detectors[i];
+        unsigned int nbSymbols = 1 << (m_minSF + i);
+        detector.m_spreadFactor = m_minSF + i;
+        detector.m_nbSymbols = nbSymbols;
+        detector.m_fftSequence = fftFactory->getEngine(nbSymbols, false, &detector.m_fft);
+        detector.m_downChirp.resize(nbSymbols);
+        detector.m_upChirp.resize(nbSymbols);
+        detector.m_payloadChirp.resize(nbSymbols);
+        detector.m_magSq.resize(nbSymbols);
+
+        // Base up chirp sweeping -BW/2 to BW/2 in 2^SF chips
+        for (unsigned int n = 0; n < nbSymbols; n++)
+        {
+            double phase = M_PI * ((double) n * n / nbSymbols - n);
+            detector.m_upChirp[n] = Complex(cos(phase), sin(phase));
+            detector.m_downChirp[n] = std::conj(detector.m_upChirp[n]);
+        }
+
+        // The largest of 2^SF noise bins is about SF*ln(2) times the mean. False preamble
+        // detections are rare anyway as the peak must stay on the same bin for several windows.
+        detector.m_detectThreshold = 2.0f * detector.m_spreadFactor * M_LN2;
+        detector.m_payloadThreshold = 1.5f * detector.m_spreadFactor * M_LN2;
+    }
+
+    reset();
+}
+
+LoRaDemodMultiSF::~LoRaDemodMultiSF()
+{
+    FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
+
+    for (const Detector& detector : m_detectors) {
+        fftFactory->releaseEngine(detector.m_nbSymbols, false, detector.m_fftSequence);
+    }
+}
+
+void LoRaDemodMultiSF::reset()
+{
+    for (Detector& detector : m_detectors)
+    {
+        detector.m_state = StateSearch;
+        detector.m_windowStart = m_sampleCount;
+        detector.m_preambleCount = 0;
+        detector.m_misses = 0;
+        detector.m_frame.m_symbols.clear();
+    }
+}
+
+void LoRaDemodMultiSF::feed(const std::vector<Complex>& samples)
+{
+    const unsigned int mask = m_bufferSize - 1;
+
+    // Detectors are run every chunk so that none falls behind the ring buffer
+    for (unsigned int offset = 0; offset < samples.size(); offset += m_chunkSize)
+    {
+        unsigned int count = std::min((unsigned int) samples.size() - offset, m_chunkSize);
+
+        for (unsigned int i = 0; i < count; i++) {
+            m_buffer[(m_sampleCount + i) & mask] = samples[offset + i];
+        }
+
+        m_sampleCount += count;
+
+        for (Detector& detector : m_detectors)
+        {
+            while (process(detector)) {}
+        }
+    }
+}
+
+bool LoRaDemodMultiSF::process(Detector& detector)
+{
+    if (detector.m_state == StateSync) {
+        return processSync(detector);
+    }
+
+    if (detector.m_windowStart + detector.m_nbSymbols > m_sampleCount) {
+        return false;
+    }
+
+    switch (detector.m_state)
+    {
+    case StateSearch:
+        processSearch(detector);
+        break;
+    case StatePreamble:
+        processPreamble(detector);
+        break;
+    case StatePayload:
+        processPayload(detector);
+        break;
+    default:
+        break;
+    }
+
+    return true;
+}
+
+void LoRaDemodMultiSF::processSearch(Detector& detector)
+{
+    Peak peak;
+    int nbSymbols = detector.m_nbSymbols;
+    dechirp(detector, detector.m_windowStart, detector.m_downChirp, peak);
+    detector.m_windowStart += nbSymbols;
+
+    if (peak.m_ratio > detector.m_detectThreshold)
+    {
+        int preambleBin = ((int) lroundf(detector.m_preambleValue)) % nbSymbols;
+
+        if ((detector.m_preambleCount > 0) && (binDistance(peak.m_bin, preambleBin, nbSymbols) <= 1)) {
+            detector.m_preambleCount++;
+        } else {
+            detector.m_preambleCount = 1;
+        }
+
+        detector.m_preambleValue = peak.m_value;
+        detector.m_preambleSNR = peak.m_snr;
+    }
+    else
+    {
+        detector.m_preambleCount = 0;
+    }
+
+    if (detector.m_preambleCount >= m_preambleMinSymbols)
+    {
+        detector.m_state = StatePreamble;
+        detector.m_misses = 0;
+    }
+}
+
+void LoRaDemodMultiSF::processPreamble(Detector& detector)
+{
+    Peak upPeak, downPeak;
+    int nbSymbols = detector.m_nbSymbols;
+    int preambleBin = ((int) lroundf(detector.m_preambleValue)) % nbSymbols;
+    dechirp(detector, detector.m_windowStart, detector.m_downChirp, upPeak);
+    dechirp(detector, detector.m_windowStart, detector.m_upChirp, downPeak);
+
+    if ((upPeak.m_ratio > detector.m_detectThreshold) && (binDistance(upPeak.m_bin, preambleBin, nbSymbols) <= 1))
+    {
+        detector.m_preambleValue = upPeak.m_value;
+        detector.m_preambleSNR = upPeak.m_snr;
+        detector.m_preambleCount++;
+        detector.m_misses = 0;
+    }
+    else if ((downPeak.m_ratio > detector.m_detectThreshold) && (downPeak.m_magSq > upPeak.m_magSq))
+    {
+        detector.m_sfdWindow = detector.m_windowStart;
+        detector.m_sfdValue = downPeak.m_value;
+        detector.m_state = StateSync;
+    }
+    else if (++detector.m_misses > 3) // two sync word symbols and one partial SFD window at most
+    {
+        detector.m_state = StateSearch;
+        detector.m_preambleCount = 0;
+    }
+
+    detector.m_windowStart += nbSymbols;
+}
+
+bool LoRaDemodMultiSF::processSync(Detector& detector)
+{
+    int nbSymbols = detector.m_nbSymbols;
+
+    // Preamble bin is timing + CFO and SFD bin is CFO - timing
+    float cfo = wrap((detector.m_preambleValue + detector.m_sfdValue) / 2.0f, nbSymbols);
+
+    if (std::abs(cfo) > nbSymbols / 4) { // resolve the half spectrum ambiguity assuming |CFO| < BW/4
+        cfo = wrap(cfo + nbSymbols / 2, nbSymbols);
+    }
+
+    float timing = fmodf(detector.m_preambleValue - cfo + 2 * nbSymbols, nbSymbols);
+    int shift = ((int) lroundf(timing)) % nbSymbols;
+    quint64 base = detector.m_sfdWindow - shift; // Symbol boundary in the first window of the SFD
+
+    if (base + 3 * nbSymbols > m_sampleCount) {
+        return false;
+    }
+
+    // The first window may have caught only part of the SFD: find the two full down chirps
+    Real bestScore = -1.0f;
+    quint64 sfdStart = base;
+
+    for (int m = -1; m <= 1; m++)
+    {
+        Peak first, second;
+        quint64 start = base + m * nbSymbols;
+        dechirp(detector, start, detector.m_upChirp, first);
+        dechirp(detector, start + nbSymbols, detector.m_upChirp, second);
+
+        if (first.m_magSq + second.m_magSq > bestScore)
+        {
+            bestScore = first.m_magSq + second.m_magSq;
+            sfdStart = start;
+        }
+    }
+
+    detector.m_cfo = cfo;
+    detector.m_timingResidual = timing - shift;
+
+    // Sync word symbols are its nibbles times 8
+    Peak sync1, sync2;
+    dechirp(detector, sfdStart - 2 * nbSymbols, detector.m_downChirp, sync1);
+    dechirp(detector, sfdStart - nbSymbols, detector.m_downChirp, sync2);
+    float sync1Value = fmodf(sync1.m_value - cfo - detector.m_timingResidual + 2 * nbSymbols, nbSymbols);
+    float sync2Value = fmodf(sync2.m_value - cfo - detector.m_timingResidual + 2 * nbSymbols, nbSymbols);
+    unsigned int syncWord = ((lroundf(sync1Value / 8.0f) & 0xF) << 4) | (lroundf(sync2Value / 8.0f) & 0xF);
+
+    for (int n = 0; n < nbSymbols; n++)
+    {
+        double phase = -2.0 * M_PI * cfo * n / nbSymbols;
+        detector.m_payloadChirp[n] = detector.m_downChirp[n] * Complex(cos(phase), sin(phase));
+    }
+
+    detector.m_frame.m_spreadFactor = detector.m_spreadFactor;
+    detector.m_frame.m_cfo = (cfo * m_bandwidth) / nbSymbols;
+    detector.m_frame.m_timingOffset = timing;
+    detector.m_frame.m_snr = 10.0f * log10f(std::max(detector.m_preambleSNR, 1e-6f));
+    detector.m_frame.m_syncWord = syncWord;
+    detector.m_frame.m_symbols.clear();
+    detector.m_windowStart = sfdStart + 2 * nbSymbols + nbSymbols / 4; // 2.25 down chirps
+    detector.m_misses = 0;
+    detector.m_state = StatePayload;
+
+    return true;
+}
+
+void LoRaDemodMultiSF::processPayload(Detector& detector)
+{
+    Peak peak;
+    int nbSymbols = detector.m_nbSymbols;
+    dechirp(detector, detector.m_windowStart, detector.m_payloadChirp, peak);
+    detector.m_windowStart += nbSymbols;
+
+    int symbol = ((int) lroundf(peak.m_value - detector.m_timingResidual) + nbSymbols) % nbSymbols;
+    detector.m_frame.m_symbols.push_back(symbol);
+
+    if (peak.m_ratio < detector.m_payloadThreshold)
+    {
+        if (++detector.m_misses == 2) // end of frame: drop the symbols lost in the noise
+        {
+            detector.m_frame.m_symbols.resize(detector.m_frame.m_symbols.size() - 2);
+            endFrame(detector);
+            return;
+        }
+    }
+    else
+    {
+        detector.m_misses = 0;
+    }
+
+    if (detector.m_frame.m_symbols.size() >= m_payloadMaxSymbols) {
+        endFrame(detector);
+    }
+}
+
+void LoRaDemodMultiSF::endFrame(Detector& detector)
+{
+    const Frame& frame = detector.m_frame;
+
+    if (frame.m_symbols.size() > 0)
+    {
+        QString symbols;
+
+        for (unsigned int i = 0; i < frame.m_symbols.size(); i++) {
+            symbols += QString("%1 ").arg(frame.m_symbols[i], 3, 16, QChar('0'));
+        }
+
+        m_frameCount++;
+        m_frames.push_back(frame);
+        qDebug("LoRaDemodMultiSF::endFrame: SF%u CFO: %.1f Hz timing: %.2f SNR: %.1f dB sync: %02X symbols(%u): %s",
+            frame.m_spreadFactor, frame.m_cfo, frame.m_timingOffset, frame.m_snr, frame.m_syncWord,
+            (unsigned int) frame.m_symbols.size(), qPrintable(symbols));
+    }
+
+    detector.m_state = StateSearch;
+    detector.m_preambleCount = 0;
+    detector.m_misses = 0;
+}
+
+void LoRaDemodMultiSF::dechirp(Detector& detector, quint64 start, const std::vector<Complex>& chirp, Peak& peak)
+{
+    const unsigned int mask = m_bufferSize - 1;
+    int nbSymbols = detector.m_nbSymbols;
+    Complex *in = detector.m_fft->in();
+
+    for (int n = 0; n < nbSymbols; n++) {
+        in[n] = m_buffer[(start + n) & mask] * chirp[n];
+    }
+
+    detector.m_fft->transform();
+    const Complex *out = detector.m_fft->out();
+    Real sum = 0.0f;
+    Real max = 0.0f;
+    int imax = 0;
+
+    for (int n = 0; n < nbSymbols; n++)
+    {
+        Real magSq = std::norm(out[n]);
+        detector.m_magSq[n] = magSq;
+        sum += magSq;
+
+        if (magSq > max)
+        {
+            max = magSq;
+            imax = n;
+        }
+    }
+
+    // Parabolic interpolation of the peak magnitude
+    Real a = sqrt(detector.m_magSq[(imax - 1 + nbSymbols) % nbSymbols]);
+    Real b = sqrt(max);
+    Real c = sqrt(detector.m_magSq[(imax + 1) % nbSymbols]);
+    Real den = a - 2.0f * b + c;
+    Real delta = den < 0.0f ? 0.5f * (a - c) / den : 0.0f;
+
+    peak.m_bin = imax;
+    peak.m_value = fmodf(imax + delta + nbSymbols, nbSymbols);
+    peak.m_magSq = max;
+    peak.m_ratio = sum > max ? (max * (nbSymbols - 1)) / (sum - max) : 0.0f;
+    peak.m_snr = sum > max ? ((a*a + max + c*c) * (nbSymbols - 3) / (sum - a*a - max - c*c) - 3.0f) / nbSymbols : 0.0f;
+}
+
+int LoRaDemodMultiSF::binDistance(int a, int b, int n)
+{
+    int d = std::abs(a - b) % n;
+    return std::min(d, n - d);
+}
+
+float LoRaDemodMultiSF::wrap(float value, int n)
+{
+    float w = fmodf(value + n / 2, n);
+    return w < 0.0f ? w + n / 2 : w - n / 2;
+}
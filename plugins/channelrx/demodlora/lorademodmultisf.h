@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_LORADEMODMULTISF_H
+#define INCLUDE_LORADEMODMULTISF_H
+
+#include <vector>
+
+#include <QtGlobal>
+
+#include "dsp/dsptypes.h"
+
+class FFTEngine;
+
+/**
+ * Dechirp and FFT LoRa demodulator searching spreading factors 7 to 12 simultaneously.
+ *
+ * Input is the channel sampled at the LoRa bandwidth (one sample per chip). All
+ * spreading factors share the input ring buffer and each has a detector with its
+ * chirp tables and an FFT of size 2^SF. Samples are appended in chunks and each
+ * detector then runs all the windows completed by the chunk back to back.
+ *
+ * A detector runs a state machine:
+ *   - Search: non overlapping windows dechirped with the down chirp. A preamble is
+ *     found when the peak stands out of the noise at the same bin in consecutive windows.
+ *   - Preamble: windows are also dechirped with the up chirp. The start frame delimiter
+ *     (down chirps) is found when the up chirp dechirp takes over.
+ *   - Sync: the preamble bin (CFO + timing) and SFD bin (CFO - timing) give the carrier
+ *     frequency offset and the symbol timing. The SFD position is refined on aligned
+ *     windows and the sync word is read from the two symbols before it.
+ *   - Payload: aligned and CFO corrected windows give the symbol values until the
+ *     peaks fade into the noise.
+ */
+class LoRaDemodMultiSF
+{
+public:
+    struct Frame
+    {
+        unsigned int m_spreadFactor;
+        float m_cfo;                 //!< Carrier frequency offset (Hz)
+        float m_timingOffset;        //!< Symbol start relative to the search windows (samples)
+        float m_snr;                 //!< Preamble SNR estimate (dB)
+        unsigned int m_syncWord;
+        std::vector<unsigned short> m_symbols; //!< Demodulated symbols (not de-grayed)
+    };
+
+    LoRaDemodMultiSF();
+    ~LoRaDemodMultiSF();
+
+    void setBandwidth(int bandwidth) { m_bandwidth = bandwidth; }
+    void reset();
+    void feed(const std::vector<Complex>& samples);
+    unsigned int getFrameCount() const { return m_frameCount; }
+    void takeFrames(std::vector<Frame>& frames) { frames.clear(); frames.swap(m_frames); } //!< Frames completed since the last call
+
+    static const unsigned int m_minSF = 7;
+    static const unsigned int m_maxSF = 12;
+    static const unsigned int m_preambleMinSymbols = 4;  //!< Consecutive preamble chirps to detect a frame
+    static const unsigned int m_payloadMaxSymbols = 1024;
+
+private:
+    enum State
+    {
+        StateSearch,
+        StatePreamble,
+        StateSync,
+        StatePayload
+    };
+
+    struct Detector
+    {
+        unsigned int m_spreadFactor;
+        unsigned int m_nbSymbols;            //!< 2^SF: FFT size and samples per symbol
+        FFTEngine *m_fft;
+        unsigned int m_fftSequence;
+        std::vector<Complex> m_downChirp;    //!< Dechirps up chirps
+        std::vector<Complex> m_upChirp;      //!< Dechirps down chirps
+        std::vector<Complex> m_payloadChirp; //!< Down chirp with the CFO correction of the current frame
+        std::vector<Real> m_magSq;
+        float m_detectThreshold;             //!< Peak to mean power ratio for the preamble
+        float m_payloadThreshold;            //!< Peak to mean power ratio for payload symbols
+        State m_state;
+        quint64 m_windowStart;               //!< Absolute index of the next window start
+        unsigned int m_preambleCount;
+        unsigned int m_misses;
+        float m_preambleValue;               //!< Preamble peak bin with fractional part
+        float m_preambleSNR;
+        quint64 m_sfdWindow;                 //!< Window where the up chirp dechirp took over
+        float m_sfdValue;                    //!< SFD peak bin with fractional part
+        float m_cfo;                         //!< CFO of the current frame (bins)
+        float m_timingResidual;              //!< Timing left after aligning on whole samples
+        Frame m_frame;
+    };
+
+    struct Peak
+    {
+        int m_bin;
+        float m_value;    //!< Bin with fractional part in [0, N)
+        Real m_magSq;
+        Real m_ratio;     //!< Peak to mean power ratio
+        Real m_snr;       //!< Peak and its neighbours over noise power per sample
+    };
+
+    int m_bandwidth;
+    std::vector<Complex> m_buffer; //!< Ring buffer of input samples shared by all detectors
+    quint64 m_sampleCount;         //!< Total number of samples appended to the ring buffer
+    std::vector<Detector> m_detectors;
+    unsigned int m_frameCount;
+    std::vector<Frame> m_frames;   //!< Completed frames not taken yet
+
+    static const unsigned int m_bufferSize = 16 << m_maxSF; //!< Power of two larger than the deepest look back
+    static const unsigned int m_chunkSize = 1024;
+
+    bool process(Detector& detector); //!< Returns false when more samples are needed
+    void processSearch(Detector& detector);
+    void processPreamble(Detector& detector);
+    bool processSync(Detector& detector);
+    void processPayload(Detector& detector);
+    void endFrame(Detector& detector);
+    void dechirp(Detector& detector, quint64 start, const std::vector<Complex>& chirp, Peak& peak);
+    static int binDistance(int a, int b, int n);
+    static float wrap(float value, int n); //!< Into [-n/2, n/2)
+};
+
+#endif // INCLUDE_LORADEMODMULTISF_H
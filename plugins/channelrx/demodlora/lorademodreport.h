@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////////
-// Copyright (C) 2019 Edouard Griffiths, F4EXB.                                  //
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
 //                                                                               //
 // This program is free software; you can redistribute it and/or modify          //
 // it under the terms of the GNU General Public License as published by          //
@@ -15,64 +15,42 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#ifndef PLUGINS_CHANNELRX_LOCALSINK_LOCALSINKWORKER_H_
-#define PLUGINS_CHANNELRX_LOCALSINK_LOCALSINKWORKER_H_
+#ifndef INCLUDE_LORADEMODREPORT_H
+#define INCLUDE_LORADEMODREPORT_H
 
 #include <QObject>
-#include <QMutex>
-#include <QWaitCondition>
 
-#include "dsp/dsptypes.h"
 #include "util/message.h"
-#include "util/messagequeue.h"
 
-class SampleSinkFifo;
+#include "lorademodmultisf.h"
 
-class LocalSinkWorker : public QObject {
+class LoRaDemodReport : public QObject
+{
     Q_OBJECT
-
 public:
-    class MsgStartStop : public Message {
+    class MsgReportDecodeFrame : public Message {
         MESSAGE_CLASS_DECLARATION
 
     public:
-        bool getStartStop() const { return m_startStop; }
+        const LoRaDemodMultiSF::Frame& getFrame() const { return m_frame; }
 
-        static MsgStartStop* create(bool startStop) {
-            return new MsgStartStop(startStop);
+        static MsgReportDecodeFrame* create(const LoRaDemodMultiSF::Frame& frame)
+        {
+            return new MsgReportDecodeFrame(frame);
         }
 
-    protected:
-        bool m_startStop;
+    private:
+        LoRaDemodMultiSF::Frame m_frame;
 
-        MsgStartStop(bool startStop) :
+        MsgReportDecodeFrame(const LoRaDemodMultiSF::Frame& frame) :
             Message(),
-            m_startStop(startStop)
+            m_frame(frame)
         { }
     };
 
-    LocalSinkWorker(QObject* parent = 0);
-    ~LocalSinkWorker();
-
-    void startStop(bool start);
-    void setSampleFifo(SampleSinkFifo *sampleFifo) { m_sampleFifo = sampleFifo; }
-    void setDeviceSampleFifo(SampleSinkFifo *sampleFifo) { m_deviceSampleFifo  = sampleFifo; }
-
-public slots:
-    void handleData(); //!< Handle data when samples have to be processed
-
-private:
-	volatile bool m_running;
-    SampleSinkFifo *m_sampleFifo;
-    SampleSinkFifo *m_deviceSampleFifo;
-    MessageQueue m_inputMessageQueue;
-
-	void startWork();
-	void stopWork();
-
-private slots:
-    void handleInputMessages();
+public:
+    LoRaDemodReport();
+    ~LoRaDemodReport();
 };
 
-#endif // PLUGINS_CHANNELRX_LOCALSINK_LOCALSINKWORKER_H_
-
+#endif // INCLUDE_LORADEMODREPORT_H
@@ -7,8 +7,8 @@
 #include "settings/serializable.h"
 #include "lorademodsettings.h"
 
-const int LoRaDemodSettings::bandwidths[] = {7813,15625,20833,31250,62500};
-const int LoRaDemodSettings::nb_bandwidths = 5;
+const int LoRaDemodSettings::bandwidths[] = {7813,15625,20833,31250,62500,125000,250000,500000};
+const int LoRaDemodSettings::nb_bandwidths = 8;
 
 LoRaDemodSettings::LoRaDemodSettings() :
     m_centerFrequency(0),
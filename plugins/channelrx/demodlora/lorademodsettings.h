@@ -13,7 +13,7 @@ struct LoRaDemodSettings
 {
     int m_centerFrequency;
     int m_bandwidthIndex;
-    int m_spread;
+    int m_spread; //!< 0: 6:4 FEC with SF8 sliding FFT, 1: all spreading factors 7 to 12 with dechirp and FFT
     uint32_t m_rgbColor;
     QString m_title;
 
@@ -21,6 +21,7 @@ struct LoRaDemodSettings
     Serializable *m_spectrumGUI;
 
     static const int bandwidths[];
+    static const int spreadMultiSF = 1;
     static const int nb_bandwidths;
 
     LoRaDemodSettings();
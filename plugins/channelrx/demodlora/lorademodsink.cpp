@@ -21,7 +21,10 @@
 
 #include "dsp/dsptypes.h"
 #include "dsp/basebandsamplesink.h"
+#include "util/messagequeue.h"
 
+#include "lorademodmultisf.h"
+#include "lorademodreport.h"
 #include "lorademodsink.h"
 
 const int LoRaDemodSink::DATA_BITS = 6;
@@ -31,7 +34,11 @@ const int LoRaDemodSink::LORA_SFFT_LEN = (LoRaDemodSink::SPREADFACTOR / 2);
 const int LoRaDemodSink::LORA_SQUELCH = 3;
 
 LoRaDemodSink::LoRaDemodSink() :
-        m_spectrumSink(nullptr)
+        m_spectrumSink(nullptr),
+        m_multiSF(nullptr),
+        m_lastFrame(),
+        m_frameCount(0),
+        m_messageQueueToGUI(nullptr)
 {
 	m_Bandwidth = LoRaDemodSettings::bandwidths[0];
 	m_channelSampleRate = 96000;
@@ -63,6 +70,7 @@ LoRaDemodSink::~LoRaDemodSink()
 	delete [] mov;
 	delete [] history;
 	delete [] finetune;
+	delete m_multiSF;
 }
 
 void LoRaDemodSink::dumpRaw()
@@ -224,6 +232,12 @@ void LoRaDemodSink::feed(const SampleVector::const_iterator& begin, const Sample
 
 	m_sampleBuffer.clear();
 
+	if (m_multiSF)
+	{
+		feedMultiSF(begin, end);
+		return;
+	}
+
 	for (SampleVector::const_iterator it = begin; it < end; ++it)
 	{
 		Complex c(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
@@ -248,6 +262,53 @@ void LoRaDemodSink::feed(const SampleVector::const_iterator& begin, const Sample
 	}
 }
 
+void LoRaDemodSink::feedMultiSF(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+	Complex ci;
+	m_multiSFSamples.clear();
+
+	// Collect the whole block at one sample per chip so that each spreading factor runs its FFTs back to back
+	for (SampleVector::const_iterator it = begin; it < end; ++it)
+	{
+		Complex c(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
+		c *= m_nco.nextIQ();
+
+		if (m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
+		{
+			m_multiSFSamples.push_back(ci);
+			m_sampleBuffer.push_back(Sample(ci.real() * SDR_RX_SCALEF, ci.imag() * SDR_RX_SCALEF));
+			m_sampleDistanceRemain += (Real) m_channelSampleRate / m_Bandwidth;
+		}
+	}
+
+	m_multiSF->feed(m_multiSFSamples);
+	m_multiSF->takeFrames(m_multiSFFrames);
+
+	for (const LoRaDemodMultiSF::Frame& frame : m_multiSFFrames)
+	{
+		if (m_messageQueueToGUI)
+		{
+			LoRaDemodReport::MsgReportDecodeFrame *msg = LoRaDemodReport::MsgReportDecodeFrame::create(frame);
+			m_messageQueueToGUI->push(msg);
+		}
+
+		QMutexLocker mutexLocker(&m_frameMutex);
+		m_lastFrame = frame;
+		m_frameCount++;
+	}
+
+	if (m_spectrumSink) {
+		m_spectrumSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), false);
+	}
+}
+
+unsigned int LoRaDemodSink::getLastFrame(LoRaDemodMultiSF::Frame& frame)
+{
+	QMutexLocker mutexLocker(&m_frameMutex);
+	frame = m_lastFrame;
+	return m_frameCount;
+}
+
 void LoRaDemodSink::applyChannelSettings(int channelSampleRate, int bandwidth, int channelFrequencyOffset, bool force)
 {
     qDebug() << "LoRaDemodSink::applyChannelSettings:"
@@ -267,6 +328,12 @@ void LoRaDemodSink::applyChannelSettings(int channelSampleRate, int bandwidth, i
         m_sampleDistanceRemain = (Real) channelSampleRate / bandwidth;
     }
 
+    if (m_multiSF && ((bandwidth != m_Bandwidth) || force))
+    {
+        m_multiSF->setBandwidth(bandwidth);
+        m_multiSF->reset();
+    }
+
     m_channelSampleRate = channelSampleRate;
     m_Bandwidth = bandwidth;
     m_channelFrequencyOffset = channelFrequencyOffset;
@@ -282,5 +349,17 @@ void LoRaDemodSink::applySettings(const LoRaDemodSettings& settings, bool force)
             << " m_title: " << settings.m_title
             << " force: " << force;
 
+    if ((settings.m_spread != m_settings.m_spread) || force)
+    {
+        delete m_multiSF;
+        m_multiSF = nullptr;
+
+        if (settings.m_spread == LoRaDemodSettings::spreadMultiSF)
+        {
+            m_multiSF = new LoRaDemodMultiSF();
+            m_multiSF->setBandwidth(m_Bandwidth);
+        }
+    }
+
     m_settings = settings;
 }
@@ -20,6 +20,8 @@
 
 #include <vector>
 
+#include <QMutex>
+
 #include "dsp/channelsamplesink.h"
 #include "dsp/nco.h"
 #include "dsp/interpolator.h"
@@ -27,8 +29,10 @@
 #include "dsp/fftfilt.h"
 
 #include "lorademodsettings.h"
+#include "lorademodmultisf.h"
 
 class BasebandSampleSink;
+class MessageQueue;
 
 class LoRaDemodSink : public ChannelSampleSink {
 public:
@@ -40,6 +44,8 @@ public:
 	void setSpectrumSink(BasebandSampleSink* spectrumSink) { m_spectrumSink = spectrumSink; }
     void applyChannelSettings(int channelSampleRate, int bandwidth, int channelFrequencyOffset, bool force = false);
     void applySettings(const LoRaDemodSettings& settings, bool force = false);
+    void setMessageQueueToGUI(MessageQueue *messageQueue) { m_messageQueueToGUI = messageQueue; }
+    unsigned int getLastFrame(LoRaDemodMultiSF::Frame& frame); //!< Copies the last multi SF frame and returns the number of frames so far
 
 private:
     LoRaDemodSettings m_settings;
@@ -68,12 +74,21 @@ private:
 	BasebandSampleSink* m_spectrumSink;
 	SampleVector m_sampleBuffer;
 
+	LoRaDemodMultiSF *m_multiSF; //!< All spreading factors demodulator (nullptr when not selected)
+	std::vector<Complex> m_multiSFSamples;
+	std::vector<LoRaDemodMultiSF::Frame> m_multiSFFrames;
+	LoRaDemodMultiSF::Frame m_lastFrame; //!< Last multi SF frame for the channel report
+	unsigned int m_frameCount;
+	QMutex m_frameMutex;                 //!< Last frame is read by the API thread
+	MessageQueue *m_messageQueueToGUI;
+
     static const int DATA_BITS;
     static const int SAMPLEBITS;
     static const int SPREADFACTOR;
     static const int LORA_SFFT_LEN;
     static const int LORA_SQUELCH;
 
+	void feedMultiSF(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
 	int  detect(Complex sample, Complex angle);
 	void dumpRaw(void);
 	short synch (short bin);
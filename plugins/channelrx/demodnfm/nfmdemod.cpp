@@ -88,6 +88,12 @@ void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
     m_basebandSink->feed(begin, end);
 }
 
+void NFMDemod::feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end, bool firstOfBurst)
+{
+    (void) firstOfBurst;
+    m_basebandSink->feedFloat(begin, end);
+}
+
 void NFMDemod::start()
 {
     qDebug() << "NFMDemod::start";
@@ -107,6 +113,11 @@ void NFMDemod::stop()
 	m_thread->wait();
 }
 
+void NFMDemod::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool NFMDemod::handleMessage(const Message& cmd)
 {
 	if (MsgConfigureNFMDemod::match(cmd))
@@ -29,6 +29,7 @@ NFMDemodBaseband::NFMDemodBaseband() :
     m_mutex(QMutex::Recursive)
 {
     m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
+    m_floatSampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
     m_channelizer = new DownChannelizer(&m_sink);
 
     qDebug("NFMDemodBaseband::NFMDemodBaseband");
@@ -39,6 +40,13 @@ NFMDemodBaseband::NFMDemodBaseband() :
         &NFMDemodBaseband::handleData,
         Qt::QueuedConnection
     );
+    QObject::connect(
+        &m_floatSampleFifo,
+        &FSampleSinkFifo::dataReady,
+        this,
+        &NFMDemodBaseband::handleFloatData,
+        Qt::QueuedConnection
+    );
 
     DSPEngine::instance()->getAudioDeviceManager()->addAudioSink(m_sink.getAudioFifo(), getInputMessageQueue());
     m_sink.applyAudioSampleRate(DSPEngine::instance()->getAudioDeviceManager()->getOutputSampleRate());
@@ -56,6 +64,7 @@ void NFMDemodBaseband::reset()
 {
     QMutexLocker mutexLocker(&m_mutex);
     m_sampleFifo.reset();
+    m_floatSampleFifo.reset();
 }
 
 void NFMDemodBaseband::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
@@ -63,6 +72,36 @@ void NFMDemodBaseband::feed(const SampleVector::const_iterator& begin, const Sam
     m_sampleFifo.write(begin, end);
 }
 
+void NFMDemodBaseband::feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end)
+{
+    m_floatSampleFifo.write(begin, end);
+}
+
+void NFMDemodBaseband::handleFloatData()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    while ((m_floatSampleFifo.fill() > 0) && (m_inputMessageQueue.size() == 0))
+    {
+		FSampleVector::iterator part1begin;
+		FSampleVector::iterator part1end;
+		FSampleVector::iterator part2begin;
+		FSampleVector::iterator part2end;
+
+        std::size_t count = m_floatSampleFifo.readBegin(m_floatSampleFifo.fill(), &part1begin, &part1end, &part2begin, &part2end);
+
+        if (part1begin != part1end) {
+            m_channelizer->feedFloat(part1begin, part1end);
+        }
+
+		if (part2begin != part2end) {
+            m_channelizer->feedFloat(part2begin, part2end);
+        }
+
+		m_floatSampleFifo.readCommit((unsigned int) count);
+    }
+}
+
 void NFMDemodBaseband::handleData()
 {
     QMutexLocker mutexLocker(&m_mutex);
@@ -120,6 +159,8 @@ bool NFMDemodBaseband::handleMessage(const Message& cmd)
         DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
         qDebug() << "NFMDemodBaseband::handleMessage: DSPSignalNotification: basebandSampleRate: " << notif.getSampleRate();
         m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(notif.getSampleRate()));
+        m_floatSampleFifo.setSize(SampleSinkFifo::getSizePolicy(notif.getSampleRate()));
+
         m_channelizer->setBasebandSampleRate(notif.getSampleRate());
         m_sink.applyChannelSettings(m_channelizer->getChannelSampleRate(), m_channelizer->getChannelFrequencyOffset());
         m_sink.applyAudioSampleRate(m_sink.getAudioSampleRate()); // reapply in case of channel sample rate change
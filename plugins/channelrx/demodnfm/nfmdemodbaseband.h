@@ -22,6 +22,7 @@
 #include <QMutex>
 
 #include "dsp/samplesinkfifo.h"
+#include "dsp/fsamplesinkfifo.h"
 #include "util/message.h"
 #include "util/messagequeue.h"
 
@@ -60,6 +61,8 @@ public:
     ~NFMDemodBaseband();
     void reset();
     void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end);
+    void setCompactSamples(bool compactSamples) { m_sampleFifo.setCompact(compactSamples); }
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     int getChannelSampleRate() const;
     void getMagSqLevels(double& avg, double& peak, int& nbSamples) { m_sink.getMagSqLevels(avg, peak, nbSamples); }
@@ -72,6 +75,7 @@ public:
 
 private:
     SampleSinkFifo m_sampleFifo;
+    FSampleSinkFifo m_floatSampleFifo; //!< Float baseband input
     DownChannelizer *m_channelizer;
     NFMDemodSink m_sink;
 	MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
@@ -84,6 +88,7 @@ private:
 private slots:
     void handleInputMessages();
     void handleData(); //!< Handle data when samples have to be processed
+    void handleFloatData();
 };
 
 #endif // INCLUDE_NFMDEMODBASEBAND_H
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "gui/crightclickenabler.h"
 #include "gui/audioselectdialog.h"
 #include "dsp/dspengine.h"
+#include "dsp/dcsdetector.h"
 #include "mainwindow.h"
 
 #include "nfmdemodreport.h"
@@ -82,6 +83,12 @@ bool NFMDemodGUI::handleMessage(const Message& message)
         setCtcssFreq(report.getFrequency());
         return true;
     }
+    else if (NFMDemodReport::MsgReportDCSCode::match(message))
+    {
+        NFMDemodReport::MsgReportDCSCode& report = (NFMDemodReport::MsgReportDCSCode&) message;
+        setDcsCode(report.getDetected(), report.getCode(), report.getInverted());
+        return true;
+    }
     else if (NFMDemod::MsgConfigureNFMDemod::match(message))
     {
         qDebug("NFMDemodGUI::handleMessage: NFMDemod::MsgConfigureNFMDemod");
@@ -284,7 +291,11 @@ NFMDemodGUI::NFMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseban
 	m_doApplySettings(true),
 	m_squelchOpen(false),
     m_audioSampleRate(-1),
-	m_tickCount(0)
+	m_tickCount(0),
+	m_ctcssFreq(0),
+	m_dcsDetected(false),
+	m_dcsCode(0),
+	m_dcsInverted(false)
 {
 	ui->setupUi(this);
 	setAttribute(Qt::WA_DeleteOnClose, true);
@@ -446,13 +457,31 @@ void NFMDemodGUI::enterEvent(QEvent*)
 
 void NFMDemodGUI::setCtcssFreq(Real ctcssFreq)
 {
-	if (ctcssFreq == 0)
+	m_ctcssFreq = ctcssFreq;
+	displayTone();
+}
+
+void NFMDemodGUI::setDcsCode(bool detected, unsigned int code, bool inverted)
+{
+	m_dcsDetected = detected;
+	m_dcsCode = code;
+	m_dcsInverted = inverted;
+	displayTone();
+}
+
+void NFMDemodGUI::displayTone()
+{
+	if (m_dcsDetected) // a DCS signal also puts energy at CTCSS frequencies
+	{
+		ui->ctcssText->setText("D" + DCSDetector::getCodeName(m_dcsCode, m_dcsInverted));
+	}
+	else if (m_ctcssFreq == 0)
 	{
 		ui->ctcssText->setText("--");
 	}
 	else
 	{
-		ui->ctcssText->setText(QString("%1").arg(ctcssFreq));
+		ui->ctcssText->setText(QString("%1").arg(m_ctcssFreq));
 	}
 }
 
@@ -37,6 +37,7 @@ public:
 	virtual MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
 	virtual bool handleMessage(const Message& message);
 	void setCtcssFreq(Real ctcssFreq);
+	void setDcsCode(bool detected, unsigned int code, bool inverted);
 
 public slots:
 	void channelMarkerChangedByCursor();
@@ -55,6 +56,10 @@ private:
 	bool m_squelchOpen;
     int m_audioSampleRate;
 	uint32_t m_tickCount;
+	Real m_ctcssFreq;
+	bool m_dcsDetected;
+	unsigned int m_dcsCode;
+	bool m_dcsInverted;
 	MessageQueue m_inputMessageQueue;
 
 	explicit NFMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel, QWidget* parent = 0);
@@ -64,6 +69,7 @@ private:
 	void applySettings(bool force = false);
 	void displaySettings();
     void displayStreamIndex();
+	void displayTone();
 
 	void leaveEvent(QEvent*);
 	void enterEvent(QEvent*);
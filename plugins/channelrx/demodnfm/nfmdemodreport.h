@@ -47,6 +47,32 @@ public:
         { }
     };
 
+    class MsgReportDCSCode : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        bool getDetected() const { return m_detected; }
+        unsigned int getCode() const { return m_code; }
+        bool getInverted() const { return m_inverted; }
+
+        static MsgReportDCSCode* create(bool detected, unsigned int code, bool inverted)
+        {
+            return new MsgReportDCSCode(detected, code, inverted);
+        }
+
+    private:
+        bool m_detected;
+        unsigned int m_code;
+        bool m_inverted;
+
+        MsgReportDCSCode(bool detected, unsigned int code, bool inverted) :
+            Message(),
+            m_detected(detected),
+            m_code(code),
+            m_inverted(inverted)
+        { }
+    };
+
 public:
     NFMDemodReport();
     ~NFMDemodReport();
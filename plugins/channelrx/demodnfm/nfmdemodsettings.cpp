@@ -30,6 +30,11 @@ const int NFMDemodSettings::m_fmDev[] = { // corresponding single side FM deviat
     2000, 2500, 3330, 4000,  5000,  6000,  8000,  10000,  16000
 };
 const int NFMDemodSettings::m_nbRfBW = 9;
+const int NFMDemodSettings::m_legacyCtcssIndexes[] = { // 32 EIA tones of older versions in the 50 standard tones
+     1,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, 26, 28, 30, 32, 34, 36, 38, 41
+};
+const int NFMDemodSettings::m_nbLegacyCtcssIndexes = 32;
 
 NFMDemodSettings::NFMDemodSettings() :
     m_channelMarker(0)
@@ -72,7 +77,7 @@ QByteArray NFMDemodSettings::serialize() const
     s.writeS32(5, static_cast<int>(m_squelch));
     s.writeBool(6, m_highPass);
     s.writeU32(7, m_rgbColor);
-    s.writeS32(8, m_ctcssIndex);
+    s.writeS32(8, getLegacyCtcssIndex(m_ctcssIndex));
     s.writeBool(9, m_ctcssOn);
     s.writeBool(10, m_audioMute);
     s.writeS32(11, m_squelchGate);
@@ -90,6 +95,7 @@ QByteArray NFMDemodSettings::serialize() const
     s.writeU32(19, m_reverseAPIDeviceIndex);
     s.writeU32(20, m_reverseAPIChannelIndex);
     s.writeS32(21, m_streamIndex);
+    s.writeS32(22, m_ctcssIndex);
 
     return s.final();
 }
@@ -129,7 +135,8 @@ bool NFMDemodSettings::deserialize(const QByteArray& data)
         m_squelch = (tmp < -100 ? tmp/10 : tmp) * 1.0;
         d.readBool(6, &m_highPass, true);
         d.readU32(7, &m_rgbColor, QColor(255, 0, 0).rgb());
-        d.readS32(8, &m_ctcssIndex, 0);
+        d.readS32(8, &tmp, 0);
+        m_ctcssIndex = tmp > 0 && tmp <= m_nbLegacyCtcssIndexes ? m_legacyCtcssIndexes[tmp-1] : 0;
         d.readBool(9, &m_ctcssOn, false);
         d.readBool(10, &m_audioMute, false);
         d.readS32(11, &m_squelchGate, 5);
@@ -151,6 +158,7 @@ bool NFMDemodSettings::deserialize(const QByteArray& data)
         d.readU32(20, &utmp, 0);
         m_reverseAPIChannelIndex = utmp > 99 ? 99 : utmp;
         d.readS32(21, &m_streamIndex, 0);
+        d.readS32(22, &m_ctcssIndex, m_ctcssIndex);
 
         return true;
     }
@@ -195,3 +203,15 @@ int NFMDemodSettings::getRFBWIndex(int rfbw)
 
     return m_nbRfBW-1;
 }
+
+int NFMDemodSettings::getLegacyCtcssIndex(int ctcssIndex)
+{
+    for (int i = 0; i < m_nbLegacyCtcssIndexes; i++)
+    {
+        if (m_legacyCtcssIndexes[i] == ctcssIndex) {
+            return i + 1;
+        }
+    }
+
+    return 0;
+}
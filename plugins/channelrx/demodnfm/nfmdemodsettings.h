@@ -27,6 +27,8 @@ struct NFMDemodSettings
     static const int m_nbRfBW;
     static const int m_rfBW[];
     static const int m_fmDev[];
+    static const int m_nbLegacyCtcssIndexes;
+    static const int m_legacyCtcssIndexes[];
 
     int32_t m_inputFrequencyOffset;
     Real m_rfBandwidth;
@@ -38,7 +40,7 @@ struct NFMDemodSettings
     Real m_volume;
     bool m_ctcssOn;
     bool m_audioMute;
-    int  m_ctcssIndex;
+    int  m_ctcssIndex; //!< 1 based index in the 50 standard tones. 0 for none
     quint32 m_rgbColor;
     QString m_title;
     QString m_audioDeviceName;
@@ -61,6 +63,7 @@ struct NFMDemodSettings
     static int getRFBW(int index);
     static int getFMDev(int index);
     static int getRFBWIndex(int rfbw);
+    static int getLegacyCtcssIndex(int ctcssIndex); //!< Index in the 32 EIA tones of older versions or 0
 };
 
 
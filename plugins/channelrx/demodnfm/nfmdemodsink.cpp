@@ -42,6 +42,7 @@ NFMDemodSink::NFMDemodSink() :
         m_audioBufferFill(0),
         m_audioFifo(48000),
         m_ctcssIndex(0),
+        m_dcsDetected(false),
         m_sampleCount(0),
         m_squelchCount(0),
         m_squelchGate(4800),
@@ -69,31 +70,47 @@ NFMDemodSink::~NFMDemodSink()
 
 void NFMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-	Complex ci;
-
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
 		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		processOneInput(c);
+    }
+
+    processTones();
+}
+
+void NFMDemodSink::feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end)
+{
+	for (FSampleVector::const_iterator it = begin; it != end; ++it)
+	{
+		Complex c(it->real() * SDR_RX_SCALEF, it->imag() * SDR_RX_SCALEF); // same scale as fixed point input
+		processOneInput(c);
+    }
 
-        if (m_interpolatorDistance < 1.0f) // interpolate
+    processTones();
+}
+
+void NFMDemodSink::processOneInput(Complex &c)
+{
+	Complex ci;
+	c *= m_nco.nextIQ();
+
+    if (m_interpolatorDistance < 1.0f) // interpolate
+    {
+        while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
         {
-            while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
+            processOneSample(ci);
+            m_interpolatorDistanceRemain += m_interpolatorDistance;
         }
-        else // decimate
+    }
+    else // decimate
+    {
+        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
         {
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
+            processOneSample(ci);
+            m_interpolatorDistanceRemain += m_interpolatorDistance;
         }
     }
-
 }
 
 void NFMDemodSink::processOneSample(Complex &ci)
@@ -167,8 +184,16 @@ void NFMDemodSink::processOneSample(Complex &ci)
         }
     }
 
+    bool squelchWasOpen = m_squelchOpen;
     m_squelchOpen = (m_squelchCount > m_squelchGate);
 
+    if (squelchWasOpen && !m_squelchOpen) // tone audio from before the squelch closed is not relevant anymore
+    {
+        m_ctcssDetector.reset();
+        m_dcsDetector.reset();
+        m_toneBuffer.clear();
+    }
+
     if (m_settings.m_audioMute)
     {
         sample = 0;
@@ -181,39 +206,8 @@ void NFMDemodSink::processOneSample(Complex &ci)
             {
                 Real ctcss_sample = m_ctcssLowpass.filter(demod);
 
-                if ((m_sampleCount & 7) == 7) // decimate 48k -> 6k
-                {
-                    if (m_ctcssDetector.analyze(&ctcss_sample))
-                    {
-                        int maxToneIndex;
-
-                        if (m_ctcssDetector.getDetectedTone(maxToneIndex))
-                        {
-                            if (maxToneIndex+1 != m_ctcssIndex)
-                            {
-                                if (getMessageQueueToGUI())
-                                {
-                                    NFMDemodReport::MsgReportCTCSSFreq *msg = NFMDemodReport::MsgReportCTCSSFreq::create(m_ctcssDetector.getToneSet()[maxToneIndex]);
-                                    getMessageQueueToGUI()->push(msg);
-                                }
-
-                                m_ctcssIndex = maxToneIndex+1;
-                            }
-                        }
-                        else
-                        {
-                            if (m_ctcssIndex != 0)
-                            {
-                                if (getMessageQueueToGUI())
-                                {
-                                    NFMDemodReport::MsgReportCTCSSFreq *msg = NFMDemodReport::MsgReportCTCSSFreq::create(0);
-                                    getMessageQueueToGUI()->push(msg);
-                                }
-
-                                m_ctcssIndex = 0;
-                            }
-                        }
-                    }
+                if ((m_sampleCount & 7) == 7) { // decimate 48k -> 6k
+                    m_toneBuffer.push_back(ctcss_sample);
                 }
             }
 
@@ -243,6 +237,17 @@ void NFMDemodSink::processOneSample(Complex &ci)
                 m_ctcssIndex = 0;
             }
 
+            if (m_dcsDetected)
+            {
+                if (getMessageQueueToGUI())
+                {
+                    NFMDemodReport::MsgReportDCSCode *msg = NFMDemodReport::MsgReportDCSCode::create(false, 0, false);
+                    getMessageQueueToGUI()->push(msg);
+                }
+
+                m_dcsDetected = false;
+            }
+
             sample = 0;
         }
     }
@@ -266,6 +271,61 @@ void NFMDemodSink::processOneSample(Complex &ci)
 }
 
 
+void NFMDemodSink::processTones()
+{
+    if (m_toneBuffer.size() == 0) {
+        return;
+    }
+
+    // All tones are analyzed at once on the block
+    if (m_ctcssDetector.analyze(m_toneBuffer.data(), m_toneBuffer.size()))
+    {
+        int maxToneIndex;
+
+        if (m_ctcssDetector.getDetectedTone(maxToneIndex))
+        {
+            if (maxToneIndex+1 != m_ctcssIndex)
+            {
+                if (getMessageQueueToGUI())
+                {
+                    NFMDemodReport::MsgReportCTCSSFreq *msg = NFMDemodReport::MsgReportCTCSSFreq::create(m_ctcssDetector.getToneSet()[maxToneIndex]);
+                    getMessageQueueToGUI()->push(msg);
+                }
+
+                m_ctcssIndex = maxToneIndex+1;
+            }
+        }
+        else
+        {
+            if (m_ctcssIndex != 0)
+            {
+                if (getMessageQueueToGUI())
+                {
+                    NFMDemodReport::MsgReportCTCSSFreq *msg = NFMDemodReport::MsgReportCTCSSFreq::create(0);
+                    getMessageQueueToGUI()->push(msg);
+                }
+
+                m_ctcssIndex = 0;
+            }
+        }
+    }
+
+    if (m_dcsDetector.analyze(m_toneBuffer.data(), m_toneBuffer.size()))
+    {
+        unsigned int code;
+        bool inverted;
+        m_dcsDetected = m_dcsDetector.getDetectedCode(code, inverted);
+
+        if (getMessageQueueToGUI())
+        {
+            NFMDemodReport::MsgReportDCSCode *msg = NFMDemodReport::MsgReportDCSCode::create(m_dcsDetected, code, inverted);
+            getMessageQueueToGUI()->push(msg);
+        }
+    }
+
+    m_toneBuffer.clear();
+}
+
 void NFMDemodSink::applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force)
 {
     qDebug() << "NFMDemodSink::applyChannelSettings:"
@@ -371,7 +431,8 @@ void NFMDemodSink::applyAudioSampleRate(unsigned int sampleRate)
     m_lowpass.create(301, sampleRate, m_settings.m_afBandwidth);
     m_squelchGate = (sampleRate / 100) * m_settings.m_squelchGate; // gate is given in 10s of ms at 48000 Hz audio sample rate
     m_squelchCount = 0; // reset squelch open counter
-    m_ctcssDetector.setCoefficients(sampleRate/16, sampleRate/8.0f); // 0.5s / 2 Hz resolution
+    m_ctcssDetector.setCoefficients(sampleRate/8, sampleRate/8.0f); // 1s / 1 Hz resolution to separate close tones (67.0/69.3 Hz)
+    m_dcsDetector.setSampleRate(sampleRate/8);
 
     if (sampleRate < 16000) {
         m_afSquelch.setCoefficients(sampleRate/2000, 600, sampleRate, 200, 0, afSqTones_lowrate); // 0.5ms test period, 300ms average span, audio SR, 100ms attack, no decay
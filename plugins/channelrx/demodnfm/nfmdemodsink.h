@@ -29,6 +29,7 @@
 #include "dsp/afsquelch.h"
 #include "dsp/agc.h"
 #include "dsp/ctcssdetector.h"
+#include "dsp/dcsdetector.h"
 #include "util/movingaverage.h"
 #include "util/doublebufferfifo.h"
 #include "audio/audiofifo.h"
@@ -41,6 +42,7 @@ public:
 	~NFMDemodSink();
 
 	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+	virtual void feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end);
 
 	const Real *getCtcssToneSet(int& nbTones) const {
 		nbTones = m_ctcssDetector.getNTones();
@@ -114,6 +116,9 @@ private:
 	CTCSSDetector m_ctcssDetector;
 	int m_ctcssIndex; // 0 for nothing detected
 	int m_ctcssIndexSelected;
+	DCSDetector m_dcsDetector;
+	bool m_dcsDetected;
+	std::vector<Real> m_toneBuffer; //!< Tone audio of the current block analyzed at the end of feed
 	int m_sampleCount;
 	int m_squelchCount;
 	int m_squelchGate;
@@ -139,6 +144,8 @@ private:
     static const double afSqTones_lowrate[];
 
     void processOneSample(Complex &ci);
+    void processOneInput(Complex &c);
+    void processTones();
     MessageQueue *getMessageQueueToGUI() { return m_messageQueueToGUI; }
 
     inline float arctan2(Real y, Real x)
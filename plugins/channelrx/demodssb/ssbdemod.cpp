@@ -107,6 +107,11 @@ void SSBDemod::stop()
 	m_thread->wait();
 }
 
+void SSBDemod::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool SSBDemod::handleMessage(const Message& cmd)
 {
     if (MsgConfigureSSBDemod::match(cmd))
@@ -109,6 +109,11 @@ void WFMDemod::stop()
 	m_thread->wait();
 }
 
+void WFMDemod::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool WFMDemod::handleMessage(const Message& cmd)
 {
     if (MsgConfigureWFMDemod::match(cmd))
@@ -118,6 +118,11 @@ void FileSink::stop()
 	m_thread.wait();
 }
 
+void FileSink::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool FileSink::handleMessage(const Message& cmd)
 {
     if (DSPSignalNotification::match(cmd))
@@ -112,6 +112,11 @@ void FreqTracker::stop()
 	m_thread->wait();
 }
 
+void FreqTracker::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool FreqTracker::handleMessage(const Message& cmd)
 {
     if (DSPSignalNotification::match(cmd))
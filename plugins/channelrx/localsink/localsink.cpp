@@ -100,6 +100,11 @@ void LocalSink::stop()
 	m_thread->wait();
 }
 
+void LocalSink::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool LocalSink::handleMessage(const Message& cmd)
 {
     if (DSPSignalNotification::match(cmd))
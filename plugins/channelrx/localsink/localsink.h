@@ -88,6 +88,7 @@ public:
     virtual void start();
     virtual void stop();
     virtual bool handleMessage(const Message& cmd);
+    virtual void setCompactSamples(bool compactSamples);
 
     virtual void getIdentifier(QString& id) { id = objectName(); }
     virtual void getTitle(QString& title) { title = "Local Sink"; }
@@ -16,24 +16,28 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QDebug>
+#include <QThread>
 
-#include <boost/crc.hpp>
-#include <boost/cstdint.hpp>
 #include "dsp/devicesamplesource.h"
-#include "dsp/hbfilterchainconverter.h"
+#include "dsp/samplesinkfifo.h"
 
-#include "localsinkworker.h"
 #include "localsinksink.h"
 
+const int LocalSinkSink::m_backPressureTimeoutUs = 20000;
+const int LocalSinkSink::m_dropReportPeriodMs = 2500;
+
 LocalSinkSink::LocalSinkSink() :
-        m_sinkWorker(nullptr),
+        m_deviceSampleFifo(nullptr),
         m_running(false),
+        m_stalled(false),
+        m_samplesCount(0),
+        m_droppedCount(0),
+        m_droppedReported(0),
         m_centerFrequency(0),
         m_frequencyOffset(0),
         m_sampleRate(48000),
         m_deviceSampleRate(48000)
 {
-    m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(4000000));
     applySettings(m_settings, true);
 }
 
@@ -43,7 +47,39 @@ LocalSinkSink::~LocalSinkSink()
 
 void LocalSinkSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-    m_sampleFifo.write(begin, end);
+    if (!m_running || !m_deviceSampleFifo) {
+        return;
+    }
+
+    unsigned int count = end - begin;
+    unsigned int room = m_deviceSampleFifo->size() - m_deviceSampleFifo->fill();
+
+    // back-pressure: give the Local Input engine a chance to catch up before dropping
+    if ((room < count) && !m_stalled)
+    {
+        for (int waited = 0; (room < count) && (waited < m_backPressureTimeoutUs); waited += 500)
+        {
+            QThread::usleep(500);
+            room = m_deviceSampleFifo->size() - m_deviceSampleFifo->fill();
+        }
+
+        m_stalled = room < count;
+    }
+    else if (room >= count)
+    {
+        m_stalled = false;
+    }
+
+    unsigned int written = m_deviceSampleFifo->write(begin, end);
+    m_samplesCount += written;
+    m_droppedCount += count - written;
+
+    if ((m_droppedCount != m_droppedReported) && (m_dropReportTimer.elapsed() > m_dropReportPeriodMs))
+    {
+        qWarning("LocalSinkSink::feed: %llu samples dropped (%llu handed over)", m_droppedCount - m_droppedReported, m_samplesCount);
+        m_droppedReported = m_droppedCount;
+        m_dropReportTimer.restart();
+    }
 }
 
 void LocalSinkSink::start(DeviceSampleSource *deviceSource)
@@ -54,60 +90,22 @@ void LocalSinkSink::start(DeviceSampleSource *deviceSource)
         stop();
     }
 
-    m_sinkWorker = new LocalSinkWorker();
-    m_sinkWorker->moveToThread(&m_sinkWorkerThread);
-    m_sinkWorker->setSampleFifo(&m_sampleFifo);
-
-    if (deviceSource) {
-        m_sinkWorker->setDeviceSampleFifo(deviceSource->getSampleFifo());
-    }
-
-    QObject::connect(
-        &m_sampleFifo,
-        &SampleSinkFifo::dataReady,
-        m_sinkWorker,
-        &LocalSinkWorker::handleData,
-        Qt::QueuedConnection
-    );
-
-    startWorker();
+    m_deviceSampleFifo = deviceSource ? deviceSource->getSampleFifo() : nullptr;
+    m_stalled = false;
+    m_samplesCount = 0;
+    m_droppedCount = 0;
+    m_droppedReported = 0;
+    m_dropReportTimer.start();
     m_running = true;
 }
 
 void LocalSinkSink::stop()
 {
-    qDebug("LocalSinkSink::stop");
-
-    QObject::disconnect(
-        &m_sampleFifo,
-        &SampleSinkFifo::dataReady,
-        m_sinkWorker,
-        &LocalSinkWorker::handleData
-    );
-
-    if (m_sinkWorker != 0)
-    {
-        stopWorker();
-        m_sinkWorker->deleteLater();
-        m_sinkWorker = nullptr;
-    }
-
+    qDebug("LocalSinkSink::stop: %llu samples handed over %llu dropped", m_samplesCount, m_droppedCount);
+    m_deviceSampleFifo = nullptr;
     m_running = false;
 }
 
-void LocalSinkSink::startWorker()
-{
-	m_sinkWorker->startStop(true);
-	m_sinkWorkerThread.start();
-}
-
-void LocalSinkSink::stopWorker()
-{
-	m_sinkWorker->startStop(false);
-	m_sinkWorkerThread.quit();
-	m_sinkWorkerThread.wait();
-}
-
 void LocalSinkSink::applySettings(const LocalSinkSettings& settings, bool force)
 {
     qDebug() << "LocalSinkSink::applySettings:"
@@ -120,5 +118,5 @@ void LocalSinkSink::applySettings(const LocalSinkSettings& settings, bool force)
 
 void LocalSinkSink::setSampleRate(int sampleRate)
 {
-    m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(sampleRate));
+    m_sampleRate = sampleRate;
 }
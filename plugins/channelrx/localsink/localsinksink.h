@@ -19,15 +19,21 @@
 #define INCLUDE_LOCALSINKSINK_H_
 
 #include <QObject>
-#include <QThread>
+#include <QElapsedTimer>
 
 #include "dsp/channelsamplesink.h"
 
 #include "localsinksettings.h"
 
 class DeviceSampleSource;
-class LocalSinkWorker;
+class SampleSinkFifo;
 
+/**
+ * Hands the channel samples over to the Local Input device set. Samples are written directly
+ * in the FIFO read by the Local Input device engine so there is a single copy and no thread hop.
+ * When this FIFO is full the channel thread waits for the Local Input engine to make room for at
+ * most m_backPressureTimeoutUs then drops the samples that do not fit. Drops are counted.
+ */
 class LocalSinkSink : public QObject, public ChannelSampleSink {
     Q_OBJECT
 public:
@@ -41,21 +47,26 @@ public:
     void stop();
     bool isRunning() const { return m_running; }
     void setSampleRate(int sampleRate);
+    quint64 getSamplesCount() const { return m_samplesCount; }   //!< Samples handed over since start
+    quint64 getDroppedCount() const { return m_droppedCount; }   //!< Samples dropped since start
 
 private:
-    SampleSinkFifo m_sampleFifo;
+    SampleSinkFifo *m_deviceSampleFifo; //!< FIFO of the Local Input device
     LocalSinkSettings m_settings;
-    LocalSinkWorker *m_sinkWorker;
-    QThread m_sinkWorkerThread;
     bool m_running;
+    bool m_stalled;              //!< Local Input engine did not read during last wait: do not wait again until it does
+    quint64 m_samplesCount;
+    quint64 m_droppedCount;
+    quint64 m_droppedReported;
+    QElapsedTimer m_dropReportTimer;
 
     uint64_t m_centerFrequency;
     int64_t m_frequencyOffset;
     uint32_t m_sampleRate;
     uint32_t m_deviceSampleRate;
 
-	void startWorker();
-	void stopWorker();
+    static const int m_backPressureTimeoutUs;
+    static const int m_dropReportPeriodMs;
 };
 
 #endif // INCLUDE_LOCALSINKSINK_H_
@@ -0,0 +1,389 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QThread>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QBuffer>
+
+#include "SWGChannelSettings.h"
+
+#include "util/simpleserializer.h"
+#include "dsp/dspcommands.h"
+#include "device/deviceapi.h"
+
+#include "rdsmonitorbaseband.h"
+#include "rdsmonitor.h"
+
+MESSAGE_CLASS_DEFINITION(RDSMonitor::MsgConfigureRDSMonitor, Message)
+MESSAGE_CLASS_DEFINITION(RDSMonitor::MsgBasebandNotification, Message)
+
+const QString RDSMonitor::m_channelIdURI = "sdrangel.channel.rdsmonitor";
+const QString RDSMonitor::m_channelId = "RDSMonitor";
+
+RDSMonitor::RDSMonitor(DeviceAPI *deviceAPI) :
+        ChannelAPI(m_channelIdURI, ChannelAPI::StreamSingleSink),
+        m_deviceAPI(deviceAPI)
+{
+    setObjectName(m_channelId);
+
+    m_thread = new QThread(this);
+    m_basebandSink = new RDSMonitorBaseband();
+    m_basebandSink->moveToThread(m_thread);
+
+    applySettings(m_settings, true);
+
+    m_deviceAPI->addChannelSink(this);
+    m_deviceAPI->addChannelSinkAPI(this);
+
+    m_networkManager = new QNetworkAccessManager();
+    connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
+}
+
+RDSMonitor::~RDSMonitor()
+{
+    disconnect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
+    delete m_networkManager;
+    m_deviceAPI->removeChannelSinkAPI(this);
+    m_deviceAPI->removeChannelSink(this);
+    delete m_basebandSink;
+    delete m_thread;
+}
+
+uint32_t RDSMonitor::getNumberOfDeviceStreams() const
+{
+    return m_deviceAPI->getNbSourceStreams();
+}
+
+void RDSMonitor::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
+{
+    (void) firstOfBurst;
+    m_basebandSink->feed(begin, end);
+}
+
+void RDSMonitor::start()
+{
+    qDebug("RDSMonitor::start");
+    m_basebandSink->reset();
+    m_thread->start();
+}
+
+void RDSMonitor::stop()
+{
+    qDebug("RDSMonitor::stop");
+    m_thread->exit();
+    m_thread->wait();
+}
+
+void RDSMonitor::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
+bool RDSMonitor::handleMessage(const Message& cmd)
+{
+    if (DSPSignalNotification::match(cmd))
+    {
+        DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
+
+        qDebug() << "RDSMonitor::handleMessage: DSPSignalNotification:"
+                << " inputSampleRate: " << notif.getSampleRate()
+                << " centerFrequency: " << notif.getCenterFrequency();
+
+        DSPSignalNotification *msg = new DSPSignalNotification(notif.getSampleRate(), notif.getCenterFrequency());
+        m_basebandSink->getInputMessageQueue()->push(msg);
+
+        if (getMessageQueueToGUI())
+        {
+            MsgBasebandNotification *msg = MsgBasebandNotification::create(notif.getSampleRate(), notif.getCenterFrequency());
+            getMessageQueueToGUI()->push(msg);
+        }
+
+        return true;
+    }
+    else if (MsgConfigureRDSMonitor::match(cmd))
+    {
+        MsgConfigureRDSMonitor& cfg = (MsgConfigureRDSMonitor&) cmd;
+        qDebug() << "RDSMonitor::handleMessage: MsgConfigureRDSMonitor";
+        applySettings(cfg.getSettings(), cfg.getForce());
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+QByteArray RDSMonitor::serialize() const
+{
+    return m_settings.serialize();
+}
+
+bool RDSMonitor::deserialize(const QByteArray& data)
+{
+    if (m_settings.deserialize(data))
+    {
+        MsgConfigureRDSMonitor *msg = MsgConfigureRDSMonitor::create(m_settings, true);
+        m_inputMessageQueue.push(msg);
+        return true;
+    }
+    else
+    {
+        m_settings.resetToDefaults();
+        MsgConfigureRDSMonitor *msg = MsgConfigureRDSMonitor::create(m_settings, true);
+        m_inputMessageQueue.push(msg);
+        return false;
+    }
+}
+
+void RDSMonitor::getStatus(std::vector<RDSMonitorSink::StationStatus>& status) const
+{
+    m_basebandSink->getStatus(status);
+}
+
+void RDSMonitor::applySettings(const RDSMonitorSettings& settings, bool force)
+{
+    qDebug() << "RDSMonitor::applySettings:"
+            << "m_frequencies: " << RDSMonitorSettings::frequenciesToString(settings.m_frequencies)
+            << "m_nbThreads: " << settings.m_nbThreads
+            << "m_streamIndex: " << settings.m_streamIndex
+            << "force: " << force;
+
+    QList<QString> reverseAPIKeys;
+
+    if ((settings.m_frequencies != m_settings.m_frequencies) || force) {
+        reverseAPIKeys.append("frequencies");
+    }
+    if ((settings.m_nbThreads != m_settings.m_nbThreads) || force) {
+        reverseAPIKeys.append("nbThreads");
+    }
+    if ((settings.m_rgbColor != m_settings.m_rgbColor) || force) {
+        reverseAPIKeys.append("rgbColor");
+    }
+    if ((settings.m_title != m_settings.m_title) || force) {
+        reverseAPIKeys.append("title");
+    }
+
+    RDSMonitorBaseband::MsgConfigureRDSMonitorBaseband *msg = RDSMonitorBaseband::MsgConfigureRDSMonitorBaseband::create(settings, force);
+    m_basebandSink->getInputMessageQueue()->push(msg);
+
+    if (m_settings.m_streamIndex != settings.m_streamIndex)
+    {
+        if (m_deviceAPI->getSampleMIMO()) // change of stream is possible for MIMO devices only
+        {
+            m_deviceAPI->removeChannelSinkAPI(this);
+            m_deviceAPI->removeChannelSink(this, m_settings.m_streamIndex);
+            m_deviceAPI->addChannelSink(this, settings.m_streamIndex);
+            m_deviceAPI->addChannelSinkAPI(this);
+        }
+
+        reverseAPIKeys.append("streamIndex");
+    }
+
+    if ((settings.m_useReverseAPI) && (reverseAPIKeys.size() != 0))
+    {
+        bool fullUpdate = ((m_settings.m_useReverseAPI != settings.m_useReverseAPI) && settings.m_useReverseAPI) ||
+                (m_settings.m_reverseAPIAddress != settings.m_reverseAPIAddress) ||
+                (m_settings.m_reverseAPIPort != settings.m_reverseAPIPort) ||
+                (m_settings.m_reverseAPIDeviceIndex != settings.m_reverseAPIDeviceIndex) ||
+                (m_settings.m_reverseAPIChannelIndex != settings.m_reverseAPIChannelIndex);
+        webapiReverseSendSettings(reverseAPIKeys, settings, fullUpdate || force);
+    }
+
+    m_settings = settings;
+}
+
+int RDSMonitor::webapiSettingsGet(
+        SWGSDRangel::SWGChannelSettings& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setRdsMonitorSettings(new SWGSDRangel::SWGRDSMonitorSettings());
+    response.getRdsMonitorSettings()->init();
+    webapiFormatChannelSettings(response, m_settings);
+    return 200;
+}
+
+int RDSMonitor::webapiSettingsPutPatch(
+        bool force,
+        const QStringList& channelSettingsKeys,
+        SWGSDRangel::SWGChannelSettings& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    RDSMonitorSettings settings = m_settings;
+    webapiUpdateChannelSettings(settings, channelSettingsKeys, response);
+
+    MsgConfigureRDSMonitor *msg = MsgConfigureRDSMonitor::create(settings, force);
+    m_inputMessageQueue.push(msg);
+
+    qDebug("RDSMonitor::webapiSettingsPutPatch: forward to GUI: %p", m_guiMessageQueue);
+    if (m_guiMessageQueue) // forward to GUI if any
+    {
+        MsgConfigureRDSMonitor *msgToGUI = MsgConfigureRDSMonitor::create(settings, force);
+        m_guiMessageQueue->push(msgToGUI);
+    }
+
+    webapiFormatChannelSettings(response, settings);
+
+    return 200;
+}
+
+void RDSMonitor::webapiUpdateChannelSettings(
+        RDSMonitorSettings& settings,
+        const QStringList& channelSettingsKeys,
+        SWGSDRangel::SWGChannelSettings& response)
+{
+    if (channelSettingsKeys.contains("frequencies")) {
+        settings.m_frequencies = RDSMonitorSettings::frequenciesFromString(*response.getRdsMonitorSettings()->getFrequencies());
+    }
+
+    if (channelSettingsKeys.contains("nbThreads"))
+    {
+        int nbThreads = response.getRdsMonitorSettings()->getNbThreads();
+        settings.m_nbThreads = nbThreads < 1 ? 1 : nbThreads > RDSMonitorSettings::m_maxThreads ? RDSMonitorSettings::m_maxThreads : nbThreads;
+    }
+
+    if (channelSettingsKeys.contains("rgbColor")) {
+        settings.m_rgbColor = response.getRdsMonitorSettings()->getRgbColor();
+    }
+    if (channelSettingsKeys.contains("title")) {
+        settings.m_title = *response.getRdsMonitorSettings()->getTitle();
+    }
+    if (channelSettingsKeys.contains("streamIndex")) {
+        settings.m_streamIndex = response.getRdsMonitorSettings()->getStreamIndex();
+    }
+    if (channelSettingsKeys.contains("useReverseAPI")) {
+        settings.m_useReverseAPI = response.getRdsMonitorSettings()->getUseReverseApi() != 0;
+    }
+    if (channelSettingsKeys.contains("reverseAPIAddress")) {
+        settings.m_reverseAPIAddress = *response.getRdsMonitorSettings()->getReverseApiAddress();
+    }
+    if (channelSettingsKeys.contains("reverseAPIPort")) {
+        settings.m_reverseAPIPort = response.getRdsMonitorSettings()->getReverseApiPort();
+    }
+    if (channelSettingsKeys.contains("reverseAPIDeviceIndex")) {
+        settings.m_reverseAPIDeviceIndex = response.getRdsMonitorSettings()->getReverseApiDeviceIndex();
+    }
+    if (channelSettingsKeys.contains("reverseAPIChannelIndex")) {
+        settings.m_reverseAPIChannelIndex = response.getRdsMonitorSettings()->getReverseApiChannelIndex();
+    }
+}
+
+void RDSMonitor::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const RDSMonitorSettings& settings)
+{
+    QString frequencies = RDSMonitorSettings::frequenciesToString(settings.m_frequencies);
+
+    if (response.getRdsMonitorSettings()->getFrequencies()) {
+        *response.getRdsMonitorSettings()->getFrequencies() = frequencies;
+    } else {
+        response.getRdsMonitorSettings()->setFrequencies(new QString(frequencies));
+    }
+
+    response.getRdsMonitorSettings()->setNbThreads(settings.m_nbThreads);
+    response.getRdsMonitorSettings()->setRgbColor(settings.m_rgbColor);
+
+    if (response.getRdsMonitorSettings()->getTitle()) {
+        *response.getRdsMonitorSettings()->getTitle() = settings.m_title;
+    } else {
+        response.getRdsMonitorSettings()->setTitle(new QString(settings.m_title));
+    }
+
+    response.getRdsMonitorSettings()->setStreamIndex(settings.m_streamIndex);
+    response.getRdsMonitorSettings()->setUseReverseApi(settings.m_useReverseAPI ? 1 : 0);
+
+    if (response.getRdsMonitorSettings()->getReverseApiAddress()) {
+        *response.getRdsMonitorSettings()->getReverseApiAddress() = settings.m_reverseAPIAddress;
+    } else {
+        response.getRdsMonitorSettings()->setReverseApiAddress(new QString(settings.m_reverseAPIAddress));
+    }
+
+    response.getRdsMonitorSettings()->setReverseApiPort(settings.m_reverseAPIPort);
+    response.getRdsMonitorSettings()->setReverseApiDeviceIndex(settings.m_reverseAPIDeviceIndex);
+    response.getRdsMonitorSettings()->setReverseApiChannelIndex(settings.m_reverseAPIChannelIndex);
+}
+
+void RDSMonitor::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const RDSMonitorSettings& settings, bool force)
+{
+    SWGSDRangel::SWGChannelSettings *swgChannelSettings = new SWGSDRangel::SWGChannelSettings();
+    swgChannelSettings->setDirection(0); // single sink (Rx)
+    swgChannelSettings->setOriginatorChannelIndex(getIndexInDeviceSet());
+    swgChannelSettings->setOriginatorDeviceSetIndex(getDeviceSetIndex());
+    swgChannelSettings->setChannelType(new QString("RDSMonitor"));
+    swgChannelSettings->setRdsMonitorSettings(new SWGSDRangel::SWGRDSMonitorSettings());
+    SWGSDRangel::SWGRDSMonitorSettings *swgRDSMonitorSettings = swgChannelSettings->getRdsMonitorSettings();
+
+    // transfer data that has been modified. When force is on transfer all data except reverse API data
+
+    if (channelSettingsKeys.contains("frequencies") || force) {
+        swgRDSMonitorSettings->setFrequencies(new QString(RDSMonitorSettings::frequenciesToString(settings.m_frequencies)));
+    }
+    if (channelSettingsKeys.contains("nbThreads") || force) {
+        swgRDSMonitorSettings->setNbThreads(settings.m_nbThreads);
+    }
+    if (channelSettingsKeys.contains("rgbColor") || force) {
+        swgRDSMonitorSettings->setRgbColor(settings.m_rgbColor);
+    }
+    if (channelSettingsKeys.contains("title") || force) {
+        swgRDSMonitorSettings->setTitle(new QString(settings.m_title));
+    }
+    if (channelSettingsKeys.contains("streamIndex") || force) {
+        swgRDSMonitorSettings->setStreamIndex(settings.m_streamIndex);
+    }
+
+    QString channelSettingsURL = QString("http://%1:%2/sdrangel/deviceset/%3/channel/%4/settings")
+            .arg(settings.m_reverseAPIAddress)
+            .arg(settings.m_reverseAPIPort)
+            .arg(settings.m_reverseAPIDeviceIndex)
+            .arg(settings.m_reverseAPIChannelIndex);
+    m_networkRequest.setUrl(QUrl(channelSettingsURL));
+    m_networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+
+    QBuffer *buffer = new QBuffer();
+    buffer->open((QBuffer::ReadWrite));
+    buffer->write(swgChannelSettings->asJson().toUtf8());
+    buffer->seek(0);
+
+    // Always use PATCH to avoid passing reverse API settings
+    QNetworkReply *reply = m_networkManager->sendCustomRequest(m_networkRequest, "PATCH", buffer);
+    buffer->setParent(reply);
+
+    delete swgChannelSettings;
+}
+
+void RDSMonitor::networkManagerFinished(QNetworkReply *reply)
+{
+    QNetworkReply::NetworkError replyError = reply->error();
+
+    if (replyError)
+    {
+        qWarning() << "RDSMonitor::networkManagerFinished:"
+                << " error(" << (int) replyError
+                << "): " << replyError
+                << ": " << reply->errorString();
+    }
+    else
+    {
+        QString answer = reply->readAll();
+        answer.chop(1); // remove last \n
+        qDebug("RDSMonitor::networkManagerFinished: reply:\n%s", answer.toStdString().c_str());
+    }
+
+    reply->deleteLater();
+}
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_RDSMONITOR_H_
+#define INCLUDE_RDSMONITOR_H_
+
+#include <vector>
+
+#include <QObject>
+#include <QNetworkRequest>
+
+#include "dsp/basebandsamplesink.h"
+#include "channel/channelapi.h"
+#include "rdsmonitorsettings.h"
+#include "rdsmonitorsink.h"
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QThread;
+
+class DeviceAPI;
+class RDSMonitorBaseband;
+
+class RDSMonitor : public BasebandSampleSink, public ChannelAPI {
+    Q_OBJECT
+public:
+    class MsgConfigureRDSMonitor : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        const RDSMonitorSettings& getSettings() const { return m_settings; }
+        bool getForce() const { return m_force; }
+
+        static MsgConfigureRDSMonitor* create(const RDSMonitorSettings& settings, bool force)
+        {
+            return new MsgConfigureRDSMonitor(settings, force);
+        }
+
+    private:
+        RDSMonitorSettings m_settings;
+        bool m_force;
+
+        MsgConfigureRDSMonitor(const RDSMonitorSettings& settings, bool force) :
+            Message(),
+            m_settings(settings),
+            m_force(force)
+        { }
+    };
+
+    class MsgBasebandNotification : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        static MsgBasebandNotification* create(int sampleRate, qint64 centerFrequency) {
+            return new MsgBasebandNotification(sampleRate, centerFrequency);
+        }
+
+        int getSampleRate() const { return m_sampleRate; }
+        qint64 getCenterFrequency() const { return m_centerFrequency; }
+
+    private:
+
+        MsgBasebandNotification(int sampleRate, qint64 centerFrequency) :
+            Message(),
+            m_sampleRate(sampleRate),
+            m_centerFrequency(centerFrequency)
+        { }
+
+        int m_sampleRate;
+        qint64 m_centerFrequency;
+    };
+
+    RDSMonitor(DeviceAPI *deviceAPI);
+    virtual ~RDSMonitor();
+    virtual void destroy() { delete this; }
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool po);
+    virtual void start();
+    virtual void stop();
+    virtual bool handleMessage(const Message& cmd);
+    virtual void setCompactSamples(bool compactSamples);
+
+    virtual void getIdentifier(QString& id) { id = objectName(); }
+    virtual void getTitle(QString& title) { title = m_settings.m_title; }
+    virtual qint64 getCenterFrequency() const { return 0; }
+
+    virtual QByteArray serialize() const;
+    virtual bool deserialize(const QByteArray& data);
+
+    virtual int getNbSinkStreams() const { return 1; }
+    virtual int getNbSourceStreams() const { return 0; }
+
+    virtual qint64 getStreamCenterFrequency(int streamIndex, bool sinkElseSource) const
+    {
+        (void) streamIndex;
+        (void) sinkElseSource;
+        return 0;
+    }
+
+    virtual int webapiSettingsGet(
+            SWGSDRangel::SWGChannelSettings& response,
+            QString& errorMessage);
+
+    virtual int webapiSettingsPutPatch(
+            bool force,
+            const QStringList& channelSettingsKeys,
+            SWGSDRangel::SWGChannelSettings& response,
+            QString& errorMessage);
+
+    static void webapiFormatChannelSettings(
+        SWGSDRangel::SWGChannelSettings& response,
+        const RDSMonitorSettings& settings);
+
+    static void webapiUpdateChannelSettings(
+            RDSMonitorSettings& settings,
+            const QStringList& channelSettingsKeys,
+            SWGSDRangel::SWGChannelSettings& response);
+
+    uint32_t getNumberOfDeviceStreams() const;
+    void getStatus(std::vector<RDSMonitorSink::StationStatus>& status) const; //!< Status of each station
+
+    static const QString m_channelIdURI;
+    static const QString m_channelId;
+
+private:
+    DeviceAPI *m_deviceAPI;
+    QThread *m_thread;
+    RDSMonitorBaseband *m_basebandSink;
+    RDSMonitorSettings m_settings;
+
+    QNetworkAccessManager *m_networkManager;
+    QNetworkRequest m_networkRequest;
+
+    void applySettings(const RDSMonitorSettings& settings, bool force = false);
+    void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const RDSMonitorSettings& settings, bool force);
+
+private slots:
+    void networkManagerFinished(QNetworkReply *reply);
+};
+
+#endif /* INCLUDE_RDSMONITOR_H_ */
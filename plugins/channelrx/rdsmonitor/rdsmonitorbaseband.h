@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_RDSMONITORBASEBAND_H
+#define INCLUDE_RDSMONITORBASEBAND_H
+
+#include <QObject>
+#include <QMutex>
+
+#include "dsp/samplesinkfifo.h"
+#include "util/message.h"
+#include "util/messagequeue.h"
+
+#include "rdsmonitorsink.h"
+#include "rdsmonitorsettings.h"
+
+/**
+ * There is no channelizer: each station of the sink takes its own slice of the full baseband.
+ */
+class RDSMonitorBaseband : public QObject
+{
+    Q_OBJECT
+public:
+    class MsgConfigureRDSMonitorBaseband : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        const RDSMonitorSettings& getSettings() const { return m_settings; }
+        bool getForce() const { return m_force; }
+
+        static MsgConfigureRDSMonitorBaseband* create(const RDSMonitorSettings& settings, bool force)
+        {
+            return new MsgConfigureRDSMonitorBaseband(settings, force);
+        }
+
+    private:
+        RDSMonitorSettings m_settings;
+        bool m_force;
+
+        MsgConfigureRDSMonitorBaseband(const RDSMonitorSettings& settings, bool force) :
+            Message(),
+            m_settings(settings),
+            m_force(force)
+        { }
+    };
+
+    RDSMonitorBaseband();
+    ~RDSMonitorBaseband();
+    void reset();
+    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void setCompactSamples(bool compactSamples) { m_sampleFifo.setCompact(compactSamples); }
+    MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
+    void getStatus(std::vector<RDSMonitorSink::StationStatus>& status) const { m_sink.getStatus(status); }
+
+private:
+    SampleSinkFifo m_sampleFifo;
+    RDSMonitorSink m_sink;
+    MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
+    RDSMonitorSettings m_settings;
+    QMutex m_mutex;
+
+    bool handleMessage(const Message& cmd);
+    void applySettings(const RDSMonitorSettings& settings, bool force = false);
+
+private slots:
+    void handleInputMessages();
+    void handleData(); //!< Handle data when samples have to be processed
+};
+
+#endif // INCLUDE_RDSMONITORBASEBAND_H
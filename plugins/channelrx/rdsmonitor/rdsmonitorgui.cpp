@@ -0,0 +1,380 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QLocale>
+#include <QTableWidgetItem>
+
+#include "device/deviceuiset.h"
+#include "gui/basicchannelsettingsdialog.h"
+#include "gui/devicestreamselectiondialog.h"
+#include "rds/rdsparser.h"
+#include "rds/rdsstationdb.h"
+#include "mainwindow.h"
+
+#include "rdsmonitorgui.h"
+#include "rdsmonitor.h"
+#include "ui_rdsmonitorgui.h"
+
+RDSMonitorGUI* RDSMonitorGUI::create(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *channelRx)
+{
+    RDSMonitorGUI* gui = new RDSMonitorGUI(pluginAPI, deviceUISet, channelRx);
+    return gui;
+}
+
+void RDSMonitorGUI::destroy()
+{
+    delete this;
+}
+
+void RDSMonitorGUI::setName(const QString& name)
+{
+    setObjectName(name);
+}
+
+QString RDSMonitorGUI::getName() const
+{
+    return objectName();
+}
+
+qint64 RDSMonitorGUI::getCenterFrequency() const {
+    return 0;
+}
+
+void RDSMonitorGUI::setCenterFrequency(qint64 centerFrequency)
+{
+    (void) centerFrequency;
+}
+
+void RDSMonitorGUI::resetToDefaults()
+{
+    m_settings.resetToDefaults();
+    displaySettings();
+    applySettings(true);
+}
+
+QByteArray RDSMonitorGUI::serialize() const
+{
+    return m_settings.serialize();
+}
+
+bool RDSMonitorGUI::deserialize(const QByteArray& data)
+{
+    if (m_settings.deserialize(data))
+    {
+        displaySettings();
+        applySettings(true);
+        return true;
+    }
+    else
+    {
+        resetToDefaults();
+        return false;
+    }
+}
+
+bool RDSMonitorGUI::handleMessage(const Message& message)
+{
+    if (RDSMonitor::MsgBasebandNotification::match(message))
+    {
+        RDSMonitor::MsgBasebandNotification& notif = (RDSMonitor::MsgBasebandNotification&) message;
+        m_basebandSampleRate = notif.getSampleRate();
+        m_centerFrequency = notif.getCenterFrequency();
+        displayBaseband();
+        return true;
+    }
+    else if (RDSMonitor::MsgConfigureRDSMonitor::match(message))
+    {
+        const RDSMonitor::MsgConfigureRDSMonitor& cfg = (RDSMonitor::MsgConfigureRDSMonitor&) message;
+        m_settings = cfg.getSettings();
+        blockApplySettings(true);
+        displaySettings();
+        blockApplySettings(false);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+RDSMonitorGUI::RDSMonitorGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *channelrx, QWidget* parent) :
+        RollupWidget(parent),
+        ui(new Ui::RDSMonitorGUI),
+        m_pluginAPI(pluginAPI),
+        m_deviceUISet(deviceUISet),
+        m_basebandSampleRate(0),
+        m_centerFrequency(0),
+        m_tickCount(0)
+{
+    ui->setupUi(this);
+    setAttribute(Qt::WA_DeleteOnClose, true);
+    connect(this, SIGNAL(widgetRolled(QWidget*,bool)), this, SLOT(onWidgetRolled(QWidget*,bool)));
+    connect(this, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(onMenuDialogCalled(const QPoint &)));
+
+    m_rdsMonitor = (RDSMonitor*) channelrx;
+    m_rdsMonitor->setMessageQueueToGUI(getInputMessageQueue());
+
+    m_channelMarker.blockSignals(true);
+    m_channelMarker.setColor(m_settings.m_rgbColor);
+    m_channelMarker.setCenterFrequency(0);
+    m_channelMarker.setTitle("RDS Monitor");
+    m_channelMarker.blockSignals(false);
+    m_channelMarker.setVisible(false); // the channel covers the whole baseband
+
+    m_settings.setChannelMarker(&m_channelMarker);
+
+    m_deviceUISet->registerRxChannelInstance(RDSMonitor::m_channelIdURI, this);
+    m_deviceUISet->addChannelMarker(&m_channelMarker);
+    m_deviceUISet->addRollupWidget(this);
+
+    ui->stations->resizeColumnsToContents();
+
+    connect(getInputMessageQueue(), SIGNAL(messageEnqueued()), this, SLOT(handleSourceMessages()));
+    connect(&MainWindow::getInstance()->getMasterTimer(), SIGNAL(timeout()), this, SLOT(tick()));
+
+    displaySettings();
+    applySettings(true);
+}
+
+RDSMonitorGUI::~RDSMonitorGUI()
+{
+    m_deviceUISet->removeRxChannelInstance(this);
+    delete m_rdsMonitor; // TODO: check this: when the GUI closes it has to delete the demodulator
+    delete ui;
+}
+
+void RDSMonitorGUI::blockApplySettings(bool block)
+{
+    m_doApplySettings = !block;
+}
+
+void RDSMonitorGUI::applySettings(bool force)
+{
+    if (m_doApplySettings)
+    {
+        setTitleColor(m_channelMarker.getColor());
+
+        RDSMonitor::MsgConfigureRDSMonitor* message = RDSMonitor::MsgConfigureRDSMonitor::create(m_settings, force);
+        m_rdsMonitor->getInputMessageQueue()->push(message);
+    }
+}
+
+void RDSMonitorGUI::displaySettings()
+{
+    m_channelMarker.blockSignals(true);
+    m_channelMarker.setCenterFrequency(0);
+    m_channelMarker.setTitle(m_settings.m_title);
+    m_channelMarker.setMovable(false);
+    m_channelMarker.blockSignals(false);
+    m_channelMarker.setColor(m_settings.m_rgbColor); // activate signal on the last setting only
+
+    setTitleColor(m_settings.m_rgbColor);
+    setWindowTitle(m_channelMarker.getTitle());
+
+    blockApplySettings(true);
+    ui->frequencies->setText(RDSMonitorSettings::frequenciesToString(m_settings.m_frequencies));
+    ui->nbThreads->setValue(m_settings.m_nbThreads);
+    displayStreamIndex();
+    displayStations();
+    blockApplySettings(false);
+}
+
+void RDSMonitorGUI::displayStreamIndex()
+{
+    if (m_deviceUISet->m_deviceMIMOEngine) {
+        setStreamIndicator(tr("%1").arg(m_settings.m_streamIndex));
+    } else {
+        setStreamIndicator("S"); // single channel indicator
+    }
+}
+
+void RDSMonitorGUI::displayBaseband()
+{
+    ui->basebandText->setText(tr("%1 - %2 MHz")
+        .arg(QString::number((m_centerFrequency - m_basebandSampleRate / 2) / 1e6, 'f', 3))
+        .arg(QString::number((m_centerFrequency + m_basebandSampleRate / 2) / 1e6, 'f', 3)));
+}
+
+void RDSMonitorGUI::displayStations()
+{
+    std::vector<RDSMonitorSink::StationStatus> status;
+    m_rdsMonitor->getStatus(status);
+    ui->stations->setRowCount(m_settings.m_frequencies.size());
+    QLocale loc;
+
+    for (int row = 0; row < m_settings.m_frequencies.size(); row++)
+    {
+        qint64 frequency = m_settings.m_frequencies[row];
+        const RDSMonitorSink::StationStatus *stationStatus = nullptr;
+
+        for (const auto& s : status)
+        {
+            if (s.m_frequency == frequency)
+            {
+                stationStatus = &s;
+                break;
+            }
+        }
+
+        RDSStationDB::Station station;
+        bool known = RDSStationDB::instance()->getStationAt(frequency, station);
+        QString texts[8];
+        texts[STATION_COL_FREQUENCY] = QString::number(frequency / 1e6, 'f', 3);
+
+        if (stationStatus && stationStatus->m_inBand)
+        {
+            texts[STATION_COL_PILOT] = stationStatus->m_pilotLock ? "P" : "-";
+            texts[STATION_COL_SYNC] = stationStatus->m_synced ? "S" : "-";
+            texts[STATION_COL_GROUPS] = loc.toString(stationStatus->m_groups);
+        }
+        else
+        {
+            texts[STATION_COL_PILOT] = "x"; // out of baseband
+            texts[STATION_COL_SYNC] = "x";
+        }
+
+        if (known)
+        {
+            texts[STATION_COL_PI] = QString("%1").arg(station.m_pi, 4, 16, QChar('0')).toUpper();
+            texts[STATION_COL_PS] = station.m_programServiceName;
+            texts[STATION_COL_PTY] = QString(RDSParser::pty_table[station.m_programType & 0x1f].c_str());
+            texts[STATION_COL_RT] = station.m_radioText;
+        }
+
+        for (int col = 0; col < 8; col++)
+        {
+            QTableWidgetItem *item = ui->stations->item(row, col);
+
+            if (!item)
+            {
+                item = new QTableWidgetItem();
+                ui->stations->setItem(row, col, item);
+            }
+
+            if (item->text() != texts[col]) {
+                item->setText(texts[col]);
+            }
+        }
+    }
+
+    ui->databaseText->setText(tr("%1 / %2")
+        .arg(RDSStationDB::instance()->getNbStations())
+        .arg(RDSStationDB::instance()->getSerial()));
+}
+
+void RDSMonitorGUI::leaveEvent(QEvent*)
+{
+    m_channelMarker.setHighlighted(false);
+}
+
+void RDSMonitorGUI::enterEvent(QEvent*)
+{
+    m_channelMarker.setHighlighted(true);
+}
+
+void RDSMonitorGUI::handleSourceMessages()
+{
+    Message* message;
+
+    while ((message = getInputMessageQueue()->pop()) != 0)
+    {
+        if (handleMessage(*message))
+        {
+            delete message;
+        }
+    }
+}
+
+void RDSMonitorGUI::onWidgetRolled(QWidget* widget, bool rollDown)
+{
+    (void) widget;
+    (void) rollDown;
+}
+
+void RDSMonitorGUI::onMenuDialogCalled(const QPoint &p)
+{
+    if (m_contextMenuType == ContextMenuChannelSettings)
+    {
+        BasicChannelSettingsDialog dialog(&m_channelMarker, this);
+        dialog.setUseReverseAPI(m_settings.m_useReverseAPI);
+        dialog.setReverseAPIAddress(m_settings.m_reverseAPIAddress);
+        dialog.setReverseAPIPort(m_settings.m_reverseAPIPort);
+        dialog.setReverseAPIDeviceIndex(m_settings.m_reverseAPIDeviceIndex);
+        dialog.setReverseAPIChannelIndex(m_settings.m_reverseAPIChannelIndex);
+
+        dialog.move(p);
+        dialog.exec();
+
+        m_settings.m_rgbColor = m_channelMarker.getColor().rgb();
+        m_settings.m_title = m_channelMarker.getTitle();
+        m_settings.m_useReverseAPI = dialog.useReverseAPI();
+        m_settings.m_reverseAPIAddress = dialog.getReverseAPIAddress();
+        m_settings.m_reverseAPIPort = dialog.getReverseAPIPort();
+        m_settings.m_reverseAPIDeviceIndex = dialog.getReverseAPIDeviceIndex();
+        m_settings.m_reverseAPIChannelIndex = dialog.getReverseAPIChannelIndex();
+
+        setWindowTitle(m_settings.m_title);
+        setTitleColor(m_settings.m_rgbColor);
+
+        applySettings();
+    }
+    else if ((m_contextMenuType == ContextMenuStreamSettings) && (m_deviceUISet->m_deviceMIMOEngine))
+    {
+        DeviceStreamSelectionDialog dialog(this);
+        dialog.setNumberOfStreams(m_rdsMonitor->getNumberOfDeviceStreams());
+        dialog.setStreamIndex(m_settings.m_streamIndex);
+        dialog.move(p);
+        dialog.exec();
+
+        m_settings.m_streamIndex = dialog.getSelectedStreamIndex();
+        m_channelMarker.clearStreamIndexes();
+        m_channelMarker.addStreamIndex(m_settings.m_streamIndex);
+        displayStreamIndex();
+        applySettings();
+    }
+
+    resetContextMenuType();
+}
+
+void RDSMonitorGUI::on_frequencies_editingFinished()
+{
+    m_settings.m_frequencies = RDSMonitorSettings::frequenciesFromString(ui->frequencies->text());
+    ui->frequencies->setText(RDSMonitorSettings::frequenciesToString(m_settings.m_frequencies));
+    displayStations();
+    applySettings();
+}
+
+void RDSMonitorGUI::on_nbThreads_valueChanged(int value)
+{
+    m_settings.m_nbThreads = value;
+    applySettings();
+}
+
+void RDSMonitorGUI::on_clearDB_clicked()
+{
+    RDSStationDB::instance()->clear();
+    displayStations();
+}
+
+void RDSMonitorGUI::tick()
+{
+    if (++m_tickCount == 20) // once per second
+    {
+        displayStations();
+        m_tickCount = 0;
+    }
+}
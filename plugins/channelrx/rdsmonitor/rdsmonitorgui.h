@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_CHANNELRX_RDSMONITOR_RDSMONITORGUI_H_
+#define PLUGINS_CHANNELRX_RDSMONITOR_RDSMONITORGUI_H_
+
+#include <stdint.h>
+
+#include <QObject>
+
+#include "plugin/plugininstancegui.h"
+#include "dsp/channelmarker.h"
+#include "gui/rollupwidget.h"
+#include "util/messagequeue.h"
+
+#include "rdsmonitorsettings.h"
+
+class PluginAPI;
+class DeviceUISet;
+class RDSMonitor;
+class BasebandSampleSink;
+
+namespace Ui {
+    class RDSMonitorGUI;
+}
+
+class RDSMonitorGUI : public RollupWidget, public PluginInstanceGUI {
+    Q_OBJECT
+public:
+    static RDSMonitorGUI* create(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel);
+    virtual void destroy();
+
+    void setName(const QString& name);
+    QString getName() const;
+    virtual qint64 getCenterFrequency() const;
+    virtual void setCenterFrequency(qint64 centerFrequency);
+
+    void resetToDefaults();
+    QByteArray serialize() const;
+    bool deserialize(const QByteArray& data);
+    virtual MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
+    virtual bool handleMessage(const Message& message);
+
+private:
+    enum StationCol {
+        STATION_COL_FREQUENCY,
+        STATION_COL_PILOT,
+        STATION_COL_SYNC,
+        STATION_COL_GROUPS,
+        STATION_COL_PI,
+        STATION_COL_PS,
+        STATION_COL_PTY,
+        STATION_COL_RT
+    };
+
+    Ui::RDSMonitorGUI* ui;
+    PluginAPI* m_pluginAPI;
+    DeviceUISet* m_deviceUISet;
+    ChannelMarker m_channelMarker;
+    RDSMonitorSettings m_settings;
+    int m_basebandSampleRate;
+    qint64 m_centerFrequency;
+    bool m_doApplySettings;
+
+    RDSMonitor* m_rdsMonitor;
+    MessageQueue m_inputMessageQueue;
+
+    uint32_t m_tickCount;
+
+    explicit RDSMonitorGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel, QWidget* parent = 0);
+    virtual ~RDSMonitorGUI();
+
+    void blockApplySettings(bool block);
+    void applySettings(bool force = false);
+    void displaySettings();
+    void displayStreamIndex();
+    void displayBaseband();
+    void displayStations();
+
+    void leaveEvent(QEvent*);
+    void enterEvent(QEvent*);
+
+private slots:
+    void handleSourceMessages();
+    void on_frequencies_editingFinished();
+    void on_nbThreads_valueChanged(int value);
+    void on_clearDB_clicked();
+    void onWidgetRolled(QWidget* widget, bool rollDown);
+    void onMenuDialogCalled(const QPoint& p);
+    void tick();
+};
+
+#endif /* PLUGINS_CHANNELRX_RDSMONITOR_RDSMONITORGUI_H_ */
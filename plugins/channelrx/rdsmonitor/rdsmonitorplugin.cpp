@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "rdsmonitorplugin.h"
+
+#include <QtPlugin>
+#include "plugin/pluginapi.h"
+
+#ifndef SERVER_MODE
+#include "rdsmonitorgui.h"
+#endif
+#include "rdsmonitor.h"
+#include "rdsmonitorwebapiadapter.h"
+#include "rdsmonitorplugin.h"
+
+const PluginDescriptor RDSMonitorPlugin::m_pluginDescriptor = {
+    RDSMonitor::m_channelId,
+    QString("RDS monitor"),
+    QString("4.15.0"),
+    QString("(c) Edouard Griffiths, F4EXB"),
+    QString("https://github.com/f4exb/sdrangel"),
+    true,
+    QString("https://github.com/f4exb/sdrangel")
+};
+
+RDSMonitorPlugin::RDSMonitorPlugin(QObject* parent) :
+    QObject(parent),
+    m_pluginAPI(0)
+{
+}
+
+const PluginDescriptor& RDSMonitorPlugin::getPluginDescriptor() const
+{
+    return m_pluginDescriptor;
+}
+
+void RDSMonitorPlugin::initPlugin(PluginAPI* pluginAPI)
+{
+    m_pluginAPI = pluginAPI;
+
+    // register channel Source
+    m_pluginAPI->registerRxChannel(RDSMonitor::m_channelIdURI, RDSMonitor::m_channelId, this);
+}
+
+#ifdef SERVER_MODE
+PluginInstanceGUI* RDSMonitorPlugin::createRxChannelGUI(
+        DeviceUISet *deviceUISet,
+        BasebandSampleSink *rxChannel) const
+{
+    return 0;
+}
+#else
+PluginInstanceGUI* RDSMonitorPlugin::createRxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel) const
+{
+    return RDSMonitorGUI::create(m_pluginAPI, deviceUISet, rxChannel);
+}
+#endif
+
+BasebandSampleSink* RDSMonitorPlugin::createRxChannelBS(DeviceAPI *deviceAPI) const
+{
+    return new RDSMonitor(deviceAPI);
+}
+
+ChannelAPI* RDSMonitorPlugin::createRxChannelCS(DeviceAPI *deviceAPI) const
+{
+    return new RDSMonitor(deviceAPI);
+}
+
+ChannelWebAPIAdapter* RDSMonitorPlugin::createChannelWebAPIAdapter() const
+{
+	return new RDSMonitorWebAPIAdapter();
+}
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "rdsmonitorsettings.h"
+
+#include <QColor>
+#include <QStringList>
+#include <QRegExp>
+
+#include "util/simpleserializer.h"
+#include "settings/serializable.h"
+
+const int RDSMonitorSettings::m_maxThreads = 16;
+
+RDSMonitorSettings::RDSMonitorSettings()
+{
+    resetToDefaults();
+}
+
+void RDSMonitorSettings::resetToDefaults()
+{
+    m_frequencies.clear();
+    m_nbThreads = 1;
+    m_rgbColor = QColor(200, 120, 40).rgb();
+    m_title = "RDS Monitor";
+    m_channelMarker = nullptr;
+    m_streamIndex = 0;
+    m_useReverseAPI = false;
+    m_reverseAPIAddress = "127.0.0.1";
+    m_reverseAPIPort = 8888;
+    m_reverseAPIDeviceIndex = 0;
+    m_reverseAPIChannelIndex = 0;
+}
+
+QByteArray RDSMonitorSettings::serialize() const
+{
+    SimpleSerializer s(1);
+    s.writeString(1, frequenciesToString(m_frequencies));
+    s.writeS32(2, m_nbThreads);
+    s.writeU32(5, m_rgbColor);
+    s.writeString(6, m_title);
+    s.writeBool(7, m_useReverseAPI);
+    s.writeString(8, m_reverseAPIAddress);
+    s.writeU32(9, m_reverseAPIPort);
+    s.writeU32(10, m_reverseAPIDeviceIndex);
+    s.writeU32(11, m_reverseAPIChannelIndex);
+    s.writeS32(14, m_streamIndex);
+
+    return s.final();
+}
+
+bool RDSMonitorSettings::deserialize(const QByteArray& data)
+{
+    SimpleDeserializer d(data);
+
+    if(!d.isValid())
+    {
+        resetToDefaults();
+        return false;
+    }
+
+    if(d.getVersion() == 1)
+    {
+        uint32_t tmp;
+        QString strtmp;
+
+        d.readString(1, &strtmp, "");
+        m_frequencies = frequenciesFromString(strtmp);
+        d.readS32(2, &m_nbThreads, 1);
+        m_nbThreads = m_nbThreads < 1 ? 1 : m_nbThreads > m_maxThreads ? m_maxThreads : m_nbThreads;
+        d.readU32(5, &m_rgbColor, QColor(200, 120, 40).rgb());
+        d.readString(6, &m_title, "RDS Monitor");
+        d.readBool(7, &m_useReverseAPI, false);
+        d.readString(8, &m_reverseAPIAddress, "127.0.0.1");
+        d.readU32(9, &tmp, 0);
+
+        if ((tmp > 1023) && (tmp < 65535)) {
+            m_reverseAPIPort = tmp;
+        } else {
+            m_reverseAPIPort = 8888;
+        }
+
+        d.readU32(10, &tmp, 0);
+        m_reverseAPIDeviceIndex = tmp > 99 ? 99 : tmp;
+        d.readU32(11, &tmp, 0);
+        m_reverseAPIChannelIndex = tmp > 99 ? 99 : tmp;
+        d.readS32(14, &m_streamIndex, 0);
+
+        return true;
+    }
+    else
+    {
+        resetToDefaults();
+        return false;
+    }
+}
+
+QString RDSMonitorSettings::frequenciesToString(const QList<qint64>& frequencies)
+{
+    QStringList list;
+
+    for (const auto& frequency : frequencies) {
+        list.append(QString::number(frequency / 1e6, 'f', 3));
+    }
+
+    return list.join(",");
+}
+
+QList<qint64> RDSMonitorSettings::frequenciesFromString(const QString& string)
+{
+    QList<qint64> frequencies;
+    QStringList list = string.split(QRegExp("[,; ]"), QString::SkipEmptyParts);
+
+    for (const auto& item : list)
+    {
+        bool ok;
+        double mhz = item.toDouble(&ok);
+
+        if (!ok || (mhz <= 0.0)) {
+            continue;
+        }
+
+        qint64 frequency = (qint64) (mhz * 1e6 + 0.5);
+
+        if (!frequencies.contains(frequency)) {
+            frequencies.append(frequency);
+        }
+    }
+
+    return frequencies;
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_RDSMONITORSETTINGS_H_
+#define INCLUDE_RDSMONITORSETTINGS_H_
+
+#include <QByteArray>
+#include <QString>
+#include <QList>
+
+class Serializable;
+
+struct RDSMonitorSettings
+{
+    QList<qint64> m_frequencies; //!< Absolute frequencies (Hz) of the stations to monitor
+    int m_nbThreads;             //!< Number of threads sharing the stations
+    quint32 m_rgbColor;
+    QString m_title;
+    int m_streamIndex; //!< MIMO channel. Not relevant when connected to SI (single Rx).
+    bool m_useReverseAPI;
+    QString m_reverseAPIAddress;
+    uint16_t m_reverseAPIPort;
+    uint16_t m_reverseAPIDeviceIndex;
+    uint16_t m_reverseAPIChannelIndex;
+
+    Serializable *m_channelMarker;
+
+    RDSMonitorSettings();
+    void resetToDefaults();
+    void setChannelMarker(Serializable *channelMarker) { m_channelMarker = channelMarker; }
+    QByteArray serialize() const;
+    bool deserialize(const QByteArray& data);
+
+    static QString frequenciesToString(const QList<qint64>& frequencies); //!< Comma separated list in MHz
+    static QList<qint64> frequenciesFromString(const QString& string);
+
+    static const int m_maxThreads;
+};
+
+#endif /* INCLUDE_RDSMONITORSETTINGS_H_ */
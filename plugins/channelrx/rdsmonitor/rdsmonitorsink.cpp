@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <QDebug>
+
+#include "rds/rdsstationdb.h"
+
+#include "rdsmonitorsink.h"
+
+const int RDSMonitorSink::m_mpxSampleRate = 228000;
+const int RDSMonitorSink::m_minSampleRate = 150000;
+const int RDSMonitorSink::m_halfBandwidth = 100000;
+const int RDSMonitorSink::m_fmExcursion = 750000; // same scaling as the BFM demodulator
+
+RDSMonitorSink::RDSMonitorSink() :
+    m_sampleRate(48000),
+    m_centerFrequency(0)
+{
+}
+
+RDSMonitorSink::~RDSMonitorSink()
+{
+    m_workers.stop();
+    deleteStations();
+}
+
+void RDSMonitorSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    if (m_stations.size() == 0) {
+        return;
+    }
+
+    m_i.resize(end - begin);
+    m_q.resize(end - begin);
+    int k = 0;
+
+    for (SampleVector::const_iterator it = begin; it != end; ++it, k++)
+    {
+        m_i[k] = it->real() / SDR_RX_SCALEF;
+        m_q[k] = it->imag() / SDR_RX_SCALEF;
+    }
+
+    unsigned int nbThreads = m_workers.getNbStreams();
+    unsigned int nbStations = m_stations.size();
+
+    m_workers.run(nbThreads, [this, nbThreads, nbStations](unsigned int threadIndex) {
+        for (unsigned int i = threadIndex; i < nbStations; i += nbThreads) {
+            processStation(m_stations[i]);
+        }
+    });
+
+    updateStatus();
+}
+
+void RDSMonitorSink::processStation(Station *station)
+{
+    if (!station->m_inBand) {
+        return;
+    }
+
+    int n = m_i.size();
+    station->m_iIn.resize(n);
+    station->m_qIn.resize(n);
+
+    for (int k = 0; k < n; k++)
+    {
+        Complex nco = station->m_nco.nextIQ();
+        station->m_iIn[k] = m_i[k] * nco.real() - m_q[k] * nco.imag();
+        station->m_qIn[k] = m_i[k] * nco.imag() + m_q[k] * nco.real();
+    }
+
+    const Real *iIn = station->m_iIn.data();
+    const Real *qIn = station->m_qIn.data();
+
+    for (auto& decimator : station->m_decimators)
+    {
+        station->m_iOut.clear();
+        station->m_qOut.clear();
+        decimator.feed(iIn, qIn, n, station->m_iOut, station->m_qOut);
+        station->m_iStage.swap(station->m_iOut); // output of this stage is the input of the next one
+        station->m_qStage.swap(station->m_qOut);
+        iIn = station->m_iStage.data();
+        qIn = station->m_qStage.data();
+        n = station->m_iStage.size();
+    }
+
+    station->m_iOut.swap(station->m_iStage);
+    station->m_qOut.swap(station->m_qStage);
+
+    station->m_mpx.resize(station->m_iOut.size());
+
+    for (unsigned int k = 0; k < station->m_iOut.size(); k++) {
+        station->m_mpx[k] = station->m_phaseDiscri.phaseDiscriminator(Complex(station->m_iOut[k], station->m_qOut[k]));
+    }
+
+    station->m_composite.feed(station->m_mpx);
+    const std::vector<Real>& rds = station->m_composite.getRDS();
+
+    for (std::vector<Real>::const_iterator it = rds.begin(); it != rds.end(); ++it)
+    {
+        bool bit;
+
+        if (station->m_rdsDemod.process(*it, bit))
+        {
+            if (station->m_rdsDecoder.frameSync(bit))
+            {
+                station->m_rdsParser.parseGroup(station->m_rdsDecoder.getGroup());
+                RDSStationDB::instance()->update(station->m_frequency, station->m_rdsParser);
+                station->m_rdsParser.clearUpdateFlags();
+                station->m_groups++;
+            }
+        }
+    }
+}
+
+void RDSMonitorSink::updateStatus()
+{
+    QMutexLocker mutexLocker(&m_statusMutex);
+    m_status.resize(m_stations.size());
+
+    for (unsigned int i = 0; i < m_stations.size(); i++)
+    {
+        const Station *station = m_stations[i];
+        StationStatus& status = m_status[i];
+        status.m_frequency = station->m_frequency;
+        status.m_inBand = station->m_inBand;
+        status.m_pilotLock = station->m_composite.getPilotLock();
+        status.m_synced = station->m_rdsDecoder.synced();
+        status.m_pi = station->m_rdsParser.m_pi_program_identification;
+        status.m_groups = station->m_groups;
+    }
+}
+
+void RDSMonitorSink::getStatus(std::vector<StationStatus>& status) const
+{
+    QMutexLocker mutexLocker(&m_statusMutex);
+    status = m_status;
+}
+
+void RDSMonitorSink::applyBaseband(int sampleRate, qint64 centerFrequency)
+{
+    qDebug() << "RDSMonitorSink::applyBaseband:"
+        << " sampleRate: " << sampleRate
+        << " centerFrequency: " << centerFrequency;
+
+    m_sampleRate = sampleRate;
+    m_centerFrequency = centerFrequency;
+
+    for (auto station : m_stations) {
+        configureStation(station);
+    }
+
+    updateStatus();
+}
+
+void RDSMonitorSink::applySettings(const RDSMonitorSettings& settings, bool force)
+{
+    qDebug() << "RDSMonitorSink::applySettings:"
+        << " m_frequencies: " << RDSMonitorSettings::frequenciesToString(settings.m_frequencies)
+        << " m_nbThreads: " << settings.m_nbThreads
+        << " force: " << force;
+
+    bool stationsChange = (settings.m_frequencies != m_settings.m_frequencies) || force;
+    bool threadsChange = (settings.m_nbThreads != m_settings.m_nbThreads) || stationsChange;
+    m_settings = settings;
+
+    if (stationsChange)
+    {
+        m_workers.stop(); // stations are about to be deleted
+        createStations();
+        updateStatus();
+    }
+
+    if (threadsChange)
+    {
+        int nbThreads = std::min(m_settings.m_nbThreads, (int) m_stations.size());
+        m_workers.start(nbThreads < 1 ? 1 : nbThreads);
+    }
+}
+
+void RDSMonitorSink::createStations()
+{
+    deleteStations();
+
+    for (const auto& frequency : m_settings.m_frequencies)
+    {
+        Station *station = new Station();
+        station->m_frequency = frequency;
+        station->m_groups = 0;
+        station->m_composite.setStereo(false, false);
+        station->m_composite.setRDS(true);
+        station->m_composite.setAudio(false);
+        station->m_composite.setShowPilot(false);
+        configureStation(station);
+        m_stations.push_back(station);
+    }
+}
+
+void RDSMonitorSink::deleteStations()
+{
+    for (auto station : m_stations) {
+        delete station;
+    }
+
+    m_stations.clear();
+}
+
+void RDSMonitorSink::configureStation(Station *station)
+{
+    qint64 offset = station->m_frequency - m_centerFrequency;
+    station->m_inBand = (m_sampleRate >= m_minSampleRate) && (std::abs(offset) + m_halfBandwidth <= m_sampleRate / 2);
+
+    if (!station->m_inBand) {
+        return;
+    }
+
+    int decimation = getDecimation(m_sampleRate);
+    int mpxRate = m_sampleRate / decimation;
+    station->m_nco.setFreq(-offset, m_sampleRate);
+    station->m_decimators.clear();
+
+    if (decimation == 1) // no folding: only limit to the station band
+    {
+        station->m_decimators.push_back(BFMComposite::Decimator());
+        station->m_decimators.back().create(1, m_sampleRate, m_halfBandwidth,
+            std::max((double) mpxRate - m_halfBandwidth, m_halfBandwidth + 0.05 * m_sampleRate));
+    }
+    else
+    {
+        double rate = m_sampleRate;
+        int remaining = decimation;
+
+        // Each stage rejects what would fold into the station band at its output rate
+        while (remaining % 2 == 0)
+        {
+            station->m_decimators.push_back(BFMComposite::Decimator());
+            station->m_decimators.back().create(2, rate, m_halfBandwidth, rate / 2 - m_halfBandwidth);
+            rate /= 2;
+            remaining /= 2;
+        }
+
+        if (remaining > 1)
+        {
+            station->m_decimators.push_back(BFMComposite::Decimator());
+            station->m_decimators.back().create(remaining, rate, m_halfBandwidth, rate / remaining - m_halfBandwidth);
+        }
+    }
+
+    station->m_phaseDiscri.setFMScaling(mpxRate / (Real) m_fmExcursion);
+    station->m_composite.configure(mpxRate, 48000, 15000);
+    station->m_rdsDemod.setSampleRate(station->m_composite.getRDSRate());
+    station->m_rdsParser.clearAllFields();
+}
+
+int RDSMonitorSink::getDecimation(int sampleRate)
+{
+    // Largest 2^k or 3*2^k decimation keeping the MPX rate above the minimum
+    int ratio = sampleRate / m_mpxSampleRate;
+    int decimation = 1;
+
+    while (2*decimation <= ratio) {
+        decimation *= 2;
+    }
+
+    if ((decimation > 1) && ((3*decimation)/2 <= ratio)) {
+        decimation = (3*decimation)/2;
+    }
+
+    return decimation;
+}
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_RDSMONITORSINK_H_
+#define INCLUDE_RDSMONITORSINK_H_
+
+#include <vector>
+
+#include <QMutex>
+
+#include "dsp/channelsamplesink.h"
+#include "dsp/nco.h"
+#include "dsp/phasediscri.h"
+#include "dsp/bfmcomposite.h"
+#include "dsp/streamworkers.h"
+#include "rds/rdsdemod.h"
+#include "rds/rdsdecoder.h"
+#include "rds/rdsparser.h"
+
+#include "rdsmonitorsettings.h"
+
+/**
+ * Decodes RDS of several FM stations taken directly from the baseband. There is no audio.
+ * Each station has its own chain: shift, decimation to MPX rate, FM discriminator, composite
+ * decoder with only the RDS output enabled, RDS demodulator, decoder and parser. The decoded
+ * groups are merged in the shared RDS station database.
+ * Decimation is done by stages of 2 followed by a last stage of 3 if needed so that the filters
+ * stay short at any baseband rate while rejecting what would fold into the station band.
+ * The stations are shared among a number of threads, station i going to thread i modulo the
+ * number of threads so that a station chain always runs on the same thread.
+ */
+class RDSMonitorSink : public ChannelSampleSink {
+public:
+    struct StationStatus
+    {
+        qint64 m_frequency;
+        bool m_inBand;    //!< Station frequency is within the baseband
+        bool m_pilotLock; //!< 19 kHz pilot locked
+        bool m_synced;    //!< RDS decoder is in sync
+        unsigned int m_pi;
+        quint64 m_groups; //!< Groups decoded
+    };
+
+    RDSMonitorSink();
+    ~RDSMonitorSink();
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+
+    void applyBaseband(int sampleRate, qint64 centerFrequency);
+    void applySettings(const RDSMonitorSettings& settings, bool force = false);
+    void getStatus(std::vector<StationStatus>& status) const;
+
+private:
+    struct Station
+    {
+        qint64 m_frequency;
+        bool m_inBand;
+        NCO m_nco;
+        std::vector<BFMComposite::Decimator> m_decimators;
+        PhaseDiscriminators m_phaseDiscri;
+        BFMComposite m_composite;
+        RDSDemod m_rdsDemod;
+        RDSDecoder m_rdsDecoder;
+        RDSParser m_rdsParser;
+        quint64 m_groups;
+        std::vector<Real> m_iIn;
+        std::vector<Real> m_qIn;
+        std::vector<Real> m_iOut;
+        std::vector<Real> m_qOut;
+        std::vector<Real> m_iStage; //!< Intermediate decimation stage output
+        std::vector<Real> m_qStage;
+        std::vector<Real> m_mpx;
+    };
+
+    int m_sampleRate;
+    qint64 m_centerFrequency;
+    RDSMonitorSettings m_settings;
+    std::vector<Station*> m_stations;
+    std::vector<Real> m_i; //!< Block of baseband samples scaled to +/-1 shared by all stations
+    std::vector<Real> m_q;
+    StreamWorkers m_workers;
+    std::vector<StationStatus> m_status;
+    mutable QMutex m_statusMutex;
+
+    void createStations();
+    void deleteStations();
+    void configureStation(Station *station);
+    void processStation(Station *station);
+    void updateStatus();
+    static int getDecimation(int sampleRate);
+
+    static const int m_mpxSampleRate;  //!< Minimum MPX sample rate
+    static const int m_minSampleRate;  //!< Minimum baseband sample rate to decode RDS
+    static const int m_halfBandwidth;  //!< Half the RF bandwidth of a station
+    static const int m_fmExcursion;
+};
+
+#endif // INCLUDE_RDSMONITORSINK_H_
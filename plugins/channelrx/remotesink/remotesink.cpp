@@ -107,6 +107,11 @@ void RemoteSink::stop()
 	m_thread->wait();
 }
 
+void RemoteSink::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool RemoteSink::handleMessage(const Message& cmd)
 {
     if (MsgConfigureRemoteSink::match(cmd))
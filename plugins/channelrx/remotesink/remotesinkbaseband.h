@@ -62,6 +62,7 @@ public:
 
     void reset();
 	void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+	void setCompactSamples(bool compactSamples) { m_sampleFifo.setCompact(compactSamples); }
     void startSender() { m_sink.startSender(); }
     void stopSender() { m_sink.stopSender(); }
 
@@ -0,0 +1,446 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QThread>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QBuffer>
+
+#include "SWGChannelSettings.h"
+
+#include "util/simpleserializer.h"
+#include "dsp/dspcommands.h"
+#include "dsp/hbfilterchainconverter.h"
+#include "device/deviceapi.h"
+
+#include "shmsinkbaseband.h"
+#include "shmsink.h"
+
+MESSAGE_CLASS_DEFINITION(ShmSink::MsgConfigureShmSink, Message)
+MESSAGE_CLASS_DEFINITION(ShmSink::MsgBasebandSampleRateNotification, Message)
+
+const QString ShmSink::m_channelIdURI = "sdrangel.channel.shmsink";
+const QString ShmSink::m_channelId = "ShmSink";
+
+ShmSink::ShmSink(DeviceAPI *deviceAPI) :
+        ChannelAPI(m_channelIdURI, ChannelAPI::StreamSingleSink),
+        m_deviceAPI(deviceAPI),
+        m_centerFrequency(0),
+        m_frequencyOffset(0),
+        m_basebandSampleRate(48000)
+{
+    setObjectName(m_channelId);
+
+    m_thread = new QThread(this);
+    m_basebandSink = new ShmSinkBaseband();
+    m_basebandSink->moveToThread(m_thread);
+
+    applySettings(m_settings, true);
+
+    m_deviceAPI->addChannelSink(this);
+    m_deviceAPI->addChannelSinkAPI(this);
+
+    m_networkManager = new QNetworkAccessManager();
+    connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
+}
+
+ShmSink::~ShmSink()
+{
+    disconnect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
+    delete m_networkManager;
+    m_deviceAPI->removeChannelSinkAPI(this);
+    m_deviceAPI->removeChannelSink(this);
+    delete m_basebandSink;
+    delete m_thread;
+}
+
+uint32_t ShmSink::getNumberOfDeviceStreams() const
+{
+    return m_deviceAPI->getNbSourceStreams();
+}
+
+void ShmSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
+{
+    (void) firstOfBurst;
+    m_basebandSink->feed(begin, end);
+}
+
+void ShmSink::start()
+{
+	qDebug("ShmSink::start");
+    m_basebandSink->reset();
+    m_thread->start();
+}
+
+void ShmSink::stop()
+{
+    qDebug("ShmSink::stop");
+	m_thread->exit();
+	m_thread->wait();
+}
+
+void ShmSink::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
+bool ShmSink::handleMessage(const Message& cmd)
+{
+    if (DSPSignalNotification::match(cmd))
+    {
+        DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
+
+        qDebug() << "ShmSink::handleMessage: DSPSignalNotification:"
+                << " inputSampleRate: " << notif.getSampleRate()
+                << " centerFrequency: " << notif.getCenterFrequency();
+
+        m_basebandSampleRate = notif.getSampleRate();
+        m_centerFrequency = notif.getCenterFrequency();
+
+        calculateFrequencyOffset(m_settings.m_log2Decim, m_settings.m_filterChainHash); // This is when device sample rate changes
+
+        DSPSignalNotification *msg = new DSPSignalNotification(notif.getSampleRate(), notif.getCenterFrequency());
+        m_basebandSink->getInputMessageQueue()->push(msg);
+
+        if (getMessageQueueToGUI())
+        {
+            MsgBasebandSampleRateNotification *msg = MsgBasebandSampleRateNotification::create(notif.getSampleRate());
+            getMessageQueueToGUI()->push(msg);
+        }
+
+        return true;
+    }
+    else if (MsgConfigureShmSink::match(cmd))
+    {
+        MsgConfigureShmSink& cfg = (MsgConfigureShmSink&) cmd;
+        qDebug() << "ShmSink::handleMessage: MsgConfigureShmSink";
+        applySettings(cfg.getSettings(), cfg.getForce());
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+QByteArray ShmSink::serialize() const
+{
+    return m_settings.serialize();
+}
+
+bool ShmSink::deserialize(const QByteArray& data)
+{
+    (void) data;
+    if (m_settings.deserialize(data))
+    {
+        MsgConfigureShmSink *msg = MsgConfigureShmSink::create(m_settings, true);
+        m_inputMessageQueue.push(msg);
+        return true;
+    }
+    else
+    {
+        m_settings.resetToDefaults();
+        MsgConfigureShmSink *msg = MsgConfigureShmSink::create(m_settings, true);
+        m_inputMessageQueue.push(msg);
+        return false;
+    }
+}
+
+quint64 ShmSink::getSamplesCount() const
+{
+    return m_basebandSink->getSamplesCount();
+}
+
+quint64 ShmSink::getDroppedCount() const
+{
+    return m_basebandSink->getDroppedCount();
+}
+
+void ShmSink::applySettings(const ShmSinkSettings& settings, bool force)
+{
+    qDebug() << "ShmSink::applySettings:"
+            << "m_shmName: " << settings.m_shmName
+            << "m_streamIndex: " << settings.m_streamIndex
+            << "m_play:" << settings.m_play
+            << "force: " << force;
+
+    QList<QString> reverseAPIKeys;
+
+    if ((settings.m_shmName != m_settings.m_shmName) || force) {
+        reverseAPIKeys.append("shmName");
+    }
+    if ((settings.m_log2Decim != m_settings.m_log2Decim) || force) {
+        reverseAPIKeys.append("log2Decim");
+    }
+    if ((settings.m_filterChainHash != m_settings.m_filterChainHash) || force) {
+        reverseAPIKeys.append("filterChainHash");
+    }
+
+    if ((settings.m_log2Decim != m_settings.m_log2Decim)
+     || (settings.m_filterChainHash != m_settings.m_filterChainHash) || force)
+    {
+        calculateFrequencyOffset(settings.m_log2Decim, settings.m_filterChainHash);
+    }
+
+    // settings first so that the sink starts on the right segment
+    ShmSinkBaseband::MsgConfigureShmSinkBaseband *msg = ShmSinkBaseband::MsgConfigureShmSinkBaseband::create(settings, force);
+    m_basebandSink->getInputMessageQueue()->push(msg);
+
+    if ((settings.m_play != m_settings.m_play) || force)
+    {
+        reverseAPIKeys.append("play");
+        ShmSinkBaseband::MsgConfigureShmSinkWork *msg = ShmSinkBaseband::MsgConfigureShmSinkWork::create(
+            settings.m_play
+        );
+        m_basebandSink->getInputMessageQueue()->push(msg);
+    }
+
+    if (m_settings.m_streamIndex != settings.m_streamIndex)
+    {
+        if (m_deviceAPI->getSampleMIMO()) // change of stream is possible for MIMO devices only
+        {
+            m_deviceAPI->removeChannelSinkAPI(this);
+            m_deviceAPI->removeChannelSink(this, m_settings.m_streamIndex);
+            m_deviceAPI->addChannelSink(this, settings.m_streamIndex);
+            m_deviceAPI->addChannelSinkAPI(this);
+        }
+
+        reverseAPIKeys.append("streamIndex");
+    }
+
+    if ((settings.m_useReverseAPI) && (reverseAPIKeys.size() != 0))
+    {
+        bool fullUpdate = ((m_settings.m_useReverseAPI != settings.m_useReverseAPI) && settings.m_useReverseAPI) ||
+                (m_settings.m_reverseAPIAddress != settings.m_reverseAPIAddress) ||
+                (m_settings.m_reverseAPIPort != settings.m_reverseAPIPort) ||
+                (m_settings.m_reverseAPIDeviceIndex != settings.m_reverseAPIDeviceIndex) ||
+                (m_settings.m_reverseAPIChannelIndex != settings.m_reverseAPIChannelIndex);
+        webapiReverseSendSettings(reverseAPIKeys, settings, fullUpdate || force);
+    }
+
+    m_settings = settings;
+}
+
+void ShmSink::validateFilterChainHash(ShmSinkSettings& settings)
+{
+    unsigned int s = 1;
+
+    for (unsigned int i = 0; i < settings.m_log2Decim; i++) {
+        s *= 3;
+    }
+
+    settings.m_filterChainHash = settings.m_filterChainHash >= s ? s-1 : settings.m_filterChainHash;
+}
+
+void ShmSink::calculateFrequencyOffset(uint32_t log2Decim, uint32_t filterChainHash)
+{
+    double shiftFactor = HBFilterChainConverter::getShiftFactor(log2Decim, filterChainHash);
+    m_frequencyOffset = m_basebandSampleRate * shiftFactor;
+}
+
+int ShmSink::webapiSettingsGet(
+        SWGSDRangel::SWGChannelSettings& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setShmSinkSettings(new SWGSDRangel::SWGShmSinkSettings());
+    response.getShmSinkSettings()->init();
+    webapiFormatChannelSettings(response, m_settings);
+    return 200;
+}
+
+int ShmSink::webapiSettingsPutPatch(
+        bool force,
+        const QStringList& channelSettingsKeys,
+        SWGSDRangel::SWGChannelSettings& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    ShmSinkSettings settings = m_settings;
+    webapiUpdateChannelSettings(settings, channelSettingsKeys, response);
+
+    MsgConfigureShmSink *msg = MsgConfigureShmSink::create(settings, force);
+    m_inputMessageQueue.push(msg);
+
+    qDebug("ShmSink::webapiSettingsPutPatch: forward to GUI: %p", m_guiMessageQueue);
+    if (m_guiMessageQueue) // forward to GUI if any
+    {
+        MsgConfigureShmSink *msgToGUI = MsgConfigureShmSink::create(settings, force);
+        m_guiMessageQueue->push(msgToGUI);
+    }
+
+    webapiFormatChannelSettings(response, settings);
+
+    return 200;
+}
+
+void ShmSink::webapiUpdateChannelSettings(
+        ShmSinkSettings& settings,
+        const QStringList& channelSettingsKeys,
+        SWGSDRangel::SWGChannelSettings& response)
+{
+    if (channelSettingsKeys.contains("shmName")) {
+        settings.m_shmName = *response.getShmSinkSettings()->getShmName();
+    }
+    if (channelSettingsKeys.contains("rgbColor")) {
+        settings.m_rgbColor = response.getShmSinkSettings()->getRgbColor();
+    }
+    if (channelSettingsKeys.contains("title")) {
+        settings.m_title = *response.getShmSinkSettings()->getTitle();
+    }
+    if (channelSettingsKeys.contains("log2Decim")) {
+        settings.m_log2Decim = response.getShmSinkSettings()->getLog2Decim();
+    }
+
+    if (channelSettingsKeys.contains("filterChainHash"))
+    {
+        settings.m_filterChainHash = response.getShmSinkSettings()->getFilterChainHash();
+        validateFilterChainHash(settings);
+    }
+
+    if (channelSettingsKeys.contains("play")) {
+        settings.m_play = response.getShmSinkSettings()->getPlay() != 0;
+    }
+    if (channelSettingsKeys.contains("streamIndex")) {
+        settings.m_streamIndex = response.getShmSinkSettings()->getStreamIndex();
+    }
+    if (channelSettingsKeys.contains("useReverseAPI")) {
+        settings.m_useReverseAPI = response.getShmSinkSettings()->getUseReverseApi() != 0;
+    }
+    if (channelSettingsKeys.contains("reverseAPIAddress")) {
+        settings.m_reverseAPIAddress = *response.getShmSinkSettings()->getReverseApiAddress();
+    }
+    if (channelSettingsKeys.contains("reverseAPIPort")) {
+        settings.m_reverseAPIPort = response.getShmSinkSettings()->getReverseApiPort();
+    }
+    if (channelSettingsKeys.contains("reverseAPIDeviceIndex")) {
+        settings.m_reverseAPIDeviceIndex = response.getShmSinkSettings()->getReverseApiDeviceIndex();
+    }
+    if (channelSettingsKeys.contains("reverseAPIChannelIndex")) {
+        settings.m_reverseAPIChannelIndex = response.getShmSinkSettings()->getReverseApiChannelIndex();
+    }
+}
+
+void ShmSink::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const ShmSinkSettings& settings)
+{
+    if (response.getShmSinkSettings()->getShmName()) {
+        *response.getShmSinkSettings()->getShmName() = settings.m_shmName;
+    } else {
+        response.getShmSinkSettings()->setShmName(new QString(settings.m_shmName));
+    }
+
+    response.getShmSinkSettings()->setRgbColor(settings.m_rgbColor);
+
+    if (response.getShmSinkSettings()->getTitle()) {
+        *response.getShmSinkSettings()->getTitle() = settings.m_title;
+    } else {
+        response.getShmSinkSettings()->setTitle(new QString(settings.m_title));
+    }
+
+    response.getShmSinkSettings()->setLog2Decim(settings.m_log2Decim);
+    response.getShmSinkSettings()->setFilterChainHash(settings.m_filterChainHash);
+    response.getShmSinkSettings()->setPlay(settings.m_play ? 1 : 0);
+    response.getShmSinkSettings()->setStreamIndex(settings.m_streamIndex);
+    response.getShmSinkSettings()->setUseReverseApi(settings.m_useReverseAPI ? 1 : 0);
+
+    if (response.getShmSinkSettings()->getReverseApiAddress()) {
+        *response.getShmSinkSettings()->getReverseApiAddress() = settings.m_reverseAPIAddress;
+    } else {
+        response.getShmSinkSettings()->setReverseApiAddress(new QString(settings.m_reverseAPIAddress));
+    }
+
+    response.getShmSinkSettings()->setReverseApiPort(settings.m_reverseAPIPort);
+    response.getShmSinkSettings()->setReverseApiDeviceIndex(settings.m_reverseAPIDeviceIndex);
+    response.getShmSinkSettings()->setReverseApiChannelIndex(settings.m_reverseAPIChannelIndex);
+}
+
+void ShmSink::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const ShmSinkSettings& settings, bool force)
+{
+    SWGSDRangel::SWGChannelSettings *swgChannelSettings = new SWGSDRangel::SWGChannelSettings();
+    swgChannelSettings->setDirection(0); // single sink (Rx)
+    swgChannelSettings->setOriginatorChannelIndex(getIndexInDeviceSet());
+    swgChannelSettings->setOriginatorDeviceSetIndex(getDeviceSetIndex());
+    swgChannelSettings->setChannelType(new QString("ShmSink"));
+    swgChannelSettings->setShmSinkSettings(new SWGSDRangel::SWGShmSinkSettings());
+    SWGSDRangel::SWGShmSinkSettings *swgShmSinkSettings = swgChannelSettings->getShmSinkSettings();
+
+    // transfer data that has been modified. When force is on transfer all data except reverse API data
+
+    if (channelSettingsKeys.contains("shmName") || force) {
+        swgShmSinkSettings->setShmName(new QString(settings.m_shmName));
+    }
+    if (channelSettingsKeys.contains("rgbColor") || force) {
+        swgShmSinkSettings->setRgbColor(settings.m_rgbColor);
+    }
+    if (channelSettingsKeys.contains("title") || force) {
+        swgShmSinkSettings->setTitle(new QString(settings.m_title));
+    }
+    if (channelSettingsKeys.contains("log2Decim") || force) {
+        swgShmSinkSettings->setLog2Decim(settings.m_log2Decim);
+    }
+    if (channelSettingsKeys.contains("filterChainHash") || force) {
+        swgShmSinkSettings->setFilterChainHash(settings.m_filterChainHash);
+    }
+    if (channelSettingsKeys.contains("play") || force) {
+        swgShmSinkSettings->setPlay(settings.m_play ? 1 : 0);
+    }
+    if (channelSettingsKeys.contains("streamIndex") || force) {
+        swgShmSinkSettings->setStreamIndex(settings.m_streamIndex);
+    }
+
+    QString channelSettingsURL = QString("http://%1:%2/sdrangel/deviceset/%3/channel/%4/settings")
+            .arg(settings.m_reverseAPIAddress)
+            .arg(settings.m_reverseAPIPort)
+            .arg(settings.m_reverseAPIDeviceIndex)
+            .arg(settings.m_reverseAPIChannelIndex);
+    m_networkRequest.setUrl(QUrl(channelSettingsURL));
+    m_networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+
+    QBuffer *buffer = new QBuffer();
+    buffer->open((QBuffer::ReadWrite));
+    buffer->write(swgChannelSettings->asJson().toUtf8());
+    buffer->seek(0);
+
+    // Always use PATCH to avoid passing reverse API settings
+    QNetworkReply *reply = m_networkManager->sendCustomRequest(m_networkRequest, "PATCH", buffer);
+    buffer->setParent(reply);
+
+    delete swgChannelSettings;
+}
+
+void ShmSink::networkManagerFinished(QNetworkReply *reply)
+{
+    QNetworkReply::NetworkError replyError = reply->error();
+
+    if (replyError)
+    {
+        qWarning() << "ShmSink::networkManagerFinished:"
+                << " error(" << (int) replyError
+                << "): " << replyError
+                << ": " << reply->errorString();
+    }
+    else
+    {
+        QString answer = reply->readAll();
+        answer.chop(1); // remove last \n
+        qDebug("ShmSink::networkManagerFinished: reply:\n%s", answer.toStdString().c_str());
+    }
+
+    reply->deleteLater();
+}
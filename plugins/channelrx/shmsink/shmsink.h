@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SHMSINK_H_
+#define INCLUDE_SHMSINK_H_
+
+#include <QObject>
+#include <QMutex>
+#include <QNetworkRequest>
+
+#include "dsp/basebandsamplesink.h"
+#include "channel/channelapi.h"
+#include "shmsinksettings.h"
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QThread;
+
+class DeviceAPI;
+class ShmSinkBaseband;
+
+class ShmSink : public BasebandSampleSink, public ChannelAPI {
+    Q_OBJECT
+public:
+    class MsgConfigureShmSink : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        const ShmSinkSettings& getSettings() const { return m_settings; }
+        bool getForce() const { return m_force; }
+
+        static MsgConfigureShmSink* create(const ShmSinkSettings& settings, bool force)
+        {
+            return new MsgConfigureShmSink(settings, force);
+        }
+
+    private:
+        ShmSinkSettings m_settings;
+        bool m_force;
+
+        MsgConfigureShmSink(const ShmSinkSettings& settings, bool force) :
+            Message(),
+            m_settings(settings),
+            m_force(force)
+        { }
+    };
+
+    class MsgBasebandSampleRateNotification : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        static MsgBasebandSampleRateNotification* create(int sampleRate) {
+            return new MsgBasebandSampleRateNotification(sampleRate);
+        }
+
+        int getSampleRate() const { return m_sampleRate; }
+
+    private:
+
+        MsgBasebandSampleRateNotification(int sampleRate) :
+            Message(),
+            m_sampleRate(sampleRate)
+        { }
+
+        int m_sampleRate;
+    };
+
+    ShmSink(DeviceAPI *deviceAPI);
+    virtual ~ShmSink();
+    virtual void destroy() { delete this; }
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool po);
+    virtual void start();
+    virtual void stop();
+    virtual bool handleMessage(const Message& cmd);
+    virtual void setCompactSamples(bool compactSamples);
+
+    virtual void getIdentifier(QString& id) { id = objectName(); }
+    virtual void getTitle(QString& title) { title = "Shared Memory Sink"; }
+    virtual qint64 getCenterFrequency() const { return m_frequencyOffset; }
+
+    virtual QByteArray serialize() const;
+    virtual bool deserialize(const QByteArray& data);
+
+    virtual int getNbSinkStreams() const { return 1; }
+    virtual int getNbSourceStreams() const { return 0; }
+
+    virtual qint64 getStreamCenterFrequency(int streamIndex, bool sinkElseSource) const
+    {
+        (void) streamIndex;
+        (void) sinkElseSource;
+        return m_frequencyOffset;
+    }
+
+    virtual int webapiSettingsGet(
+            SWGSDRangel::SWGChannelSettings& response,
+            QString& errorMessage);
+
+    virtual int webapiSettingsPutPatch(
+            bool force,
+            const QStringList& channelSettingsKeys,
+            SWGSDRangel::SWGChannelSettings& response,
+            QString& errorMessage);
+
+    static void webapiFormatChannelSettings(
+        SWGSDRangel::SWGChannelSettings& response,
+        const ShmSinkSettings& settings);
+
+    static void webapiUpdateChannelSettings(
+            ShmSinkSettings& settings,
+            const QStringList& channelSettingsKeys,
+            SWGSDRangel::SWGChannelSettings& response);
+
+    uint32_t getNumberOfDeviceStreams() const;
+    quint64 getSamplesCount() const;  //!< Samples written in the shared memory ring since start
+    quint64 getDroppedCount() const;  //!< Samples dropped since start
+
+    static const QString m_channelIdURI;
+    static const QString m_channelId;
+
+private:
+    DeviceAPI *m_deviceAPI;
+    QThread *m_thread;
+    ShmSinkBaseband *m_basebandSink;
+    ShmSinkSettings m_settings;
+
+    uint64_t m_centerFrequency;
+    int64_t m_frequencyOffset;
+    uint32_t m_basebandSampleRate;
+
+    QNetworkAccessManager *m_networkManager;
+    QNetworkRequest m_networkRequest;
+
+    void applySettings(const ShmSinkSettings& settings, bool force = false);
+    static void validateFilterChainHash(ShmSinkSettings& settings);
+    void calculateFrequencyOffset(uint32_t log2Decim, uint32_t filterChainHash);
+
+    void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const ShmSinkSettings& settings, bool force);
+
+private slots:
+    void networkManagerFinished(QNetworkReply *reply);
+};
+
+#endif /* INCLUDE_SHMSINK_H_ */
@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dsp/downchannelizer.h"
+#include "dsp/dspengine.h"
+#include "dsp/dspcommands.h"
+#include "dsp/hbfilterchainconverter.h"
+
+#include "shmsinkbaseband.h"
+
+MESSAGE_CLASS_DEFINITION(ShmSinkBaseband::MsgConfigureShmSinkBaseband, Message)
+MESSAGE_CLASS_DEFINITION(ShmSinkBaseband::MsgConfigureShmSinkWork, Message)
+
+ShmSinkBaseband::ShmSinkBaseband() :
+    m_basebandSampleRate(48000),
+    m_centerFrequency(0),
+    m_working(false),
+    m_mutex(QMutex::Recursive)
+{
+    m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
+    m_channelizer = new DownChannelizer(&m_sink);
+
+    qDebug("ShmSinkBaseband::ShmSinkBaseband");
+    QObject::connect(
+        &m_sampleFifo,
+        &SampleSinkFifo::dataReady,
+        this,
+        &ShmSinkBaseband::handleData,
+        Qt::QueuedConnection
+    );
+
+    connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
+}
+
+ShmSinkBaseband::~ShmSinkBaseband()
+{
+    m_sink.stop();
+    delete m_channelizer;
+}
+
+void ShmSinkBaseband::reset()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_sampleFifo.reset();
+}
+
+void ShmSinkBaseband::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    m_sampleFifo.write(begin, end);
+}
+
+void ShmSinkBaseband::handleData()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    while ((m_sampleFifo.fill() > 0) && (m_inputMessageQueue.size() == 0))
+    {
+        SampleVector::iterator part1begin;
+        SampleVector::iterator part1end;
+        SampleVector::iterator part2begin;
+        SampleVector::iterator part2end;
+
+        std::size_t count = m_sampleFifo.readBegin(m_sampleFifo.fill(), &part1begin, &part1end, &part2begin, &part2end);
+
+        // first part of FIFO data
+        if (part1begin != part1end) {
+            m_channelizer->feed(part1begin, part1end);
+        }
+
+        // second part of FIFO data (used when block wraps around)
+        if(part2begin != part2end) {
+            m_channelizer->feed(part2begin, part2end);
+        }
+
+        m_sampleFifo.readCommit((unsigned int) count);
+    }
+}
+
+void ShmSinkBaseband::handleInputMessages()
+{
+    Message* message;
+
+    while ((message = m_inputMessageQueue.pop()) != nullptr)
+    {
+        if (handleMessage(*message)) {
+            delete message;
+        }
+    }
+}
+
+bool ShmSinkBaseband::handleMessage(const Message& cmd)
+{
+    if (MsgConfigureShmSinkBaseband::match(cmd))
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        MsgConfigureShmSinkBaseband& cfg = (MsgConfigureShmSinkBaseband&) cmd;
+        qDebug() << "ShmSinkBaseband::handleMessage: MsgConfigureShmSinkBaseband";
+
+        applySettings(cfg.getSettings(), cfg.getForce());
+
+        return true;
+    }
+    else if (DSPSignalNotification::match(cmd))
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
+        qDebug() << "ShmSinkBaseband::handleMessage: DSPSignalNotification:"
+            << " basebandSampleRate: " << notif.getSampleRate()
+            << " centerFrequency: " << notif.getCenterFrequency();
+        m_basebandSampleRate = notif.getSampleRate();
+        m_centerFrequency = notif.getCenterFrequency();
+        m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(notif.getSampleRate()));
+        m_channelizer->setBasebandSampleRate(notif.getSampleRate(), true); // apply decimation
+        updateStreamParameters();
+
+        return true;
+    }
+    else if (MsgConfigureShmSinkWork::match(cmd))
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        MsgConfigureShmSinkWork& conf = (MsgConfigureShmSinkWork&) cmd;
+        qDebug() << "ShmSinkBaseband::handleMessage: MsgConfigureShmSinkWork: " << conf.isWorking();
+        m_working = conf.isWorking();
+
+        if (m_working) {
+            m_sink.start(m_settings.m_shmName);
+        } else {
+            m_sink.stop();
+        }
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void ShmSinkBaseband::applySettings(const ShmSinkSettings& settings, bool force)
+{
+    qDebug() << "ShmSinkBaseband::applySettings:"
+        << "m_shmName:" << settings.m_shmName
+        << "m_log2Decim:" << settings.m_log2Decim
+        << "m_filterChainHash:" << settings.m_filterChainHash
+        << " force: " << force;
+
+    if ((settings.m_log2Decim != m_settings.m_log2Decim)
+     || (settings.m_filterChainHash != m_settings.m_filterChainHash) || force)
+    {
+        m_channelizer->setDecimation(settings.m_log2Decim, settings.m_filterChainHash);
+    }
+
+    if ((settings.m_shmName != m_settings.m_shmName) && m_working) {
+        m_sink.start(settings.m_shmName); // move to the new segment
+    }
+
+    m_settings = settings;
+    updateStreamParameters();
+}
+
+void ShmSinkBaseband::updateStreamParameters()
+{
+    double shiftFactor = HBFilterChainConverter::getShiftFactor(m_settings.m_log2Decim, m_settings.m_filterChainHash);
+    m_sink.setStreamParameters(getChannelSampleRate(), m_centerFrequency + (qint64) (m_basebandSampleRate * shiftFactor));
+}
+
+int ShmSinkBaseband::getChannelSampleRate() const
+{
+    return m_channelizer->getChannelSampleRate();
+}
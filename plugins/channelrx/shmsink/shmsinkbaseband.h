@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SHMSINKBASEBAND_H
+#define INCLUDE_SHMSINKBASEBAND_H
+
+#include <QObject>
+#include <QMutex>
+
+#include "dsp/samplesinkfifo.h"
+#include "util/message.h"
+#include "util/messagequeue.h"
+
+#include "shmsinksink.h"
+#include "shmsinksettings.h"
+
+class DownChannelizer;
+
+class ShmSinkBaseband : public QObject
+{
+    Q_OBJECT
+public:
+    class MsgConfigureShmSinkBaseband : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        const ShmSinkSettings& getSettings() const { return m_settings; }
+        bool getForce() const { return m_force; }
+
+        static MsgConfigureShmSinkBaseband* create(const ShmSinkSettings& settings, bool force)
+        {
+            return new MsgConfigureShmSinkBaseband(settings, force);
+        }
+
+    private:
+        ShmSinkSettings m_settings;
+        bool m_force;
+
+        MsgConfigureShmSinkBaseband(const ShmSinkSettings& settings, bool force) :
+            Message(),
+            m_settings(settings),
+            m_force(force)
+        { }
+    };
+
+    class MsgConfigureShmSinkWork : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        bool isWorking() const { return m_working; }
+
+        static MsgConfigureShmSinkWork* create(bool working)
+        {
+            return new MsgConfigureShmSinkWork(working);
+        }
+
+    private:
+        bool m_working;
+
+        MsgConfigureShmSinkWork(bool working) :
+            Message(),
+            m_working(working)
+        { }
+    };
+
+    ShmSinkBaseband();
+    ~ShmSinkBaseband();
+    void reset();
+    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void setCompactSamples(bool compactSamples) { m_sampleFifo.setCompact(compactSamples); }
+    MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
+    int getChannelSampleRate() const;
+    quint64 getSamplesCount() const { return m_sink.getSamplesCount(); }
+    quint64 getDroppedCount() const { return m_sink.getDroppedCount(); }
+
+private:
+    SampleSinkFifo m_sampleFifo;
+    DownChannelizer *m_channelizer;
+    ShmSinkSink m_sink;
+    MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
+    ShmSinkSettings m_settings;
+    int m_basebandSampleRate;
+    qint64 m_centerFrequency;
+    bool m_working;
+    QMutex m_mutex;
+
+    bool handleMessage(const Message& cmd);
+    void applySettings(const ShmSinkSettings& settings, bool force = false);
+    void updateStreamParameters();
+
+private slots:
+    void handleInputMessages();
+    void handleData(); //!< Handle data when samples have to be processed
+};
+
+
+#endif // INCLUDE_SHMSINKBASEBAND_H
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "shmsinkplugin.h"
+
+#include <QtPlugin>
+#include "plugin/pluginapi.h"
+
+#ifndef SERVER_MODE
+#include "shmsinkgui.h"
+#endif
+#include "shmsink.h"
+#include "shmsinkwebapiadapter.h"
+#include "shmsinkplugin.h"
+
+const PluginDescriptor ShmSinkPlugin::m_pluginDescriptor = {
+    ShmSink::m_channelId,
+    QString("Shared memory channel sink"),
+    QString("4.15.0"),
+    QString("(c) Edouard Griffiths, F4EXB"),
+    QString("https://github.com/f4exb/sdrangel"),
+    true,
+    QString("https://github.com/f4exb/sdrangel")
+};
+
+ShmSinkPlugin::ShmSinkPlugin(QObject* parent) :
+    QObject(parent),
+    m_pluginAPI(0)
+{
+}
+
+const PluginDescriptor& ShmSinkPlugin::getPluginDescriptor() const
+{
+    return m_pluginDescriptor;
+}
+
+void ShmSinkPlugin::initPlugin(PluginAPI* pluginAPI)
+{
+    m_pluginAPI = pluginAPI;
+
+    // register channel Source
+    m_pluginAPI->registerRxChannel(ShmSink::m_channelIdURI, ShmSink::m_channelId, this);
+}
+
+#ifdef SERVER_MODE
+PluginInstanceGUI* ShmSinkPlugin::createRxChannelGUI(
+        DeviceUISet *deviceUISet,
+        BasebandSampleSink *rxChannel) const
+{
+    return 0;
+}
+#else
+PluginInstanceGUI* ShmSinkPlugin::createRxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel) const
+{
+    return ShmSinkGUI::create(m_pluginAPI, deviceUISet, rxChannel);
+}
+#endif
+
+BasebandSampleSink* ShmSinkPlugin::createRxChannelBS(DeviceAPI *deviceAPI) const
+{
+    return new ShmSink(deviceAPI);
+}
+
+ChannelAPI* ShmSinkPlugin::createRxChannelCS(DeviceAPI *deviceAPI) const
+{
+    return new ShmSink(deviceAPI);
+}
+
+ChannelWebAPIAdapter* ShmSinkPlugin::createChannelWebAPIAdapter() const
+{
+	return new ShmSinkWebAPIAdapter();
+}
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "util/timeutil.h"
+
+#include "shmsinksink.h"
+
+const unsigned int ShmSinkSink::m_ringCapacity = 1<<22;
+const int ShmSinkSink::m_dropReportPeriodMs = 2500;
+
+ShmSinkSink::ShmSinkSink() :
+    m_sampleRate(48000),
+    m_centerFrequency(0),
+    m_samplesCount(0),
+    m_droppedCount(0),
+    m_droppedReported(0)
+{
+}
+
+ShmSinkSink::~ShmSinkSink()
+{
+    stop();
+}
+
+void ShmSinkSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    if (!m_ring.isOpen()) {
+        return;
+    }
+
+    unsigned int count = end - begin;
+    ShmIQRing::BlockInfo info;
+    info.m_centerFrequency = m_centerFrequency;
+    info.m_sampleRate = m_sampleRate;
+    info.m_nbSamples = count;
+    // the block is handed over as soon as its last sample is out of the channelizer
+    info.m_timestampUs = TimeUtil::nowus() - (m_sampleRate > 0 ? (count * 1000000ULL) / m_sampleRate : 0);
+
+    unsigned int written = m_ring.write(begin, end, info);
+    m_samplesCount += written;
+    m_droppedCount += count - written;
+
+    if ((m_droppedCount != m_droppedReported) && (m_dropReportTimer.elapsed() > m_dropReportPeriodMs))
+    {
+        qWarning("ShmSinkSink::feed: %s: %llu samples dropped (%llu written)",
+            qPrintable(m_ring.getName()), m_droppedCount - m_droppedReported, m_samplesCount);
+        m_droppedReported = m_droppedCount;
+        m_dropReportTimer.restart();
+    }
+}
+
+bool ShmSinkSink::start(const QString& shmName)
+{
+    qDebug() << "ShmSinkSink::start: " << shmName;
+
+    if (m_ring.isOpen()) {
+        stop();
+    }
+
+    m_samplesCount = 0;
+    m_droppedCount = 0;
+    m_droppedReported = 0;
+    m_dropReportTimer.start();
+
+    return m_ring.create(shmName, m_ringCapacity);
+}
+
+void ShmSinkSink::stop()
+{
+    if (!m_ring.isOpen()) {
+        return;
+    }
+
+    qDebug("ShmSinkSink::stop: %llu samples written %llu dropped", m_samplesCount, m_droppedCount);
+    m_ring.close();
+}
+
+void ShmSinkSink::setStreamParameters(int sampleRate, qint64 centerFrequency)
+{
+    qDebug() << "ShmSinkSink::setStreamParameters:"
+        << " sampleRate: " << sampleRate
+        << " centerFrequency: " << centerFrequency;
+    m_sampleRate = sampleRate;
+    m_centerFrequency = centerFrequency;
+}
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SHMSINKSINK_H_
+#define INCLUDE_SHMSINKSINK_H_
+
+#include <QElapsedTimer>
+
+#include "dsp/channelsamplesink.h"
+#include "util/shmiqring.h"
+
+/**
+ * Writes the channel samples in a shared memory ring read by a Shared Memory Input device
+ * possibly in another process. Each block carries the stream center frequency, sample rate
+ * and the timestamp of its first sample. The writer never waits for the reader: blocks that
+ * do not fit are dropped and counted.
+ */
+class ShmSinkSink : public ChannelSampleSink {
+public:
+    ShmSinkSink();
+    ~ShmSinkSink();
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+
+    bool start(const QString& shmName);
+    void stop();
+    bool isRunning() const { return m_ring.isOpen(); }
+    void setStreamParameters(int sampleRate, qint64 centerFrequency);
+    quint64 getSamplesCount() const { return m_samplesCount; } //!< Samples written since start
+    quint64 getDroppedCount() const { return m_droppedCount; } //!< Samples dropped since start
+
+private:
+    ShmIQRing m_ring;
+    int m_sampleRate;
+    qint64 m_centerFrequency;
+    quint64 m_samplesCount;
+    quint64 m_droppedCount;
+    quint64 m_droppedReported;
+    QElapsedTimer m_dropReportTimer;
+
+    static const unsigned int m_ringCapacity;
+    static const int m_dropReportPeriodMs;
+};
+
+#endif // INCLUDE_SHMSINKSINK_H_
@@ -104,6 +104,11 @@ void UDPSink::stop()
 	m_thread->wait();
 }
 
+void UDPSink::setCompactSamples(bool compactSamples)
+{
+    m_basebandSink->setCompactSamples(compactSamples);
+}
+
 bool UDPSink::handleMessage(const Message& cmd)
 {
     if (MsgConfigureUDPSink::match(cmd))
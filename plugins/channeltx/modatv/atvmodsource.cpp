@@ -166,13 +166,18 @@ ATVModSource::~ATVModSource()
 
 void ATVModSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
 {
-    std::for_each(
-        begin,
-        begin + nbSamples,
-        [this](Sample& s) {
-            pullOne(s);
-        }
-    );
+	if (m_settings.m_channelMute)
+	{
+        std::fill(begin, begin + nbSamples, Sample{0, 0});
+		return;
+	}
+
+    if (m_modBuffer.size() < nbSamples) {
+        m_modBuffer.resize(nbSamples);
+    }
+
+    modulateBlock(m_modBuffer.data(), nbSamples);
+    finalizeBlock(m_modBuffer.data(), &(*begin), nbSamples);
 }
 
 void ATVModSource::prefetch(unsigned int nbSamples)
@@ -190,46 +195,61 @@ void ATVModSource::pullOne(Sample& sample)
 	}
 
     Complex ci;
+    modulateBlock(&ci, 1);
+    finalizeBlock(&ci, &sample, 1);
+}
 
+void ATVModSource::modulateBlock(Complex *ci, unsigned int nbSamples)
+{
     if ((m_tvSampleRate == m_channelSampleRate) && (!m_settings.m_forceDecimator)) // no interpolation nor decimation
     {
-        modulateSample();
-        pullFinalize(m_modSample, sample);
+        for (unsigned int i = 0; i < nbSamples; i++)
+        {
+            modulateSample();
+            ci[i] = m_modSample;
+        }
     }
-    else
+    else if (m_interpolatorDistance > 1.0f) // decimate
     {
-        if (m_interpolatorDistance > 1.0f) // decimate
+        for (unsigned int i = 0; i < nbSamples; i++)
         {
             modulateSample();
 
-            while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+            while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci[i]))
             {
                 modulateSample();
             }
+
+            m_interpolatorDistanceRemain += m_interpolatorDistance;
         }
-        else
+    }
+    else
+    {
+        for (unsigned int i = 0; i < nbSamples; i++)
         {
-            if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+            if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci[i]))
             {
                 modulateSample();
             }
-        }
 
-        m_interpolatorDistanceRemain += m_interpolatorDistance;
-        pullFinalize(ci, sample);
+            m_interpolatorDistanceRemain += m_interpolatorDistance;
+        }
     }
 }
 
-void ATVModSource::pullFinalize(Complex& ci, Sample& sample)
+void ATVModSource::finalizeBlock(Complex *ci, Sample *sOut, unsigned int nbSamples)
 {
-    ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        ci[i] *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
-    magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
-    m_movingAverage(magsq);
+        double magsq = ci[i].real() * ci[i].real() + ci[i].imag() * ci[i].imag();
+        magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
+        m_movingAverage(magsq);
 
-    sample.m_real = (FixReal) ci.real();
-    sample.m_imag = (FixReal) ci.imag();
+        sOut[i].m_real = (FixReal) ci[i].real();
+        sOut[i].m_imag = (FixReal) ci[i].imag();
+    }
 }
 
 void ATVModSource::modulateSample()
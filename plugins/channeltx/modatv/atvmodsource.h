@@ -148,6 +148,7 @@ private:
 
     NCO m_carrierNco;
     Complex m_modSample;
+    std::vector<Complex> m_modBuffer; //!< Channel samples before carrier shift in block mode
     float m_modPhasor; //!< For FM modulation
     Interpolator m_interpolator;
     Real m_interpolatorDistance;
@@ -242,7 +243,8 @@ private:
     static const LineType StdShort_F1Start[];
     static const LineType StdShort_F2Start[];
 
-    void pullFinalize(Complex& ci, Sample& sample);
+    void modulateBlock(Complex *ci, unsigned int nbSamples); //!< Produce nbSamples channel samples
+    void finalizeBlock(Complex *ci, Sample *sOut, unsigned int nbSamples); //!< Shift to carrier, measure and convert
     void pullVideo(Real& sample);
     void calculateLevel(Real& sample);
     void modulateSample();
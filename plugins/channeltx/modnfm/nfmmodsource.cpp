@@ -53,13 +53,18 @@ NFMModSource::~NFMModSource()
 
 void NFMModSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
 {
-    std::for_each(
-        begin,
-        begin + nbSamples,
-        [this](Sample& s) {
-            pullOne(s);
-        }
-    );
+	if (m_settings.m_channelMute)
+	{
+        std::fill(begin, begin + nbSamples, Sample{0, 0});
+		return;
+	}
+
+    if (m_modBuffer.size() < nbSamples) {
+        m_modBuffer.resize(nbSamples);
+    }
+
+    modulateBlock(m_modBuffer.data(), nbSamples);
+    finalizeBlock(m_modBuffer.data(), &(*begin), nbSamples);
 }
 
 void NFMModSource::pullOne(Sample& sample)
@@ -72,35 +77,55 @@ void NFMModSource::pullOne(Sample& sample)
 	}
 
 	Complex ci;
+    modulateBlock(&ci, 1);
+    finalizeBlock(&ci, &sample, 1);
+}
 
+void NFMModSource::modulateBlock(Complex *ci, unsigned int nbSamples)
+{
     if (m_interpolatorDistance > 1.0f) // decimate
     {
-    	modulateSample();
-
-        while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        for (unsigned int i = 0; i < nbSamples; i++)
         {
-        	modulateSample();
+            modulateSample();
+
+            while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci[i]))
+            {
+                modulateSample();
+            }
+
+            m_interpolatorDistanceRemain += m_interpolatorDistance;
         }
     }
     else
     {
-        if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        for (unsigned int i = 0; i < nbSamples; i++)
         {
-        	modulateSample();
+            if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci[i]))
+            {
+                modulateSample();
+            }
+
+            m_interpolatorDistanceRemain += m_interpolatorDistance;
         }
     }
+}
+
+void NFMModSource::finalizeBlock(Complex *ci, Sample *sOut, unsigned int nbSamples)
+{
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        ci[i] *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_interpolatorDistanceRemain += m_interpolatorDistance;
+        double magsq = ci[i].real() * ci[i].real() + ci[i].imag() * ci[i].imag();
+        magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
+        m_movingAverage(magsq);
 
-    ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
+        sOut[i].m_real = (FixReal) ci[i].real();
+        sOut[i].m_imag = (FixReal) ci[i].imag();
+    }
 
-    double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
-	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
-	m_movingAverage(magsq);
 	m_magsq = m_movingAverage.asDouble();
-
-	sample.m_real = (FixReal) ci.real();
-	sample.m_imag = (FixReal) ci.imag();
 }
 
 void NFMModSource::prefetch(unsigned int nbSamples)
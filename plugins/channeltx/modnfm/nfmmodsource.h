@@ -114,7 +114,11 @@ private:
     static const int m_levelNbSamples;
     static const float m_preemphasis;
 
+    std::vector<Complex> m_modBuffer; //!< Channel samples before carrier shift in block mode
+
     void processOneSample(Complex& ci);
+    void modulateBlock(Complex *ci, unsigned int nbSamples); //!< Produce nbSamples channel samples
+    void finalizeBlock(Complex *ci, Sample *sOut, unsigned int nbSamples); //!< Shift to carrier, measure and convert
     void pullAF(Real& sample);
     void pullAudio(unsigned int nbSamples);
     void pushFeedback(Real sample);
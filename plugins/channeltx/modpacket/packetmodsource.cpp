@@ -55,13 +55,23 @@ PacketModSource::~PacketModSource()
 
 void PacketModSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
 {
-    std::for_each(
-        begin,
-        begin + nbSamples,
-        [this](Sample& s) {
-            pullOne(s);
-        }
-    );
+    if (m_settings.m_channelMute)
+    {
+        std::fill(begin, begin + nbSamples, Sample{0, 0});
+        return;
+    }
+
+    if (m_modBuffer.size() < nbSamples) {
+        m_modBuffer.resize(nbSamples);
+    }
+
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        modulateSample();
+        m_modBuffer[i] = m_modSample;
+    }
+
+    finalizeBlock(m_modBuffer.data(), &(*begin), nbSamples);
 }
 
 void PacketModSource::pullOne(Sample& sample)
@@ -75,19 +85,27 @@ void PacketModSource::pullOne(Sample& sample)
 
     // Calculate next sample
     modulateSample();
-
-    // Shift to carrier frequency
     Complex ci = m_modSample;
-    ci *= m_carrierNco.nextIQ();
+    finalizeBlock(&ci, &sample, 1);
+}
 
-    // Calculate power
-    double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
-    m_movingAverage(magsq);
-    m_magsq = m_movingAverage.asDouble();
+void PacketModSource::finalizeBlock(Complex *ci, Sample *sOut, unsigned int nbSamples)
+{
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        // Shift to carrier frequency
+        ci[i] *= m_carrierNco.nextIQ();
+
+        // Calculate power
+        double magsq = ci[i].real() * ci[i].real() + ci[i].imag() * ci[i].imag();
+        m_movingAverage(magsq);
 
-    // Convert from float to fixed point
-    sample.m_real = (FixReal) (ci.real() * SDR_TX_SCALEF);
-    sample.m_imag = (FixReal) (ci.imag() * SDR_TX_SCALEF);
+        // Convert from float to fixed point
+        sOut[i].m_real = (FixReal) (ci[i].real() * SDR_TX_SCALEF);
+        sOut[i].m_imag = (FixReal) (ci[i].imag() * SDR_TX_SCALEF);
+    }
+
+    m_magsq = m_movingAverage.asDouble();
 }
 
 void PacketModSource::prefetch(unsigned int nbSamples)
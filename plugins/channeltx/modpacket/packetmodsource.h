@@ -128,6 +128,8 @@ private:
 
     std::ofstream m_audioFile;          // For debug output of baseband waveform
 
+    std::vector<Complex> m_modBuffer;   // Channel samples before carrier shift in block mode
+
     bool bitsValid();                   // Are there and bits to transmit
     int getBit();                       // Get bit from m_bits
     void addBit(int bit);               // Add bit to m_bits, with zero stuffing
@@ -135,6 +137,7 @@ private:
 
     void calculateLevel(Real& sample);
     void modulateSample();
+    void finalizeBlock(Complex *ci, Sample *sOut, unsigned int nbSamples); // Shift to carrier, measure and convert
     void sampleToSpectrum(Real sample);
 
 };
@@ -82,48 +82,67 @@ SSBModSource::~SSBModSource()
 
 void SSBModSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
 {
-    std::for_each(
-        begin,
-        begin + nbSamples,
-        [this](Sample& s) {
-            pullOne(s);
-        }
-    );
+    if (m_modBuffer.size() < nbSamples) {
+        m_modBuffer.resize(nbSamples);
+    }
+
+    modulateBlock(m_modBuffer.data(), nbSamples);
+    finalizeBlock(m_modBuffer.data(), &(*begin), nbSamples);
 }
 
 void SSBModSource::pullOne(Sample& sample)
 {
 	Complex ci;
+    modulateBlock(&ci, 1);
+    finalizeBlock(&ci, &sample, 1);
+}
 
+void SSBModSource::modulateBlock(Complex *ci, unsigned int nbSamples)
+{
     if (m_interpolatorDistance > 1.0f) // decimate
     {
-    	modulateSample();
-
-        while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        for (unsigned int i = 0; i < nbSamples; i++)
         {
-        	modulateSample();
+            modulateSample();
+
+            while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci[i]))
+            {
+                modulateSample();
+            }
+
+            m_interpolatorDistanceRemain += m_interpolatorDistance;
         }
     }
     else
     {
-        if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        for (unsigned int i = 0; i < nbSamples; i++)
         {
-        	modulateSample();
+            if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci[i]))
+            {
+                modulateSample();
+            }
+
+            m_interpolatorDistanceRemain += m_interpolatorDistance;
         }
     }
+}
 
-    m_interpolatorDistanceRemain += m_interpolatorDistance;
+void SSBModSource::finalizeBlock(Complex *ci, Sample *sOut, unsigned int nbSamples)
+{
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        ci[i] *= m_carrierNco.nextIQ(); // shift to carrier frequency
+        ci[i] *= 0.891235351562f * SDR_TX_SCALEF; //scaling at -1 dB to account for possible filter overshoot
 
-    ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
-    ci *= 0.891235351562f * SDR_TX_SCALEF; //scaling at -1 dB to account for possible filter overshoot
+        double magsq = ci[i].real() * ci[i].real() + ci[i].imag() * ci[i].imag();
+        magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
+        m_movingAverage(magsq);
 
-    double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
-	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
-	m_movingAverage(magsq);
-	m_magsq = m_movingAverage.asDouble();
+        sOut[i].m_real = (FixReal) ci[i].real();
+        sOut[i].m_imag = (FixReal) ci[i].imag();
+    }
 
-	sample.m_real = (FixReal) ci.real();
-	sample.m_imag = (FixReal) ci.imag();
+	m_magsq = m_movingAverage.asDouble();
 }
 
 void SSBModSource::prefetch(unsigned int nbSamples)
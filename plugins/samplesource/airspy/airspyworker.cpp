@@ -30,9 +30,7 @@ AirspyWorker::AirspyWorker(struct airspy_device* dev, SampleSinkFifo* sampleFifo
 	m_convertBuffer(AIRSPY_BLOCKSIZE),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(10),
-	m_log2Decim(0),
-	m_fcPos(0),
-    m_iqOrder(true)
+	m_frontEnd(DeviceFrontEnd::FormatS16, 12)
 {
 	std::fill(m_buf, m_buf + 2*AIRSPY_BLOCKSIZE, 0);
 }
@@ -81,198 +79,19 @@ void AirspyWorker::setSamplerate(uint32_t samplerate)
 
 void AirspyWorker::setLog2Decimation(unsigned int log2_decim)
 {
-	m_log2Decim = log2_decim;
+	m_frontEnd.setLog2Decim(log2_decim);
 }
 
 void AirspyWorker::setFcPos(int fcPos)
 {
-	m_fcPos = fcPos;
+	m_frontEnd.setFcPos(fcPos);
 }
 
-//  Decimate according to specified log2 (ex: log2=4 => decim=16)
-void AirspyWorker::callbackIQ(const qint16* buf, qint32 len)
+//  Convert, shift and decimate according to specified log2 (ex: log2=4 => decim=16)
+void AirspyWorker::callback(const qint16* buf, qint32 len)
 {
 	SampleVector::iterator it = m_convertBuffer.begin();
-
-	if (m_log2Decim == 0)
-	{
-		m_decimatorsIQ.decimate1(&it, buf, len);
-	}
-	else
-	{
-		if (m_fcPos == 0) // Infra
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsIQ.decimate2_inf(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsIQ.decimate4_inf(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsIQ.decimate8_inf(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsIQ.decimate16_inf(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsIQ.decimate32_inf(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsIQ.decimate64_inf(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-		else if (m_fcPos == 1) // Supra
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsIQ.decimate2_sup(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsIQ.decimate4_sup(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsIQ.decimate8_sup(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsIQ.decimate16_sup(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsIQ.decimate32_sup(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsIQ.decimate64_sup(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-		else if (m_fcPos == 2) // Center
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsIQ.decimate2_cen(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsIQ.decimate4_cen(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsIQ.decimate8_cen(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsIQ.decimate16_cen(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsIQ.decimate32_cen(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsIQ.decimate64_cen(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-	}
-
-	m_sampleFifo->write(m_convertBuffer.begin(), it);
-}
-
-void AirspyWorker::callbackQI(const qint16* buf, qint32 len)
-{
-	SampleVector::iterator it = m_convertBuffer.begin();
-
-	if (m_log2Decim == 0)
-	{
-		m_decimatorsQI.decimate1(&it, buf, len);
-	}
-	else
-	{
-		if (m_fcPos == 0) // Infra
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsQI.decimate2_inf(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsQI.decimate4_inf(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsQI.decimate8_inf(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsQI.decimate16_inf(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsQI.decimate32_inf(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsQI.decimate64_inf(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-		else if (m_fcPos == 1) // Supra
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsQI.decimate2_sup(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsQI.decimate4_sup(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsQI.decimate8_sup(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsQI.decimate16_sup(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsQI.decimate32_sup(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsQI.decimate64_sup(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-		else if (m_fcPos == 2) // Center
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsQI.decimate2_cen(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsQI.decimate4_cen(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsQI.decimate8_cen(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsQI.decimate16_cen(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsQI.decimate32_cen(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsQI.decimate64_cen(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-	}
-
+	m_frontEnd.process(buf, len, &it);
 	m_sampleFifo->write(m_convertBuffer.begin(), it);
 }
 
@@ -281,11 +100,7 @@ int AirspyWorker::rx_callback(airspy_transfer_t* transfer)
     AirspyWorker *worker = (AirspyWorker*) transfer->ctx;
 	qint32 bytes_to_write = transfer->sample_count * sizeof(qint16);
 
-    if (worker->m_iqOrder) {
-    	worker->callbackIQ((qint16 *) transfer->samples, bytes_to_write);
-    } else {
-        worker->callbackQI((qint16 *) transfer->samples, bytes_to_write);
-    }
+    worker->callback((qint16 *) transfer->samples, bytes_to_write);
 
     return 0;
 }
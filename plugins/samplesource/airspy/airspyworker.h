@@ -22,7 +22,7 @@
 #include <libairspy/airspy.h>
 
 #include "dsp/samplesinkfifo.h"
-#include "dsp/decimators.h"
+#include "dsp/devicefrontend.h"
 
 #define AIRSPY_BLOCKSIZE (1<<17)
 
@@ -38,7 +38,7 @@ public:
 	void setSamplerate(uint32_t samplerate);
 	void setLog2Decimation(unsigned int log2_decim);
 	void setFcPos(int fcPos);
-    void setIQOrder(bool iqOrder) { m_iqOrder = iqOrder; }
+    void setIQOrder(bool iqOrder) { m_frontEnd.setIQOrder(iqOrder); }
 
 private:
 	bool m_running;
@@ -49,15 +49,9 @@ private:
 	SampleSinkFifo* m_sampleFifo;
 
 	int m_samplerate;
-	unsigned int m_log2Decim;
-	int m_fcPos;
-    bool m_iqOrder;
+	DeviceFrontEnd m_frontEnd;
 
-	Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12, true> m_decimatorsIQ;
-	Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12, false> m_decimatorsQI;
-
-	void callbackIQ(const qint16* buf, qint32 len);
-	void callbackQI(const qint16* buf, qint32 len);
+	void callback(const qint16* buf, qint32 len);
 	static int rx_callback(airspy_transfer_t* transfer);
 };
 
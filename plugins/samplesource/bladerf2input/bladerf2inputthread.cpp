@@ -23,8 +23,7 @@ BladeRF2InputThread::BladeRF2InputThread(struct bladerf* dev, unsigned int nbRxC
     QThread(parent),
     m_running(false),
     m_dev(dev),
-    m_nbChannels(nbRxChannels),
-    m_iqOrder(true)
+    m_nbChannels(nbRxChannels)
 {
     qDebug("BladeRF2InputThread::BladeRF2InputThread");
     m_channels = new Channel[nbRxChannels];
@@ -112,11 +111,7 @@ void BladeRF2InputThread::run()
                 }
                 else
                 {
-                    if (m_iqOrder) {
-                        callbackSIIQ(m_buf, 2*DeviceBladeRF2::blockSize);
-                    } else {
-                        callbackSIQI(m_buf, 2*DeviceBladeRF2::blockSize);
-                    }
+                    callbackSI(m_buf, 2*DeviceBladeRF2::blockSize);
                 }
             }
             qDebug("BladeRF2InputThread::run: stop running loop");
@@ -148,14 +143,14 @@ unsigned int BladeRF2InputThread::getNbFifos()
 void BladeRF2InputThread::setLog2Decimation(unsigned int channel, unsigned int log2_decim)
 {
     if (channel < m_nbChannels) {
-        m_channels[channel].m_log2Decim = log2_decim;
+        m_channels[channel].m_frontEnd.setLog2Decim(log2_decim);
     }
 }
 
 unsigned int BladeRF2InputThread::getLog2Decimation(unsigned int channel) const
 {
     if (channel < m_nbChannels) {
-        return m_channels[channel].m_log2Decim;
+        return m_channels[channel].m_frontEnd.getLog2Decim();
     } else {
         return 0;
     }
@@ -164,19 +159,26 @@ unsigned int BladeRF2InputThread::getLog2Decimation(unsigned int channel) const
 void BladeRF2InputThread::setFcPos(unsigned int channel, int fcPos)
 {
     if (channel < m_nbChannels) {
-        m_channels[channel].m_fcPos = fcPos;
+        m_channels[channel].m_frontEnd.setFcPos(fcPos);
     }
 }
 
 int BladeRF2InputThread::getFcPos(unsigned int channel) const
 {
     if (channel < m_nbChannels) {
-        return m_channels[channel].m_fcPos;
+        return m_channels[channel].m_frontEnd.getFcPos();
     } else {
         return 0;
     }
 }
 
+void BladeRF2InputThread::setIQOrder(bool iqOrder)
+{
+    for (unsigned int i = 0; i < m_nbChannels; i++) {
+        m_channels[i].m_frontEnd.setIQOrder(iqOrder);
+    }
+}
+
 void BladeRF2InputThread::setFifo(unsigned int channel, SampleSinkFifo *sampleFifo)
 {
     if (channel < m_nbChannels) {
@@ -208,197 +210,15 @@ void BladeRF2InputThread::callbackMI(const qint16* buf, qint32 samplesPerChannel
     {
         if (m_channels[channel].m_sampleFifo)
         {
-            if (m_iqOrder) {
-                callbackSIIQ(&buf[2*samplesPerChannel*channel], 2*samplesPerChannel, channel);
-            } else {
-                callbackSIQI(&buf[2*samplesPerChannel*channel], 2*samplesPerChannel, channel);
-            }
-        }
-    }
-}
-
-void BladeRF2InputThread::callbackSIIQ(const qint16* buf, qint32 len, unsigned int channel)
-{
-    SampleVector::iterator it = m_channels[channel].m_convertBuffer.begin();
-
-    if (m_channels[channel].m_log2Decim == 0)
-    {
-        m_channels[channel].m_decimatorsIQ.decimate1(&it, buf, len);
-    }
-    else
-    {
-        if (m_channels[channel].m_fcPos == 0) // Infra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimatorsIQ.decimate2_inf(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimatorsIQ.decimate4_inf(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimatorsIQ.decimate8_inf(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimatorsIQ.decimate16_inf(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimatorsIQ.decimate32_inf(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimatorsIQ.decimate64_inf(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 1) // Supra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimatorsIQ.decimate2_sup(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimatorsIQ.decimate4_sup(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimatorsIQ.decimate8_sup(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimatorsIQ.decimate16_sup(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimatorsIQ.decimate32_sup(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimatorsIQ.decimate64_sup(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 2) // Center
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimatorsIQ.decimate2_cen(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimatorsIQ.decimate4_cen(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimatorsIQ.decimate8_cen(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimatorsIQ.decimate16_cen(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimatorsIQ.decimate32_cen(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimatorsIQ.decimate64_cen(&it, buf, len);
-                break;
-            default:
-                break;
-            }
+            callbackSI(&buf[2*samplesPerChannel*channel], 2*samplesPerChannel, channel);
         }
     }
-
-    m_channels[channel].m_sampleFifo->write(m_channels[channel].m_convertBuffer.begin(), it);
 }
 
-void BladeRF2InputThread::callbackSIQI(const qint16* buf, qint32 len, unsigned int channel)
+//  Convert, shift and decimate according to specified log2 (ex: log2=4 => decim=16)
+void BladeRF2InputThread::callbackSI(const qint16* buf, qint32 len, unsigned int channel)
 {
     SampleVector::iterator it = m_channels[channel].m_convertBuffer.begin();
-
-    if (m_channels[channel].m_log2Decim == 0)
-    {
-        m_channels[channel].m_decimatorsQI.decimate1(&it, buf, len);
-    }
-    else
-    {
-        if (m_channels[channel].m_fcPos == 0) // Infra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimatorsQI.decimate2_inf(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimatorsQI.decimate4_inf(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimatorsQI.decimate8_inf(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimatorsQI.decimate16_inf(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimatorsQI.decimate32_inf(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimatorsQI.decimate64_inf(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 1) // Supra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimatorsQI.decimate2_sup(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimatorsQI.decimate4_sup(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimatorsQI.decimate8_sup(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimatorsQI.decimate16_sup(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimatorsQI.decimate32_sup(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimatorsQI.decimate64_sup(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 2) // Center
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimatorsQI.decimate2_cen(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimatorsQI.decimate4_cen(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimatorsQI.decimate8_cen(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimatorsQI.decimate16_cen(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimatorsQI.decimate32_cen(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimatorsQI.decimate64_cen(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-    }
-
+    m_channels[channel].m_frontEnd.process(buf, len, &it);
     m_channels[channel].m_sampleFifo->write(m_channels[channel].m_convertBuffer.begin(), it);
 }
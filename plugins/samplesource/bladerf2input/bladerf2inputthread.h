@@ -30,7 +30,7 @@
 #include <libbladeRF.h>
 
 #include "bladerf2/devicebladerf2shared.h"
-#include "dsp/decimators.h"
+#include "dsp/devicefrontend.h"
 
 class SampleSinkFifo;
 
@@ -51,22 +51,18 @@ public:
     int getFcPos(unsigned int channel) const;
     void setFifo(unsigned int channel, SampleSinkFifo *sampleFifo);
     SampleSinkFifo *getFifo(unsigned int channel);
-    void setIQOrder(bool iqOrder) { m_iqOrder = iqOrder; }
+    void setIQOrder(bool iqOrder);
 
 private:
     struct Channel
     {
         SampleVector m_convertBuffer;
         SampleSinkFifo* m_sampleFifo;
-        unsigned int m_log2Decim;
-        int m_fcPos;
-        Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12, true> m_decimatorsIQ;
-        Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12, false> m_decimatorsQI;
+        DeviceFrontEnd m_frontEnd;
 
         Channel() :
             m_sampleFifo(0),
-            m_log2Decim(0),
-            m_fcPos(0)
+            m_frontEnd(DeviceFrontEnd::FormatS16, 12)
         {}
 
         ~Channel()
@@ -81,12 +77,10 @@ private:
     Channel *m_channels; //!< Array of channels dynamically allocated for the given number of Rx channels
     qint16 *m_buf; //!< Full buffer for SISO or MIMO operation
     unsigned int m_nbChannels;
-    bool m_iqOrder;
 
     void run();
     unsigned int getNbFifos();
-    void callbackSIIQ(const qint16* buf, qint32 len, unsigned int channel = 0);
-    void callbackSIQI(const qint16* buf, qint32 len, unsigned int channel = 0);
+    void callbackSI(const qint16* buf, qint32 len, unsigned int channel = 0);
     void callbackMI(const qint16* buf, qint32 samplesPerChannel);
 };
 
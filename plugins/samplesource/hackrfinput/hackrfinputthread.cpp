@@ -30,9 +30,7 @@ HackRFInputThread::HackRFInputThread(hackrf_device* dev, SampleSinkFifo* sampleF
 	m_convertBuffer(HACKRF_BLOCKSIZE),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(10),
-	m_log2Decim(0),
-	m_fcPos(0),
-    m_iqOrder(true)
+	m_frontEnd(DeviceFrontEnd::FormatS8, 8)
 {
     std::fill(m_buf, m_buf + 2*HACKRF_BLOCKSIZE, 0);
 }
@@ -65,12 +63,12 @@ void HackRFInputThread::setSamplerate(uint32_t samplerate)
 
 void HackRFInputThread::setLog2Decimation(unsigned int log2_decim)
 {
-	m_log2Decim = log2_decim;
+	m_frontEnd.setLog2Decim(log2_decim);
 }
 
 void HackRFInputThread::setFcPos(int fcPos)
 {
-	m_fcPos = fcPos;
+	m_frontEnd.setFcPos(fcPos);
 }
 
 void HackRFInputThread::run()
@@ -122,190 +120,11 @@ void HackRFInputThread::run()
 	m_running = false;
 }
 
-//  Decimate according to specified log2 (ex: log2=4 => decim=16)
-void HackRFInputThread::callbackIQ(const qint8* buf, qint32 len)
+//  Convert, shift and decimate according to specified log2 (ex: log2=4 => decim=16)
+void HackRFInputThread::callback(const qint8* buf, qint32 len)
 {
 	SampleVector::iterator it = m_convertBuffer.begin();
-
-	if (m_log2Decim == 0)
-	{
-		m_decimatorsIQ.decimate1(&it, buf, len);
-	}
-	else
-	{
-		if (m_fcPos == 0) // Infra
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsIQ.decimate2_inf(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsIQ.decimate4_inf_txsync(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsIQ.decimate8_inf_txsync(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsIQ.decimate16_inf_txsync(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsIQ.decimate32_inf_txsync(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsIQ.decimate64_inf_txsync(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-		else if (m_fcPos == 1) // Supra
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsIQ.decimate2_sup(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsIQ.decimate4_sup_txsync(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsIQ.decimate8_sup_txsync(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsIQ.decimate16_sup_txsync(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsIQ.decimate32_sup_txsync(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsIQ.decimate64_sup_txsync(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-		else if (m_fcPos == 2) // Center
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsIQ.decimate2_cen(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsIQ.decimate4_cen(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsIQ.decimate8_cen(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsIQ.decimate16_cen(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsIQ.decimate32_cen(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsIQ.decimate64_cen(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-	}
-
-	m_sampleFifo->write(m_convertBuffer.begin(), it);
-}
-
-void HackRFInputThread::callbackQI(const qint8* buf, qint32 len)
-{
-	SampleVector::iterator it = m_convertBuffer.begin();
-
-	if (m_log2Decim == 0)
-	{
-		m_decimatorsQI.decimate1(&it, buf, len);
-	}
-	else
-	{
-		if (m_fcPos == 0) // Infra
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsQI.decimate2_inf(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsQI.decimate4_inf_txsync(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsQI.decimate8_inf_txsync(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsQI.decimate16_inf_txsync(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsQI.decimate32_inf_txsync(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsQI.decimate64_inf_txsync(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-		else if (m_fcPos == 1) // Supra
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsQI.decimate2_sup(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsQI.decimate4_sup_txsync(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsQI.decimate8_sup_txsync(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsQI.decimate16_sup_txsync(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsQI.decimate32_sup_txsync(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsQI.decimate64_sup_txsync(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-		else if (m_fcPos == 2) // Center
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsQI.decimate2_cen(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsQI.decimate4_cen(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsQI.decimate8_cen(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsQI.decimate16_cen(&it, buf, len);
-				break;
-			case 5:
-				m_decimatorsQI.decimate32_cen(&it, buf, len);
-				break;
-			case 6:
-				m_decimatorsQI.decimate64_cen(&it, buf, len);
-				break;
-			default:
-				break;
-			}
-		}
-	}
-
+	m_frontEnd.process(buf, len, &it);
 	m_sampleFifo->write(m_convertBuffer.begin(), it);
 }
 
@@ -314,11 +133,7 @@ int HackRFInputThread::rx_callback(hackrf_transfer* transfer)
     HackRFInputThread *thread = (HackRFInputThread *) transfer->rx_ctx;
 	qint32 bytes_to_write = transfer->valid_length;
 
-    if (thread->m_iqOrder) {
-    	thread->callbackIQ((qint8 *) transfer->buffer, bytes_to_write);
-    } else {
-        thread->callbackQI((qint8 *) transfer->buffer, bytes_to_write);
-    }
+    thread->callback((qint8 *) transfer->buffer, bytes_to_write);
 
     return 0;
 }
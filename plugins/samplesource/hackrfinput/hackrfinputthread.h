@@ -24,7 +24,7 @@
 #include <libhackrf/hackrf.h>
 
 #include "dsp/samplesinkfifo.h"
-#include "dsp/decimators.h"
+#include "dsp/devicefrontend.h"
 
 #define HACKRF_BLOCKSIZE (1<<17)
 
@@ -40,7 +40,7 @@ public:
 	void setSamplerate(uint32_t samplerate);
 	void setLog2Decimation(unsigned int log2_decim);
 	void setFcPos(int fcPos);
-    void setIQOrder(bool iqOrder) { m_iqOrder = iqOrder; }
+    void setIQOrder(bool iqOrder) { m_frontEnd.setIQOrder(iqOrder); }
 
 private:
 	QMutex m_startWaitMutex;
@@ -53,16 +53,10 @@ private:
 	SampleSinkFifo* m_sampleFifo;
 
 	int m_samplerate;
-	unsigned int m_log2Decim;
-	int m_fcPos;
-    bool m_iqOrder;
-
-	Decimators<qint32, qint8, SDR_RX_SAMP_SZ, 8, true> m_decimatorsIQ;
-	Decimators<qint32, qint8, SDR_RX_SAMP_SZ, 8, false> m_decimatorsQI;
+	DeviceFrontEnd m_frontEnd;
 
 	void run();
-	void callbackIQ(const qint8* buf, qint32 len);
-	void callbackQI(const qint8* buf, qint32 len);
+	void callback(const qint8* buf, qint32 len);
 	static int rx_callback(hackrf_transfer* transfer);
 };
 
@@ -18,6 +18,7 @@
 
 #include <stdio.h>
 #include <errno.h>
+#include <string.h>
 #include "rtlsdrthread.h"
 
 #include "dsp/samplesinkfifo.h"
@@ -31,10 +32,10 @@ RTLSDRThread::RTLSDRThread(rtlsdr_dev_t* dev, SampleSinkFifo* sampleFifo, QObjec
 	m_convertBuffer(FCD_BLOCKSIZE),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(288000),
-	m_log2Decim(4),
-	m_fcPos(0),
-    m_iqOrder(true)
+	m_frontEnd(DeviceFrontEnd::FormatU8, 8, 127)
 {
+	m_frontEnd.setLog2Decim(4);
+	m_frontEnd.setFcPos(0);
 }
 
 RTLSDRThread::~RTLSDRThread()
@@ -64,12 +65,12 @@ void RTLSDRThread::setSamplerate(int samplerate)
 
 void RTLSDRThread::setLog2Decimation(unsigned int log2_decim)
 {
-	m_log2Decim = log2_decim;
+	m_frontEnd.setLog2Decim(log2_decim);
 }
 
 void RTLSDRThread::setFcPos(int fcPos)
 {
-	m_fcPos = fcPos;
+	m_frontEnd.setFcPos(fcPos);
 }
 
 void RTLSDRThread::run()
@@ -89,193 +90,11 @@ void RTLSDRThread::run()
 	m_running = false;
 }
 
-//  Decimate according to specified log2 (ex: log2=4 => decim=16)
-void RTLSDRThread::callbackIQ(const quint8* buf, qint32 len)
+//  Convert, shift and decimate according to specified log2 (ex: log2=4 => decim=16)
+void RTLSDRThread::callback(const quint8* buf, qint32 len)
 {
 	SampleVector::iterator it = m_convertBuffer.begin();
-
-	if (m_log2Decim == 0)
-	{
-		m_decimatorsIQ.decimate1(&it, buf, len);
-	}
-	else
-	{
-		if (m_fcPos == 0) // Infradyne
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsIQ.decimate2_inf(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsIQ.decimate4_inf(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsIQ.decimate8_inf(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsIQ.decimate16_inf(&it, buf, len);
-				break;
-            case 5:
-                m_decimatorsIQ.decimate32_inf(&it, buf, len);
-                break;
-            case 6:
-                m_decimatorsIQ.decimate64_inf(&it, buf, len);
-                break;
-			default:
-				break;
-			}
-		}
-		else if (m_fcPos == 1) // Supradyne
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsIQ.decimate2_sup(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsIQ.decimate4_sup(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsIQ.decimate8_sup(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsIQ.decimate16_sup(&it, buf, len);
-				break;
-            case 5:
-                m_decimatorsIQ.decimate32_sup(&it, buf, len);
-                break;
-            case 6:
-                m_decimatorsIQ.decimate64_sup(&it, buf, len);
-                break;
-			default:
-				break;
-			}
-		}
-		else // Centered
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsIQ.decimate2_cen(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsIQ.decimate4_cen(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsIQ.decimate8_cen(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsIQ.decimate16_cen(&it, buf, len);
-				break;
-            case 5:
-                m_decimatorsIQ.decimate32_cen(&it, buf, len);
-                break;
-            case 6:
-                m_decimatorsIQ.decimate64_cen(&it, buf, len);
-                break;
-			default:
-				break;
-			}
-		}
-	}
-
-	m_sampleFifo->write(m_convertBuffer.begin(), it);
-
-	if(!m_running)
-		rtlsdr_cancel_async(m_dev);
-}
-
-void RTLSDRThread::callbackQI(const quint8* buf, qint32 len)
-{
-	SampleVector::iterator it = m_convertBuffer.begin();
-
-	if (m_log2Decim == 0)
-	{
-		m_decimatorsQI.decimate1(&it, buf, len);
-	}
-	else
-	{
-		if (m_fcPos == 0) // Infradyne
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsQI.decimate2_inf(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsQI.decimate4_inf(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsQI.decimate8_inf(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsQI.decimate16_inf(&it, buf, len);
-				break;
-            case 5:
-                m_decimatorsQI.decimate32_inf(&it, buf, len);
-                break;
-            case 6:
-                m_decimatorsQI.decimate64_inf(&it, buf, len);
-                break;
-			default:
-				break;
-			}
-		}
-		else if (m_fcPos == 1) // Supradyne
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsQI.decimate2_sup(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsQI.decimate4_sup(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsQI.decimate8_sup(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsQI.decimate16_sup(&it, buf, len);
-				break;
-            case 5:
-                m_decimatorsQI.decimate32_sup(&it, buf, len);
-                break;
-            case 6:
-                m_decimatorsQI.decimate64_sup(&it, buf, len);
-                break;
-			default:
-				break;
-			}
-		}
-		else // Centered
-		{
-			switch (m_log2Decim)
-			{
-			case 1:
-				m_decimatorsQI.decimate2_cen(&it, buf, len);
-				break;
-			case 2:
-				m_decimatorsQI.decimate4_cen(&it, buf, len);
-				break;
-			case 3:
-				m_decimatorsQI.decimate8_cen(&it, buf, len);
-				break;
-			case 4:
-				m_decimatorsQI.decimate16_cen(&it, buf, len);
-				break;
-            case 5:
-                m_decimatorsQI.decimate32_cen(&it, buf, len);
-                break;
-            case 6:
-                m_decimatorsQI.decimate64_cen(&it, buf, len);
-                break;
-			default:
-				break;
-			}
-		}
-	}
-
+	m_frontEnd.process(buf, len, &it);
 	m_sampleFifo->write(m_convertBuffer.begin(), it);
 
 	if(!m_running)
@@ -285,11 +104,6 @@ void RTLSDRThread::callbackQI(const quint8* buf, qint32 len)
 void RTLSDRThread::callbackHelper(unsigned char* buf, uint32_t len, void* ctx)
 {
 	RTLSDRThread* thread = (RTLSDRThread*) ctx;
-
-    if (thread->m_iqOrder) {
-    	thread->callbackIQ(buf, len);
-    } else {
-        thread->callbackQI(buf, len);
-    }
+	thread->callback(buf, len);
 }
 
@@ -25,7 +25,7 @@
 #include <rtl-sdr.h>
 
 #include "dsp/samplesinkfifo.h"
-#include "dsp/decimatorsu.h"
+#include "dsp/devicefrontend.h"
 
 class RTLSDRThread : public QThread {
 	Q_OBJECT
@@ -39,7 +39,7 @@ public:
 	void setSamplerate(int samplerate);
 	void setLog2Decimation(unsigned int log2_decim);
 	void setFcPos(int fcPos);
-    void setIQOrder(bool iqOrder) { m_iqOrder = iqOrder; }
+    void setIQOrder(bool iqOrder) { m_frontEnd.setIQOrder(iqOrder); }
 
 private:
 	QMutex m_startWaitMutex;
@@ -51,16 +51,10 @@ private:
 	SampleSinkFifo* m_sampleFifo;
 
 	int m_samplerate;
-	unsigned int m_log2Decim;
-	int m_fcPos;
-    bool m_iqOrder;
-
-	DecimatorsU<qint32, quint8, SDR_RX_SAMP_SZ, 8, 127, true> m_decimatorsIQ;
-	DecimatorsU<qint32, quint8, SDR_RX_SAMP_SZ, 8, 127, false> m_decimatorsQI;
+	DeviceFrontEnd m_frontEnd;
 
 	void run();
-	void callbackIQ(const quint8* buf, qint32 len);
-	void callbackQI(const quint8* buf, qint32 len);
+	void callback(const quint8* buf, qint32 len);
 
 	static void callbackHelper(unsigned char* buf, uint32_t len, void* ctx);
 };
@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SHMINPUT_H
+#define INCLUDE_SHMINPUT_H
+
+#include <stdint.h>
+
+#include <QString>
+#include <QByteArray>
+#include <QMutex>
+#include <QNetworkRequest>
+
+#include "dsp/devicesamplesource.h"
+
+#include "shminputsettings.h"
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class DeviceAPI;
+class ShmInputWorker;
+
+class ShmInput : public DeviceSampleSource {
+    Q_OBJECT
+public:
+    class MsgConfigureShmInput : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        const ShmInputSettings& getSettings() const { return m_settings; }
+        bool getForce() const { return m_force; }
+
+        static MsgConfigureShmInput* create(const ShmInputSettings& settings, bool force = false)
+        {
+            return new MsgConfigureShmInput(settings, force);
+        }
+
+    private:
+        ShmInputSettings m_settings;
+        bool m_force;
+
+        MsgConfigureShmInput(const ShmInputSettings& settings, bool force) :
+            Message(),
+            m_settings(settings),
+            m_force(force)
+        { }
+    };
+
+    class MsgStartStop : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        bool getStartStop() const { return m_startStop; }
+
+        static MsgStartStop* create(bool startStop) {
+            return new MsgStartStop(startStop);
+        }
+
+    protected:
+        bool m_startStop;
+
+        MsgStartStop(bool startStop) :
+            Message(),
+            m_startStop(startStop)
+        { }
+    };
+
+    class MsgReportSampleRateAndFrequency : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        int getSampleRate() const { return m_sampleRate; }
+        int getCenterFrequency() const { return m_centerFrequency; }
+
+        static MsgReportSampleRateAndFrequency* create(int sampleRate, qint64 centerFrequency) {
+            return new MsgReportSampleRateAndFrequency(sampleRate, centerFrequency);
+        }
+
+    protected:
+        int m_sampleRate;
+        qint64 m_centerFrequency;
+
+        MsgReportSampleRateAndFrequency(int sampleRate, qint64 centerFrequency) :
+            Message(),
+            m_sampleRate(sampleRate),
+            m_centerFrequency(centerFrequency)
+        { }
+    };
+
+	ShmInput(DeviceAPI *deviceAPI);
+	virtual ~ShmInput();
+	virtual void destroy();
+
+    virtual void init();
+	virtual bool start();
+	virtual void stop();
+
+    virtual QByteArray serialize() const;
+    virtual bool deserialize(const QByteArray& data);
+
+    virtual void setMessageQueueToGUI(MessageQueue *queue);
+	virtual const QString& getDeviceDescription() const;
+	virtual int getSampleRate() const;
+    virtual void setSampleRate(int sampleRate);
+	virtual quint64 getCenterFrequency() const;
+    virtual void setCenterFrequency(qint64 centerFrequency);
+
+	virtual bool handleMessage(const Message& message);
+
+    virtual int webapiSettingsGet(
+                SWGSDRangel::SWGDeviceSettings& response,
+                QString& errorMessage);
+
+    virtual int webapiSettingsPutPatch(
+                bool force,
+                const QStringList& deviceSettingsKeys,
+                SWGSDRangel::SWGDeviceSettings& response, // query + response
+                QString& errorMessage);
+
+    virtual int webapiReportGet(
+            SWGSDRangel::SWGDeviceReport& response,
+            QString& errorMessage);
+
+    virtual int webapiRunGet(
+            SWGSDRangel::SWGDeviceState& response,
+            QString& errorMessage);
+
+    virtual int webapiRun(
+            bool run,
+            SWGSDRangel::SWGDeviceState& response,
+            QString& errorMessage);
+
+    static void webapiFormatDeviceSettings(
+            SWGSDRangel::SWGDeviceSettings& response,
+            const ShmInputSettings& settings);
+
+    static void webapiUpdateDeviceSettings(
+            ShmInputSettings& settings,
+            const QStringList& deviceSettingsKeys,
+            SWGSDRangel::SWGDeviceSettings& response);
+
+    bool isConnected() const;
+    float getLatencyMs() const;     //!< Age of the last block received from the ring
+    quint64 getDroppedCount() const; //!< Samples dropped by the writer because this side was late
+
+private:
+	DeviceAPI *m_deviceAPI;
+	QMutex m_mutex;
+	ShmInputSettings m_settings;
+    ShmInputWorker *m_worker;
+    bool m_running;
+    qint64 m_centerFrequency;
+    int m_sampleRate;
+	QString m_deviceDescription;
+    QNetworkAccessManager *m_networkManager;
+    QNetworkRequest m_networkRequest;
+
+    void applySettings(const ShmInputSettings& settings, bool force = false);
+    void webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& response);
+    void webapiReverseSendSettings(QList<QString>& deviceSettingsKeys, const ShmInputSettings& settings, bool force);
+    void webapiReverseSendStartStop(bool start);
+
+private slots:
+    void networkManagerFinished(QNetworkReply *reply);
+};
+
+#endif // INCLUDE_SHMINPUT_H
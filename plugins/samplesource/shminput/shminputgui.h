@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SHMINPUTGUI_H
+#define INCLUDE_SHMINPUTGUI_H
+
+#include <QTimer>
+#include <QWidget>
+
+#include "plugin/plugininstancegui.h"
+#include "util/messagequeue.h"
+
+#include "shminput.h"
+
+class DeviceUISet;
+
+namespace Ui {
+	class ShmInputGui;
+}
+
+class ShmInputGui : public QWidget, public PluginInstanceGUI {
+	Q_OBJECT
+
+public:
+	explicit ShmInputGui(DeviceUISet *deviceUISet, QWidget* parent = 0);
+	virtual ~ShmInputGui();
+	virtual void destroy();
+
+	void setName(const QString& name);
+	QString getName() const;
+
+	void resetToDefaults();
+	QByteArray serialize() const;
+	bool deserialize(const QByteArray& data);
+	virtual qint64 getCenterFrequency() const;
+	virtual void setCenterFrequency(qint64 centerFrequency);
+	virtual MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
+	virtual bool handleMessage(const Message& message);
+
+private:
+	Ui::ShmInputGui* ui;
+
+	DeviceUISet* m_deviceUISet;
+    ShmInputSettings m_settings;     //!< current settings
+	ShmInput* m_sampleSource;
+    int m_streamSampleRate;          //!< Sample rate of received stream
+    quint64 m_streamCenterFrequency; //!< Center frequency of received stream
+	QTimer m_updateTimer;
+	QTimer m_statusTimer;
+    int m_lastEngineState;
+    MessageQueue m_inputMessageQueue;
+	bool m_doApplySettings;
+    bool m_forceSettings;
+
+    QPalette m_paletteGreenText;
+    QPalette m_paletteWhiteText;
+
+    void blockApplySettings(bool block);
+	void displaySettings();
+    void sendSettings();
+	void updateSampleRateAndFrequency();
+
+private slots:
+    void handleInputMessages();
+    void on_shmName_editingFinished();
+	void on_dcOffset_toggled(bool checked);
+	void on_iqImbalance_toggled(bool checked);
+	void on_startStop_toggled(bool checked);
+    void updateHardware();
+	void updateStatus();
+    void openDeviceSettingsDialog(const QPoint& p);
+};
+
+#endif // INCLUDE_SHMINPUTGUI_H
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "util/simpleserializer.h"
+#include "shminputsettings.h"
+
+ShmInputSettings::ShmInputSettings()
+{
+    resetToDefaults();
+}
+
+void ShmInputSettings::resetToDefaults()
+{
+    m_shmName = "sdrangel_iq";
+    m_dcBlock = false;
+    m_iqCorrection = false;
+    m_useReverseAPI = false;
+    m_reverseAPIAddress = "127.0.0.1";
+    m_reverseAPIPort = 8888;
+    m_reverseAPIDeviceIndex = 0;
+}
+
+QByteArray ShmInputSettings::serialize() const
+{
+    SimpleSerializer s(1);
+
+    s.writeBool(1, m_dcBlock);
+    s.writeBool(2, m_iqCorrection);
+    s.writeBool(3, m_useReverseAPI);
+    s.writeString(4, m_reverseAPIAddress);
+    s.writeU32(5, m_reverseAPIPort);
+    s.writeU32(6, m_reverseAPIDeviceIndex);
+    s.writeString(7, m_shmName);
+
+    return s.final();
+}
+
+bool ShmInputSettings::deserialize(const QByteArray& data)
+{
+    SimpleDeserializer d(data);
+
+    if (!d.isValid())
+    {
+        resetToDefaults();
+        return false;
+    }
+
+    if (d.getVersion() == 1)
+    {
+        quint32 uintval;
+
+        d.readBool(1, &m_dcBlock, false);
+        d.readBool(2, &m_iqCorrection, false);
+        d.readBool(3, &m_useReverseAPI, false);
+        d.readString(4, &m_reverseAPIAddress, "127.0.0.1");
+        d.readU32(5, &uintval, 0);
+
+        if ((uintval > 1023) && (uintval < 65535)) {
+            m_reverseAPIPort = uintval;
+        } else {
+            m_reverseAPIPort = 8888;
+        }
+
+        d.readU32(6, &uintval, 0);
+        m_reverseAPIDeviceIndex = uintval > 99 ? 99 : uintval;
+        d.readString(7, &m_shmName, "sdrangel_iq");
+        return true;
+    }
+    else
+    {
+        resetToDefaults();
+        return false;
+    }
+}
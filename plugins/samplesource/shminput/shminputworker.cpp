@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dsp/samplesinkfifo.h"
+#include "util/messagequeue.h"
+#include "util/timeutil.h"
+
+#include "shminputworker.h"
+
+MESSAGE_CLASS_DEFINITION(ShmInputWorker::MsgReportStream, Message)
+
+ShmInputWorker::ShmInputWorker(SampleSinkFifo* sampleFifo, MessageQueue *outputMessageQueue, QObject* parent) :
+    QThread(parent),
+    m_running(false),
+    m_connected(false),
+    m_latencyMs(0.0f),
+    m_droppedCount(0),
+    m_sampleFifo(sampleFifo),
+    m_outputMessageQueue(outputMessageQueue),
+    m_nameChanged(false),
+    m_sampleRate(0),
+    m_centerFrequency(0)
+{
+}
+
+ShmInputWorker::~ShmInputWorker()
+{
+    stopWork();
+}
+
+void ShmInputWorker::setShmName(const QString& shmName)
+{
+    QMutexLocker mutexLocker(&m_nameMutex);
+
+    if (shmName != m_shmName)
+    {
+        m_shmName = shmName;
+        m_nameChanged = true;
+    }
+}
+
+void ShmInputWorker::startWork()
+{
+    m_startWaitMutex.lock();
+    start();
+
+    while (!m_running) {
+        m_startWaiter.wait(&m_startWaitMutex, 100);
+    }
+
+    m_startWaitMutex.unlock();
+}
+
+void ShmInputWorker::stopWork()
+{
+    m_running = false;
+    wait();
+}
+
+bool ShmInputWorker::attach()
+{
+    QString shmName;
+
+    {
+        QMutexLocker mutexLocker(&m_nameMutex);
+        shmName = m_shmName;
+        m_nameChanged = false;
+    }
+
+    if (!m_ring.attach(shmName)) {
+        return false;
+    }
+
+    qDebug("ShmInputWorker::attach: attached to %s capacity: %u", qPrintable(shmName), m_ring.getCapacity());
+    m_sampleRate = 0; // force stream report on first block
+    m_centerFrequency = 0;
+    m_connected = true;
+    return true;
+}
+
+void ShmInputWorker::run()
+{
+    m_running = true;
+    m_startWaiter.wakeAll();
+
+    while (m_running)
+    {
+        if (m_nameChanged || (m_ring.isOpen() && !m_ring.isWriterAlive()))
+        {
+            if (m_ring.isOpen()) {
+                qDebug("ShmInputWorker::run: detach from %s", qPrintable(m_ring.getName()));
+            }
+
+            m_ring.close();
+            m_connected = false;
+        }
+
+        if (!m_ring.isOpen())
+        {
+            if (!attach())
+            {
+                // the sink is not there yet: retry later while staying responsive to stop
+                for (int i = 0; m_running && (i < m_attachRetryMs / m_waitTimeoutMs); i++) {
+                    msleep(m_waitTimeoutMs);
+                }
+            }
+
+            continue;
+        }
+
+        if (!m_ring.wait(m_waitTimeoutMs)) {
+            continue;
+        }
+
+        ShmIQRing::BlockInfo info;
+        const Sample *part1, *part2;
+        unsigned int size1, size2;
+
+        while (m_running && m_ring.readBegin(info, &part1, size1, &part2, size2))
+        {
+            if ((info.m_sampleRate != (quint32) m_sampleRate) || (info.m_centerFrequency != m_centerFrequency))
+            {
+                m_sampleRate = info.m_sampleRate;
+                m_centerFrequency = info.m_centerFrequency;
+                qDebug("ShmInputWorker::run: stream: sample rate: %d center frequency: %llu", m_sampleRate, m_centerFrequency);
+
+                if (m_outputMessageQueue) {
+                    m_outputMessageQueue->push(MsgReportStream::create(m_sampleRate, m_centerFrequency));
+                }
+            }
+
+            writeToSampleFifo(part1, size1);
+
+            if (size2 > 0) {
+                writeToSampleFifo(part2, size2);
+            }
+
+            m_ring.readCommit();
+            m_latencyMs = (TimeUtil::nowus() - info.m_timestampUs) / 1000.0f;
+            m_droppedCount = m_ring.getDroppedCount();
+        }
+    }
+
+    m_ring.close();
+    m_connected = false;
+    m_running = false;
+}
+
+void ShmInputWorker::writeToSampleFifo(const Sample *samples, unsigned int nbSamples)
+{
+    // back-pressure: the ring absorbs the wait and the writer drops if it really overflows
+    while (m_running && (nbSamples <= m_sampleFifo->size()) && (m_sampleFifo->size() - m_sampleFifo->fill() < nbSamples)) {
+        usleep(1000);
+    }
+
+    m_sampleFifo->write((const quint8*) samples, nbSamples*sizeof(Sample));
+}
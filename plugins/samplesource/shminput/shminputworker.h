@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_SAMPLESOURCE_SHMINPUT_SHMINPUTWORKER_H_
+#define PLUGINS_SAMPLESOURCE_SHMINPUT_SHMINPUTWORKER_H_
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QString>
+
+#include "util/message.h"
+#include "util/shmiqring.h"
+
+class SampleSinkFifo;
+class MessageQueue;
+
+/**
+ * Reads the shared memory ring written by a Shared Memory Sink in another instance and
+ * pushes the samples to the device FIFO. The worker keeps trying to attach to the segment
+ * so that either side can be started first and the sink side can be restarted at will.
+ */
+class ShmInputWorker : public QThread {
+    Q_OBJECT
+
+public:
+    class MsgReportStream : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        int getSampleRate() const { return m_sampleRate; }
+        quint64 getCenterFrequency() const { return m_centerFrequency; }
+
+        static MsgReportStream* create(int sampleRate, quint64 centerFrequency) {
+            return new MsgReportStream(sampleRate, centerFrequency);
+        }
+
+    private:
+        int m_sampleRate;
+        quint64 m_centerFrequency;
+
+        MsgReportStream(int sampleRate, quint64 centerFrequency) :
+            Message(),
+            m_sampleRate(sampleRate),
+            m_centerFrequency(centerFrequency)
+        { }
+    };
+
+    ShmInputWorker(SampleSinkFifo* sampleFifo, MessageQueue *outputMessageQueue, QObject* parent = nullptr);
+    ~ShmInputWorker();
+
+    void setShmName(const QString& shmName);
+    void startWork();
+    void stopWork();
+    bool isConnected() const { return m_connected; }
+    float getLatencyMs() const { return m_latencyMs; } //!< Age of the last block received
+    quint64 getDroppedCount() const { return m_droppedCount; }
+
+private:
+    QMutex m_startWaitMutex;
+    QWaitCondition m_startWaiter;
+    volatile bool m_running;
+    volatile bool m_connected;
+    volatile float m_latencyMs;
+    volatile quint64 m_droppedCount;
+
+    SampleSinkFifo* m_sampleFifo;
+    MessageQueue *m_outputMessageQueue;
+    QMutex m_nameMutex;
+    QString m_shmName;
+    bool m_nameChanged;
+    ShmIQRing m_ring;
+    int m_sampleRate;
+    quint64 m_centerFrequency;
+
+    static const int m_attachRetryMs = 500;
+    static const int m_waitTimeoutMs = 100;
+
+    void run();
+    bool attach();
+    void writeToSampleFifo(const Sample *samples, unsigned int nbSamples);
+};
+
+#endif // PLUGINS_SAMPLESOURCE_SHMINPUT_SHMINPUTWORKER_H_
@@ -490,12 +490,14 @@ bool SoapySDRInput::start()
             qDebug("SoapySDRInput::start: expand channels. Re-allocate thread and take ownership");
 
             SampleSinkFifo **fifos = new SampleSinkFifo*[nbOriginalChannels];
+            FSampleSinkFifo **floatFifos = new FSampleSinkFifo*[nbOriginalChannels];
             unsigned int *log2Decims = new unsigned int[nbOriginalChannels];
             int *fcPoss = new int[nbOriginalChannels];
 
             for (int i = 0; i < nbOriginalChannels; i++) // save original FIFO references and data
             {
                 fifos[i] = soapySDRInputThread->getFifo(i);
+                floatFifos[i] = soapySDRInputThread->getFloatFifo(i);
                 log2Decims[i] = soapySDRInputThread->getLog2Decimation(i);
                 fcPoss[i] = soapySDRInputThread->getFcPos(i);
             }
@@ -508,6 +510,7 @@ bool SoapySDRInput::start()
             for (int i = 0; i < nbOriginalChannels; i++) // restore original FIFO references
             {
                 soapySDRInputThread->setFifo(i, fifos[i]);
+                soapySDRInputThread->setFloatFifo(i, floatFifos[i]);
                 soapySDRInputThread->setLog2Decimation(i, log2Decims[i]);
                 soapySDRInputThread->setFcPos(i, fcPoss[i]);
             }
@@ -522,6 +525,7 @@ bool SoapySDRInput::start()
 
             delete[] fcPoss;
             delete[] log2Decims;
+            delete[] floatFifos;
             delete[] fifos;
 
             needsStart = true;
@@ -539,7 +543,12 @@ bool SoapySDRInput::start()
         needsStart = true;
     }
 
+    if (m_floatSamples && (m_floatSampleFifo.size() == 0)) {
+        m_floatSampleFifo.setSize(96000 * 4);
+    }
+
     soapySDRInputThread->setFifo(requestedChannel, &m_sampleFifo);
+    soapySDRInputThread->setFloatFifo(requestedChannel, m_floatSamples ? &m_floatSampleFifo : nullptr);
     soapySDRInputThread->setLog2Decimation(requestedChannel, m_settings.m_log2Decim);
     soapySDRInputThread->setFcPos(requestedChannel, (int) m_settings.m_fcPos);
 
@@ -610,6 +619,7 @@ void SoapySDRInput::stop()
         qDebug("SoapySDRInput::stop: MI mode. Reduce by deleting and re-creating the thread");
         soapySDRInputThread->stopWork();
         SampleSinkFifo **fifos = new SampleSinkFifo*[nbOriginalChannels-1];
+        FSampleSinkFifo **floatFifos = new FSampleSinkFifo*[nbOriginalChannels-1];
         unsigned int *log2Decims = new unsigned int[nbOriginalChannels-1];
         int *fcPoss = new int[nbOriginalChannels-1];
         int highestActiveChannelIndex = -1;
@@ -617,6 +627,7 @@ void SoapySDRInput::stop()
         for (int i = 0; i < nbOriginalChannels-1; i++) // save original FIFO references and get the channel with highest index
         {
             fifos[i] = soapySDRInputThread->getFifo(i);
+            floatFifos[i] = soapySDRInputThread->getFloatFifo(i);
 
             if ((soapySDRInputThread->getFifo(i) != 0) && (i > highestActiveChannelIndex)) {
                 highestActiveChannelIndex = i;
@@ -637,6 +648,7 @@ void SoapySDRInput::stop()
             for (int i = 0; i < highestActiveChannelIndex; i++)  // restore original FIFO references
             {
                 soapySDRInputThread->setFifo(i, fifos[i]);
+                soapySDRInputThread->setFloatFifo(i, floatFifos[i]);
                 soapySDRInputThread->setLog2Decimation(i, log2Decims[i]);
                 soapySDRInputThread->setFcPos(i, fcPoss[i]);
             }
@@ -662,12 +674,14 @@ void SoapySDRInput::stop()
 
         delete[] fcPoss;
         delete[] log2Decims;
+        delete[] floatFifos;
         delete[] fifos;
     }
     else // remove channel from existing thread
     {
         qDebug("SoapySDRInput::stop: MI mode. Not changing MI configuration. Just remove FIFO reference");
         soapySDRInputThread->setFifo(requestedChannel, 0); // remove FIFO
+        soapySDRInputThread->setFloatFifo(requestedChannel, 0);
     }
 
     m_running = false;
@@ -22,7 +22,9 @@
 #include <SoapySDR/Errors.hpp>
 
 #include "dsp/samplesinkfifo.h"
+#include "dsp/fsamplesinkfifo.h"
 #include "soapysdr/devicesoapysdr.h"
+#include "util/timeutil.h"
 
 #include "soapysdrinputthread.h"
 
@@ -111,6 +113,26 @@ void SoapySDRInputThread::run()
             format = "CF32";
         }
 
+        for (unsigned int i = 0; i < m_nbChannels; i++)
+        {
+            switch (m_decimatorType)
+            {
+            case Decimator8:
+                m_channels[i].m_frontEnd.setInputFormat(DeviceFrontEnd::FormatS8, 8);
+                break;
+            case Decimator12:
+                m_channels[i].m_frontEnd.setInputFormat(DeviceFrontEnd::FormatS16, 12);
+                break;
+            case Decimator16:
+                m_channels[i].m_frontEnd.setInputFormat(DeviceFrontEnd::FormatS16, 16);
+                break;
+            case DecimatorFloat:
+            default:
+                m_channels[i].m_frontEnd.setInputFormat(DeviceFrontEnd::FormatF32, 0);
+                break;
+            }
+        }
+
         unsigned int elemSize = SoapySDR::formatToSize(format); // sample (I+Q) size in bytes
         SoapySDR::Stream *stream = m_dev->setupStream(SOAPY_SDR_RX, format, channels);
 
@@ -125,11 +147,14 @@ void SoapySDRInputThread::run()
 
         for (unsigned int i = 0; i < m_nbChannels; i++) {
             m_channels[i].m_convertBuffer.resize(numElems, Sample{0,0});
+            m_channels[i].m_fconvertBuffer.resize(numElems, FSample{0,0});
         }
 
         m_dev->activateStream(stream);
         int flags(0);
         long long timeNs(0);
+        bool hwTimeOffsetSet = false;
+        qint64 hwTimeOffsetUs = 0; //!< device time to host epoch
         float blockTime = ((float) numElems) / (m_sampleRate <= 0 ? 1024000 : m_sampleRate);
         long initialTtimeoutUs = 10000000 * blockTime; // 10 times the block time
         long timeoutUs = initialTtimeoutUs < 250000 ? 250000 : initialTtimeoutUs; // 250ms minimum
@@ -156,57 +181,29 @@ void SoapySDRInputThread::run()
                 break;
             }
 
-            if (m_iqOrder)
+            if ((ret > 0) && (flags & SOAPY_SDR_HAS_TIME))
             {
-                if (m_nbChannels > 1)
-                {
-                    callbackMIIQ(buffs, numElems*2); // size given in number of I or Q samples (2 items per sample)
-                }
-                else
-                {
-                    switch (m_decimatorType)
-                    {
-                    case Decimator8:
-                        callbackSI8IQ((const qint8*) buffs[0], numElems*2);
-                        break;
-                    case Decimator12:
-                        callbackSI12IQ((const qint16*) buffs[0], numElems*2);
-                        break;
-                    case Decimator16:
-                        callbackSI16IQ((const qint16*) buffs[0], numElems*2);
-                        break;
-                    case DecimatorFloat:
-                    default:
-                        callbackSIFIQ((const float*) buffs[0], numElems*2);
-                    }
-                }
-            }
-            else
-            {
-                if (m_nbChannels > 1)
+                qint64 timeUs = timeNs / 1000;
+
+                if (!hwTimeOffsetSet) // anchor the device time to the host epoch once per run
                 {
-                    callbackMIQI(buffs, numElems*2); // size given in number of I or Q samples (2 items per sample)
+                    hwTimeOffsetUs = TimeUtil::nowus() - timeUs - (m_sampleRate == 0 ? 0 : (ret * 1000000LL) / m_sampleRate);
+                    hwTimeOffsetSet = true;
                 }
-                else
+
+                for (unsigned int i = 0; i < m_nbChannels; i++)
                 {
-                    switch (m_decimatorType)
-                    {
-                    case Decimator8:
-                        callbackSI8QI((const qint8*) buffs[0], numElems*2);
-                        break;
-                    case Decimator12:
-                        callbackSI12QI((const qint16*) buffs[0], numElems*2);
-                        break;
-                    case Decimator16:
-                        callbackSI16QI((const qint16*) buffs[0], numElems*2);
-                        break;
-                    case DecimatorFloat:
-                    default:
-                        callbackSIFQI((const float*) buffs[0], numElems*2);
+                    if (m_channels[i].m_sampleFifo) {
+                        m_channels[i].m_sampleFifo->setHardwareTimestamp(timeUs + hwTimeOffsetUs);
                     }
                 }
             }
 
+            if (m_nbChannels > 1) {
+                callbackMI(buffs, numElems*2); // size given in number of I or Q samples (2 items per sample)
+            } else {
+                callbackSI(buffs[0], numElems*2);
+            }
         }
 
         qDebug("SoapySDRInputThread::run: stop running loop");
@@ -227,7 +224,7 @@ unsigned int SoapySDRInputThread::getNbFifos()
 
     for (unsigned int i = 0; i < m_nbChannels; i++)
     {
-        if (m_channels[i].m_sampleFifo) {
+        if (m_channels[i].m_sampleFifo || m_channels[i].m_floatSampleFifo) {
             fifoCount++;
         }
     }
@@ -239,6 +236,7 @@ void SoapySDRInputThread::setLog2Decimation(unsigned int channel, unsigned int l
 {
     if (channel < m_nbChannels) {
         m_channels[channel].m_log2Decim = log2_decim;
+        m_channels[channel].m_frontEnd.setLog2Decim(log2_decim);
     }
 }
 
@@ -255,6 +253,7 @@ void SoapySDRInputThread::setFcPos(unsigned int channel, int fcPos)
 {
     if (channel < m_nbChannels) {
         m_channels[channel].m_fcPos = fcPos;
+        m_channels[channel].m_frontEnd.setFcPos(fcPos);
     }
 }
 
@@ -267,6 +266,15 @@ int SoapySDRInputThread::getFcPos(unsigned int channel) const
     }
 }
 
+void SoapySDRInputThread::setIQOrder(bool iqOrder)
+{
+    m_iqOrder = iqOrder;
+
+    for (unsigned int i = 0; i < m_nbChannels; i++) {
+        m_channels[i].m_frontEnd.setIQOrder(iqOrder);
+    }
+}
+
 void SoapySDRInputThread::setFifo(unsigned int channel, SampleSinkFifo *sampleFifo)
 {
     if (channel < m_nbChannels) {
@@ -283,615 +291,55 @@ SampleSinkFifo *SoapySDRInputThread::getFifo(unsigned int channel)
     }
 }
 
-void SoapySDRInputThread::callbackMIIQ(std::vector<void *>& buffs, qint32 samplesPerChannel)
-{
-    for(unsigned int ichan = 0; ichan < m_nbChannels; ichan++)
-    {
-        switch (m_decimatorType)
-        {
-        case Decimator8:
-            callbackSI8IQ((const qint8*) buffs[ichan], samplesPerChannel, ichan);
-            break;
-        case Decimator12:
-            callbackSI12IQ((const qint16*) buffs[ichan], samplesPerChannel, ichan);
-            break;
-        case Decimator16:
-            callbackSI16IQ((const qint16*) buffs[ichan], samplesPerChannel, ichan);
-            break;
-        case DecimatorFloat:
-        default:
-            callbackSIFIQ((const float*) buffs[ichan], samplesPerChannel, ichan);
-        }
-    }
-}
-
-void SoapySDRInputThread::callbackMIQI(std::vector<void *>& buffs, qint32 samplesPerChannel)
+void SoapySDRInputThread::setFloatFifo(unsigned int channel, FSampleSinkFifo *sampleFifo)
 {
-    for(unsigned int ichan = 0; ichan < m_nbChannels; ichan++)
-    {
-        switch (m_decimatorType)
-        {
-        case Decimator8:
-            callbackSI8QI((const qint8*) buffs[ichan], samplesPerChannel, ichan);
-            break;
-        case Decimator12:
-            callbackSI12QI((const qint16*) buffs[ichan], samplesPerChannel, ichan);
-            break;
-        case Decimator16:
-            callbackSI16QI((const qint16*) buffs[ichan], samplesPerChannel, ichan);
-            break;
-        case DecimatorFloat:
-        default:
-            callbackSIFQI((const float*) buffs[ichan], samplesPerChannel, ichan);
-        }
-    }
-}
-
-void SoapySDRInputThread::callbackSI8IQ(const qint8* buf, qint32 len, unsigned int channel)
-{
-    SampleVector::iterator it = m_channels[channel].m_convertBuffer.begin();
-
-    if (m_channels[channel].m_log2Decim == 0)
-    {
-        m_channels[channel].m_decimators8IQ.decimate1(&it, buf, len);
-    }
-    else
-    {
-        if (m_channels[channel].m_fcPos == 0) // Infra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators8IQ.decimate2_inf(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators8IQ.decimate4_inf(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators8IQ.decimate8_inf(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators8IQ.decimate16_inf(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators8IQ.decimate32_inf(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators8IQ.decimate64_inf(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 1) // Supra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators8IQ.decimate2_sup(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators8IQ.decimate4_sup(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators8IQ.decimate8_sup(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators8IQ.decimate16_sup(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators8IQ.decimate32_sup(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators8IQ.decimate64_sup(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 2) // Center
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators8IQ.decimate2_cen(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators8IQ.decimate4_cen(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators8IQ.decimate8_cen(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators8IQ.decimate16_cen(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators8IQ.decimate32_cen(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators8IQ.decimate64_cen(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
+    if (channel < m_nbChannels) {
+        m_channels[channel].m_floatSampleFifo = sampleFifo;
     }
-
-    m_channels[channel].m_sampleFifo->write(m_channels[channel].m_convertBuffer.begin(), it);
 }
 
-void SoapySDRInputThread::callbackSI8QI(const qint8* buf, qint32 len, unsigned int channel)
+FSampleSinkFifo *SoapySDRInputThread::getFloatFifo(unsigned int channel)
 {
-    SampleVector::iterator it = m_channels[channel].m_convertBuffer.begin();
-
-    if (m_channels[channel].m_log2Decim == 0)
-    {
-        m_channels[channel].m_decimators8QI.decimate1(&it, buf, len);
-    }
-    else
-    {
-        if (m_channels[channel].m_fcPos == 0) // Infra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators8QI.decimate2_inf(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators8QI.decimate4_inf(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators8QI.decimate8_inf(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators8QI.decimate16_inf(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators8QI.decimate32_inf(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators8QI.decimate64_inf(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 1) // Supra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators8QI.decimate2_sup(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators8QI.decimate4_sup(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators8QI.decimate8_sup(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators8QI.decimate16_sup(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators8QI.decimate32_sup(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators8QI.decimate64_sup(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 2) // Center
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators8QI.decimate2_cen(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators8QI.decimate4_cen(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators8QI.decimate8_cen(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators8QI.decimate16_cen(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators8QI.decimate32_cen(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators8QI.decimate64_cen(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
+    if (channel < m_nbChannels) {
+        return m_channels[channel].m_floatSampleFifo;
+    } else {
+        return 0;
     }
-
-    m_channels[channel].m_sampleFifo->write(m_channels[channel].m_convertBuffer.begin(), it);
 }
 
-void SoapySDRInputThread::callbackSI12IQ(const qint16* buf, qint32 len, unsigned int channel)
+void SoapySDRInputThread::callbackMI(std::vector<void *>& buffs, qint32 samplesPerChannel)
 {
-    SampleVector::iterator it = m_channels[channel].m_convertBuffer.begin();
-
-    if (m_channels[channel].m_log2Decim == 0)
-    {
-        m_channels[channel].m_decimators12IQ.decimate1(&it, buf, len);
-    }
-    else
-    {
-        if (m_channels[channel].m_fcPos == 0) // Infra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators12IQ.decimate2_inf(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators12IQ.decimate4_inf(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators12IQ.decimate8_inf(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators12IQ.decimate16_inf(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators12IQ.decimate32_inf(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators12IQ.decimate64_inf(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 1) // Supra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators12IQ.decimate2_sup(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators12IQ.decimate4_sup(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators12IQ.decimate8_sup(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators12IQ.decimate16_sup(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators12IQ.decimate32_sup(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators12IQ.decimate64_sup(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 2) // Center
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators12IQ.decimate2_cen(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators12IQ.decimate4_cen(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators12IQ.decimate8_cen(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators12IQ.decimate16_cen(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators12IQ.decimate32_cen(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators12IQ.decimate64_cen(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
+    for(unsigned int ichan = 0; ichan < m_nbChannels; ichan++) {
+        callbackSI(buffs[ichan], samplesPerChannel, ichan);
     }
-
-    m_channels[channel].m_sampleFifo->write(m_channels[channel].m_convertBuffer.begin(), it);
 }
 
-void SoapySDRInputThread::callbackSI12QI(const qint16* buf, qint32 len, unsigned int channel)
+//  Convert, shift and decimate according to specified log2 (ex: log2=4 => decim=16)
+void SoapySDRInputThread::callbackSI(const void* buf, qint32 len, unsigned int channel)
 {
-    SampleVector::iterator it = m_channels[channel].m_convertBuffer.begin();
-
-    if (m_channels[channel].m_log2Decim == 0)
-    {
-        m_channels[channel].m_decimators12QI.decimate1(&it, buf, len);
-    }
-    else
+    if ((m_decimatorType == DecimatorFloat) && m_channels[channel].m_floatSampleFifo) // float baseband: no conversion to fixed point
     {
-        if (m_channels[channel].m_fcPos == 0) // Infra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators12QI.decimate2_inf(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators12QI.decimate4_inf(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators12QI.decimate8_inf(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators12QI.decimate16_inf(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators12QI.decimate32_inf(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators12QI.decimate64_inf(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 1) // Supra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators12QI.decimate2_sup(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators12QI.decimate4_sup(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators12QI.decimate8_sup(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators12QI.decimate16_sup(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators12QI.decimate32_sup(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators12QI.decimate64_sup(&it, buf, len);
-                break;
-            default:
-                break;
-            }
+        if (m_iqOrder) {
+            callbackFFIQ((const float*) buf, len, channel);
+        } else {
+            callbackFFQI((const float*) buf, len, channel);
         }
-        else if (m_channels[channel].m_fcPos == 2) // Center
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators12QI.decimate2_cen(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators12QI.decimate4_cen(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators12QI.decimate8_cen(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators12QI.decimate16_cen(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators12QI.decimate32_cen(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators12QI.decimate64_cen(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-    }
-
-    m_channels[channel].m_sampleFifo->write(m_channels[channel].m_convertBuffer.begin(), it);
-}
 
-void SoapySDRInputThread::callbackSI16IQ(const qint16* buf, qint32 len, unsigned int channel)
-{
-    SampleVector::iterator it = m_channels[channel].m_convertBuffer.begin();
-
-    if (m_channels[channel].m_log2Decim == 0)
-    {
-        m_channels[channel].m_decimators16IQ.decimate1(&it, buf, len);
-    }
-    else
-    {
-        if (m_channels[channel].m_fcPos == 0) // Infra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators16IQ.decimate2_inf(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators16IQ.decimate4_inf(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators16IQ.decimate8_inf(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators16IQ.decimate16_inf(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators16IQ.decimate32_inf(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators16IQ.decimate64_inf(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 1) // Supra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators16IQ.decimate2_sup(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators16IQ.decimate4_sup(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators16IQ.decimate8_sup(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators16IQ.decimate16_sup(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators16IQ.decimate32_sup(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators16IQ.decimate64_sup(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 2) // Center
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators16IQ.decimate2_cen(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators16IQ.decimate4_cen(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators16IQ.decimate8_cen(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators16IQ.decimate16_cen(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators16IQ.decimate32_cen(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators16IQ.decimate64_cen(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
+        return;
     }
 
-    m_channels[channel].m_sampleFifo->write(m_channels[channel].m_convertBuffer.begin(), it);
-}
-
-void SoapySDRInputThread::callbackSI16QI(const qint16* buf, qint32 len, unsigned int channel)
-{
     SampleVector::iterator it = m_channels[channel].m_convertBuffer.begin();
-
-    if (m_channels[channel].m_log2Decim == 0)
-    {
-        m_channels[channel].m_decimators16QI.decimate1(&it, buf, len);
-    }
-    else
-    {
-        if (m_channels[channel].m_fcPos == 0) // Infra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators16QI.decimate2_inf(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators16QI.decimate4_inf(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators16QI.decimate8_inf(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators16QI.decimate16_inf(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators16QI.decimate32_inf(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators16QI.decimate64_inf(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 1) // Supra
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators16QI.decimate2_sup(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators16QI.decimate4_sup(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators16QI.decimate8_sup(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators16QI.decimate16_sup(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators16QI.decimate32_sup(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators16QI.decimate64_sup(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-        else if (m_channels[channel].m_fcPos == 2) // Center
-        {
-            switch (m_channels[channel].m_log2Decim)
-            {
-            case 1:
-                m_channels[channel].m_decimators16QI.decimate2_cen(&it, buf, len);
-                break;
-            case 2:
-                m_channels[channel].m_decimators16QI.decimate4_cen(&it, buf, len);
-                break;
-            case 3:
-                m_channels[channel].m_decimators16QI.decimate8_cen(&it, buf, len);
-                break;
-            case 4:
-                m_channels[channel].m_decimators16QI.decimate16_cen(&it, buf, len);
-                break;
-            case 5:
-                m_channels[channel].m_decimators16QI.decimate32_cen(&it, buf, len);
-                break;
-            case 6:
-                m_channels[channel].m_decimators16QI.decimate64_cen(&it, buf, len);
-                break;
-            default:
-                break;
-            }
-        }
-    }
-
+    m_channels[channel].m_frontEnd.process(buf, len, &it);
     m_channels[channel].m_sampleFifo->write(m_channels[channel].m_convertBuffer.begin(), it);
 }
 
-void SoapySDRInputThread::callbackSIFIQ(const float* buf, qint32 len, unsigned int channel)
+void SoapySDRInputThread::callbackFFIQ(const float* buf, qint32 len, unsigned int channel)
 {
-    SampleVector::iterator it = m_channels[channel].m_convertBuffer.begin();
+    FSampleVector::iterator it = m_channels[channel].m_fconvertBuffer.begin();
 
     if (m_channels[channel].m_log2Decim == 0)
     {
-        m_channels[channel].m_decimatorsFloatIQ.decimate1(&it, buf, len);
+        m_channels[channel].m_decimatorsFFIQ.decimate1(&it, buf, len);
     }
     else
     {
@@ -900,22 +348,22 @@ void SoapySDRInputThread::callbackSIFIQ(const float* buf, qint32 len, unsigned i
             switch (m_channels[channel].m_log2Decim)
             {
             case 1:
-                m_channels[channel].m_decimatorsFloatIQ.decimate2_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate2_inf(&it, buf, len);
                 break;
             case 2:
-                m_channels[channel].m_decimatorsFloatIQ.decimate4_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate4_inf(&it, buf, len);
                 break;
             case 3:
-                m_channels[channel].m_decimatorsFloatIQ.decimate8_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate8_inf(&it, buf, len);
                 break;
             case 4:
-                m_channels[channel].m_decimatorsFloatIQ.decimate16_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate16_inf(&it, buf, len);
                 break;
             case 5:
-                m_channels[channel].m_decimatorsFloatIQ.decimate32_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate32_inf(&it, buf, len);
                 break;
             case 6:
-                m_channels[channel].m_decimatorsFloatIQ.decimate64_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate64_inf(&it, buf, len);
                 break;
             default:
                 break;
@@ -926,22 +374,22 @@ void SoapySDRInputThread::callbackSIFIQ(const float* buf, qint32 len, unsigned i
             switch (m_channels[channel].m_log2Decim)
             {
             case 1:
-                m_channels[channel].m_decimatorsFloatIQ.decimate2_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate2_sup(&it, buf, len);
                 break;
             case 2:
-                m_channels[channel].m_decimatorsFloatIQ.decimate4_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate4_sup(&it, buf, len);
                 break;
             case 3:
-                m_channels[channel].m_decimatorsFloatIQ.decimate8_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate8_sup(&it, buf, len);
                 break;
             case 4:
-                m_channels[channel].m_decimatorsFloatIQ.decimate16_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate16_sup(&it, buf, len);
                 break;
             case 5:
-                m_channels[channel].m_decimatorsFloatIQ.decimate32_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate32_sup(&it, buf, len);
                 break;
             case 6:
-                m_channels[channel].m_decimatorsFloatIQ.decimate64_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate64_sup(&it, buf, len);
                 break;
             default:
                 break;
@@ -952,22 +400,22 @@ void SoapySDRInputThread::callbackSIFIQ(const float* buf, qint32 len, unsigned i
             switch (m_channels[channel].m_log2Decim)
             {
             case 1:
-                m_channels[channel].m_decimatorsFloatIQ.decimate2_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate2_cen(&it, buf, len);
                 break;
             case 2:
-                m_channels[channel].m_decimatorsFloatIQ.decimate4_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate4_cen(&it, buf, len);
                 break;
             case 3:
-                m_channels[channel].m_decimatorsFloatIQ.decimate8_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate8_cen(&it, buf, len);
                 break;
             case 4:
-                m_channels[channel].m_decimatorsFloatIQ.decimate16_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate16_cen(&it, buf, len);
                 break;
             case 5:
-                m_channels[channel].m_decimatorsFloatIQ.decimate32_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate32_cen(&it, buf, len);
                 break;
             case 6:
-                m_channels[channel].m_decimatorsFloatIQ.decimate64_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFIQ.decimate64_cen(&it, buf, len);
                 break;
             default:
                 break;
@@ -975,16 +423,16 @@ void SoapySDRInputThread::callbackSIFIQ(const float* buf, qint32 len, unsigned i
         }
     }
 
-    m_channels[channel].m_sampleFifo->write(m_channels[channel].m_convertBuffer.begin(), it);
+    m_channels[channel].m_floatSampleFifo->write(m_channels[channel].m_fconvertBuffer.begin(), it);
 }
 
-void SoapySDRInputThread::callbackSIFQI(const float* buf, qint32 len, unsigned int channel)
+void SoapySDRInputThread::callbackFFQI(const float* buf, qint32 len, unsigned int channel)
 {
-    SampleVector::iterator it = m_channels[channel].m_convertBuffer.begin();
+    FSampleVector::iterator it = m_channels[channel].m_fconvertBuffer.begin();
 
     if (m_channels[channel].m_log2Decim == 0)
     {
-        m_channels[channel].m_decimatorsFloatQI.decimate1(&it, buf, len);
+        m_channels[channel].m_decimatorsFFQI.decimate1(&it, buf, len);
     }
     else
     {
@@ -993,22 +441,22 @@ void SoapySDRInputThread::callbackSIFQI(const float* buf, qint32 len, unsigned i
             switch (m_channels[channel].m_log2Decim)
             {
             case 1:
-                m_channels[channel].m_decimatorsFloatQI.decimate2_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate2_inf(&it, buf, len);
                 break;
             case 2:
-                m_channels[channel].m_decimatorsFloatQI.decimate4_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate4_inf(&it, buf, len);
                 break;
             case 3:
-                m_channels[channel].m_decimatorsFloatQI.decimate8_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate8_inf(&it, buf, len);
                 break;
             case 4:
-                m_channels[channel].m_decimatorsFloatQI.decimate16_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate16_inf(&it, buf, len);
                 break;
             case 5:
-                m_channels[channel].m_decimatorsFloatQI.decimate32_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate32_inf(&it, buf, len);
                 break;
             case 6:
-                m_channels[channel].m_decimatorsFloatQI.decimate64_inf(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate64_inf(&it, buf, len);
                 break;
             default:
                 break;
@@ -1019,22 +467,22 @@ void SoapySDRInputThread::callbackSIFQI(const float* buf, qint32 len, unsigned i
             switch (m_channels[channel].m_log2Decim)
             {
             case 1:
-                m_channels[channel].m_decimatorsFloatQI.decimate2_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate2_sup(&it, buf, len);
                 break;
             case 2:
-                m_channels[channel].m_decimatorsFloatQI.decimate4_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate4_sup(&it, buf, len);
                 break;
             case 3:
-                m_channels[channel].m_decimatorsFloatQI.decimate8_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate8_sup(&it, buf, len);
                 break;
             case 4:
-                m_channels[channel].m_decimatorsFloatQI.decimate16_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate16_sup(&it, buf, len);
                 break;
             case 5:
-                m_channels[channel].m_decimatorsFloatQI.decimate32_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate32_sup(&it, buf, len);
                 break;
             case 6:
-                m_channels[channel].m_decimatorsFloatQI.decimate64_sup(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate64_sup(&it, buf, len);
                 break;
             default:
                 break;
@@ -1045,22 +493,22 @@ void SoapySDRInputThread::callbackSIFQI(const float* buf, qint32 len, unsigned i
             switch (m_channels[channel].m_log2Decim)
             {
             case 1:
-                m_channels[channel].m_decimatorsFloatQI.decimate2_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate2_cen(&it, buf, len);
                 break;
             case 2:
-                m_channels[channel].m_decimatorsFloatQI.decimate4_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate4_cen(&it, buf, len);
                 break;
             case 3:
-                m_channels[channel].m_decimatorsFloatQI.decimate8_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate8_cen(&it, buf, len);
                 break;
             case 4:
-                m_channels[channel].m_decimatorsFloatQI.decimate16_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate16_cen(&it, buf, len);
                 break;
             case 5:
-                m_channels[channel].m_decimatorsFloatQI.decimate32_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate32_cen(&it, buf, len);
                 break;
             case 6:
-                m_channels[channel].m_decimatorsFloatQI.decimate64_cen(&it, buf, len);
+                m_channels[channel].m_decimatorsFFQI.decimate64_cen(&it, buf, len);
                 break;
             default:
                 break;
@@ -1068,5 +516,5 @@ void SoapySDRInputThread::callbackSIFQI(const float* buf, qint32 len, unsigned i
         }
     }
 
-    m_channels[channel].m_sampleFifo->write(m_channels[channel].m_convertBuffer.begin(), it);
+    m_channels[channel].m_floatSampleFifo->write(m_channels[channel].m_fconvertBuffer.begin(), it);
 }
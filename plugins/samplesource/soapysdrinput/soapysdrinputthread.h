@@ -29,10 +29,11 @@
 #include <SoapySDR/Device.hpp>
 
 #include "soapysdr/devicesoapysdrshared.h"
-#include "dsp/decimators.h"
-#include "dsp/decimatorsfi.h"
+#include "dsp/devicefrontend.h"
+#include "dsp/decimatorsff.h"
 
 class SampleSinkFifo;
+class FSampleSinkFifo;
 
 class SoapySDRInputThread : public QThread {
     Q_OBJECT
@@ -53,28 +54,29 @@ public:
     int getFcPos(unsigned int channel) const;
     void setFifo(unsigned int channel, SampleSinkFifo *sampleFifo);
     SampleSinkFifo *getFifo(unsigned int channel);
-    void setIQOrder(bool iqOrder) { m_iqOrder = iqOrder; }
+    void setFloatFifo(unsigned int channel, FSampleSinkFifo *sampleFifo); //!< When set float samples go there without conversion
+    FSampleSinkFifo *getFloatFifo(unsigned int channel);
+    void setIQOrder(bool iqOrder);
 
 private:
     struct Channel
     {
         SampleVector m_convertBuffer;
+        FSampleVector m_fconvertBuffer;
         SampleSinkFifo* m_sampleFifo;
+        FSampleSinkFifo* m_floatSampleFifo;
         unsigned int m_log2Decim;
         int m_fcPos;
-        Decimators<qint32, qint8, SDR_RX_SAMP_SZ, 8, true> m_decimators8IQ;
-        Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12, true> m_decimators12IQ;
-        Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 16, true> m_decimators16IQ;
-        Decimators<qint32, qint8, SDR_RX_SAMP_SZ, 8, false> m_decimators8QI;
-        Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12, false> m_decimators12QI;
-        Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 16, false> m_decimators16QI;
-        DecimatorsFI<true> m_decimatorsFloatIQ;
-        DecimatorsFI<false> m_decimatorsFloatQI;
+        DeviceFrontEnd m_frontEnd; //!< Fixed point Sample output
+        DecimatorsFF<true> m_decimatorsFFIQ;
+        DecimatorsFF<false> m_decimatorsFFQI;
 
         Channel() :
             m_sampleFifo(0),
+            m_floatSampleFifo(0),
             m_log2Decim(0),
-            m_fcPos(0)
+            m_fcPos(0),
+            m_frontEnd(DeviceFrontEnd::FormatF32, 0)
         {}
 
         ~Channel()
@@ -103,18 +105,12 @@ private:
     void run();
     unsigned int getNbFifos();
 
-    void callbackSI8IQ(const qint8* buf, qint32 len, unsigned int channel = 0);
-    void callbackSI12IQ(const qint16* buf, qint32 len, unsigned int channel = 0);
-    void callbackSI16IQ(const qint16* buf, qint32 len, unsigned int channel = 0);
-    void callbackSIFIQ(const float* buf, qint32 len, unsigned int channel = 0);
+    void callbackSI(const void* buf, qint32 len, unsigned int channel = 0);
 
-    void callbackSI8QI(const qint8* buf, qint32 len, unsigned int channel = 0);
-    void callbackSI12QI(const qint16* buf, qint32 len, unsigned int channel = 0);
-    void callbackSI16QI(const qint16* buf, qint32 len, unsigned int channel = 0);
-    void callbackSIFQI(const float* buf, qint32 len, unsigned int channel = 0);
+    void callbackFFIQ(const float* buf, qint32 len, unsigned int channel = 0);
+    void callbackFFQI(const float* buf, qint32 len, unsigned int channel = 0);
 
-    void callbackMIIQ(std::vector<void *>& buffs, qint32 samplesPerChannel);
-    void callbackMIQI(std::vector<void *>& buffs, qint32 samplesPerChannel);
+    void callbackMI(std::vector<void *>& buffs, qint32 samplesPerChannel);
 };
 
 
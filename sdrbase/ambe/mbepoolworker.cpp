@@ -0,0 +1,377 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#ifdef DSD_USE_MBELIB
+extern "C" {
+#include <mbelib.h>
+}
+#endif
+
+#include "audio/audiofifo.h"
+#include "mbepoolworker.h"
+
+MESSAGE_CLASS_DEFINITION(MBEPoolWorker::MsgPoolDecode, Message)
+
+/**
+ * mbelib state of one voice stream. Frames are expected in the layout handed to the AMBE chips:
+ * the FEC code vectors c0, c1, ... packed one after the other MSB first.
+ */
+struct MBEPoolWorker::Vocoder
+{
+#ifdef DSD_USE_MBELIB
+    mbe_parms m_curMp;
+    mbe_parms m_prevMp;
+    mbe_parms m_prevMpEnhanced;
+    char m_ambeFrame[4][24];
+    char m_ambeData[49];
+    char m_imbeFrame[8][23];
+    char m_imbeData[88];
+    char m_errStr[64];
+
+    Vocoder() {
+        mbe_initMbeParms(&m_curMp, &m_prevMp, &m_prevMpEnhanced);
+    }
+
+    static void unpack(const unsigned char *mbeFrame, char *vectors, int vectorStride, const int *sizes, int nbVectors)
+    {
+        int bitIndex = 0;
+
+        for (int v = 0; v < nbVectors; v++)
+        {
+            char *vector = vectors + v*vectorStride;
+
+            for (int i = sizes[v] - 1; i >= 0; i--, bitIndex++) {
+                vector[i] = (mbeFrame[bitIndex>>3] >> (7 - (bitIndex&7))) & 1;
+            }
+        }
+    }
+
+    bool decode(short *audio, const unsigned char *mbeFrame, SerialDV::DVRate mbeRate)
+    {
+        static const int ambeSizes[4] = {24, 23, 11, 14};
+        static const int imbeSizes[8] = {23, 23, 23, 23, 15, 15, 15, 7};
+        int errs = 0, errs2 = 0;
+
+        switch (mbeRate)
+        {
+        case SerialDV::DVRate3600x2400:
+            unpack(mbeFrame, &m_ambeFrame[0][0], 24, ambeSizes, 4);
+            mbe_processAmbe3600x2400Frame(audio, &errs, &errs2, m_errStr, m_ambeFrame, m_ambeData,
+                &m_curMp, &m_prevMp, &m_prevMpEnhanced, 3);
+            return true;
+        case SerialDV::DVRate3600x2450:
+            unpack(mbeFrame, &m_ambeFrame[0][0], 24, ambeSizes, 4);
+            mbe_processAmbe3600x2450Frame(audio, &errs, &errs2, m_errStr, m_ambeFrame, m_ambeData,
+                &m_curMp, &m_prevMp, &m_prevMpEnhanced, 3);
+            return true;
+        case SerialDV::DVRate7200x4400:
+            unpack(mbeFrame, &m_imbeFrame[0][0], 23, imbeSizes, 8);
+            mbe_processImbe7200x4400Frame(audio, &errs, &errs2, m_errStr, m_imbeFrame, m_imbeData,
+                &m_curMp, &m_prevMp, &m_prevMpEnhanced, 3);
+            return true;
+        default:
+            return false;
+        }
+    }
+#else
+    bool decode(short *audio, const unsigned char *mbeFrame, SerialDV::DVRate mbeRate)
+    {
+        (void) audio;
+        (void) mbeFrame;
+        (void) mbeRate;
+        return false;
+    }
+#endif
+};
+
+MBEPoolWorker::Channel::Channel(AudioFifo *audioFifo) :
+    m_audioFifo(audioFifo),
+    m_vocoder(new Vocoder()),
+    m_audioBufferFill(0),
+    m_upsamplerLastValue(0.0f),
+    m_upsampling(1),
+    m_volume(1.0f)
+{
+    m_audioBuffer.resize(8192);
+    setVolumeFactors(this);
+}
+
+MBEPoolWorker::Channel::~Channel()
+{
+    delete m_vocoder;
+}
+
+MBEPoolWorker::MBEPoolWorker() :
+    m_nbFrames(0),
+    m_nbBatches(0),
+    m_nbDropped(0),
+    m_busyNs(0)
+{
+    std::fill(m_dvAudioSamples, m_dvAudioSamples+SerialDV::MBE_AUDIO_BLOCK_SIZE, 0);
+}
+
+MBEPoolWorker::~MBEPoolWorker()
+{
+    m_inputMessageQueue.clear();
+
+    for (std::map<quint64, Channel*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it) {
+        delete it->second;
+    }
+}
+
+bool MBEPoolWorker::isAvailable()
+{
+#ifdef DSD_USE_MBELIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MBEPoolWorker::canDecode(SerialDV::DVRate mbeRate)
+{
+    return isAvailable()
+        && ((mbeRate == SerialDV::DVRate3600x2400)
+         || (mbeRate == SerialDV::DVRate3600x2450)
+         || (mbeRate == SerialDV::DVRate7200x4400));
+}
+
+void MBEPoolWorker::pushMbeFrame(const unsigned char *mbeFrame,
+        int mbeRateIndex,
+        int mbeVolumeIndex,
+        unsigned char channels,
+        bool useHP,
+        int upsampling,
+        AudioFifo *audioFifo,
+        quint64 channelId)
+{
+    m_inputMessageQueue.push(MsgPoolDecode::create(
+        channelId,
+        AMBEWorker::MsgMbeDecode::create(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo)));
+}
+
+void MBEPoolWorker::addChannel(quint64 channelId, AudioFifo *audioFifo)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_channels.find(channelId) == m_channels.end()) {
+        m_channels[channelId] = new Channel(audioFifo);
+    }
+}
+
+void MBEPoolWorker::releaseChannel(quint64 channelId)
+{
+    QMutexLocker locker(&m_mutex);
+    std::map<quint64, Channel*>::iterator it = m_channels.find(channelId);
+
+    if (it != m_channels.end())
+    {
+        delete it->second;
+        m_channels.erase(it);
+    }
+}
+
+int MBEPoolWorker::getNbChannels()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_channels.size();
+}
+
+void MBEPoolWorker::getLoad(Load& load)
+{
+    QMutexLocker locker(&m_mutex);
+    load.m_nbChannels = m_channels.size();
+    load.m_queueSize = m_inputMessageQueue.size();
+    load.m_nbFrames = m_nbFrames;
+    load.m_nbBatches = m_nbBatches;
+    load.m_nbDropped = m_nbDropped;
+    load.m_busyNs = m_busyNs;
+}
+
+void MBEPoolWorker::handleInputMessages()
+{
+    std::vector<Message*> batch;
+    std::vector<Channel*> written;
+    Message* message;
+    batch.reserve(m_maxBatchSize);
+
+    while (true)
+    {
+        int nbDropped = 0;
+
+        while (m_inputMessageQueue.size() > m_maxQueueSize)
+        {
+            delete m_inputMessageQueue.pop();
+            nbDropped++;
+        }
+
+        if (nbDropped > 0) {
+            qDebug("MBEPoolWorker::handleInputMessages: too many messages in queue: %d dropped", nbDropped);
+        }
+
+        batch.clear();
+
+        while ((batch.size() < (unsigned int) m_maxBatchSize) && ((message = m_inputMessageQueue.pop()) != 0)) {
+            batch.push_back(message);
+        }
+
+        if (batch.size() == 0) {
+            break;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        QMutexLocker locker(&m_mutex);
+        m_nbDropped += nbDropped;
+        written.clear();
+
+        for (std::vector<Message*>::iterator it = batch.begin(); it != batch.end(); ++it)
+        {
+            if (MsgPoolDecode::match(**it))
+            {
+                MsgPoolDecode *poolMsg = (MsgPoolDecode *) *it;
+                AMBEWorker::MsgMbeDecode *decodeMsg = &poolMsg->getDecode();
+                std::map<quint64, Channel*>::iterator itChannel = m_channels.find(poolMsg->getChannelId());
+
+                if (itChannel == m_channels.end()) // channel released
+                {
+                    m_nbDropped++;
+                }
+                else if (decode(itChannel->second, decodeMsg->getMbeFrame(), decodeMsg->getMbeRate()))
+                {
+                    Channel *channel = itChannel->second;
+                    int dBVolume = (decodeMsg->getVolumeIndex() - 30) / 4;
+                    float volume = pow(10.0, dBVolume / 10.0f);
+                    int upsampling = decodeMsg->getUpsampling();
+                    upsampling = upsampling > 6 ? 6 : upsampling < 1 ? 1 : upsampling;
+
+                    if ((volume != channel->m_volume) || (upsampling != channel->m_upsampling))
+                    {
+                        channel->m_volume = volume;
+                        channel->m_upsampling = upsampling;
+                        setVolumeFactors(channel);
+                    }
+
+                    channel->m_upsampleFilter.useHP(decodeMsg->getUseHP());
+
+                    if (upsampling > 1) {
+                        upsample(channel, upsampling, m_dvAudioSamples, SerialDV::MBE_AUDIO_BLOCK_SIZE, decodeMsg->getChannels());
+                    } else {
+                        noUpsample(channel, m_dvAudioSamples, SerialDV::MBE_AUDIO_BLOCK_SIZE, decodeMsg->getChannels());
+                    }
+
+                    if (channel->m_audioBufferFill >= channel->m_audioBuffer.size() - 960) {
+                        writeAudio(channel);
+                    }
+
+                    if (std::find(written.begin(), written.end(), channel) == written.end()) {
+                        written.push_back(channel);
+                    }
+
+                    m_nbFrames++;
+                }
+                else
+                {
+                    qDebug("MBEPoolWorker::handleInputMessages: MsgMbeDecode: cannot decode rate %d", (int) decodeMsg->getMbeRate());
+                    m_nbDropped++;
+                }
+            }
+
+            delete *it;
+        }
+
+        for (std::vector<Channel*>::iterator it = written.begin(); it != written.end(); ++it) {
+            writeAudio(*it);
+        }
+
+        m_nbBatches++;
+        m_busyNs += timer.nsecsElapsed();
+    }
+}
+
+bool MBEPoolWorker::decode(Channel *channel, const unsigned char *mbeFrame, SerialDV::DVRate mbeRate)
+{
+    return channel->m_vocoder->decode(m_dvAudioSamples, mbeFrame, mbeRate);
+}
+
+void MBEPoolWorker::writeAudio(Channel *channel)
+{
+    if (channel->m_audioBufferFill == 0) {
+        return;
+    }
+
+    uint res = channel->m_audioFifo->write((const quint8*)&channel->m_audioBuffer[0], channel->m_audioBufferFill);
+
+    if (res != channel->m_audioBufferFill) {
+        qDebug("MBEPoolWorker::writeAudio: %u/%u audio samples written", res, channel->m_audioBufferFill);
+    }
+
+    channel->m_audioBufferFill = 0;
+}
+
+void MBEPoolWorker::upsample(Channel *channel, int upsampling, short *in, int nbSamplesIn, unsigned char channels)
+{
+    for (int i = 0; i < nbSamplesIn; i++)
+    {
+        float cur = channel->m_upsampleFilter.usesHP() ? channel->m_upsampleFilter.runHP((float) in[i]) : (float) in[i];
+        float prev = channel->m_upsamplerLastValue;
+        qint16 upsample;
+
+        for (int j = 1; j <= upsampling; j++)
+        {
+            upsample = (qint16) channel->m_upsampleFilter.runLP(cur*channel->m_upsamplingFactors[j] + prev*channel->m_upsamplingFactors[upsampling-j]);
+            channel->m_audioBuffer[channel->m_audioBufferFill].l = channels & 1 ? channel->m_compressor.compress(upsample) : 0;
+            channel->m_audioBuffer[channel->m_audioBufferFill].r = (channels>>1) & 1 ? channel->m_compressor.compress(upsample) : 0;
+
+            if (channel->m_audioBufferFill < channel->m_audioBuffer.size() - 1) {
+                ++channel->m_audioBufferFill;
+            }
+        }
+
+        channel->m_upsamplerLastValue = cur;
+    }
+}
+
+void MBEPoolWorker::noUpsample(Channel *channel, short *in, int nbSamplesIn, unsigned char channels)
+{
+    for (int i = 0; i < nbSamplesIn; i++)
+    {
+        float cur = channel->m_upsampleFilter.usesHP() ? channel->m_upsampleFilter.runHP((float) in[i]) : (float) in[i];
+        channel->m_audioBuffer[channel->m_audioBufferFill].l = channels & 1 ? cur*channel->m_upsamplingFactors[0] : 0;
+        channel->m_audioBuffer[channel->m_audioBufferFill].r = (channels>>1) & 1 ? cur*channel->m_upsamplingFactors[0] : 0;
+
+        if (channel->m_audioBufferFill < channel->m_audioBuffer.size() - 1) {
+            ++channel->m_audioBufferFill;
+        }
+    }
+}
+
+void MBEPoolWorker::setVolumeFactors(Channel *channel)
+{
+    channel->m_upsamplingFactors[0] = channel->m_volume;
+
+    for (int i = 1; i <= channel->m_upsampling; i++) {
+        channel->m_upsamplingFactors[i] = (i*channel->m_volume) / (float) channel->m_upsampling;
+    }
+}
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AMBE_MBEPOOLWORKER_H_
+#define SDRBASE_AMBE_MBEPOOLWORKER_H_
+
+#include <map>
+
+#include <QObject>
+#include <QMutex>
+
+#include "export.h"
+#include "dvcontroller.h"
+#include "ambeworker.h"
+
+#include "util/message.h"
+#include "util/messagequeue.h"
+#include "dsp/filtermbe.h"
+#include "dsp/dsptypes.h"
+#include "audio/audiocompressor.h"
+
+class AudioFifo;
+
+/**
+ * Software (mbelib) vocoder worker of the MBEWorkerPool.
+ *
+ * It runs in its own thread and decodes MsgPoolDecode messages for the channels the pool
+ * assigned to it. A channel is identified by the id the pool gave it when it was assigned so that
+ * frames still queued for a released channel are never decoded into a channel that reuses the
+ * same audio FIFO address. Each channel keeps its own vocoder and audio state. Messages are
+ * consumed in batches: frames are decoded in queue order (so in order for each channel) and the
+ * audio of each channel is written to its FIFO once per batch.
+ */
+class SDRBASE_API MBEPoolWorker : public QObject {
+    Q_OBJECT
+public:
+    class MsgPoolDecode : public Message
+    {
+        MESSAGE_CLASS_DECLARATION
+    public:
+        quint64 getChannelId() const { return m_channelId; }
+        AMBEWorker::MsgMbeDecode& getDecode() { return *m_decode; }
+
+        static MsgPoolDecode* create(quint64 channelId, AMBEWorker::MsgMbeDecode *decode) {
+            return new MsgPoolDecode(channelId, decode);
+        }
+
+        ~MsgPoolDecode() { delete m_decode; }
+
+    private:
+        quint64 m_channelId;
+        AMBEWorker::MsgMbeDecode *m_decode; //!< Owned
+
+        MsgPoolDecode(quint64 channelId, AMBEWorker::MsgMbeDecode *decode) :
+            Message(),
+            m_channelId(channelId),
+            m_decode(decode)
+        { }
+    };
+
+    struct Load
+    {
+        int m_nbChannels;
+        int m_queueSize;
+        qint64 m_nbFrames;   //!< Frames decoded since start
+        qint64 m_nbBatches;  //!< Batches processed since start
+        qint64 m_nbDropped;  //!< Frames dropped since start (queue overflow or unsupported rate)
+        qint64 m_busyNs;     //!< Time spent decoding since start (ns)
+    };
+
+    MBEPoolWorker();
+    ~MBEPoolWorker();
+
+    void pushMbeFrame(const unsigned char *mbeFrame,
+            int mbeRateIndex,
+            int mbeVolumeIndex,
+            unsigned char channels,
+            bool useHP,
+            int upsampling,
+            AudioFifo *audioFifo,
+            quint64 channelId);
+
+    void addChannel(quint64 channelId, AudioFifo *audioFifo);
+    void releaseChannel(quint64 channelId); //!< No audio is written to the channel FIFO once this returns
+    int getNbChannels();
+    void getLoad(Load& load);
+
+    static bool isAvailable();                  //!< Built with mbelib
+    static bool canDecode(SerialDV::DVRate mbeRate);
+
+    MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
+
+    static const int m_maxBatchSize = 64;  //!< Frames processed between two FIFO writes
+    static const int m_maxQueueSize = 400; //!< Frames kept in queue (more than 1s for 20 channels)
+
+public slots:
+    void handleInputMessages();
+
+private:
+    struct Vocoder;
+
+    struct Channel
+    {
+        Channel(AudioFifo *audioFifo);
+        ~Channel();
+
+        AudioFifo *m_audioFifo;
+        Vocoder *m_vocoder;
+        AudioVector m_audioBuffer;
+        uint m_audioBufferFill;
+        float m_upsamplerLastValue;
+        MBEAudioInterpolatorFilter m_upsampleFilter;
+        int m_upsampling;
+        float m_volume;
+        float m_upsamplingFactors[7];
+        AudioCompressor m_compressor;
+    };
+
+    std::map<quint64, Channel*> m_channels; //!< By channel id
+    QMutex m_mutex;
+    short m_dvAudioSamples[SerialDV::MBE_AUDIO_BLOCK_SIZE];
+    qint64 m_nbFrames;
+    qint64 m_nbBatches;
+    qint64 m_nbDropped;
+    qint64 m_busyNs;
+
+    bool decode(Channel *channel, const unsigned char *mbeFrame, SerialDV::DVRate mbeRate);
+    static void upsample(Channel *channel, int upsampling, short *in, int nbSamplesIn, unsigned char channels);
+    static void noUpsample(Channel *channel, short *in, int nbSamplesIn, unsigned char channels);
+    static void setVolumeFactors(Channel *channel);
+    static void writeAudio(Channel *channel);
+};
+
+#endif // SDRBASE_AMBE_MBEPOOLWORKER_H_
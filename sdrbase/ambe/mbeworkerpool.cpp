@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QThread>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDebug>
+
+#include "dvcontroller.h"
+#include "mbepoolworker.h"
+#include "mbeworkerpool.h"
+
+MBEWorkerPool::MBEWorkerPool() :
+    m_nextChannelId(0)
+{}
+
+MBEWorkerPool::~MBEWorkerPool()
+{
+    stop();
+}
+
+bool MBEWorkerPool::isAvailable()
+{
+    return MBEPoolWorker::isAvailable();
+}
+
+bool MBEWorkerPool::canDecode(int mbeRateIndex)
+{
+    return MBEPoolWorker::canDecode((SerialDV::DVRate) mbeRateIndex);
+}
+
+void MBEWorkerPool::start(int nbWorkers)
+{
+    QMutexLocker locker(&m_mutex);
+    startWorkers(nbWorkers);
+}
+
+void MBEWorkerPool::startWorkers(int nbWorkers)
+{
+    if (m_workers.size() > 0) {
+        return;
+    }
+
+    if (nbWorkers <= 0) {
+        nbWorkers = std::max(1, QThread::idealThreadCount() - 1);
+    }
+
+    for (int i = 0; i < nbWorkers; i++)
+    {
+        m_workers.push_back(PoolWorker());
+        m_workers.back().worker = new MBEPoolWorker();
+        m_workers.back().thread = new QThread();
+        m_workers.back().worker->moveToThread(m_workers.back().thread);
+        connect(&m_workers.back().worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), m_workers.back().worker, SLOT(handleInputMessages()));
+        m_workers.back().thread->start();
+    }
+
+    m_loadTimer.start();
+    qDebug("MBEWorkerPool::start: %d workers", nbWorkers);
+}
+
+void MBEWorkerPool::stop()
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (std::vector<PoolWorker>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        disconnect(&it->worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), it->worker, SLOT(handleInputMessages()));
+        it->thread->quit();
+        it->thread->wait();
+        delete it->worker;
+        delete it->thread;
+    }
+
+    if (m_workers.size() > 0) {
+        qDebug("MBEWorkerPool::stop: %d workers stopped", (int) m_workers.size());
+    }
+
+    m_workers.clear();
+    m_assignments.clear();
+}
+
+const MBEWorkerPool::Assignment& MBEWorkerPool::assignChannel(AudioFifo *audioFifo)
+{
+    std::map<AudioFifo*, Assignment>::const_iterator it = m_assignments.find(audioFifo);
+
+    if (it != m_assignments.end()) {
+        return it->second;
+    }
+
+    int bestIndex = 0;
+    int bestNbChannels = m_workers[0].worker->getNbChannels();
+
+    for (unsigned int i = 1; i < m_workers.size(); i++)
+    {
+        int nbChannels = m_workers[i].worker->getNbChannels();
+
+        if (nbChannels < bestNbChannels)
+        {
+            bestIndex = i;
+            bestNbChannels = nbChannels;
+        }
+    }
+
+    Assignment& assignment = m_assignments[audioFifo];
+    assignment.m_workerIndex = bestIndex;
+    assignment.m_channelId = m_nextChannelId++;
+    m_workers[bestIndex].worker->addChannel(assignment.m_channelId, audioFifo);
+    qDebug("MBEWorkerPool::assignChannel: %p as channel %llu on worker %d",
+        audioFifo, (unsigned long long) assignment.m_channelId, bestIndex);
+
+    return assignment;
+}
+
+void MBEWorkerPool::pushMbeFrame(
+        const unsigned char *mbeFrame,
+        int mbeRateIndex,
+        int mbeVolumeIndex,
+        unsigned char channels,
+        bool useHP,
+        int upsampling,
+        AudioFifo *audioFifo)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_workers.size() == 0) {
+        startWorkers(0);
+    }
+
+    const Assignment& assignment = assignChannel(audioFifo);
+    m_workers[assignment.m_workerIndex].worker->pushMbeFrame(
+        mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo, assignment.m_channelId);
+}
+
+void MBEWorkerPool::releaseChannel(AudioFifo *audioFifo)
+{
+    QMutexLocker locker(&m_mutex);
+    std::map<AudioFifo*, Assignment>::iterator it = m_assignments.find(audioFifo);
+
+    if (it != m_assignments.end())
+    {
+        m_workers[it->second.m_workerIndex].worker->releaseChannel(it->second.m_channelId);
+        m_assignments.erase(it);
+    }
+}
+
+void MBEWorkerPool::getLoad(std::vector<WorkerLoad>& loads)
+{
+    QMutexLocker locker(&m_mutex);
+    qint64 elapsedNs = m_loadTimer.isValid() ? m_loadTimer.nsecsElapsed() : 0;
+    m_loadTimer.restart();
+    loads.clear();
+
+    for (std::vector<PoolWorker>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        MBEPoolWorker::Load load;
+        it->worker->getLoad(load);
+        qint64 nbFrames = load.m_nbFrames - it->lastFrames;
+        qint64 nbBatches = load.m_nbBatches - it->lastBatches;
+        qint64 busyNs = load.m_busyNs - it->lastBusyNs;
+        it->lastFrames = load.m_nbFrames;
+        it->lastBatches = load.m_nbBatches;
+        it->lastBusyNs = load.m_busyNs;
+
+        loads.push_back(WorkerLoad());
+        loads.back().m_nbChannels = load.m_nbChannels;
+        loads.back().m_queueSize = load.m_queueSize;
+        loads.back().m_framesPerSecond = elapsedNs > 0 ? (nbFrames * 1e9f) / elapsedNs : 0.0f;
+        loads.back().m_framesPerBatch = nbBatches > 0 ? nbFrames / (float) nbBatches : 0.0f;
+        loads.back().m_busyRatio = elapsedNs > 0 ? busyNs / (float) elapsedNs : 0.0f;
+        loads.back().m_nbDropped = load.m_nbDropped;
+    }
+}
+
+void MBEWorkerPool::formatLoad(const std::vector<WorkerLoad>& loads, QJsonObject& jsonObject)
+{
+    QJsonArray workers;
+
+    for (std::vector<WorkerLoad>::const_iterator it = loads.begin(); it != loads.end(); ++it)
+    {
+        QJsonObject worker;
+        worker.insert("nbChannels", it->m_nbChannels);
+        worker.insert("queueSize", it->m_queueSize);
+        worker.insert("framesPerSecond", it->m_framesPerSecond);
+        worker.insert("framesPerBatch", it->m_framesPerBatch);
+        worker.insert("busyRatio", it->m_busyRatio);
+        worker.insert("nbDropped", (double) it->m_nbDropped);
+        workers.append(worker);
+    }
+
+    jsonObject.insert("available", isAvailable() ? 1 : 0);
+    jsonObject.insert("nbWorkers", (int) loads.size());
+    jsonObject.insert("workers", workers);
+}
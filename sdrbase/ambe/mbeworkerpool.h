@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AMBE_MBEWORKERPOOL_H_
+#define SDRBASE_AMBE_MBEWORKERPOOL_H_
+
+#include <vector>
+#include <map>
+
+#include <QObject>
+#include <QMutex>
+#include <QElapsedTimer>
+
+#include "export.h"
+
+class QThread;
+class QJsonObject;
+class MBEPoolWorker;
+class AudioFifo;
+
+/**
+ * Pool of software (mbelib) vocoder threads shared by all digital voice channels.
+ *
+ * Channels push MBE frames exactly as they would for the AMBE serial devices. Each channel
+ * (identified by its audio FIFO) is pinned to the least loaded worker the first time it pushes a
+ * frame so that its frames are decoded in order by a single vocoder state. The worker sees the
+ * channel under a fresh id for each assignment so that a FIFO allocated at the address of a
+ * released one starts with a clean vocoder state and never gets frames queued for the old one.
+ * Threads are started on first use.
+ */
+class SDRBASE_API MBEWorkerPool : public QObject
+{
+    Q_OBJECT
+public:
+    struct WorkerLoad
+    {
+        int m_nbChannels;        //!< Channels assigned to the worker
+        int m_queueSize;         //!< Frames waiting in queue
+        float m_framesPerSecond; //!< Decoded frames per second since last report
+        float m_framesPerBatch;  //!< Average batch size since last report
+        float m_busyRatio;       //!< Fraction of time spent decoding since last report
+        qint64 m_nbDropped;      //!< Total frames dropped
+    };
+
+    MBEWorkerPool();
+    ~MBEWorkerPool();
+
+    static bool isAvailable();             //!< Software vocoder was built in
+    static bool canDecode(int mbeRateIndex);
+
+    void start(int nbWorkers = 0);          //!< 0: one worker per core less one (at least one)
+    void stop();
+    int getNbWorkers() const { return m_workers.size(); }
+
+    void pushMbeFrame(
+            const unsigned char *mbeFrame,
+            int mbeRateIndex,
+            int mbeVolumeIndex,
+            unsigned char channels,
+            bool useHP,
+            int upsampling,
+            AudioFifo *audioFifo);
+    void releaseChannel(AudioFifo *audioFifo); //!< To be called before the FIFO is destroyed
+
+    void getLoad(std::vector<WorkerLoad>& loads); //!< Load of each worker since the previous call
+    static void formatLoad(const std::vector<WorkerLoad>& loads, QJsonObject& jsonObject);
+
+private:
+    struct PoolWorker
+    {
+        PoolWorker() :
+            thread(nullptr),
+            worker(nullptr),
+            lastFrames(0),
+            lastBatches(0),
+            lastBusyNs(0)
+        {}
+
+        QThread *thread;
+        MBEPoolWorker *worker;
+        qint64 lastFrames;
+        qint64 lastBatches;
+        qint64 lastBusyNs;
+    };
+
+    struct Assignment
+    {
+        int m_workerIndex;
+        quint64 m_channelId;
+    };
+
+    std::vector<PoolWorker> m_workers;
+    std::map<AudioFifo*, Assignment> m_assignments; //!< Worker and channel id of each channel FIFO
+    quint64 m_nextChannelId;
+    QElapsedTimer m_loadTimer;
+    QMutex m_mutex;
+
+    void startWorkers(int nbWorkers);
+    const Assignment& assignChannel(AudioFifo *audioFifo);
+};
+
+#endif // SDRBASE_AMBE_MBEWORKERPOOL_H_
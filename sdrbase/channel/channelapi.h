@@ -107,6 +107,31 @@ public:
         errorMessage = "Not implemented"; return 501;
     }
 
+    /**
+     * API adapter for the channel video frame GET requests (channels producing video).
+     * Frame gets the latest frame encoded as per format ("jpeg" or "raw") with its size divided by scale.
+     * Status is 204 (no content) when there is no frame with a number above since.
+     */
+    virtual int webapiVideoFrameGet(
+            const QString& format,
+            int scale,
+            int quality,
+            quint64 since,
+            QByteArray& frame,
+            QString& mimeType,
+            quint64& frameIndex,
+            QString& errorMessage)
+    {
+        (void) format;
+        (void) scale;
+        (void) quality;
+        (void) since;
+        (void) frame;
+        (void) mimeType;
+        (void) frameIndex;
+        errorMessage = "Not implemented"; return 501;
+    }
+
     int getIndexInDeviceSet() const { return m_indexInDeviceSet; }
     void setIndexInDeviceSet(int indexInDeviceSet) { m_indexInDeviceSet = indexInDeviceSet; }
     int getDeviceSetIndex() const { return m_deviceSetIndex; }
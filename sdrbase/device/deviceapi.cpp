@@ -332,6 +332,40 @@ void DeviceAPI::configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCo
     }
 }
 
+void DeviceAPI::configureCompactSamples(bool compactSamples)
+{
+    if (m_deviceSourceEngine) {
+        m_deviceSourceEngine->configureCompactSamples(compactSamples);
+    }
+}
+
+bool DeviceAPI::getCompactSamples() const
+{
+    return m_deviceSourceEngine ? m_deviceSourceEngine->getCompactSamples() : false;
+}
+
+void DeviceAPI::configureFloatSamples(bool floatSamples)
+{
+    DeviceSampleSource *source = getSampleSource();
+
+    if (source) {
+        source->setFloatSamples(floatSamples);
+    }
+}
+
+bool DeviceAPI::getFloatSamples()
+{
+    DeviceSampleSource *source = getSampleSource();
+    return source ? source->getFloatSamples() : false;
+}
+
+void DeviceAPI::configureConcurrentStreams(bool concurrentStreams)
+{
+    if (m_deviceMIMOEngine) {
+        m_deviceMIMOEngine->configureConcurrentStreams(concurrentStreams);
+    }
+}
+
 void DeviceAPI::setHardwareId(const QString& id)
 {
     m_hardwareId = id;
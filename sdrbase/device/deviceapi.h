@@ -101,6 +101,11 @@ public:
     MessageQueue *getSamplingDeviceGUIMessageQueue();   //!< Sampling device (ex: single Tx) GUI input message queue
 
     void configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection, int streamIndex = 0); //!< Configure current device engine DSP corrections (Rx)
+    void configureCompactSamples(bool compactSamples); //!< Use 16 bit sample storage in the FIFOs of the device set (Rx)
+    bool getCompactSamples() const;
+    void configureFloatSamples(bool floatSamples); //!< Request float baseband from float native devices. Applied at next start (Rx)
+    bool getFloatSamples();
+    void configureConcurrentStreams(bool concurrentStreams); //!< Process each stream of a synchronous MIMO device on its own worker (MIMO)
 
     void setHardwareId(const QString& id);
     void setSamplingDeviceId(const QString& id) { m_samplingDeviceId = id; }
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "basebandsamplesink.h"
 
 MESSAGE_CLASS_DEFINITION(BasebandSampleSink::MsgThreadedSink, Message)
@@ -12,6 +14,27 @@ BasebandSampleSink::~BasebandSampleSink()
 {
 }
 
+void BasebandSampleSink::feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end, bool positiveOnly)
+{
+	unsigned int count = end - begin;
+
+	if (m_floatConvertBuffer.size() < count) {
+		m_floatConvertBuffer.resize(count);
+	}
+
+	SampleVector::iterator it = m_floatConvertBuffer.begin();
+
+	for (FSampleVector::const_iterator fit = begin; fit != end; ++fit, ++it)
+	{
+		Real re = std::max(-1.0f, std::min(fit->real(), 1.0f - 1.0f/SDR_RX_SCALEF));
+		Real im = std::max(-1.0f, std::min(fit->imag(), 1.0f - 1.0f/SDR_RX_SCALEF));
+		it->setReal(re * SDR_RX_SCALEF);
+		it->setImag(im * SDR_RX_SCALEF);
+	}
+
+	feed(m_floatConvertBuffer.begin(), m_floatConvertBuffer.begin() + count, positiveOnly);
+}
+
 void BasebandSampleSink::handleInputMessages()
 {
 	Message* message;
@@ -57,7 +57,10 @@ public:
 	virtual void start() = 0;
 	virtual void stop() = 0;
 	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly) = 0;
+	/** Float baseband input (full scale 1.0). Default converts to fixed point samples and calls the fixed point feed */
+	virtual void feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end, bool positiveOnly);
 	virtual bool handleMessage(const Message& cmd) = 0; //!< Processing of a message. Returns true if message has actually been processed
+	virtual void setCompactSamples(bool compactSamples) { (void) compactSamples; } //!< Sinks with a sample FIFO may store 16 bit samples
 
 	MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     void setMessageQueueToGUI(MessageQueue *queue) { m_guiMessageQueue = queue; }
@@ -66,6 +69,7 @@ public:
 protected:
 	MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
     MessageQueue *m_guiMessageQueue;  //!< Input message queue to the GUI
+	SampleVector m_floatConvertBuffer; //!< Used by the default float feed
 
 protected slots:
 	void handleInputMessages();
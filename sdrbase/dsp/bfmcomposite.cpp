@@ -0,0 +1,357 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <algorithm>
+
+#include <QDebug>
+
+#include "dsp/wfir.h"
+#include "bfmcomposite.h"
+
+const Real BFMComposite::m_minPilotLevel = 0.01;
+
+BFMComposite::Decimator::Decimator() :
+    m_ptr(0),
+    m_decimation(1),
+    m_phase(0)
+{}
+
+void BFMComposite::Decimator::create(int decimation, double sampleRate, double passband, double stopband)
+{
+    // Kaiser window design for 60 dB stop band attenuation
+    double transition = (stopband - passband) / sampleRate;
+    int nbTaps = (int) std::ceil(52.0 / (2.285 * 2.0 * M_PI * transition)) + 1;
+    nbTaps = std::min(nbTaps | 1, 1023);
+    std::vector<double> taps(nbTaps);
+    WFIR::BasicFIR(taps.data(), nbTaps, WFIR::LPF, (passband + stopband) / sampleRate, 0.0, WFIR::wtKAISER, 5.65);
+
+    double sum = 0.0;
+
+    for (int i = 0; i < nbTaps; i++) {
+        sum += taps[i];
+    }
+
+    m_taps.resize(nbTaps);
+
+    for (int i = 0; i < nbTaps; i++) {
+        m_taps[i] = taps[i] / sum;
+    }
+
+    m_delay[0].assign(2*nbTaps, 0.0f);
+    m_delay[1].assign(2*nbTaps, 0.0f);
+    m_ptr = 0;
+    m_decimation = decimation;
+    m_phase = 0;
+}
+
+void BFMComposite::Decimator::feed(const Real *in0, const Real *in1, int n, std::vector<Real>& out0, std::vector<Real>& out1)
+{
+    int nbTaps = m_taps.size();
+    const Real *taps = m_taps.data();
+    Real *delay0 = m_delay[0].data();
+    Real *delay1 = m_delay[1].data();
+
+    for (int i = 0; i < n; i++)
+    {
+        delay0[m_ptr] = delay0[m_ptr + nbTaps] = in0[i];
+
+        if (in1) {
+            delay1[m_ptr] = delay1[m_ptr + nbTaps] = in1[i];
+        }
+
+        m_ptr = m_ptr + 1 == nbTaps ? 0 : m_ptr + 1;
+
+        if (++m_phase < m_decimation) {
+            continue;
+        }
+
+        m_phase = 0;
+        const Real *x0 = &delay0[m_ptr]; // oldest to newest
+        Real acc0 = 0.0f;
+
+        for (int k = 0; k < nbTaps; k++) {
+            acc0 += taps[k] * x0[k];
+        }
+
+        out0.push_back(acc0);
+
+        if (in1)
+        {
+            const Real *x1 = &delay1[m_ptr];
+            Real acc1 = 0.0f;
+
+            for (int k = 0; k < nbTaps; k++) {
+                acc1 += taps[k] * x1[k];
+            }
+
+            out1.push_back(acc1);
+        }
+    }
+}
+
+BFMComposite::BFMComposite() :
+    m_inputSampleRate(0),
+    m_audioRate(48000),
+    m_rdsRate(31250),
+    m_stereo(false),
+    m_lsbStereo(false),
+    m_rds(false),
+    m_audio(true),
+    m_showPilot(false),
+    m_pilotDecimation(1),
+    m_pilotPhase(0),
+    m_ncoRe(1.0),
+    m_ncoIm(0.0),
+    m_ncoFreq(0.0),
+    m_ncoNominal(0.0),
+    m_loopKp(0.0),
+    m_loopKi(0.0),
+    m_pilotAccRe(0.0f),
+    m_pilotAccIm(0.0f),
+    m_pilotLpAlpha(1.0f),
+    m_pilotLevel(0.0f),
+    m_lockError(1.0f),
+    m_lockCount(0),
+    m_lockDelay(1)
+{
+    m_pilotLpRe[0] = m_pilotLpRe[1] = 0.0f;
+    m_pilotLpIm[0] = m_pilotLpIm[1] = 0.0f;
+}
+
+BFMComposite::~BFMComposite()
+{}
+
+void BFMComposite::configure(int inputSampleRate, int audioSampleRate, Real afBandwidth)
+{
+    m_inputSampleRate = inputSampleRate;
+
+    // L+R and L-R: decimate to the lowest rate not below the audio rate
+    int audioDecimation = std::max(1, inputSampleRate / std::max(1, audioSampleRate));
+    m_audioRate = inputSampleRate / (Real) audioDecimation;
+    m_audioDecimator.create(audioDecimation, inputSampleRate, afBandwidth,
+        std::max((double) m_audioRate - afBandwidth, afBandwidth + 0.05 * inputSampleRate));
+
+    // RDS: +/- 2.4 kHz baseband at about 31.25 kS/s. The pilot loop is updated at the same rate.
+    int rdsDecimation = std::max(1, inputSampleRate / 31250);
+    m_rdsRate = inputSampleRate / (Real) rdsDecimation;
+    m_rdsDecimator.create(rdsDecimation, inputSampleRate, 2400.0, m_rdsRate - 2400.0);
+
+    m_pilotDecimation = rdsDecimation;
+    m_pilotPhase = 0;
+    m_ncoRe = 1.0;
+    m_ncoIm = 0.0;
+    m_ncoNominal = 2.0 * M_PI * 19000.0 / inputSampleRate;
+    m_ncoFreq = m_ncoNominal;
+
+    // Second order loop of 10 Hz noise bandwidth updated every m_pilotDecimation samples
+    double zeta = 0.707;
+    double wnT = ((2.0 * 10.0) / (zeta + 1.0 / (4.0 * zeta))) * (m_pilotDecimation / (double) inputSampleRate);
+    m_loopKp = 2.0 * zeta * wnT;
+    m_loopKi = (wnT * wnT) / m_pilotDecimation;
+
+    m_pilotAccRe = 0.0f;
+    m_pilotAccIm = 0.0f;
+    m_pilotLpRe[0] = m_pilotLpRe[1] = 0.0f;
+    m_pilotLpIm[0] = m_pilotLpIm[1] = 0.0f;
+    m_pilotLpAlpha = 1.0 - std::exp(-2.0 * M_PI * 150.0 / m_rdsRate);
+    m_pilotLevel = 0.0f;
+    m_lockError = 1.0f;
+    m_lockCount = 0;
+    m_lockDelay = (int) (m_rdsRate / 2); // 0.5s
+
+    m_ncoSin.resize(m_pilotDecimation);
+    m_ncoCos.resize(m_pilotDecimation);
+    m_monoIn.resize(m_pilotDecimation);
+    m_stereoIn.resize(m_pilotDecimation);
+    m_rdsIn.resize(m_pilotDecimation);
+
+    qDebug("BFMComposite::configure: input: %d audio: %f (/%d %d taps) RDS: %f (/%d %d taps)",
+        inputSampleRate,
+        m_audioRate, audioDecimation, m_audioDecimator.getNbTaps(),
+        m_rdsRate, rdsDecimation, m_rdsDecimator.getNbTaps());
+}
+
+void BFMComposite::feed(const std::vector<Real>& mpx)
+{
+    int n = mpx.size();
+    m_mono.clear();
+    m_stereoOut.clear();
+    m_rdsOut.clear();
+    m_pilot38.clear();
+
+    for (int i = 0; i < n;)
+    {
+        int len = std::min(n - i, m_pilotDecimation - m_pilotPhase);
+        processSegment(&mpx[i], len);
+        m_pilotPhase += len;
+        i += len;
+
+        if (m_pilotPhase == m_pilotDecimation)
+        {
+            if (m_stereo || m_rds) {
+                updatePilotLoop();
+            }
+
+            m_pilotPhase = 0;
+        }
+    }
+}
+
+void BFMComposite::processSegment(const Real *mpx, int n)
+{
+    if (!m_stereo && !m_rds)
+    {
+        m_lockCount = 0;
+
+        if (m_audio) {
+            m_audioDecimator.feed(mpx, nullptr, n, m_mono, m_dummy);
+        }
+
+        return;
+    }
+
+    // The NCO recursion is serial. Everything else below is a straight loop over the segment.
+    Real *ncoSin = m_ncoSin.data();
+    Real *ncoCos = m_ncoCos.data();
+    double rotRe = std::cos(m_ncoFreq);
+    double rotIm = std::sin(m_ncoFreq);
+
+    for (int k = 0; k < n; k++)
+    {
+        ncoCos[k] = m_ncoRe;
+        ncoSin[k] = m_ncoIm;
+        double re = m_ncoRe * rotRe - m_ncoIm * rotIm;
+        m_ncoIm = m_ncoRe * rotIm + m_ncoIm * rotRe;
+        m_ncoRe = re;
+    }
+
+    // pilot baseband: mpx * exp(-j*phi)
+    Real accRe = 0.0f, accIm = 0.0f;
+
+    for (int k = 0; k < n; k++)
+    {
+        accRe += mpx[k] * ncoCos[k];
+        accIm -= mpx[k] * ncoSin[k];
+    }
+
+    m_pilotAccRe += accRe;
+    m_pilotAccIm += accIm;
+
+    // L+R: locked pilot A*sin(phi) removed
+    Real *monoIn = m_monoIn.data();
+    Real pilotAmplitude = getPilotLock() ? m_pilotLevel : 0.0f;
+
+    if (m_audio)
+    {
+        for (int k = 0; k < n; k++) {
+            monoIn[k] = mpx[k] - pilotAmplitude * ncoSin[k];
+        }
+    }
+
+    // L-R: sin(2*phi) = 2*sin*cos (LSB mode adds cos(2*phi) = 2*cos*cos - 1)
+    Real *stereoIn = m_stereoIn.data();
+
+    if (m_audio && m_stereo)
+    {
+        if (m_lsbStereo)
+        {
+            for (int k = 0; k < n; k++) {
+                stereoIn[k] = mpx[k] * (2.0f * ncoSin[k] * ncoCos[k] + 2.0f * ncoCos[k] * ncoCos[k] - 1.0f);
+            }
+        }
+        else
+        {
+            for (int k = 0; k < n; k++) {
+                stereoIn[k] = 1.17f * mpx[k] * 2.0f * ncoSin[k] * ncoCos[k];
+            }
+        }
+    }
+
+    if (m_audio) {
+        m_audioDecimator.feed(monoIn, m_stereo ? stereoIn : nullptr, n, m_mono, m_stereoOut);
+    }
+
+    // RDS: cos(3*phi) = cos*(cos^2 - 3*sin^2)
+    if (m_rds)
+    {
+        Real *rdsIn = m_rdsIn.data();
+
+        for (int k = 0; k < n; k++) {
+            rdsIn[k] = 2.0f * mpx[k] * ncoCos[k] * (ncoCos[k] * ncoCos[k] - 3.0f * ncoSin[k] * ncoSin[k]);
+        }
+
+        m_rdsDecimator.feed(rdsIn, nullptr, n, m_rdsOut, m_dummy);
+    }
+
+    if (m_showPilot)
+    {
+        for (int k = 0; k < n; k++) {
+            m_pilot38.push_back(2.0f * ncoSin[k] * ncoCos[k]);
+        }
+    }
+}
+
+void BFMComposite::updatePilotLoop()
+{
+    Real re = m_pilotAccRe / m_pilotDecimation;
+    Real im = m_pilotAccIm / m_pilotDecimation;
+    m_pilotAccRe = 0.0f;
+    m_pilotAccIm = 0.0f;
+
+    for (int i = 0; i < 2; i++)
+    {
+        m_pilotLpRe[i] += m_pilotLpAlpha * (re - m_pilotLpRe[i]);
+        m_pilotLpIm[i] += m_pilotLpAlpha * (im - m_pilotLpIm[i]);
+        re = m_pilotLpRe[i];
+        im = m_pilotLpIm[i];
+    }
+
+    // Locked on mpx = A*sin(phi): baseband is -j*A/2
+    m_pilotLevel = 2.0f * std::sqrt(re*re + im*im);
+    double phaseErr = std::atan2(re, -im);
+
+    m_lockError += 0.001f * (std::abs(phaseErr) - m_lockError); // about 30 ms average
+
+    if ((m_pilotLevel > m_minPilotLevel) && (m_lockError < 0.3f))
+    {
+        if (m_lockCount < m_lockDelay) {
+            m_lockCount++;
+        }
+    }
+    else
+    {
+        m_lockCount = 0;
+    }
+
+    if (m_pilotLevel < m_minPilotLevel) {
+        phaseErr = 0.0; // no pilot: free run
+    }
+
+    double maxDeviation = 2.0 * M_PI * 10.0 / m_inputSampleRate;
+    m_ncoFreq += m_loopKi * phaseErr;
+    m_ncoFreq = std::max(m_ncoNominal - maxDeviation, std::min(m_ncoNominal + maxDeviation, m_ncoFreq));
+
+    // Phase correction and magnitude renormalization of the NCO phasor
+    double corrRe = std::cos(m_loopKp * phaseErr);
+    double corrIm = std::sin(m_loopKp * phaseErr);
+    double ncoRe = m_ncoRe * corrRe - m_ncoIm * corrIm;
+    double ncoIm = m_ncoRe * corrIm + m_ncoIm * corrRe;
+    double norm = 1.0 / std::sqrt(ncoRe*ncoRe + ncoIm*ncoIm);
+    m_ncoRe = ncoRe * norm;
+    m_ncoIm = ncoIm * norm;
+}
@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_BFMCOMPOSITE_H_
+#define SDRBASE_DSP_BFMCOMPOSITE_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Multi-rate FM composite (MPX) decoder.
+ *
+ * The MPX signal is processed in blocks at the channel rate. The 19 kHz pilot phase comes from a
+ * complex NCO that is locked on the pilot at a low rate. The NCO harmonics are used to mix the L-R
+ * subcarrier (38 kHz) and the RDS subcarrier (57 kHz) to baseband in simple per sample loops over
+ * the block. Then each component is brought down to its own rate by a decimating FIR that only
+ * computes the retained outputs:
+ *   - L+R and L-R share one filter down to the audio intermediate rate (at least the audio rate)
+ *   - RDS baseband goes down to about 31.25 kS/s
+ * The pilot itself is removed from L+R once locked.
+ */
+class SDRBASE_API BFMComposite
+{
+public:
+    /** Decimating FIR on one or two real lanes sharing the same taps. Also used to bring FM stations down to MPX rate. */
+    class Decimator
+    {
+    public:
+        Decimator();
+        void create(int decimation, double sampleRate, double passband, double stopband);
+        void feed(const Real *in0, const Real *in1, int n, std::vector<Real>& out0, std::vector<Real>& out1);
+        int getDecimation() const { return m_decimation; }
+        int getNbTaps() const { return m_taps.size(); }
+
+    private:
+        std::vector<Real> m_taps;
+        std::vector<Real> m_delay[2]; //!< Twice the filter length so that the window is contiguous
+        int m_ptr;
+        int m_decimation;
+        int m_phase;
+    };
+
+    BFMComposite();
+    ~BFMComposite();
+
+    void configure(int inputSampleRate, int audioSampleRate, Real afBandwidth);
+    void setStereo(bool stereo, bool lsbStereo) { m_stereo = stereo; m_lsbStereo = lsbStereo; }
+    void setRDS(bool rds) { m_rds = rds; }
+    void setAudio(bool audio) { m_audio = audio; } //!< L+R and L-R outputs are not produced when off (RDS only)
+    void setShowPilot(bool showPilot) { m_showPilot = showPilot; }
+
+    void feed(const std::vector<Real>& mpx); //!< Process a block of MPX samples. Outputs are replaced.
+
+    const std::vector<Real>& getMono() const { return m_mono; }     //!< L+R at audio intermediate rate
+    const std::vector<Real>& getStereo() const { return m_stereoOut; } //!< L-R at audio intermediate rate (if stereo)
+    const std::vector<Real>& getRDS() const { return m_rdsOut; }    //!< RDS baseband at RDS rate (if RDS)
+    const std::vector<Real>& getPilot38() const { return m_pilot38; } //!< Regenerated 38 kHz at input rate (if show pilot)
+    Real getAudioRate() const { return m_audioRate; }
+    Real getRDSRate() const { return m_rdsRate; }
+
+    bool getPilotLock() const { return m_lockCount >= m_lockDelay; }
+    Real getPilotLevel() const { return m_pilotLevel; }
+
+private:
+    int m_inputSampleRate;
+    Real m_audioRate;
+    Real m_rdsRate;
+    bool m_stereo;
+    bool m_lsbStereo;
+    bool m_rds;
+    bool m_audio;
+    bool m_showPilot;
+
+    Decimator m_audioDecimator;
+    Decimator m_rdsDecimator;
+
+    // pilot NCO and loop
+    int m_pilotDecimation;   //!< Input samples per pilot loop update
+    int m_pilotPhase;        //!< Position in current update period
+    double m_ncoRe;          //!< NCO phasor exp(j*phi)
+    double m_ncoIm;
+    double m_ncoFreq;        //!< NCO frequency (radians per input sample)
+    double m_ncoNominal;     //!< Nominal 19 kHz frequency (radians per input sample)
+    double m_loopKp;
+    double m_loopKi;
+    Real m_pilotAccRe;       //!< Pilot baseband integrate and dump
+    Real m_pilotAccIm;
+    Real m_pilotLpRe[2];     //!< Two one pole low pass stages on pilot baseband
+    Real m_pilotLpIm[2];
+    Real m_pilotLpAlpha;
+    Real m_pilotLevel;
+    Real m_lockError;        //!< Average absolute phase error
+    int m_lockCount;
+    int m_lockDelay;
+    static const Real m_minPilotLevel;
+
+    // block buffers
+    std::vector<Real> m_ncoSin;
+    std::vector<Real> m_ncoCos;
+    std::vector<Real> m_monoIn;
+    std::vector<Real> m_stereoIn;
+    std::vector<Real> m_rdsIn;
+    std::vector<Real> m_mono;
+    std::vector<Real> m_stereoOut;
+    std::vector<Real> m_rdsOut;
+    std::vector<Real> m_pilot38;
+    std::vector<Real> m_dummy;
+
+    void processSegment(const Real *mpx, int n);
+    void updatePilotLoop();
+};
+
+#endif // SDRBASE_DSP_BFMCOMPOSITE_H_
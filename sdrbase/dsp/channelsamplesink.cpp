@@ -16,10 +16,33 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "channelsamplesink.h"
 
 ChannelSampleSink::ChannelSampleSink()
 {}
 
 ChannelSampleSink::~ChannelSampleSink()
-{}
\ No newline at end of file
+{}
+
+void ChannelSampleSink::feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end)
+{
+    unsigned int count = end - begin;
+
+    if (m_floatConvertBuffer.size() < count) {
+        m_floatConvertBuffer.resize(count);
+    }
+
+    SampleVector::iterator it = m_floatConvertBuffer.begin();
+
+    for (FSampleVector::const_iterator fit = begin; fit != end; ++fit, ++it)
+    {
+        Real re = std::max(-1.0f, std::min(fit->real(), 1.0f - 1.0f/SDR_RX_SCALEF));
+        Real im = std::max(-1.0f, std::min(fit->imag(), 1.0f - 1.0f/SDR_RX_SCALEF));
+        it->setReal(re * SDR_RX_SCALEF);
+        it->setImag(im * SDR_RX_SCALEF);
+    }
+
+    feed(m_floatConvertBuffer.begin(), m_floatConvertBuffer.begin() + count);
+}
\ No newline at end of file
@@ -32,6 +32,11 @@ public:
 	virtual ~ChannelSampleSink();
 
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end) = 0;
+    /** Float input (full scale 1.0). Default converts to fixed point samples and calls the fixed point feed */
+    virtual void feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end);
+
+protected:
+    SampleVector m_floatConvertBuffer; //!< Used by the default float feed
 };
 
 #endif // SDRBASE_DSP_CHANNELSAMPLESINK_H_
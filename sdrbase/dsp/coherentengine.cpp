@@ -0,0 +1,729 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <algorithm>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include <QDebug>
+
+#include "dsp/samplemififo.h"
+#include "dsp/basebandsamplesink.h"
+
+#include "coherentengine.h"
+
+namespace {
+
+//! re + j.im = sum of a[t].conj(b[t]) for t in [0, n)
+inline void dotConj(const float *aI, const float *aQ, const float *bI, const float *bQ, int n, float& re, float& im)
+{
+    int i = 0;
+    float sumRe = 0.0f;
+    float sumIm = 0.0f;
+
+#if defined(USE_SSE2)
+    __m128 accRe = _mm_setzero_ps();
+    __m128 accIm = _mm_setzero_ps();
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 ar = _mm_loadu_ps(aI + i);
+        __m128 ai = _mm_loadu_ps(aQ + i);
+        __m128 br = _mm_loadu_ps(bI + i);
+        __m128 bi = _mm_loadu_ps(bQ + i);
+        accRe = _mm_add_ps(accRe, _mm_add_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi)));
+        accIm = _mm_add_ps(accIm, _mm_sub_ps(_mm_mul_ps(ai, br), _mm_mul_ps(ar, bi)));
+    }
+
+    float tmp[4];
+    _mm_storeu_ps(tmp, accRe);
+    sumRe = (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+    _mm_storeu_ps(tmp, accIm);
+    sumIm = (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+#endif
+
+    for (; i < n; i++)
+    {
+        sumRe += aI[i]*bI[i] + aQ[i]*bQ[i];
+        sumIm += aQ[i]*bI[i] - aI[i]*bQ[i];
+    }
+
+    re = sumRe;
+    im = sumIm;
+}
+
+//! y[t] (+)= conj(w).x[t] for t in [0, n)
+inline void mulConj(float wr, float wi, const float *xI, const float *xQ, float *yI, float *yQ, int n, bool accumulate)
+{
+    int i = 0;
+
+#if defined(USE_SSE2)
+    __m128 vwr = _mm_set1_ps(wr);
+    __m128 vwi = _mm_set1_ps(wi);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 xr = _mm_loadu_ps(xI + i);
+        __m128 xi = _mm_loadu_ps(xQ + i);
+        __m128 pr = _mm_add_ps(_mm_mul_ps(vwr, xr), _mm_mul_ps(vwi, xi));
+        __m128 pi = _mm_sub_ps(_mm_mul_ps(vwr, xi), _mm_mul_ps(vwi, xr));
+
+        if (accumulate)
+        {
+            pr = _mm_add_ps(pr, _mm_loadu_ps(yI + i));
+            pi = _mm_add_ps(pi, _mm_loadu_ps(yQ + i));
+        }
+
+        _mm_storeu_ps(yI + i, pr);
+        _mm_storeu_ps(yQ + i, pi);
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        float pr = wr*xI[i] + wi*xQ[i];
+        float pi = wr*xQ[i] - wi*xI[i];
+        yI[i] = accumulate ? yI[i] + pr : pr;
+        yQ[i] = accumulate ? yQ[i] + pi : pi;
+    }
+}
+
+} // namespace
+
+CoherentEngine::CoherentEngine(unsigned int nbStreams, unsigned int blockSize, unsigned int maxDelay) :
+    m_nbBlocks(0),
+    m_calibrate(false),
+    m_calibrationReference(0),
+    m_calibrationMaxLag(0),
+    m_covarianceAlpha(0.25f),
+    m_covarianceValid(false),
+    m_beamformerType(BeamformerDelayAndSum),
+    m_diagonalLoading(0.01f),
+    m_factorized(false),
+    m_beamSink(nullptr),
+    m_beamIndex(0)
+{
+    configure(nbStreams, blockSize, maxDelay);
+}
+
+CoherentEngine::~CoherentEngine()
+{}
+
+void CoherentEngine::configure(unsigned int nbStreams, unsigned int blockSize, unsigned int maxDelay)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    m_nbStreams = nbStreams < 1 ? 1 : nbStreams;
+    m_blockSize = blockSize < 16 ? 16 : blockSize;
+    m_maxDelay = maxDelay;
+    m_maxBacklog = 16*m_blockSize;
+    m_maxChunk = 0;
+    m_nbBlocks = 0;
+
+    m_inputs.assign(m_nbStreams, SampleVector());
+    m_blockPointers.resize(m_nbStreams);
+    m_raw.assign(2*m_nbStreams*(m_maxDelay + m_blockSize), 0.0f);
+    m_aligned.assign(2*m_nbStreams*m_blockSize, 0.0f);
+    m_delays.assign(m_nbStreams, 0);
+    m_phases.assign(m_nbStreams, 0.0f);
+    m_calibrate = false;
+
+    m_blockCovariance.assign(m_nbStreams*m_nbStreams, Complex{0.0f, 0.0f});
+    m_covariance.assign(m_nbStreams*m_nbStreams, Complex{0.0f, 0.0f});
+    m_covarianceValid = false;
+
+    m_steeringVectors.clear();
+    m_beamPowers.clear();
+    m_cholesky.assign(m_nbStreams*m_nbStreams, Complex{0.0f, 0.0f});
+    m_work.resize(m_nbStreams);
+    m_weights.resize(m_nbStreams);
+    m_beam.resize(2*m_blockSize);
+    m_beamSamples.resize(m_blockSize);
+}
+
+void CoherentEngine::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, unsigned int streamIndex)
+{
+    if ((streamIndex >= m_nbStreams) || (begin == end)) {
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    m_maxChunk = std::max(m_maxChunk, (unsigned int) (end - begin));
+    append(&(*begin), &(*begin) + (end - begin), streamIndex);
+    drain();
+    checkBacklog(streamIndex);
+}
+
+unsigned int CoherentEngine::work(SampleMIFifo *sampleFifo)
+{
+    if (!sampleFifo || (sampleFifo->getNbStreams() < m_nbStreams)) {
+        return 0;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    const std::vector<SampleVector>& data = sampleFifo->getData();
+    unsigned int iPart1Begin, iPart1End, iPart2Begin, iPart2End;
+    unsigned int count = 0;
+
+    while (sampleFifo->fillSync() > 0)
+    {
+        sampleFifo->readSync(iPart1Begin, iPart1End, iPart2Begin, iPart2End);
+
+        for (unsigned int stream = 0; stream < m_nbStreams; stream++)
+        {
+            if (iPart1Begin != iPart1End) {
+                append(&data[stream][iPart1Begin], &data[stream][0] + iPart1End, stream);
+            }
+
+            if (iPart2Begin != iPart2End) {
+                append(&data[stream][iPart2Begin], &data[stream][0] + iPart2End, stream);
+            }
+        }
+
+        count += (iPart1End - iPart1Begin) + (iPart2End - iPart2Begin);
+        drain();
+    }
+
+    return count;
+}
+
+void CoherentEngine::processBlock(const std::vector<const Sample*>& streams)
+{
+    if (streams.size() < m_nbStreams) {
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    processAligned(streams);
+}
+
+void CoherentEngine::append(const Sample *begin, const Sample *end, unsigned int streamIndex)
+{
+    SampleVector& input = m_inputs[streamIndex];
+    input.insert(input.end(), begin, end);
+}
+
+void CoherentEngine::checkBacklog(unsigned int streamIndex)
+{
+    // only the imbalance between streams matters as complete blocks are drained
+    unsigned int minPending = m_inputs[0].size();
+    unsigned int maxPending = minPending;
+
+    for (unsigned int stream = 1; stream < m_nbStreams; stream++)
+    {
+        minPending = std::min(minPending, (unsigned int) m_inputs[stream].size());
+        maxPending = std::max(maxPending, (unsigned int) m_inputs[stream].size());
+    }
+
+    if (maxPending - minPending > std::max(m_maxBacklog, 2*m_maxChunk)) // other streams are not coming: start over
+    {
+        qWarning("CoherentEngine::checkBacklog: stream %u backlog overflow: resynchronize streams", streamIndex);
+
+        for (std::vector<SampleVector>::iterator it = m_inputs.begin(); it != m_inputs.end(); ++it) {
+            it->clear();
+        }
+    }
+}
+
+void CoherentEngine::drain()
+{
+    unsigned int available = m_inputs[0].size();
+
+    for (unsigned int stream = 1; stream < m_nbStreams; stream++) {
+        available = std::min(available, (unsigned int) m_inputs[stream].size());
+    }
+
+    unsigned int nbBlocks = available / m_blockSize;
+
+    if (nbBlocks == 0) {
+        return;
+    }
+
+    for (unsigned int block = 0; block < nbBlocks; block++)
+    {
+        for (unsigned int stream = 0; stream < m_nbStreams; stream++) {
+            m_blockPointers[stream] = &m_inputs[stream][block*m_blockSize];
+        }
+
+        processAligned(m_blockPointers);
+    }
+
+    for (unsigned int stream = 0; stream < m_nbStreams; stream++) {
+        m_inputs[stream].erase(m_inputs[stream].begin(), m_inputs[stream].begin() + nbBlocks*m_blockSize);
+    }
+}
+
+void CoherentEngine::processAligned(const std::vector<const Sample*>& streams)
+{
+    convert(streams);
+
+    if (m_calibrate)
+    {
+        runCalibration();
+        m_calibrate = false;
+    }
+
+    align();
+    estimateCovariance();
+
+    m_factorized = false;
+
+    if ((m_beamformerType == BeamformerMVDR) && ((m_steeringVectors.size() != 0) || m_beamSink)) {
+        m_factorized = factorize(); // falls back to delay and sum if it fails
+    }
+
+    if (m_steeringVectors.size() != 0) {
+        computeBeamPowers();
+    }
+
+    if (m_beamSink && (m_beamIndex*m_nbStreams < m_steeringVectors.size())) {
+        formBeam();
+    }
+
+    m_nbBlocks++;
+}
+
+void CoherentEngine::convert(const std::vector<const Sample*>& streams)
+{
+    const float scale = 1.0f / SDR_RX_SCALEF;
+
+    for (unsigned int stream = 0; stream < m_nbStreams; stream++)
+    {
+        float *xI = rawI(stream);
+        float *xQ = rawQ(stream);
+        // keep the end of the previous block as history for delays
+        std::copy(xI + m_blockSize, xI + m_blockSize + m_maxDelay, xI);
+        std::copy(xQ + m_blockSize, xQ + m_blockSize + m_maxDelay, xQ);
+        xI += m_maxDelay;
+        xQ += m_maxDelay;
+        const Sample *s = streams[stream];
+
+        for (unsigned int i = 0; i < m_blockSize; i++)
+        {
+            xI[i] = s[i].real() * scale;
+            xQ[i] = s[i].imag() * scale;
+        }
+    }
+}
+
+void CoherentEngine::align()
+{
+    for (unsigned int stream = 0; stream < m_nbStreams; stream++)
+    {
+        unsigned int offset = m_maxDelay - m_delays[stream];
+        mulConj(
+            std::cos(m_phases[stream]), std::sin(m_phases[stream]),
+            rawI(stream) + offset, rawQ(stream) + offset,
+            alignedI(stream), alignedQ(stream),
+            m_blockSize,
+            false
+        );
+    }
+}
+
+void CoherentEngine::estimateCovariance()
+{
+    float re, im;
+
+    for (unsigned int i = 0; i < m_nbStreams; i++)
+    {
+        for (unsigned int j = i; j < m_nbStreams; j++)
+        {
+            dotConj(alignedI(i), alignedQ(i), alignedI(j), alignedQ(j), m_blockSize, re, im);
+            Complex r(re / m_blockSize, im / m_blockSize);
+            m_blockCovariance[i*m_nbStreams + j] = r;
+            m_blockCovariance[j*m_nbStreams + i] = std::conj(r);
+        }
+    }
+
+    if (m_covarianceValid)
+    {
+        for (unsigned int k = 0; k < m_covariance.size(); k++) {
+            m_covariance[k] += m_covarianceAlpha * (m_blockCovariance[k] - m_covariance[k]);
+        }
+    }
+    else
+    {
+        m_covariance = m_blockCovariance;
+        m_covarianceValid = true;
+    }
+}
+
+void CoherentEngine::xcorr(const float *aI, const float *aQ, const float *bI, const float *bQ, int n, int maxLag, std::vector<Complex>& out)
+{
+    float re, im;
+    out.resize(2*maxLag + 1);
+
+    for (int lag = -maxLag; lag <= maxLag; lag++)
+    {
+        dotConj(aI + lag, aQ + lag, bI, bQ, n, re, im);
+        out[maxLag + lag] = Complex(re / n, im / n);
+    }
+}
+
+void CoherentEngine::estimateLag(const std::vector<Complex>& xcorr, float& lag, Complex& peak)
+{
+    if (xcorr.size() == 0)
+    {
+        lag = 0.0f;
+        peak = Complex{0.0f, 0.0f};
+        return;
+    }
+
+    int maxLag = (xcorr.size() - 1) / 2;
+    unsigned int kmax = 0;
+    float mmax = 0.0f;
+
+    for (unsigned int k = 0; k < xcorr.size(); k++)
+    {
+        float m = std::norm(xcorr[k]);
+
+        if (m > mmax)
+        {
+            mmax = m;
+            kmax = k;
+        }
+    }
+
+    float delta = 0.0f;
+
+    if ((kmax > 0) && (kmax < xcorr.size() - 1))
+    {
+        float m0 = std::abs(xcorr[kmax - 1]);
+        float m1 = std::abs(xcorr[kmax]);
+        float m2 = std::abs(xcorr[kmax + 1]);
+        float den = m0 - 2.0f*m1 + m2;
+        delta = den != 0.0f ? 0.5f * (m0 - m2) / den : 0.0f;
+    }
+
+    lag = (int) kmax - maxLag + delta;
+    peak = xcorr[kmax];
+}
+
+void CoherentEngine::crossCorrelate(unsigned int streamA, unsigned int streamB, int maxLag, std::vector<Complex>& xcorrOut)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if ((streamA >= m_nbStreams) || (streamB >= m_nbStreams))
+    {
+        xcorrOut.clear();
+        return;
+    }
+
+    maxLag = std::max(0, std::min(maxLag, (int) m_blockSize / 4));
+    xcorr(
+        alignedI(streamA) + maxLag, alignedQ(streamA) + maxLag,
+        alignedI(streamB) + maxLag, alignedQ(streamB) + maxLag,
+        m_blockSize - 2*maxLag,
+        maxLag,
+        xcorrOut
+    );
+}
+
+void CoherentEngine::calibrate(unsigned int referenceStream, unsigned int maxLag)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_calibrationReference = referenceStream < m_nbStreams ? referenceStream : 0;
+    m_calibrationMaxLag = maxLag;
+    m_calibrate = true;
+}
+
+void CoherentEngine::runCalibration()
+{
+    // relative delays are within [-maxLag, maxLag] so that they fit in the delay line once made positive
+    int maxLag = std::min(m_calibrationMaxLag, std::min(m_maxDelay / 2, m_blockSize / 4));
+    std::vector<int> lags(m_nbStreams, 0);
+    std::vector<Complex> xc;
+    const float *refI = rawI(m_calibrationReference) + m_maxDelay;
+    const float *refQ = rawQ(m_calibrationReference) + m_maxDelay;
+    int maxStreamLag = 0;
+
+    m_phases[m_calibrationReference] = 0.0f;
+
+    for (unsigned int stream = 0; stream < m_nbStreams; stream++)
+    {
+        if (stream == m_calibrationReference) {
+            continue;
+        }
+
+        float lag;
+        Complex peak;
+        xcorr(rawI(stream) + m_maxDelay, rawQ(stream) + m_maxDelay, refI, refQ, m_blockSize - maxLag, maxLag, xc);
+        estimateLag(xc, lag, peak);
+        lags[stream] = std::max(-maxLag, std::min(maxLag, (int) std::round(lag)));
+        m_phases[stream] = std::arg(xc[maxLag + lags[stream]]);
+        maxStreamLag = std::max(maxStreamLag, lags[stream]);
+        qDebug("CoherentEngine::runCalibration: stream %u: lag: %.2f phase: %.3f", stream, lag, m_phases[stream]);
+    }
+
+    // delay each stream so that all match the most delayed one
+    for (unsigned int stream = 0; stream < m_nbStreams; stream++) {
+        m_delays[stream] = maxStreamLag - lags[stream];
+    }
+
+    m_covarianceValid = false;
+}
+
+void CoherentEngine::setAlignment(unsigned int streamIndex, unsigned int delay, float phase)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (streamIndex < m_nbStreams)
+    {
+        m_delays[streamIndex] = std::min(delay, m_maxDelay);
+        m_phases[streamIndex] = phase;
+        m_covarianceValid = false;
+    }
+}
+
+void CoherentEngine::resetAlignment()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    std::fill(m_delays.begin(), m_delays.end(), 0);
+    std::fill(m_phases.begin(), m_phases.end(), 0.0f);
+    m_covarianceValid = false;
+}
+
+void CoherentEngine::getCovariance(std::vector<Complex>& covariance)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    covariance = m_covariance;
+}
+
+void CoherentEngine::setSteeringVectors(const std::vector<Complex>& steeringVectors)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_steeringVectors.assign(steeringVectors.begin(), steeringVectors.begin() + (steeringVectors.size() / m_nbStreams) * m_nbStreams);
+    m_beamPowers.assign(m_steeringVectors.size() / m_nbStreams, 0.0f);
+}
+
+void CoherentEngine::setBeamformer(BeamformerType type, float diagonalLoading)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_beamformerType = type;
+    m_diagonalLoading = diagonalLoading;
+}
+
+void CoherentEngine::getBeamPowers(std::vector<float>& powers)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    powers = m_beamPowers;
+}
+
+void CoherentEngine::setBeamSink(BasebandSampleSink *sink, unsigned int vectorIndex)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_beamSink = sink;
+    m_beamIndex = vectorIndex;
+}
+
+void CoherentEngine::makeULASteeringVectors(
+    unsigned int nbStreams,
+    float spacing,
+    float angleMin,
+    float angleMax,
+    unsigned int nbAngles,
+    std::vector<Complex>& steeringVectors)
+{
+    steeringVectors.resize(nbStreams*nbAngles);
+
+    for (unsigned int k = 0; k < nbAngles; k++)
+    {
+        float angle = nbAngles > 1 ? angleMin + ((angleMax - angleMin) * k) / (nbAngles - 1) : angleMin;
+        float dphi = 2.0f * M_PI * spacing * std::sin(angle);
+
+        for (unsigned int n = 0; n < nbStreams; n++) {
+            steeringVectors[k*nbStreams + n] = std::polar(1.0f, dphi * n);
+        }
+    }
+}
+
+bool CoherentEngine::factorize()
+{
+    unsigned int n = m_nbStreams;
+    float trace = 0.0f;
+
+    for (unsigned int i = 0; i < n; i++) {
+        trace += m_covariance[i*n + i].real();
+    }
+
+    float loading = m_diagonalLoading * (trace / n);
+
+    if (loading <= 0.0f) {
+        loading = 1e-12f;
+    }
+
+    for (unsigned int j = 0; j < n; j++)
+    {
+        float d = m_covariance[j*n + j].real() + loading;
+
+        for (unsigned int k = 0; k < j; k++) {
+            d -= std::norm(m_cholesky[j*n + k]);
+        }
+
+        if (d <= 0.0f) {
+            return false;
+        }
+
+        float ljj = std::sqrt(d);
+        m_cholesky[j*n + j] = Complex(ljj, 0.0f);
+
+        for (unsigned int i = j + 1; i < n; i++)
+        {
+            Complex sum = m_covariance[i*n + j];
+
+            for (unsigned int k = 0; k < j; k++) {
+                sum -= m_cholesky[i*n + k] * std::conj(m_cholesky[j*n + k]);
+            }
+
+            m_cholesky[i*n + j] = sum / ljj;
+        }
+    }
+
+    return true;
+}
+
+void CoherentEngine::solve(const Complex *a, Complex *x)
+{
+    unsigned int n = m_nbStreams;
+
+    // L y = a
+    for (unsigned int i = 0; i < n; i++)
+    {
+        Complex sum = a[i];
+
+        for (unsigned int k = 0; k < i; k++) {
+            sum -= m_cholesky[i*n + k] * m_work[k];
+        }
+
+        m_work[i] = sum / m_cholesky[i*n + i].real();
+    }
+
+    // L^H x = y
+    for (int i = n - 1; i >= 0; i--)
+    {
+        Complex sum = m_work[i];
+
+        for (unsigned int k = i + 1; k < n; k++) {
+            sum -= std::conj(m_cholesky[k*n + i]) * x[k];
+        }
+
+        x[i] = sum / m_cholesky[i*n + i].real();
+    }
+}
+
+void CoherentEngine::computeBeamPowers()
+{
+    unsigned int n = m_nbStreams;
+    unsigned int nbVectors = m_steeringVectors.size() / n;
+
+    for (unsigned int v = 0; v < nbVectors; v++)
+    {
+        const Complex *a = &m_steeringVectors[v*n];
+
+        if (m_factorized) // MVDR: 1 / a^H R^-1 a = 1 / |L^-1 a|^2
+        {
+            float q = 0.0f;
+
+            for (unsigned int i = 0; i < n; i++)
+            {
+                Complex sum = a[i];
+
+                for (unsigned int k = 0; k < i; k++) {
+                    sum -= m_cholesky[i*n + k] * m_work[k];
+                }
+
+                m_work[i] = sum / m_cholesky[i*n + i].real();
+                q += std::norm(m_work[i]);
+            }
+
+            m_beamPowers[v] = q > 0.0f ? 1.0f / q : 0.0f;
+        }
+        else // delay and sum: a^H R a / (a^H a)^2
+        {
+            float p = 0.0f;
+            float norm = 0.0f;
+
+            for (unsigned int i = 0; i < n; i++)
+            {
+                Complex ra(0.0f, 0.0f);
+
+                for (unsigned int j = 0; j < n; j++) {
+                    ra += m_covariance[i*n + j] * a[j];
+                }
+
+                p += (std::conj(a[i]) * ra).real();
+                norm += std::norm(a[i]);
+            }
+
+            m_beamPowers[v] = norm > 0.0f ? p / (norm*norm) : 0.0f;
+        }
+    }
+}
+
+void CoherentEngine::formBeam()
+{
+    unsigned int n = m_nbStreams;
+    const Complex *a = &m_steeringVectors[m_beamIndex*n];
+    Complex den(0.0f, 0.0f);
+
+    if (m_factorized) // w = R^-1 a / a^H R^-1 a
+    {
+        solve(a, m_weights.data());
+
+        for (unsigned int i = 0; i < n; i++) {
+            den += std::conj(a[i]) * m_weights[i];
+        }
+    }
+    else // w = a / a^H a
+    {
+        for (unsigned int i = 0; i < n; i++)
+        {
+            m_weights[i] = a[i];
+            den += std::norm(a[i]);
+        }
+    }
+
+    if (std::norm(den) == 0.0f) {
+        return;
+    }
+
+    // y = sum of conj(w_i).x_i
+    float *yI = &m_beam[0];
+    float *yQ = &m_beam[m_blockSize];
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        Complex w = m_weights[i] / den; // den is real as R is hermitian
+        mulConj(w.real(), w.imag(), alignedI(i), alignedQ(i), yI, yQ, m_blockSize, i != 0);
+    }
+
+    const float maxValue = SDR_RX_SCALEF - 1.0f;
+
+    for (unsigned int t = 0; t < m_blockSize; t++)
+    {
+        float re = std::max(-maxValue, std::min(maxValue, yI[t] * SDR_RX_SCALEF));
+        float im = std::max(-maxValue, std::min(maxValue, yQ[t] * SDR_RX_SCALEF));
+        m_beamSamples[t].setReal((FixReal) re);
+        m_beamSamples[t].setImag((FixReal) im);
+    }
+
+    m_beamSink->feed(m_beamSamples.begin(), m_beamSamples.end(), false);
+}
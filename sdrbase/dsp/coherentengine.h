@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_COHERENTENGINE_H_
+#define SDRBASE_DSP_COHERENTENGINE_H_
+
+#include <vector>
+
+#include <QMutex>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class SampleMIFifo;
+class BasebandSampleSink;
+
+/**
+ * Block synchronous processing of N coherent streams for MIMO channels
+ * (direction finding, interferometry, beamforming).
+ *
+ * Samples come either from MIMOChannel::feed (one stream after the other) or directly from a
+ * synchronous SampleMIFifo. They are gathered in blocks of m_blockSize samples per stream that
+ * are processed only when all streams have a complete block so that blocks are always aligned.
+ *
+ * Each block is converted to planar float arrays (separate I and Q) then:
+ *   - aligned: each stream can be delayed by an integer number of samples and rotated by a
+ *     constant phase. calibrate() estimates these from the cross correlation with a reference.
+ *   - the spatial covariance matrix R[i][j] = <x_i conj(x_j)> is estimated and averaged.
+ *   - for each steering vector a the beam power is computed from R either as delay and sum
+ *     a^H R a / (a^H a)^2 or as MVDR (Capon) 1 / (a^H R^-1 a) using a Cholesky factorization of
+ *     R with diagonal loading. Scanning many vectors is therefore cheap: O(N^2) per vector.
+ *   - optionally one beam is formed in time domain and fed to a baseband sample sink.
+ * Correlation and beam forming inner loops work on planar data with SSE2 four samples at a time.
+ */
+class SDRBASE_API CoherentEngine
+{
+public:
+    enum BeamformerType
+    {
+        BeamformerDelayAndSum,
+        BeamformerMVDR
+    };
+
+    CoherentEngine(unsigned int nbStreams = 2, unsigned int blockSize = 4096, unsigned int maxDelay = 64);
+    ~CoherentEngine();
+
+    void configure(unsigned int nbStreams, unsigned int blockSize, unsigned int maxDelay = 64);
+    unsigned int getNbStreams() const { return m_nbStreams; }
+    unsigned int getBlockSize() const { return m_blockSize; }
+    quint64 getNbBlocks() const { return m_nbBlocks; }
+
+    // Input
+    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, unsigned int streamIndex); //!< For MIMOChannel::feed
+    unsigned int work(SampleMIFifo *sampleFifo); //!< Consume all synchronous data of the FIFO. Returns number of samples per stream
+    void processBlock(const std::vector<const Sample*>& streams); //!< Process one aligned block of m_blockSize samples per stream
+
+    // Alignment
+    void setAlignment(unsigned int streamIndex, unsigned int delay, float phase); //!< delay in samples (<= max delay) and phase in radians
+    void resetAlignment();
+    void calibrate(unsigned int referenceStream, unsigned int maxLag); //!< Estimate and apply delays and phases on the next block
+    unsigned int getDelay(unsigned int streamIndex) const { return m_delays[streamIndex]; }
+    float getPhase(unsigned int streamIndex) const { return m_phases[streamIndex]; }
+
+    // Correlation
+    void setCovarianceAveraging(float alpha) { m_covarianceAlpha = alpha; } //!< Weight of the last block in the covariance average (1: no averaging)
+    void getCovariance(std::vector<Complex>& covariance); //!< N x N row major matrix
+    void crossCorrelate(unsigned int streamA, unsigned int streamB, int maxLag, std::vector<Complex>& xcorr); //!< On last aligned block. xcorr[maxLag + l] = <a[t+l] conj(b[t])>
+    static void estimateLag(const std::vector<Complex>& xcorr, float& lag, Complex& peak); //!< Peak of a cross correlation with parabolic interpolation
+
+    // Beamforming
+    void setSteeringVectors(const std::vector<Complex>& steeringVectors); //!< Any number of vectors of N complex weights one after the other
+    void setBeamformer(BeamformerType type, float diagonalLoading = 0.01f); //!< Loading relative to the average stream power
+    void getBeamPowers(std::vector<float>& powers); //!< Power of each steering vector for the averaged covariance
+    void setBeamSink(BasebandSampleSink *sink, unsigned int vectorIndex); //!< Feed the beam of this steering vector to the sink (nullptr to stop)
+    static void makeULASteeringVectors( //!< Steering vectors of an uniform linear array for angles from broadside in radians
+        unsigned int nbStreams,
+        float spacing, //!< element spacing in wavelengths
+        float angleMin,
+        float angleMax,
+        unsigned int nbAngles,
+        std::vector<Complex>& steeringVectors
+    );
+
+private:
+    unsigned int m_nbStreams;
+    unsigned int m_blockSize;
+    unsigned int m_maxDelay;
+    quint64 m_nbBlocks;
+
+    std::vector<SampleVector> m_inputs; //!< Samples waiting for a complete block on all streams
+    unsigned int m_maxBacklog;          //!< Inputs are resynchronized beyond this imbalance between streams (samples)
+    unsigned int m_maxChunk;            //!< Largest chunk fed to a single stream: the tolerated imbalance is at least twice this
+    std::vector<const Sample*> m_blockPointers;
+    std::vector<float> m_raw;     //!< Planar raw samples with m_maxDelay history: per stream I then Q of m_maxDelay + m_blockSize
+    std::vector<float> m_aligned; //!< Planar aligned samples: per stream I then Q of m_blockSize
+
+    std::vector<unsigned int> m_delays;
+    std::vector<float> m_phases;
+    bool m_calibrate;
+    unsigned int m_calibrationReference;
+    unsigned int m_calibrationMaxLag;
+
+    float m_covarianceAlpha;
+    std::vector<Complex> m_blockCovariance;
+    std::vector<Complex> m_covariance;
+    bool m_covarianceValid;
+
+    BeamformerType m_beamformerType;
+    float m_diagonalLoading;
+    bool m_factorized; //!< Cholesky factor of the current covariance is available (MVDR)
+    std::vector<Complex> m_steeringVectors;
+    std::vector<float> m_beamPowers;
+    std::vector<Complex> m_cholesky; //!< Lower triangular factor of the loaded covariance
+    std::vector<Complex> m_work;
+    std::vector<Complex> m_weights;
+    BasebandSampleSink *m_beamSink;
+    unsigned int m_beamIndex;
+    std::vector<float> m_beam; //!< Planar beam output
+    SampleVector m_beamSamples;
+
+    QMutex m_mutex;
+
+    float *rawI(unsigned int streamIndex) { return &m_raw[2*streamIndex*(m_maxDelay + m_blockSize)]; }
+    float *rawQ(unsigned int streamIndex) { return &m_raw[(2*streamIndex + 1)*(m_maxDelay + m_blockSize)]; }
+    float *alignedI(unsigned int streamIndex) { return &m_aligned[2*streamIndex*m_blockSize]; }
+    float *alignedQ(unsigned int streamIndex) { return &m_aligned[(2*streamIndex + 1)*m_blockSize]; }
+
+    void append(const Sample *begin, const Sample *end, unsigned int streamIndex);
+    void checkBacklog(unsigned int streamIndex); //!< Resynchronize if one stream runs too far ahead of the others
+    void drain(); //!< Process all blocks complete on all streams
+    void processAligned(const std::vector<const Sample*>& streams);
+    void convert(const std::vector<const Sample*>& streams);
+    void runCalibration();
+    void align();
+    void estimateCovariance();
+    void computeBeamPowers();
+    bool factorize(); //!< Cholesky factorization of the loaded covariance
+    void solve(const Complex *a, Complex *x); //!< Solve R x = a with the Cholesky factor
+    void formBeam();
+    static void xcorr(const float *aI, const float *aQ, const float *bI, const float *bQ, int n, int maxLag, std::vector<Complex>& out);
+};
+
+#endif // SDRBASE_DSP_COHERENTENGINE_H_
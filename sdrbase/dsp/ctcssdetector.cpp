@@ -4,94 +4,43 @@
  *  Created on: Jun 16, 2015
  *      Author: f4exb
  */
-#include <math.h>
 #include "dsp/ctcssdetector.h"
 
-#undef M_PI
-#define M_PI		3.14159265358979323846
+const Real CTCSSDetector::m_standardTones[] = {
+	 67.0,  69.3,  71.9,  74.4,  77.0,  79.7,  82.5,  85.4,  88.5,  91.5,
+	 94.8,  97.4, 100.0, 103.5, 107.2, 110.9, 114.8, 118.8, 123.0, 127.3,
+	131.8, 136.5, 141.3, 146.2, 151.4, 156.7, 159.8, 162.2, 165.5, 167.9,
+	171.3, 173.8, 177.3, 179.9, 183.5, 186.2, 189.9, 192.8, 196.6, 199.5,
+	203.5, 206.5, 210.7, 218.1, 225.7, 229.1, 233.6, 241.8, 250.3, 254.1
+};
 
 CTCSSDetector::CTCSSDetector() :
 			N(0),
 			sampleRate(0),
-			samplesProcessed(0),
+			nTones(m_nbStandardTones),
 			maxPowerIndex(0),
 			toneDetected(false),
-			maxPower(0.0)
+			maxPower(0.0),
+			aboveAvg(2.0), // Arbitrary max power above average threshold
+			toneSet(m_standardTones, m_standardTones + m_nbStandardTones)
 {
-	nTones = 32;
-	k = new Real[nTones];
-	coef = new Real[nTones];
-	toneSet = new Real[nTones];
-	u0 = new Real[nTones];
-	u1 = new Real[nTones];
-	power = new Real[nTones];
-
-	// The 32 EIA standard tones
-	toneSet[0]  = 67.0;
-	toneSet[1]  = 71.9;
-	toneSet[2]  = 74.4;
-	toneSet[3]  = 77.0;
-	toneSet[4]  = 79.7;
-	toneSet[5]  = 82.5;
-	toneSet[6]  = 85.4;
-	toneSet[7]  = 88.5;
-	toneSet[8]  = 91.5;
-	toneSet[9]  = 94.8;
-	toneSet[10]  = 97.4;
-	toneSet[11] = 100.0;
-	toneSet[12] = 103.5;
-	toneSet[13] = 107.2;
-	toneSet[14] = 110.9;
-	toneSet[15] = 114.8;
-	toneSet[16] = 118.8;
-	toneSet[17] = 123.0;
-	toneSet[18] = 127.3;
-	toneSet[19] = 131.8;
-	toneSet[20] = 136.5;
-	toneSet[21] = 141.3;
-	toneSet[22] = 146.2;
-	toneSet[23] = 151.4;
-	toneSet[24] = 156.7;
-	toneSet[25] = 162.2;
-	toneSet[26] = 167.9;
-	toneSet[27] = 173.8;
-	toneSet[28] = 179.9;
-	toneSet[29] = 186.2;
-	toneSet[30] = 192.8;
-	toneSet[31] = 203.5;
 }
 
-CTCSSDetector::CTCSSDetector(int _nTones, Real *tones) :
+CTCSSDetector::CTCSSDetector(int _nTones, const Real *tones) :
 			N(0),
 			sampleRate(0),
-			samplesProcessed(0),
+			nTones(_nTones),
 			maxPowerIndex(0),
 			toneDetected(false),
-			maxPower(0.0)
+			maxPower(0.0),
+			aboveAvg(2.0),
+			toneSet(tones, tones + _nTones)
 {
-	nTones = _nTones;
-	k = new Real[nTones];
-	coef = new Real[nTones];
-	toneSet = new Real[nTones];
-	u0 = new Real[nTones];
-	u1 = new Real[nTones];
-	power = new Real[nTones];
-
-	for (int j = 0; j < nTones; ++j)
-	{
-		toneSet[j] = tones[j];
-	}
 }
 
 
 CTCSSDetector::~CTCSSDetector()
 {
-	delete[] k;
-	delete[] coef;
-	delete[] toneSet;
-	delete[] u0;
-	delete[] u1;
-	delete[] power;
 }
 
 
@@ -100,32 +49,33 @@ void CTCSSDetector::setCoefficients(int zN, int _samplerate )
 	N = zN;                   // save the basic parameters for use during analysis
 	sampleRate = _samplerate;
 
-	// for each of the frequencies (tones) of interest calculate
-	// k and the associated filter coefficient as per the Goertzel
-	// algorithm. Note: we are using a real value (as apposed to
-	// an integer as described in some references. k is retained
-	// for later display. The tone set is specified in the
-	// constructor. Notice that the resulting coefficients are
-	// independent of N.
-	for (int j = 0; j < nTones; ++j)
-	{
-		k[j] = ((double)N * toneSet[j]) / (double)sampleRate;
-		coef[j] = 2.0 * cos((2.0 * M_PI * toneSet[j])/(double)sampleRate);
-	}
+	// The Goertzel bank calculates the filter coefficient of each
+	// frequency (tone) of interest. Note: we are using a real value
+	// of k (as apposed to an integer as described in some references).
+	// The coefficients are independent of N.
+	bank.configure(1, toneSet, sampleRate, N);
+	reset();
+}
+
+
+void CTCSSDetector::setThreshold(double thold)
+{
+	aboveAvg = thold;
 }
 
 
 // Analyze an input signal for the presence of CTCSS tones.
 bool CTCSSDetector::analyze(Real *sample)
 {
+	return analyze(sample, 1);
+}
 
-	feedback(*sample); // Goertzel feedback
-	samplesProcessed += 1;
 
-	if (samplesProcessed == N) // completed a block of N
+bool CTCSSDetector::analyze(const Real *samples, unsigned int nbSamples)
+{
+	if (bank.feed(samples, nbSamples) > 0) // completed a block of N
 	{
-		feedForward(); // calculate the power at each tone
-		samplesProcessed = 0;
+		evaluatePower(); // look at the power of each tone
 		return true; // have a result
 	}
 	else
@@ -135,61 +85,24 @@ bool CTCSSDetector::analyze(Real *sample)
 }
 
 
-void CTCSSDetector::feedback(Real in)
-{
-	Real t;
-
-	// feedback for each tone
-	for (int j = 0; j < nTones; ++j)
-	{
-		t = u0[j];
-		u0[j] = in + (coef[j] * u0[j]) - u1[j];
-		u1[j] = t;
-	}
-}
-
-
-void CTCSSDetector::feedForward()
-{
-	initializePower();
-
-	for (int j = 0; j < nTones; ++j)
-	{
-		power[j] = (u0[j] * u0[j]) + (u1[j] * u1[j]) - (coef[j] * u0[j] * u1[j]);
-		u0[j] = u1[j] = 0.0; // reset for next block.
-	}
-
-	evaluatePower();
-}
-
-
 void CTCSSDetector::reset()
 {
-	for (int j = 0; j < nTones; ++j)
-	{
-		power[j] = u0[j] = u1[j] = 0.0; // reset
-	}
-
-	samplesProcessed = 0;
+	bank.reset();
 	maxPower = 0.0;
 	maxPowerIndex = 0;
 	toneDetected = false;
 }
 
 
-void CTCSSDetector::initializePower()
+void CTCSSDetector::evaluatePower()
 {
-	for (int j = 0; j < nTones; ++j)
-	{
-		power[j] = 0.0; // reset
-	}
+	toneDetected = evaluatePower(bank.getPowers(0), nTones, aboveAvg, maxPowerIndex, maxPower);
 }
 
 
-void CTCSSDetector::evaluatePower()
+bool CTCSSDetector::evaluatePower(const float *power, int nTones, Real aboveAvg, int& maxPowerIndex, Real& maxPower)
 {
 	Real sumPower = 0.0;
-	Real aboveAvg = 2.0; // Arbitrary max power above average threshold
 	maxPower = 0.0;
 
 	for (int j = 0; j < nTones; ++j)
@@ -203,5 +116,5 @@ void CTCSSDetector::evaluatePower()
 		}
 	}
 
-	toneDetected = (maxPower > (sumPower/nTones) + aboveAvg);
+	return nTones > 0 && (maxPower > (sumPower/nTones) + aboveAvg);
 }
@@ -9,19 +9,23 @@
 #ifndef INCLUDE_GPL_DSP_CTCSSDETECTOR_H_
 #define INCLUDE_GPL_DSP_CTCSSDETECTOR_H_
 
+#include <vector>
+
 #include "dsp/dsptypes.h"
+#include "dsp/goertzelbank.h"
 #include "export.h"
 
 /** CTCSSDetector: Continuous Tone Coded Squelch System
  * tone detector class based on the Modified Goertzel
- * algorithm.
+ * algorithm. All tones are analyzed at once over blocks
+ * of samples by a vectorized Goertzel bank.
  */
 class SDRBASE_API CTCSSDetector {
 public:
     // Constructors and Destructor
-    CTCSSDetector();
+    CTCSSDetector(); // the 50 standard tones
     // allows user defined CTCSS tone set
-    CTCSSDetector(int _nTones, Real *tones);
+    CTCSSDetector(int _nTones, const Real *tones);
     virtual ~CTCSSDetector();
 
     // setup the basic parameters and coefficients
@@ -29,13 +33,17 @@ public:
     		int zN,            // the algorithm "block"  size
 			int SampleRate);  // input signal sample rate
 
-    // set the detection threshold
+    // set the detection threshold: max power above average power
     void setThreshold(double thold);
 
     // analyze a sample set and optionally filter
     // the tone frequencies.
     bool analyze(Real *sample); // input signal sample
 
+    // analyze a block of samples. Returns true if at least
+    // one analysis period was completed in the block.
+    bool analyze(const Real *samples, unsigned int nbSamples);
+
     // get the number of defined tones.
     int getNTones() const {
     	return nTones;
@@ -44,7 +52,7 @@ public:
     // get the tone set
     const Real *getToneSet() const
     {
-    	return toneSet;
+    	return toneSet.data();
     }
 
     // get the currently detected tone, if any
@@ -62,27 +70,27 @@ public:
 
     void reset();                       // reset the analysis algorithm
 
+    // Find the strongest tone in a set of tone powers. Returns true if it is
+    // above the average power plus aboveAvg.
+    static bool evaluatePower(const float *power, int nTones, Real aboveAvg, int& maxPowerIndex, Real& maxPower);
+
+    static const int m_nbStandardTones = 50;
+    static const Real m_standardTones[]; // the 50 standard tones in ascending order
+
 protected:
-    // Override these to change behavior of the detector
-    virtual void initializePower();
+    // Override this to change behavior of the detector
     virtual void evaluatePower();
-    void feedback(Real sample);
-    void feedForward();
 
 private:
     int N;
     int sampleRate;
     int nTones;
-    int samplesProcessed;
     int maxPowerIndex;
     bool toneDetected;
     Real maxPower;
-    Real *k;
-    Real *coef;
-    Real *toneSet;
-    Real *u0;
-    Real *u1;
-    Real *power;
+    Real aboveAvg;
+    std::vector<Real> toneSet;
+    GoertzelBank bank;
 };
 
 
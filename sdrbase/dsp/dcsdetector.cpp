@@ -0,0 +1,209 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dcsdetector.h"
+
+namespace
+{
+
+static const unsigned int wordBits = 23;
+static const unsigned int wordMask = (1U << wordBits) - 1;
+static const unsigned int invertedFlag = 0x100;
+
+unsigned int rotate(unsigned int word)
+{
+    return (word >> 1) | ((word & 1) << (wordBits - 1));
+}
+
+} // namespace
+
+const unsigned short DCSDetector::m_codes[] = {
+    0023, 0025, 0026, 0031, 0032, 0036, 0043, 0047, 0051, 0053, 0054, 0065, 0071, 0072, 0073, 0074,
+    0114, 0115, 0116, 0122, 0125, 0131, 0132, 0134, 0143, 0145, 0152, 0155, 0156, 0162, 0165, 0172,
+    0174, 0205, 0212, 0223, 0225, 0226, 0243, 0244, 0245, 0246, 0251, 0252, 0255, 0261, 0263, 0265,
+    0266, 0271, 0274, 0306, 0311, 0315, 0325, 0331, 0332, 0343, 0346, 0351, 0356, 0364, 0365, 0371,
+    0411, 0412, 0413, 0423, 0431, 0432, 0445, 0446, 0452, 0454, 0455, 0462, 0464, 0465, 0466, 0503,
+    0506, 0516, 0523, 0526, 0532, 0546, 0565, 0606, 0612, 0624, 0627, 0631, 0632, 0654, 0662, 0664,
+    0703, 0712, 0723, 0731, 0732, 0734, 0743, 0754
+};
+
+const Real DCSDetector::m_bitRate = 134.4;
+
+DCSDetector::DCSDetector() :
+    m_sampleRate(0),
+    m_phaseIncrement(0.0),
+    m_dcAlpha(0.0)
+{
+    reset();
+}
+
+void DCSDetector::setSampleRate(int sampleRate)
+{
+    m_sampleRate = sampleRate;
+    m_phaseIncrement = sampleRate > 0 ? m_bitRate / sampleRate : 0.0;
+    m_dcAlpha = sampleRate > 0 ? 1.0 / sampleRate : 0.0; // ~1s time constant
+    reset();
+}
+
+void DCSDetector::reset()
+{
+    m_phase = 0.0;
+    m_dc = 0.0;
+    m_lastLevel = false;
+    m_shiftRegister = 0;
+    m_matchCode = 0;
+    m_matchCount = 0;
+    m_missCount = 0;
+    m_detected = false;
+    m_code = 0;
+    m_inverted = false;
+}
+
+bool DCSDetector::analyze(const Real *samples, unsigned int nbSamples)
+{
+    bool changed = false;
+
+    for (unsigned int k = 0; k < nbSamples; k++)
+    {
+        m_dc += (samples[k] - m_dc) * m_dcAlpha;
+        bool level = samples[k] > m_dc;
+
+        if (level != m_lastLevel) // transition: pull the bit boundary towards it
+        {
+            m_phase -= 0.25 * (m_phase < 0.5 ? m_phase : m_phase - 1.0);
+            m_lastLevel = level;
+        }
+
+        Real previousPhase = m_phase;
+        m_phase += m_phaseIncrement;
+
+        if ((previousPhase < 0.5) && (m_phase >= 0.5)) { // middle of the bit
+            changed = processBit(level) || changed;
+        }
+
+        if (m_phase >= 1.0) {
+            m_phase -= 1.0;
+        }
+    }
+
+    return changed;
+}
+
+bool DCSDetector::processBit(bool bit)
+{
+    m_shiftRegister = (m_shiftRegister >> 1) | ((bit ? 1U : 0U) << (wordBits - 1));
+    const std::map<unsigned int, unsigned int>& table = codewords();
+    std::map<unsigned int, unsigned int>::const_iterator it = table.find(m_shiftRegister);
+
+    if (it == table.end())
+    {
+        m_matchCount = 0;
+
+        if (m_detected && (++m_missCount > 2*wordBits))
+        {
+            m_detected = false;
+            return true;
+        }
+
+        return false;
+    }
+
+    m_missCount = 0;
+
+    if (it->second == m_matchCode)
+    {
+        m_matchCount++;
+    }
+    else
+    {
+        m_matchCode = it->second;
+        m_matchCount = 1;
+    }
+
+    if (m_matchCount < wordBits) {
+        return false;
+    }
+
+    unsigned int code = m_codes[(m_matchCode & ~invertedFlag) - 1];
+    bool inverted = (m_matchCode & invertedFlag) != 0;
+
+    if (m_detected && (code == m_code) && (inverted == m_inverted)) {
+        return false;
+    }
+
+    m_detected = true;
+    m_code = code;
+    m_inverted = inverted;
+    return true;
+}
+
+unsigned int DCSDetector::getCodeword(unsigned int code)
+{
+    // Golay (23,12): 9 code bits, "100" then 11 parity bits
+    unsigned int data = (code & 0x1FF) | 0x800;
+    unsigned int cw = data;
+
+    for (int i = 0; i < 12; i++)
+    {
+        if (cw & 1) {
+            cw ^= 0xC75;
+        }
+
+        cw >>= 1;
+    }
+
+    return ((cw << 12) | data) & wordMask;
+}
+
+QString DCSDetector::getCodeName(unsigned int code, bool inverted)
+{
+    return QString("%1%2").arg(code, 3, 8, QChar('0')).arg(inverted ? "I" : "N");
+}
+
+const std::map<unsigned int, unsigned int>& DCSDetector::codewords()
+{
+    static const std::map<unsigned int, unsigned int> table = []() {
+        std::map<unsigned int, unsigned int> t;
+
+        // Each inverted code is the alias of a normal code (ex: 047I is 023N) so normal codes come first
+        for (int polarity = 0; polarity < 2; polarity++)
+        {
+            for (int i = 0; i < m_nbCodes; i++)
+            {
+                unsigned int word = getCodeword(m_codes[i]);
+
+                for (unsigned int r = 0; r < wordBits; r++)
+                {
+                    if (polarity == 0) {
+                        t.insert(std::make_pair(word, (unsigned int) i + 1));
+                    } else { // insert does not replace an existing alias
+                        t.insert(std::make_pair(~word & wordMask, (unsigned int) (i + 1) | invertedFlag));
+                    }
+
+                    word = rotate(word);
+                }
+            }
+        }
+
+        qDebug("DCSDetector::codewords: %u words", (unsigned int) t.size());
+        return t;
+    }();
+
+    return table;
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_DCSDETECTOR_H_
+#define SDRBASE_DSP_DCSDETECTOR_H_
+
+#include <map>
+
+#include <QString>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Digital Coded Squelch (DCS) detector.
+ *
+ * DCS sends continuously a 23 bit Golay codeword at 134.4 bit/s NRZ below the voice band.
+ * The input is the low passed audio (below 300 Hz) at a low sample rate. Bits are sliced
+ * with a zero crossing clock recovery and the last 23 bits are looked up among all the
+ * rotations of the standard codes in normal and inverted polarity. A code is detected when
+ * it is seen for a whole codeword and lost after two codewords without a match.
+ * Codes sharing the same rotations (aliases) are reported as the first one of the standard list.
+ */
+class SDRBASE_API DCSDetector
+{
+public:
+    DCSDetector();
+
+    void setSampleRate(int sampleRate);
+    void reset();
+
+    /** Analyze a block of samples. Returns true when the detected code has changed. */
+    bool analyze(const Real *samples, unsigned int nbSamples);
+
+    /** Get the currently detected code if any. code is the octal code as written (ex: 023 is 0x13) */
+    bool getDetectedCode(unsigned int& code, bool& inverted) const
+    {
+        code = m_code;
+        inverted = m_inverted;
+        return m_detected;
+    }
+
+    static QString getCodeName(unsigned int code, bool inverted); //!< ex: "023N" or "023I"
+    static unsigned int getCodeword(unsigned int code); //!< 23 bit codeword of a code with the first bit sent as LSB
+
+    static const int m_nbCodes = 104;
+    static const unsigned short m_codes[]; //!< standard codes in ascending order
+    static const Real m_bitRate;
+
+private:
+    int m_sampleRate;
+    Real m_phaseIncrement; //!< bit period fraction per sample
+    Real m_phase;          //!< bit period fraction. Transitions at 0 bits sampled at 0.5
+    Real m_dc;
+    Real m_dcAlpha;
+    bool m_lastLevel;
+    unsigned int m_shiftRegister;
+    unsigned int m_matchCode;  //!< code index + 1 and polarity flag of the last match
+    unsigned int m_matchCount; //!< consecutive bits matching m_matchCode
+    unsigned int m_missCount;  //!< consecutive bits without a match
+    bool m_detected;
+    unsigned int m_code;
+    bool m_inverted;
+
+    bool processBit(bool bit);
+
+    //! codeword rotations (and complements) to code index + 1 (bit 8 set for inverted polarity)
+    static const std::map<unsigned int, unsigned int>& codewords();
+};
+
+#endif // SDRBASE_DSP_DCSDETECTOR_H_
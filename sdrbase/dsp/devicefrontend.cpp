@@ -0,0 +1,599 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <QDebug>
+
+#include "dsp/devicesamplestatic.h"
+#include "dsp/hbfiltertraits.h"
+
+#include "devicefrontend.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DEVICEFRONTEND_X86
+#include <immintrin.h>
+#endif
+
+#if defined(USE_NEON) || defined(__ARM_NEON)
+#define DEVICEFRONTEND_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+static const int hbOrder = 64;
+static const int hbHistory = hbOrder;          //!< Input samples kept between blocks
+static const int hbTaps = hbOrder / 4;         //!< Distinct non zero side taps
+static const unsigned int phasorBlock = 8;     //!< Largest vector length of the shift kernels
+static const float sampleMax = SDR_RX_SCALEF - 1.0f;
+
+struct Kernels
+{
+    const char *m_name;
+    void (*convertU8)(const quint8 *in, unsigned int n, float offset, float scale, float *out);
+    void (*convertS8)(const qint8 *in, unsigned int n, float scale, float *out);
+    void (*convertS16)(const qint16 *in, unsigned int n, float scale, float *out);
+    void (*convertF32)(const float *in, unsigned int n, float scale, float *out);
+    void (*deinterleave)(const float *in, unsigned int nbPairs, float *even, float *odd);
+    void (*rotate)(float *i, float *q, unsigned int n, const float *c, const float *s, unsigned int period, unsigned int& phase);
+    void (*hbDecimate)(const float *even, const float *odd, unsigned int nbOut, const float *taps, float *out);
+    void (*toSamples)(const float *i, const float *q, unsigned int n, Sample *out);
+};
+
+// Generic kernels
+
+void convertU8Generic(const quint8 *in, unsigned int n, float offset, float scale, float *out)
+{
+    for (unsigned int k = 0; k < n; k++) {
+        out[k] = (in[k] - offset) * scale;
+    }
+}
+
+void convertS8Generic(const qint8 *in, unsigned int n, float scale, float *out)
+{
+    for (unsigned int k = 0; k < n; k++) {
+        out[k] = in[k] * scale;
+    }
+}
+
+void convertS16Generic(const qint16 *in, unsigned int n, float scale, float *out)
+{
+    for (unsigned int k = 0; k < n; k++) {
+        out[k] = in[k] * scale;
+    }
+}
+
+void convertF32Generic(const float *in, unsigned int n, float scale, float *out)
+{
+    for (unsigned int k = 0; k < n; k++) {
+        out[k] = in[k] * scale;
+    }
+}
+
+void deinterleaveGeneric(const float *in, unsigned int nbPairs, float *even, float *odd)
+{
+    for (unsigned int k = 0; k < nbPairs; k++)
+    {
+        even[k] = in[2*k];
+        odd[k] = in[2*k+1];
+    }
+}
+
+void rotateGeneric(float *i, float *q, unsigned int n, const float *c, const float *s, unsigned int period, unsigned int& phase)
+{
+    for (unsigned int k = 0; k < n; k++)
+    {
+        float re = i[k] * c[phase] - q[k] * s[phase];
+        float im = i[k] * s[phase] + q[k] * c[phase];
+        i[k] = re;
+        q[k] = im;
+        phase = (phase + 1) & (period - 1);
+    }
+}
+
+inline float hbOutput(const float *even, const float *odd, unsigned int k, const float *taps)
+{
+    float acc = 0.5f * even[k + hbTaps];
+
+    for (int m = 0; m < hbTaps; m++) {
+        acc += taps[m] * (odd[k + m] + odd[k + 2*hbTaps - 1 - m]);
+    }
+
+    return acc;
+}
+
+void hbDecimateGeneric(const float *even, const float *odd, unsigned int nbOut, const float *taps, float *out)
+{
+    for (unsigned int k = 0; k < nbOut; k++) {
+        out[k] = hbOutput(even, odd, k, taps);
+    }
+}
+
+void toSamplesGeneric(const float *i, const float *q, unsigned int n, Sample *out)
+{
+    for (unsigned int k = 0; k < n; k++)
+    {
+        out[k].setReal((FixReal) lrintf(std::min(std::max(i[k], -sampleMax), sampleMax)));
+        out[k].setImag((FixReal) lrintf(std::min(std::max(q[k], -sampleMax), sampleMax)));
+    }
+}
+
+const Kernels genericKernels = {
+    "generic",
+    convertU8Generic,
+    convertS8Generic,
+    convertS16Generic,
+    convertF32Generic,
+    deinterleaveGeneric,
+    rotateGeneric,
+    hbDecimateGeneric,
+    toSamplesGeneric
+};
+
+#if defined(DEVICEFRONTEND_X86)
+
+// AVX2 kernels. Compiled for AVX2/FMA whatever the build flags and only called when the processor supports them.
+
+__attribute__((target("avx2,fma")))
+void convertU8AVX2(const quint8 *in, unsigned int n, float offset, float scale, float *out)
+{
+    __m256 vOffset = _mm256_set1_ps(offset);
+    __m256 vScale = _mm256_set1_ps(scale);
+    unsigned int k = 0;
+
+    for (; k + 16 <= n; k += 16)
+    {
+        __m128i b = _mm_loadu_si128((const __m128i*) &in[k]);
+        __m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(b));
+        __m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(b, 8)));
+        _mm256_storeu_ps(&out[k], _mm256_mul_ps(_mm256_sub_ps(lo, vOffset), vScale));
+        _mm256_storeu_ps(&out[k+8], _mm256_mul_ps(_mm256_sub_ps(hi, vOffset), vScale));
+    }
+
+    convertU8Generic(&in[k], n - k, offset, scale, &out[k]);
+}
+
+__attribute__((target("avx2,fma")))
+void convertS8AVX2(const qint8 *in, unsigned int n, float scale, float *out)
+{
+    __m256 vScale = _mm256_set1_ps(scale);
+    unsigned int k = 0;
+
+    for (; k + 16 <= n; k += 16)
+    {
+        __m128i b = _mm_loadu_si128((const __m128i*) &in[k]);
+        __m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(b));
+        __m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(b, 8)));
+        _mm256_storeu_ps(&out[k], _mm256_mul_ps(lo, vScale));
+        _mm256_storeu_ps(&out[k+8], _mm256_mul_ps(hi, vScale));
+    }
+
+    convertS8Generic(&in[k], n - k, scale, &out[k]);
+}
+
+__attribute__((target("avx2,fma")))
+void convertS16AVX2(const qint16 *in, unsigned int n, float scale, float *out)
+{
+    __m256 vScale = _mm256_set1_ps(scale);
+    unsigned int k = 0;
+
+    for (; k + 8 <= n; k += 8)
+    {
+        __m128i w = _mm_loadu_si128((const __m128i*) &in[k]);
+        _mm256_storeu_ps(&out[k], _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(w)), vScale));
+    }
+
+    convertS16Generic(&in[k], n - k, scale, &out[k]);
+}
+
+__attribute__((target("avx2,fma")))
+void convertF32AVX2(const float *in, unsigned int n, float scale, float *out)
+{
+    __m256 vScale = _mm256_set1_ps(scale);
+    unsigned int k = 0;
+
+    for (; k + 8 <= n; k += 8) {
+        _mm256_storeu_ps(&out[k], _mm256_mul_ps(_mm256_loadu_ps(&in[k]), vScale));
+    }
+
+    convertF32Generic(&in[k], n - k, scale, &out[k]);
+}
+
+__attribute__((target("avx2,fma")))
+void deinterleaveAVX2(const float *in, unsigned int nbPairs, float *even, float *odd)
+{
+    unsigned int k = 0;
+
+    for (; k + 8 <= nbPairs; k += 8)
+    {
+        __m256 a = _mm256_loadu_ps(&in[2*k]);
+        __m256 b = _mm256_loadu_ps(&in[2*k+8]);
+        // shuffles work within 128 bit lanes: reorder the 64 bit pairs afterwards
+        __m256 e = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+        __m256 o = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+        _mm256_storeu_ps(&even[k], _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(e), _MM_SHUFFLE(3,1,2,0))));
+        _mm256_storeu_ps(&odd[k], _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(o), _MM_SHUFFLE(3,1,2,0))));
+    }
+
+    deinterleaveGeneric(&in[2*k], nbPairs - k, &even[k], &odd[k]);
+}
+
+__attribute__((target("avx2,fma")))
+void rotateAVX2(float *i, float *q, unsigned int n, const float *c, const float *s, unsigned int period, unsigned int& phase)
+{
+    unsigned int k = 0;
+
+    for (; k + 8 <= n; k += 8)
+    {
+        __m256 vi = _mm256_loadu_ps(&i[k]);
+        __m256 vq = _mm256_loadu_ps(&q[k]);
+        __m256 vc = _mm256_loadu_ps(&c[phase]);
+        __m256 vs = _mm256_loadu_ps(&s[phase]);
+        _mm256_storeu_ps(&i[k], _mm256_fmsub_ps(vi, vc, _mm256_mul_ps(vq, vs)));
+        _mm256_storeu_ps(&q[k], _mm256_fmadd_ps(vi, vs, _mm256_mul_ps(vq, vc)));
+        phase = (phase + 8) & (period - 1);
+    }
+
+    rotateGeneric(&i[k], &q[k], n - k, c, s, period, phase);
+}
+
+__attribute__((target("avx2,fma")))
+void hbDecimateAVX2(const float *even, const float *odd, unsigned int nbOut, const float *taps, float *out)
+{
+    const __m256 half = _mm256_set1_ps(0.5f);
+    unsigned int k = 0;
+
+    for (; k + 8 <= nbOut; k += 8)
+    {
+        __m256 acc = _mm256_mul_ps(half, _mm256_loadu_ps(&even[k + hbTaps]));
+
+        for (int m = 0; m < hbTaps; m++)
+        {
+            __m256 sum = _mm256_add_ps(_mm256_loadu_ps(&odd[k + m]), _mm256_loadu_ps(&odd[k + 2*hbTaps - 1 - m]));
+            acc = _mm256_fmadd_ps(_mm256_set1_ps(taps[m]), sum, acc);
+        }
+
+        _mm256_storeu_ps(&out[k], acc);
+    }
+
+    for (; k < nbOut; k++) {
+        out[k] = hbOutput(even, odd, k, taps);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+void toSamplesAVX2(const float *i, const float *q, unsigned int n, Sample *out)
+{
+    const __m256 vMax = _mm256_set1_ps(sampleMax);
+    const __m256 vMin = _mm256_set1_ps(-sampleMax);
+    unsigned int k = 0;
+
+    for (; k + 8 <= n; k += 8)
+    {
+        __m256i vi = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&i[k]), vMin), vMax));
+        __m256i vq = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&q[k]), vMin), vMax));
+        __m256i lo = _mm256_unpacklo_epi32(vi, vq); // i0 q0 i1 q1 | i4 q4 i5 q5
+        __m256i hi = _mm256_unpackhi_epi32(vi, vq); // i2 q2 i3 q3 | i6 q6 i7 q7
+        __m256i s0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+        __m256i s1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+#if SDR_RX_SAMP_SZ == 24
+        _mm256_storeu_si256((__m256i*) &out[k], s0);
+        _mm256_storeu_si256((__m256i*) &out[k+4], s1);
+#else
+        // values are already within the 16 bit range
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(s0, s1), _MM_SHUFFLE(3,1,2,0));
+        _mm256_storeu_si256((__m256i*) &out[k], packed);
+#endif
+    }
+
+    toSamplesGeneric(&i[k], &q[k], n - k, &out[k]);
+}
+
+const Kernels avx2Kernels = {
+    "avx2",
+    convertU8AVX2,
+    convertS8AVX2,
+    convertS16AVX2,
+    convertF32AVX2,
+    deinterleaveAVX2,
+    rotateAVX2,
+    hbDecimateAVX2,
+    toSamplesAVX2
+};
+
+#endif // DEVICEFRONTEND_X86
+
+#if defined(DEVICEFRONTEND_NEON)
+
+// NEON kernels. Conversions stay generic: the compiler vectorizes them well enough.
+
+void deinterleaveNEON(const float *in, unsigned int nbPairs, float *even, float *odd)
+{
+    unsigned int k = 0;
+
+    for (; k + 4 <= nbPairs; k += 4)
+    {
+        float32x4x2_t v = vld2q_f32(&in[2*k]);
+        vst1q_f32(&even[k], v.val[0]);
+        vst1q_f32(&odd[k], v.val[1]);
+    }
+
+    deinterleaveGeneric(&in[2*k], nbPairs - k, &even[k], &odd[k]);
+}
+
+void rotateNEON(float *i, float *q, unsigned int n, const float *c, const float *s, unsigned int period, unsigned int& phase)
+{
+    unsigned int k = 0;
+
+    for (; k + 4 <= n; k += 4)
+    {
+        float32x4_t vi = vld1q_f32(&i[k]);
+        float32x4_t vq = vld1q_f32(&q[k]);
+        float32x4_t vc = vld1q_f32(&c[phase]);
+        float32x4_t vs = vld1q_f32(&s[phase]);
+        vst1q_f32(&i[k], vmlsq_f32(vmulq_f32(vi, vc), vq, vs));
+        vst1q_f32(&q[k], vmlaq_f32(vmulq_f32(vi, vs), vq, vc));
+        phase = (phase + 4) & (period - 1);
+    }
+
+    rotateGeneric(&i[k], &q[k], n - k, c, s, period, phase);
+}
+
+void hbDecimateNEON(const float *even, const float *odd, unsigned int nbOut, const float *taps, float *out)
+{
+    unsigned int k = 0;
+
+    for (; k + 4 <= nbOut; k += 4)
+    {
+        float32x4_t acc = vmulq_n_f32(vld1q_f32(&even[k + hbTaps]), 0.5f);
+
+        for (int m = 0; m < hbTaps; m++)
+        {
+            float32x4_t sum = vaddq_f32(vld1q_f32(&odd[k + m]), vld1q_f32(&odd[k + 2*hbTaps - 1 - m]));
+            acc = vmlaq_n_f32(acc, sum, taps[m]);
+        }
+
+        vst1q_f32(&out[k], acc);
+    }
+
+    for (; k < nbOut; k++) {
+        out[k] = hbOutput(even, odd, k, taps);
+    }
+}
+
+const Kernels neonKernels = {
+    "neon",
+    convertU8Generic,
+    convertS8Generic,
+    convertS16Generic,
+    convertF32Generic,
+    deinterleaveNEON,
+    rotateNEON,
+    hbDecimateNEON,
+    toSamplesGeneric
+};
+
+#endif // DEVICEFRONTEND_NEON
+
+const Kernels& selectKernels()
+{
+#if defined(DEVICEFRONTEND_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return avx2Kernels;
+    }
+#endif
+#if defined(DEVICEFRONTEND_NEON)
+    return neonKernels;
+#else
+    return genericKernels;
+#endif
+}
+
+const Kernels& kernels()
+{
+    static const Kernels& selected = selectKernels(); // thread safe initialization
+    return selected;
+}
+
+} // namespace
+
+DeviceFrontEnd::DeviceFrontEnd(InputFormat format, unsigned int inputBits, int offset) :
+    m_iqOrder(true),
+    m_log2Decim(0),
+    m_fcPos(DeviceSampleStatic::FC_POS_CENTER),
+    m_appliedLog2Decim(0),
+    m_appliedFcPos(DeviceSampleStatic::FC_POS_CENTER),
+    m_period(0),
+    m_phase(0)
+{
+    setInputFormat(format, inputBits, offset);
+    applyDecimation();
+}
+
+void DeviceFrontEnd::setInputFormat(InputFormat format, unsigned int inputBits, int offset)
+{
+    m_format = format;
+    m_offset = offset;
+
+    if (format == FormatF32) {
+        m_scale = SDR_RX_SCALEF;
+    } else {
+        m_scale = (float) (1 << SDR_RX_SAMP_SZ) / (float) (1 << inputBits);
+    }
+}
+
+const char *DeviceFrontEnd::getKernelsName()
+{
+    return kernels().m_name;
+}
+
+void DeviceFrontEnd::applyDecimation()
+{
+    m_appliedLog2Decim = std::min(m_log2Decim, m_maxLog2Decim);
+    m_appliedFcPos = m_fcPos;
+
+    for (unsigned int s = 0; s < m_maxLog2Decim; s++)
+    {
+        for (int p = 0; p < 2; p++) {
+            m_stages[s].m_in[p].assign(hbHistory, 0.0f);
+        }
+
+        m_stages[s].m_fill = hbHistory;
+    }
+
+    // the shift as a fraction of the device sample rate is a ratio of powers of two
+    const int rateUnit = 1 << 16;
+    int shift = DeviceSampleStatic::calculateSourceFrequencyShift(
+        m_appliedLog2Decim,
+        (DeviceSampleStatic::fcPos_t) m_appliedFcPos,
+        rateUnit,
+        DeviceSampleStatic::FSHIFT_STD);
+    m_phase = 0;
+
+    if (shift == 0)
+    {
+        m_period = 0;
+        return;
+    }
+
+    unsigned int period = rateUnit;
+
+    while ((shift % 2 == 0) && (period > 1))
+    {
+        shift /= 2;
+        period /= 2;
+    }
+
+    // whole blocks of the widest kernel must find contiguous phasor values
+    m_period = std::max(period, phasorBlock);
+    m_cos.resize(m_period + phasorBlock);
+    m_sin.resize(m_period + phasorBlock);
+
+    for (unsigned int k = 0; k < m_period + phasorBlock; k++)
+    {
+        // brings the frequency of the shift down to zero
+        double phi = -2.0 * M_PI * shift * (double) (k % period) / period;
+        m_cos[k] = cos(phi);
+        m_sin[k] = sin(phi);
+    }
+
+    qDebug("DeviceFrontEnd::applyDecimation: log2Decim: %u fcPos: %d shift: %d/%u kernels: %s",
+        m_appliedLog2Decim, m_appliedFcPos, shift, period, getKernelsName());
+}
+
+unsigned int DeviceFrontEnd::runStage(Stage& stage, const float *inI, const float *inQ, unsigned int count)
+{
+    const Kernels& k = kernels();
+    const float *in[2] = {inI, inQ};
+    unsigned int fill = stage.m_fill + count;
+    unsigned int nbOut = fill > (unsigned int) hbOrder ? (fill - hbOrder - 1) / 2 + 1 : 0;
+
+    if (m_even.size() < nbOut + 2*hbTaps)
+    {
+        m_even.resize(nbOut + 2*hbTaps);
+        m_odd.resize(nbOut + 2*hbTaps);
+    }
+
+    for (int p = 0; p < 2; p++)
+    {
+        std::vector<float>& buf = stage.m_in[p];
+
+        if (buf.size() < fill) {
+            buf.resize(fill);
+        }
+
+        std::copy(in[p], in[p] + count, buf.begin() + stage.m_fill);
+
+        if (stage.m_out[p].size() < nbOut) {
+            stage.m_out[p].resize(nbOut);
+        }
+
+        if (nbOut == 0) {
+            continue;
+        }
+
+        k.deinterleave(buf.data(), nbOut + 2*hbTaps - 1, m_even.data(), m_odd.data());
+        k.hbDecimate(m_even.data(), m_odd.data(), nbOut, HBFIRFilterTraits<hbOrder>::hbCoeffsF, stage.m_out[p].data());
+        // keep what the next outputs need
+        std::copy(buf.begin() + 2*nbOut, buf.begin() + fill, buf.begin());
+    }
+
+    stage.m_fill = fill - 2*nbOut;
+    return nbOut;
+}
+
+void DeviceFrontEnd::process(const void *buf, qint32 len, SampleVector::iterator* it)
+{
+    const Kernels& k = kernels();
+
+    if ((m_log2Decim != m_appliedLog2Decim) || (m_fcPos != m_appliedFcPos)) {
+        applyDecimation();
+    }
+
+    unsigned int nbPairs = len / 2;
+
+    if (m_work.size() < 2*nbPairs)
+    {
+        m_work.resize(2*nbPairs);
+        m_iq[0].resize(nbPairs);
+        m_iq[1].resize(nbPairs);
+    }
+
+    switch (m_format)
+    {
+    case FormatU8:
+        k.convertU8((const quint8*) buf, 2*nbPairs, m_offset, m_scale, m_work.data());
+        break;
+    case FormatS8:
+        k.convertS8((const qint8*) buf, 2*nbPairs, m_scale, m_work.data());
+        break;
+    case FormatS16:
+        k.convertS16((const qint16*) buf, 2*nbPairs, m_scale, m_work.data());
+        break;
+    case FormatF32:
+    default:
+        k.convertF32((const float*) buf, 2*nbPairs, m_scale, m_work.data());
+        break;
+    }
+
+    // I/Q swap is free: just exchange the destinations
+    k.deinterleave(m_work.data(), nbPairs, m_iq[m_iqOrder ? 0 : 1].data(), m_iq[m_iqOrder ? 1 : 0].data());
+
+    if (m_period != 0) {
+        k.rotate(m_iq[0].data(), m_iq[1].data(), nbPairs, m_cos.data(), m_sin.data(), m_period, m_phase);
+    }
+
+    const float *i = m_iq[0].data();
+    const float *q = m_iq[1].data();
+    unsigned int count = nbPairs;
+
+    for (unsigned int s = 0; s < m_appliedLog2Decim; s++)
+    {
+        count = runStage(m_stages[s], i, q, count);
+        i = m_stages[s].m_out[0].data();
+        q = m_stages[s].m_out[1].data();
+    }
+
+    k.toSamples(i, q, count, &(**it));
+    *it += count;
+}
@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_DEVICEFRONTEND_H_
+#define SDRBASE_DSP_DEVICEFRONTEND_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Front end of the Rx device workers. Converts the raw samples delivered by the device to float,
+ * puts them in I/Q order, shifts the spectrum according to the center frequency position (fcPos)
+ * and decimates by a power of two with a chain of half band filters. The result is written as
+ * Samples ready for the device FIFO.
+ *
+ * This replaces the per device instantiations of the Decimators templates. The frequency shift
+ * is the one given by DeviceSampleStatic::calculateSourceFrequencyShift with the standard scheme
+ * and the half band filters are the 64th order filters of the Decimators so the output is the
+ * same band at the same level.
+ *
+ * Processing kernels are selected once at run time: AVX2/FMA on x86 processors supporting it,
+ * NEON on ARM when built with NEON support and plain C++ otherwise.
+ */
+class SDRBASE_API DeviceFrontEnd
+{
+public:
+    enum InputFormat
+    {
+        FormatU8,  //!< Unsigned 8 bit with offset (ex: RTL-SDR)
+        FormatS8,  //!< Signed 8 bit
+        FormatS16, //!< Signed 16 bit holding inputBits significant bits
+        FormatF32  //!< Float full scale 1.0
+    };
+
+    DeviceFrontEnd(InputFormat format, unsigned int inputBits, int offset = 0);
+
+    void setInputFormat(InputFormat format, unsigned int inputBits, int offset = 0); //!< Call from the worker thread only
+    void setIQOrder(bool iqOrder) { m_iqOrder = iqOrder; }
+    void setLog2Decim(unsigned int log2Decim) { m_log2Decim = log2Decim; } //!< Effective at the next process()
+    void setFcPos(int fcPos) { m_fcPos = fcPos; }                          //!< Effective at the next process()
+    unsigned int getLog2Decim() const { return m_log2Decim; }
+    int getFcPos() const { return m_fcPos; }
+    bool getIQOrder() const { return m_iqOrder; }
+
+    /**
+     * Process a block of raw device samples.
+     * len counts I and Q values as with the Decimators (ex: bytes for 8 bit samples).
+     * The decimated samples are written from *it on and *it is moved past the last one.
+     */
+    void process(const void *buf, qint32 len, SampleVector::iterator* it);
+
+    static const char *getKernelsName(); //!< Name of the kernels selected on this processor
+    static const unsigned int m_maxLog2Decim = 6;
+
+private:
+    struct Stage
+    {
+        std::vector<float> m_in[2];  //!< Pending input I and Q starting with the filter history
+        std::vector<float> m_out[2]; //!< Decimated I and Q
+        unsigned int m_fill;
+    };
+
+    InputFormat m_format;
+    float m_scale;
+    float m_offset;
+    bool m_iqOrder;
+    unsigned int m_log2Decim;
+    int m_fcPos;
+    unsigned int m_appliedLog2Decim;
+    int m_appliedFcPos;
+
+    std::vector<float> m_work;    //!< Interleaved converted input
+    std::vector<float> m_iq[2];   //!< I and Q at device rate
+    std::vector<float> m_even;
+    std::vector<float> m_odd;
+    Stage m_stages[m_maxLog2Decim];
+    std::vector<float> m_cos;     //!< Shift phasor period padded for block access
+    std::vector<float> m_sin;
+    unsigned int m_period;        //!< Number of phasor values in one period (0: no shift)
+    unsigned int m_phase;
+
+    void applyDecimation();
+    unsigned int runStage(Stage& stage, const float *inI, const float *inQ, unsigned int count);
+};
+
+#endif // SDRBASE_DSP_DEVICEFRONTEND_H_
@@ -22,6 +22,7 @@
 #include "dsp/devicesamplesource.h"
 
 DeviceSampleSource::DeviceSampleSource() :
+    m_floatSamples(false),
     m_guiMessageQueue(0)
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
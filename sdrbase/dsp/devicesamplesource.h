@@ -23,6 +23,7 @@
 #include <QByteArray>
 
 #include "samplesinkfifo.h"
+#include "fsamplesinkfifo.h"
 #include "util/message.h"
 #include "util/messagequeue.h"
 #include "export.h"
@@ -133,6 +134,13 @@ public:
 	virtual void setMessageQueueToGUI(MessageQueue *queue) = 0; // pure virtual so that child classes must have to deal with this
 	MessageQueue *getMessageQueueToGUI() { return m_guiMessageQueue; }
     SampleSinkFifo* getSampleFifo() { return &m_sampleFifo; }
+    FSampleSinkFifo* getFloatSampleFifo() { return &m_floatSampleFifo; }
+    /**
+     * Request the float baseband pipeline. Devices delivering float samples natively then write
+     * to the float FIFO instead of converting to fixed point. Others ignore it. Applied at next start.
+     */
+    void setFloatSamples(bool floatSamples) { m_floatSamples = floatSamples; }
+    bool getFloatSamples() const { return m_floatSamples; }
 
     static qint64 calculateDeviceCenterFrequency(
             quint64 centerFrequency,
@@ -166,6 +174,8 @@ protected slots:
 
 protected:
     SampleSinkFifo m_sampleFifo;
+    FSampleSinkFifo m_floatSampleFifo; //!< Used instead of m_sampleFifo in float baseband mode
+    bool m_floatSamples;
 	MessageQueue m_inputMessageQueue; //!< Input queue to the source
 	MessageQueue *m_guiMessageQueue;  //!< Input message queue to the GUI
 };
@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QDebug>
+
+#include "devicetimealigner.h"
+
+const qint64 DeviceTimeAligner::m_resyncToleranceUs = 1000;
+const unsigned int DeviceTimeAligner::m_maxBufferedBlocks = 64;
+
+void DeviceTimeAligner::Stream::restart(qint64 timeUs, int sampleRate)
+{
+    m_buffer.clear();
+    m_start = 0;
+    m_originUs = timeUs;
+    m_consumed = 0;
+    m_sampleRate = sampleRate;
+}
+
+void DeviceTimeAligner::Stream::consume(unsigned int count)
+{
+    m_consumed += count; // time is derived from the count so that rounding does not accumulate
+    m_start += count;
+
+    // compact once the consumed part dominates so that the buffer does not grow unbounded
+    if (m_start > m_buffer.size() / 2)
+    {
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_start);
+        m_start = 0;
+    }
+}
+
+DeviceTimeAligner::DeviceTimeAligner(unsigned int nbStreams, unsigned int blockSize) :
+    m_streams(nbStreams),
+    m_blockSize(blockSize),
+    m_consumer(nullptr),
+    m_blocks(nbStreams, SampleVector(blockSize)),
+    m_alignedCount(0),
+    m_rateMismatch(false)
+{
+}
+
+DeviceTimeAligner::~DeviceTimeAligner()
+{
+}
+
+void DeviceTimeAligner::setConsumer(DeviceTimeAlignerConsumer *consumer)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_consumer = consumer;
+}
+
+void DeviceTimeAligner::reset()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (std::vector<Stream>::iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+    {
+        it->restart(0, 0);
+        it->m_discarded = 0;
+    }
+
+    m_alignedCount = 0;
+    m_rateMismatch = false;
+}
+
+quint64 DeviceTimeAligner::getDiscardedCount(unsigned int streamIndex) const
+{
+    return streamIndex < m_streams.size() ? m_streams[streamIndex].m_discarded : 0;
+}
+
+qint64 DeviceTimeAligner::getSkewUs(unsigned int streamIndex) const
+{
+    if ((streamIndex >= m_streams.size()) || (m_streams.size() == 0)) {
+        return 0;
+    }
+
+    return m_streams[streamIndex].startUs() - m_streams[0].startUs();
+}
+
+void DeviceTimeAligner::feed(unsigned int streamIndex, SampleVector::const_iterator begin, SampleVector::const_iterator end,
+    qint64 timestampUs, int sampleRate)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if ((streamIndex >= m_streams.size()) || (begin == end) || (sampleRate <= 0) || (timestampUs == 0)) {
+        return;
+    }
+
+    Stream& stream = m_streams[streamIndex];
+
+    if (stream.available() > 0)
+    {
+        qint64 expectedUs = stream.startUs() + samplesToUs(stream.available(), stream.m_sampleRate);
+        qint64 jumpUs = timestampUs - expectedUs;
+
+        if ((sampleRate != stream.m_sampleRate) || (std::abs(jumpUs) > m_resyncToleranceUs))
+        {
+            qDebug("DeviceTimeAligner::feed: stream %u: resync jump: %lld us (%lld samples)",
+                streamIndex, jumpUs, usToSamples(jumpUs, sampleRate));
+            stream.m_discarded += stream.available();
+            stream.restart(timestampUs, sampleRate);
+        }
+    }
+    else
+    {
+        stream.restart(timestampUs, sampleRate);
+    }
+
+    stream.m_buffer.insert(stream.m_buffer.end(), begin, end);
+
+    // bound the buffer when other streams do not deliver
+    unsigned int maxBuffered = m_maxBufferedBlocks * m_blockSize;
+
+    if (stream.available() > maxBuffered)
+    {
+        unsigned int excess = stream.available() - maxBuffered;
+        stream.m_discarded += excess;
+        stream.consume(excess);
+    }
+
+    align();
+}
+
+void DeviceTimeAligner::align()
+{
+    int sampleRate = m_streams[0].m_sampleRate;
+
+    for (std::vector<Stream>::const_iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+    {
+        if (it->available() == 0) {
+            return;
+        }
+
+        if (it->m_sampleRate != sampleRate)
+        {
+            if (!m_rateMismatch) {
+                qWarning("DeviceTimeAligner::align: streams have different sample rates: cannot align");
+            }
+
+            m_rateMismatch = true;
+            return;
+        }
+    }
+
+    m_rateMismatch = false;
+
+    while (true)
+    {
+        // the common window starts with the stream that started last
+        qint64 windowStartUs = m_streams[0].startUs();
+
+        for (std::vector<Stream>::const_iterator it = m_streams.begin(); it != m_streams.end(); ++it) {
+            windowStartUs = std::max(windowStartUs, it->startUs());
+        }
+
+        for (std::vector<Stream>::iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+        {
+            qint64 skip = usToSamples(windowStartUs - it->startUs(), sampleRate);
+            unsigned int toSkip = std::min((qint64) it->available(), skip);
+
+            if (toSkip > 0)
+            {
+                it->m_discarded += toSkip;
+                it->consume(toSkip);
+            }
+
+            if (it->available() < m_blockSize) {
+                return;
+            }
+        }
+
+        for (unsigned int i = 0; i < m_streams.size(); i++)
+        {
+            Stream& stream = m_streams[i];
+            std::copy(stream.m_buffer.begin() + stream.m_start, stream.m_buffer.begin() + stream.m_start + m_blockSize, m_blocks[i].begin());
+            stream.consume(m_blockSize);
+        }
+
+        m_alignedCount++;
+
+        if (m_consumer) {
+            m_consumer->feedAligned(m_blocks, windowStartUs, sampleRate);
+        }
+    }
+}
+
+qint64 DeviceTimeAligner::samplesToUs(qint64 nbSamples, int sampleRate)
+{
+    return sampleRate <= 0 ? 0 : (nbSamples * 1000000LL) / sampleRate;
+}
+
+qint64 DeviceTimeAligner::usToSamples(qint64 us, int sampleRate)
+{
+    return us >= 0 ? (us * sampleRate + 500000LL) / 1000000LL : -((-us * sampleRate + 500000LL) / 1000000LL);
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_DEVICETIMEALIGNER_H_
+#define SDRBASE_DSP_DEVICETIMEALIGNER_H_
+
+#include <vector>
+
+#include <QMutex>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class SDRBASE_API DeviceTimeAlignerConsumer
+{
+public:
+    virtual ~DeviceTimeAlignerConsumer() {}
+    /**
+     * One block of the same length per stream, all starting at timestampUs.
+     * Called in the thread of the device engine that completed the block with the aligner
+     * locked so the consumer should copy the data and return quickly.
+     */
+    virtual void feedAligned(const std::vector<SampleVector>& blocks, qint64 timestampUs, int sampleRate) = 0;
+};
+
+/**
+ * Delivers time aligned blocks of samples from several Rx device sets to a consumer.
+ *
+ * Each device source engine attached with DSPDeviceSourceEngine::configureTimeAligner() feeds
+ * its samples along with the time of their first sample taken from its device FIFO. Samples are
+ * buffered per stream until all streams cover a common window of m_blockSize samples which is
+ * then cut out of each stream at the nearest sample and given to the consumer. Samples older than
+ * the common window are discarded.
+ *
+ * All streams must run at the same sample rate. A stream whose timestamps jump by more than
+ * m_resyncToleranceUs (dropped samples, clock resync) restarts its buffer at the new time. The
+ * tolerance is a time so that the jitter of host clock timestamps is accepted at any sample rate.
+ */
+class SDRBASE_API DeviceTimeAligner
+{
+public:
+    DeviceTimeAligner(unsigned int nbStreams, unsigned int blockSize);
+    ~DeviceTimeAligner();
+
+    void setConsumer(DeviceTimeAlignerConsumer *consumer);
+    unsigned int getNbStreams() const { return m_streams.size(); }
+    unsigned int getBlockSize() const { return m_blockSize; }
+    void reset();
+
+    void feed(unsigned int streamIndex, SampleVector::const_iterator begin, SampleVector::const_iterator end,
+        qint64 timestampUs, int sampleRate);
+
+    quint64 getAlignedCount() const { return m_alignedCount; } //!< Number of blocks delivered
+    quint64 getDiscardedCount(unsigned int streamIndex) const;  //!< Samples of this stream that could not be aligned
+    qint64 getSkewUs(unsigned int streamIndex) const;           //!< Start time of this stream buffer relative to the first stream
+
+    static const qint64 m_resyncToleranceUs;
+    static const unsigned int m_maxBufferedBlocks; //!< A stream buffers at most this many blocks when others lag
+
+private:
+    struct Stream
+    {
+        SampleVector m_buffer;
+        unsigned int m_start;    //!< Index in m_buffer of the oldest sample kept
+        qint64 m_originUs;       //!< Time of the first sample buffered since the last resync
+        quint64 m_consumed;      //!< Samples consumed since the last resync
+        int m_sampleRate;
+        quint64 m_discarded;
+
+        Stream() :
+            m_start(0),
+            m_originUs(0),
+            m_consumed(0),
+            m_sampleRate(0),
+            m_discarded(0)
+        {}
+
+        unsigned int available() const { return m_buffer.size() - m_start; }
+        qint64 startUs() const { return m_originUs + samplesToUs(m_consumed, m_sampleRate); } //!< Time of the sample at m_start
+        void restart(qint64 timeUs, int sampleRate);
+        void consume(unsigned int count);
+    };
+
+    QMutex m_mutex;
+    std::vector<Stream> m_streams;
+    unsigned int m_blockSize;
+    DeviceTimeAlignerConsumer *m_consumer;
+    std::vector<SampleVector> m_blocks;
+    quint64 m_alignedCount;
+    bool m_rateMismatch;
+
+    void align();
+    static qint64 samplesToUs(qint64 nbSamples, int sampleRate);
+    static qint64 usToSamples(qint64 us, int sampleRate);
+};
+
+#endif // SDRBASE_DSP_DEVICETIMEALIGNER_H_
@@ -87,6 +87,42 @@ void DownChannelizer::feed(const SampleVector::const_iterator& begin, const Samp
 	}
 }
 
+void DownChannelizer::feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end)
+{
+	if (m_sampleSink == 0)
+    {
+		m_fsampleBuffer.clear();
+		return;
+	}
+
+	if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
+	{
+		m_sampleSink->feedFloat(begin, end);
+	}
+	else
+	{
+		for (FSampleVector::const_iterator sample = begin; sample != end; ++sample)
+		{
+			FSample s(*sample);
+			FilterStages::iterator stage = m_filterStages.begin();
+
+			for (; stage != m_filterStages.end(); ++stage)
+			{
+				if (!(*stage)->work(&s)) { // float stages have unity gain: no scaling
+					break;
+				}
+			}
+
+			if (stage == m_filterStages.end()) {
+				m_fsampleBuffer.push_back(s);
+			}
+		}
+
+		m_sampleSink->feedFloat(m_fsampleBuffer.begin(), m_fsampleBuffer.end());
+		m_fsampleBuffer.clear();
+	}
+}
+
 void DownChannelizer::setChannelization(int requestedSampleRate, qint64 requestedCenterFrequency)
 {
     if (requestedSampleRate < 0)
@@ -172,42 +208,52 @@ void DownChannelizer::applyDecimation()
 #ifdef SDR_RX_SAMPLE_24BIT
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER, true>),
+    m_filterF(new IntHalfbandFilterEOF<DOWNCHANNELIZER_HB_FILTER_ORDER, true>),
     m_workFunction(0),
+    m_workFunctionF(0),
     m_mode(mode),
     m_sse(true)
 {
     switch(mode) {
         case ModeCenter:
             m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateCenter;
+            m_workFunctionF = &IntHalfbandFilterEOF<DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateCenter;
             break;
 
         case ModeLowerHalf:
             m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateLowerHalf;
+            m_workFunctionF = &IntHalfbandFilterEOF<DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateLowerHalf;
             break;
 
         case ModeUpperHalf:
             m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateUpperHalf;
+            m_workFunctionF = &IntHalfbandFilterEOF<DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateUpperHalf;
             break;
     }
 }
 #else
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER, true>),
+    m_filterF(new IntHalfbandFilterEOF<DOWNCHANNELIZER_HB_FILTER_ORDER, true>),
     m_workFunction(0),
+    m_workFunctionF(0),
     m_mode(mode),
     m_sse(true)
 {
     switch(mode) {
         case ModeCenter:
             m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateCenter;
+            m_workFunctionF = &IntHalfbandFilterEOF<DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateCenter;
             break;
 
         case ModeLowerHalf:
             m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateLowerHalf;
+            m_workFunctionF = &IntHalfbandFilterEOF<DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateLowerHalf;
             break;
 
         case ModeUpperHalf:
             m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateUpperHalf;
+            m_workFunctionF = &IntHalfbandFilterEOF<DOWNCHANNELIZER_HB_FILTER_ORDER, true>::workDecimateUpperHalf;
             break;
     }
 }
@@ -215,6 +261,7 @@ DownChannelizer::FilterStage::FilterStage(Mode mode) :
 
 DownChannelizer::FilterStage::~FilterStage()
 {
+	delete m_filterF;
 	delete m_filter;
 }
 
@@ -25,6 +25,7 @@
 #include "export.h"
 #include "util/message.h"
 #include "dsp/inthalfbandfiltereo.h"
+#include "dsp/inthalfbandfiltereof.h"
 
 #include "channelsamplesink.h"
 
@@ -36,6 +37,7 @@ public:
 	virtual ~DownChannelizer();
 
 	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+	virtual void feedFloat(const FSampleVector::const_iterator& begin, const FSampleVector::const_iterator& end); //!< Float baseband: stays in float down to the channel sink
 
     void setDecimation(unsigned int log2Decim, unsigned int filterChainHash);         //!< Define channelizer with decimation factor and filter chain definition
     void setChannelization(int requestedSampleRate, qint64 requestedCenterFrequency); //!< Define channelizer with requested sample rate and center frequency (shift in the baseband)
@@ -60,7 +62,11 @@ protected:
         IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER, true>* m_filter;
 #endif
 
+		typedef bool (IntHalfbandFilterEOF<DOWNCHANNELIZER_HB_FILTER_ORDER, true>::*WorkFunctionF)(FSample* s);
+		IntHalfbandFilterEOF<DOWNCHANNELIZER_HB_FILTER_ORDER, true>* m_filterF; //!< Float counterpart used by the float feed
+
 		WorkFunction m_workFunction;
+		WorkFunctionF m_workFunctionF;
 		Mode m_mode;
 		bool m_sse;
 
@@ -71,6 +77,11 @@ protected:
 		{
 			return (m_filter->*m_workFunction)(sample);
 		}
+
+		bool work(FSample* sample)
+		{
+			return (m_filterF->*m_workFunctionF)(sample);
+		}
 	};
 	typedef std::list<FilterStage*> FilterStages;
 	FilterStages m_filterStages;
@@ -84,6 +95,7 @@ protected:
     unsigned int m_log2Decim;
     unsigned int m_filterChainHash;
 	SampleVector m_sampleBuffer;
+	FSampleVector m_fsampleBuffer;
 
 	void applyChannelization();
     void applyDecimation();
@@ -29,6 +29,7 @@ class BasebandSampleSink;
 class DeviceSampleSink;
 class BasebandSampleSource;
 class AudioFifo;
+class DeviceTimeAligner;
 
 class SDRBASE_API DSPAcquisitionInit : public Message {
 	MESSAGE_CLASS_DECLARATION
@@ -226,6 +227,39 @@ private:
 
 };
 
+class SDRBASE_API DSPConfigureCompactSamples : public Message {
+	MESSAGE_CLASS_DECLARATION
+
+public:
+	DSPConfigureCompactSamples(bool compactSamples) :
+		Message(),
+		m_compactSamples(compactSamples)
+	{ }
+
+	bool getCompactSamples() const { return m_compactSamples; }
+
+private:
+	bool m_compactSamples;
+};
+
+class SDRBASE_API DSPConfigureTimeAligner : public Message {
+	MESSAGE_CLASS_DECLARATION
+
+public:
+	DSPConfigureTimeAligner(DeviceTimeAligner *timeAligner, unsigned int streamIndex) :
+		Message(),
+		m_timeAligner(timeAligner),
+		m_streamIndex(streamIndex)
+	{ }
+
+	DeviceTimeAligner *getTimeAligner() const { return m_timeAligner; }
+	unsigned int getStreamIndex() const { return m_streamIndex; }
+
+private:
+	DeviceTimeAligner *m_timeAligner;
+	unsigned int m_streamIndex;
+};
+
 class SDRBASE_API DSPEngineReport : public Message {
 	MESSAGE_CLASS_DECLARATION
 
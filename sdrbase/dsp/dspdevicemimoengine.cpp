@@ -23,6 +23,8 @@
 #include "basebandsamplesource.h"
 #include "devicesamplemimo.h"
 #include "mimochannel.h"
+#include "samplemixer.h"
+#include "util/bufferarena.h"
 
 #include "dspdevicemimoengine.h"
 
@@ -38,14 +40,17 @@ MESSAGE_CLASS_DEFINITION(DSPDeviceMIMOEngine::RemoveSpectrumSink, Message)
 MESSAGE_CLASS_DEFINITION(DSPDeviceMIMOEngine::GetErrorMessage, Message)
 MESSAGE_CLASS_DEFINITION(DSPDeviceMIMOEngine::GetMIMODeviceDescription, Message)
 MESSAGE_CLASS_DEFINITION(DSPDeviceMIMOEngine::ConfigureCorrection, Message)
+MESSAGE_CLASS_DEFINITION(DSPDeviceMIMOEngine::ConfigureConcurrentStreams, Message)
 MESSAGE_CLASS_DEFINITION(DSPDeviceMIMOEngine::SetSpectrumSinkInput, Message)
 
 DSPDeviceMIMOEngine::DSPDeviceMIMOEngine(uint32_t uid, QObject* parent) :
 	QThread(parent),
     m_uid(uid),
+    m_arenaNode(-1),
     m_stateRx(StNotStarted),
     m_stateTx(StNotStarted),
     m_deviceSampleMIMO(nullptr),
+    m_concurrentStreams(false),
     m_spectrumInputSourceElseSink(true),
     m_spectrumInputIndex(0)
 {
@@ -59,11 +64,13 @@ DSPDeviceMIMOEngine::~DSPDeviceMIMOEngine()
 {
     stop();
 	wait();
+    BufferArena::instance().trim(this);
 }
 
 void DSPDeviceMIMOEngine::run()
 {
 	qDebug() << "DSPDeviceMIMOEngine::run";
+	m_arenaNode = BufferArena::getCurrentNode(); // the device FIFOs are placed on this node
 	m_stateRx = StIdle;
     m_stateTx = StIdle;
 	exec();
@@ -264,6 +271,19 @@ void DSPDeviceMIMOEngine::workSampleSinkFifos()
         //unsigned int count = sampleFifo->readSync(sampleFifo->fillSync(), iPart1Begin, iPart1End, iPart2Begin, iPart2End);
         sampleFifo->readSync(iPart1Begin, iPart1End, iPart2Begin, iPart2End);
 
+        if (m_streamWorkers.isRunning())
+        {
+            if (iPart1Begin != iPart1End) {
+                workSamplesSinkConcurrent(data, iPart1Begin, iPart1End);
+            }
+
+            if (iPart2Begin != iPart2End) {
+                workSamplesSinkConcurrent(data, iPart2Begin, iPart2End);
+            }
+
+            continue;
+        }
+
         if (iPart1Begin != iPart1End)
         {
             for (unsigned int stream = 0; stream < data.size(); stream++) {
@@ -299,6 +319,20 @@ void DSPDeviceMIMOEngine::workSampleSourceFifos()
 
         // pull samples from the sources by stream
 
+        if (m_streamWorkers.isRunning() && (m_mimoChannels.size() == 0)) // MIMO channels are not thread safe across streams
+        {
+            if (iPart1Begin != iPart1End) {
+                workSamplesSourceConcurrent(data, iPart1Begin, iPart1End);
+            }
+
+            if (iPart2Begin != iPart2End) {
+                workSamplesSourceConcurrent(data, iPart2Begin, iPart2End);
+            }
+
+            remainder = sampleFifo->remainderSync();
+            continue;
+        }
+
         if (iPart1Begin != iPart1End)
         {
             for (unsigned int streamIndex = 0; streamIndex < sampleFifo->getNbStreams(); streamIndex++) {
@@ -380,29 +414,79 @@ void DSPDeviceMIMOEngine::workSampleSourceFifo(unsigned int streamIndex)
  * Routes samples from source channels registered for the FIFO to the device sink FIFO
  */
 void DSPDeviceMIMOEngine::workSamplesSink(const SampleVector::const_iterator& vbegin, const SampleVector::const_iterator& vend, unsigned int streamIndex)
+{
+    SampleVector::const_iterator begin;
+    SampleVector::const_iterator end;
+
+    workSamplesSinkStream(vbegin, vend, streamIndex, begin, end);
+    workSamplesSinkMIMO(begin, end, streamIndex);
+}
+
+void DSPDeviceMIMOEngine::workSamplesSinkStream(
+    const SampleVector::const_iterator& vbegin,
+    const SampleVector::const_iterator& vend,
+    unsigned int streamIndex,
+    SampleVector::const_iterator& begin,
+    SampleVector::const_iterator& end
+)
 {
 	bool positiveOnly = false;
+    begin = vbegin;
+    end = vend;
+
     // DC and IQ corrections
-    // if (m_sourcesCorrections[streamIndex].m_dcOffsetCorrection) {
-    //     iqCorrections(vbegin, vend, streamIndex, m_sourcesCorrections[streamIndex].m_iqImbalanceCorrection);
-    // }
+    if ((streamIndex < m_sourcesCorrections.size()) && m_sourcesCorrections[streamIndex].m_dcOffsetCorrection)
+    {
+        iqCorrections(vbegin, vend, streamIndex, m_sourcesCorrections[streamIndex].m_iqImbalanceCorrection);
+        begin = m_sourcesCorrections[streamIndex].m_correctionBuffer.begin();
+        end = m_sourcesCorrections[streamIndex].m_correctionBuffer.begin() + (vend - vbegin);
+    }
 
     // feed data to direct sinks
     if (streamIndex < m_basebandSampleSinks.size())
     {
         for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks[streamIndex].begin(); it != m_basebandSampleSinks[streamIndex].end(); ++it) {
-            (*it)->feed(vbegin, vend, positiveOnly);
+            (*it)->feed(begin, end, positiveOnly);
         }
     }
 
     // possibly feed data to spectrum sink
     if ((m_spectrumSink) && (m_spectrumInputSourceElseSink) && (streamIndex == m_spectrumInputIndex)) {
-        m_spectrumSink->feed(vbegin, vend, positiveOnly);
+        m_spectrumSink->feed(begin, end, positiveOnly);
     }
+}
 
+void DSPDeviceMIMOEngine::workSamplesSinkMIMO(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, unsigned int streamIndex)
+{
     // feed data to MIMO channels
     for (MIMOChannels::const_iterator it = m_mimoChannels.begin(); it != m_mimoChannels.end(); ++it) {
-        (*it)->feed(vbegin, vend, streamIndex);
+        (*it)->feed(begin, end, streamIndex);
+    }
+}
+
+/**
+ * Process the same block of all sink streams in parallel. Each stream is corrected and fed to its
+ * single stream sinks on its own worker. MIMO channels are fed on the engine thread once all streams
+ * are done so that they still receive the streams one after the other with aligned blocks.
+ */
+void DSPDeviceMIMOEngine::workSamplesSinkConcurrent(const std::vector<SampleVector>& data, unsigned int iBegin, unsigned int iEnd)
+{
+    unsigned int nbStreams = data.size();
+    m_sinkBlockBegins.resize(nbStreams);
+    m_sinkBlockEnds.resize(nbStreams);
+
+    m_streamWorkers.run(nbStreams, [&](unsigned int streamIndex) {
+        workSamplesSinkStream(
+            data[streamIndex].begin() + iBegin,
+            data[streamIndex].begin() + iEnd,
+            streamIndex,
+            m_sinkBlockBegins[streamIndex],
+            m_sinkBlockEnds[streamIndex]
+        );
+    });
+
+    for (unsigned int streamIndex = 0; streamIndex < nbStreams; streamIndex++) {
+        workSamplesSinkMIMO(m_sinkBlockBegins[streamIndex], m_sinkBlockEnds[streamIndex], streamIndex);
     }
 }
 
@@ -436,32 +520,23 @@ void DSPDeviceMIMOEngine::workSamplesSource(SampleVector& data, unsigned int iBe
         else
         {
             m_sourceSampleBuffers[streamIndex].allocate(nbSamples);
+            m_sourceMixBuffers[streamIndex].allocate(2*nbSamples);
+            SampleVector::iterator aBegin = m_sourceSampleBuffers[streamIndex].m_vector.begin();
+            qint32 *acc = m_sourceMixBuffers[streamIndex].m_vector.data();
             BasebandSampleSources::const_iterator srcIt = m_basebandSampleSources[streamIndex].begin();
-            BasebandSampleSource *sampleSource = *srcIt;
-            sampleSource->pull(begin, nbSamples);
-            ++srcIt;
-            m_sumIndex = 1;
 
-            for (; srcIt != m_basebandSampleSources[streamIndex].end(); ++srcIt, m_sumIndex++)
+            for (; srcIt != m_basebandSampleSources[streamIndex].end(); ++srcIt)
             {
-                sampleSource = *srcIt;
-                SampleVector::iterator aBegin = m_sourceSampleBuffers[streamIndex].m_vector.begin();
-                sampleSource->pull(aBegin, nbSamples);
-                std::transform(
-                    aBegin,
-                    aBegin + nbSamples,
-                    begin,
-                    begin,
-                    [this](Sample& a, const Sample& b) -> Sample {
-                        int den = m_sumIndex + 1; // at each stage scale sum by n/n+1 and input by 1/n+1
-                        int nom = m_sumIndex;     // so that final sum is scaled by N (number of channels)
-                        return Sample{
-                            a.real()/den + nom*(b.real()/den),
-                            a.imag()/den + nom*(b.imag()/den)
-                        };
-                    }
-                );
+                (*srcIt)->pull(aBegin, nbSamples);
+
+                if (srcIt == m_basebandSampleSources[streamIndex].begin()) {
+                    SampleMixer::load(&(*aBegin), acc, nbSamples);
+                } else {
+                    SampleMixer::accumulate(&(*aBegin), acc, nbSamples);
+                }
             }
+
+            SampleMixer::mix(acc, &(*begin), nbSamples, m_basebandSampleSources[streamIndex].size());
         }
     }
 
@@ -471,6 +546,16 @@ void DSPDeviceMIMOEngine::workSamplesSource(SampleVector& data, unsigned int iBe
     }
 }
 
+/**
+ * Generate the same block of all source streams in parallel when there are no MIMO channels
+ */
+void DSPDeviceMIMOEngine::workSamplesSourceConcurrent(std::vector<SampleVector>& data, unsigned int iBegin, unsigned int iEnd)
+{
+    m_streamWorkers.run(data.size(), [&](unsigned int streamIndex) {
+        workSamplesSource(data[streamIndex], iBegin, iEnd, streamIndex);
+    });
+}
+
 // notStarted -> idle -> init -> running -+
 //                ^                       |
 //                +-----------------------+
@@ -556,6 +641,7 @@ DSPDeviceMIMOEngine::State DSPDeviceMIMOEngine::gotoIdle(int subsystemIndex)
         return StIdle;
     }
 
+	BufferArena::instance().trim(this); // cached blocks released by the device FIFOs
 	m_deviceDescription.clear();
 
 	return StIdle;
@@ -593,14 +679,6 @@ DSPDeviceMIMOEngine::State DSPDeviceMIMOEngine::gotoInit(int subsystemIndex)
 	    // init: pass sample rate and center frequency to all sample rate and/or center frequency dependent sinks and wait for completion
         for (unsigned int isource = 0; isource < m_deviceSampleMIMO->getNbSourceStreams(); isource++)
         {
-            if (isource < m_sourcesCorrections.size())
-            {
-                m_sourcesCorrections[isource].m_iOffset = 0;
-                m_sourcesCorrections[isource].m_qOffset = 0;
-                m_sourcesCorrections[isource].m_iRange = 1 << 16;
-                m_sourcesCorrections[isource].m_qRange = 1 << 16;
-            }
-
             quint64 sourceCenterFrequency = m_deviceSampleMIMO->getSourceCenterFrequency(isource);
             int sourceStreamSampleRate = m_deviceSampleMIMO->getSourceSampleRate(isource);
 
@@ -807,10 +885,15 @@ void DSPDeviceMIMOEngine::handleSetMIMO(DeviceSampleMIMO* mimo)
 {
     m_deviceSampleMIMO = mimo;
 
-    if (!mimo) { // Early leave
+    if (!mimo) // Early leave
+    {
+        updateStreamWorkers();
         return;
     }
 
+    m_deviceSampleMIMO->getSampleMIFifo()->setArena(m_arenaNode, this);
+    m_deviceSampleMIMO->getSampleMOFifo()->setArena(m_arenaNode, this);
+
     for (int i = 0; i < m_deviceSampleMIMO->getNbSinkFifos(); i++)
     {
         m_basebandSampleSinks.push_back(BasebandSampleSinks());
@@ -822,6 +905,7 @@ void DSPDeviceMIMOEngine::handleSetMIMO(DeviceSampleMIMO* mimo)
         m_basebandSampleSources.push_back(BasebandSampleSources());
         m_sourceSampleBuffers.push_back(IncrementalVector<Sample>());
         m_sourceZeroBuffers.push_back(IncrementalVector<Sample>());
+        m_sourceMixBuffers.push_back(IncrementalVector<qint32>());
     }
 
     if (m_deviceSampleMIMO->getMIMOType() == DeviceSampleMIMO::MIMOHalfSynchronous) // synchronous FIFOs on Rx and not with Tx
@@ -872,6 +956,8 @@ void DSPDeviceMIMOEngine::handleSetMIMO(DeviceSampleMIMO* mimo)
             // );
         }
     }
+
+    updateStreamWorkers();
 }
 
 void DSPDeviceMIMOEngine::handleSynchronousMessages()
@@ -1132,36 +1218,21 @@ void DSPDeviceMIMOEngine::handleInputMessages()
 
             if (isource < m_sourcesCorrections.size())
             {
+                m_sourcesCorrections[isource].m_dcOffsetCorrection = conf->getDCOffsetCorrection();
                 m_sourcesCorrections[isource].m_iqImbalanceCorrection = conf->getIQImbalanceCorrection();
-
-                if (m_sourcesCorrections[isource].m_dcOffsetCorrection != conf->getDCOffsetCorrection())
-                {
-                    m_sourcesCorrections[isource].m_dcOffsetCorrection = conf->getDCOffsetCorrection();
-                    m_sourcesCorrections[isource].m_iOffset = 0;
-                    m_sourcesCorrections[isource].m_qOffset = 0;
-
-                    if (m_sourcesCorrections[isource].m_iqImbalanceCorrection != conf->getIQImbalanceCorrection())
-                    {
-                        m_sourcesCorrections[isource].m_iqImbalanceCorrection = conf->getIQImbalanceCorrection();
-                        m_sourcesCorrections[isource].m_iRange = 1 << 16;
-                        m_sourcesCorrections[isource].m_qRange = 1 << 16;
-                        m_sourcesCorrections[isource].m_imbalance = 65536;
-                    }
-                }
-                m_sourcesCorrections[isource].m_iBeta.reset();
-                m_sourcesCorrections[isource].m_qBeta.reset();
-                m_sourcesCorrections[isource].m_avgAmp.reset();
-                m_sourcesCorrections[isource].m_avgII.reset();
-                m_sourcesCorrections[isource].m_avgII2.reset();
-                m_sourcesCorrections[isource].m_avgIQ.reset();
-                m_sourcesCorrections[isource].m_avgPhi.reset();
-                m_sourcesCorrections[isource].m_avgQQ2.reset();
-                m_sourcesCorrections[isource].m_iBeta.reset();
-                m_sourcesCorrections[isource].m_qBeta.reset();
+                m_sourcesCorrections[isource].m_iqCorrector.reset();
             }
 
 			delete message;
 		}
+		else if (ConfigureConcurrentStreams::match(*message))
+		{
+			ConfigureConcurrentStreams* conf = (ConfigureConcurrentStreams*) message;
+            m_concurrentStreams = conf->getConcurrentStreams();
+            updateStreamWorkers();
+
+			delete message;
+		}
 		else if (DSPMIMOSignalNotification::match(*message))
 		{
 			DSPMIMOSignalNotification *notif = (DSPMIMOSignalNotification *) message;
@@ -1264,91 +1335,48 @@ void DSPDeviceMIMOEngine::configureCorrections(bool dcOffsetCorrection, bool iqI
 	m_inputMessageQueue.push(cmd);
 }
 
-void DSPDeviceMIMOEngine::iqCorrections(SampleVector::iterator begin, SampleVector::iterator end, int isource, bool imbalanceCorrection)
+void DSPDeviceMIMOEngine::configureConcurrentStreams(bool concurrentStreams)
+{
+	qDebug() << "DSPDeviceMIMOEngine::configureConcurrentStreams: " << concurrentStreams;
+	ConfigureConcurrentStreams* cmd = new ConfigureConcurrentStreams(concurrentStreams);
+	m_inputMessageQueue.push(cmd);
+}
+
+void DSPDeviceMIMOEngine::updateStreamWorkers()
 {
-    for(SampleVector::iterator it = begin; it < end; it++)
+    // asynchronous streams are already processed independently as their data comes
+    if (m_concurrentStreams && m_deviceSampleMIMO && (m_deviceSampleMIMO->getMIMOType() != DeviceSampleMIMO::MIMOAsynchronous))
     {
-        m_sourcesCorrections[isource].m_iBeta(it->real());
-        m_sourcesCorrections[isource].m_qBeta(it->imag());
+        unsigned int nbStreams = std::max(m_deviceSampleMIMO->getNbSourceStreams(), m_deviceSampleMIMO->getNbSinkStreams());
 
-        if (imbalanceCorrection)
+        if (nbStreams > 1)
         {
-#if IMBALANCE_INT
-            // acquisition
-            int64_t xi = (it->m_real - (int32_t) m_sourcesCorrections[isource].m_iBeta) << 5;
-            int64_t xq = (it->m_imag - (int32_t) m_sourcesCorrections[isource].m_qBeta) << 5;
-
-            // phase imbalance
-            m_sourcesCorrections[isource].m_avgII((xi*xi)>>28); // <I", I">
-            m_sourcesCorrections[isource].m_avgIQ((xi*xq)>>28); // <I", Q">
-
-            if ((int64_t) m_sourcesCorrections[isource].m_avgII != 0)
-            {
-                int64_t phi = (((int64_t) m_sourcesCorrections[isource].m_avgIQ)<<28) / (int64_t) m_sourcesCorrections[isource].m_avgII;
-                m_sourcesCorrections[isource].m_avgPhi(phi);
-            }
-
-            int64_t corrPhi = (((int64_t) m_sourcesCorrections[isource].m_avgPhi) * xq) >> 28;  //(m_avgPhi.asDouble()/16777216.0) * ((double) xq);
-
-            int64_t yi = xi - corrPhi;
-            int64_t yq = xq;
-
-            // amplitude I/Q imbalance
-            m_sourcesCorrections[isource].m_avgII2((yi*yi)>>28); // <I, I>
-            m_sourcesCorrections[isource].m_avgQQ2((yq*yq)>>28); // <Q, Q>
-
-            if ((int64_t) m_sourcesCorrections[isource].m_avgQQ2 != 0)
+            if (!m_streamWorkers.isRunning() || (m_streamWorkers.getNbStreams() != nbStreams))
             {
-                int64_t a = (((int64_t) m_sourcesCorrections[isource].m_avgII2)<<28) / (int64_t) m_sourcesCorrections[isource].m_avgQQ2;
-                Fixed<int64_t, 28> fA(Fixed<int64_t, 28>::internal(), a);
-                Fixed<int64_t, 28> sqrtA = sqrt((Fixed<int64_t, 28>) fA);
-                m_sourcesCorrections[isource].m_avgAmp(sqrtA.as_internal());
+                qDebug("DSPDeviceMIMOEngine::updateStreamWorkers: start %u stream workers", nbStreams);
+                m_streamWorkers.start(nbStreams);
             }
 
-            int64_t zq = (((int64_t) m_sourcesCorrections[isource].m_avgAmp) * yq) >> 28;
-
-            it->m_real = yi >> 5;
-            it->m_imag = zq >> 5;
-
-#else
-            // DC correction and conversion
-            float xi = (it->m_real - (int32_t) m_sourcesCorrections[isource].m_iBeta) / SDR_RX_SCALEF;
-            float xq = (it->m_imag - (int32_t) m_sourcesCorrections[isource].m_qBeta) / SDR_RX_SCALEF;
-
-            // phase imbalance
-            m_sourcesCorrections[isource].m_avgII(xi*xi); // <I", I">
-            m_sourcesCorrections[isource].m_avgIQ(xi*xq); // <I", Q">
-
-
-            if (m_sourcesCorrections[isource].m_avgII.asDouble() != 0) {
-                m_sourcesCorrections[isource].m_avgPhi(m_sourcesCorrections[isource].m_avgIQ.asDouble()/m_sourcesCorrections[isource].m_avgII.asDouble());
-            }
-
-            float& yi = xi; // the in phase remains the reference
-            float yq = xq - m_sourcesCorrections[isource].m_avgPhi.asDouble()*xi;
+            return;
+        }
+    }
 
-            // amplitude I/Q imbalance
-            m_sourcesCorrections[isource].m_avgII2(yi*yi); // <I, I>
-            m_sourcesCorrections[isource].m_avgQQ2(yq*yq); // <Q, Q>
+    if (m_streamWorkers.isRunning())
+    {
+        qDebug("DSPDeviceMIMOEngine::updateStreamWorkers: stop stream workers");
+        m_streamWorkers.stop();
+    }
+}
 
-            if (m_sourcesCorrections[isource].m_avgQQ2.asDouble() != 0) {
-                m_sourcesCorrections[isource].m_avgAmp(sqrt(m_sourcesCorrections[isource].m_avgII2.asDouble() / m_sourcesCorrections[isource].m_avgQQ2.asDouble()));
-            }
+void DSPDeviceMIMOEngine::iqCorrections(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, int isource, bool imbalanceCorrection)
+{
+    unsigned int nbSamples = end - begin;
 
-            // final correction
-            float& zi = yi; // the in phase remains the reference
-            float zq = m_sourcesCorrections[isource].m_avgAmp.asDouble() * yq;
+    SourceCorrection& sourceCorrection = m_sourcesCorrections[isource];
 
-            // convert and store
-            it->m_real = zi * SDR_RX_SCALEF;
-            it->m_imag = zq * SDR_RX_SCALEF;
-#endif
-        }
-        else
-        {
-            // DC correction only
-            it->m_real -= (int32_t) m_sourcesCorrections[isource].m_iBeta;
-            it->m_imag -= (int32_t) m_sourcesCorrections[isource].m_qBeta;
-        }
+    if (sourceCorrection.m_correctionBuffer.size() < nbSamples) {
+        sourceCorrection.m_correctionBuffer.resize(nbSamples);
     }
+
+    sourceCorrection.m_iqCorrector.process(begin, end, sourceCorrection.m_correctionBuffer.begin(), imbalanceCorrection);
 }
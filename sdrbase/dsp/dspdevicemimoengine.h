@@ -22,15 +22,17 @@
 #include <QThread>
 
 #include "dsp/dsptypes.h"
+#include "dsp/iqcorrector.h"
+#include "dsp/streamworkers.h"
 #include "util/message.h"
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
-#include "util/movingaverage.h"
 #include "util/incrementalvector.h"
 #include "export.h"
 
 class DeviceSampleMIMO;
 class BasebandSampleSink;
+class BasebandSampleSource;
 class MIMOChannel;
 
 class SDRBASE_API DSPDeviceMIMOEngine : public QThread {
@@ -190,6 +192,18 @@ public:
         unsigned int m_index;
     };
 
+    class ConfigureConcurrentStreams : public Message {
+        MESSAGE_CLASS_DECLARATION
+    public:
+        ConfigureConcurrentStreams(bool concurrentStreams) :
+            Message(),
+            m_concurrentStreams(concurrentStreams)
+        { }
+        bool getConcurrentStreams() const { return m_concurrentStreams; }
+    private:
+        bool m_concurrentStreams;
+    };
+
     class SetSpectrumSinkInput : public Message {
         MESSAGE_CLASS_DECLARATION
     public:
@@ -255,59 +269,25 @@ public:
 	QString deviceDescription(); //!< Return the device description
 
    	void configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection, int isource); //!< Configure source DSP corrections
+    void configureConcurrentStreams(bool concurrentStreams); //!< Process each stream of synchronous FIFOs on its own worker
 
 private:
     struct SourceCorrection
     {
         bool m_dcOffsetCorrection;
         bool m_iqImbalanceCorrection;
-        double m_iOffset;
-        double m_qOffset;
-        int m_iRange;
-        int m_qRange;
-        int m_imbalance;
-        MovingAverageUtil<int32_t, int64_t, 1024> m_iBeta;
-        MovingAverageUtil<int32_t, int64_t, 1024> m_qBeta;
-#if IMBALANCE_INT
-        // Fixed point DC + IQ corrections
-        MovingAverageUtil<int64_t, int64_t, 128> m_avgII;
-        MovingAverageUtil<int64_t, int64_t, 128> m_avgIQ;
-        MovingAverageUtil<int64_t, int64_t, 128> m_avgPhi;
-        MovingAverageUtil<int64_t, int64_t, 128> m_avgII2;
-        MovingAverageUtil<int64_t, int64_t, 128> m_avgQQ2;
-        MovingAverageUtil<int64_t, int64_t, 128> m_avgAmp;
-#else
-        // Floating point DC + IQ corrections
-        MovingAverageUtil<float, double, 128> m_avgII;
-        MovingAverageUtil<float, double, 128> m_avgIQ;
-        MovingAverageUtil<float, double, 128> m_avgII2;
-        MovingAverageUtil<float, double, 128> m_avgQQ2;
-        MovingAverageUtil<double, double, 128> m_avgPhi;
-        MovingAverageUtil<double, double, 128> m_avgAmp;
-#endif
+        IQCorrector m_iqCorrector;
+        SampleVector m_correctionBuffer; //!< Corrected samples of the read only sink FIFO data
+
         SourceCorrection()
         {
             m_dcOffsetCorrection = false;
             m_iqImbalanceCorrection = false;
-            m_iOffset = 0;
-            m_qOffset = 0;
-            m_iRange = 1 << 16;
-            m_qRange = 1 << 16;
-            m_imbalance = 65536;
-            m_iBeta.reset();
-            m_qBeta.reset();
-            m_avgAmp.reset();
-            m_avgII.reset();
-            m_avgII2.reset();
-            m_avgIQ.reset();
-            m_avgPhi.reset();
-            m_avgQQ2.reset();
-            m_iBeta.reset();
-            m_qBeta.reset();
         }
     };
 
 	uint32_t m_uid; //!< unique ID
+	int m_arenaNode; //!< BufferArena node of the device FIFOs: the node the engine thread started on
     State m_stateRx;
     State m_stateTx;
 
@@ -327,13 +307,18 @@ private:
 	std::vector<BasebandSampleSources> m_basebandSampleSources; //!< channel sample sources (per output stream)
     std::vector<IncrementalVector<Sample>> m_sourceSampleBuffers;
     std::vector<IncrementalVector<Sample>> m_sourceZeroBuffers;
-    unsigned int m_sumIndex;            //!< channel index when summing channels
+    std::vector<IncrementalVector<qint32>> m_sourceMixBuffers; //!< I/Q accumulators when mixing channels (per output stream)
 
     typedef std::list<MIMOChannel*> MIMOChannels;
     MIMOChannels m_mimoChannels; //!< MIMO channels
 
     std::vector<SourceCorrection> m_sourcesCorrections;
 
+    bool m_concurrentStreams;       //!< Process streams of synchronous FIFOs concurrently
+    StreamWorkers m_streamWorkers;  //!< One worker per stream beyond the first one when processing concurrently
+    std::vector<SampleVector::const_iterator> m_sinkBlockBegins; //!< Start of the processed block of each stream (concurrent mode)
+    std::vector<SampleVector::const_iterator> m_sinkBlockEnds;   //!< End of the processed block of each stream (concurrent mode)
+
     BasebandSampleSink *m_spectrumSink; //!< The spectrum sink
     bool m_spectrumInputSourceElseSink; //!< Source else sink stream to be used as spectrum sink input
     unsigned int m_spectrumInputIndex;  //!< Index of the stream to be used as spectrum sink input
@@ -342,9 +327,20 @@ private:
     void workSampleSinkFifos(); //!< transfer samples of all sink streams (sync mode)
     void workSampleSinkFifo(unsigned int streamIndex); //!< transfer samples of one sink stream (async mode)
     void workSamplesSink(const SampleVector::const_iterator& vbegin, const SampleVector::const_iterator& vend, unsigned int streamIndex);
+    void workSamplesSinkStream( //!< corrections and single stream sinks. Returns the corrected samples range
+        const SampleVector::const_iterator& vbegin,
+        const SampleVector::const_iterator& vend,
+        unsigned int streamIndex,
+        SampleVector::const_iterator& begin,
+        SampleVector::const_iterator& end
+    );
+    void workSamplesSinkMIMO(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, unsigned int streamIndex);
+    void workSamplesSinkConcurrent(const std::vector<SampleVector>& data, unsigned int iBegin, unsigned int iEnd);
     void workSampleSourceFifos(); //!< transfer samples of all source streams (sync mode)
     void workSampleSourceFifo(unsigned int streamIndex); //!< transfer samples of one source stream (async mode)
     void workSamplesSource(SampleVector& data, unsigned int iBegin, unsigned int iEnd, unsigned int streamIndex);
+    void workSamplesSourceConcurrent(std::vector<SampleVector>& data, unsigned int iBegin, unsigned int iEnd);
+    void updateStreamWorkers(); //!< Start or stop stream workers according to mode and MIMO device
 
 	State gotoIdle(int subsystemIndex);     //!< Go to the idle state
 	State gotoInit(int subsystemIndex);     //!< Go to the acquisition init state from idle
@@ -352,7 +348,7 @@ private:
 	State gotoError(int subsystemIndex, const QString& errorMsg); //!< Go to an error state
 
     void handleSetMIMO(DeviceSampleMIMO* mimo); //!< Manage MIMO device setting
-   	void iqCorrections(SampleVector::iterator begin, SampleVector::iterator end, int isource, bool imbalanceCorrection);
+   	void iqCorrections(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, int isource, bool imbalanceCorrection);
 
 private slots:
 	void handleDataRxSync();           //!< Handle data when Rx samples have to be processed synchronously
@@ -26,11 +26,14 @@
 #include "dsp/basebandsamplesink.h"
 #include "dsp/devicesamplesink.h"
 #include "dsp/dspcommands.h"
+#include "dsp/samplemixer.h"
 #include "samplesourcefifodb.h"
+#include "util/bufferarena.h"
 
 DSPDeviceSinkEngine::DSPDeviceSinkEngine(uint32_t uid, QObject* parent) :
 	QThread(parent),
     m_uid(uid),
+    m_arenaNode(-1),
 	m_state(StNotStarted),
 	m_deviceSampleSink(nullptr),
 	m_sampleSinkSequence(0),
@@ -49,11 +52,13 @@ DSPDeviceSinkEngine::~DSPDeviceSinkEngine()
 {
     stop();
 	wait();
+    BufferArena::instance().trim(this);
 }
 
 void DSPDeviceSinkEngine::run()
 {
 	qDebug() << "DSPDeviceSinkEngine::run";
+	m_arenaNode = BufferArena::getCurrentNode(); // the device FIFOs are placed on this node
 	m_state = StIdle;
 	exec();
 }
@@ -204,33 +209,26 @@ void DSPDeviceSinkEngine::workSamples(SampleVector& data, unsigned int iBegin, u
     }
     else
     {
+        // channel sources render in their own baseband threads ahead of the engine so only
+        // the collection of their output and the mix happen here
         m_sourceSampleBuffer.allocate(nbSamples);
+        m_sourceMixBuffer.allocate(2*nbSamples);
         SampleVector::iterator sBegin = m_sourceSampleBuffer.m_vector.begin();
+        qint32 *acc = m_sourceMixBuffer.m_vector.data();
         BasebandSampleSources::const_iterator srcIt = m_basebandSampleSources.begin();
-        BasebandSampleSource *source = *srcIt;
-        source->pull(begin, nbSamples);
-        srcIt++;
-        m_sumIndex = 1;
 
-        for (; srcIt != m_basebandSampleSources.end(); ++srcIt, m_sumIndex++)
+        for (; srcIt != m_basebandSampleSources.end(); ++srcIt)
         {
-            source = *srcIt;
-            source->pull(sBegin, nbSamples);
-            std::transform(
-                sBegin,
-                sBegin + nbSamples,
-                data.begin() + iBegin,
-                data.begin() + iBegin,
-                [this](Sample& a, const Sample& b) -> Sample {
-                    int den = m_sumIndex + 1; // at each stage scale sum by n/n+1 and input by 1/n+1
-                    int nom = m_sumIndex;     // so that final sum is scaled by N (number of channels)
-                    return Sample{
-                        a.real()/den + nom*(b.real()/den),
-                        a.imag()/den + nom*(b.imag()/den)
-                    };
-                }
-            );
+            (*srcIt)->pull(sBegin, nbSamples);
+
+            if (srcIt == m_basebandSampleSources.begin()) {
+                SampleMixer::load(&(*sBegin), acc, nbSamples);
+            } else {
+                SampleMixer::accumulate(&(*sBegin), acc, nbSamples);
+            }
         }
+
+        SampleMixer::mix(acc, &(*begin), nbSamples, m_basebandSampleSources.size());
     }
 
     // possibly feed data to spectrum sink
@@ -274,6 +272,7 @@ DSPDeviceSinkEngine::State DSPDeviceSinkEngine::gotoIdle()
 		(*it)->stop();
 	}
 
+	BufferArena::instance().trim(this); // cached blocks released by the device FIFOs
 	m_deviceDescription.clear();
 	m_sampleRate = 0;
 
@@ -403,6 +402,7 @@ void DSPDeviceSinkEngine::handleSetSink(DeviceSampleSink* sink)
     }
 
     qDebug("DSPDeviceSinkEngine::handleSetSink: set %s", qPrintable(sink->getDeviceDescription()));
+    m_deviceSampleSink->getSampleFifo()->setArena(m_arenaNode, this);
 
     QObject::connect(
         m_deviceSampleSink->getSampleFifo(),
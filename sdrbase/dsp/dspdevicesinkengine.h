@@ -82,6 +82,7 @@ public:
 
 private:
 	uint32_t m_uid; //!< unique ID
+	int m_arenaNode; //!< BufferArena node of the device FIFOs: the node the engine thread started on
 
 	MessageQueue m_inputMessageQueue;  //<! Input message queue. Post here.
 	SyncMessenger m_syncMessenger;     //!< Used to process messages synchronously with the thread
@@ -100,10 +101,10 @@ private:
 	BasebandSampleSink *m_spectrumSink;
     IncrementalVector<Sample> m_sourceSampleBuffer;
     IncrementalVector<Sample> m_sourceZeroBuffer;
+    IncrementalVector<qint32> m_sourceMixBuffer; //!< I/Q accumulator when mixing channels
 
 	uint32_t m_sampleRate;
 	quint64 m_centerFrequency;
-    unsigned int m_sumIndex; //!< channel index when summing channels
 
 	void run();
 	void workSampleFifo(); //!< transfer samples from baseband sources to sink if in running state
@@ -23,12 +23,15 @@
 #include <stdio.h>
 #include <QDebug>
 #include "dsp/dspcommands.h"
-#include "util/fixed.h"
 #include "samplesinkfifo.h"
+#include "fsamplesinkfifo.h"
+#include "devicetimealigner.h"
+#include "util/bufferarena.h"
 
 DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	QThread(parent),
     m_uid(uid),
+    m_arenaNode(-1),
 	m_state(StNotStarted),
 	m_deviceSampleSource(nullptr),
 	m_sampleSourceSequence(0),
@@ -37,6 +40,9 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	m_centerFrequency(0),
 	m_dcOffsetCorrection(false),
 	m_iqImbalanceCorrection(false),
+	m_compactSamples(false),
+	m_timeAligner(nullptr),
+	m_timeAlignerStream(0),
 	m_iOffset(0),
 	m_qOffset(0),
 	m_iRange(1 << 16),
@@ -53,11 +59,13 @@ DSPDeviceSourceEngine::~DSPDeviceSourceEngine()
 {
     stop();
     wait();
+    BufferArena::instance().trim(this);
 }
 
 void DSPDeviceSourceEngine::run()
 {
 	qDebug() << "DSPDeviceSourceEngine::run";
+	m_arenaNode = BufferArena::getCurrentNode(); // the device FIFOs are placed on this node
 	m_state = StIdle;
     exec();
 }
@@ -141,6 +149,20 @@ void DSPDeviceSourceEngine::configureCorrections(bool dcOffsetCorrection, bool i
 	m_inputMessageQueue.push(cmd);
 }
 
+void DSPDeviceSourceEngine::configureCompactSamples(bool compactSamples)
+{
+	qDebug() << "DSPDeviceSourceEngine::configureCompactSamples: " << compactSamples;
+	DSPConfigureCompactSamples* cmd = new DSPConfigureCompactSamples(compactSamples);
+	m_inputMessageQueue.push(cmd);
+}
+
+void DSPDeviceSourceEngine::configureTimeAligner(DeviceTimeAligner *timeAligner, unsigned int streamIndex)
+{
+	qDebug() << "DSPDeviceSourceEngine::configureTimeAligner: stream: " << streamIndex;
+	DSPConfigureTimeAligner cmd(timeAligner, streamIndex); // synchronous so that the aligner can be deleted after detaching
+	m_syncMessenger.sendWait(cmd);
+}
+
 QString DSPDeviceSourceEngine::errorMessage()
 {
 	qDebug() << "DSPDeviceSourceEngine::errorMessage";
@@ -159,103 +181,17 @@ QString DSPDeviceSourceEngine::sourceDeviceDescription()
 
 void DSPDeviceSourceEngine::iqCorrections(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection)
 {
-    for(SampleVector::iterator it = begin; it < end; it++)
-    {
-        m_iBeta(it->real());
-        m_qBeta(it->imag());
-
-        if (imbalanceCorrection)
-        {
-#if IMBALANCE_INT
-            // acquisition
-            int64_t xi = (it->m_real - (int32_t) m_iBeta) << 5;
-            int64_t xq = (it->m_imag - (int32_t) m_qBeta) << 5;
-
-            // phase imbalance
-            m_avgII((xi*xi)>>28); // <I", I">
-            m_avgIQ((xi*xq)>>28); // <I", Q">
-
-            if ((int64_t) m_avgII != 0)
-            {
-                int64_t phi = (((int64_t) m_avgIQ)<<28) / (int64_t) m_avgII;
-                m_avgPhi(phi);
-            }
-
-            int64_t corrPhi = (((int64_t) m_avgPhi) * xq) >> 28;  //(m_avgPhi.asDouble()/16777216.0) * ((double) xq);
-
-            int64_t yi = xi - corrPhi;
-            int64_t yq = xq;
-
-            // amplitude I/Q imbalance
-            m_avgII2((yi*yi)>>28); // <I, I>
-            m_avgQQ2((yq*yq)>>28); // <Q, Q>
-
-            if ((int64_t) m_avgQQ2 != 0)
-            {
-                int64_t a = (((int64_t) m_avgII2)<<28) / (int64_t) m_avgQQ2;
-                Fixed<int64_t, 28> fA(Fixed<int64_t, 28>::internal(), a);
-                Fixed<int64_t, 28> sqrtA = sqrt((Fixed<int64_t, 28>) fA);
-                m_avgAmp(sqrtA.as_internal());
-            }
-
-            int64_t zq = (((int64_t) m_avgAmp) * yq) >> 28;
-
-            it->m_real = yi >> 5;
-            it->m_imag = zq >> 5;
-
-#else
-            // DC correction and conversion
-            float xi = (it->m_real - (int32_t) m_iBeta) / SDR_RX_SCALEF;
-            float xq = (it->m_imag - (int32_t) m_qBeta) / SDR_RX_SCALEF;
-
-            // phase imbalance
-            m_avgII(xi*xi); // <I", I">
-            m_avgIQ(xi*xq); // <I", Q">
-
-
-            if (m_avgII.asDouble() != 0) {
-                m_avgPhi(m_avgIQ.asDouble()/m_avgII.asDouble());
-            }
-
-            float& yi = xi; // the in phase remains the reference
-            float yq = xq - m_avgPhi.asDouble()*xi;
-
-            // amplitude I/Q imbalance
-            m_avgII2(yi*yi); // <I, I>
-            m_avgQQ2(yq*yq); // <Q, Q>
-
-            if (m_avgQQ2.asDouble() != 0) {
-                m_avgAmp(sqrt(m_avgII2.asDouble() / m_avgQQ2.asDouble()));
-            }
-
-            // final correction
-            float& zi = yi; // the in phase remains the reference
-            float zq = m_avgAmp.asDouble() * yq;
+    m_iqCorrector.process(begin, end, imbalanceCorrection);
+}
 
-            // convert and store
-            it->m_real = zi * SDR_RX_SCALEF;
-            it->m_imag = zq * SDR_RX_SCALEF;
-#endif
-        }
-        else
-        {
-            // DC correction only
-            it->m_real -= (int32_t) m_iBeta;
-            it->m_imag -= (int32_t) m_qBeta;
-        }
-    }
+void DSPDeviceSourceEngine::iqCorrections(FSampleVector::iterator begin, FSampleVector::iterator end, bool imbalanceCorrection)
+{
+    m_iqCorrectorF.process(begin, end, imbalanceCorrection);
 }
 
 void DSPDeviceSourceEngine::dcOffset(SampleVector::iterator begin, SampleVector::iterator end)
 {
-	// sum and correct in one pass
-	for(SampleVector::iterator it = begin; it < end; it++)
-	{
-	    m_iBeta(it->real());
-	    m_qBeta(it->imag());
-	    it->m_real -= (int32_t) m_iBeta;
-	    it->m_imag -= (int32_t) m_qBeta;
-	}
+    m_iqCorrector.process(begin, end, false);
 }
 
 void DSPDeviceSourceEngine::imbalance(SampleVector::iterator begin, SampleVector::iterator end)
@@ -321,6 +257,8 @@ void DSPDeviceSourceEngine::work()
 		SampleVector::iterator part2end;
 
 		std::size_t count = sampleFifo->readBegin(sampleFifo->fill(), &part1begin, &part1end, &part2begin, &part2end);
+		bool timeAlign = m_timeAligner && (m_sampleRate > 0);
+		qint64 timestampUs = timeAlign ? sampleFifo->getReadTimestampUs() : 0;
 
 		// first part of FIFO data
 		if (part1begin != part1end)
@@ -331,6 +269,10 @@ void DSPDeviceSourceEngine::work()
                 iqCorrections(part1begin, part1end, m_iqImbalanceCorrection);
             }
 
+            if (timeAlign) {
+                m_timeAligner->feed(m_timeAlignerStream, part1begin, part1end, timestampUs, m_sampleRate);
+            }
+
 			// feed data to direct sinks
 			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it)
 			{
@@ -348,6 +290,12 @@ void DSPDeviceSourceEngine::work()
                 iqCorrections(part2begin, part2end, m_iqImbalanceCorrection);
             }
 
+            if (timeAlign)
+            {
+                qint64 part2TimestampUs = timestampUs == 0 ? 0 : timestampUs + ((qint64) (part1end - part1begin) * 1000000LL) / m_sampleRate;
+                m_timeAligner->feed(m_timeAlignerStream, part2begin, part2end, part2TimestampUs, m_sampleRate);
+            }
+
 			// feed data to direct sinks
 			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); it++)
 			{
@@ -362,6 +310,48 @@ void DSPDeviceSourceEngine::work()
 	}
 }
 
+void DSPDeviceSourceEngine::workFloat()
+{
+	FSampleSinkFifo* sampleFifo = m_deviceSampleSource->getFloatSampleFifo();
+	std::size_t samplesDone = 0;
+	bool positiveOnly = false;
+
+	while ((sampleFifo->fill() > 0) && (m_inputMessageQueue.size() == 0) && (samplesDone < m_sampleRate))
+	{
+		FSampleVector::iterator part1begin;
+		FSampleVector::iterator part1end;
+		FSampleVector::iterator part2begin;
+		FSampleVector::iterator part2end;
+
+		std::size_t count = sampleFifo->readBegin(sampleFifo->fill(), &part1begin, &part1end, &part2begin, &part2end);
+
+		if (part1begin != part1end)
+		{
+            if (m_dcOffsetCorrection) {
+                iqCorrections(part1begin, part1end, m_iqImbalanceCorrection);
+            }
+
+			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it) {
+				(*it)->feedFloat(part1begin, part1end, positiveOnly);
+			}
+		}
+
+		if (part2begin != part2end)
+		{
+            if (m_dcOffsetCorrection) {
+                iqCorrections(part2begin, part2end, m_iqImbalanceCorrection);
+            }
+
+			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it) {
+				(*it)->feedFloat(part2begin, part2end, positiveOnly);
+			}
+		}
+
+		sampleFifo->readCommit((unsigned int) count);
+		samplesDone += count;
+	}
+}
+
 // notStarted -> idle -> init -> running -+
 //                ^                       |
 //                +-----------------------+
@@ -396,6 +386,7 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoIdle()
 		(*it)->stop();
 	}
 
+	BufferArena::instance().trim(this); // cached blocks released by the device FIFOs
 	m_deviceDescription.clear();
 	m_sampleRate = 0;
 
@@ -527,6 +518,10 @@ void DSPDeviceSourceEngine::handleSetSource(DeviceSampleSource* source)
 	{
 		qDebug("DSPDeviceSourceEngine::handleSetSource: set %s", qPrintable(source->getDeviceDescription()));
 		connect(m_deviceSampleSource->getSampleFifo(), SIGNAL(dataReady()), this, SLOT(handleData()), Qt::QueuedConnection);
+		connect(m_deviceSampleSource->getFloatSampleFifo(), SIGNAL(dataReady()), this, SLOT(handleData()), Qt::QueuedConnection);
+		m_deviceSampleSource->getSampleFifo()->setCompact(m_compactSamples);
+		m_deviceSampleSource->getSampleFifo()->setArena(m_arenaNode, this);
+		m_deviceSampleSource->getFloatSampleFifo()->setArena(m_arenaNode, this);
 	}
 	else
 	{
@@ -539,6 +534,7 @@ void DSPDeviceSourceEngine::handleData()
 	if(m_state == StRunning)
 	{
 		work();
+		workFloat();
 	}
 }
 
@@ -583,6 +579,7 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
         // initialize sample rate and center frequency in the sink:
         DSPSignalNotification msg(m_sampleRate, m_centerFrequency);
         sink->handleMessage(msg);
+        sink->setCompactSamples(m_compactSamples);
         // start the sink:
         if(m_state == StRunning) {
             sink->start();
@@ -598,6 +595,12 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
 
 		m_basebandSampleSinks.remove(sink);
 	}
+	else if (DSPConfigureTimeAligner::match(*message))
+	{
+		DSPConfigureTimeAligner *conf = (DSPConfigureTimeAligner*) message;
+		m_timeAligner = conf->getTimeAligner();
+		m_timeAlignerStream = conf->getStreamIndex();
+	}
 
 	m_syncMessenger.done(m_state);
 }
@@ -630,14 +633,23 @@ void DSPDeviceSourceEngine::handleInputMessages()
 				m_imbalance = 65536;
 			}
 
-			m_avgAmp.reset();
-			m_avgII.reset();
-			m_avgII2.reset();
-			m_avgIQ.reset();
-			m_avgPhi.reset();
-			m_avgQQ2.reset();
-			m_iBeta.reset();
-			m_qBeta.reset();
+			m_iqCorrector.reset();
+			m_iqCorrectorF.reset();
+
+			delete message;
+		}
+		else if (DSPConfigureCompactSamples::match(*message))
+		{
+			DSPConfigureCompactSamples* conf = (DSPConfigureCompactSamples*) message;
+			m_compactSamples = conf->getCompactSamples();
+
+			if (m_deviceSampleSource) {
+				m_deviceSampleSource->getSampleFifo()->setCompact(m_compactSamples);
+			}
+
+			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it) {
+				(*it)->setCompactSamples(m_compactSamples);
+			}
 
 			delete message;
 		}
@@ -650,6 +662,10 @@ void DSPDeviceSourceEngine::handleInputMessages()
 			m_sampleRate = notif->getSampleRate();
 			m_centerFrequency = notif->getCenterFrequency();
 
+			if (m_deviceSampleSource) {
+				m_deviceSampleSource->getSampleFifo()->setSampleRate(m_sampleRate); // seeds the sample clock
+			}
+
 			qDebug() << "DSPDeviceSourceEngine::handleInputMessages: DSPSignalNotification:"
 				<< " m_sampleRate: " << m_sampleRate
 				<< " m_centerFrequency: " << m_centerFrequency;
@@ -25,13 +25,14 @@
 #include <QWaitCondition>
 #include "dsp/dsptypes.h"
 #include "dsp/fftwindow.h"
+#include "dsp/iqcorrector.h"
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
 #include "export.h"
-#include "util/movingaverage.h"
 
 class DeviceSampleSource;
 class BasebandSampleSink;
+class DeviceTimeAligner;
 
 class SDRBASE_API DSPDeviceSourceEngine : public QThread {
 	Q_OBJECT
@@ -67,6 +68,9 @@ public:
 	void removeSink(BasebandSampleSink* sink); //!< Remove a sample sink
 
 	void configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection); //!< Configure DSP corrections
+	void configureCompactSamples(bool compactSamples); //!< Use 16 bit storage in the device and channel FIFOs
+	bool getCompactSamples() const { return m_compactSamples; }
+	void configureTimeAligner(DeviceTimeAligner *timeAligner, unsigned int streamIndex); //!< Feed timestamped samples to the aligner as this stream. Null to detach
 
 	State state() const { return m_state; } //!< Return DSP engine current state
 
@@ -75,6 +79,7 @@ public:
 
 private:
 	uint m_uid; //!< unique ID
+	int m_arenaNode; //!< BufferArena node of the device FIFOs: the node the engine thread started on
 
 	MessageQueue m_inputMessageQueue;  //<! Input message queue. Post here.
 	SyncMessenger m_syncMessenger;     //!< Used to process messages synchronously with the thread
@@ -95,29 +100,13 @@ private:
 
 	bool m_dcOffsetCorrection;
 	bool m_iqImbalanceCorrection;
+	bool m_compactSamples;
+	DeviceTimeAligner *m_timeAligner;
+	unsigned int m_timeAlignerStream;
 	double m_iOffset, m_qOffset;
 
-	MovingAverageUtil<int32_t, int64_t, 1024> m_iBeta;
-    MovingAverageUtil<int32_t, int64_t, 1024> m_qBeta;
-
-#if IMBALANCE_INT
-    // Fixed point DC + IQ corrections
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgII;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgIQ;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgPhi;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgII2;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgQQ2;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgAmp;
-
-#else
-    // Floating point DC + IQ corrections
-    MovingAverageUtil<float, double, 128> m_avgII;
-    MovingAverageUtil<float, double, 128> m_avgIQ;
-    MovingAverageUtil<float, double, 128> m_avgII2;
-    MovingAverageUtil<float, double, 128> m_avgQQ2;
-    MovingAverageUtil<double, double, 128> m_avgPhi;
-    MovingAverageUtil<double, double, 128> m_avgAmp;
-#endif
+	IQCorrector m_iqCorrector;  //!< DC and IQ imbalance corrections
+	IQCorrector m_iqCorrectorF; //!< same for the float baseband
 
     qint32 m_iRange;
 	qint32 m_qRange;
@@ -126,9 +115,11 @@ private:
 	void run();
 
 	void iqCorrections(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection);
+	void iqCorrections(FSampleVector::iterator begin, FSampleVector::iterator end, bool imbalanceCorrection);
 	void dcOffset(SampleVector::iterator begin, SampleVector::iterator end);
 	void imbalance(SampleVector::iterator begin, SampleVector::iterator end);
 	void work(); //!< transfer samples from source to sinks if in running state
+	void workFloat(); //!< same for the float baseband FIFO
 
 	State gotoIdle();     //!< Go to the idle state
 	State gotoInit();     //!< Go to the acquisition init state from idle
@@ -189,7 +189,21 @@ void DSPEngine::pushMbeFrame(
         int upsampling,
         AudioFifo *audioFifo)
 {
-    m_ambeEngine.pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo);
+    if (m_ambeEngine.getNbDevices() > 0) {
+        m_ambeEngine.pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo);
+    } else {
+        m_mbeWorkerPool.pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo);
+    }
+}
+
+bool DSPEngine::hasMbeOffloadSupport()
+{
+    return hasDVSerialSupport() || MBEWorkerPool::isAvailable();
+}
+
+void DSPEngine::releaseMbeChannel(AudioFifo *audioFifo)
+{
+    m_mbeWorkerPool.releaseChannel(audioFifo);
 }
 
 void DSPEngine::createFFTFactory(const QString& fftWisdomFileName)
@@ -28,6 +28,7 @@
 #include "audio/audioinput.h"
 #include "export.h"
 #include "ambe/ambeengine.h"
+#include "ambe/mbeworkerpool.h"
 
 class DSPDeviceSourceEngine;
 class DSPDeviceSinkEngine;
@@ -55,6 +56,7 @@ public:
 
 	AudioDeviceManager *getAudioDeviceManager() { return &m_audioDeviceManager; }
 	AMBEEngine *getAMBEEngine() { return &m_ambeEngine; }
+	MBEWorkerPool *getMBEWorkerPool() { return &m_mbeWorkerPool; }
 
     uint32_t getDeviceSourceEnginesNumber() const { return m_deviceSourceEngines.size(); }
     DSPDeviceSourceEngine *getDeviceSourceEngineByIndex(uint deviceIndex) { return m_deviceSourceEngines[deviceIndex]; }
@@ -73,6 +75,8 @@ public:
 	bool hasDVSerialSupport();
 	void setDVSerialSupport(bool support);
 	void getDVSerialNames(std::vector<std::string>& deviceNames);
+	bool hasMbeOffloadSupport(); //!< MBE frames can be pushed (AMBE devices or software vocoder pool)
+	void releaseMbeChannel(AudioFifo *audioFifo);
 	void pushMbeFrame(
 	        const unsigned char *mbeFrame,
 	        int mbeRateIndex,
@@ -103,6 +107,7 @@ private:
 	bool m_dvSerialSupport;
     bool m_mimoSupport;
 	AMBEEngine m_ambeEngine;
+	MBEWorkerPool m_mbeWorkerPool;
     FFTFactory *m_fftFactory;
 };
 
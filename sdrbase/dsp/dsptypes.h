@@ -23,6 +23,8 @@
 #include <vector>
 #include <QtGlobal>
 
+#include "util/bufferarena.h"
+
 #ifdef SDR_RX_SAMPLE_24BIT
 #define SDR_RX_SAMP_SZ 24 // internal fixed arithmetic sample size
 #define SDR_RX_SCALEF 8388608.0f
@@ -87,14 +89,25 @@ struct FSample
 	Real m_imag;
 };
 
+struct CompactSample //!< 16 bit I/Q storage used by FIFOs in compact mode
+{
+	CompactSample() : m_real(0), m_imag(0) {}
+	CompactSample(qint16 real, qint16 imag) : m_real(real), m_imag(imag) {}
+
+	qint16 m_real;
+	qint16 m_imag;
+};
+
 struct AudioSample {
     qint16 l;
     qint16 r;
 };
 #pragma pack(pop)
 
-typedef std::vector<Sample> SampleVector;
-typedef std::vector<FSample> FSampleVector;
+// large sample buffers (FIFOs) are taken from the huge page arena
+typedef std::vector<Sample, ArenaAllocator<Sample>> SampleVector;
+typedef std::vector<FSample, ArenaAllocator<FSample>> FSampleVector;
+typedef std::vector<CompactSample, ArenaAllocator<CompactSample>> CompactSampleVector;
 typedef std::vector<AudioSample> AudioVector;
 
 #endif // INCLUDE_DSPTYPES_H
@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "fsamplesinkfifo.h"
+
+void FSampleSinkFifo::create(unsigned int s)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	BufferArena::Scope arenaScope(m_arenaNode, m_arenaOwner);
+	m_size = 0;
+	m_fill = 0;
+	m_head = 0;
+	m_tail = 0;
+
+	if (s > m_data.capacity()) { // release before allocating so that the arena can recycle the block
+		FSampleVector().swap(m_data);
+	}
+
+	m_data.resize(s);
+	m_size = m_data.size();
+}
+
+void FSampleSinkFifo::reset()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	m_suppressed = -1;
+	m_fill = 0;
+	m_head = 0;
+	m_tail = 0;
+}
+
+FSampleSinkFifo::FSampleSinkFifo(QObject* parent) :
+	QObject(parent),
+	m_data(),
+	m_arenaNode(-1),
+	m_arenaOwner(nullptr)
+{
+	m_suppressed = -1;
+	m_size = 0;
+	m_fill = 0;
+	m_head = 0;
+	m_tail = 0;
+}
+
+FSampleSinkFifo::FSampleSinkFifo(int size, QObject* parent) :
+	QObject(parent),
+	m_data(),
+	m_arenaNode(-1),
+	m_arenaOwner(nullptr)
+{
+	m_suppressed = -1;
+	create(size);
+}
+
+FSampleSinkFifo::~FSampleSinkFifo()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	m_size = 0;
+}
+
+bool FSampleSinkFifo::setSize(int size)
+{
+	create(size);
+
+	return m_data.size() == (unsigned int)size;
+}
+
+void FSampleSinkFifo::setArena(int node, const void *owner)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	m_arenaNode = node;
+	m_arenaOwner = owner;
+}
+
+unsigned int FSampleSinkFifo::write(FSampleVector::const_iterator begin, FSampleVector::const_iterator end)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	unsigned int count = end - begin;
+	unsigned int total;
+	unsigned int remaining;
+	unsigned int len;
+
+	total = std::min(count, m_size - m_fill);
+
+    if (total < count)
+    {
+		if (m_suppressed < 0)
+        {
+			m_suppressed = 0;
+			m_msgRateTimer.start();
+			qCritical("FSampleSinkFifo::write: overflow - dropping %u samples", count - total);
+		}
+        else
+        {
+			if (m_msgRateTimer.elapsed() > 2500)
+            {
+				qCritical("FSampleSinkFifo::write: %u messages dropped", m_suppressed);
+				qCritical("FSampleSinkFifo::write: overflow - dropping %u samples", count - total);
+				m_suppressed = -1;
+			}
+            else
+            {
+				m_suppressed++;
+			}
+		}
+	}
+
+	remaining = total;
+
+    while (remaining > 0)
+    {
+		len = std::min(remaining, m_size - m_tail);
+		std::copy(begin, begin + len, m_data.begin() + m_tail);
+		m_tail += len;
+		m_tail %= m_size;
+		m_fill += len;
+		begin += len;
+		remaining -= len;
+	}
+
+	if (m_fill > 0) {
+		emit dataReady();
+    }
+
+	return total;
+}
+
+unsigned int FSampleSinkFifo::readBegin(unsigned int count,
+	FSampleVector::iterator* part1Begin, FSampleVector::iterator* part1End,
+	FSampleVector::iterator* part2Begin, FSampleVector::iterator* part2End)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	unsigned int total;
+	unsigned int remaining;
+	unsigned int len;
+	unsigned int head = m_head;
+
+	total = std::min(count, m_fill);
+
+    if (total < count) {
+		qCritical("FSampleSinkFifo::readBegin: underflow - missing %u samples", count - total);
+    }
+
+	remaining = total;
+
+    if (remaining > 0)
+    {
+		len = std::min(remaining, m_size - head);
+		*part1Begin = m_data.begin() + head;
+		*part1End = m_data.begin() + head + len;
+		head += len;
+		head %= m_size;
+		remaining -= len;
+	}
+    else
+    {
+		*part1Begin = m_data.end();
+		*part1End = m_data.end();
+	}
+
+    if (remaining > 0)
+    {
+		len = std::min(remaining, m_size - head);
+		*part2Begin = m_data.begin() + head;
+		*part2End = m_data.begin() + head + len;
+	}
+    else
+    {
+		*part2Begin = m_data.end();
+		*part2End = m_data.end();
+	}
+
+	return total;
+}
+
+unsigned int FSampleSinkFifo::readCommit(unsigned int count)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (count > m_fill)
+    {
+		qCritical("FSampleSinkFifo::readCommit: cannot commit more than available samples");
+		count = m_fill;
+	}
+
+    m_head = (m_head + count) % m_size;
+	m_fill -= count;
+
+	return count;
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_FSAMPLESINKFIFO_H
+#define INCLUDE_FSAMPLESINKFIFO_H
+
+#include <QObject>
+#include <QMutex>
+#include <QElapsedTimer>
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Float counterpart of SampleSinkFifo used by the float baseband pipeline.
+ * Samples are normalized to full scale 1.0.
+ */
+class SDRBASE_API FSampleSinkFifo : public QObject {
+	Q_OBJECT
+
+private:
+	QMutex m_mutex;
+	QElapsedTimer m_msgRateTimer;
+	int m_suppressed;
+
+	FSampleVector m_data;
+	int m_arenaNode;          //!< BufferArena node of the storage
+	const void *m_arenaOwner; //!< BufferArena owner of the storage
+
+	unsigned int m_size;
+	unsigned int m_fill;
+	unsigned int m_head;
+	unsigned int m_tail;
+
+	void create(unsigned int s);
+
+public:
+	FSampleSinkFifo(QObject* parent = nullptr);
+	FSampleSinkFifo(int size, QObject* parent = nullptr);
+	~FSampleSinkFifo();
+
+	bool setSize(int size);
+	void setArena(int node, const void *owner); //!< NUMA node (-1 follows the CPU) and BufferArena owner of the storage allocated from now on
+    void reset();
+	inline unsigned int size() const { return m_size; }
+	inline unsigned int fill() { QMutexLocker mutexLocker(&m_mutex); unsigned int fill = m_fill; return fill; }
+
+	unsigned int write(FSampleVector::const_iterator begin, FSampleVector::const_iterator end);
+
+	unsigned int readBegin(unsigned int count,
+		FSampleVector::iterator* part1Begin, FSampleVector::iterator* part1End,
+		FSampleVector::iterator* part2Begin, FSampleVector::iterator* part2End);
+	unsigned int readCommit(unsigned int count);
+
+signals:
+	void dataReady();
+};
+
+#endif // INCLUDE_FSAMPLESINKFIFO_H
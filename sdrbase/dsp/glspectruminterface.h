@@ -27,6 +27,9 @@ public:
     GLSpectrumInterface() {}
     virtual ~GLSpectrumInterface() {}
     virtual void newSpectrum(const std::vector<Real>& spectrum, int fftSize) {}
+    /** Spectrum stitched from several tunings. Overrides center frequency and span until stopPanorama() */
+    virtual void newPanorama(const std::vector<Real>& spectrum, qint64 centerFrequency, int span) {}
+    virtual void stopPanorama() {} //!< Restore the device center frequency and sample rate
 };
 
 #endif // SDRBASE_DSP_GLSPECTRUMINTERFACE_H_
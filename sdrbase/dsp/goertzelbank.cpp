@@ -0,0 +1,326 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDebug>
+
+#include "goertzelbank.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GOERTZELBANK_X86
+#include <immintrin.h>
+#endif
+
+#if defined(USE_NEON) || defined(__ARM_NEON)
+#define GOERTZELBANK_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+static const unsigned int vectorLanes = 8; //!< Widest vector (AVX2)
+
+struct Kernels
+{
+    const char *m_name;
+    //! Run n samples through lanes filters (lanes is a multiple of vectorLanes)
+    void (*run)(const float *in, unsigned int n, const float *coef, float *u0, float *u1, unsigned int lanes);
+};
+
+void runGeneric(const float *in, unsigned int n, const float *coef, float *u0, float *u1, unsigned int lanes)
+{
+    for (unsigned int k = 0; k < n; k++)
+    {
+        float x = in[k];
+
+        for (unsigned int j = 0; j < lanes; j++)
+        {
+            float t = u0[j];
+            u0[j] = x + coef[j] * t - u1[j];
+            u1[j] = t;
+        }
+    }
+}
+
+const Kernels genericKernels = {
+    "generic",
+    runGeneric
+};
+
+#if defined(GOERTZELBANK_X86)
+
+// AVX2 kernels. Compiled for AVX2/FMA whatever the build flags and only called when the processor supports them.
+// The filters of 4 vectors at a time stay in registers for the whole block to hide the FMA latency.
+
+__attribute__((target("avx2,fma")))
+void runAVX2(const float *in, unsigned int n, const float *coef, float *u0, float *u1, unsigned int lanes)
+{
+    unsigned int j = 0;
+
+    for (; j + 32 <= lanes; j += 32)
+    {
+        __m256 c0 = _mm256_loadu_ps(&coef[j]);
+        __m256 c1 = _mm256_loadu_ps(&coef[j+8]);
+        __m256 c2 = _mm256_loadu_ps(&coef[j+16]);
+        __m256 c3 = _mm256_loadu_ps(&coef[j+24]);
+        __m256 a0 = _mm256_loadu_ps(&u0[j]);
+        __m256 a1 = _mm256_loadu_ps(&u0[j+8]);
+        __m256 a2 = _mm256_loadu_ps(&u0[j+16]);
+        __m256 a3 = _mm256_loadu_ps(&u0[j+24]);
+        __m256 b0 = _mm256_loadu_ps(&u1[j]);
+        __m256 b1 = _mm256_loadu_ps(&u1[j+8]);
+        __m256 b2 = _mm256_loadu_ps(&u1[j+16]);
+        __m256 b3 = _mm256_loadu_ps(&u1[j+24]);
+
+        for (unsigned int k = 0; k < n; k++)
+        {
+            __m256 x = _mm256_set1_ps(in[k]);
+            __m256 t0 = a0, t1 = a1, t2 = a2, t3 = a3;
+            a0 = _mm256_sub_ps(_mm256_fmadd_ps(c0, a0, x), b0);
+            a1 = _mm256_sub_ps(_mm256_fmadd_ps(c1, a1, x), b1);
+            a2 = _mm256_sub_ps(_mm256_fmadd_ps(c2, a2, x), b2);
+            a3 = _mm256_sub_ps(_mm256_fmadd_ps(c3, a3, x), b3);
+            b0 = t0; b1 = t1; b2 = t2; b3 = t3;
+        }
+
+        _mm256_storeu_ps(&u0[j], a0);
+        _mm256_storeu_ps(&u0[j+8], a1);
+        _mm256_storeu_ps(&u0[j+16], a2);
+        _mm256_storeu_ps(&u0[j+24], a3);
+        _mm256_storeu_ps(&u1[j], b0);
+        _mm256_storeu_ps(&u1[j+8], b1);
+        _mm256_storeu_ps(&u1[j+16], b2);
+        _mm256_storeu_ps(&u1[j+24], b3);
+    }
+
+    for (; j < lanes; j += 8)
+    {
+        __m256 c0 = _mm256_loadu_ps(&coef[j]);
+        __m256 a0 = _mm256_loadu_ps(&u0[j]);
+        __m256 b0 = _mm256_loadu_ps(&u1[j]);
+
+        for (unsigned int k = 0; k < n; k++)
+        {
+            __m256 t0 = a0;
+            a0 = _mm256_sub_ps(_mm256_fmadd_ps(c0, a0, _mm256_set1_ps(in[k])), b0);
+            b0 = t0;
+        }
+
+        _mm256_storeu_ps(&u0[j], a0);
+        _mm256_storeu_ps(&u1[j], b0);
+    }
+}
+
+const Kernels avx2Kernels = {
+    "avx2",
+    runAVX2
+};
+
+#endif // GOERTZELBANK_X86
+
+#if defined(GOERTZELBANK_NEON)
+
+void runNEON(const float *in, unsigned int n, const float *coef, float *u0, float *u1, unsigned int lanes)
+{
+    unsigned int j = 0;
+
+    for (; j + 16 <= lanes; j += 16)
+    {
+        float32x4_t c0 = vld1q_f32(&coef[j]);
+        float32x4_t c1 = vld1q_f32(&coef[j+4]);
+        float32x4_t c2 = vld1q_f32(&coef[j+8]);
+        float32x4_t c3 = vld1q_f32(&coef[j+12]);
+        float32x4_t a0 = vld1q_f32(&u0[j]);
+        float32x4_t a1 = vld1q_f32(&u0[j+4]);
+        float32x4_t a2 = vld1q_f32(&u0[j+8]);
+        float32x4_t a3 = vld1q_f32(&u0[j+12]);
+        float32x4_t b0 = vld1q_f32(&u1[j]);
+        float32x4_t b1 = vld1q_f32(&u1[j+4]);
+        float32x4_t b2 = vld1q_f32(&u1[j+8]);
+        float32x4_t b3 = vld1q_f32(&u1[j+12]);
+
+        for (unsigned int k = 0; k < n; k++)
+        {
+            float32x4_t x = vdupq_n_f32(in[k]);
+            float32x4_t t0 = a0, t1 = a1, t2 = a2, t3 = a3;
+            a0 = vsubq_f32(vmlaq_f32(x, c0, a0), b0);
+            a1 = vsubq_f32(vmlaq_f32(x, c1, a1), b1);
+            a2 = vsubq_f32(vmlaq_f32(x, c2, a2), b2);
+            a3 = vsubq_f32(vmlaq_f32(x, c3, a3), b3);
+            b0 = t0; b1 = t1; b2 = t2; b3 = t3;
+        }
+
+        vst1q_f32(&u0[j], a0);
+        vst1q_f32(&u0[j+4], a1);
+        vst1q_f32(&u0[j+8], a2);
+        vst1q_f32(&u0[j+12], a3);
+        vst1q_f32(&u1[j], b0);
+        vst1q_f32(&u1[j+4], b1);
+        vst1q_f32(&u1[j+8], b2);
+        vst1q_f32(&u1[j+12], b3);
+    }
+
+    for (; j < lanes; j += 4)
+    {
+        float32x4_t c0 = vld1q_f32(&coef[j]);
+        float32x4_t a0 = vld1q_f32(&u0[j]);
+        float32x4_t b0 = vld1q_f32(&u1[j]);
+
+        for (unsigned int k = 0; k < n; k++)
+        {
+            float32x4_t t0 = a0;
+            a0 = vsubq_f32(vmlaq_f32(vdupq_n_f32(in[k]), c0, a0), b0);
+            b0 = t0;
+        }
+
+        vst1q_f32(&u0[j], a0);
+        vst1q_f32(&u1[j], b0);
+    }
+}
+
+const Kernels neonKernels = {
+    "neon",
+    runNEON
+};
+
+#endif // GOERTZELBANK_NEON
+
+const Kernels& selectKernels()
+{
+#if defined(GOERTZELBANK_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return avx2Kernels;
+    }
+#endif
+#if defined(GOERTZELBANK_NEON)
+    return neonKernels;
+#else
+    return genericKernels;
+#endif
+}
+
+const Kernels& kernels()
+{
+    static const Kernels& selected = selectKernels(); // thread safe initialization
+    return selected;
+}
+
+} // namespace
+
+GoertzelBank::GoertzelBank() :
+    m_nbChannels(0),
+    m_stride(0),
+    m_windowSize(0),
+    m_samplesProcessed(0),
+    m_sampleRate(0)
+{}
+
+void GoertzelBank::configure(unsigned int nbChannels, const std::vector<Real>& frequencies, int sampleRate, unsigned int windowSize)
+{
+    qDebug("GoertzelBank::configure: %u channels %u frequencies sample rate: %d window: %u kernels: %s",
+        nbChannels, (unsigned int) frequencies.size(), sampleRate, windowSize, getKernelsName());
+
+    m_frequencies = frequencies;
+    m_nbChannels = nbChannels;
+    m_stride = ((frequencies.size() + vectorLanes - 1) / vectorLanes) * vectorLanes;
+    m_sampleRate = sampleRate;
+    m_windowSize = windowSize;
+
+    // Padding filters have a null coefficient and are never read
+    m_coef.assign(m_stride, 0.0f);
+
+    for (unsigned int j = 0; j < frequencies.size(); j++) {
+        m_coef[j] = sampleRate > 0 ? 2.0 * cos((2.0 * M_PI * frequencies[j]) / (double) sampleRate) : 0.0;
+    }
+
+    m_u0.resize(m_nbChannels * m_stride);
+    m_u1.resize(m_nbChannels * m_stride);
+    m_powers.assign(m_nbChannels * m_stride, 0.0f);
+    reset();
+}
+
+void GoertzelBank::setWindowSize(unsigned int windowSize)
+{
+    m_windowSize = windowSize;
+    reset();
+}
+
+void GoertzelBank::reset()
+{
+    std::fill(m_u0.begin(), m_u0.end(), 0.0f);
+    std::fill(m_u1.begin(), m_u1.end(), 0.0f);
+    m_samplesProcessed = 0;
+}
+
+unsigned int GoertzelBank::feed(const float * const *channelSamples, unsigned int n)
+{
+    if ((m_windowSize == 0) || (m_stride == 0)) {
+        return 0;
+    }
+
+    const Kernels& k = kernels();
+    unsigned int windows = 0;
+    unsigned int done = 0;
+
+    while (done < n)
+    {
+        unsigned int chunk = std::min(n - done, m_windowSize - m_samplesProcessed);
+
+        for (unsigned int channel = 0; channel < m_nbChannels; channel++) {
+            k.run(&channelSamples[channel][done], chunk, m_coef.data(), &m_u0[channel*m_stride], &m_u1[channel*m_stride], m_stride);
+        }
+
+        done += chunk;
+        m_samplesProcessed += chunk;
+
+        if (m_samplesProcessed == m_windowSize)
+        {
+            evaluate();
+            m_samplesProcessed = 0;
+            windows++;
+        }
+    }
+
+    return windows;
+}
+
+void GoertzelBank::evaluate()
+{
+    for (unsigned int channel = 0; channel < m_nbChannels; channel++)
+    {
+        float *u0 = &m_u0[channel*m_stride];
+        float *u1 = &m_u1[channel*m_stride];
+        float *power = &m_powers[channel*m_stride];
+
+        for (unsigned int j = 0; j < m_stride; j++)
+        {
+            power[j] = (u0[j] * u0[j]) + (u1[j] * u1[j]) - (m_coef[j] * u0[j] * u1[j]);
+            u0[j] = 0.0f; // reset for next window
+            u1[j] = 0.0f;
+        }
+    }
+}
+
+const char *GoertzelBank::getKernelsName()
+{
+    return kernels().m_name;
+}
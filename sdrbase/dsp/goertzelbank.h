@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_GOERTZELBANK_H_
+#define SDRBASE_DSP_GOERTZELBANK_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Bank of Goertzel filters evaluated over blocks of real samples.
+ *
+ * The same set of frequencies is analyzed on one or several channels fed in lockstep
+ * (ex: the tone audio of many receivers in a scanner). Filter states are stored
+ * frequency after frequency for each channel with the number of frequencies rounded up
+ * to the widest vector so that a whole block of samples runs through a vector of filters
+ * held in registers. Each window of N samples gives the power at each frequency of
+ * each channel.
+ *
+ * Processing kernels are selected once at run time: AVX2/FMA on x86 processors supporting it,
+ * NEON on ARM when built with NEON support and plain C++ otherwise.
+ */
+class SDRBASE_API GoertzelBank
+{
+public:
+    GoertzelBank();
+
+    /**
+     * Set the frequencies to analyze on each of nbChannels channels.
+     * windowSize is the number of samples of an analysis window (resolution sampleRate/windowSize).
+     */
+    void configure(unsigned int nbChannels, const std::vector<Real>& frequencies, int sampleRate, unsigned int windowSize);
+    void setWindowSize(unsigned int windowSize); //!< Restarts the current window
+    void reset(); //!< Clear filters and restart the current window
+
+    /**
+     * Feed n samples of each channel. channelSamples[c] points to the n samples of channel c.
+     * Returns the number of windows completed during the block. The powers of the last one
+     * are available with getPowers().
+     */
+    unsigned int feed(const float * const *channelSamples, unsigned int n);
+    unsigned int feed(const float *samples, unsigned int n) { return feed(&samples, n); } //!< Single channel
+
+    unsigned int getNbChannels() const { return m_nbChannels; }
+    unsigned int getNbFrequencies() const { return m_frequencies.size(); }
+    unsigned int getWindowSize() const { return m_windowSize; }
+    const std::vector<Real>& getFrequencies() const { return m_frequencies; }
+    const float *getPowers(unsigned int channel) const { return &m_powers[channel * m_stride]; } //!< getNbFrequencies() powers
+
+    static const char *getKernelsName(); //!< Name of the kernels selected on this processor
+
+private:
+    std::vector<Real> m_frequencies;
+    unsigned int m_nbChannels;
+    unsigned int m_stride;      //!< Filters per channel rounded up to the vector length
+    unsigned int m_windowSize;
+    unsigned int m_samplesProcessed;
+    int m_sampleRate;
+    std::vector<float> m_coef;  //!< [m_stride] 2cos(w) shared by all channels
+    std::vector<float> m_u0;    //!< [channel][m_stride]
+    std::vector<float> m_u1;    //!< [channel][m_stride]
+    std::vector<float> m_powers; //!< [channel][m_stride]
+
+    void evaluate();
+};
+
+#endif // SDRBASE_DSP_GOERTZELBANK_H_
@@ -61,6 +61,92 @@ public:
         }
     }
 
+    // downsample by 2, return center part of original spectrum
+    bool workDecimateCenter(FSample* sample)
+    {
+        storeSample(sample->real(), sample->imag());
+
+        switch(m_state)
+        {
+            case 0:
+                advancePointer();
+                m_state = 1;
+                return false;
+
+            default:
+                doFIR(&sample->m_real, &sample->m_imag);
+                advancePointer();
+                m_state = 0;
+                return true;
+        }
+    }
+
+    // downsample by 2, return lower half of original spectrum
+    bool workDecimateLowerHalf(FSample* sample)
+    {
+        switch(m_state)
+        {
+            case 0:
+                storeSample(-sample->imag(), sample->real());
+                advancePointer();
+                m_state = 1;
+                return false;
+
+            case 1:
+                storeSample(-sample->real(), -sample->imag());
+                doFIR(&sample->m_real, &sample->m_imag);
+                advancePointer();
+                m_state = 2;
+                return true;
+
+            case 2:
+                storeSample(sample->imag(), -sample->real());
+                advancePointer();
+                m_state = 3;
+                return false;
+
+            default:
+                storeSample(sample->real(), sample->imag());
+                doFIR(&sample->m_real, &sample->m_imag);
+                advancePointer();
+                m_state = 0;
+                return true;
+        }
+    }
+
+    // downsample by 2, return upper half of original spectrum
+    bool workDecimateUpperHalf(FSample* sample)
+    {
+        switch(m_state)
+        {
+            case 0:
+                storeSample(sample->imag(), -sample->real());
+                advancePointer();
+                m_state = 1;
+                return false;
+
+            case 1:
+                storeSample(-sample->real(), -sample->imag());
+                doFIR(&sample->m_real, &sample->m_imag);
+                advancePointer();
+                m_state = 2;
+                return true;
+
+            case 2:
+                storeSample(-sample->imag(), sample->real());
+                advancePointer();
+                m_state = 3;
+                return false;
+
+            default:
+                storeSample(sample->real(), sample->imag());
+                doFIR(&sample->m_real, &sample->m_imag);
+                advancePointer();
+                m_state = 0;
+                return true;
+        }
+    }
+
     void myDecimate(float x1, float y1, float *x2, float *y2)
     {
         storeSample(x1, y1);
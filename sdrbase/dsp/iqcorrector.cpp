@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include "iqcorrector.h"
+
+const float IQCorrector::m_dcTimeConstant = 1024.0f;
+const float IQCorrector::m_iqTimeConstant = 16384.0f;
+const int IQCorrector::m_maxEstimationSamples = 4096;
+
+namespace {
+
+inline FixReal toFixReal(float v)
+{
+#if SDR_RX_SAMP_SZ == 16
+    if (v > 32767.0f) {
+        return 32767;
+    } else if (v < -32768.0f) {
+        return -32768;
+    }
+#endif
+    return (FixReal) lrintf(v);
+}
+
+}
+
+IQCorrector::IQCorrector()
+{
+    reset();
+}
+
+void IQCorrector::reset()
+{
+    m_dcI = 0.0;
+    m_dcQ = 0.0;
+    m_cII = 0.0;
+    m_cIQ = 0.0;
+    m_cQQ = 0.0;
+    m_phi = 0.0f;
+    m_amp = 1.0f;
+    m_iqInit = false;
+}
+
+template<typename Iterator>
+void IQCorrector::estimate(Iterator begin, Iterator end, bool imbalanceCorrection)
+{
+    int nbSamples = end - begin;
+
+    if (nbSamples <= 0) {
+        return;
+    }
+
+    // DC: plain sums over the whole block
+    double sI = 0.0, sQ = 0.0;
+
+    for (int k = 0; k < nbSamples; k++)
+    {
+        sI += begin[k].m_real;
+        sQ += begin[k].m_imag;
+    }
+
+    double mI = sI / nbSamples;
+    double mQ = sQ / nbSamples;
+    double alphaDC = 1.0 - std::exp(-nbSamples / m_dcTimeConstant);
+    m_dcI += alphaDC * (mI - m_dcI);
+    m_dcQ += alphaDC * (mQ - m_dcQ);
+
+    if (!imbalanceCorrection) {
+        return;
+    }
+
+    // imbalance: second order moments around the block mean on decimated samples
+    int stride = nbSamples > m_maxEstimationSamples ? nbSamples / m_maxEstimationSamples : 1;
+    double sII = 0.0, sIQ = 0.0, sQQ = 0.0;
+    int count = 0;
+
+    for (int k = 0; k < nbSamples; k += stride, count++)
+    {
+        double xi = begin[k].m_real - mI;
+        double xq = begin[k].m_imag - mQ;
+        sII += xi*xi;
+        sIQ += xi*xq;
+        sQQ += xq*xq;
+    }
+
+    double cII = sII / count;
+    double cIQ = sIQ / count;
+    double cQQ = sQQ / count;
+
+    if (m_iqInit)
+    {
+        double alphaIQ = 1.0 - std::exp(-count / m_iqTimeConstant);
+        m_cII += alphaIQ * (cII - m_cII);
+        m_cIQ += alphaIQ * (cIQ - m_cIQ);
+        m_cQQ += alphaIQ * (cQQ - m_cQQ);
+    }
+    else
+    {
+        m_cII = cII;
+        m_cIQ = cIQ;
+        m_cQQ = cQQ;
+        m_iqInit = true;
+    }
+
+    if (m_cII > 0.0)
+    {
+        double phi = m_cIQ / m_cII;
+        double yqq = m_cQQ - phi * m_cIQ; // <Q - phi.I, Q - phi.I>
+
+        if (yqq > 0.0)
+        {
+            m_phi = phi;
+            m_amp = std::sqrt(m_cII / yqq);
+        }
+    }
+}
+
+void IQCorrector::coefficients(bool imbalanceCorrection, float& kI, float& kQ, float& cI, float& cQ) const
+{
+    // I' = I + cI
+    // Q' = kQ.Q + kI.I + cQ
+    cI = -m_dcI;
+
+    if (imbalanceCorrection)
+    {
+        kQ = m_amp;
+        kI = -m_amp * m_phi;
+        cQ = m_amp * (m_phi * m_dcI - m_dcQ);
+    }
+    else
+    {
+        kQ = 1.0f;
+        kI = 0.0f;
+        cQ = -m_dcQ;
+    }
+}
+
+void IQCorrector::process(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection)
+{
+    process(SampleVector::const_iterator(begin), SampleVector::const_iterator(end), begin, imbalanceCorrection);
+}
+
+void IQCorrector::process(
+    SampleVector::const_iterator begin,
+    SampleVector::const_iterator end,
+    SampleVector::iterator out,
+    bool imbalanceCorrection)
+{
+    int nbSamples = end - begin;
+
+    if (nbSamples <= 0) {
+        return;
+    }
+
+    estimate(begin, end, imbalanceCorrection);
+
+    float kI, kQ, cI, cQ;
+    coefficients(imbalanceCorrection, kI, kQ, cI, cQ);
+    const Sample *in = &(*begin);
+    Sample *res = &(*out);
+    int k = 0;
+
+#if defined(USE_SSE2)
+    const __m128 a = _mm_setr_ps(1.0f, kQ, 1.0f, kQ);
+    const __m128 b = _mm_setr_ps(0.0f, kI, 0.0f, kI);
+    const __m128 c = _mm_setr_ps(cI, cQ, cI, cQ);
+#if SDR_RX_SAMP_SZ == 24
+    // two [I,Q] int32 pairs per vector
+    for (; k + 2 <= nbSamples; k += 2)
+    {
+        __m128 v = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) &in[k]));
+        __m128 vi = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, a), _mm_mul_ps(vi, b)), c);
+        _mm_storeu_si128((__m128i*) &res[k], _mm_cvtps_epi32(r));
+    }
+#else
+    // four [I,Q] int16 pairs per vector widened to two int32 vectors
+    for (; k + 4 <= nbSamples; k += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*) &in[k]);
+        __m128 vl = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+        __m128 vh = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+        __m128 vil = _mm_shuffle_ps(vl, vl, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 vih = _mm_shuffle_ps(vh, vh, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 rl = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vl, a), _mm_mul_ps(vil, b)), c);
+        __m128 rh = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vh, a), _mm_mul_ps(vih, b)), c);
+        _mm_storeu_si128((__m128i*) &res[k], _mm_packs_epi32(_mm_cvtps_epi32(rl), _mm_cvtps_epi32(rh)));
+    }
+#endif
+#endif
+
+    for (; k < nbSamples; k++)
+    {
+        float xi = in[k].m_real;
+        float xq = in[k].m_imag;
+        res[k].m_real = toFixReal(xi + cI);
+        res[k].m_imag = toFixReal(kQ*xq + kI*xi + cQ);
+    }
+}
+
+void IQCorrector::process(FSampleVector::iterator begin, FSampleVector::iterator end, bool imbalanceCorrection)
+{
+    int nbSamples = end - begin;
+
+    if (nbSamples <= 0) {
+        return;
+    }
+
+    estimate(begin, end, imbalanceCorrection);
+
+    float kI, kQ, cI, cQ;
+    coefficients(imbalanceCorrection, kI, kQ, cI, cQ);
+    FSample *s = &(*begin);
+    int k = 0;
+
+#if defined(USE_SSE2)
+    const __m128 a = _mm_setr_ps(1.0f, kQ, 1.0f, kQ);
+    const __m128 b = _mm_setr_ps(0.0f, kI, 0.0f, kI);
+    const __m128 c = _mm_setr_ps(cI, cQ, cI, cQ);
+
+    for (; k + 2 <= nbSamples; k += 2)
+    {
+        __m128 v = _mm_loadu_ps((const float*) &s[k]);
+        __m128 vi = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+        _mm_storeu_ps((float*) &s[k], _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, a), _mm_mul_ps(vi, b)), c));
+    }
+#endif
+
+    for (; k < nbSamples; k++)
+    {
+        float xi = s[k].m_real;
+        float xq = s[k].m_imag;
+        s[k].m_real = xi + cI;
+        s[k].m_imag = kQ*xq + kI*xi + cQ;
+    }
+}
@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_IQCORRECTOR_H_
+#define SDRBASE_DSP_IQCORRECTOR_H_
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * DC offset and IQ imbalance corrector working on blocks of samples.
+ *
+ * Estimation is done once per block: the mean of I and Q is taken over the whole block and
+ * second order moments on at most m_maxEstimationSamples samples evenly spread over the block.
+ * They are folded into exponentially smoothed estimates. The DC time constant is expressed in
+ * samples so that DC tracking speed does not depend on the block size. The imbalance time constant
+ * is expressed in estimation samples since imbalance drifts slowly and needs many samples to be
+ * estimated accurately.
+ *
+ * The correction is then a single affine transform applied to the whole block:
+ *   I' = I - dcI
+ *   Q' = amp * ((Q - dcQ) - phi * (I - dcI))
+ * where phi is the I/Q correlation (phase imbalance) and amp the I/Q power ratio
+ * square root (gain imbalance). With SSE2 it is done two samples at a time.
+ */
+class SDRBASE_API IQCorrector
+{
+public:
+    IQCorrector();
+
+    void reset();
+    void process(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection);
+    void process(
+        SampleVector::const_iterator begin,
+        SampleVector::const_iterator end,
+        SampleVector::iterator out,
+        bool imbalanceCorrection); //!< Out of place version for read only FIFO data
+    void process(FSampleVector::iterator begin, FSampleVector::iterator end, bool imbalanceCorrection);
+
+    float getDCI() const { return m_dcI; }
+    float getDCQ() const { return m_dcQ; }
+    float getPhi() const { return m_phi; }
+    float getAmp() const { return m_amp; }
+
+    static const float m_dcTimeConstant;  //!< DC tracking time constant in samples
+    static const float m_iqTimeConstant;  //!< Imbalance tracking time constant in estimation samples
+    static const int m_maxEstimationSamples; //!< Maximum number of samples used for estimation per block
+
+private:
+    double m_dcI;   //!< DC estimate of I (in the unit of the samples)
+    double m_dcQ;   //!< DC estimate of Q
+    double m_cII;   //!< Smoothed <I,I> covariance
+    double m_cIQ;   //!< Smoothed <I,Q> covariance
+    double m_cQQ;   //!< Smoothed <Q,Q> covariance
+    float m_phi;    //!< Phase imbalance correction factor
+    float m_amp;    //!< Gain imbalance correction factor
+    bool m_iqInit;  //!< Covariances have been initialized
+
+    template<typename Iterator>
+    void estimate(Iterator begin, Iterator end, bool imbalanceCorrection);
+    void coefficients(bool imbalanceCorrection, float& kI, float& kQ, float& cI, float& cQ) const;
+};
+
+#endif // SDRBASE_DSP_IQCORRECTOR_H_
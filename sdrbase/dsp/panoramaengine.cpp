@@ -0,0 +1,480 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDebug>
+#include <QCoreApplication>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QMutexLocker>
+
+#include "dsp/dspcommands.h"
+#include "dsp/dspengine.h"
+#include "dsp/fftfactory.h"
+#include "dsp/fftengine.h"
+#include "dsp/devicesamplesource.h"
+#include "dsp/glspectruminterface.h"
+#include "util/timeutil.h"
+
+#include "panoramaengine.h"
+
+MESSAGE_CLASS_DEFINITION(PanoramaEngine::MsgConfigureWSSpectrum, Message)
+
+const Real PanoramaEngine::m_noDataDb = -150.0f;
+
+QString PanoramaEngine::Settings::getError() const
+{
+    if ((m_fromHz < 0) || (m_toHz <= m_fromHz)) {
+        return QString("Range must satisfy 0 <= from < to");
+    }
+    if (m_toHz - m_fromHz > m_maxSpanHz) {
+        return QString("Range wider than %1 Hz").arg(m_maxSpanHz);
+    }
+    if ((m_fftSize < 64) || (m_fftSize > 16384) || ((m_fftSize & (m_fftSize - 1)) != 0)) {
+        return QString("FFT size must be a power of two between 64 and 16384");
+    }
+    if (m_settleMs < 0) {
+        return QString("Settle time must be positive");
+    }
+    if ((m_overlapPercent < 0) || (m_overlapPercent > 50)) {
+        return QString("Overlap must be between 0 and 50%");
+    }
+    if ((m_usablePercent < 10) || (m_usablePercent > 100)) {
+        return QString("Usable part must be between 10 and 100%");
+    }
+    if (m_averagingNb < 1) {
+        return QString("Averaging must be at least 1");
+    }
+
+    return QString();
+}
+
+PanoramaEngine::PanoramaEngine(DeviceSampleSource *source, const Settings& settings) :
+    m_settings(settings),
+    m_source(source),
+    m_glSpectrum(nullptr),
+    m_wsSpectrum(this),
+    m_running(false),
+    m_initialCenterFrequency(source->getCenterFrequency()),
+    m_fft(nullptr),
+    m_fftEngineSequence(0),
+    m_ofs(20.0f * log10f(1.0f / settings.m_fftSize)),
+    m_sampleRate(0),
+    m_binWidth(0.0),
+    m_usableBins(0),
+    m_stepBins(0),
+    m_nbBins(0),
+    m_nbHops(0),
+    m_settleSamples(0),
+    m_timeoutSamples(0),
+    m_state(StIdle),
+    m_hop(0),
+    m_deviceCenterFrequency(source->getCenterFrequency()),
+    m_hopCenterFrequency(0),
+    m_countdown(0),
+    m_capture(settings.m_fftSize * settings.m_averagingNb),
+    m_captureFill(0),
+    m_hopPower(settings.m_fftSize),
+    m_sweepStartMs(0),
+    m_panoramaFromHz(settings.m_fromHz),
+    m_panoramaBinWidth(0.0),
+    m_sweepCount(0),
+    m_sweepTimeMs(0)
+{
+    setObjectName("PanoramaEngine");
+    FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
+    m_fftEngineSequence = fftFactory->getEngine(m_settings.m_fftSize, false, &m_fft);
+    m_window.create(FFTWindow::BlackmanHarris, m_settings.m_fftSize);
+    // the web socket server and the input queue are served by the main event loop
+    // whatever the thread that created the engine
+    moveToThread(QCoreApplication::instance()->thread());
+}
+
+PanoramaEngine::~PanoramaEngine()
+{
+    FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
+    fftFactory->releaseEngine(m_settings.m_fftSize, false, m_fftEngineSequence);
+}
+
+void PanoramaEngine::openWSSpectrum(const QString& address, quint16 port)
+{
+    getInputMessageQueue()->push(MsgConfigureWSSpectrum::create(true, address, port));
+}
+
+void PanoramaEngine::closeWSSpectrum()
+{
+    getInputMessageQueue()->push(MsgConfigureWSSpectrum::create(false, "", 0));
+}
+
+void PanoramaEngine::restoreCenterFrequency()
+{
+    m_source->setCenterFrequency(m_initialCenterFrequency);
+}
+
+void PanoramaEngine::start()
+{
+    m_running = true;
+
+    if (m_nbBins > 0) {
+        startSweep();
+    }
+}
+
+void PanoramaEngine::stop()
+{
+    m_running = false;
+    m_state = StIdle;
+}
+
+void PanoramaEngine::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
+{
+    (void) positiveOnly;
+    SampleVector::const_iterator it = begin;
+
+    while ((it < end) && (m_state != StIdle))
+    {
+        unsigned int todo = end - it;
+
+        if (m_state == StCollect)
+        {
+            unsigned int count = std::min(todo, (unsigned int) m_capture.size() - m_captureFill);
+            std::vector<Complex>::iterator cit = m_capture.begin() + m_captureFill;
+
+            for (unsigned int i = 0; i < count; i++, ++it, ++cit) {
+                *cit = Complex(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
+            }
+
+            m_captureFill += count;
+
+            if (m_captureFill == m_capture.size()) {
+                hopCaptured();
+            }
+        }
+        else // samples are dropped while tuning and settling
+        {
+            unsigned int count = std::min(todo, m_countdown);
+            it += count;
+            m_countdown -= count;
+
+            if (m_countdown != 0) {
+                continue;
+            }
+
+            if (m_state == StWaitTune)
+            {
+                // the device did not report a change (e.g. frequency rounded to the previous value)
+                qWarning("PanoramaEngine::feed: no frequency report for hop %d: assume %lld Hz", m_hop, hopCenterFrequency(m_hop));
+                m_hopCenterFrequency = hopCenterFrequency(m_hop);
+                m_state = StSettle;
+                m_countdown = m_settleSamples;
+            }
+            else
+            {
+                m_state = StCollect;
+                m_captureFill = 0;
+            }
+        }
+    }
+}
+
+bool PanoramaEngine::handleMessage(const Message& cmd)
+{
+    if (DSPSignalNotification::match(cmd))
+    {
+        DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
+        m_deviceCenterFrequency = notif.getCenterFrequency();
+
+        if (notif.getSampleRate() != m_sampleRate)
+        {
+            qDebug() << "PanoramaEngine::handleMessage: DSPSignalNotification:"
+                << " centerFrequency: " << notif.getCenterFrequency()
+                << " sampleRate: " << notif.getSampleRate();
+            m_sampleRate = notif.getSampleRate();
+            makePlan();
+
+            if (m_running && (m_nbBins > 0)) {
+                startSweep();
+            }
+        }
+        else if ((m_state == StWaitTune) // ignore reports of other changes before the retune is applied
+            && (std::abs(m_deviceCenterFrequency - hopCenterFrequency(m_hop)) < m_sampleRate / 2))
+        {
+            m_hopCenterFrequency = m_deviceCenterFrequency;
+            m_state = StSettle;
+            m_countdown = m_settleSamples;
+        }
+
+        return true;
+    }
+    else if (MsgConfigureWSSpectrum::match(cmd))
+    {
+        MsgConfigureWSSpectrum& conf = (MsgConfigureWSSpectrum&) cmd;
+
+        if (conf.getOpen())
+        {
+            m_wsSpectrum.closeSocket();
+            m_wsSpectrum.setListeningAddress(conf.getAddress());
+            m_wsSpectrum.setPort(conf.getPort());
+            m_wsSpectrum.openSocket();
+        }
+        else
+        {
+            m_wsSpectrum.closeSocket();
+        }
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void PanoramaEngine::makePlan()
+{
+    int fftSize = m_settings.m_fftSize;
+    m_binWidth = (double) m_sampleRate / fftSize;
+    m_usableBins = std::max(2, ((fftSize * m_settings.m_usablePercent) / 100) & ~1);
+    int overlapBins = (m_usableBins * m_settings.m_overlapPercent) / 100;
+    m_stepBins = m_usableBins - overlapBins;
+    // output bin n is centered at m_fromHz + n * m_binWidth
+    qint64 nbBins = (qint64) ((m_settings.m_toHz - m_settings.m_fromHz) / m_binWidth) + 1;
+
+    if (nbBins > m_maxBins)
+    {
+        qWarning("PanoramaEngine::makePlan: %lld bins of %.1f Hz exceed the maximum of %d: sweep disabled",
+            nbBins, m_binWidth, m_maxBins);
+        m_nbBins = 0;
+        m_nbHops = 0;
+        m_sumPower.clear();
+        m_sumWeight.clear();
+        return;
+    }
+
+    m_nbBins = (int) nbBins;
+    m_nbHops = m_nbBins <= m_usableBins ? 1 : 1 + (m_nbBins - m_usableBins + m_stepBins - 1) / m_stepBins;
+    m_settleSamples = ((qint64) m_sampleRate * m_settings.m_settleMs) / 1000;
+    m_timeoutSamples = m_sampleRate + m_settleSamples;
+
+    m_weights.resize(m_usableBins);
+
+    for (int j = 0; j < m_usableBins; j++)
+    {
+        float w = 1.0f;
+
+        if (overlapBins > 0)
+        {
+            w = std::min(w, (j + 0.5f) / overlapBins);
+            w = std::min(w, (m_usableBins - j - 0.5f) / overlapBins);
+        }
+
+        m_weights[j] = w;
+    }
+
+    m_sumPower.assign(m_nbBins, 0.0);
+    m_sumWeight.assign(m_nbBins, 0.0);
+
+    qDebug("PanoramaEngine::makePlan: %d bins of %.1f Hz in %d hops of %d bins (step %d)",
+        m_nbBins, m_binWidth, m_nbHops, m_usableBins, m_stepBins);
+}
+
+void PanoramaEngine::startSweep()
+{
+    std::fill(m_sumPower.begin(), m_sumPower.end(), 0.0);
+    std::fill(m_sumWeight.begin(), m_sumWeight.end(), 0.0);
+    m_sweepStartMs = TimeUtil::nowms();
+    m_hop = 0;
+    tune(m_hop);
+}
+
+qint64 PanoramaEngine::hopCenterFrequency(int hop) const
+{
+    return m_settings.m_fromHz + (qint64) ((hop * m_stepBins + m_usableBins / 2) * m_binWidth);
+}
+
+void PanoramaEngine::tune(int hop)
+{
+    qint64 centerFrequency = hopCenterFrequency(hop);
+
+    if (std::abs(m_deviceCenterFrequency - centerFrequency) < m_binWidth / 2) // no retune needed
+    {
+        m_hopCenterFrequency = m_deviceCenterFrequency;
+        m_state = StCollect;
+        m_captureFill = 0;
+    }
+    else
+    {
+        m_source->setCenterFrequency(centerFrequency);
+        m_state = StWaitTune;
+        m_countdown = m_timeoutSamples;
+    }
+}
+
+void PanoramaEngine::hopCaptured()
+{
+    int hop = m_hop;
+    qint64 hopCenter = m_hopCenterFrequency;
+    bool sweepDone = ++m_hop == m_nbHops;
+
+    if (sweepDone) {
+        m_hop = 0;
+    }
+
+    // retune first so that the device settles while this hop is processed
+    tune(m_hop);
+    processHop(hop, hopCenter);
+
+    if (sweepDone)
+    {
+        sweepCompleted();
+        std::fill(m_sumPower.begin(), m_sumPower.end(), 0.0);
+        std::fill(m_sumWeight.begin(), m_sumWeight.end(), 0.0);
+        m_sweepStartMs = TimeUtil::nowms();
+    }
+}
+
+void PanoramaEngine::processHop(int hop, qint64 centerFrequency)
+{
+    int fftSize = m_settings.m_fftSize;
+    int halfSize = fftSize / 2;
+    std::fill(m_hopPower.begin(), m_hopPower.end(), 0.0f);
+
+    for (int b = 0; b < m_settings.m_averagingNb; b++)
+    {
+        m_window.apply(&m_capture[b * fftSize], m_fft->in());
+        m_fft->transform();
+        const Complex *fftOut = m_fft->out();
+
+        for (int k = 0; k < fftSize; k++) // DC moved to the middle
+        {
+            const Complex& c = fftOut[(k + halfSize) % fftSize];
+            m_hopPower[k] += c.real() * c.real() + c.imag() * c.imag();
+        }
+    }
+
+    // bins are placed according to the frequency the device actually reported
+    int shift = std::lround((centerFrequency - hopCenterFrequency(hop)) / m_binWidth);
+    int firstBin = hop * m_stepBins + shift;
+    int firstK = halfSize - m_usableBins / 2;
+
+    for (int j = 0; j < m_usableBins; j++)
+    {
+        int n = firstBin + j;
+
+        if ((n < 0) || (n >= m_nbBins)) {
+            continue;
+        }
+
+        m_sumPower[n] += m_weights[j] * (m_hopPower[firstK + j] / m_settings.m_averagingNb);
+        m_sumWeight[n] += m_weights[j];
+    }
+}
+
+void PanoramaEngine::sweepCompleted()
+{
+    qint64 nowMs = TimeUtil::nowms();
+
+    m_mutex.lock();
+    m_panorama.resize(m_nbBins);
+
+    for (int n = 0; n < m_nbBins; n++)
+    {
+        m_panorama[n] = m_sumWeight[n] > 0.0 && m_sumPower[n] > 0.0 ?
+            10.0f * log10f(m_sumPower[n] / m_sumWeight[n]) + m_ofs : m_noDataDb;
+    }
+
+    m_panoramaFromHz = m_settings.m_fromHz;
+    m_panoramaBinWidth = m_binWidth;
+    m_sweepCount++;
+    m_sweepTimeMs = nowMs - m_sweepStartMs;
+    m_mutex.unlock();
+
+    if (!m_glSpectrum && !m_wsSpectrum.socketOpened()) {
+        return;
+    }
+
+    int factor = (m_nbBins + m_maxDisplayBins - 1) / m_maxDisplayBins;
+    decimate(m_panorama, factor, m_displayPower);
+    // the range is limited to m_maxSpanHz so the rounded up display span still fits an int
+    qint64 span = std::min((qint64) (m_displayPower.size() * factor * m_binWidth), (qint64) INT32_MAX);
+    qint64 centerFrequency = m_settings.m_fromHz - (qint64) (m_binWidth / 2) + span / 2;
+
+    if (m_glSpectrum) {
+        m_glSpectrum->newPanorama(m_displayPower, centerFrequency, (int) span);
+    }
+
+    if (m_wsSpectrum.socketOpened())
+    {
+        m_wsSpectrum.newSpectrum(
+            m_displayPower,
+            m_displayPower.size(),
+            0.0f,
+            100.0f,
+            centerFrequency,
+            span,
+            false
+        );
+    }
+}
+
+void PanoramaEngine::decimate(const std::vector<Real>& in, int factor, std::vector<Real>& out)
+{
+    out.resize((in.size() + factor - 1) / factor);
+
+    for (unsigned int i = 0; i < out.size(); i++) // peak hold
+    {
+        std::vector<Real>::const_iterator first = in.begin() + i * factor;
+        std::vector<Real>::const_iterator last = std::min(first + factor, in.end());
+        out[i] = *std::max_element(first, last);
+    }
+}
+
+void PanoramaEngine::formatPanorama(QJsonObject& json, int maxBins)
+{
+    std::vector<Real> power;
+    int factor = 1;
+
+    m_mutex.lock();
+
+    if ((maxBins > 0) && ((int) m_panorama.size() > maxBins))
+    {
+        factor = (m_panorama.size() + maxBins - 1) / maxBins;
+        decimate(m_panorama, factor, power);
+    }
+    else
+    {
+        power = m_panorama;
+    }
+
+    json.insert("fromHz", (double) m_panoramaFromHz);
+    json.insert("binWidth", m_panoramaBinWidth * factor);
+    json.insert("nbBins", (int) power.size());
+    json.insert("nbHops", m_nbHops);
+    json.insert("sweepCount", (double) m_sweepCount);
+    json.insert("sweepTimeMs", (double) m_sweepTimeMs);
+    m_mutex.unlock();
+
+    QJsonArray jsonPower;
+
+    for (std::vector<Real>::const_iterator it = power.begin(); it != power.end(); ++it) {
+        jsonPower.append(std::round(*it * 10.0f) / 10.0f);
+    }
+
+    json.insert("power", jsonPower);
+}
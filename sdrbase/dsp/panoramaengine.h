@@ -0,0 +1,185 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_PANORAMAENGINE_H_
+#define SDRBASE_DSP_PANORAMAENGINE_H_
+
+#include <vector>
+
+#include <QString>
+#include <QMutex>
+
+#include "dsp/basebandsamplesink.h"
+#include "dsp/fftwindow.h"
+#include "websockets/wsspectrum.h"
+#include "util/message.h"
+#include "export.h"
+
+class DeviceSampleSource;
+class FFTEngine;
+class GLSpectrumInterface;
+class QJsonObject;
+
+/**
+ * Wideband spectrum obtained by hopping the device center frequency over a range wider than
+ * the device bandwidth and stitching the power spectra of the successive hops.
+ *
+ * For each hop the engine retunes the source, waits for the device to report the new center
+ * frequency then discards the settle samples before capturing the FFT blocks. The retune to the
+ * next hop is issued as soon as the blocks of the current hop are captured so that the FFT of
+ * a hop runs while the device settles on the next one.
+ *
+ * Only the central part (usable percentage) of each FFT is kept to avoid the filter roll off
+ * at the band edges. Successive hops overlap and are blended with linear ramps in the overlap
+ * zone. Power is accumulated in linear scale and converted to dB at the end of each sweep.
+ */
+class SDRBASE_API PanoramaEngine : public BasebandSampleSink {
+public:
+    struct Settings
+    {
+        qint64 m_fromHz;        //!< Start of the scanned range (Hz)
+        qint64 m_toHz;          //!< End of the scanned range (Hz)
+        int m_fftSize;
+        int m_settleMs;         //!< Time discarded after each retune (ms)
+        int m_overlapPercent;   //!< Overlap between hops as a percentage of the usable width
+        int m_usablePercent;    //!< Central part of each FFT that is kept
+        int m_averagingNb;      //!< Number of FFTs averaged per hop
+
+        Settings() :
+            m_fromHz(0),
+            m_toHz(0),
+            m_fftSize(1024),
+            m_settleMs(20),
+            m_overlapPercent(10),
+            m_usablePercent(80),
+            m_averagingNb(1)
+        {}
+
+        bool isValid() const { return getError().isEmpty(); }
+        QString getError() const; //!< Empty if the settings are valid else the reason why they are not
+
+        static const qint64 m_maxSpanHz = 2000000000LL; //!< The display span is an int
+    };
+
+    class MsgConfigureWSSpectrum : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        bool getOpen() const { return m_open; }
+        const QString& getAddress() const { return m_address; }
+        quint16 getPort() const { return m_port; }
+
+        static MsgConfigureWSSpectrum* create(bool open, const QString& address, quint16 port) {
+            return new MsgConfigureWSSpectrum(open, address, port);
+        }
+
+    private:
+        bool m_open;
+        QString m_address;
+        quint16 m_port;
+
+        MsgConfigureWSSpectrum(bool open, const QString& address, quint16 port) :
+            Message(),
+            m_open(open),
+            m_address(address),
+            m_port(port)
+        { }
+    };
+
+    PanoramaEngine(DeviceSampleSource *source, const Settings& settings);
+    virtual ~PanoramaEngine();
+
+    const Settings& getSettings() const { return m_settings; }
+    void setGLSpectrum(GLSpectrumInterface *glSpectrum) { m_glSpectrum = glSpectrum; } //!< Set before the engine is attached
+    void openWSSpectrum(const QString& address, quint16 port);
+    void closeWSSpectrum();
+    void restoreCenterFrequency(); //!< Tune the device back to where it was before the panorama. Call once detached
+    void formatPanorama(QJsonObject& json, int maxBins); //!< Last complete sweep. maxBins > 0 limits the number of bins (peak hold)
+
+    virtual void start();
+    virtual void stop();
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
+    virtual bool handleMessage(const Message& cmd);
+
+    static const int m_maxDisplayBins = 4096; //!< Decimation limit for the spectrum display and web socket
+    static const Real m_noDataDb;             //!< Value of bins not covered by any hop
+    static const int m_maxBins = 1<<24;       //!< Plans with more output bins are rejected
+
+private:
+    enum State
+    {
+        StIdle,     //!< Sample rate not known yet
+        StWaitTune, //!< Retune issued, waiting for the device to report the new frequency
+        StSettle,   //!< Discarding settle samples
+        StCollect   //!< Capturing FFT blocks
+    };
+
+    Settings m_settings;
+    DeviceSampleSource *m_source;
+    GLSpectrumInterface *m_glSpectrum;
+    WSSpectrum m_wsSpectrum;
+    bool m_running;
+    qint64 m_initialCenterFrequency;
+    FFTEngine *m_fft;
+    unsigned int m_fftEngineSequence;
+    FFTWindow m_window;
+    Real m_ofs;
+
+    // hop plan
+    int m_sampleRate;
+    double m_binWidth;
+    int m_usableBins;
+    int m_stepBins;
+    int m_nbBins;     //!< Number of bins of the whole panorama
+    int m_nbHops;
+    unsigned int m_settleSamples;
+    unsigned int m_timeoutSamples;
+    std::vector<float> m_weights; //!< Blending weight of each usable bin
+
+    // sweep state
+    State m_state;
+    int m_hop;
+    qint64 m_deviceCenterFrequency; //!< As last reported by the device
+    qint64 m_hopCenterFrequency;    //!< Actual center frequency of the hop being captured
+    unsigned int m_countdown;
+    std::vector<Complex> m_capture;
+    unsigned int m_captureFill;
+    std::vector<double> m_sumPower;
+    std::vector<double> m_sumWeight;
+    std::vector<Real> m_hopPower;
+    std::vector<Real> m_displayPower;
+    qint64 m_sweepStartMs;
+
+    // last complete sweep
+    QMutex m_mutex;
+    std::vector<Real> m_panorama;
+    qint64 m_panoramaFromHz;
+    double m_panoramaBinWidth;
+    quint64 m_sweepCount;
+    qint64 m_sweepTimeMs;
+
+    void makePlan();
+    void startSweep();
+    qint64 hopCenterFrequency(int hop) const;
+    void tune(int hop);
+    void hopCaptured();
+    void processHop(int hop, qint64 centerFrequency);
+    void sweepCompleted();
+    static void decimate(const std::vector<Real>& in, int factor, std::vector<Real>& out);
+};
+
+#endif // SDRBASE_DSP_PANORAMAENGINE_H_
@@ -0,0 +1,143 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <QDebug>
+
+#include "sampleclock.h"
+
+const double SampleClock::m_acquisitionBandwidth = 2.0;
+const double SampleClock::m_trackingBandwidth = 0.1;
+const unsigned int SampleClock::m_acquisitionObservations = 200;
+const double SampleClock::m_maxErrorUs = 200000.0;
+const double SampleClock::m_maxPpm = 1000.0;
+
+SampleClock::SampleClock() :
+    m_sampleRate(0),
+    m_nominalPeriodUs(0.0),
+    m_periodUs(0.0)
+{
+    reset();
+}
+
+void SampleClock::setSampleRate(unsigned int sampleRate)
+{
+    if (sampleRate == m_sampleRate) {
+        return;
+    }
+
+    m_sampleRate = sampleRate;
+    m_nominalPeriodUs = sampleRate == 0 ? 0.0 : 1e6 / sampleRate;
+    reset();
+}
+
+void SampleClock::reset()
+{
+    m_periodUs = m_nominalPeriodUs;
+    m_refIndex = 0;
+    m_refUs = 0.0;
+    m_locked = false;
+    m_hardware = false;
+    m_nbObservations = 0;
+}
+
+void SampleClock::observe(quint64 index, qint64 hostTimeUs)
+{
+    if (m_hardware || (m_sampleRate == 0)) {
+        return;
+    }
+
+    if (!m_locked)
+    {
+        m_refIndex = index;
+        m_refUs = hostTimeUs;
+        m_locked = true;
+        m_nbObservations = 1;
+        return;
+    }
+
+    if (index <= m_refIndex) {
+        return;
+    }
+
+    quint64 nbSamples = index - m_refIndex;
+    double predictedUs = m_refUs + nbSamples * m_periodUs;
+    double errorUs = hostTimeUs - predictedUs;
+
+    if (std::fabs(errorUs) > m_maxErrorUs)
+    {
+        qDebug("SampleClock::observe: error %f us: resync", errorUs);
+        m_periodUs = m_nominalPeriodUs;
+        m_refIndex = index;
+        m_refUs = hostTimeUs;
+        m_nbObservations = 1;
+        return;
+    }
+
+    // second order loop with gains derived from the bandwidth and the block duration
+    double bandwidth = m_nbObservations < m_acquisitionObservations ? m_acquisitionBandwidth : m_trackingBandwidth;
+    double omega = 2.0 * M_PI * bandwidth * nbSamples * m_periodUs * 1e-6;
+    omega = omega > 0.5 ? 0.5 : omega;
+    double b = M_SQRT2 * omega;
+    double c = omega * omega;
+
+    m_refUs = predictedUs + b * errorUs;
+    m_refIndex = index;
+    m_periodUs += c * errorUs / nbSamples;
+    clampPeriod();
+    m_nbObservations++;
+}
+
+void SampleClock::setReference(quint64 index, qint64 hardwareTimeUs)
+{
+    if (m_sampleRate == 0) {
+        return;
+    }
+
+    if (m_hardware && (index > m_refIndex))
+    {
+        double measuredUs = (hardwareTimeUs - m_refUs) / (index - m_refIndex);
+
+        // a jump of the device time (device overflow) gives an out of range period that is ignored
+        if (std::fabs(measuredUs - m_nominalPeriodUs) < m_nominalPeriodUs * m_maxPpm * 1e-6) {
+            m_periodUs += 0.1 * (measuredUs - m_periodUs);
+        }
+    }
+
+    m_refIndex = index;
+    m_refUs = hardwareTimeUs;
+    m_locked = true;
+    m_hardware = true;
+}
+
+qint64 SampleClock::getTimeUs(quint64 index) const
+{
+    double delta = index >= m_refIndex ? (double) (index - m_refIndex) : -((double) (m_refIndex - index));
+    return (qint64) std::llround(m_refUs + delta * m_periodUs);
+}
+
+void SampleClock::clampPeriod()
+{
+    double maxDeviation = m_nominalPeriodUs * m_maxPpm * 1e-6;
+
+    if (m_periodUs > m_nominalPeriodUs + maxDeviation) {
+        m_periodUs = m_nominalPeriodUs + maxDeviation;
+    } else if (m_periodUs < m_nominalPeriodUs - maxDeviation) {
+        m_periodUs = m_nominalPeriodUs - maxDeviation;
+    }
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SAMPLECLOCK_H_
+#define SDRBASE_DSP_SAMPLECLOCK_H_
+
+#include <QtGlobal>
+
+#include "export.h"
+
+/**
+ * Maps the index of a sample in a stream to an absolute time (us since epoch).
+ *
+ * With host time the writer observes the time at which each block is handed over. These
+ * observations are jittery so they drive a second order delay locked loop that tracks both
+ * the time of a reference sample and the actual sample period (the device clock is never exactly
+ * at its nominal rate). The loop bandwidth is wide at start for fast acquisition then narrowed.
+ *
+ * With hardware time the device gives the exact time of the first sample of a block. It is then
+ * used as the reference directly and only the sample period is estimated from successive stamps.
+ */
+class SDRBASE_API SampleClock
+{
+public:
+    SampleClock();
+
+    void setSampleRate(unsigned int sampleRate); //!< Resets the clock if the rate changes
+    unsigned int getSampleRate() const { return m_sampleRate; }
+    void reset();
+
+    void observe(quint64 index, qint64 hostTimeUs);        //!< Host time at which sample index (excluded) has been received
+    void setReference(quint64 index, qint64 hardwareTimeUs); //!< Hardware time of sample index
+    bool isLocked() const { return m_locked; }
+    bool isHardware() const { return m_hardware; }
+
+    qint64 getTimeUs(quint64 index) const; //!< Estimated time of sample index
+    double getPeriodUs() const { return m_periodUs; }
+
+    static const double m_acquisitionBandwidth; //!< Loop bandwidth (Hz) for the first observations
+    static const double m_trackingBandwidth;    //!< Loop bandwidth (Hz) once acquired
+    static const unsigned int m_acquisitionObservations;
+    static const double m_maxErrorUs;           //!< The loop is reset on errors larger than this
+    static const double m_maxPpm;               //!< Maximum deviation of the period from nominal
+
+private:
+    unsigned int m_sampleRate;
+    double m_nominalPeriodUs;
+    double m_periodUs;
+    quint64 m_refIndex;
+    double m_refUs;
+    bool m_locked;
+    bool m_hardware;
+    unsigned int m_nbObservations;
+
+    void clampPeriod();
+};
+
+#endif // SDRBASE_DSP_SAMPLECLOCK_H_
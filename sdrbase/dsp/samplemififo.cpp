@@ -19,6 +19,7 @@
 
 void SampleMIFifo::init(unsigned int nbStreams, unsigned int size)
 {
+    BufferArena::Scope arenaScope(m_arenaNode, m_arenaOwner);
     m_nbStreams = nbStreams;
     m_size = size;
 	m_fill = 0;
@@ -29,12 +30,23 @@ void SampleMIFifo::init(unsigned int nbStreams, unsigned int size)
 
     for (unsigned int stream = 0; stream < nbStreams; stream++)
     {
+        if (size > m_data[stream].capacity()) { // release before allocating so that the arena can recycle the block
+            SampleVector().swap(m_data[stream]);
+        }
+
         m_data[stream].resize(size);
         m_vFill.push_back(0);
         m_vHead.push_back(0);
     }
 }
 
+void SampleMIFifo::setArena(int node, const void *owner)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_arenaNode = node;
+    m_arenaOwner = owner;
+}
+
 void SampleMIFifo::reset()
 {
     QMutexLocker mutexLocker(&m_mutex);
@@ -49,6 +61,8 @@ void SampleMIFifo::reset()
 
 SampleMIFifo::SampleMIFifo(QObject *parent) :
     QObject(parent),
+    m_arenaNode(-1),
+    m_arenaOwner(nullptr),
     m_nbStreams(0),
     m_size(0),
     m_fill(0),
@@ -57,7 +71,9 @@ SampleMIFifo::SampleMIFifo(QObject *parent) :
 }
 
 SampleMIFifo::SampleMIFifo(unsigned int nbStreams, unsigned int size, QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_arenaNode(-1),
+    m_arenaOwner(nullptr)
 {
     init(nbStreams, size);
 }
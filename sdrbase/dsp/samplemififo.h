@@ -32,6 +32,7 @@ public:
     SampleMIFifo(unsigned int nbStreams, unsigned int size, QObject *parent = nullptr);
     ~SampleMIFifo();
     void init(unsigned int nbStreams, unsigned int size);
+    void setArena(int node, const void *owner); //!< NUMA node (-1 follows the CPU) and BufferArena owner of the storage allocated from now on
     void reset();
 
     void writeSync(const quint8* data, unsigned int count); //!< de-interleaved data in input with count bytes for each stream
@@ -89,6 +90,8 @@ signals:
 
 private:
     std::vector<SampleVector> m_data;
+    int m_arenaNode;          //!< BufferArena node of the storage
+    const void *m_arenaOwner; //!< BufferArena owner of the storage
     unsigned int m_nbStreams;
     unsigned int m_size;
     unsigned int m_fill;               //!< Number of samples written from beginning of samples vector (sync)
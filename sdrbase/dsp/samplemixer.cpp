@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include "samplemixer.h"
+
+namespace {
+
+const float txMax = SDR_TX_SCALEF - 1.0f;
+const float txMin = -SDR_TX_SCALEF;
+
+inline FixReal saturate(float v)
+{
+    if (v > txMax) {
+        return (FixReal) txMax;
+    } else if (v < txMin) {
+        return (FixReal) txMin;
+    } else {
+        return (FixReal) lrintf(v);
+    }
+}
+
+}
+
+void SampleMixer::load(const Sample *in, qint32 *acc, unsigned int nbSamples)
+{
+    unsigned int k = 0;
+
+#if defined(USE_SSE2) && (SDR_RX_SAMP_SZ == 16)
+    for (; k + 4 <= nbSamples; k += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*) &in[k]);
+        _mm_storeu_si128((__m128i*) &acc[2*k], _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+        _mm_storeu_si128((__m128i*) &acc[2*k+4], _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+    }
+#endif
+
+    for (; k < nbSamples; k++)
+    {
+        acc[2*k] = in[k].m_real;
+        acc[2*k+1] = in[k].m_imag;
+    }
+}
+
+void SampleMixer::accumulate(const Sample *in, qint32 *acc, unsigned int nbSamples)
+{
+    unsigned int k = 0;
+
+#if defined(USE_SSE2)
+#if SDR_RX_SAMP_SZ == 24
+    for (; k + 2 <= nbSamples; k += 2)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*) &in[k]);
+        __m128i a = _mm_loadu_si128((const __m128i*) &acc[2*k]);
+        _mm_storeu_si128((__m128i*) &acc[2*k], _mm_add_epi32(a, x));
+    }
+#else
+    for (; k + 4 <= nbSamples; k += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*) &in[k]);
+        __m128i al = _mm_loadu_si128((const __m128i*) &acc[2*k]);
+        __m128i ah = _mm_loadu_si128((const __m128i*) &acc[2*k+4]);
+        _mm_storeu_si128((__m128i*) &acc[2*k], _mm_add_epi32(al, _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16)));
+        _mm_storeu_si128((__m128i*) &acc[2*k+4], _mm_add_epi32(ah, _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16)));
+    }
+#endif
+#endif
+
+    for (; k < nbSamples; k++)
+    {
+        acc[2*k] += in[k].m_real;
+        acc[2*k+1] += in[k].m_imag;
+    }
+}
+
+void SampleMixer::mix(const qint32 *acc, Sample *out, unsigned int nbSamples, unsigned int nbSources)
+{
+    float scale = 1.0f / nbSources;
+    unsigned int k = 0;
+
+#if defined(USE_SSE2)
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 vmax = _mm_set1_ps(txMax);
+    const __m128 vmin = _mm_set1_ps(txMin);
+#if SDR_RX_SAMP_SZ == 24
+    for (; k + 2 <= nbSamples; k += 2)
+    {
+        __m128 v = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) &acc[2*k])), s);
+        v = _mm_max_ps(_mm_min_ps(v, vmax), vmin);
+        _mm_storeu_si128((__m128i*) &out[k], _mm_cvtps_epi32(v));
+    }
+#else
+    for (; k + 4 <= nbSamples; k += 4)
+    {
+        __m128 vl = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) &acc[2*k])), s);
+        __m128 vh = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) &acc[2*k+4])), s);
+        vl = _mm_max_ps(_mm_min_ps(vl, vmax), vmin);
+        vh = _mm_max_ps(_mm_min_ps(vh, vmax), vmin);
+        _mm_storeu_si128((__m128i*) &out[k], _mm_packs_epi32(_mm_cvtps_epi32(vl), _mm_cvtps_epi32(vh)));
+    }
+#endif
+#endif
+
+    for (; k < nbSamples; k++)
+    {
+        out[k].m_real = saturate(acc[2*k] * scale);
+        out[k].m_imag = saturate(acc[2*k+1] * scale);
+    }
+}
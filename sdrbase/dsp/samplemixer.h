@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SAMPLEMIXER_H_
+#define SDRBASE_DSP_SAMPLEMIXER_H_
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Mixes blocks of Tx samples coming from several baseband sources.
+ *
+ * Sources are summed in a 32 bit accumulator holding interleaved I and Q values so that
+ * the sum cannot wrap. The final sum is scaled by the number of sources and saturated
+ * to the Tx sample range. All stages are SSE2 vectorized when available.
+ */
+class SDRBASE_API SampleMixer
+{
+public:
+    static void load(const Sample *in, qint32 *acc, unsigned int nbSamples);       //!< acc = in
+    static void accumulate(const Sample *in, qint32 *acc, unsigned int nbSamples); //!< acc += in
+    static void mix(const qint32 *acc, Sample *out, unsigned int nbSamples, unsigned int nbSources); //!< out = sat(acc / nbSources)
+};
+
+#endif // SDRBASE_DSP_SAMPLEMIXER_H_
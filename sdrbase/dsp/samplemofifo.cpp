@@ -22,18 +22,23 @@ const unsigned int SampleMOFifo::m_guardDivisor = 10;
 
 SampleMOFifo::SampleMOFifo(QObject *parent) :
     QObject(parent),
+    m_arenaNode(-1),
+    m_arenaOwner(nullptr),
     m_nbStreams(0),
     m_mutex(QMutex::Recursive)
 {}
 
 SampleMOFifo::SampleMOFifo(unsigned int nbStreams, unsigned int size, QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_arenaNode(-1),
+    m_arenaOwner(nullptr)
 {
     init(nbStreams, size);
 }
 
 void SampleMOFifo::init(unsigned int nbStreams, unsigned int size)
 {
+    BufferArena::Scope arenaScope(m_arenaNode, m_arenaOwner);
     m_data.resize(nbStreams);
     m_vReadCount.resize(nbStreams);
     m_vReadHead.resize(nbStreams);
@@ -45,6 +50,7 @@ void SampleMOFifo::init(unsigned int nbStreams, unsigned int size)
 void SampleMOFifo::resize(unsigned int size)
 {
     QMutexLocker mutexLocker(&m_mutex);
+    BufferArena::Scope arenaScope(m_arenaNode, m_arenaOwner);
     m_size = size;
     m_lowGuard = m_size / m_guardDivisor;
     m_highGuard = m_size - (m_size/m_guardDivisor);
@@ -57,6 +63,13 @@ void SampleMOFifo::resize(unsigned int size)
     reset();
 }
 
+void SampleMOFifo::setArena(int node, const void *owner)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_arenaNode = node;
+    m_arenaOwner = owner;
+}
+
 void SampleMOFifo::reset()
 {
     QMutexLocker mutexLocker(&m_mutex);
@@ -33,6 +33,7 @@ public:
 
     void init(unsigned int nbStreams, unsigned int size);
     void resize(unsigned int size);
+    void setArena(int node, const void *owner); //!< NUMA node (-1 follows the CPU) and BufferArena owner of the storage allocated from now on
     void reset();
 
     void readSync(
@@ -91,6 +92,8 @@ signals:
 
 private:
     std::vector<SampleVector> m_data;
+    int m_arenaNode;          //!< BufferArena node of the storage
+    const void *m_arenaOwner; //!< BufferArena owner of the storage
     unsigned int m_nbStreams;
     unsigned int m_size;
     unsigned int m_lowGuard;
@@ -16,19 +16,44 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include "util/timeutil.h"
 #include "samplesinkfifo.h"
 
-//#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+const unsigned int SampleSinkFifo::m_expandChunk = 16384;
+const unsigned int SampleSinkFifo::m_nbAnchors = 64;
 
 void SampleSinkFifo::create(unsigned int s)
 {
+	BufferArena::Scope arenaScope(m_arenaNode, m_arenaOwner);
 	m_size = 0;
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
 
-	m_data.resize(s);
-	m_size = m_data.size();
+    // only one storage is allocated at a time
+    if (m_compact)
+    {
+        SampleVector().swap(m_data);
+
+        if (s > m_compactData.capacity()) { // release before allocating so that the arena can recycle the block
+            CompactSampleVector().swap(m_compactData);
+        }
+
+        m_compactData.resize(s);
+        m_size = m_compactData.size();
+    }
+    else
+    {
+        CompactSampleVector().swap(m_compactData);
+        SampleVector().swap(m_expandBuffer);
+
+        if (s > m_data.capacity()) { // release before allocating so that the arena can recycle the block
+            SampleVector().swap(m_data);
+        }
+
+        m_data.resize(s); // within capacity: no reallocation
+        m_size = m_data.size();
+    }
 }
 
 void SampleSinkFifo::reset()
@@ -37,36 +62,65 @@ void SampleSinkFifo::reset()
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
+	resetTime();
+}
+
+void SampleSinkFifo::resetTime()
+{
+	m_clock.reset();
+	m_streamIndex = 0;
+	m_acceptedIndex = 0;
+	m_readIndex = 0;
+	m_hardwareTimeUs = -1;
+	m_anchors.assign(m_nbAnchors, TimeAnchor{0, 0});
+	m_anchorHead = 0;
 }
 
 SampleSinkFifo::SampleSinkFifo(QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_compact(false),
+	m_compactRequest(false),
+	m_arenaNode(-1),
+	m_arenaOwner(nullptr)
 {
 	m_suppressed = -1;
 	m_size = 0;
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
+	resetTime();
 }
 
 SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_compact(false),
+	m_compactRequest(false),
+	m_arenaNode(-1),
+	m_arenaOwner(nullptr)
 {
 	m_suppressed = -1;
 	create(size);
+	resetTime();
 }
 
 SampleSinkFifo::SampleSinkFifo(const SampleSinkFifo& other) :
     QObject(other.parent()),
-    m_data(other.m_data)
+    m_data(other.m_data),
+    m_compactData(other.m_compactData),
+    m_expandBuffer(other.m_expandBuffer),
+    m_compact(other.m_compact),
+    m_compactRequest(other.m_compactRequest),
+    m_arenaNode(other.m_arenaNode),
+    m_arenaOwner(other.m_arenaOwner)
 {
   	m_suppressed = -1;
-	m_size = m_data.size();
+	m_size = m_compact ? m_compactData.size() : m_data.size();
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
+	resetTime();
 }
 
 SampleSinkFifo::~SampleSinkFifo()
@@ -77,9 +131,146 @@ SampleSinkFifo::~SampleSinkFifo()
 
 bool SampleSinkFifo::setSize(int size)
 {
+	QMutexLocker mutexLocker(&m_mutex);
 	create(size);
+	m_readIndex = m_acceptedIndex; // contents are discarded
+
+	return m_size == (unsigned int)size;
+}
 
-	return m_data.size() == (unsigned int)size;
+void SampleSinkFifo::setArena(int node, const void *owner)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	m_arenaNode = node;
+	m_arenaOwner = owner;
+}
+
+void SampleSinkFifo::setCompact(bool compact)
+{
+#ifdef SDR_RX_SAMPLE_24BIT
+	QMutexLocker mutexLocker(&m_mutex);
+	m_compactRequest = compact;
+#else
+	(void) compact; // samples are already 16 bit
+#endif
+}
+
+void SampleSinkFifo::applyCompactRequest()
+{
+	if (m_compactRequest == m_compact) {
+		return;
+	}
+
+	qDebug("SampleSinkFifo::applyCompactRequest: %s storage of %u samples", m_compactRequest ? "compact" : "full", m_size);
+	m_compact = m_compactRequest;
+	create(m_size);
+	m_readIndex = m_acceptedIndex; // contents are discarded
+
+	if (m_compact) {
+		m_expandBuffer.resize(m_expandChunk);
+	}
+}
+
+void SampleSinkFifo::copyIn(const Sample* begin, unsigned int len, unsigned int at)
+{
+	if (m_compact)
+	{
+		CompactSampleVector::iterator it = m_compactData.begin() + at;
+
+		for (const Sample *s = begin; s < begin + len; ++s, ++it)
+		{
+			it->m_real = s->m_real >> (SDR_RX_SAMP_SZ - 16);
+			it->m_imag = s->m_imag >> (SDR_RX_SAMP_SZ - 16);
+		}
+	}
+	else
+	{
+		std::copy(begin, begin + len, m_data.begin() + at);
+	}
+}
+
+void SampleSinkFifo::copyOut(unsigned int at, unsigned int len, SampleVector::iterator dest)
+{
+	if (m_compact)
+	{
+		CompactSampleVector::const_iterator it = m_compactData.begin() + at;
+
+		for (unsigned int i = 0; i < len; i++, ++it, ++dest)
+		{
+			dest->m_real = ((FixReal) it->m_real) << (SDR_RX_SAMP_SZ - 16);
+			dest->m_imag = ((FixReal) it->m_imag) << (SDR_RX_SAMP_SZ - 16);
+		}
+	}
+	else
+	{
+		std::copy(m_data.begin() + at, m_data.begin() + at + len, dest);
+	}
+}
+
+void SampleSinkFifo::setSampleRate(unsigned int sampleRate)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (sampleRate != m_clock.getSampleRate())
+	{
+		m_clock.setSampleRate(sampleRate);
+		m_streamIndex = 0;
+		m_hardwareTimeUs = -1;
+	}
+}
+
+void SampleSinkFifo::setHardwareTimestamp(qint64 timeUs)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	m_hardwareTimeUs = timeUs;
+}
+
+void SampleSinkFifo::stampWrite(unsigned int count, unsigned int total)
+{
+	quint64 firstIndex = m_streamIndex;
+	m_streamIndex += count; // dropped samples take time too
+
+	if (m_hardwareTimeUs >= 0)
+	{
+		m_clock.setReference(firstIndex, m_hardwareTimeUs);
+		m_hardwareTimeUs = -1;
+	}
+	else
+	{
+		m_clock.observe(m_streamIndex, TimeUtil::nowus()); // the block is complete now
+	}
+
+	if (total > 0) // samples are dropped at the end of the block so the first one is always accepted
+	{
+		m_anchors[m_anchorHead].m_index = m_acceptedIndex;
+		m_anchors[m_anchorHead].m_timeUs = m_clock.getTimeUs(firstIndex);
+		m_anchorHead = (m_anchorHead + 1) % m_nbAnchors;
+		m_acceptedIndex += total;
+	}
+}
+
+qint64 SampleSinkFifo::getReadTimestampUs()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (!m_clock.isLocked()) {
+		return 0;
+	}
+
+	// newest anchor at or before the read head. If the reader is so late that it has been
+	// overwritten extrapolate from the oldest one.
+	const TimeAnchor *anchor = nullptr;
+
+	for (unsigned int i = 1; i <= m_nbAnchors; i++)
+	{
+		anchor = &m_anchors[(m_anchorHead + m_nbAnchors - i) % m_nbAnchors];
+
+		if (anchor->m_index <= m_readIndex) {
+			break;
+		}
+	}
+
+	return anchor->m_timeUs + (qint64) (((qint64) m_readIndex - (qint64) anchor->m_index) * m_clock.getPeriodUs());
 }
 
 unsigned int SampleSinkFifo::write(const quint8* data, unsigned int count)
@@ -116,12 +307,13 @@ unsigned int SampleSinkFifo::write(const quint8* data, unsigned int count)
 		}
 	}
 
+	stampWrite(count, total);
 	remaining = total;
 
     while (remaining > 0)
     {
 		len = std::min(remaining, m_size - m_tail);
-		std::copy(begin, begin + len, m_data.begin() + m_tail);
+		copyIn(&(*begin), len, m_tail);
 		m_tail += len;
 		m_tail %= m_size;
 		m_fill += len;
@@ -169,12 +361,13 @@ unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVec
 		}
 	}
 
+	stampWrite(count, total);
 	remaining = total;
 
     while (remaining > 0)
     {
 		len = std::min(remaining, m_size - m_tail);
-		std::copy(begin, begin + len, m_data.begin() + m_tail);
+		copyIn(&(*begin), len, m_tail);
 		m_tail += len;
 		m_tail %= m_size;
 		m_fill += len;
@@ -208,7 +401,7 @@ unsigned int SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::it
     while (remaining > 0)
     {
 		len = std::min(remaining, m_size - m_head);
-		std::copy(m_data.begin() + m_head, m_data.begin() + m_head + len, begin);
+		copyOut(m_head, len, begin);
 		m_head += len;
 		m_head %= m_size;
 		m_fill -= len;
@@ -216,6 +409,8 @@ unsigned int SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::it
 		remaining -= len;
 	}
 
+	m_readIndex += total;
+
 	return total;
 }
 
@@ -229,12 +424,37 @@ unsigned int SampleSinkFifo::readBegin(unsigned int count,
 	unsigned int len;
 	unsigned int head = m_head;
 
+	applyCompactRequest(); // the reader holds no iterator at this point
+
 	total = std::min(count, m_fill);
 
     if (total < count) {
 		qCritical("SampleSinkFifo::readBegin: underflow - missing %u samples", count - total);
     }
 
+    if (m_compact)
+    {
+        // widen a chunk small enough to stay in cache and hand it over as a single part
+        total = std::min(total, m_expandChunk);
+        remaining = total;
+
+        while (remaining > 0)
+        {
+            len = std::min(remaining, m_size - head);
+            copyOut(head, len, m_expandBuffer.begin() + (total - remaining));
+            head += len;
+            head %= m_size;
+            remaining -= len;
+        }
+
+        *part1Begin = m_expandBuffer.begin();
+        *part1End = m_expandBuffer.begin() + total;
+        *part2Begin = *part1End;
+        *part2End = *part1End;
+
+        return total;
+    }
+
 	remaining = total;
 
     if (remaining > 0)
@@ -279,6 +499,7 @@ unsigned int SampleSinkFifo::readCommit(unsigned int count)
 
     m_head = (m_head + count) % m_size;
 	m_fill -= count;
+	m_readIndex += count;
 
 	return count;
 }
@@ -23,6 +23,7 @@
 #include <QMutex>
 #include <QElapsedTimer>
 #include "dsp/dsptypes.h"
+#include "dsp/sampleclock.h"
 #include "export.h"
 
 class SDRBASE_API SampleSinkFifo : public QObject {
@@ -34,13 +35,41 @@ private:
 	int m_suppressed;
 
 	SampleVector m_data;
+	CompactSampleVector m_compactData; //!< Storage in compact mode
+	SampleVector m_expandBuffer;       //!< Samples widened from compact storage handed to the reader
+	bool m_compact;                    //!< Current storage mode
+	bool m_compactRequest;             //!< Requested storage mode applied at next read
+	int m_arenaNode;                   //!< BufferArena node of the storage
+	const void *m_arenaOwner;          //!< BufferArena owner of the storage
 
 	unsigned int m_size;
 	unsigned int m_fill;
 	unsigned int m_head;
 	unsigned int m_tail;
 
+	struct TimeAnchor
+	{
+		quint64 m_index;  //!< Index of the sample in the accepted samples sequence
+		qint64 m_timeUs;  //!< Time of this sample (us since epoch)
+	};
+
+	SampleClock m_clock;               //!< Stream sample index to time
+	quint64 m_streamIndex;             //!< Samples presented to write including dropped samples
+	quint64 m_acceptedIndex;           //!< Samples actually written
+	quint64 m_readIndex;               //!< Samples read
+	qint64 m_hardwareTimeUs;           //!< Pending hardware time of the next sample written or -1
+	std::vector<TimeAnchor> m_anchors; //!< Time of the first sample of the last written blocks
+	unsigned int m_anchorHead;
+
+	static const unsigned int m_expandChunk; //!< Maximum number of samples returned by readBegin in compact mode
+	static const unsigned int m_nbAnchors;
+
 	void create(unsigned int s);
+	void applyCompactRequest();
+	void copyIn(const Sample* begin, unsigned int len, unsigned int at);
+	void copyOut(unsigned int at, unsigned int len, SampleVector::iterator dest);
+	void stampWrite(unsigned int count, unsigned int total);
+	void resetTime();
 
 public:
 	SampleSinkFifo(QObject* parent = nullptr);
@@ -49,7 +78,25 @@ public:
 	~SampleSinkFifo();
 
 	bool setSize(int size);
+	void setArena(int node, const void *owner); //!< NUMA node (-1 follows the CPU) and BufferArena owner of the storage allocated from now on
     void reset();
+    /**
+     * Compact mode stores samples as 16 bit I/Q (only the 16 most significant bits of 24 bit samples)
+     * which halves the memory footprint of the FIFO. Samples are narrowed on write and widened back
+     * on read so this costs two extra passes over the data. Has no effect in 16 bit builds.
+     * The change is applied by the reader at its next readBegin and the FIFO contents are discarded.
+     */
+    void setCompact(bool compact);
+    bool isCompact() const { return m_compactRequest; }
+	/**
+	 * Every block written is timestamped. The time of the first sample of a block comes from the
+	 * hardware time given with setHardwareTimestamp() just before the write when the device has it
+	 * or else from the host clock smoothed by the sample clock loop.
+	 */
+	void setSampleRate(unsigned int sampleRate);       //!< Seeds the sample clock. Resets timing when changed
+	void setHardwareTimestamp(qint64 timeUs);          //!< Hardware time (us since epoch) of the next sample written
+	qint64 getReadTimestampUs();                       //!< Time of the sample at the read head (us since epoch) or 0 if unknown
+	bool isHardwareTime() const { return m_clock.isHardware(); }
 	inline unsigned int size() const { return m_size; }
 	inline unsigned int fill() { QMutexLocker mutexLocker(&m_mutex); unsigned int fill = m_fill; return fill; }
 
@@ -21,11 +21,15 @@ const unsigned int SampleSourceFifo::m_rwDivisor = 2;
 const unsigned int SampleSourceFifo::m_guardDivisor = 10;
 
 SampleSourceFifo::SampleSourceFifo(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_arenaNode(-1),
+    m_arenaOwner(nullptr)
 {}
 
 SampleSourceFifo::SampleSourceFifo(unsigned int size, QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_arenaNode(-1),
+    m_arenaOwner(nullptr)
 {
     resize(size);
 }
@@ -33,6 +37,7 @@ SampleSourceFifo::SampleSourceFifo(unsigned int size, QObject *parent) :
 void SampleSourceFifo::resize(unsigned int size)
 {
     QMutexLocker mutexLocker(&m_mutex);
+    BufferArena::Scope arenaScope(m_arenaNode, m_arenaOwner);
     m_size = size;
     m_lowGuard = m_size / m_guardDivisor;
     m_highGuard = m_size - (m_size/m_guardDivisor);
@@ -40,9 +45,21 @@ void SampleSourceFifo::resize(unsigned int size)
 	m_readCount = 0;
     m_readHead = 0;
     m_writeHead = m_midPoint;
+
+    if (size > m_data.capacity()) { // release before allocating so that the arena can recycle the block
+        SampleVector().swap(m_data);
+    }
+
     m_data.resize(size);
 }
 
+void SampleSourceFifo::setArena(int node, const void *owner)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_arenaNode = node;
+    m_arenaOwner = owner;
+}
+
 void SampleSourceFifo::reset()
 {
     QMutexLocker mutexLocker(&m_mutex);
@@ -30,6 +30,7 @@ public:
     SampleSourceFifo(unsigned int size, QObject *parent = nullptr);
     ~SampleSourceFifo();
     void resize(unsigned int size);
+    void setArena(int node, const void *owner); //!< NUMA node (-1 follows the CPU) and BufferArena owner of the storage allocated from now on
     void reset();
 
     SampleVector& getData() { return m_data; }
@@ -70,6 +71,8 @@ signals:
 
 private:
     SampleVector m_data;
+    int m_arenaNode;          //!< BufferArena node of the storage
+    const void *m_arenaOwner; //!< BufferArena owner of the storage
     unsigned int m_size;
     unsigned int m_lowGuard;
     unsigned int m_highGuard;
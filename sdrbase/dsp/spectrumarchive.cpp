@@ -0,0 +1,568 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDebug>
+#include <QDir>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QMutexLocker>
+
+#include "spectrumarchive.h"
+
+const Real SpectrumArchive::m_minDb = -150.0f;
+const Real SpectrumArchive::m_dbStep = 0.6f;
+
+SpectrumArchive::SpectrumArchive() :
+    m_open(false),
+    m_centerFrequency(0),
+    m_sampleRate(0),
+    m_runActive(false),
+    m_mutex(QMutex::Recursive)
+{
+    for (int level = 0; level < m_nbLevels; level++)
+    {
+        m_levels[level].m_nbBins = 0;
+        m_levels[level].m_nbRows = 0;
+        m_levels[level].m_hasPending = false;
+    }
+}
+
+SpectrumArchive::~SpectrumArchive()
+{
+    close();
+}
+
+bool SpectrumArchive::open(const QString& directory)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_open) {
+        close();
+    }
+
+    if (!QDir().mkpath(directory))
+    {
+        qCritical("SpectrumArchive::open: cannot create %s", qPrintable(directory));
+        return false;
+    }
+
+    m_directory = directory;
+    m_runs.clear();
+    loadIndex();
+    m_runActive = false;
+    m_open = true;
+    qDebug("SpectrumArchive::open: %s: %d runs", qPrintable(m_directory), (int) m_runs.size());
+
+    return true;
+}
+
+void SpectrumArchive::close()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_open) {
+        return;
+    }
+
+    endRun();
+    m_open = false;
+}
+
+void SpectrumArchive::setStream(quint64 centerFrequency, int sampleRate)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if ((centerFrequency != m_centerFrequency) || (sampleRate != m_sampleRate)) {
+        endRun(); // the next spectrum starts a new run
+    }
+
+    m_centerFrequency = centerFrequency;
+    m_sampleRate = sampleRate;
+}
+
+quint8 SpectrumArchive::quantize(Real db)
+{
+    Real q = std::round((db - m_minDb) / m_dbStep);
+    return q < 0.0f ? 0 : q > 255.0f ? 255 : (quint8) q;
+}
+
+void SpectrumArchive::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_open || (m_sampleRate == 0)) {
+        return;
+    }
+
+    if (m_runActive && (fftSize != m_runs.back().m_fftSize)) {
+        endRun();
+    }
+
+    if (!m_runActive) {
+        startRun(fftSize);
+    }
+
+    m_row.resize(fftSize);
+
+    for (int i = 0; i < fftSize; i++) {
+        m_row[i] = quantize(spectrum[i]);
+    }
+
+    qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    m_timesFile.write((const char *) &nowMs, sizeof(qint64));
+    Run& run = m_runs.back();
+    run.m_endMs = nowMs;
+    run.m_nbRows++;
+
+    pushRow(0, m_row);
+}
+
+int SpectrumArchive::levelBins(int fftSize, int level)
+{
+    int minBins = std::min(fftSize, (int) m_minLevelBins);
+    int bins = fftSize >> level;
+    return bins < minBins ? minBins : bins;
+}
+
+int SpectrumArchive::recordSize(int fftSize, int level)
+{
+    return m_tileRows * levelBins(fftSize, level);
+}
+
+QString SpectrumArchive::runDirectory(int runIndex) const
+{
+    return QString("%1/run%2").arg(m_directory).arg(runIndex, 5, 10, QChar('0'));
+}
+
+void SpectrumArchive::startRun(int fftSize)
+{
+    Run run;
+    run.m_index = m_runs.size() == 0 ? 0 : m_runs.back().m_index + 1;
+    run.m_centerFrequency = m_centerFrequency;
+    run.m_sampleRate = m_sampleRate;
+    run.m_fftSize = fftSize;
+    run.m_startMs = QDateTime::currentMSecsSinceEpoch();
+    run.m_endMs = run.m_startMs;
+    run.m_nbRows = 0;
+
+    QString runDir = runDirectory(run.m_index);
+    QDir().mkpath(runDir);
+    m_timesFile.setFileName(runDir + "/times.dat");
+
+    if (!m_timesFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCritical("SpectrumArchive::startRun: cannot open %s", qPrintable(m_timesFile.fileName()));
+    }
+
+    for (int level = 0; level < m_nbLevels; level++)
+    {
+        Level& l = m_levels[level];
+        l.m_nbBins = levelBins(fftSize, level);
+        l.m_nbRows = 0;
+        l.m_record.assign(recordSize(fftSize, level), 0);
+        l.m_hasPending = false;
+        QFile(QString("%1/L%2.dat").arg(runDir).arg(level)).remove();
+    }
+
+    m_runs.push_back(run);
+    m_runActive = true;
+    saveIndex();
+
+    qDebug("SpectrumArchive::startRun: run %d: %llu Hz %d S/s FFT: %d",
+        run.m_index, run.m_centerFrequency, run.m_sampleRate, run.m_fftSize);
+}
+
+void SpectrumArchive::endRun()
+{
+    if (!m_runActive) {
+        return;
+    }
+
+    flushRecords();
+    m_timesFile.close();
+    m_runActive = false;
+    saveIndex();
+}
+
+void SpectrumArchive::pushRow(int level, const std::vector<quint8>& row)
+{
+    storeRow(level, row);
+
+    if (level + 1 == m_nbLevels) {
+        return;
+    }
+
+    Level& l = m_levels[level];
+
+    if (!l.m_hasPending)
+    {
+        l.m_pendingRow = row;
+        l.m_hasPending = true;
+        return;
+    }
+
+    // peak hold over the pair of rows then over pairs of bins if the next level is narrower
+    int nextBins = m_levels[level + 1].m_nbBins;
+    std::vector<quint8> nextRow(nextBins);
+
+    if (nextBins == l.m_nbBins)
+    {
+        for (int i = 0; i < nextBins; i++) {
+            nextRow[i] = std::max(l.m_pendingRow[i], row[i]);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < nextBins; i++)
+        {
+            quint8 a = std::max(l.m_pendingRow[2*i], row[2*i]);
+            quint8 b = 2*i + 1 < l.m_nbBins ? std::max(l.m_pendingRow[2*i + 1], row[2*i + 1]) : 0;
+            nextRow[i] = std::max(a, b);
+        }
+    }
+
+    l.m_hasPending = false;
+    pushRow(level + 1, nextRow);
+}
+
+void SpectrumArchive::storeRow(int level, const std::vector<quint8>& row)
+{
+    Level& l = m_levels[level];
+    int recordRow = l.m_nbRows % m_tileRows;
+
+    for (int tileStart = 0; tileStart < l.m_nbBins; tileStart += m_tileBins)
+    {
+        int tileWidth = std::min((int) m_tileBins, l.m_nbBins - tileStart);
+        std::copy(
+            row.begin() + tileStart,
+            row.begin() + tileStart + tileWidth,
+            l.m_record.begin() + tileStart*m_tileRows + recordRow*tileWidth
+        );
+    }
+
+    l.m_nbRows++;
+
+    if (recordRow == m_tileRows - 1)
+    {
+        writeRecord(level);
+        std::fill(l.m_record.begin(), l.m_record.end(), 0);
+
+        if (level == 0) {
+            saveIndex(); // keep the row count on disk reasonably up to date
+        }
+    }
+}
+
+void SpectrumArchive::writeRecord(int level)
+{
+    Level& l = m_levels[level];
+
+    if (l.m_nbRows == 0) {
+        return;
+    }
+
+    quint64 recordIndex = (l.m_nbRows - 1) / m_tileRows;
+    QFile levelFile(QString("%1/L%2.dat").arg(runDirectory(m_runs.back().m_index)).arg(level));
+
+    if (!levelFile.open(QIODevice::ReadWrite))
+    {
+        qCritical("SpectrumArchive::writeRecord: cannot open %s", qPrintable(levelFile.fileName()));
+        return;
+    }
+
+    levelFile.seek(recordIndex * l.m_record.size());
+    levelFile.write((const char *) l.m_record.data(), l.m_record.size());
+    levelFile.close();
+}
+
+void SpectrumArchive::flushRecords()
+{
+    if (!m_runActive) {
+        return;
+    }
+
+    for (int level = 0; level < m_nbLevels; level++)
+    {
+        if (m_levels[level].m_nbRows % m_tileRows != 0) { // complete records are already written
+            writeRecord(level);
+        }
+    }
+
+    m_timesFile.flush();
+}
+
+void SpectrumArchive::loadIndex()
+{
+    QFile indexFile(m_directory + "/index.json");
+
+    if (!indexFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(indexFile.readAll());
+    QJsonArray runs = doc.object().value("runs").toArray();
+
+    for (int i = 0; i < runs.size(); i++)
+    {
+        QJsonObject jsonRun = runs.at(i).toObject();
+        Run run;
+        run.m_index = jsonRun.value("index").toInt();
+        run.m_centerFrequency = (quint64) jsonRun.value("centerFrequency").toDouble();
+        run.m_sampleRate = jsonRun.value("sampleRate").toInt();
+        run.m_fftSize = jsonRun.value("fftSize").toInt();
+        run.m_startMs = (qint64) jsonRun.value("startMs").toDouble();
+        run.m_endMs = (qint64) jsonRun.value("endMs").toDouble();
+        run.m_nbRows = (quint64) jsonRun.value("nbRows").toDouble();
+        m_runs.push_back(run);
+    }
+}
+
+void SpectrumArchive::saveIndex()
+{
+    QJsonArray runs;
+
+    for (const auto& run : m_runs)
+    {
+        QJsonObject jsonRun;
+        jsonRun.insert("index", run.m_index);
+        jsonRun.insert("centerFrequency", (double) run.m_centerFrequency);
+        jsonRun.insert("sampleRate", run.m_sampleRate);
+        jsonRun.insert("fftSize", run.m_fftSize);
+        jsonRun.insert("startMs", (double) run.m_startMs);
+        jsonRun.insert("endMs", (double) run.m_endMs);
+        jsonRun.insert("nbRows", (double) run.m_nbRows);
+        runs.append(jsonRun);
+    }
+
+    QJsonObject root;
+    root.insert("runs", runs);
+    QFile indexFile(m_directory + "/index.json");
+
+    if (!indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCritical("SpectrumArchive::saveIndex: cannot open %s", qPrintable(indexFile.fileName()));
+        return;
+    }
+
+    indexFile.write(QJsonDocument(root).toJson());
+}
+
+qint64 SpectrumArchive::readTime(QFile& timesFile, quint64 row)
+{
+    qint64 timeMs = 0;
+    timesFile.seek(row * sizeof(qint64));
+    timesFile.read((char *) &timeMs, sizeof(qint64));
+    return timeMs;
+}
+
+quint64 SpectrumArchive::lowerBound(QFile& timesFile, quint64 nbRows, qint64 timeMs)
+{
+    quint64 first = 0;
+    quint64 count = nbRows;
+
+    while (count > 0)
+    {
+        quint64 step = count / 2;
+
+        if (readTime(timesFile, first + step) < timeMs)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
+bool SpectrumArchive::query(qint64 fromMs, qint64 toMs, qint64 fromHz, qint64 toHz, int maxRows, int maxBins, std::vector<Window>& windows)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    windows.clear();
+
+    if (!m_open || (toMs < fromMs) || (toHz < fromHz) || (maxRows <= 0) || (maxBins <= 0)) {
+        return false;
+    }
+
+    flushRecords(); // make the rows of the current record visible
+
+    for (const auto& run : m_runs)
+    {
+        qint64 runStartHz = (qint64) run.m_centerFrequency - run.m_sampleRate/2;
+        qint64 runEndHz = (qint64) run.m_centerFrequency + run.m_sampleRate/2;
+
+        if ((run.m_nbRows == 0) || (run.m_endMs < fromMs) || (run.m_startMs > toMs)
+         || (runEndHz < fromHz) || (runStartHz > toHz)) {
+            continue;
+        }
+
+        queryRun(run, fromMs, toMs, fromHz, toHz, maxRows, maxBins, windows);
+    }
+
+    return true;
+}
+
+void SpectrumArchive::queryRun(const Run& run, qint64 fromMs, qint64 toMs, qint64 fromHz, qint64 toHz,
+    int maxRows, int maxBins, std::vector<Window>& windows)
+{
+    QString runDir = runDirectory(run.m_index);
+    QFile timesFile(runDir + "/times.dat");
+
+    if (!timesFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    // level 0 row range [r0, r1[
+    quint64 r0 = lowerBound(timesFile, run.m_nbRows, fromMs);
+    quint64 r1 = lowerBound(timesFile, run.m_nbRows, toMs + 1);
+
+    if (r0 >= r1) {
+        return;
+    }
+
+    // level 0 bin range [b0, b1[
+    double binWidth0 = run.m_sampleRate / (double) run.m_fftSize;
+    qint64 runStartHz = (qint64) run.m_centerFrequency - run.m_sampleRate/2;
+    qint64 runEndHz = runStartHz + (qint64) (run.m_fftSize * binWidth0);
+    fromHz = std::max(fromHz, runStartHz); // clamp to the run before converting to bins
+    toHz = std::min(toHz, runEndHz);
+    int b0 = (int) std::floor((fromHz - runStartHz) / binWidth0);
+    int b1 = (int) std::ceil((toHz - runStartHz) / binWidth0);
+    b0 = std::max(0, std::min(b0, run.m_fftSize - 1));
+    b1 = std::max(b0 + 1, std::min(b1, run.m_fftSize));
+
+    // select the coarsest needed level
+    int level = 0;
+
+    for (int l = 0; l < m_nbLevels; l++)
+    {
+        quint64 levelRows = run.m_nbRows >> l;
+
+        if ((levelRows == 0) || ((r0 >> l) > std::min((r1 - 1) >> l, levelRows - 1))) {
+            break; // no complete row at this level for this window
+        }
+
+        level = l;
+        int ratio = run.m_fftSize / levelBins(run.m_fftSize, l);
+        quint64 nbRows = ((r1 - 1) >> l) - (r0 >> l) + 1;
+        int nbBins = (b1 - 1)/ratio - b0/ratio + 1;
+        bool minWidth = levelBins(run.m_fftSize, l) == std::min(run.m_fftSize, (int) m_minLevelBins);
+
+        if ((nbRows <= (quint64) maxRows) && ((nbBins <= maxBins) || minWidth)) {
+            break;
+        }
+    }
+
+    int levelWidth = levelBins(run.m_fftSize, level);
+    int ratio = run.m_fftSize / levelWidth;
+    quint64 lr0 = r0 >> level;
+    quint64 lr1 = std::min((r1 - 1) >> level, (run.m_nbRows >> level) - 1); // inclusive
+    int lb0 = b0 / ratio;
+    int lb1 = (b1 - 1) / ratio; // inclusive
+
+    QFile levelFile(QString("%1/L%2.dat").arg(runDir).arg(level));
+
+    if (!levelFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    windows.push_back(Window());
+    Window& window = windows.back();
+    window.m_centerFrequency = run.m_centerFrequency;
+    window.m_sampleRate = run.m_sampleRate;
+    window.m_level = level;
+    window.m_binWidth = binWidth0 * ratio;
+    window.m_startFrequency = runStartHz + (qint64) (lb0 * window.m_binWidth);
+    window.m_nbRows = lr1 - lr0 + 1;
+    window.m_nbBins = lb1 - lb0 + 1;
+    window.m_rowTimes.resize(window.m_nbRows);
+    window.m_data.assign(window.m_nbRows * window.m_nbBins, 0);
+
+    for (quint64 lr = lr0; lr <= lr1; lr++) {
+        window.m_rowTimes[lr - lr0] = readTime(timesFile, lr << level);
+    }
+
+    int recordBytes = recordSize(run.m_fftSize, level);
+    std::vector<quint8> block;
+
+    for (quint64 record = lr0 / m_tileRows; record <= lr1 / m_tileRows; record++)
+    {
+        int rowStart = record == lr0 / m_tileRows ? lr0 % m_tileRows : 0;
+        int rowEnd = record == lr1 / m_tileRows ? lr1 % m_tileRows : m_tileRows - 1; // inclusive
+
+        for (int tileStart = (lb0 / m_tileBins) * m_tileBins; tileStart <= lb1; tileStart += m_tileBins)
+        {
+            // the rows of a frequency tile are contiguous: read them in one go
+            int tileWidth = std::min((int) m_tileBins, levelWidth - tileStart);
+            int nbTileRows = rowEnd - rowStart + 1;
+            block.resize(nbTileRows * tileWidth);
+            levelFile.seek(record * recordBytes + tileStart*m_tileRows + rowStart*tileWidth);
+            levelFile.read((char *) block.data(), block.size());
+
+            int binStart = std::max(lb0, tileStart);
+            int binEnd = std::min(lb1, tileStart + tileWidth - 1); // inclusive
+            quint64 windowRow = record * m_tileRows + rowStart - lr0;
+
+            for (int row = 0; row < nbTileRows; row++, windowRow++)
+            {
+                std::copy(
+                    block.begin() + row*tileWidth + (binStart - tileStart),
+                    block.begin() + row*tileWidth + (binEnd - tileStart) + 1,
+                    window.m_data.begin() + windowRow*window.m_nbBins + (binStart - lb0)
+                );
+            }
+        }
+    }
+}
+
+void SpectrumArchive::formatWindows(const std::vector<Window>& windows, QJsonObject& json)
+{
+    QJsonArray jsonWindows;
+
+    for (const auto& window : windows)
+    {
+        QJsonObject jsonWindow;
+        jsonWindow.insert("centerFrequency", (double) window.m_centerFrequency);
+        jsonWindow.insert("sampleRate", window.m_sampleRate);
+        jsonWindow.insert("level", window.m_level);
+        jsonWindow.insert("startFrequency", (double) window.m_startFrequency);
+        jsonWindow.insert("binWidth", window.m_binWidth);
+        jsonWindow.insert("nbRows", window.m_nbRows);
+        jsonWindow.insert("nbBins", window.m_nbBins);
+        QJsonArray rowTimes;
+
+        for (auto t : window.m_rowTimes) {
+            rowTimes.append((double) t);
+        }
+
+        jsonWindow.insert("rowTimes", rowTimes);
+        QByteArray data((const char *) window.m_data.data(), window.m_data.size());
+        jsonWindow.insert("data", QString(data.toBase64()));
+        jsonWindows.append(jsonWindow);
+    }
+
+    json.insert("minDb", m_minDb);
+    json.insert("dbStep", m_dbStep);
+    json.insert("windows", jsonWindows);
+}
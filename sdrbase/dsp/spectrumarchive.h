@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMARCHIVE_H_
+#define SDRBASE_DSP_SPECTRUMARCHIVE_H_
+
+#include <vector>
+
+#include <QString>
+#include <QFile>
+#include <QMutex>
+
+#include "dsp/glspectruminterface.h"
+#include "export.h"
+
+class QJsonObject;
+
+/**
+ * Permanent waterfall history stored on disk.
+ *
+ * Power spectra (in dB) are quantized to one byte per bin and stored in a pyramid of levels.
+ * Level 0 holds the spectra as received. Each level above is half the time resolution of the
+ * level below and half its frequency resolution until the width falls to m_minLevelBins bins.
+ * Decimation keeps the peak value so that short bursts stay visible when zoomed out.
+ *
+ * The archive is split in runs. A new run starts whenever center frequency, sample rate or
+ * FFT size change. Each run is a directory holding:
+ *   - times.dat: the timestamp (ms since epoch, qint64) of every level 0 row
+ *   - L<n>.dat: the level n data as a sequence of fixed size records of m_tileRows rows.
+ *     Inside a record data is stored by frequency tiles of m_tileBins bins so that a
+ *     frequency window is read in contiguous chunks.
+ * The list of runs is kept in index.json at the root of the archive directory.
+ */
+class SDRBASE_API SpectrumArchive : public GLSpectrumInterface
+{
+public:
+    struct Window
+    {
+        quint64 m_centerFrequency;    //!< Center frequency of the run (Hz)
+        int m_sampleRate;             //!< Sample rate of the run (S/s)
+        int m_level;                  //!< Pyramid level the data was taken from
+        qint64 m_startFrequency;      //!< Frequency of the first bin (Hz)
+        double m_binWidth;            //!< Width of one bin (Hz)
+        int m_nbRows;
+        int m_nbBins;
+        std::vector<qint64> m_rowTimes; //!< Timestamp of each row (ms since epoch)
+        std::vector<quint8> m_data;     //!< m_nbRows x m_nbBins quantized values, row major
+    };
+
+    SpectrumArchive();
+    virtual ~SpectrumArchive();
+
+    bool open(const QString& directory);
+    void close();
+    bool isOpen() const { return m_open; }
+    const QString& getDirectory() const { return m_directory; }
+
+    void setStream(quint64 centerFrequency, int sampleRate); //!< Call whenever the device stream changes
+    virtual void newSpectrum(const std::vector<Real>& spectrum, int fftSize);
+
+    /**
+     * Retrieve the data covering the [fromMs, toMs] time window and [fromHz, toHz] frequency window.
+     * The lowest resolution level that keeps the result within maxRows x maxBins is used
+     * (frequency decimation stops at m_minLevelBins so the bins limit may be exceeded).
+     * One window is returned per run overlapping the query.
+     */
+    bool query(qint64 fromMs, qint64 toMs, qint64 fromHz, qint64 toHz, int maxRows, int maxBins, std::vector<Window>& windows);
+    static void formatWindows(const std::vector<Window>& windows, QJsonObject& json);
+
+    static quint8 quantize(Real db);
+    static Real dequantize(quint8 q) { return m_minDb + q * m_dbStep; }
+
+    static const int m_tileRows = 256;     //!< Rows per record
+    static const int m_tileBins = 256;     //!< Bins per frequency tile
+    static const int m_minLevelBins = 64;  //!< Frequency decimation stops at this width
+    static const int m_nbLevels = 16;      //!< Time decimation of the top level is 2^15
+    static const Real m_minDb;             //!< dB value of quantized 0
+    static const Real m_dbStep;            //!< dB per quantization step
+
+private:
+    struct Run
+    {
+        int m_index;
+        quint64 m_centerFrequency;
+        int m_sampleRate;
+        int m_fftSize;
+        qint64 m_startMs;
+        qint64 m_endMs;
+        quint64 m_nbRows; //!< Number of level 0 rows
+
+        Run() :
+            m_index(0),
+            m_centerFrequency(0),
+            m_sampleRate(0),
+            m_fftSize(0),
+            m_startMs(0),
+            m_endMs(0),
+            m_nbRows(0)
+        {}
+    };
+
+    struct Level
+    {
+        int m_nbBins;               //!< Width of a row at this level
+        quint64 m_nbRows;           //!< Total rows completed at this level
+        std::vector<quint8> m_record; //!< Current (incomplete) record laid out as stored on disk
+        std::vector<quint8> m_pendingRow; //!< Row waiting for its pair to build the next level
+        bool m_hasPending;
+    };
+
+    bool m_open;
+    QString m_directory;
+    quint64 m_centerFrequency;
+    int m_sampleRate;
+    std::vector<Run> m_runs;
+    bool m_runActive;
+    Level m_levels[m_nbLevels];
+    std::vector<quint8> m_row;
+    QFile m_timesFile;
+    QMutex m_mutex;
+
+    void startRun(int fftSize);
+    void endRun();
+    void pushRow(int level, const std::vector<quint8>& row);
+    void storeRow(int level, const std::vector<quint8>& row);
+    void writeRecord(int level);
+    void flushRecords();
+    void loadIndex();
+    void saveIndex();
+    QString runDirectory(int runIndex) const;
+    static int levelBins(int fftSize, int level);
+    static int recordSize(int fftSize, int level);
+    static qint64 readTime(QFile& timesFile, quint64 row);
+    static quint64 lowerBound(QFile& timesFile, quint64 nbRows, qint64 timeMs);
+    void queryRun(const Run& run, qint64 fromMs, qint64 toMs, qint64 fromHz, qint64 toHz,
+        int maxRows, int maxBins, std::vector<Window>& windows);
+};
+
+#endif // SDRBASE_DSP_SPECTRUMARCHIVE_H_
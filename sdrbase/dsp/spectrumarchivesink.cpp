@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dsp/dspcommands.h"
+#include "spectrumarchivesink.h"
+
+SpectrumArchiveSink::SpectrumArchiveSink() :
+    m_spectrumVis(SDR_RX_SCALEF),
+    m_fftSize(1024),
+    m_rowsPerSecond(10.0f),
+    m_sampleRate(48000)
+{
+    setObjectName("SpectrumArchiveSink");
+    m_spectrumVis.setGLSpectrum(&m_archive);
+}
+
+SpectrumArchiveSink::~SpectrumArchiveSink()
+{
+    m_archive.close();
+}
+
+bool SpectrumArchiveSink::open(const QString& directory, int fftSize, float rowsPerSecond)
+{
+    if (!isValidFFTSize(fftSize))
+    {
+        qWarning("SpectrumArchiveSink::open: invalid FFT size: %d", fftSize);
+        return false;
+    }
+
+    m_fftSize = fftSize;
+    m_rowsPerSecond = rowsPerSecond > 0.0f ? rowsPerSecond : 1.0f;
+
+    if (!m_archive.open(directory)) {
+        return false;
+    }
+
+    applySpectrumSettings();
+    return true;
+}
+
+void SpectrumArchiveSink::close()
+{
+    m_archive.close();
+}
+
+void SpectrumArchiveSink::start()
+{
+    m_spectrumVis.start();
+}
+
+void SpectrumArchiveSink::stop()
+{
+    m_spectrumVis.stop();
+}
+
+void SpectrumArchiveSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
+{
+    if (m_archive.isOpen()) {
+        m_spectrumVis.feed(begin, end, positiveOnly);
+    }
+}
+
+bool SpectrumArchiveSink::handleMessage(const Message& cmd)
+{
+    if (DSPSignalNotification::match(cmd))
+    {
+        DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
+        qDebug() << "SpectrumArchiveSink::handleMessage: DSPSignalNotification:"
+            << " centerFrequency: " << notif.getCenterFrequency()
+            << " sampleRate: " << notif.getSampleRate();
+        m_sampleRate = notif.getSampleRate();
+        m_archive.setStream(notif.getCenterFrequency(), m_sampleRate);
+        m_spectrumVis.handleMessage(cmd);
+        applySpectrumSettings();
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void SpectrumArchiveSink::applySpectrumSettings()
+{
+    // average as many FFTs as needed to get close to the requested row rate
+    unsigned int averagingNb = m_sampleRate / (m_fftSize * m_rowsPerSecond);
+    averagingNb = averagingNb < 1 ? 1 : averagingNb;
+
+    GLSpectrumSettings settings = m_spectrumVis.getSettings();
+    settings.m_fftSize = m_fftSize;
+    settings.m_fftOverlap = 0;
+    settings.m_fftWindow = FFTWindow::BlackmanHarris;
+    settings.m_averagingMode = GLSpectrumSettings::AvgModeFixed;
+    settings.m_averagingIndex = GLSpectrumSettings::getAveragingIndex(averagingNb, settings.m_averagingMode);
+    settings.m_linear = false;
+
+    // applied synchronously: this sink may be created from a thread without an event loop
+    SpectrumVis::MsgConfigureSpectrumVis *msg = SpectrumVis::MsgConfigureSpectrumVis::create(settings, false);
+    m_spectrumVis.handleMessage(*msg);
+    delete msg;
+}
@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMARCHIVESINK_H_
+#define SDRBASE_DSP_SPECTRUMARCHIVESINK_H_
+
+#include "dsp/basebandsamplesink.h"
+#include "dsp/spectrumvis.h"
+#include "dsp/spectrumarchive.h"
+#include "export.h"
+
+/**
+ * Baseband sink attached to a device set to record its waterfall into a SpectrumArchive.
+ * Power spectra are computed by a private SpectrumVis using fixed averaging so that
+ * the archive receives about the requested number of rows per second whatever the sample rate.
+ */
+class SDRBASE_API SpectrumArchiveSink : public BasebandSampleSink {
+public:
+    SpectrumArchiveSink();
+    virtual ~SpectrumArchiveSink();
+
+    bool open(const QString& directory, int fftSize, float rowsPerSecond);
+    void close();
+    SpectrumArchive& getArchive() { return m_archive; }
+    int getFFTSize() const { return m_fftSize; }
+    float getRowsPerSecond() const { return m_rowsPerSecond; }
+    static bool isValidFFTSize(int fftSize) { return (fftSize >= m_minFFTSize) && (fftSize <= m_maxFFTSize) && ((fftSize & (fftSize - 1)) == 0); }
+
+    static const int m_minFFTSize = 64;   //!< Limits of the SpectrumVis FFT
+    static const int m_maxFFTSize = 4096;
+
+    virtual void start();
+    virtual void stop();
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
+    virtual bool handleMessage(const Message& cmd);
+
+private:
+    SpectrumVis m_spectrumVis;
+    SpectrumArchive m_archive;
+    int m_fftSize;
+    float m_rowsPerSecond;
+    int m_sampleRate;
+
+    void applySpectrumSettings();
+};
+
+#endif // SDRBASE_DSP_SPECTRUMARCHIVESINK_H_
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "streamworkers.h"
+
+StreamWorkers::Worker::Worker(StreamWorkers *parent, unsigned int streamIndex) :
+    m_parent(parent),
+    m_streamIndex(streamIndex)
+{}
+
+void StreamWorkers::Worker::run()
+{
+    m_parent->workerLoop(m_streamIndex);
+}
+
+StreamWorkers::StreamWorkers() :
+    m_job(nullptr),
+    m_nbJobStreams(0),
+    m_generation(0),
+    m_pending(0),
+    m_stopping(false)
+{}
+
+StreamWorkers::~StreamWorkers()
+{
+    stop();
+}
+
+void StreamWorkers::start(unsigned int nbStreams)
+{
+    stop();
+
+    if (nbStreams < 2) {
+        return;
+    }
+
+    qDebug("StreamWorkers::start: %u streams", nbStreams);
+    m_stopping = false;
+    m_generation = 0; // workers wait for the first job from generation 0
+
+    for (unsigned int streamIndex = 1; streamIndex < nbStreams; streamIndex++)
+    {
+        m_workers.push_back(new Worker(this, streamIndex));
+        m_workers.back()->start();
+    }
+}
+
+void StreamWorkers::stop()
+{
+    if (m_workers.size() == 0) {
+        return;
+    }
+
+    qDebug("StreamWorkers::stop");
+    m_mutex.lock();
+    m_stopping = true;
+    m_jobReady.wakeAll();
+    m_mutex.unlock();
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    m_workers.clear();
+}
+
+void StreamWorkers::run(unsigned int nbStreams, const Job& job)
+{
+    if (m_workers.size() == 0) // sequential fallback
+    {
+        for (unsigned int streamIndex = 0; streamIndex < nbStreams; streamIndex++) {
+            job(streamIndex);
+        }
+
+        return;
+    }
+
+    m_mutex.lock();
+    m_job = &job;
+    m_nbJobStreams = nbStreams;
+    m_pending = m_workers.size();
+    m_generation++;
+    m_jobReady.wakeAll();
+    m_mutex.unlock();
+
+    if (nbStreams > 0) {
+        job(0);
+    }
+
+    // streams beyond the workers count (should not happen) are done here
+    for (unsigned int streamIndex = m_workers.size() + 1; streamIndex < nbStreams; streamIndex++) {
+        job(streamIndex);
+    }
+
+    m_mutex.lock();
+
+    while (m_pending != 0) {
+        m_jobsDone.wait(&m_mutex);
+    }
+
+    m_job = nullptr;
+    m_mutex.unlock();
+}
+
+void StreamWorkers::workerLoop(unsigned int streamIndex)
+{
+    unsigned int generation = 0;
+    m_mutex.lock();
+
+    while (true)
+    {
+        while (!m_stopping && (m_generation == generation)) {
+            m_jobReady.wait(&m_mutex);
+        }
+
+        if (m_stopping) {
+            break;
+        }
+
+        generation = m_generation;
+        const Job *job = m_job;
+        bool concerned = streamIndex < m_nbJobStreams;
+        m_mutex.unlock();
+
+        if (concerned) {
+            (*job)(streamIndex);
+        }
+
+        m_mutex.lock();
+
+        if (--m_pending == 0) {
+            m_jobsDone.wakeAll();
+        }
+    }
+
+    m_mutex.unlock();
+}
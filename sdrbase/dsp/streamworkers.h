@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_STREAMWORKERS_H_
+#define SDRBASE_DSP_STREAMWORKERS_H_
+
+#include <vector>
+#include <functional>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "export.h"
+
+/**
+ * Set of threads each bound to one stream index used to process the streams of a block in parallel.
+ * run() executes the job for stream 0 on the calling thread and for the other streams on their own
+ * worker then returns only when all streams are done. The calling thread can therefore treat the
+ * whole call as a block barrier and process data that needs all streams aligned right after it.
+ * A worker is always given the same stream so that the state of the stream stays on one core.
+ */
+class SDRBASE_API StreamWorkers
+{
+public:
+    typedef std::function<void(unsigned int)> Job; //!< Job called with the stream index
+
+    StreamWorkers();
+    ~StreamWorkers();
+
+    void start(unsigned int nbStreams); //!< Start workers for streams 1 to nbStreams-1
+    void stop();                        //!< Stop all workers
+    unsigned int getNbStreams() const { return m_workers.size() + 1; }
+    bool isRunning() const { return m_workers.size() != 0; }
+    void run(unsigned int nbStreams, const Job& job); //!< Run job on streams 0 to nbStreams-1 and wait for completion
+
+private:
+    class Worker : public QThread
+    {
+    public:
+        Worker(StreamWorkers *parent, unsigned int streamIndex);
+    private:
+        StreamWorkers *m_parent;
+        unsigned int m_streamIndex;
+        void run();
+    };
+
+    std::vector<Worker*> m_workers;
+    QMutex m_mutex;
+    QWaitCondition m_jobReady;
+    QWaitCondition m_jobsDone;
+    const Job *m_job;
+    unsigned int m_nbJobStreams; //!< Number of streams concerned by the current job
+    unsigned int m_generation;   //!< Incremented at each new job
+    unsigned int m_pending;      //!< Number of workers not done with the current job
+    bool m_stopping;
+
+    void workerLoop(unsigned int streamIndex);
+};
+
+#endif // SDRBASE_DSP_STREAMWORKERS_H_
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dsp/ctcssdetector.h"
+#include "util/messagequeue.h"
+
+#include "tonescanner.h"
+
+MESSAGE_CLASS_DEFINITION(ToneScanner::MsgReportTone, Message)
+
+ToneScanner::ToneScanner() :
+    m_ctcssAboveAvg(2.0),
+    m_messageQueue(nullptr)
+{}
+
+const Real *ToneScanner::CTCSSTones()
+{
+    return CTCSSDetector::m_standardTones;
+}
+
+void ToneScanner::configure(unsigned int nbChannels, int sampleRate)
+{
+    qDebug("ToneScanner::configure: %u channels sample rate: %d", nbChannels, sampleRate);
+    std::vector<Real> tones(CTCSSDetector::m_standardTones, CTCSSDetector::m_standardTones + CTCSSDetector::m_nbStandardTones);
+    m_bank.configure(nbChannels, tones, sampleRate, sampleRate); // 1s to separate close tones (67.0/69.3 Hz)
+    m_channels.resize(nbChannels);
+
+    for (std::vector<Channel>::iterator it = m_channels.begin(); it != m_channels.end(); ++it)
+    {
+        it->m_ctcssIndex = -1;
+        it->m_dcs.setSampleRate(sampleRate);
+    }
+}
+
+void ToneScanner::reset()
+{
+    m_bank.reset();
+
+    for (std::vector<Channel>::iterator it = m_channels.begin(); it != m_channels.end(); ++it)
+    {
+        it->m_ctcssIndex = -1;
+        it->m_dcs.reset();
+    }
+}
+
+void ToneScanner::feed(const float * const *channelSamples, unsigned int n)
+{
+    bool ctcssDone = m_bank.feed(channelSamples, n) > 0;
+
+    for (unsigned int channel = 0; channel < m_channels.size(); channel++)
+    {
+        Channel& ch = m_channels[channel];
+        bool changed = ch.m_dcs.analyze(channelSamples[channel], n);
+
+        if (ctcssDone)
+        {
+            int maxPowerIndex;
+            Real maxPower;
+            int ctcssIndex = CTCSSDetector::evaluatePower(m_bank.getPowers(channel), CTCSSDetector::m_nbStandardTones,
+                m_ctcssAboveAvg, maxPowerIndex, maxPower) ? maxPowerIndex : -1;
+
+            if (ctcssIndex != ch.m_ctcssIndex)
+            {
+                ch.m_ctcssIndex = ctcssIndex;
+                changed = true;
+            }
+        }
+
+        if (changed) {
+            report(channel);
+        }
+    }
+}
+
+void ToneScanner::report(unsigned int channel)
+{
+    if (!m_messageQueue) {
+        return;
+    }
+
+    unsigned int code;
+    bool inverted;
+    bool dcsDetected = m_channels[channel].m_dcs.getDetectedCode(code, inverted);
+    m_messageQueue->push(MsgReportTone::create(channel, m_channels[channel].m_ctcssIndex, dcsDetected, code, inverted));
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_TONESCANNER_H_
+#define SDRBASE_DSP_TONESCANNER_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "dsp/goertzelbank.h"
+#include "dsp/dcsdetector.h"
+#include "util/message.h"
+#include "export.h"
+
+class MessageQueue;
+
+/**
+ * CTCSS and DCS scanner over many channels at once.
+ *
+ * Channels give their tone audio (low passed below 300 Hz at a low sample rate, ex: 6 kS/s)
+ * in lockstep blocks. The 50 standard CTCSS tones of all channels are analyzed by a single
+ * vectorized Goertzel bank and each channel has its DCS detector. A MsgReportTone is posted
+ * to the message queue whenever the CTCSS tone or the DCS code of a channel changes so that
+ * the processing thread never waits for the consumer.
+ */
+class SDRBASE_API ToneScanner
+{
+public:
+    class SDRBASE_API MsgReportTone : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        unsigned int getChannel() const { return m_channel; }
+        int getCTCSSIndex() const { return m_ctcssIndex; } //!< -1 if none
+        Real getCTCSSFrequency() const { return m_ctcssIndex < 0 ? 0 : CTCSSTones()[m_ctcssIndex]; }
+        bool getDCSDetected() const { return m_dcsDetected; }
+        unsigned int getDCSCode() const { return m_dcsCode; }
+        bool getDCSInverted() const { return m_dcsInverted; }
+
+        static MsgReportTone* create(unsigned int channel, int ctcssIndex, bool dcsDetected, unsigned int dcsCode, bool dcsInverted) {
+            return new MsgReportTone(channel, ctcssIndex, dcsDetected, dcsCode, dcsInverted);
+        }
+
+    private:
+        unsigned int m_channel;
+        int m_ctcssIndex;
+        bool m_dcsDetected;
+        unsigned int m_dcsCode;
+        bool m_dcsInverted;
+
+        MsgReportTone(unsigned int channel, int ctcssIndex, bool dcsDetected, unsigned int dcsCode, bool dcsInverted) :
+            Message(),
+            m_channel(channel),
+            m_ctcssIndex(ctcssIndex),
+            m_dcsDetected(dcsDetected),
+            m_dcsCode(dcsCode),
+            m_dcsInverted(dcsInverted)
+        { }
+    };
+
+    ToneScanner();
+
+    /** Set the number of channels and the sample rate of their tone audio. Window is 1s (1 Hz resolution) */
+    void configure(unsigned int nbChannels, int sampleRate);
+    void setMessageQueue(MessageQueue *messageQueue) { m_messageQueue = messageQueue; }
+    void setCTCSSThreshold(Real aboveAvg) { m_ctcssAboveAvg = aboveAvg; } //!< Max power above average power
+    void reset();
+
+    /** Feed n samples of each channel. channelSamples[c] points to the n samples of channel c */
+    void feed(const float * const *channelSamples, unsigned int n);
+
+    unsigned int getNbChannels() const { return m_channels.size(); }
+    int getCTCSSIndex(unsigned int channel) const { return m_channels[channel].m_ctcssIndex; } //!< -1 if none
+    bool getDCSCode(unsigned int channel, unsigned int& code, bool& inverted) const
+    {
+        return m_channels[channel].m_dcs.getDetectedCode(code, inverted);
+    }
+
+    static const Real *CTCSSTones(); //!< The CTCSSDetector standard tones
+
+private:
+    struct Channel
+    {
+        Channel() : m_ctcssIndex(-1) {}
+        int m_ctcssIndex;
+        DCSDetector m_dcs;
+    };
+
+    std::vector<Channel> m_channels;
+    GoertzelBank m_bank;
+    Real m_ctcssAboveAvg;
+    MessageQueue *m_messageQueue;
+
+    void report(unsigned int channel);
+};
+
+#endif // SDRBASE_DSP_TONESCANNER_H_
@@ -101,16 +101,34 @@ void UpChannelizer::pull(SampleVector::iterator begin, unsigned int nbSamples)
     }
     else
     {
-        std::for_each(
-            begin,
-            begin + nbSamples,
-            [this](Sample& s) {
-                pullOne(s);
-            }
-        );
+        pullStage(0, &(*begin), nbSamples);
     }
 }
 
+void UpChannelizer::pullStage(unsigned int stageIndex, Sample *sOut, unsigned int nbOut)
+{
+    FilterStage *stage = m_filterStages[stageIndex];
+    SampleVector& stageBuffer = m_stageBuffers[stageIndex];
+    unsigned int nbIn = stage->nbInputs(nbOut);
+    bool lastStage = stageIndex == m_filterStages.size() - 1;
+
+    if (stageBuffer.size() < nbIn) {
+        stageBuffer.resize(nbIn);
+    }
+
+    // stages are independent so the lower rate stages can be run first on the whole block
+    if (nbIn != 0)
+    {
+        if (lastStage) {
+            m_sampleSource->pull(stageBuffer.begin(), nbIn);
+        } else {
+            pullStage(stageIndex + 1, stageBuffer.data(), nbIn);
+        }
+    }
+
+    stage->workBlock(lastStage ? m_sampleIn : m_stageSamples[stageIndex + 1], stageBuffer.data(), sOut, nbOut);
+}
+
 void UpChannelizer::prefetch(unsigned int nbSamples)
 {
     unsigned int log2Interp = m_filterStages.size();
@@ -156,6 +174,7 @@ void UpChannelizer::applyChannelization()
         m_requestedCenterFrequency - m_requestedInputSampleRate / 2, m_requestedCenterFrequency + m_requestedInputSampleRate / 2);
 
     m_channelSampleRate = m_basebandSampleRate / (1 << m_filterStages.size());
+    m_stageBuffers.resize(m_filterStages.size());
 
     qDebug() << "UpChannelizer::applyConfiguration: done: "
             << " out:" << m_basebandSampleRate
@@ -183,6 +202,7 @@ void UpChannelizer::applyInterpolation()
     m_channelFrequencyOffset = m_basebandSampleRate * setFilterChain(stageIndexes);
     m_channelSampleRate = m_basebandSampleRate / (1 << m_filterStages.size());
     m_requestedInputSampleRate = m_channelSampleRate;
+    m_stageBuffers.resize(m_filterStages.size());
 
 	qDebug() << "UpChannelizer::applyInterpolation:"
             << " m_log2Interp:" << m_log2Interp
@@ -195,7 +215,9 @@ void UpChannelizer::applyInterpolation()
 #ifdef USE_SSE4_1
 UpChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0)
+    m_workFunction(0),
+    m_mode(mode),
+    m_nextConsumes(false)
 {
     switch(mode) {
         case ModeCenter:
@@ -214,7 +236,9 @@ UpChannelizer::FilterStage::FilterStage(Mode mode) :
 #else
 UpChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0)
+    m_workFunction(0),
+    m_mode(mode),
+    m_nextConsumes(false)
 {
     switch(mode) {
         case ModeCenter:
@@ -237,6 +261,46 @@ UpChannelizer::FilterStage::~FilterStage()
     delete m_filter;
 }
 
+void UpChannelizer::FilterStage::workBlock(Sample& pending, const Sample *sIn, Sample *sOut, unsigned int nbOut)
+{
+    if (nbOut == 0) {
+        return;
+    }
+
+    bool consumed = false;
+
+    // the mode is resolved once per block so that the filter work is inlined in the loop
+    switch (m_mode)
+    {
+    case ModeCenter:
+        for (unsigned int i = 0; i < nbOut; i++)
+        {
+            if ((consumed = m_filter->workInterpolateCenter(&pending, &sOut[i]))) {
+                pending = *sIn++;
+            }
+        }
+        break;
+    case ModeLowerHalf:
+        for (unsigned int i = 0; i < nbOut; i++)
+        {
+            if ((consumed = m_filter->workInterpolateLowerHalf(&pending, &sOut[i]))) {
+                pending = *sIn++;
+            }
+        }
+        break;
+    case ModeUpperHalf:
+        for (unsigned int i = 0; i < nbOut; i++)
+        {
+            if ((consumed = m_filter->workInterpolateUpperHalf(&pending, &sOut[i]))) {
+                pending = *sIn++;
+            }
+        }
+        break;
+    }
+
+    m_nextConsumes = !consumed;
+}
+
 bool UpChannelizer::signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const
 {
     //qDebug("   testing signal [%f, %f], channel [%f, %f]", sigStart, sigEnd, chanStart, chanEnd);
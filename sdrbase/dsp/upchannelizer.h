@@ -66,19 +66,37 @@ protected:
         IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #endif
         WorkFunction m_workFunction;
+        Mode m_mode;
+        bool m_nextConsumes; //!< next work call will consume an input sample
 
         FilterStage(Mode mode);
         ~FilterStage();
 
-        bool work(Sample* sampleIn, Sample *sampleOut) {
-            return (m_filter->*m_workFunction)(sampleIn, sampleOut);
+        bool work(Sample* sampleIn, Sample *sampleOut)
+        {
+            bool consumed = (m_filter->*m_workFunction)(sampleIn, sampleOut);
+            m_nextConsumes = !consumed;
+            return consumed;
         }
+
+        /** Number of input samples consumed to produce nbOut output samples */
+        unsigned int nbInputs(unsigned int nbOut) const {
+            return (nbOut + (m_nextConsumes ? 1 : 0)) / 2;
+        }
+
+        /**
+         * Interpolate a block. pending is the input sample that will be consumed first (as in
+         * the sample by sample chain). It is replaced by the successive samples of sIn that must
+         * hold nbInputs(nbOut) samples.
+         */
+        void workBlock(Sample& pending, const Sample *sIn, Sample *sOut, unsigned int nbOut);
     };
 
     typedef std::vector<FilterStage*> FilterStages;
     FilterStages m_filterStages;
     bool m_filterChainSetMode;
     std::vector<Sample> m_stageSamples;
+    std::vector<SampleVector> m_stageBuffers; //!< Input buffers of each stage in block mode
     ChannelSampleSource* m_sampleSource; //!< Modulator
     int m_basebandSampleRate;
     int m_requestedInputSampleRate;
@@ -90,6 +108,7 @@ protected:
     SampleVector m_sampleBuffer;
     Sample m_sampleIn;
 
+    void pullStage(unsigned int stageIndex, Sample *sOut, unsigned int nbOut);
     void applyChannelization();
     void applyInterpolation();
     bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QMutexLocker>
+#include <QDebug>
+
+#include "videoframebuffer.h"
+
+VideoFrameBuffer::VideoFrameBuffer() :
+    m_backIndex(0),
+    m_latest(1),
+    m_readIndex(2),
+    m_width(0),
+    m_height(0),
+    m_pixelFormat(PixelGray8),
+    m_frameCount(0)
+{}
+
+VideoFrameBuffer::~VideoFrameBuffer()
+{}
+
+void VideoFrameBuffer::resize(int width, int height, PixelFormat pixelFormat)
+{
+    if ((width == m_width) && (height == m_height) && (pixelFormat == m_pixelFormat)) {
+        return;
+    }
+
+    qDebug("VideoFrameBuffer::resize: %dx%d format: %d", width, height, (int) pixelFormat);
+    m_width = width < 0 ? 0 : width;
+    m_height = height < 0 ? 0 : height;
+    m_pixelFormat = pixelFormat;
+    prepareBackFrame();
+}
+
+uint8_t *VideoFrameBuffer::getBackRow(int row)
+{
+    if ((row < 0) || (row >= m_height)) {
+        return nullptr;
+    }
+
+    Frame& back = m_frames[m_backIndex];
+    return &back.m_data[row * back.m_width * back.getBytesPerPixel()];
+}
+
+void VideoFrameBuffer::swap(bool keyFrame)
+{
+    Frame& back = m_frames[m_backIndex];
+    back.m_keyFrame = keyFrame;
+    back.m_index = ++m_frameCount;
+    // the previous latest frame (possibly just released by a reader) becomes the frame to write
+    int previous = m_latest.fetchAndStoreOrdered(m_backIndex | m_freshFlag);
+    m_backIndex = previous & ~m_freshFlag;
+    prepareBackFrame();
+}
+
+bool VideoFrameBuffer::getFrame(Frame& frame, quint64 since)
+{
+    QMutexLocker mutexLocker(&m_readMutex);
+
+    if (m_latest.loadAcquire() & m_freshFlag)
+    {
+        int latest = m_latest.fetchAndStoreOrdered(m_readIndex);
+        m_readIndex = latest & ~m_freshFlag;
+    }
+
+    const Frame& readFrame = m_frames[m_readIndex];
+
+    if ((readFrame.m_index == 0) || (readFrame.m_index <= since)) {
+        return false;
+    }
+
+    frame = readFrame;
+    return true;
+}
+
+void VideoFrameBuffer::prepareBackFrame()
+{
+    Frame& back = m_frames[m_backIndex];
+
+    if ((back.m_width != m_width) || (back.m_height != m_height) || (back.m_pixelFormat != m_pixelFormat))
+    {
+        back.m_width = m_width;
+        back.m_height = m_height;
+        back.m_pixelFormat = m_pixelFormat;
+        back.m_data.assign(m_width * m_height * back.getBytesPerPixel(), 0);
+    }
+}
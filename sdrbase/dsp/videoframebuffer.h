@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_VIDEOFRAMEBUFFER_H_
+#define SDRBASE_DSP_VIDEOFRAMEBUFFER_H_
+
+#include <vector>
+#include <stdint.h>
+
+#include <QAtomicInt>
+#include <QMutex>
+
+#include "export.h"
+
+/**
+ * Latest video frame slot between a demodulator (producer) and any number of readers (GUI, API).
+ * This is a triple buffer: the producer writes whole rows in its own frame and publishes it with
+ * swap() by exchanging it atomically with the latest frame slot so it never waits for readers.
+ * Readers copy the latest published frame whole with getFrame() so they never see a partially
+ * written image. Readers are serialized among themselves only.
+ */
+class SDRBASE_API VideoFrameBuffer
+{
+public:
+    enum PixelFormat
+    {
+        PixelGray8, //!< 1 byte per pixel luma
+        PixelRGB24  //!< 3 bytes per pixel R, G, B
+    };
+
+    struct Frame
+    {
+        int m_width;
+        int m_height;
+        PixelFormat m_pixelFormat;
+        bool m_keyFrame;             //!< Frame is a key frame of a compressed stream (always true for analog video)
+        quint64 m_index;             //!< Frame number since start. Starts at 1.
+        std::vector<uint8_t> m_data; //!< Rows of m_width pixels
+
+        Frame() :
+            m_width(0),
+            m_height(0),
+            m_pixelFormat(PixelGray8),
+            m_keyFrame(true),
+            m_index(0)
+        {}
+
+        int getBytesPerPixel() const { return m_pixelFormat == PixelRGB24 ? 3 : 1; }
+    };
+
+    VideoFrameBuffer();
+    ~VideoFrameBuffer();
+
+    // producer side
+    void resize(int width, int height, PixelFormat pixelFormat = PixelGray8); //!< Size of the frames to come
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    uint8_t *getBackRow(int row);    //!< Row of the frame being written or nullptr if out of range
+    void swap(bool keyFrame = true); //!< Publish the frame being written as the latest frame
+
+    // reader side
+    bool getFrame(Frame& frame, quint64 since = 0); //!< Copy of the latest frame if its number is above since
+
+private:
+    static const int m_freshFlag = 4; //!< Set in m_latest when the latest frame was not taken by a reader yet
+    Frame m_frames[3];
+    int m_backIndex;     //!< Frame being written (producer)
+    QAtomicInt m_latest; //!< Latest published frame index and fresh flag
+    int m_readIndex;     //!< Frame owned by the readers
+    QMutex m_readMutex;  //!< Serializes readers only
+    int m_width;
+    int m_height;
+    PixelFormat m_pixelFormat;
+    quint64 m_frameCount;
+
+    void prepareBackFrame();
+};
+
+#endif // SDRBASE_DSP_VIDEOFRAMEBUFFER_H_
@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QImage>
+#include <QBuffer>
+
+#include "videoframeencoder.h"
+
+bool VideoFrameEncoder::getFormat(const QString& formatStr, Format& format)
+{
+    if ((formatStr == "jpeg") || (formatStr == "jpg"))
+    {
+        format = FormatJPEG;
+        return true;
+    }
+    else if (formatStr == "raw")
+    {
+        format = FormatRaw;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool VideoFrameEncoder::encode(
+    const VideoFrameBuffer::Frame& frame,
+    Format format,
+    int scale,
+    int quality,
+    QByteArray& data,
+    QString& mimeType)
+{
+    int width, height;
+    std::vector<uint8_t> pixels;
+    reduce(frame, scale, width, height, pixels);
+    int bytesPerPixel = frame.getBytesPerPixel();
+
+    if ((width == 0) || (height == 0)) {
+        return false;
+    }
+
+    if (format == FormatRaw)
+    {
+        data = QString("P%1\n%2 %3\n255\n")
+            .arg(frame.m_pixelFormat == VideoFrameBuffer::PixelRGB24 ? 6 : 5)
+            .arg(width)
+            .arg(height)
+            .toLatin1();
+        data.append((const char *) pixels.data(), pixels.size());
+        mimeType = frame.m_pixelFormat == VideoFrameBuffer::PixelRGB24 ? "image/x-portable-pixmap" : "image/x-portable-graymap";
+        return true;
+    }
+    else
+    {
+        QImage image(
+            pixels.data(),
+            width,
+            height,
+            width * bytesPerPixel,
+            frame.m_pixelFormat == VideoFrameBuffer::PixelRGB24 ? QImage::Format_RGB888 : QImage::Format_Grayscale8
+        );
+        data.clear();
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        mimeType = "image/jpeg";
+        return image.save(&buffer, "JPG", quality);
+    }
+}
+
+int VideoFrameEncoder::webapiFrameGet(
+    VideoFrameBuffer& videoFrameBuffer,
+    const QString& formatStr,
+    int scale,
+    int quality,
+    quint64 since,
+    QByteArray& data,
+    QString& mimeType,
+    quint64& frameIndex,
+    QString& errorMessage)
+{
+    Format format;
+
+    if (!getFormat(formatStr, format))
+    {
+        errorMessage = QString("Unknown frame format %1").arg(formatStr);
+        return 400;
+    }
+
+    if ((scale < 1) || (scale > 16))
+    {
+        errorMessage = QString("Scale %1 out of range 1 to 16").arg(scale);
+        return 400;
+    }
+
+    VideoFrameBuffer::Frame frame;
+
+    if (!videoFrameBuffer.getFrame(frame, since)) // no new frame
+    {
+        frameIndex = since;
+        return 204;
+    }
+
+    frameIndex = frame.m_index;
+
+    if (!encode(frame, format, scale, quality < 0 ? 0 : quality > 100 ? 100 : quality, data, mimeType))
+    {
+        errorMessage = QString("Cannot encode frame %1").arg(frame.m_index);
+        return 500;
+    }
+
+    return 200;
+}
+
+void VideoFrameEncoder::reduce(const VideoFrameBuffer::Frame& frame, int scale, int& width, int& height, std::vector<uint8_t>& pixels)
+{
+    int bytesPerPixel = frame.getBytesPerPixel();
+
+    if (scale <= 1)
+    {
+        width = frame.m_width;
+        height = frame.m_height;
+        pixels = frame.m_data;
+        return;
+    }
+
+    width = frame.m_width / scale;
+    height = frame.m_height / scale;
+    pixels.resize(width * height * bytesPerPixel);
+    int srcRowSize = frame.m_width * bytesPerPixel;
+    int area = scale * scale;
+    std::vector<unsigned int> sums(width * bytesPerPixel);
+
+    for (int row = 0; row < height; row++)
+    {
+        std::fill(sums.begin(), sums.end(), 0);
+
+        for (int srcRow = row * scale; srcRow < (row + 1) * scale; srcRow++)
+        {
+            const uint8_t *src = &frame.m_data[srcRow * srcRowSize];
+
+            for (int col = 0; col < width; col++)
+            {
+                for (int k = 0; k < scale * bytesPerPixel; k++) {
+                    sums[col * bytesPerPixel + (k % bytesPerPixel)] += src[col * scale * bytesPerPixel + k];
+                }
+            }
+        }
+
+        uint8_t *dst = &pixels[row * width * bytesPerPixel];
+
+        for (int i = 0; i < width * bytesPerPixel; i++) {
+            dst[i] = sums[i] / area;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_VIDEOFRAMEENCODER_H_
+#define SDRBASE_DSP_VIDEOFRAMEENCODER_H_
+
+#include <QByteArray>
+#include <QString>
+
+#include "dsp/videoframebuffer.h"
+#include "export.h"
+
+/**
+ * Encodes the video frames of a VideoFrameBuffer for export (API). Encoding is done on the reader
+ * side only when a frame is requested so that its cost follows the rate of the readers.
+ */
+class SDRBASE_API VideoFrameEncoder
+{
+public:
+    enum Format
+    {
+        FormatJPEG, //!< JPEG image
+        FormatRaw   //!< Binary PGM (gray) or PPM (RGB) image that is the raw pixels with a short header
+    };
+
+    static bool getFormat(const QString& formatStr, Format& format); //!< "jpeg" or "raw"
+
+    /**
+     * Encode the frame in data with its size reduced by scale (1 for full size).
+     * Pixels are averaged over scale x scale squares. Quality is the JPEG quality (0 to 100).
+     */
+    static bool encode(
+        const VideoFrameBuffer::Frame& frame,
+        Format format,
+        int scale,
+        int quality,
+        QByteArray& data,
+        QString& mimeType
+    );
+
+    /**
+     * Implementation of the channels video frame API from the latest frame of a VideoFrameBuffer.
+     * Returns the HTTP status: 200 with a frame, 204 when there is no frame newer than since.
+     */
+    static int webapiFrameGet(
+        VideoFrameBuffer& videoFrameBuffer,
+        const QString& formatStr,
+        int scale,
+        int quality,
+        quint64 since,
+        QByteArray& data,
+        QString& mimeType,
+        quint64& frameIndex,
+        QString& errorMessage
+    );
+
+private:
+    static void reduce(const VideoFrameBuffer::Frame& frame, int scale, int& width, int& height, std::vector<uint8_t>& pixels);
+};
+
+#endif // SDRBASE_DSP_VIDEOFRAMEENCODER_H_
@@ -18,6 +18,7 @@
 
 #include <QCommandLineOption>
 #include <QRegExpValidator>
+#include <QThread>
 #include <QDebug>
 
 #include "mainparser.h"
@@ -34,12 +35,35 @@ MainParser::MainParser() :
     m_fftwfWisdomOption(QStringList() << "w" << "fftwf-wisdom",
         "FFTW Wisdom file.",
         "file",
-        "")
+        ""),
+    m_batchFileOption(QStringList() << "batch-file",
+        "Process this .sdriq file offline with the batch preset then exit (server only).",
+        "file",
+        ""),
+    m_batchPresetOption(QStringList() << "batch-preset",
+        "Rx preset used in batch mode given as group:description or description.",
+        "preset",
+        ""),
+    m_batchWorkersOption(QStringList() << "batch-workers",
+        "Number of file segments processed in parallel in batch mode. Defaults to the number of cores.",
+        "workers",
+        "0"),
+    m_batchOverlapOption(QStringList() << "batch-overlap",
+        "Overlap in milliseconds between segments in batch mode.",
+        "ms",
+        "500"),
+    m_batchOutputOption(QStringList() << "batch-output",
+        "Directory where batch mode outputs are written.",
+        "directory",
+        ".")
 {
     m_serverAddress = "127.0.0.1";
     m_serverPort = 8091;
     m_mimoSupport = false;
     m_fftwfWindowFileName = "";
+    m_batchWorkers = QThread::idealThreadCount();
+    m_batchOverlapMs = 500;
+    m_batchOutputDir = ".";
 
     m_parser.setApplicationDescription("Software Defined Radio application");
     m_parser.addHelpOption();
@@ -48,6 +72,11 @@ MainParser::MainParser() :
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
     m_parser.addOption(m_fftwfWisdomOption);
+    m_parser.addOption(m_batchFileOption);
+    m_parser.addOption(m_batchPresetOption);
+    m_parser.addOption(m_batchWorkersOption);
+    m_parser.addOption(m_batchOverlapOption);
+    m_parser.addOption(m_batchOutputOption);
 }
 
 MainParser::~MainParser()
@@ -92,6 +121,26 @@ void MainParser::parse(const QCoreApplication& app)
 
     m_fftwfWindowFileName = m_parser.value(m_fftwfWisdomOption);
 
+    // batch mode
+
+    m_batchFileName = m_parser.value(m_batchFileOption);
+    m_batchPreset = m_parser.value(m_batchPresetOption);
+    m_batchOutputDir = m_parser.value(m_batchOutputOption);
+
+    int batchWorkers = m_parser.value(m_batchWorkersOption).toInt(&ok);
+
+    if (ok && (batchWorkers > 0)) {
+        m_batchWorkers = batchWorkers;
+    }
+
+    int batchOverlapMs = m_parser.value(m_batchOverlapOption).toInt(&ok);
+
+    if (ok && (batchOverlapMs >= 0)) {
+        m_batchOverlapMs = batchOverlapMs;
+    } else {
+        qWarning() << "MainParser::parse: batch overlap invalid. Defaulting to " << m_batchOverlapMs;
+    }
+
     // MIMO - from version
 
     QStringList versionParts = app.applicationVersion().split(".");
@@ -36,17 +36,33 @@ public:
     uint16_t getServerPort() const { return m_serverPort; }
     bool getMIMOSupport() const { return m_mimoSupport; }
     const QString& getFFTWFWisdomFileName() const { return m_fftwfWindowFileName; }
+    const QString& getBatchFileName() const { return m_batchFileName; }
+    const QString& getBatchPreset() const { return m_batchPreset; }
+    int getBatchWorkers() const { return m_batchWorkers; }
+    int getBatchOverlapMs() const { return m_batchOverlapMs; }
+    const QString& getBatchOutputDir() const { return m_batchOutputDir; }
+    bool isBatchMode() const { return !m_batchFileName.isEmpty(); }
 
 private:
     QString  m_serverAddress;
     uint16_t m_serverPort;
     QString  m_fftwfWindowFileName;
     bool m_mimoSupport; //!< obtained from major version
+    QString  m_batchFileName;  //!< .sdriq file to process offline (server only)
+    QString  m_batchPreset;    //!< Rx preset applied to the offline file
+    int      m_batchWorkers;   //!< number of segments processed in parallel
+    int      m_batchOverlapMs; //!< overlap between segments in milliseconds
+    QString  m_batchOutputDir; //!< directory where outputs are stitched
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
     QCommandLineOption m_fftwfWisdomOption;
+    QCommandLineOption m_batchFileOption;
+    QCommandLineOption m_batchPresetOption;
+    QCommandLineOption m_batchWorkersOption;
+    QCommandLineOption m_batchOverlapOption;
+    QCommandLineOption m_batchOutputOption;
 };
 
 
@@ -16,10 +16,12 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#ifndef PLUGINS_CHANNEL_BFM_RDSDECODER_H_
-#define PLUGINS_CHANNEL_BFM_RDSDECODER_H_
+#ifndef SDRBASE_RDS_RDSDECODER_H_
+#define SDRBASE_RDS_RDSDECODER_H_
 
-class RDSDecoder
+#include "export.h"
+
+class SDRBASE_API RDSDecoder
 {
 public:
 	RDSDecoder();
@@ -61,4 +63,4 @@ private:
 
 
 
-#endif /* PLUGINS_CHANNEL_BFM_RDSDECODER_H_ */
+#endif /* SDRBASE_RDS_RDSDECODER_H_ */
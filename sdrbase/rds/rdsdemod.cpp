@@ -16,7 +16,7 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include "../../channelrx/demodbfm/rdsdemod.h"
+#include "rdsdemod.h"
 
 #include <QDebug>
 #include <math.h>
@@ -34,7 +34,7 @@ const Real RDSDemod::m_fsc = 1187.5;
 RDSDemod::RDSDemod()
 	// : m_udpDebug(this, 1472, 9995) // UDP debug
 {
-	m_srate = 250000;
+	setSampleRate(250000);
 
 	m_parms.subcarr_phi = 0;
 	memset(m_parms.subcarr_bb, 0, sizeof(m_parms.subcarr_bb));
@@ -67,9 +67,19 @@ RDSDemod::~RDSDemod()
 	//delete m_socket;
 }
 
-void RDSDemod::setSampleRate(int srate) /// FIXME: fix rate for now
+void RDSDemod::setSampleRate(Real srate)
 {
-    (void) srate;
+    m_srate = srate;
+    m_decimation = (int) (srate / 31250.0 + 0.5);
+    m_decimation = m_decimation < 1 ? 1 : m_decimation;
+
+    // 2nd order Butterworth low pass at 1.2 kHz (bilinear transform)
+    // At 250 kS/s these are the values given by mkfilter: 4.491730007e+03, -0.9582451124, 1.9573545869
+    double k = std::tan(M_PI * 1200.0 / srate);
+    double norm = 1.0 + std::sqrt(2.0) * k + k * k;
+    m_lpGain = norm / (k * k);
+    m_lpC0 = (1.0 - std::sqrt(2.0) * k + k * k) / norm;
+    m_lpC1 = 2.0 * (1.0 - k * k) / norm;
 }
 
 bool RDSDemod::process(Real demod, bool& bit)
@@ -113,7 +123,7 @@ bool RDSDemod::process(Real demod, bool& bit)
 	m_parms.lo_clock = (m_parms.clock_phi < M_PI ? 1 : -1);
 
 	/* Decimate band-limited signal */
-	if (m_parms.numsamples % 8 == 0)
+	if (m_parms.numsamples % m_decimation == 0)
 	{
 		/* biphase symbol integrate & dump */
 		m_parms.acc += m_parms.subcarr_bb[0] * m_parms.lo_clock;
@@ -187,13 +197,14 @@ Real RDSDemod::filter_lp_2400_iq(Real input, int iqIndex)
 {
 	/* Digital filter designed by mkfilter/mkshape/gencode A.J. Fisher
 	 Command line: /www/usr/fisher/helpers/mkfilter -Bu -Lp -o 10
-	 -a 4.8000000000e-03 0.0000000000e+00 -l */
+	 -a 4.8000000000e-03 0.0000000000e+00 -l
+	 Coefficients are now computed for the actual sample rate in setSampleRate */
 
 	m_xv[iqIndex][0] = m_xv[iqIndex][1]; m_xv[iqIndex][1] = m_xv[iqIndex][2];
-	m_xv[iqIndex][2] = input / 4.491730007e+03;
+	m_xv[iqIndex][2] = input / m_lpGain;
 	m_yv[iqIndex][0] = m_yv[iqIndex][1]; m_yv[iqIndex][1] = m_yv[iqIndex][2];
 	m_yv[iqIndex][2] =   (m_xv[iqIndex][0] + m_xv[iqIndex][2]) + 2 * m_xv[iqIndex][1]
-	+ ( -0.9582451124 * m_yv[iqIndex][0]) + (  1.9573545869 * m_yv[iqIndex][1]);
+	+ ( -m_lpC0 * m_yv[iqIndex][0]) + (  m_lpC1 * m_yv[iqIndex][1]);
 
 	return m_yv[iqIndex][2];
 }
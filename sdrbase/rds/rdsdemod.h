@@ -17,22 +17,23 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 
-#ifndef PLUGINS_CHANNEL_BFM_RDSDEMOD_H_
-#define PLUGINS_CHANNEL_BFM_RDSDEMOD_H_
+#ifndef SDRBASE_RDS_RDSDEMOD_H_
+#define SDRBASE_RDS_RDSDEMOD_H_
 
 #include <QObject>
 //#include "util/udpsink.h" // UDP debug
 
 #include "dsp/dsptypes.h"
+#include "export.h"
 
-class RDSDemod : public QObject
+class SDRBASE_API RDSDemod : public QObject
 {
     Q_OBJECT
 public:
 	RDSDemod();
 	~RDSDemod();
 
-	void setSampleRate(int srate);
+	void setSampleRate(Real srate);
 	bool process(Real rdsSample, bool &bit);
 
 	struct{
@@ -74,10 +75,14 @@ private:
 	Real m_yw[1+1];
 	Real m_prev;
 
-	int m_srate;
+	Real m_srate;
+	int m_decimation;  //!< Integrate and dump decimation (to stay near 31.25 kS/s)
+	Real m_lpGain;     //!< 1.2 kHz low pass input gain
+	Real m_lpC0;       //!< 1.2 kHz low pass y[n-2] coefficient
+	Real m_lpC1;       //!< 1.2 kHz low pass y[n-1] coefficient
 
 	static const Real m_pllBeta;
 	static const Real m_fsc;
 };
 
-#endif /* PLUGINS_CHANNEL_BFM_RDSDEMOD_H_ */
+#endif /* SDRBASE_RDS_RDSDEMOD_H_ */
@@ -368,6 +368,10 @@ void RDSParser::clearAllFields()
 	// Group 15
 	m_g15_count = 0;
 
+	vhf_or_lfmf = false;
+	no_groups = 0;
+	std::memset(free_format, 0, sizeof(free_format));
+
 	clearUpdateFlags();
 }
 
@@ -587,7 +591,6 @@ void RDSParser::decode_type0(unsigned int *group, bool B)
 
 double RDSParser::decode_af(unsigned int af_code)
 {
-	static bool vhf_or_lfmf             = 0; // 0 = vhf, 1 = lf/mf
 	double alt_frequency                = 0; // in kHz
 
 	if ((af_code == 0) ||                          // not to be used
@@ -865,9 +868,6 @@ void RDSParser::decode_type8(unsigned int *group, bool B)
 	bool D = (group[2] >> 15) & 0x1; // 1 = diversion recommended
 	m_g8_diversion_recommended = D;
 
-	static unsigned long int free_format[4];
-	static int no_groups = 0;
-
 	if (T)
 	{ // tuning info
 		qDebug() << "RDSParser::decode_type8: #tuning info# ";
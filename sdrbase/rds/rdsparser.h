@@ -16,14 +16,16 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#ifndef PLUGINS_CHANNEL_BFM_RDSPARSER_H_
-#define PLUGINS_CHANNEL_BFM_RDSPARSER_H_
+#ifndef SDRBASE_RDS_RDSPARSER_H_
+#define SDRBASE_RDS_RDSPARSER_H_
 
 #include <string>
 #include <set>
 #include <map>
 
-class RDSParser
+#include "export.h"
+
+class SDRBASE_API RDSParser
 {
 public:
 	typedef std::map<unsigned int, std::string> psns_map_t;
@@ -194,6 +196,9 @@ private:
 	unsigned char  pi_program_reference_number;
 
 	bool           radiotext_AB_flag;
+	bool           vhf_or_lfmf;      //!< AF decoding: false = vhf, true = lf/mf
+	unsigned long int free_format[4]; //!< TMC multi-group message being assembled
+	int            no_groups;
 	bool           debug;
 	bool           log;
 
@@ -201,4 +206,4 @@ private:
 
 
 
-#endif /* PLUGINS_CHANNEL_BFM_RDSPARSER_H_ */
+#endif /* SDRBASE_RDS_RDSPARSER_H_ */
@@ -0,0 +1,297 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDateTime>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QGlobalStatic>
+
+#include "rdsparser.h"
+#include "rdstmc.h"
+#include "rdsstationdb.h"
+
+Q_GLOBAL_STATIC(RDSStationDB, rdsStationDB)
+RDSStationDB *RDSStationDB::instance()
+{
+    return rdsStationDB;
+}
+
+RDSStationDB::RDSStationDB() :
+    m_serial(0),
+    m_generation(0),
+    m_clearSerial(0)
+{}
+
+RDSStationDB::~RDSStationDB()
+{}
+
+void RDSStationDB::update(qint64 frequency, const RDSParser& parser)
+{
+    unsigned int pi = parser.m_pi_program_identification;
+
+    if (pi == 0) {
+        return;
+    }
+
+    qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QMutexLocker mutexLocker(&m_mutex);
+    std::map<unsigned int, Station>::iterator it = m_stations.find(pi);
+    bool changed = false;
+
+    if (it == m_stations.end())
+    {
+        it = m_stations.insert(std::make_pair(pi, Station())).first;
+        it->second.m_pi = pi;
+        it->second.m_firstSeenMs = nowMs;
+        changed = true;
+    }
+
+    Station& station = it->second;
+    station.m_lastSeenMs = nowMs;
+    station.m_groupCount++;
+
+    if (station.m_frequency != frequency)
+    {
+        std::map<qint64, unsigned int>::iterator fit = m_frequencyIndex.find(station.m_frequency);
+
+        if ((fit != m_frequencyIndex.end()) && (fit->second == pi)) {
+            m_frequencyIndex.erase(fit);
+        }
+
+        station.m_frequency = frequency;
+        changed = true;
+    }
+
+    m_frequencyIndex[frequency] = pi;
+
+    if ((station.m_programType != parser.m_pi_program_type) || (station.m_trafficProgram != parser.m_pi_traffic_program))
+    {
+        station.m_programType = parser.m_pi_program_type;
+        station.m_trafficProgram = parser.m_pi_traffic_program;
+        changed = true;
+    }
+
+    // group fields are taken only if the parser got them since its flags were last cleared
+    // so that a parser that moved to another station does not carry the former station data
+    if (parser.m_g0_updated)
+    {
+        QString psn = QString(parser.m_g0_program_service_name).trimmed();
+
+        if ((parser.m_g0_psn_bitmap == 0xf) && (psn != station.m_programServiceName))
+        {
+            station.m_programServiceName = psn;
+            changed = true;
+        }
+
+        if ((station.m_trafficAnnouncement != parser.m_g0_traffic_announcement) || (station.m_music != parser.m_g0_music_speech))
+        {
+            station.m_trafficAnnouncement = parser.m_g0_traffic_announcement;
+            station.m_music = parser.m_g0_music_speech;
+            changed = true;
+        }
+    }
+
+    if (parser.m_g0_af_updated)
+    {
+        for (std::set<double>::const_iterator afIt = parser.m_g0_alt_freq.begin(); afIt != parser.m_g0_alt_freq.end(); ++afIt)
+        {
+            if ((*afIt > 76.0) && station.m_altFrequencies.insert(*afIt).second) {
+                changed = true;
+            }
+        }
+    }
+
+    if (parser.m_g2_updated)
+    {
+        QString radioText = QString(parser.m_g2_radiotext).trimmed();
+
+        if (radioText != station.m_radioText)
+        {
+            station.m_radioText = radioText;
+            changed = true;
+        }
+    }
+
+    if (parser.m_g8_updated && updateTMC(station, parser, nowMs)) {
+        changed = true;
+    }
+
+    if (changed)
+    {
+        m_serialIndex.erase(station.m_serial);
+        station.m_serial = ++m_serial;
+        m_serialIndex[station.m_serial] = pi;
+    }
+}
+
+bool RDSStationDB::updateTMC(Station& station, const RDSParser& parser, qint64 nowMs)
+{
+    // TMC messages are repeated: a message is identified by its event and location
+    for (std::deque<TMCMessage>::iterator it = station.m_tmcMessages.begin(); it != station.m_tmcMessages.end(); ++it)
+    {
+        if ((it->m_event == parser.m_g8_event) && (it->m_location == parser.m_g8_location))
+        {
+            bool changed = (it->m_extent != parser.m_g8_extent + 1)
+                || (it->m_negative != parser.m_g8_sign)
+                || (it->m_diversion != parser.m_g8_diversion_recommended);
+            it->m_timeMs = nowMs;
+            it->m_extent = parser.m_g8_extent + 1;
+            it->m_negative = parser.m_g8_sign;
+            it->m_diversion = parser.m_g8_diversion_recommended;
+            return changed;
+        }
+    }
+
+    TMCMessage message;
+    message.m_timeMs = nowMs;
+    message.m_event = parser.m_g8_event;
+    message.m_location = parser.m_g8_location;
+    message.m_extent = parser.m_g8_extent + 1;
+    message.m_negative = parser.m_g8_sign;
+    message.m_diversion = parser.m_g8_diversion_recommended;
+    int eventLine = RDSTMC::get_tmc_event_code_index(parser.m_g8_event, 1);
+    message.m_eventText = QString(RDSTMC::get_tmc_events(eventLine, 1).c_str());
+    station.m_tmcMessages.push_back(message);
+
+    if (station.m_tmcMessages.size() > m_maxTMCMessages) {
+        station.m_tmcMessages.pop_front();
+    }
+
+    return true;
+}
+
+void RDSStationDB::clear()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_stations.clear();
+    m_serialIndex.clear();
+    m_frequencyIndex.clear();
+    m_serial++;
+    m_clearSerial = m_serial; // clients polling with a former serial get the whole new content
+    m_generation++;           // and see that they have to drop the former one
+}
+
+quint64 RDSStationDB::getGeneration() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_generation;
+}
+
+quint64 RDSStationDB::getSerial() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_serial;
+}
+
+unsigned int RDSStationDB::getNbStations() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_stations.size();
+}
+
+bool RDSStationDB::getStation(unsigned int pi, Station& station) const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    std::map<unsigned int, Station>::const_iterator it = m_stations.find(pi);
+
+    if (it == m_stations.end()) {
+        return false;
+    }
+
+    station = it->second;
+    return true;
+}
+
+bool RDSStationDB::getStationAt(qint64 frequency, Station& station) const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    std::map<qint64, unsigned int>::const_iterator fit = m_frequencyIndex.find(frequency);
+
+    if (fit == m_frequencyIndex.end()) {
+        return false;
+    }
+
+    station = m_stations.find(fit->second)->second;
+    return true;
+}
+
+void RDSStationDB::getUpdates(quint64 since, std::vector<Station>& stations, quint64& serial, quint64& generation) const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    stations.clear();
+
+    if (since < m_clearSerial) {
+        since = 0;
+    }
+
+    for (std::map<quint64, unsigned int>::const_iterator it = m_serialIndex.upper_bound(since); it != m_serialIndex.end(); ++it) {
+        stations.push_back(m_stations.find(it->second)->second);
+    }
+
+    serial = m_serial;
+    generation = m_generation;
+}
+
+void RDSStationDB::formatStations(const std::vector<Station>& stations, quint64 serial, quint64 generation, QJsonObject& json)
+{
+    QJsonArray jsonStations;
+
+    for (const auto& station : stations)
+    {
+        QJsonObject jsonStation;
+        jsonStation.insert("pi", QString("%1").arg(station.m_pi, 4, 16, QChar('0')).toUpper());
+        jsonStation.insert("frequency", (double) station.m_frequency);
+        jsonStation.insert("programServiceName", station.m_programServiceName);
+        jsonStation.insert("radioText", station.m_radioText);
+        jsonStation.insert("programType", (int) station.m_programType);
+        jsonStation.insert("programTypeName", QString(RDSParser::pty_table[station.m_programType & 0x1f].c_str()));
+        jsonStation.insert("trafficProgram", station.m_trafficProgram);
+        jsonStation.insert("trafficAnnouncement", station.m_trafficAnnouncement);
+        jsonStation.insert("music", station.m_music);
+        QJsonArray altFrequencies;
+
+        for (auto af : station.m_altFrequencies) {
+            altFrequencies.append(af);
+        }
+
+        jsonStation.insert("altFrequencies", altFrequencies);
+        QJsonArray tmcMessages;
+
+        for (const auto& message : station.m_tmcMessages)
+        {
+            QJsonObject jsonMessage;
+            jsonMessage.insert("time", (double) message.m_timeMs);
+            jsonMessage.insert("event", (int) message.m_event);
+            jsonMessage.insert("eventText", message.m_eventText);
+            jsonMessage.insert("location", (int) message.m_location);
+            jsonMessage.insert("extent", message.m_negative ? -((int) message.m_extent) : (int) message.m_extent);
+            jsonMessage.insert("diversion", message.m_diversion);
+            tmcMessages.append(jsonMessage);
+        }
+
+        jsonStation.insert("tmcMessages", tmcMessages);
+        jsonStation.insert("groupCount", (double) station.m_groupCount);
+        jsonStation.insert("firstSeen", (double) station.m_firstSeenMs);
+        jsonStation.insert("lastSeen", (double) station.m_lastSeenMs);
+        jsonStation.insert("serial", (double) station.m_serial);
+        jsonStations.append(jsonStation);
+    }
+
+    json.insert("serial", (double) serial);
+    json.insert("generation", (double) generation);
+    json.insert("stations", jsonStations);
+}
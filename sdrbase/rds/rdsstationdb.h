@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_RDS_RDSSTATIONDB_H_
+#define SDRBASE_RDS_RDSSTATIONDB_H_
+
+#include <vector>
+#include <deque>
+#include <set>
+#include <map>
+
+#include <QString>
+#include <QMutex>
+
+#include "export.h"
+
+class QJsonObject;
+class RDSParser;
+
+/**
+ * In-memory database of the FM stations decoded by the RDS decoders of all channels.
+ *
+ * Records are indexed by PI code. Each time the content of a record changes (PS, radio text,
+ * flags, alternate frequencies, TMC messages or frequency) it gets the next value of a global
+ * serial number so that a client can poll only the records changed since the last serial it got.
+ * Last seen time and group count are refreshed on every group without changing the serial.
+ * A secondary index gives the PI last heard on a frequency.
+ */
+class SDRBASE_API RDSStationDB
+{
+public:
+    struct TMCMessage
+    {
+        qint64 m_timeMs;         //!< Last time the message was received (ms since epoch)
+        unsigned int m_event;    //!< ISO 14819-2 event code
+        unsigned int m_location; //!< ISO 14819-3 location code
+        unsigned int m_extent;   //!< Number of segments affected
+        bool m_negative;         //!< Event direction
+        bool m_diversion;        //!< Diversion recommended
+        QString m_eventText;
+    };
+
+    struct Station
+    {
+        unsigned int m_pi;
+        qint64 m_frequency;      //!< Frequency the station was last heard on (Hz)
+        QString m_programServiceName;
+        QString m_radioText;
+        unsigned int m_programType;
+        bool m_trafficProgram;
+        bool m_trafficAnnouncement;
+        bool m_music;
+        std::set<double> m_altFrequencies; //!< MHz
+        std::deque<TMCMessage> m_tmcMessages; //!< Most recent last
+        quint64 m_groupCount;
+        qint64 m_firstSeenMs;
+        qint64 m_lastSeenMs;
+        quint64 m_serial;        //!< Serial of the last content change
+
+        Station() :
+            m_pi(0),
+            m_frequency(0),
+            m_programType(0),
+            m_trafficProgram(false),
+            m_trafficAnnouncement(false),
+            m_music(false),
+            m_groupCount(0),
+            m_firstSeenMs(0),
+            m_lastSeenMs(0),
+            m_serial(0)
+        {}
+    };
+
+    RDSStationDB();
+    ~RDSStationDB();
+
+    static RDSStationDB *instance();
+
+    void update(qint64 frequency, const RDSParser& parser); //!< Merge the parser data right after it parsed a group
+    void clear();
+    quint64 getSerial() const;
+    unsigned int getNbStations() const;
+    bool getStation(unsigned int pi, Station& station) const;
+    bool getStationAt(qint64 frequency, Station& station) const; //!< Station last heard on this frequency
+    quint64 getGeneration() const;
+    /** Records changed after serial since. All records if since is from before the last clear */
+    void getUpdates(quint64 since, std::vector<Station>& stations, quint64& serial, quint64& generation) const;
+    static void formatStations(const std::vector<Station>& stations, quint64 serial, quint64 generation, QJsonObject& json);
+
+    static const unsigned int m_maxTMCMessages = 32; //!< TMC messages kept per station
+
+private:
+    std::map<unsigned int, Station> m_stations;      //!< Key: PI
+    std::map<quint64, unsigned int> m_serialIndex;   //!< Key: serial of last change, value: PI
+    std::map<qint64, unsigned int> m_frequencyIndex; //!< Key: frequency (Hz), value: PI
+    quint64 m_serial;
+    quint64 m_generation;  //!< Incremented at each clear
+    quint64 m_clearSerial; //!< Serial at the last clear
+    mutable QMutex m_mutex;
+
+    bool updateTMC(Station& station, const RDSParser& parser, qint64 nowMs);
+};
+
+#endif // SDRBASE_RDS_RDSSTATIONDB_H_
@@ -16,7 +16,7 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include "../../channelrx/demodbfm/rdstmc.h"
+#include "rdstmc.h"
 
 #define TMC_EVENTS 2047+1
 #define TMC_EVENT_LIST_LINES 2047+1
@@ -16,16 +16,18 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#ifndef PLUGINS_CHANNEL_BFM_RDSTMC_H_
-#define PLUGINS_CHANNEL_BFM_RDSTMC_H_
+#ifndef SDRBASE_RDS_RDSTMC_H_
+#define SDRBASE_RDS_RDSTMC_H_
 
 #include <string>
 
-class RDSTMC
+#include "export.h"
+
+class SDRBASE_API RDSTMC
 {
 public:
 	static std::string get_tmc_events(unsigned int i, unsigned int j);
 	static int get_tmc_event_code_index(unsigned int i, unsigned int j);
 };
 
-#endif /* PLUGINS_CHANNEL_BFM_RDSTMC_H_ */
+#endif /* SDRBASE_RDS_RDSTMC_H_ */
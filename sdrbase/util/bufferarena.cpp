@@ -0,0 +1,290 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <vector>
+#include <cstdlib>
+
+#include <QMutex>
+#include <QDebug>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "bufferarena.h"
+
+#if defined(__linux__)
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+#endif
+
+struct BufferArena::Private
+{
+    struct Block
+    {
+        int m_node;
+        const void *m_owner;
+    };
+
+    QMutex m_mutex;
+    std::map<std::pair<int, std::size_t>, std::vector<void*>> m_freeBlocks; //!< (node, bytes) => released blocks
+    std::map<void*, Block> m_blocks;  //!< Node and owner of every block handed out or cached
+    std::size_t m_mappedBytes;
+    std::size_t m_cachedBytes;
+
+    Private() :
+        m_mappedBytes(0),
+        m_cachedBytes(0)
+    {}
+};
+
+static thread_local int threadNode = -1;
+static thread_local const void *threadOwner = nullptr;
+
+BufferArena::Scope::Scope(int node, const void *owner) :
+    m_previousNode(threadNode),
+    m_previousOwner(threadOwner)
+{
+    threadNode = node;
+    threadOwner = owner;
+}
+
+BufferArena::Scope::~Scope()
+{
+    threadNode = m_previousNode;
+    threadOwner = m_previousOwner;
+}
+
+BufferArena& BufferArena::instance()
+{
+    static BufferArena *arena = new BufferArena(); // never destroyed: static buffers may be released after any static object
+    return *arena;
+}
+
+BufferArena::BufferArena() :
+    m_private(new Private())
+{}
+
+BufferArena::~BufferArena()
+{
+    // blocks still in use are left to the system at exit
+    for (auto& entry : m_private->m_freeBlocks)
+    {
+        for (void *p : entry.second) {
+            unmapBlock(p, entry.first.second);
+        }
+    }
+
+    delete m_private;
+}
+
+void BufferArena::setThreadNode(int node)
+{
+    threadNode = node;
+}
+
+int BufferArena::getCurrentNode()
+{
+    if (threadNode >= 0) {
+        return threadNode;
+    }
+
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned int cpu, node;
+
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+        return (int) node;
+    }
+#endif
+
+    return 0;
+}
+
+void *BufferArena::allocate(std::size_t bytes)
+{
+    std::size_t blockBytes = roundUp(bytes);
+    int node = getCurrentNode();
+    QMutexLocker mutexLocker(&m_private->m_mutex);
+    auto it = m_private->m_freeBlocks.find(std::make_pair(node, blockBytes));
+
+    if ((it != m_private->m_freeBlocks.end()) && !it->second.empty()) // reuse a released block
+    {
+        void *p = it->second.back();
+        it->second.pop_back();
+        m_private->m_blocks[p].m_owner = threadOwner;
+        m_private->m_cachedBytes -= blockBytes;
+        return p;
+    }
+
+    bool hugePages;
+    void *p = mapBlock(blockBytes, node, hugePages);
+
+    if (!p) {
+        throw std::bad_alloc();
+    }
+
+    m_private->m_blocks[p] = Private::Block{node, threadOwner};
+    m_private->m_mappedBytes += blockBytes;
+
+    qDebug("BufferArena::allocate: %zu bytes on node %d (%s) total mapped: %zu bytes",
+        blockBytes, node, hugePages ? "huge pages" : "default pages", m_private->m_mappedBytes);
+
+    return p;
+}
+
+void BufferArena::deallocate(void *p, std::size_t bytes)
+{
+    if (!p) {
+        return;
+    }
+
+    std::size_t blockBytes = roundUp(bytes);
+    QMutexLocker mutexLocker(&m_private->m_mutex);
+    auto blockIt = m_private->m_blocks.find(p);
+    int node = blockIt == m_private->m_blocks.end() ? 0 : blockIt->second.m_node;
+
+    if (m_private->m_cachedBytes + blockBytes <= m_maxCachedBytes)
+    {
+        m_private->m_freeBlocks[std::make_pair(node, blockBytes)].push_back(p);
+        m_private->m_cachedBytes += blockBytes;
+    }
+    else
+    {
+        if (blockIt != m_private->m_blocks.end()) {
+            m_private->m_blocks.erase(blockIt);
+        }
+
+        m_private->m_mappedBytes -= blockBytes;
+        unmapBlock(p, blockBytes);
+    }
+}
+
+void BufferArena::trim()
+{
+    QMutexLocker mutexLocker(&m_private->m_mutex);
+
+    if (m_private->m_cachedBytes == 0) {
+        return;
+    }
+
+    qDebug("BufferArena::trim: release %zu cached bytes", m_private->m_cachedBytes);
+
+    for (auto& entry : m_private->m_freeBlocks)
+    {
+        for (void *p : entry.second)
+        {
+            m_private->m_blocks.erase(p);
+            unmapBlock(p, entry.first.second);
+        }
+
+        m_private->m_mappedBytes -= entry.first.second * entry.second.size();
+    }
+
+    m_private->m_freeBlocks.clear();
+    m_private->m_cachedBytes = 0;
+}
+
+void BufferArena::trim(const void *owner)
+{
+    QMutexLocker mutexLocker(&m_private->m_mutex);
+    std::size_t trimmedBytes = 0;
+
+    for (auto& entry : m_private->m_freeBlocks)
+    {
+        std::vector<void*>& blocks = entry.second;
+
+        for (std::size_t i = 0; i < blocks.size();)
+        {
+            auto blockIt = m_private->m_blocks.find(blocks[i]);
+
+            if ((blockIt == m_private->m_blocks.end()) || (blockIt->second.m_owner != owner))
+            {
+                i++;
+                continue;
+            }
+
+            m_private->m_blocks.erase(blockIt);
+            unmapBlock(blocks[i], entry.first.second);
+            trimmedBytes += entry.first.second;
+            blocks[i] = blocks.back();
+            blocks.pop_back();
+        }
+    }
+
+    if (trimmedBytes != 0)
+    {
+        m_private->m_mappedBytes -= trimmedBytes;
+        m_private->m_cachedBytes -= trimmedBytes;
+        qDebug("BufferArena::trim: release %zu cached bytes of %p", trimmedBytes, owner);
+    }
+}
+
+void *BufferArena::mapBlock(std::size_t bytes, int node, bool& hugePages)
+{
+#if defined(__linux__)
+    void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    hugePages = p != MAP_FAILED;
+
+    if (!hugePages) // no reserved huge pages: fall back to transparent huge pages
+    {
+        p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (p == MAP_FAILED) {
+            return nullptr;
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+    }
+
+#ifdef SYS_mbind
+    // pages are not touched yet so they will be faulted in on the preferred node
+    unsigned long nodeMask[4] = {0, 0, 0, 0};
+
+    if (node < (int) (sizeof(nodeMask)*8))
+    {
+        nodeMask[node / (sizeof(unsigned long)*8)] = 1UL << (node % (sizeof(unsigned long)*8));
+        syscall(SYS_mbind, p, bytes, MPOL_PREFERRED, nodeMask, sizeof(nodeMask)*8, 0);
+    }
+#else
+    (void) node;
+#endif
+
+    return p;
+#else
+    (void) node;
+    hugePages = false;
+    return ::operator new(bytes, std::nothrow);
+#endif
+}
+
+void BufferArena::unmapBlock(void *p, std::size_t bytes)
+{
+#if defined(__linux__)
+    munmap(p, bytes);
+#else
+    (void) bytes;
+    ::operator delete(p);
+#endif
+}
@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_BUFFERARENA_H_
+#define SDRBASE_UTIL_BUFFERARENA_H_
+
+#include <cstddef>
+#include <new>
+
+#include "export.h"
+
+/**
+ * Process wide allocator for large sample buffers (FIFOs, conversion buffers).
+ *
+ * On Linux blocks are made of 2 MB huge pages (explicit huge pages if the system has some reserved
+ * else transparent huge pages) and are placed on the NUMA node of the CPU running the allocating
+ * thread unless a node is set for the thread with setThreadNode() or a Scope. The device FIFOs
+ * allocate within a Scope set by their device engine so that they are placed on the node of the
+ * engine thread that reads or writes them whatever the thread resizing them. Channel FIFOs are
+ * resized by the baseband thread that reads them and follow its CPU.
+ * Each block belongs to the owner of the scope it was allocated in (none by default).
+ * Released blocks are kept in a cache per node and size and are handed out again on the next request
+ * of the same size so that FIFO resizing on sample rate changes does not go back to the system.
+ * When a device stops its engine returns the cached blocks it owns to the system with trim(owner).
+ * Requests below m_minArenaBytes and all requests on other systems use the regular heap.
+ */
+class SDRBASE_API BufferArena
+{
+public:
+    /** Node and owner of the blocks allocated by the calling thread while it exists */
+    class SDRBASE_API Scope
+    {
+    public:
+        Scope(int node, const void *owner); //!< node -1 follows the CPU
+        ~Scope();
+
+    private:
+        int m_previousNode;
+        const void *m_previousOwner;
+    };
+
+    static BufferArena& instance();
+
+    void *allocate(std::size_t bytes);
+    void deallocate(void *p, std::size_t bytes);
+    void trim(); //!< Return all released blocks kept in the cache to the system
+    void trim(const void *owner); //!< Return the released blocks of this owner kept in the cache to the system
+
+    static void setThreadNode(int node); //!< Node used by allocations from the calling thread. -1 (default) follows the CPU
+    static int getCurrentNode();         //!< Node of the calling thread (0 when unknown)
+
+    static const std::size_t m_hugePageSize = 2*1024*1024;
+    static const std::size_t m_minArenaBytes = 1024*1024;  //!< Smaller requests are served by the heap
+    static const std::size_t m_maxCachedBytes = 512*1024*1024; //!< Released blocks above this are returned to the system
+
+private:
+    BufferArena();
+    ~BufferArena();
+    BufferArena(const BufferArena&);
+    BufferArena& operator=(const BufferArena&);
+
+    struct Private;
+    Private *m_private;
+
+    static std::size_t roundUp(std::size_t bytes) { return ((bytes + m_hugePageSize - 1) / m_hugePageSize) * m_hugePageSize; }
+    void *mapBlock(std::size_t bytes, int node, bool& hugePages);
+    void unmapBlock(void *p, std::size_t bytes);
+};
+
+/** Stateless allocator routing large requests to the BufferArena */
+template<typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    ArenaAllocator() {}
+    template<typename U> ArenaAllocator(const ArenaAllocator<U>&) {}
+
+    T *allocate(std::size_t n)
+    {
+        std::size_t bytes = n * sizeof(T);
+
+        if (bytes < BufferArena::m_minArenaBytes) {
+            return static_cast<T*>(::operator new(bytes));
+        } else {
+            return static_cast<T*>(BufferArena::instance().allocate(bytes));
+        }
+    }
+
+    void deallocate(T *p, std::size_t n)
+    {
+        std::size_t bytes = n * sizeof(T);
+
+        if (bytes < BufferArena::m_minArenaBytes) {
+            ::operator delete(p);
+        } else {
+            BufferArena::instance().deallocate(p, bytes);
+        }
+    }
+
+    template<typename U> struct rebind { typedef ArenaAllocator<U> other; };
+};
+
+template<typename T, typename U>
+inline bool operator==(const ArenaAllocator<T>&, const ArenaAllocator<U>&) { return true; }
+
+template<typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T>&, const ArenaAllocator<U>&) { return false; }
+
+#endif // SDRBASE_UTIL_BUFFERARENA_H_
@@ -21,11 +21,13 @@
 #include <stdint.h>
 #include <vector>
 
+#include "util/bufferarena.h"
+
 template<typename T>
 class IncrementalVector
 {
 public:
-    std::vector<T> m_vector;
+    std::vector<T, ArenaAllocator<T>> m_vector;
 
     IncrementalVector();
     ~IncrementalVector();
@@ -0,0 +1,483 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include <QDebug>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#endif
+
+#include "shmiqring.h"
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared memory ring needs lock free 64 bit atomics");
+
+struct ShmIQRing::Header
+{
+    struct Block
+    {
+        quint64 m_sampleIndex; //!< Index of the first sample since creation
+        BlockInfo m_info;
+    };
+
+    quint32 m_magic;
+    quint32 m_version;
+    quint32 m_sampleBytes;              //!< sizeof(Sample) in the writer: 16 and 24 bit builds cannot be mixed
+    quint32 m_capacity;                 //!< Samples. Power of 2
+    std::atomic<quint32> m_writerAlive;
+    std::atomic<quint32> m_readerWaiting;
+    std::atomic<quint32> m_futex;       //!< Incremented at every committed block and at writer close
+    quint32 m_writerPid;                //!< Writer process: the segment is stale if it does not exist anymore
+    std::atomic<quint64> m_writeBlock;  //!< Blocks committed by the writer
+    std::atomic<quint64> m_readBlock;   //!< Blocks released by the reader
+    std::atomic<quint64> m_writeSample; //!< Samples committed by the writer
+    std::atomic<quint64> m_readSample;  //!< Samples released by the reader
+    std::atomic<quint64> m_droppedCount;
+    Block m_blocks[ShmIQRing::m_nbBlocks];
+};
+
+ShmIQRing::ShmIQRing() :
+    m_header(nullptr),
+    m_samples(nullptr),
+    m_mappedBytes(0),
+    m_writer(false)
+{}
+
+ShmIQRing::~ShmIQRing()
+{
+    close();
+}
+
+QString ShmIQRing::shmName(const QString& name)
+{
+    return name.startsWith("/") ? name : QString("/%1").arg(name);
+}
+
+unsigned int ShmIQRing::roundUpPow2(unsigned int n)
+{
+    unsigned int p = 1;
+
+    while (p < n) {
+        p <<= 1;
+    }
+
+    return p;
+}
+
+unsigned int ShmIQRing::getCapacity() const
+{
+    return m_header ? m_header->m_capacity : 0;
+}
+
+quint64 ShmIQRing::getDroppedCount() const
+{
+    return m_header ? m_header->m_droppedCount.load(std::memory_order_relaxed) : 0;
+}
+
+quint64 ShmIQRing::getWrittenCount() const
+{
+    return m_header ? m_header->m_writeSample.load(std::memory_order_relaxed) : 0;
+}
+
+bool ShmIQRing::isWriterAlive() const
+{
+    return m_header
+        && (m_header->m_writerAlive.load(std::memory_order_acquire) != 0)
+        && isProcessAlive(m_header->m_writerPid); // writer killed without closing
+}
+
+#if defined(__linux__)
+
+static std::size_t shmHeaderBytes(std::size_t headerSize)
+{
+    return (headerSize + 63) & ~((std::size_t) 63); // samples start on a cache line
+}
+
+bool ShmIQRing::create(const QString& name, unsigned int capacity)
+{
+    close();
+
+    unsigned int ringCapacity = roundUpPow2(std::max(capacity, 4096U));
+    std::size_t headerSize = shmHeaderBytes(sizeof(Header));
+    std::size_t bytes = headerSize + ringCapacity * sizeof(Sample);
+    QByteArray path = shmName(name).toLatin1();
+
+    int fd = shm_open(path.constData(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+    if ((fd < 0) && (errno == EEXIST) && isStale(path))
+    {
+        qWarning("ShmIQRing::create: %s: remove stale segment", path.constData());
+        shm_unlink(path.constData());
+        fd = shm_open(path.constData(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+
+    if ((fd < 0) && (errno == EEXIST))
+    {
+        qCritical("ShmIQRing::create: %s is in use by another writer", path.constData());
+        return false;
+    }
+
+    if (fd < 0)
+    {
+        qCritical("ShmIQRing::create: cannot create %s: %s", path.constData(), strerror(errno));
+        return false;
+    }
+
+    if (ftruncate(fd, bytes) < 0)
+    {
+        qCritical("ShmIQRing::create: cannot size %s to %zu bytes: %s", path.constData(), bytes, strerror(errno));
+        ::close(fd);
+        shm_unlink(path.constData());
+        return false;
+    }
+
+    void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (p == MAP_FAILED)
+    {
+        qCritical("ShmIQRing::create: cannot map %s: %s", path.constData(), strerror(errno));
+        shm_unlink(path.constData());
+        return false;
+    }
+
+    m_header = new (p) Header();
+    m_header->m_magic = m_magic;
+    m_header->m_version = m_version;
+    m_header->m_sampleBytes = sizeof(Sample);
+    m_header->m_capacity = ringCapacity;
+    m_header->m_readerWaiting = 0;
+    m_header->m_futex = 0;
+    m_header->m_writeBlock = 0;
+    m_header->m_readBlock = 0;
+    m_header->m_writeSample = 0;
+    m_header->m_readSample = 0;
+    m_header->m_droppedCount = 0;
+    m_header->m_writerPid = getpid();
+    m_header->m_writerAlive.store(1, std::memory_order_release);
+    m_samples = (Sample*) ((char*) p + headerSize);
+    m_mappedBytes = bytes;
+    m_writer = true;
+    m_name = name;
+
+    qDebug("ShmIQRing::create: %s: %u samples", path.constData(), ringCapacity);
+    return true;
+}
+
+bool ShmIQRing::attach(const QString& name)
+{
+    close();
+
+    QByteArray path = shmName(name).toLatin1();
+    int fd = shm_open(path.constData(), O_RDWR, 0);
+
+    if (fd < 0) {
+        return false; // writer not there yet
+    }
+
+    struct stat st;
+    std::size_t headerSize = shmHeaderBytes(sizeof(Header));
+
+    if ((fstat(fd, &st) < 0) || ((std::size_t) st.st_size < headerSize))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *p = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (p == MAP_FAILED)
+    {
+        qCritical("ShmIQRing::attach: cannot map %s: %s", path.constData(), strerror(errno));
+        return false;
+    }
+
+    Header *header = (Header*) p;
+
+    if ((header->m_magic != m_magic)
+     || (header->m_version != m_version)
+     || (header->m_sampleBytes != sizeof(Sample))
+     || (headerSize + (std::size_t) header->m_capacity * sizeof(Sample) > (std::size_t) st.st_size))
+    {
+        qCritical("ShmIQRing::attach: %s: incompatible segment (version %u sample size %u)",
+            path.constData(), header->m_version, header->m_sampleBytes);
+        munmap(p, st.st_size);
+        return false;
+    }
+
+    if ((header->m_writerAlive.load(std::memory_order_acquire) == 0) || !isProcessAlive(header->m_writerPid))
+    {
+        munmap(p, st.st_size); // stale segment: wait for a new writer
+        return false;
+    }
+
+    // skip what was written before: restart from the last committed block
+    quint64 writeBlock = header->m_writeBlock.load(std::memory_order_acquire);
+
+    if (writeBlock > 0)
+    {
+        const Header::Block& last = header->m_blocks[(writeBlock - 1) % m_nbBlocks];
+        header->m_readSample.store(last.m_sampleIndex + last.m_info.m_nbSamples, std::memory_order_release);
+    }
+    else
+    {
+        header->m_readSample.store(0, std::memory_order_release);
+    }
+
+    header->m_readBlock.store(writeBlock, std::memory_order_release);
+
+    m_header = header;
+    m_samples = (Sample*) ((char*) p + headerSize);
+    m_mappedBytes = st.st_size;
+    m_writer = false;
+    m_name = name;
+
+    qDebug("ShmIQRing::attach: %s: %u samples", path.constData(), header->m_capacity);
+    return true;
+}
+
+void ShmIQRing::close()
+{
+    if (!m_header) {
+        return;
+    }
+
+    if (m_writer)
+    {
+        // unlink first so that a new writer never sees this segment as stale and takes over the name
+        shm_unlink(shmName(m_name).toLatin1().constData()); // the reader mapping stays valid until it unmaps
+        m_header->m_writerAlive.store(0, std::memory_order_release);
+        m_header->m_futex.fetch_add(1);
+        futexWake((quint32*) &m_header->m_futex); // let the reader see the writer has gone
+    }
+
+    munmap(m_header, m_mappedBytes);
+    m_header = nullptr;
+    m_samples = nullptr;
+    m_mappedBytes = 0;
+    m_writer = false;
+}
+
+bool ShmIQRing::isProcessAlive(quint32 pid)
+{
+    return (kill((pid_t) pid, 0) == 0) || (errno == EPERM); // EPERM: exists but owned by another user
+}
+
+bool ShmIQRing::isStale(const QByteArray& path)
+{
+    int fd = shm_open(path.constData(), O_RDONLY, 0);
+
+    if (fd < 0) {
+        return errno == ENOENT; // removed in between
+    }
+
+    struct stat st;
+    bool stale = true; // not a ring: can be replaced
+
+    if ((fstat(fd, &st) == 0) && ((std::size_t) st.st_size >= sizeof(Header)))
+    {
+        void *p = mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, fd, 0);
+
+        if (p != MAP_FAILED)
+        {
+            const Header *header = (const Header*) p;
+
+            if ((header->m_magic == m_magic) && (header->m_version == m_version)) {
+                stale = (header->m_writerAlive.load(std::memory_order_acquire) == 0) || !isProcessAlive(header->m_writerPid);
+            } else if (header->m_magic == m_magic) {
+                stale = header->m_writerAlive.load(std::memory_order_acquire) == 0; // other version: no writer process ID
+            }
+
+            munmap(p, sizeof(Header));
+        }
+    }
+
+    ::close(fd);
+    return stale;
+}
+
+void ShmIQRing::futexWait(quint32 *addr, quint32 value, int timeoutMs)
+{
+    struct timespec ts;
+    ts.tv_sec = timeoutMs / 1000;
+    ts.tv_nsec = (timeoutMs % 1000) * 1000000L;
+    syscall(SYS_futex, addr, FUTEX_WAIT, value, &ts, nullptr, 0); // shared futex: no FUTEX_PRIVATE_FLAG
+}
+
+void ShmIQRing::futexWake(quint32 *addr)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+#else // shared memory transport is not available
+
+bool ShmIQRing::create(const QString& name, unsigned int capacity)
+{
+    (void) capacity;
+    qCritical("ShmIQRing::create: %s: not supported on this system", qPrintable(name));
+    return false;
+}
+
+bool ShmIQRing::attach(const QString& name)
+{
+    (void) name;
+    return false;
+}
+
+void ShmIQRing::close()
+{
+}
+
+bool ShmIQRing::isProcessAlive(quint32 pid)
+{
+    (void) pid;
+    return true;
+}
+
+bool ShmIQRing::isStale(const QByteArray& path)
+{
+    (void) path;
+    return false;
+}
+
+void ShmIQRing::futexWait(quint32 *addr, quint32 value, int timeoutMs)
+{
+    (void) addr;
+    (void) value;
+    (void) timeoutMs;
+}
+
+void ShmIQRing::futexWake(quint32 *addr)
+{
+    (void) addr;
+}
+
+#endif
+
+unsigned int ShmIQRing::write(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, const BlockInfo& info)
+{
+    unsigned int count = end - begin;
+
+    if (!m_header || !m_writer || (count == 0)) {
+        return 0;
+    }
+
+    quint64 writeBlock = m_header->m_writeBlock.load(std::memory_order_relaxed);
+    quint64 readBlock = m_header->m_readBlock.load(std::memory_order_acquire);
+    quint64 writeSample = m_header->m_writeSample.load(std::memory_order_relaxed);
+    quint64 readSample = m_header->m_readSample.load(std::memory_order_acquire);
+    unsigned int capacity = m_header->m_capacity;
+
+    if ((writeSample - readSample + count > capacity) || (writeBlock - readBlock >= m_nbBlocks))
+    {
+        m_header->m_droppedCount.fetch_add(count, std::memory_order_relaxed);
+        return 0;
+    }
+
+    unsigned int pos = writeSample & (capacity - 1);
+    unsigned int size1 = std::min(count, capacity - pos);
+    std::copy(begin, begin + size1, m_samples + pos);
+    std::copy(begin + size1, end, m_samples);
+
+    Header::Block& block = m_header->m_blocks[writeBlock % m_nbBlocks];
+    block.m_sampleIndex = writeSample;
+    block.m_info = info;
+    block.m_info.m_nbSamples = count;
+
+    m_header->m_writeSample.store(writeSample + count, std::memory_order_release);
+    m_header->m_writeBlock.store(writeBlock + 1, std::memory_order_release);
+    m_header->m_futex.fetch_add(1);
+
+    if (m_header->m_readerWaiting.load() != 0) {
+        futexWake((quint32*) &m_header->m_futex);
+    }
+
+    return count;
+}
+
+bool ShmIQRing::wait(int timeoutMs)
+{
+    if (!m_header) {
+        return false;
+    }
+
+    quint64 readBlock = m_header->m_readBlock.load(std::memory_order_relaxed);
+
+    if (m_header->m_writeBlock.load(std::memory_order_acquire) != readBlock) {
+        return true;
+    }
+
+    // the futex value is taken before checking again so that a block committed in between is not missed
+    m_header->m_readerWaiting.store(1);
+    quint32 futexValue = m_header->m_futex.load();
+
+    if ((m_header->m_writeBlock.load(std::memory_order_acquire) == readBlock) && isWriterAlive()) {
+        futexWait((quint32*) &m_header->m_futex, futexValue, timeoutMs);
+    }
+
+    m_header->m_readerWaiting.store(0);
+    return m_header->m_writeBlock.load(std::memory_order_acquire) != readBlock;
+}
+
+bool ShmIQRing::readBegin(BlockInfo& info, const Sample **part1, unsigned int& size1, const Sample **part2, unsigned int& size2)
+{
+    if (!m_header || m_writer) {
+        return false;
+    }
+
+    quint64 readBlock = m_header->m_readBlock.load(std::memory_order_relaxed);
+
+    if (m_header->m_writeBlock.load(std::memory_order_acquire) == readBlock) {
+        return false;
+    }
+
+    const Header::Block& block = m_header->m_blocks[readBlock % m_nbBlocks];
+    unsigned int capacity = m_header->m_capacity;
+    unsigned int pos = block.m_sampleIndex & (capacity - 1);
+    info = block.m_info;
+    size1 = std::min(info.m_nbSamples, capacity - pos);
+    size2 = info.m_nbSamples - size1;
+    *part1 = m_samples + pos;
+    *part2 = m_samples;
+
+    return true;
+}
+
+void ShmIQRing::readCommit()
+{
+    if (!m_header || m_writer) {
+        return;
+    }
+
+    quint64 readBlock = m_header->m_readBlock.load(std::memory_order_relaxed);
+    const Header::Block& block = m_header->m_blocks[readBlock % m_nbBlocks];
+    m_header->m_readSample.store(block.m_sampleIndex + block.m_info.m_nbSamples, std::memory_order_release);
+    m_header->m_readBlock.store(readBlock + 1, std::memory_order_release);
+}
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_SHMIQRING_H_
+#define SDRBASE_UTIL_SHMIQRING_H_
+
+#include <stdint.h>
+
+#include <QString>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Single producer single consumer ring of I/Q samples in POSIX shared memory to move a sample
+ * stream between two processes (typically two sdrangelsrv instances) on the same host.
+ *
+ * The writer creates the segment with create() and the reader maps it with attach(). Samples are
+ * written by blocks. Every block is described in a separate ring of descriptors carrying the center
+ * frequency, the sample rate and the timestamp of its first sample so that the reader sees stream
+ * changes exactly at the sample where they happen.
+ *
+ * The writer never waits: when the reader is late and there is no room the block is dropped and
+ * counted. The reader sleeps on a futex in the shared segment and is woken by the writer when it
+ * commits a block. The segment records the process ID of the writer so that a reader detaches and
+ * a new writer takes the segment over when the writer process died without closing it.
+ * Available on Linux only: on other systems create() and attach() fail.
+ */
+class SDRBASE_API ShmIQRing
+{
+public:
+    struct BlockInfo
+    {
+        quint64 m_centerFrequency; //!< Hz
+        quint32 m_sampleRate;      //!< S/s
+        quint32 m_nbSamples;
+        quint64 m_timestampUs;     //!< Time of the first sample of the block (us since epoch)
+    };
+
+    ShmIQRing();
+    ~ShmIQRing();
+
+    bool create(const QString& name, unsigned int capacity); //!< Writer side. Capacity in samples is rounded up to a power of 2. Fails if a live writer owns the name
+    bool attach(const QString& name);                        //!< Reader side. Reading starts at the next block written
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+    bool isWriter() const { return m_writer; }
+    bool isWriterAlive() const; //!< Reader side: false when the writer has closed the segment or its process has gone
+    const QString& getName() const { return m_name; }
+    unsigned int getCapacity() const;
+
+    /** Writer: copy one block. Returns the number of samples written: either all or none when dropped */
+    unsigned int write(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, const BlockInfo& info);
+
+    /**
+     * Reader: wait at most timeoutMs for a block to be available.
+     * Returns true when there is at least one block to read.
+     */
+    bool wait(int timeoutMs);
+
+    /**
+     * Reader: get the next block without copying. The samples may be split in two parts when
+     * the block wraps around the end of the ring. Returns false if there is no block.
+     * The block must be released with readCommit() once consumed.
+     */
+    bool readBegin(BlockInfo& info, const Sample **part1, unsigned int& size1, const Sample **part2, unsigned int& size2);
+    void readCommit();
+
+    quint64 getDroppedCount() const; //!< Samples dropped by the writer since the segment was created
+    quint64 getWrittenCount() const; //!< Samples written since the segment was created
+
+    static const unsigned int m_nbBlocks = 1024; //!< Size of the block descriptors ring
+    static const quint32 m_magic = 0x53484d51;   //!< "SHMQ"
+    static const quint32 m_version = 2;
+
+private:
+    struct Header;
+
+    Header *m_header;
+    Sample *m_samples;
+    std::size_t m_mappedBytes;
+    bool m_writer;
+    QString m_name;
+
+    static QString shmName(const QString& name);
+    static unsigned int roundUpPow2(unsigned int n);
+    static bool isProcessAlive(quint32 pid);
+    static bool isStale(const QByteArray& path); //!< Existing segment left by a writer that is gone or not a ring at all
+    static void futexWait(quint32 *addr, quint32 value, int timeoutMs);
+    static void futexWake(quint32 *addr);
+};
+
+#endif // SDRBASE_UTIL_SHMIQRING_H_
@@ -41,6 +41,8 @@ QString WebAPIAdapterInterface::instancePresetURL = "/sdrangel/preset";
 QString WebAPIAdapterInterface::instancePresetFileURL = "/sdrangel/preset/file";
 QString WebAPIAdapterInterface::instanceDeviceSetsURL = "/sdrangel/devicesets";
 QString WebAPIAdapterInterface::instanceDeviceSetURL = "/sdrangel/deviceset";
+QString WebAPIAdapterInterface::instanceRDSStationsURL = "/sdrangel/rds/stations";
+QString WebAPIAdapterInterface::instanceAMBEPoolURL = "/sdrangel/ambe/pool";
 
 std::regex WebAPIAdapterInterface::devicesetURLRe("^/sdrangel/deviceset/([0-9]{1,2})$");
 std::regex WebAPIAdapterInterface::devicesetFocusURLRe("^/sdrangel/deviceset/([0-9]{1,2})/focus$");
@@ -56,6 +58,11 @@ std::regex WebAPIAdapterInterface::devicesetChannelIndexURLRe("^/sdrangel/device
 std::regex WebAPIAdapterInterface::devicesetChannelSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/settings$");
 std::regex WebAPIAdapterInterface::devicesetChannelReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/report");
 std::regex WebAPIAdapterInterface::devicesetChannelActionsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/actions");
+std::regex WebAPIAdapterInterface::devicesetChannelFrameURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/frame$");
+std::regex WebAPIAdapterInterface::devicesetSpectrumArchiveURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/archive$");
+std::regex WebAPIAdapterInterface::devicesetSpectrumPanoramaURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/panorama$");
+std::regex WebAPIAdapterInterface::devicesetDeviceCompactURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/compact$");
+std::regex WebAPIAdapterInterface::devicesetDeviceFloatURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/float$");
 
 void WebAPIAdapterInterface::ConfigKeys::debug() const
 {
@@ -24,7 +24,10 @@
 #include <QStringList>
 #include <regex>
 
+#include <QJsonObject>
+
 #include "SWGErrorResponse.h"
+#include "dsp/panoramaengine.h"
 
 #include "export.h"
 
@@ -658,6 +661,50 @@ public:
     	return 501;
     }
 
+    /**
+     * Handler of /sdrangel/rds/stations (GET)
+     * returns the RDS station database records changed after serial since (default 501: not implemented)
+     */
+    virtual int instanceRDSStationsGet(
+            quint64 since,
+            QJsonObject& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) since;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/rds/stations (DELETE)
+     * clears the RDS station database (default 501: not implemented)
+     */
+    virtual int instanceRDSStationsDelete(
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/ambe/pool (GET)
+     * returns the load of the software vocoder pool workers since the previous call (default 501: not implemented)
+     */
+    virtual int instanceAMBEPoolGet(
+            QJsonObject& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     /**
      * Handler of /sdrangel/deviceset/{devicesetIndex} (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
      * returns the Http status code (default 501: not implemented)
@@ -1017,6 +1064,226 @@ public:
         return 501;
     }
 
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/channel/{channelIndex}/frame (GET)
+     * returns the latest video frame of the channel encoded as per format (default 501: not implemented)
+     */
+    virtual int devicesetChannelFrameGet(
+            int deviceSetIndex,
+            int channelIndex,
+            const QString& format,
+            int scale,
+            int quality,
+            quint64 since,
+            QByteArray& frame,
+            QString& mimeType,
+            quint64& frameIndex,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) channelIndex;
+        (void) format;
+        (void) scale;
+        (void) quality;
+        (void) since;
+        (void) frame;
+        (void) mimeType;
+        (void) frameIndex;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/device/compact (GET)
+     * returns whether the device set FIFOs use 16 bit sample storage (default 501: not implemented)
+     */
+    virtual int devicesetDeviceCompactGet(
+            int deviceSetIndex,
+            bool& compactSamples,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) compactSamples;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/device/compact (PUT)
+     * selects 16 bit sample storage in the device set FIFOs (default 501: not implemented)
+     */
+    virtual int devicesetDeviceCompactPut(
+            int deviceSetIndex,
+            bool compactSamples,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) compactSamples;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/device/float (GET)
+     * returns whether the float baseband is requested (default 501: not implemented)
+     */
+    virtual int devicesetDeviceFloatGet(
+            int deviceSetIndex,
+            bool& floatSamples,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) floatSamples;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/device/float (PUT)
+     * requests the float baseband from float native devices (default 501: not implemented)
+     */
+    virtual int devicesetDeviceFloatPut(
+            int deviceSetIndex,
+            bool floatSamples,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) floatSamples;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/spectrum/archive (POST)
+     * starts archiving the spectrum of a Rx device set (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumArchivePost(
+            int deviceSetIndex,
+            const QString& directory,
+            int fftSize,
+            float rowsPerSecond,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) directory;
+        (void) fftSize;
+        (void) rowsPerSecond;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/spectrum/archive (DELETE)
+     * stops archiving the spectrum of a Rx device set (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumArchiveDelete(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/spectrum/archive (GET)
+     * returns a time/frequency window of the spectrum archive (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumArchiveGet(
+            int deviceSetIndex,
+            qint64 fromMs,
+            qint64 toMs,
+            qint64 fromHz,
+            qint64 toHz,
+            int maxRows,
+            int maxBins,
+            QJsonObject& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) fromMs;
+        (void) toMs;
+        (void) fromHz;
+        (void) toHz;
+        (void) maxRows;
+        (void) maxBins;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/spectrum/panorama (POST)
+     * starts a panorama scan on a Rx device set (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumPanoramaPost(
+            int deviceSetIndex,
+            const PanoramaEngine::Settings& settings,
+            const QString& wsAddress,
+            quint16 wsPort,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) settings;
+        (void) wsAddress;
+        (void) wsPort;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/spectrum/panorama (DELETE)
+     * stops the panorama scan of a Rx device set (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumPanoramaDelete(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/spectrum/panorama (GET)
+     * returns the last complete panorama sweep (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumPanoramaGet(
+            int deviceSetIndex,
+            int maxBins,
+            QJsonObject& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) maxBins;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     static QString instanceSummaryURL;
     static QString instanceConfigURL;
     static QString instanceDevicesURL;
@@ -1039,6 +1306,8 @@ public:
     static QString instancePresetFileURL;
     static QString instanceDeviceSetsURL;
     static QString instanceDeviceSetURL;
+    static QString instanceRDSStationsURL;
+    static QString instanceAMBEPoolURL;
     static std::regex devicesetURLRe;
     static std::regex devicesetFocusURLRe;
     static std::regex devicesetDeviceURLRe;
@@ -1052,7 +1321,12 @@ public:
     static std::regex devicesetChannelSettingsURLRe;
     static std::regex devicesetChannelReportURLRe;
     static std::regex devicesetChannelActionsURLRe;
+    static std::regex devicesetChannelFrameURLRe;
     static std::regex devicesetChannelsReportURLRe;
+    static std::regex devicesetSpectrumArchiveURLRe;
+    static std::regex devicesetSpectrumPanoramaURLRe;
+    static std::regex devicesetDeviceCompactURLRe;
+    static std::regex devicesetDeviceFloatURLRe;
 };
 
 
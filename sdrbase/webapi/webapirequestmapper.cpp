@@ -17,7 +17,10 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <limits>
+
 #include <QDirIterator>
+#include <QDateTime>
 #include <QJsonDocument>
 #include <QJsonArray>
 
@@ -51,6 +54,7 @@
 #include "SWGChannelActions.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
+#include "dsp/spectrumarchivesink.h"
 
 const QMap<QString, QString> WebAPIRequestMapper::m_channelURIToSettingsKey = {
     {"sdrangel.channel.amdemod", "AMDemodSettings"},
@@ -74,6 +78,8 @@ const QMap<QString, QString> WebAPIRequestMapper::m_channelURIToSettingsKey = {
     {"sdrangel.channeltx.modnfm", "NFMModSettings"},
     {"sdrangel.demod.localsink", "LocalSinkSettings"},
     {"sdrangel.channel.localsink", "LocalSinkSettings"}, // remap
+    {"sdrangel.channel.shmsink", "ShmSinkSettings"},
+    {"sdrangel.channel.rdsmonitor", "RDSMonitorSettings"},
     {"sdrangel.channel.localsource", "LocalSourceSettings"},
     {"sdrangel.channeltx.modpacket", "PacketModSettings"},
     {"sdrangel.demod.remotesink", "RemoteSinkSettings"},
@@ -114,6 +120,7 @@ const QMap<QString, QString> WebAPIRequestMapper::m_deviceIdToSettingsKey = {
     {"sdrangel.samplesource.localinput", "localInputSettings"},
     {"sdrangel.samplesink.localoutput", "localOutputSettings"},
     {"sdrangel.samplesource.localoutput", "localOutputSettings"}, // remap
+    {"sdrangel.samplesource.shminput", "shmInputSettings"},
     {"sdrangel.samplesource.perseus", "perseusSettings"},
     {"sdrangel.samplesource.plutosdr", "plutoSdrInputSettings"},
     {"sdrangel.samplesink.plutosdr", "plutoSdrOutputSettings"},
@@ -149,6 +156,8 @@ const QMap<QString, QString> WebAPIRequestMapper::m_channelTypeToSettingsKey = {
     {"LocalSource", "LocalSourceSettings"},
     {"RemoteSink", "RemoteSinkSettings"},
     {"RemoteSource", "RemoteSourceSettings"},
+    {"ShmSink", "ShmSinkSettings"},
+    {"RDSMonitor", "RDSMonitorSettings"},
     {"SSBMod", "SSBModSettings"},
     {"SSBDemod", "SSBDemodSettings"},
     {"UDPSink", "UDPSourceSettings"},
@@ -180,6 +189,7 @@ const QMap<QString, QString> WebAPIRequestMapper::m_sourceDeviceHwIdToSettingsKe
     {"RTLSDR", "rtlSdrSettings"},
     {"RemoteInput", "remoteInputSettings"},
     {"SDRplay1", "sdrPlaySettings"},
+    {"ShmInput", "shmInputSettings"},
     {"SoapySDR", "soapySDRInputSettings"},
     {"TestSource", "testSourceSettings"},
     {"XTRX", "XtrxInputSettings"}
@@ -321,6 +331,10 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
             instanceDeviceSetsService(request, response);
         } else if (path == WebAPIAdapterInterface::instanceDeviceSetURL) {
             instanceDeviceSetService(request, response);
+        } else if (path == WebAPIAdapterInterface::instanceRDSStationsURL) {
+            instanceRDSStationsService(request, response);
+        } else if (path == WebAPIAdapterInterface::instanceAMBEPoolURL) {
+            instanceAMBEPoolService(request, response);
         }
         else
         {
@@ -355,6 +369,16 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
                 devicesetChannelReportService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelActionsURLRe)) {
                 devicesetChannelActionsService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelFrameURLRe)) {
+                devicesetChannelFrameService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumArchiveURLRe)) {
+                devicesetSpectrumArchiveService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumPanoramaURLRe)) {
+                devicesetSpectrumPanoramaService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceCompactURLRe)) {
+                devicesetDeviceCompactService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceFloatURLRe)) {
+                devicesetDeviceFloatService(std::string(desc_match[1]), request, response);
             }
             else // serve static documentation pages
             {
@@ -1563,6 +1587,93 @@ void WebAPIRequestMapper::instanceDeviceSetService(qtwebapp::HttpRequest& reques
     }
 }
 
+void WebAPIRequestMapper::instanceRDSStationsService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "GET")
+    {
+        // since: serial returned by the previous query to get only the stations changed after it (default all)
+        QByteArray sinceStr = request.getParameter("since");
+        quint64 since = 0;
+
+        if (sinceStr.length() != 0)
+        {
+            bool ok;
+            quint64 tmp = sinceStr.toULongLong(&ok);
+
+            if (!ok)
+            {
+                response.setStatus(400,"Invalid data");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Wrong integer conversion on since parameter";
+                response.write(errorResponse.asJson().toUtf8());
+                return;
+            }
+
+            since = tmp;
+        }
+
+        QJsonObject normalResponse;
+        int status = m_adapter->instanceRDSStationsGet(since, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(QJsonDocument(normalResponse).toJson(QJsonDocument::Compact));
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else if (request.getMethod() == "DELETE")
+    {
+        SWGSDRangel::SWGSuccessResponse normalResponse;
+        int status = m_adapter->instanceRDSStationsDelete(normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::instanceAMBEPoolService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "GET")
+    {
+        QJsonObject normalResponse;
+        int status = m_adapter->instanceAMBEPoolGet(normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(QJsonDocument(normalResponse).toJson(QJsonDocument::Compact));
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::devicesetService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
@@ -1641,6 +1752,347 @@ void WebAPIRequestMapper::devicesetFocusService(const std::string& indexStr, qtw
     }
 }
 
+void WebAPIRequestMapper::devicesetDeviceCompactService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "GET")
+        {
+            bool compactSamples;
+            int status = m_adapter->devicesetDeviceCompactGet(deviceSetIndex, compactSamples, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2)
+            {
+                QJsonObject normalResponse;
+                normalResponse.insert("compact", compactSamples ? 1 : 0);
+                response.write(QJsonDocument(normalResponse).toJson(QJsonDocument::Compact));
+            }
+            else
+            {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "PUT")
+        {
+            QByteArray enableStr = request.getParameter("enable");
+
+            if (enableStr.isEmpty())
+            {
+                response.setStatus(400,"Invalid data");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Missing enable parameter";
+                response.write(errorResponse.asJson().toUtf8());
+                return;
+            }
+
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetDeviceCompactPut(deviceSetIndex, boost::lexical_cast<int>(enableStr.toStdString()) != 0, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index or enable parameter";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetDeviceFloatService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "GET")
+        {
+            bool floatSamples;
+            int status = m_adapter->devicesetDeviceFloatGet(deviceSetIndex, floatSamples, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2)
+            {
+                QJsonObject normalResponse;
+                normalResponse.insert("float", floatSamples ? 1 : 0);
+                response.write(QJsonDocument(normalResponse).toJson(QJsonDocument::Compact));
+            }
+            else
+            {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "PUT")
+        {
+            QByteArray enableStr = request.getParameter("enable");
+
+            if (enableStr.isEmpty())
+            {
+                response.setStatus(400,"Invalid data");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Missing enable parameter";
+                response.write(errorResponse.asJson().toUtf8());
+                return;
+            }
+
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetDeviceFloatPut(deviceSetIndex, boost::lexical_cast<int>(enableStr.toStdString()) != 0, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index or enable parameter";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetSpectrumArchiveService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "GET")
+        {
+            // time window in ms since epoch (default last hour) and frequency window in Hz (default all)
+            qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+            QByteArray fromStr = request.getParameter("from");
+            QByteArray toStr = request.getParameter("to");
+            QByteArray fminStr = request.getParameter("fmin");
+            QByteArray fmaxStr = request.getParameter("fmax");
+            QByteArray rowsStr = request.getParameter("rows");
+            QByteArray binsStr = request.getParameter("bins");
+            qint64 fromMs = fromStr.isEmpty() ? nowMs - 3600000 : boost::lexical_cast<qint64>(fromStr.toStdString());
+            qint64 toMs = toStr.isEmpty() ? nowMs : boost::lexical_cast<qint64>(toStr.toStdString());
+            qint64 fromHz = fminStr.isEmpty() ? 0 : boost::lexical_cast<qint64>(fminStr.toStdString());
+            qint64 toHz = fmaxStr.isEmpty() ? std::numeric_limits<qint64>::max() : boost::lexical_cast<qint64>(fmaxStr.toStdString());
+            int maxRows = rowsStr.isEmpty() ? 1024 : boost::lexical_cast<int>(rowsStr.toStdString());
+            int maxBins = binsStr.isEmpty() ? 1024 : boost::lexical_cast<int>(binsStr.toStdString());
+            QJsonObject normalResponse;
+            int status = m_adapter->devicesetSpectrumArchiveGet(deviceSetIndex, fromMs, toMs, fromHz, toHz, maxRows, maxBins, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(QJsonDocument(normalResponse).toJson(QJsonDocument::Compact));
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "POST")
+        {
+            QByteArray directoryStr = request.getParameter("directory");
+            QByteArray fftSizeStr = request.getParameter("fftSize");
+            QByteArray rateStr = request.getParameter("rate");
+            int fftSize = fftSizeStr.isEmpty() ? 1024 : boost::lexical_cast<int>(fftSizeStr.toStdString());
+            float rowsPerSecond = rateStr.isEmpty() ? 10.0f : boost::lexical_cast<float>(rateStr.toStdString());
+
+            if (directoryStr.isEmpty())
+            {
+                response.setStatus(400,"Invalid data");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Missing directory parameter";
+                response.write(errorResponse.asJson().toUtf8());
+                return;
+            }
+
+            if (!SpectrumArchiveSink::isValidFFTSize(fftSize) || !(rowsPerSecond > 0.0f))
+            {
+                response.setStatus(400,"Invalid data");
+                errorResponse.init();
+                *errorResponse.getMessage() = QString("fftSize must be a power of 2 from %1 to %2 and rate must be positive")
+                    .arg(SpectrumArchiveSink::m_minFFTSize).arg(SpectrumArchiveSink::m_maxFFTSize);
+                response.write(errorResponse.asJson().toUtf8());
+                return;
+            }
+
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetSpectrumArchivePost(deviceSetIndex, QString(directoryStr), fftSize, rowsPerSecond, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "DELETE")
+        {
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetSpectrumArchiveDelete(deviceSetIndex, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index or query parameters";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetSpectrumPanoramaService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "GET")
+        {
+            QByteArray binsStr = request.getParameter("bins");
+            int maxBins = binsStr.isEmpty() ? 0 : boost::lexical_cast<int>(binsStr.toStdString());
+            QJsonObject normalResponse;
+            int status = m_adapter->devicesetSpectrumPanoramaGet(deviceSetIndex, maxBins, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(QJsonDocument(normalResponse).toJson(QJsonDocument::Compact));
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "POST")
+        {
+            // range in Hz, settle time in ms, overlap and usable part in percent
+            PanoramaEngine::Settings settings;
+            QByteArray fromStr = request.getParameter("from");
+            QByteArray toStr = request.getParameter("to");
+            QByteArray fftSizeStr = request.getParameter("fftSize");
+            QByteArray settleStr = request.getParameter("settle");
+            QByteArray overlapStr = request.getParameter("overlap");
+            QByteArray usableStr = request.getParameter("usable");
+            QByteArray avgStr = request.getParameter("avg");
+            QByteArray wsAddressStr = request.getParameter("wsAddress");
+            QByteArray wsPortStr = request.getParameter("wsPort");
+
+            if (fromStr.isEmpty() || toStr.isEmpty())
+            {
+                response.setStatus(400,"Invalid data");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Missing from or to parameter";
+                response.write(errorResponse.asJson().toUtf8());
+                return;
+            }
+
+            settings.m_fromHz = boost::lexical_cast<qint64>(fromStr.toStdString());
+            settings.m_toHz = boost::lexical_cast<qint64>(toStr.toStdString());
+            settings.m_fftSize = fftSizeStr.isEmpty() ? settings.m_fftSize : boost::lexical_cast<int>(fftSizeStr.toStdString());
+            settings.m_settleMs = settleStr.isEmpty() ? settings.m_settleMs : boost::lexical_cast<int>(settleStr.toStdString());
+            settings.m_overlapPercent = overlapStr.isEmpty() ? settings.m_overlapPercent : boost::lexical_cast<int>(overlapStr.toStdString());
+            settings.m_usablePercent = usableStr.isEmpty() ? settings.m_usablePercent : boost::lexical_cast<int>(usableStr.toStdString());
+            settings.m_averagingNb = avgStr.isEmpty() ? settings.m_averagingNb : boost::lexical_cast<int>(avgStr.toStdString());
+            quint16 wsPort = wsPortStr.isEmpty() ? 0 : boost::lexical_cast<quint16>(wsPortStr.toStdString());
+            QString wsAddress = wsAddressStr.isEmpty() ? QString("127.0.0.1") : QString(wsAddressStr);
+
+            if (!settings.isValid())
+            {
+                response.setStatus(400,"Invalid data");
+                errorResponse.init();
+                *errorResponse.getMessage() = QString("Invalid panorama parameters: %1").arg(settings.getError());
+                response.write(errorResponse.asJson().toUtf8());
+                return;
+            }
+
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetSpectrumPanoramaPost(deviceSetIndex, settings, wsAddress, wsPort, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "DELETE")
+        {
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetSpectrumPanoramaDelete(deviceSetIndex, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index or query parameters";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::devicesetDeviceService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
@@ -2325,6 +2777,84 @@ void WebAPIRequestMapper::devicesetChannelReportService(
     }
 }
 
+void WebAPIRequestMapper::devicesetChannelFrameService(
+        const std::string& deviceSetIndexStr,
+        const std::string& channelIndexStr,
+        qtwebapp::HttpRequest& request,
+        qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
+        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
+
+        if (request.getMethod() == "GET")
+        {
+            // format: jpeg (default) or raw, scale: size divider (default 1), quality: JPEG quality (default 75)
+            // since: number of the last frame received to get only a newer one (default 0)
+            QByteArray formatStr = request.getParameter("format");
+            QByteArray scaleStr = request.getParameter("scale");
+            QByteArray qualityStr = request.getParameter("quality");
+            QByteArray sinceStr = request.getParameter("since");
+            QString format = formatStr.isEmpty() ? QString("jpeg") : QString(formatStr);
+            int scale = scaleStr.isEmpty() ? 1 : boost::lexical_cast<int>(scaleStr.toStdString());
+            int quality = qualityStr.isEmpty() ? 75 : boost::lexical_cast<int>(qualityStr.toStdString());
+            quint64 since = sinceStr.isEmpty() ? 0 : boost::lexical_cast<quint64>(sinceStr.toStdString());
+            QByteArray frame;
+            QString mimeType;
+            quint64 frameIndex = since;
+            int status = m_adapter->devicesetChannelFrameGet(
+                deviceSetIndex,
+                channelIndex,
+                format,
+                scale,
+                quality,
+                since,
+                frame,
+                mimeType,
+                frameIndex,
+                errorResponse
+            );
+            response.setStatus(status);
+
+            if (status/100 == 2)
+            {
+                response.setHeader("X-Frame-Index", QByteArray::number(frameIndex));
+
+                if (status != 204)
+                {
+                    response.setHeader("Content-Type", mimeType.toLatin1());
+                    response.write(frame);
+                }
+            }
+            else
+            {
+                response.setHeader("Content-Type", "application/json");
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setHeader("Content-Type", "application/json");
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        response.setHeader("Content-Type", "application/json");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on index or parameter";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::devicesetChannelActionsService(
         const std::string& deviceSetIndexStr,
         const std::string& channelIndexStr,
@@ -3171,6 +3701,16 @@ bool WebAPIRequestMapper::getChannelSettings(
             channelSettings->setLocalSinkSettings(new SWGSDRangel::SWGLocalSinkSettings());
             channelSettings->getLocalSinkSettings()->fromJsonObject(settingsJsonObject);
         }
+        else if (channelSettingsKey == "ShmSinkSettings")
+        {
+            channelSettings->setShmSinkSettings(new SWGSDRangel::SWGShmSinkSettings());
+            channelSettings->getShmSinkSettings()->fromJsonObject(settingsJsonObject);
+        }
+        else if (channelSettingsKey == "RDSMonitorSettings")
+        {
+            channelSettings->setRdsMonitorSettings(new SWGSDRangel::SWGRDSMonitorSettings());
+            channelSettings->getRdsMonitorSettings()->fromJsonObject(settingsJsonObject);
+        }
         else if (channelSettingsKey == "LocalSourceSettings")
         {
             channelSettings->setLocalSourceSettings(new SWGSDRangel::SWGLocalSourceSettings());
@@ -3465,6 +4005,11 @@ bool WebAPIRequestMapper::getDeviceSettings(
             deviceSettings->setLocalInputSettings(new SWGSDRangel::SWGLocalInputSettings());
             deviceSettings->getLocalInputSettings()->fromJsonObject(settingsJsonObject);
         }
+        else if (deviceSettingsKey == "shmInputSettings")
+        {
+            deviceSettings->setShmInputSettings(new SWGSDRangel::SWGShmInputSettings());
+            deviceSettings->getShmInputSettings()->fromJsonObject(settingsJsonObject);
+        }
         else if (deviceSettingsKey == "remoteOutputSettings")
         {
             deviceSettings->setRemoteOutputSettings(new SWGSDRangel::SWGRemoteOutputSettings());
@@ -17,10 +17,17 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QThread>
 
 #include "ambe/ambeengine.h"
+#include "dsp/dspdevicemimoengine.h"
+#include "dsp/bfmcomposite.h"
+#include "dsp/coherentengine.h"
+#include "testmimo.h"
 
 #include "mainbench.h"
 
@@ -64,6 +71,12 @@ void MainBench::run()
         testDecimateFF();
     } else if (m_parser.getTestType() == ParserBench::TestAMBE) {
         testAMBE();
+    } else if (m_parser.getTestType() == ParserBench::TestMIMOEngine) {
+        testMIMO();
+    } else if (m_parser.getTestType() == ParserBench::TestBFMComposite) {
+        testBFM();
+    } else if (m_parser.getTestType() == ParserBench::TestCoherentEngine) {
+        testCoherent();
     } else {
         qDebug() << "MainBench::run: unknown test type: " << m_parser.getTestType();
     }
@@ -207,6 +220,330 @@ void MainBench::testAMBE()
     }
 }
 
+void MainBench::testMIMO()
+{
+    qDebug() << "MainBench::testMIMO: create test data";
+
+    std::vector<SampleVector> data(m_parser.getNbStreams());
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (std::vector<SampleVector>::iterator it = data.begin(); it != data.end(); ++it)
+    {
+        it->resize(16384);
+
+        for (SampleVector::iterator sit = it->begin(); sit != it->end(); ++sit)
+        {
+            sit->setReal(my_rand());
+            sit->setImag(my_rand());
+        }
+    }
+
+    qDebug() << "MainBench::testMIMO: run test with" << data.size() << "streams";
+
+    printResults("MainBench::testMIMO: sequential (per stream)", runMIMO(data, false));
+    printResults("MainBench::testMIMO: concurrent (per stream)", runMIMO(data, true));
+}
+
+qint64 MainBench::runMIMO(const std::vector<SampleVector>& data, bool concurrentStreams)
+{
+    const unsigned int fifoSize = 8*data[0].size();
+    unsigned int nbStreams = data.size();
+    quint64 nbSamples = (quint64) m_parser.getNbSamples() * m_parser.getRepetition();
+    QElapsedTimer timer;
+
+    DSPDeviceMIMOEngine engine(0);
+    engine.start();
+    TestMIMO testMIMO(nbStreams, fifoSize);
+    engine.setMIMO(&testMIMO);
+    std::vector<TestMIMOSink*> sinks;
+
+    for (unsigned int stream = 0; stream < nbStreams; stream++)
+    {
+        sinks.push_back(new TestMIMOSink());
+        engine.addChannelSink(sinks.back(), stream);
+        engine.configureCorrections(true, true, stream);
+    }
+
+    engine.configureConcurrentStreams(concurrentStreams);
+    engine.initProcess(0);
+    engine.startProcess(0);
+
+    SampleMIFifo *sampleFifo = testMIMO.getSampleMIFifo();
+    std::vector<SampleVector::const_iterator> vbegin(nbStreams);
+    quint64 written = 0;
+    timer.start();
+
+    while (written < nbSamples)
+    {
+        if (sampleFifo->fillSync() > fifoSize/2) // let the engine catch up so that nothing is dropped
+        {
+            QThread::usleep(100);
+            continue;
+        }
+
+        unsigned int chunk = std::min((quint64) data[0].size(), nbSamples - written);
+
+        for (unsigned int stream = 0; stream < nbStreams; stream++) {
+            vbegin[stream] = data[stream].begin();
+        }
+
+        sampleFifo->writeSync(vbegin, chunk);
+        written += chunk;
+    }
+
+    for (unsigned int stream = 0; stream < nbStreams; stream++)
+    {
+        while (sinks[stream]->getSamplesCount() < nbSamples) {
+            QThread::usleep(100);
+        }
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+
+    engine.stopProcess(0);
+
+    for (unsigned int stream = 0; stream < nbStreams; stream++) {
+        engine.removeChannelSink(sinks[stream], stream);
+    }
+
+    engine.stop();
+    engine.wait();
+
+    for (std::vector<TestMIMOSink*>::iterator it = sinks.begin(); it != sinks.end(); ++it) {
+        delete *it;
+    }
+
+    return nsecs;
+}
+
+void MainBench::testBFM()
+{
+    const int sampleRate = 384000; // BFM channel rate
+    const int blockSize = 4096;
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
+    qDebug() << "MainBench::testBFM: create test data";
+
+    // Stereo MPX with a 1 kHz tone on the left channel only, 19 kHz pilot and a 57 kHz BPSK RDS
+    // subcarrier at 1187.5 bit/s. Biphase shaping is not needed for the load.
+    std::vector<Real> mpx(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+    Real rdsSymbol = 1.0f;
+
+    for (unsigned int i = 0; i < mpx.size(); i++)
+    {
+        double t = (double) i / sampleRate;
+        double pilot = 2.0 * M_PI * 19000.0 * t;
+        Real left = 0.5f * std::sin(2.0 * M_PI * 1000.0 * t);
+
+        if (i % (sampleRate * 2 / 2375) == 0) {
+            rdsSymbol = my_rand() < 0.0f ? -1.0f : 1.0f;
+        }
+
+        mpx[i] = 0.45f * (left / 2.0f)
+            + 0.45f * (left / 2.0f) * std::sin(2.0 * pilot)
+            + 0.09f * std::sin(pilot)
+            + 0.04f * rdsSymbol * std::sin(3.0 * pilot)
+            + 0.001f * my_rand();
+    }
+
+    BFMComposite composite;
+    composite.configure(sampleRate, 48000, 15000);
+    composite.setStereo(true, false);
+    composite.setRDS(true);
+    composite.setAudio(true);
+    std::vector<Real> block(blockSize);
+    quint64 nbAudio = 0;
+    quint64 nbRDS = 0;
+
+    qDebug() << "MainBench::testBFM: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        for (unsigned int j = 0; j < mpx.size(); j += blockSize)
+        {
+            unsigned int len = std::min((unsigned int) mpx.size() - j, (unsigned int) blockSize);
+            block.assign(mpx.begin() + j, mpx.begin() + j + len);
+            timer.start();
+            composite.feed(block);
+            nsecs += timer.nsecsElapsed();
+            nbAudio += composite.getMono().size();
+            nbRDS += composite.getRDS().size();
+        }
+    }
+
+    printResults("MainBench::testBFM", nsecs);
+    double seconds = (double) m_parser.getNbSamples() * m_parser.getRepetition() / sampleRate;
+    qInfo("MainBench::testBFM: load at %d S/s: %.2f%% of a core", sampleRate, (nsecs / 1e9) * 100.0 / seconds);
+    qInfo("MainBench::testBFM: pilot %s level %.3f audio rate %.0f S/s (%llu samples) RDS rate %.0f S/s (%llu samples)",
+        composite.getPilotLock() ? "locked" : "unlocked",
+        composite.getPilotLevel(),
+        composite.getAudioRate(),
+        nbAudio,
+        composite.getRDSRate(),
+        nbRDS);
+}
+
+void MainBench::testCoherent()
+{
+    const unsigned int blockSize = 4096;
+    const unsigned int maxDelay = 64;
+    const int maxStreamDelay = 12;        // cable delays in samples
+    const float amplitude = 0.25f;        // of full scale for the source and for the noise of each stream
+    const float angle = 20.0f * M_PI / 180.0f; // of the plane wave from broadside
+    unsigned int nbStreams = m_parser.getNbStreams();
+    unsigned int nbSamples = (m_parser.getNbSamples() / blockSize) * blockSize;
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
+    if ((nbStreams < 2) || (nbSamples < 16*blockSize))
+    {
+        qWarning("MainBench::testCoherent: needs at least 2 streams and %u samples", 16*blockSize);
+        return;
+    }
+
+    qDebug() << "MainBench::testCoherent: create test data";
+
+    // Each stream gets the same source with its own delay and phase rotation (receiver offsets)
+    // and its own noise. The calibration source is at broadside then the source is a plane wave
+    // at angle on an uniform linear array with half wavelength spacing.
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+    std::uniform_int_distribution<int> delayDistribution(0, maxStreamDelay);
+    std::vector<int> delays(nbStreams);
+    std::vector<float> phases(nbStreams);
+
+    for (unsigned int stream = 0; stream < nbStreams; stream++)
+    {
+        delays[stream] = delayDistribution(m_generator);
+        phases[stream] = M_PI * my_rand();
+    }
+
+    std::vector<Complex> source(nbSamples + maxStreamDelay);
+    double sourcePower = 0.0;
+    double noisePower = 0.0;
+
+    for (std::vector<Complex>::iterator it = source.begin(); it != source.end(); ++it)
+    {
+        *it = Complex(amplitude * my_rand(), amplitude * my_rand());
+        sourcePower += std::norm(*it);
+    }
+
+    sourcePower /= source.size();
+    std::vector<SampleVector> calibrationData(nbStreams, SampleVector(16*blockSize));
+    std::vector<SampleVector> beamData(nbStreams, SampleVector(nbSamples));
+
+    for (unsigned int stream = 0; stream < nbStreams; stream++)
+    {
+        Complex offset = std::polar(1.0f, phases[stream]);
+        Complex steering = std::polar(1.0f, (float) (M_PI * std::sin(angle) * stream));
+
+        for (unsigned int i = 0; i < nbSamples; i++)
+        {
+            Complex x = source[i + maxStreamDelay - delays[stream]] * offset;
+            Complex noise(amplitude * my_rand(), amplitude * my_rand());
+            noisePower += std::norm(noise);
+
+            if (i < calibrationData[stream].size())
+            {
+                Complex c = (x + noise) * SDR_RX_SCALEF;
+                calibrationData[stream][i].setReal((FixReal) c.real());
+                calibrationData[stream][i].setImag((FixReal) c.imag());
+            }
+
+            Complex b = (x * steering + noise) * SDR_RX_SCALEF;
+            beamData[stream][i].setReal((FixReal) b.real());
+            beamData[stream][i].setImag((FixReal) b.imag());
+        }
+    }
+
+    noisePower /= (double) nbSamples * nbStreams;
+
+    qDebug() << "MainBench::testCoherent: run test with" << nbStreams << "streams";
+
+    CoherentEngine engine(nbStreams, blockSize, maxDelay);
+    engine.setCovarianceAveraging(0.05f);
+    engine.calibrate(0, maxStreamDelay + 4);
+
+    for (unsigned int i = 0; i < calibrationData[0].size(); i += blockSize)
+    {
+        for (unsigned int stream = 0; stream < nbStreams; stream++) {
+            engine.feed(calibrationData[stream].begin() + i, calibrationData[stream].begin() + i + blockSize, stream);
+        }
+    }
+
+    // recovered lag relative to stream 0 is the difference of the delays applied to the streams
+    int maxLagError = 0;
+    float maxPhaseError = 0.0f;
+
+    for (unsigned int stream = 1; stream < nbStreams; stream++)
+    {
+        int lag = (int) engine.getDelay(0) - (int) engine.getDelay(stream);
+        float phase = engine.getPhase(stream);
+        float phaseError = std::arg(std::polar(1.0f, phase - (phases[stream] - phases[0])));
+        maxLagError = std::max(maxLagError, std::abs(lag - (delays[stream] - delays[0])));
+        maxPhaseError = std::max(maxPhaseError, std::abs(phaseError));
+        qInfo("MainBench::testCoherent: stream %u: lag %d (expected %d) phase %.3f (expected %.3f)",
+            stream, lag, delays[stream] - delays[0], phase, std::arg(std::polar(1.0f, phases[stream] - phases[0])));
+    }
+
+    qInfo("MainBench::testCoherent: calibration: max lag error %d samples max phase error %.4f rad", maxLagError, maxPhaseError);
+
+    const unsigned int nbAngles = 121; // 1 degree steps
+    std::vector<Complex> steeringVectors;
+    CoherentEngine::makeULASteeringVectors(nbStreams, 0.5f, -M_PI/3.0f, M_PI/3.0f, nbAngles, steeringVectors);
+    engine.setSteeringVectors(steeringVectors);
+
+    for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+    {
+        for (unsigned int i = 0; i < nbSamples; i += blockSize)
+        {
+            timer.start();
+
+            for (unsigned int stream = 0; stream < nbStreams; stream++) {
+                engine.feed(beamData[stream].begin() + i, beamData[stream].begin() + i + blockSize, stream);
+            }
+
+            nsecs += timer.nsecsElapsed();
+        }
+    }
+
+    printResults("MainBench::testCoherent: delay and sum (per stream)", nsecs);
+
+    // With R = P a a^H + s2 I the delay and sum power in the source direction is P + s2/N:
+    // the noise is reduced by the number of streams
+    std::vector<float> powers;
+    engine.getBeamPowers(powers);
+    unsigned int peak = std::max_element(powers.begin(), powers.end()) - powers.begin();
+    double beamNoise = powers[peak] - sourcePower;
+    qInfo("MainBench::testCoherent: delay and sum: peak at %.0f deg (expected %.0f deg) SNR gain %.2f dB (expected %.2f dB)",
+        -60.0 + (120.0 * peak) / (nbAngles - 1),
+        angle * 180.0 / M_PI,
+        beamNoise > 0.0 ? 10.0 * std::log10(noisePower / beamNoise) : 0.0,
+        10.0 * std::log10((double) nbStreams));
+
+    engine.setBeamformer(CoherentEngine::BeamformerMVDR);
+    nsecs = 0;
+
+    for (unsigned int i = 0; i < nbSamples; i += blockSize)
+    {
+        timer.start();
+
+        for (unsigned int stream = 0; stream < nbStreams; stream++) {
+            engine.feed(beamData[stream].begin() + i, beamData[stream].begin() + i + blockSize, stream);
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    engine.getBeamPowers(powers);
+    peak = std::max_element(powers.begin(), powers.end()) - powers.begin();
+    qInfo("MainBench::testCoherent: MVDR: %.0f ns per block peak at %.0f deg (expected %.0f deg)",
+        (double) nsecs / (nbSamples / blockSize),
+        -60.0 + (120.0 * peak) / (nbAngles - 1),
+        angle * 180.0 / M_PI);
+}
+
 void MainBench::decimateII(const qint16* buf, int len)
 {
     SampleVector::iterator it = m_convertBuffer.begin();
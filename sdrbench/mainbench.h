@@ -53,6 +53,10 @@ private:
     void testDecimateFI();
     void testDecimateFF();
     void testAMBE();
+    void testMIMO();
+    void testBFM();
+    void testCoherent();
+    qint64 runMIMO(const std::vector<SampleVector>& data, bool concurrentStreams);
     void decimateII(const qint16 *buf, int len);
     void decimateInfII(const qint16 *buf, int len);
     void decimateSupII(const qint16 *buf, int len);
@@ -24,7 +24,7 @@
 
 ParserBench::ParserBench() :
     m_testOption(QStringList() << "t" << "test",
-        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe",
+        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe, mimo, bfm, coherent",
         "test",
         "decimateii"),
     m_nbSamplesOption(QStringList() << "n" << "nb-samples",
@@ -38,12 +38,17 @@ ParserBench::ParserBench() :
     m_log2FactorOption(QStringList() << "l" << "log2-factor",
         "Log2 factor for rate conversion.",
         "log2",
+        "2"),
+    m_nbStreamsOption(QStringList() << "s" << "streams",
+        "Number of streams for MIMO and coherent tests.",
+        "streams",
         "2")
 {
     m_testStr = "decimateii";
     m_nbSamples = 1048576;
     m_repetition = 1;
     m_log2Factor = 4;
+    m_nbStreams = 2;
 
     m_parser.setApplicationDescription("Software Defined Radio application benchmarks");
     m_parser.addHelpOption();
@@ -53,6 +58,7 @@ ParserBench::ParserBench() :
     m_parser.addOption(m_nbSamplesOption);
     m_parser.addOption(m_repetitionOption);
     m_parser.addOption(m_log2FactorOption);
+    m_parser.addOption(m_nbStreamsOption);
 }
 
 ParserBench::~ParserBench()
@@ -111,6 +117,17 @@ void ParserBench::parse(const QCoreApplication& app)
     } else {
         qWarning() << "ParserBench::parse: repetilog2 factortion invalid. Defaulting to " << m_log2Factor;
     }
+
+    // number of streams
+
+    QString nbStreamsStr = m_parser.value(m_nbStreamsOption);
+    int nbStreams = nbStreamsStr.toInt(&ok);
+
+    if (ok && (nbStreams > 0) && (nbStreams <= 16)) {
+        m_nbStreams = nbStreams;
+    } else {
+        qWarning() << "ParserBench::parse: number of streams invalid. Defaulting to " << m_nbStreams;
+    }
 }
 
 ParserBench::TestType ParserBench::getTestType() const
@@ -127,6 +144,12 @@ ParserBench::TestType ParserBench::getTestType() const
         return TestDecimatorsSupII;
     } else if (m_testStr == "ambe") {
         return TestAMBE;
+    } else if (m_testStr == "mimo") {
+        return TestMIMOEngine;
+    } else if (m_testStr == "bfm") {
+        return TestBFMComposite;
+    } else if (m_testStr == "coherent") {
+        return TestCoherentEngine;
     } else {
         return TestDecimatorsII;
     }
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "testmimo.h"
+
+TestMIMO::TestMIMO(unsigned int nbStreams, unsigned int fifoSize) :
+    m_deviceDescription("TestMIMO"),
+    m_sampleRate(48000)
+{
+    m_mimoType = MIMOHalfSynchronous;
+    m_sampleMIFifo.init(nbStreams, fifoSize);
+}
+
+TestMIMO::~TestMIMO()
+{}
+
+TestMIMOSink::TestMIMOSink() :
+    m_sum(0, 0),
+    m_samplesCount(0)
+{
+    m_nco.setFreq(-3000, 48000);
+    m_lowpass.create(65, 48000, 5000);
+}
+
+TestMIMOSink::~TestMIMOSink()
+{}
+
+void TestMIMOSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
+{
+    (void) positiveOnly;
+
+    for (SampleVector::const_iterator it = begin; it != end; ++it)
+    {
+        Complex c(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
+        c *= m_nco.nextIQ();
+        m_sum += m_lowpass.filter(c);
+    }
+
+    m_samplesCount += end - begin;
+}
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBENCH_TESTMIMO_H_
+#define SDRBENCH_TESTMIMO_H_
+
+#include <atomic>
+
+#include "dsp/devicesamplemimo.h"
+#include "dsp/basebandsamplesink.h"
+#include "dsp/nco.h"
+#include "dsp/lowpass.h"
+
+/**
+ * Synthetic synchronous MIMO device. It has no hardware behind: the benchmark writes
+ * samples directly in its Rx FIFO.
+ */
+class TestMIMO : public DeviceSampleMIMO
+{
+public:
+    TestMIMO(unsigned int nbStreams, unsigned int fifoSize);
+    virtual ~TestMIMO();
+    virtual void destroy() { delete this; }
+
+    virtual void init() {}
+    virtual bool startRx() { return true; }
+    virtual void stopRx() {}
+    virtual bool startTx() { return true; }
+    virtual void stopTx() {}
+
+    virtual QByteArray serialize() const { return QByteArray(); }
+    virtual bool deserialize(const QByteArray& data) { (void) data; return true; }
+
+    virtual const QString& getDeviceDescription() const { return m_deviceDescription; }
+
+    virtual int getSinkSampleRate(int index) const { (void) index; return m_sampleRate; }
+    virtual void setSinkSampleRate(int sampleRate, int index) { (void) sampleRate; (void) index; }
+    virtual quint64 getSinkCenterFrequency(int index) const { (void) index; return 0; }
+    virtual void setSinkCenterFrequency(qint64 centerFrequency, int index) { (void) centerFrequency; (void) index; }
+
+    virtual int getSourceSampleRate(int index) const { (void) index; return m_sampleRate; }
+    virtual void setSourceSampleRate(int sampleRate, int index) { (void) sampleRate; (void) index; }
+    virtual quint64 getSourceCenterFrequency(int index) const { (void) index; return 0; }
+    virtual void setSourceCenterFrequency(qint64 centerFrequency, int index) { (void) centerFrequency; (void) index; }
+
+    virtual quint64 getMIMOCenterFrequency() const { return 0; }
+    virtual unsigned int getMIMOSampleRate() const { return m_sampleRate; }
+
+    virtual bool handleMessage(const Message& message) { (void) message; return false; }
+    virtual void setMessageQueueToGUI(MessageQueue *queue) { m_guiMessageQueue = queue; }
+
+private:
+    QString m_deviceDescription;
+    int m_sampleRate;
+};
+
+/**
+ * Channel sink with the load of a typical channel front end: NCO shift and low pass filter.
+ * It only counts the samples it has processed.
+ */
+class TestMIMOSink : public BasebandSampleSink
+{
+public:
+    TestMIMOSink();
+    virtual ~TestMIMOSink();
+
+    virtual void start() {}
+    virtual void stop() {}
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
+    virtual bool handleMessage(const Message& cmd) { (void) cmd; return false; }
+
+    quint64 getSamplesCount() const { return m_samplesCount; }
+
+private:
+    NCO m_nco;
+    Lowpass<Complex> m_lowpass;
+    Complex m_sum;
+    std::atomic<quint64> m_samplesCount;
+};
+
+#endif // SDRBENCH_TESTMIMO_H_
@@ -16,11 +16,15 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QFont>
+#include <QThread>
 
 #include <algorithm>
 
 #include "gui/glspectrum.h"
 #include "dsp/spectrumvis.h"
+#include "dsp/spectrumarchivesink.h"
+#include "dsp/panoramaengine.h"
+#include "device/deviceapi.h"
 #include "gui/glspectrumgui.h"
 #include "gui/channelwindow.h"
 #include "dsp/dspdevicesourceengine.h"
@@ -56,6 +60,8 @@ DeviceUISet::DeviceUISet(int tabIndex, int deviceType, QTimer& timer)
     m_deviceSourceEngine = nullptr;
     m_deviceSinkEngine = nullptr;
     m_deviceMIMOEngine = nullptr;
+    m_spectrumArchive = nullptr;
+    m_panorama = nullptr;
     m_deviceTabIndex = tabIndex;
     m_nbAvailableRxChannels = 0;   // updated at enumeration for UI selector
     m_nbAvailableTxChannels = 0;   // updated at enumeration for UI selector
@@ -70,12 +76,85 @@ DeviceUISet::DeviceUISet(int tabIndex, int deviceType, QTimer& timer)
 
 DeviceUISet::~DeviceUISet()
 {
+    stopPanorama();
+    stopSpectrumArchive();
     delete m_channelWindow;
     delete m_spectrumGUI;
     delete m_spectrumVis;
     delete m_spectrum;
 }
 
+bool DeviceUISet::startSpectrumArchive(const QString& directory, int fftSize, float rowsPerSecond)
+{
+    if (!m_deviceSourceEngine) { // Rx only
+        return false;
+    }
+
+    stopSpectrumArchive();
+    m_spectrumArchive = new SpectrumArchiveSink();
+
+    if (!m_spectrumArchive->open(directory, fftSize, rowsPerSecond))
+    {
+        delete m_spectrumArchive;
+        m_spectrumArchive = nullptr;
+        return false;
+    }
+
+    m_deviceSourceEngine->addSink(m_spectrumArchive);
+    return true;
+}
+
+void DeviceUISet::stopSpectrumArchive()
+{
+    if (!m_spectrumArchive) {
+        return;
+    }
+
+    m_deviceSourceEngine->removeSink(m_spectrumArchive);
+    delete m_spectrumArchive;
+    m_spectrumArchive = nullptr;
+}
+
+bool DeviceUISet::startPanorama(const PanoramaEngine::Settings& settings, const QString& wsAddress, quint16 wsPort)
+{
+    if (!m_deviceSourceEngine || !settings.isValid()) { // Rx only
+        return false;
+    }
+
+    stopPanorama();
+    m_panorama = new PanoramaEngine(m_deviceAPI->getSampleSource(), settings);
+    m_spectrumVis->setGLSpectrum(nullptr); // the panorama takes over the spectrum display
+    m_panorama->setGLSpectrum(m_spectrum);
+
+    if (wsPort != 0) {
+        m_panorama->openWSSpectrum(wsAddress, wsPort);
+    }
+
+    m_deviceSourceEngine->addSink(m_panorama);
+    return true;
+}
+
+void DeviceUISet::stopPanorama()
+{
+    if (!m_panorama) {
+        return;
+    }
+
+    m_deviceSourceEngine->removeSink(m_panorama);
+    m_panorama->restoreCenterFrequency();
+    m_spectrum->stopPanorama();
+    m_spectrumVis->setGLSpectrum(m_spectrum);
+
+    // the engine belongs to the main thread where its web socket server runs
+    if (m_panorama->thread() == QThread::currentThread()) {
+        delete m_panorama;
+    } else {
+        m_panorama->deleteLater();
+    }
+
+    m_panorama = nullptr;
+}
+
 void DeviceUISet::setSpectrumScalingFactor(float scalef)
 {
     m_spectrumVis->setScalef(scalef);
@@ -21,9 +21,11 @@
 #include <QTimer>
 #include <QByteArray>
 
+#include "dsp/panoramaengine.h"
 #include "export.h"
 
 class SpectrumVis;
+class SpectrumArchiveSink;
 class GLSpectrum;
 class GLSpectrumGUI;
 class ChannelWindow;
@@ -47,6 +49,8 @@ public:
     DSPDeviceSourceEngine *m_deviceSourceEngine;
     DSPDeviceSinkEngine *m_deviceSinkEngine;
     DSPDeviceMIMOEngine *m_deviceMIMOEngine;
+    SpectrumArchiveSink *m_spectrumArchive;
+    PanoramaEngine *m_panorama;
     QByteArray m_mainWindowState;
 
     DeviceUISet(int tabIndex, int deviceType, QTimer& timer);
@@ -72,6 +76,10 @@ public:
     void saveTxChannelSettings(Preset* preset);
     void loadMIMOChannelSettings(const Preset* preset, PluginAPI *pluginAPI);
     void saveMIMOChannelSettings(Preset* preset);
+    bool startSpectrumArchive(const QString& directory, int fftSize, float rowsPerSecond);
+    void stopSpectrumArchive();
+    bool startPanorama(const PanoramaEngine::Settings& settings, const QString& wsAddress, quint16 wsPort);
+    void stopPanorama();
 
     // These are the number of channel types available for selection
     void setNumberOfAvailableRxChannels(int number) { m_nbAvailableRxChannels = number; }
@@ -46,6 +46,9 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
 	m_decay(1),
 	m_sampleRate(500000),
 	m_timingRate(1),
+	m_panorama(false),
+	m_deviceCenterFrequency(100000000),
+	m_deviceSampleRate(500000),
 	m_fftSize(512),
 	m_displayGrid(true),
 	m_displayGridIntensity(5),
@@ -189,6 +192,14 @@ GLSpectrum::~GLSpectrum()
 void GLSpectrum::setCenterFrequency(qint64 frequency)
 {
 	m_mutex.lock();
+
+	if (m_panorama) // keep it for when the panorama stops
+	{
+		m_deviceCenterFrequency = frequency;
+		m_mutex.unlock();
+		return;
+	}
+
 	m_centerFrequency = frequency;
 	m_changesPending = true;
 	m_mutex.unlock();
@@ -231,6 +242,14 @@ void GLSpectrum::setHistoStroke(int stroke)
 void GLSpectrum::setSampleRate(qint32 sampleRate)
 {
     m_mutex.lock();
+
+	if (m_panorama) // keep it for when the panorama stops
+	{
+		m_deviceSampleRate = sampleRate;
+		m_mutex.unlock();
+		return;
+	}
+
 	m_sampleRate = sampleRate;
 	if (m_messageQueueToGUI) {
 	    m_messageQueueToGUI->push(new MsgReportSampleRate(m_sampleRate));
@@ -420,6 +439,43 @@ void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
 	updateHistogram(spectrum);
 }
 
+void GLSpectrum::newPanorama(const std::vector<Real>& spectrum, qint64 centerFrequency, int span)
+{
+	m_mutex.lock();
+
+	if (!m_panorama)
+	{
+		m_panorama = true;
+		m_deviceCenterFrequency = m_centerFrequency;
+		m_deviceSampleRate = m_sampleRate;
+	}
+
+	if ((centerFrequency != m_centerFrequency) || ((quint32) span != m_sampleRate))
+	{
+		m_centerFrequency = centerFrequency;
+		m_sampleRate = span;
+		m_changesPending = true;
+	}
+
+	m_mutex.unlock();
+	newSpectrum(spectrum, spectrum.size()); // called from the DSP thread: repaint is left to the timer
+}
+
+void GLSpectrum::stopPanorama()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (!m_panorama) {
+		return;
+	}
+
+	m_panorama = false;
+	m_centerFrequency = m_deviceCenterFrequency;
+	m_sampleRate = m_deviceSampleRate;
+	m_changesPending = true;
+	m_displayChanged = true;
+}
+
 void GLSpectrum::updateWaterfall(const std::vector<Real>& spectrum)
 {
 	if (m_waterfallBufferPos < m_waterfallBuffer->height())
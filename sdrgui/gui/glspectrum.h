@@ -103,6 +103,8 @@ public:
 	void setMessageQueueToGUI(MessageQueue* messageQueue) { m_messageQueueToGUI = messageQueue; }
 
 	virtual void newSpectrum(const std::vector<Real>& spectrum, int fftSize);
+	virtual void newPanorama(const std::vector<Real>& spectrum, qint64 centerFrequency, int span);
+	virtual void stopPanorama();
 	void clearSpectrumHistogram();
 
 	Real getWaterfallShare() const { return m_waterfallShare; }
@@ -246,6 +248,9 @@ private:
 	int m_decay;
 	quint32 m_sampleRate;
 	quint32 m_timingRate;
+	bool m_panorama;                  //!< Display is driven by a panorama scan
+	qint64 m_deviceCenterFrequency;   //!< Device center frequency to restore after the panorama
+	quint32 m_deviceSampleRate;       //!< Device sample rate to restore after the panorama
 
 	int m_fftSize;
 
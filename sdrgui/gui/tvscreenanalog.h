@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <algorithm>
+#include <stdint.h>
 
 #include <QMutex>
 #include <QTimer>
@@ -100,6 +101,22 @@ public:
 		}
 	}
 
+	// Sets a whole row of already resampled pixels starting at column 0 (no line shift)
+	void setRow(int line, const uint8_t *values, int nbValues)
+	{
+		if ((line < m_height) && (line >= 0))
+		{
+			int *row = m_imageData + line * m_width;
+			int n = std::min(nbValues, m_width - 2);
+
+			for (int i = 0; i < n; i++) {
+				row[i + 2] = values[i];
+			}
+
+			m_lineShiftData[line] = 127;
+		}
+	}
+
 private:
 	int m_width;
 	int m_height;
@@ -34,11 +34,14 @@
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
 #include "dsp/dspengine.h"
+#include "dsp/spectrumarchivesink.h"
+#include "dsp/panoramaengine.h"
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
 #include "channel/channelapi.h"
 #include "webapi/webapiadapterbase.h"
 #include "util/serialutil.h"
+#include "rds/rdsstationdb.h"
 
 #include "SWGInstanceSummaryResponse.h"
 #include "SWGInstanceConfigResponse.h"
@@ -1370,6 +1373,44 @@ int WebAPIAdapterGUI::instanceDeviceSetDelete(
     }
 }
 
+int WebAPIAdapterGUI::instanceRDSStationsGet(
+        quint64 since,
+        QJsonObject& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    std::vector<RDSStationDB::Station> stations;
+    quint64 serial, generation;
+    RDSStationDB::instance()->getUpdates(since, stations, serial, generation);
+    RDSStationDB::formatStations(stations, serial, generation, response);
+
+    return 200;
+}
+
+int WebAPIAdapterGUI::instanceRDSStationsDelete(
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    RDSStationDB::instance()->clear();
+    response.init();
+    *response.getMessage() = QString("RDS station database cleared");
+
+    return 200;
+}
+
+int WebAPIAdapterGUI::instanceAMBEPoolGet(
+        QJsonObject& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    std::vector<MBEWorkerPool::WorkerLoad> loads;
+    DSPEngine::instance()->getMBEWorkerPool()->getLoad(loads);
+    MBEWorkerPool::formatLoad(loads, response);
+
+    return 200;
+}
+
 int WebAPIAdapterGUI::devicesetGet(
         int deviceSetIndex,
         SWGSDRangel::SWGDeviceSet& response,
@@ -2387,6 +2428,44 @@ int WebAPIAdapterGUI::devicesetChannelReportGet(
     }
 }
 
+int WebAPIAdapterGUI::devicesetChannelFrameGet(
+        int deviceSetIndex,
+        int channelIndex,
+        const QString& format,
+        int scale,
+        int quality,
+        quint64 since,
+        QByteArray& frame,
+        QString& mimeType,
+        quint64& frameIndex,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        ChannelAPI *channelAPI = nullptr;
+
+        if (deviceSet->m_deviceSourceEngine || deviceSet->m_deviceMIMOEngine) { // video comes from Rx channels only
+            channelAPI = deviceSet->m_deviceAPI->getChanelSinkAPIAt(channelIndex);
+        }
+
+        if (channelAPI == nullptr)
+        {
+            *error.getMessage() = QString("There is no Rx channel with index %1").arg(channelIndex);
+            return 404;
+        }
+
+        return channelAPI->webapiVideoFrameGet(format, scale, quality, since, frame, mimeType, frameIndex, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
 int WebAPIAdapterGUI::devicesetChannelActionsPost(
         int deviceSetIndex,
         int channelIndex,
@@ -2677,6 +2756,344 @@ int WebAPIAdapterGUI::devicesetChannelSettingsPutPatch(
     }
 }
 
+int WebAPIAdapterGUI::devicesetDeviceCompactGet(
+        int deviceSetIndex,
+        bool& compactSamples,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (!deviceSet->m_deviceSourceEngine)
+        {
+            error.init();
+            *error.getMessage() = QString("Device set %1 is not a Rx device set").arg(deviceSetIndex);
+            return 400;
+        }
+
+        compactSamples = deviceSet->m_deviceAPI->getCompactSamples();
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetDeviceCompactPut(
+        int deviceSetIndex,
+        bool compactSamples,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (!deviceSet->m_deviceSourceEngine)
+        {
+            error.init();
+            *error.getMessage() = QString("Device set %1 is not a Rx device set").arg(deviceSetIndex);
+            return 400;
+        }
+
+        deviceSet->m_deviceAPI->configureCompactSamples(compactSamples);
+        response.init();
+        *response.getMessage() = QString("Message to set compact samples (DSPConfigureCompactSamples) was submitted successfully");
+
+        return 202;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetDeviceFloatGet(
+        int deviceSetIndex,
+        bool& floatSamples,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (!deviceSet->m_deviceSourceEngine)
+        {
+            error.init();
+            *error.getMessage() = QString("Device set %1 is not a Rx device set").arg(deviceSetIndex);
+            return 400;
+        }
+
+        floatSamples = deviceSet->m_deviceAPI->getFloatSamples();
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetDeviceFloatPut(
+        int deviceSetIndex,
+        bool floatSamples,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (!deviceSet->m_deviceSourceEngine)
+        {
+            error.init();
+            *error.getMessage() = QString("Device set %1 is not a Rx device set").arg(deviceSetIndex);
+            return 400;
+        }
+
+        deviceSet->m_deviceAPI->configureFloatSamples(floatSamples);
+        response.init();
+        *response.getMessage() = QString("Float baseband request set. Effective at next device start");
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumArchivePost(
+        int deviceSetIndex,
+        const QString& directory,
+        int fftSize,
+        float rowsPerSecond,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (!deviceSet->m_deviceSourceEngine)
+        {
+            error.init();
+            *error.getMessage() = QString("Device set %1 is not a Rx device set").arg(deviceSetIndex);
+            return 400;
+        }
+
+        if (!deviceSet->startSpectrumArchive(directory, fftSize, rowsPerSecond))
+        {
+            error.init();
+            *error.getMessage() = QString("Cannot open spectrum archive in %1").arg(directory);
+            return 500;
+        }
+
+        response.init();
+        *response.getMessage() = QString("Spectrum archive started in %1").arg(directory);
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumArchiveDelete(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (!deviceSet->m_spectrumArchive)
+        {
+            error.init();
+            *error.getMessage() = QString("Device set %1 has no spectrum archive running").arg(deviceSetIndex);
+            return 404;
+        }
+
+        deviceSet->stopSpectrumArchive();
+        response.init();
+        *response.getMessage() = QString("Spectrum archive stopped");
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumArchiveGet(
+        int deviceSetIndex,
+        qint64 fromMs,
+        qint64 toMs,
+        qint64 fromHz,
+        qint64 toHz,
+        int maxRows,
+        int maxBins,
+        QJsonObject& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (!deviceSet->m_spectrumArchive)
+        {
+            error.init();
+            *error.getMessage() = QString("Device set %1 has no spectrum archive running").arg(deviceSetIndex);
+            return 404;
+        }
+
+        std::vector<SpectrumArchive::Window> windows;
+
+        if (!deviceSet->m_spectrumArchive->getArchive().query(fromMs, toMs, fromHz, toHz, maxRows, maxBins, windows))
+        {
+            error.init();
+            *error.getMessage() = QString("Invalid spectrum archive query");
+            return 400;
+        }
+
+        SpectrumArchive::formatWindows(windows, response);
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumPanoramaPost(
+        int deviceSetIndex,
+        const PanoramaEngine::Settings& settings,
+        const QString& wsAddress,
+        quint16 wsPort,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (!deviceSet->m_deviceSourceEngine)
+        {
+            error.init();
+            *error.getMessage() = QString("Device set %1 is not a Rx device set").arg(deviceSetIndex);
+            return 400;
+        }
+
+        if (!deviceSet->startPanorama(settings, wsAddress, wsPort))
+        {
+            error.init();
+            *error.getMessage() = QString("Cannot start panorama on device set %1").arg(deviceSetIndex);
+            return 500;
+        }
+
+        response.init();
+        *response.getMessage() = QString("Panorama started from %1 to %2 Hz").arg(settings.m_fromHz).arg(settings.m_toHz);
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumPanoramaDelete(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (!deviceSet->m_panorama)
+        {
+            error.init();
+            *error.getMessage() = QString("Device set %1 has no panorama running").arg(deviceSetIndex);
+            return 404;
+        }
+
+        deviceSet->stopPanorama();
+        response.init();
+        *response.getMessage() = QString("Panorama stopped");
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumPanoramaGet(
+        int deviceSetIndex,
+        int maxBins,
+        QJsonObject& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+
+        if (!deviceSet->m_panorama)
+        {
+            error.init();
+            *error.getMessage() = QString("Device set %1 has no panorama running").arg(deviceSetIndex);
+            return 404;
+        }
+
+        deviceSet->m_panorama->formatPanorama(response, maxBins);
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
 void WebAPIAdapterGUI::getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList)
 {
     deviceSetList->init();
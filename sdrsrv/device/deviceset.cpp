@@ -17,8 +17,13 @@
 
 #include <algorithm>
 
+#include <QThread>
+
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/spectrumarchivesink.h"
+#include "dsp/panoramaengine.h"
+#include "device/deviceapi.h"
 #include "plugin/pluginapi.h"
 #include "plugin/plugininterface.h"
 #include "settings/preset.h"
@@ -40,11 +45,82 @@ DeviceSet::DeviceSet(int tabIndex)
     m_deviceSourceEngine = nullptr;
     m_deviceSinkEngine = nullptr;
     m_deviceMIMOEngine = nullptr;
+    m_spectrumArchive = nullptr;
+    m_panorama = nullptr;
     m_deviceTabIndex = tabIndex;
 }
 
 DeviceSet::~DeviceSet()
 {
+    stopPanorama();
+    stopSpectrumArchive();
+}
+
+bool DeviceSet::startSpectrumArchive(const QString& directory, int fftSize, float rowsPerSecond)
+{
+    if (!m_deviceSourceEngine) { // Rx only
+        return false;
+    }
+
+    stopSpectrumArchive();
+    m_spectrumArchive = new SpectrumArchiveSink();
+
+    if (!m_spectrumArchive->open(directory, fftSize, rowsPerSecond))
+    {
+        delete m_spectrumArchive;
+        m_spectrumArchive = nullptr;
+        return false;
+    }
+
+    m_deviceSourceEngine->addSink(m_spectrumArchive);
+    return true;
+}
+
+void DeviceSet::stopSpectrumArchive()
+{
+    if (!m_spectrumArchive) {
+        return;
+    }
+
+    m_deviceSourceEngine->removeSink(m_spectrumArchive);
+    delete m_spectrumArchive;
+    m_spectrumArchive = nullptr;
+}
+
+bool DeviceSet::startPanorama(const PanoramaEngine::Settings& settings, const QString& wsAddress, quint16 wsPort)
+{
+    if (!m_deviceSourceEngine || !settings.isValid()) { // Rx only
+        return false;
+    }
+
+    stopPanorama();
+    m_panorama = new PanoramaEngine(m_deviceAPI->getSampleSource(), settings);
+
+    if (wsPort != 0) {
+        m_panorama->openWSSpectrum(wsAddress, wsPort);
+    }
+
+    m_deviceSourceEngine->addSink(m_panorama);
+    return true;
+}
+
+void DeviceSet::stopPanorama()
+{
+    if (!m_panorama) {
+        return;
+    }
+
+    m_deviceSourceEngine->removeSink(m_panorama);
+    m_panorama->restoreCenterFrequency();
+
+    // the engine belongs to the main thread where its web socket server runs
+    if (m_panorama->thread() == QThread::currentThread()) {
+        delete m_panorama;
+    } else {
+        m_panorama->deleteLater();
+    }
+
+    m_panorama = nullptr;
 }
 
 void DeviceSet::registerRxChannelInstance(const QString& channelName, ChannelAPI* channelAPI)
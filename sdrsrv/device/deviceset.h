@@ -20,6 +20,8 @@
 
 #include <QTimer>
 
+#include "dsp/panoramaengine.h"
+
 class DeviceAPI;
 class DSPDeviceSourceEngine;
 class DSPDeviceSinkEngine;
@@ -27,6 +29,7 @@ class DSPDeviceMIMOEngine;
 class PluginAPI;
 class ChannelAPI;
 class Preset;
+class SpectrumArchiveSink;
 
 class DeviceSet
 {
@@ -35,6 +38,8 @@ public:
     DSPDeviceSourceEngine *m_deviceSourceEngine;
     DSPDeviceSinkEngine *m_deviceSinkEngine;
     DSPDeviceMIMOEngine *m_deviceMIMOEngine;
+    SpectrumArchiveSink *m_spectrumArchive;
+    PanoramaEngine *m_panorama;
 
     DeviceSet(int tabIndex);
     ~DeviceSet();
@@ -57,6 +62,10 @@ public:
     void saveTxChannelSettings(Preset* preset);
     void loadMIMOChannelSettings(const Preset* preset, PluginAPI *pluginAPI);
     void saveMIMOChannelSettings(Preset* preset);
+    bool startSpectrumArchive(const QString& directory, int fftSize, float rowsPerSecond);
+    void stopSpectrumArchive();
+    bool startPanorama(const PanoramaEngine::Settings& settings, const QString& wsAddress, quint16 wsPort);
+    void stopPanorama();
 
 private:
     struct ChannelInstanceRegistration
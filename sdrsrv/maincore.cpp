@@ -33,6 +33,7 @@
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
 #include "webapi/webapiadaptersrv.h"
+#include "offline/offlineprocessor.h"
 
 #include "maincore.h"
 
@@ -55,7 +56,8 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_masterTabIndex(-1),
     m_dspEngine(DSPEngine::instance()),
     m_lastEngineState(DSPDeviceSourceEngine::StNotStarted),
-    m_logger(logger)
+    m_logger(logger),
+    m_offlineProcessor(nullptr)
 {
     qDebug() << "MainCore::MainCore: start";
 
@@ -85,15 +87,36 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_apiHost = parser.getServerAddress();
     m_apiPort = parser.getServerPort();
     m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
-    m_apiServer->start();
 
     m_dspEngine->setMIMOSupport(parser.getMIMOSupport());
 
+    if (parser.isBatchMode()) // no API server in batch mode as the device sets are not exposed
+    {
+        m_offlineProcessor = new OfflineProcessor(
+            m_settings,
+            m_pluginManager->getPluginAPI(),
+            parser.getBatchFileName(),
+            parser.getBatchPreset(),
+            parser.getBatchWorkers(),
+            parser.getBatchOverlapMs(),
+            parser.getBatchOutputDir(),
+            this
+        );
+        connect(m_offlineProcessor, SIGNAL(finished()), this, SIGNAL(finished()));
+        QTimer::singleShot(0, this, SLOT(startBatch()));
+    }
+    else
+    {
+        m_apiServer->start();
+    }
+
     qDebug() << "MainCore::MainCore: end";
 }
 
 MainCore::~MainCore()
 {
+    delete m_offlineProcessor;
+
     while (m_deviceSets.size() > 0) {
         removeLastDevice();
     }
@@ -213,6 +236,15 @@ void MainCore::handleMessages()
     }
 }
 
+void MainCore::startBatch()
+{
+    qDebug() << "MainCore::startBatch";
+
+    if (!m_offlineProcessor->start()) {
+        emit finished();
+    }
+}
+
 void MainCore::loadSettings()
 {
 	qDebug() << "MainCore::loadSettings";
@@ -374,6 +406,8 @@ void MainCore::removeLastDevice()
     {
         DSPDeviceSourceEngine *lastDeviceEngine = m_deviceSets.back()->m_deviceSourceEngine;
         lastDeviceEngine->stopAcquistion();
+        m_deviceSets.back()->stopSpectrumArchive();
+        m_deviceSets.back()->stopPanorama();
 
         // deletes old UI and input object
         m_deviceSets.back()->freeChannels();      // destroys the channel instances
@@ -40,6 +40,7 @@ class DeviceSet;
 class WebAPIRequestMapper;
 class WebAPIServer;
 class WebAPIAdapterSrv;
+class OfflineProcessor;
 
 namespace qtwebapp {
     class LoggerWithFile;
@@ -302,6 +303,7 @@ private:
     WebAPIRequestMapper *m_requestMapper;
     WebAPIServer *m_apiServer;
     WebAPIAdapterSrv *m_apiAdapter;
+    OfflineProcessor *m_offlineProcessor;
 
 	void loadSettings();
     void applySettings();
@@ -313,6 +315,7 @@ private:
 
 private slots:
     void handleMessages();
+    void startBatch();
 };
 
 
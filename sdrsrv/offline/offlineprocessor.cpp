@@ -0,0 +1,402 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <fstream>
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include "SWGChannelSettings.h"
+#include "SWGFileSinkSettings.h"
+#include "SWGChannelActions.h"
+#include "SWGFileSinkActions.h"
+
+#include "dsp/dspengine.h"
+#include "dsp/dspdevicesourceengine.h"
+#include "device/deviceapi.h"
+#include "channel/channelapi.h"
+#include "settings/mainsettings.h"
+#include "settings/preset.h"
+#include "device/deviceset.h"
+
+#include "offlinesource.h"
+#include "offlineprocessor.h"
+
+const int OfflineProcessor::m_tailTicks = 10; // 1s after the source FIFO is empty
+
+OfflineProcessor::OfflineProcessor(
+        const MainSettings& mainSettings,
+        PluginAPI *pluginAPI,
+        const QString& fileName,
+        const QString& presetName,
+        int nbWorkers,
+        int overlapMs,
+        const QString& outputDir,
+        QObject *parent) :
+    QObject(parent),
+    m_mainSettings(mainSettings),
+    m_pluginAPI(pluginAPI),
+    m_fileName(fileName),
+    m_presetName(presetName),
+    m_nbWorkers(nbWorkers < 1 ? 1 : nbWorkers),
+    m_overlapMs(overlapMs < 0 ? 0 : overlapMs),
+    m_outputDir(outputDir),
+    m_nbSamples(0)
+{
+    connect(&m_pollTimer, SIGNAL(timeout()), this, SLOT(tick()));
+}
+
+OfflineProcessor::~OfflineProcessor()
+{
+    m_pollTimer.stop();
+    destroyDeviceSets();
+}
+
+void OfflineProcessor::computeSegments(quint64 nbSamples, int nbSegments, quint64 overlapSamples, std::vector<Segment>& segments)
+{
+    segments.clear();
+
+    if ((nbSamples == 0) || (nbSegments < 1)) {
+        return;
+    }
+
+    quint64 segmentSize = (nbSamples + nbSegments - 1) / nbSegments;
+
+    for (quint64 start = 0; start < nbSamples; start += segmentSize)
+    {
+        quint64 end = std::min(start + segmentSize, nbSamples);
+        segments.push_back(Segment(start, end, std::min(start, overlapSamples)));
+    }
+}
+
+bool OfflineProcessor::start()
+{
+    const Preset *preset = findPreset();
+
+    if (!preset)
+    {
+        qCritical("OfflineProcessor::start: Rx preset %s not found", qPrintable(m_presetName));
+        return false;
+    }
+
+    if (!readHeader()) {
+        return false;
+    }
+
+    QDir().mkpath(m_outputDir);
+
+    std::vector<Segment> segments;
+    quint64 overlapSamples = ((quint64) m_header.sampleRate * m_overlapMs) / 1000;
+    computeSegments(m_nbSamples, m_nbWorkers, overlapSamples, segments);
+    m_segments.resize(segments.size());
+
+    qInfo("OfflineProcessor::start: %s: %llu samples at %u S/s in %d segments with %llu samples overlap",
+        qPrintable(m_fileName), m_nbSamples, m_header.sampleRate, (int) segments.size(), overlapSamples);
+
+    for (unsigned int i = 0; i < segments.size(); i++)
+    {
+        m_segments[i].m_segment = segments[i];
+        createDeviceSet(i, preset);
+        configureFileSinks(i);
+    }
+
+    for (unsigned int i = 0; i < m_segments.size(); i++)
+    {
+        m_segments[i].m_deviceSet->m_deviceAPI->initDeviceEngine();
+        m_segments[i].m_deviceSet->m_deviceAPI->startDeviceEngine();
+        m_segments[i].m_state = SegmentArmed;
+    }
+
+    m_elapsedTimer.start();
+    m_pollTimer.start(100);
+    return true;
+}
+
+const Preset *OfflineProcessor::findPreset() const
+{
+    // preset is given as "group:description" or just "description"
+    int sep = m_presetName.indexOf(":");
+    QString group = sep < 0 ? QString() : m_presetName.left(sep);
+    QString description = sep < 0 ? m_presetName : m_presetName.mid(sep + 1);
+
+    for (int i = 0; i < m_mainSettings.getPresetCount(); i++)
+    {
+        const Preset *preset = m_mainSettings.getPreset(i);
+
+        if (preset->isSourcePreset()
+            && (preset->getDescription() == description)
+            && (group.isEmpty() || (preset->getGroup() == group))) {
+            return preset;
+        }
+    }
+
+    return nullptr;
+}
+
+bool OfflineProcessor::readHeader()
+{
+    std::ifstream sampleFile(m_fileName.toStdString().c_str(), std::ios::binary | std::ios::ate);
+
+    if (!sampleFile.is_open())
+    {
+        qCritical("OfflineProcessor::readHeader: cannot open %s", qPrintable(m_fileName));
+        return false;
+    }
+
+    quint64 fileSize = sampleFile.tellg();
+    sampleFile.seekg(0, std::ios::beg);
+
+    if (!FileRecord::readHeader(sampleFile, m_header))
+    {
+        qCritical("OfflineProcessor::readHeader: %s: bad header CRC", qPrintable(m_fileName));
+        return false;
+    }
+
+    if ((m_header.sampleSize != 16) && (m_header.sampleSize != 24))
+    {
+        qCritical("OfflineProcessor::readHeader: %s: unsupported sample size %u", qPrintable(m_fileName), m_header.sampleSize);
+        return false;
+    }
+
+    quint64 sampleBytes = m_header.sampleSize > 16 ? sizeof(int32_t) : sizeof(int16_t);
+    m_nbSamples = (fileSize - sizeof(FileRecord::Header)) / (2 * sampleBytes);
+
+    return m_nbSamples > 0;
+}
+
+void OfflineProcessor::createDeviceSet(int segmentIndex, const Preset *preset)
+{
+    SegmentProcess& segmentProcess = m_segments[segmentIndex];
+    DSPDeviceSourceEngine *dspDeviceSourceEngine = DSPEngine::instance()->addDeviceSourceEngine();
+    dspDeviceSourceEngine->start();
+
+    DeviceSet *deviceSet = new DeviceSet(segmentIndex);
+    deviceSet->m_deviceSourceEngine = dspDeviceSourceEngine;
+    deviceSet->m_deviceSinkEngine = nullptr;
+    deviceSet->m_deviceMIMOEngine = nullptr;
+    deviceSet->m_deviceAPI = new DeviceAPI(DeviceAPI::StreamSingleRx, segmentIndex, dspDeviceSourceEngine, nullptr, nullptr);
+    deviceSet->m_deviceAPI->setSamplingDeviceId("sdrangel.samplesource.offline");
+    deviceSet->m_deviceAPI->setSamplingDeviceDisplayName(QString("Offline[%1]").arg(segmentIndex));
+    deviceSet->m_deviceAPI->setBuddyLeader(true);
+
+    OfflineSource *source = new OfflineSource(
+        m_fileName,
+        m_header.sampleRate,
+        m_header.centerFrequency,
+        m_header.sampleSize,
+        segmentProcess.m_segment.readStart(),
+        segmentProcess.m_segment.readCount()
+    );
+    deviceSet->m_deviceAPI->setSampleSource(source);
+    deviceSet->loadRxChannelSettings(preset, m_pluginAPI);
+
+    segmentProcess.m_deviceSet = deviceSet;
+    segmentProcess.m_engine = dspDeviceSourceEngine;
+    segmentProcess.m_source = source;
+
+    if (segmentIndex == 0)
+    {
+        m_fileSinkChannelIndexes.clear();
+
+        for (int i = 0; i < deviceSet->m_deviceAPI->getNbSinkChannels(); i++)
+        {
+            QString channelId;
+            deviceSet->m_deviceAPI->getChanelSinkAPIAt(i)->getIdentifier(channelId);
+
+            if (channelId == "FileSink") {
+                m_fileSinkChannelIndexes.push_back(i);
+            }
+        }
+    }
+}
+
+void OfflineProcessor::destroyDeviceSets()
+{
+    // engines are removed last in first out
+    for (std::vector<SegmentProcess>::reverse_iterator it = m_segments.rbegin(); it != m_segments.rend(); ++it)
+    {
+        if (!it->m_deviceSet) {
+            continue;
+        }
+
+        it->m_engine->stopAcquistion();
+        it->m_deviceSet->freeChannels();
+        it->m_deviceSet->m_deviceAPI->setSampleSource(nullptr);
+        delete it->m_source;
+        DeviceAPI *deviceAPI = it->m_deviceSet->m_deviceAPI;
+        delete it->m_deviceSet;
+        it->m_engine->stop();
+        DSPEngine::instance()->removeLastDeviceSourceEngine();
+        delete deviceAPI;
+
+        it->m_deviceSet = nullptr;
+        it->m_engine = nullptr;
+        it->m_source = nullptr;
+    }
+}
+
+QString OfflineProcessor::segmentFileBase(int segmentIndex, int channelIndex) const
+{
+    return QDir(m_outputDir).filePath(QString("seg%1_ch%2").arg(segmentIndex, 3, 10, QChar('0')).arg(channelIndex));
+}
+
+void OfflineProcessor::configureFileSinks(int segmentIndex)
+{
+    DeviceAPI *deviceAPI = m_segments[segmentIndex].m_deviceSet->m_deviceAPI;
+
+    for (std::vector<int>::const_iterator it = m_fileSinkChannelIndexes.begin(); it != m_fileSinkChannelIndexes.end(); ++it)
+    {
+        SWGSDRangel::SWGChannelSettings channelSettings;
+        channelSettings.setChannelType(new QString("FileSink"));
+        channelSettings.setFileSinkSettings(new SWGSDRangel::SWGFileSinkSettings());
+        channelSettings.getFileSinkSettings()->setFileRecordName(new QString(segmentFileBase(segmentIndex, *it)));
+        QStringList keys("fileRecordName");
+        QString errorMessage;
+        deviceAPI->getChanelSinkAPIAt(*it)->webapiSettingsPutPatch(false, keys, channelSettings, errorMessage);
+    }
+}
+
+void OfflineProcessor::startFileSinks(int segmentIndex)
+{
+    DeviceAPI *deviceAPI = m_segments[segmentIndex].m_deviceSet->m_deviceAPI;
+
+    for (std::vector<int>::const_iterator it = m_fileSinkChannelIndexes.begin(); it != m_fileSinkChannelIndexes.end(); ++it)
+    {
+        SWGSDRangel::SWGChannelActions channelActions;
+        channelActions.setChannelType(new QString("FileSink"));
+        channelActions.setFileSinkActions(new SWGSDRangel::SWGFileSinkActions());
+        channelActions.getFileSinkActions()->setRecord(1);
+        QStringList keys("record");
+        QString errorMessage;
+        deviceAPI->getChanelSinkAPIAt(*it)->webapiActionsPost(keys, channelActions, errorMessage);
+    }
+}
+
+void OfflineProcessor::tick()
+{
+    int nbDone = 0;
+
+    for (unsigned int i = 0; i < m_segments.size(); i++)
+    {
+        SegmentProcess& segmentProcess = m_segments[i];
+
+        switch (segmentProcess.m_state)
+        {
+        case SegmentArmed: // settings were applied one tick ago
+            startFileSinks(i);
+            segmentProcess.m_state = SegmentRecording;
+            break;
+        case SegmentRecording:
+            segmentProcess.m_source->startStreaming();
+            segmentProcess.m_state = SegmentStreaming;
+            break;
+        case SegmentStreaming:
+            if (segmentProcess.m_source->isDrained()) {
+                segmentProcess.m_state = SegmentTail;
+            }
+            break;
+        case SegmentTail:
+            if (++segmentProcess.m_tailTicks >= m_tailTicks)
+            {
+                quint64 samplesCount = segmentProcess.m_source->getSamplesCount();
+                segmentProcess.m_engine->stopAcquistion(); // closes File Sink outputs
+                segmentProcess.m_state = SegmentDone;
+                qInfo("OfflineProcessor::tick: segment %u done (%llu samples)", i, samplesCount);
+            }
+            break;
+        case SegmentDone:
+        default:
+            nbDone++;
+            break;
+        }
+    }
+
+    if (nbDone == (int) m_segments.size())
+    {
+        m_pollTimer.stop();
+        destroyDeviceSets();
+        stitch();
+        qInfo("OfflineProcessor::tick: %s processed in %lld ms", qPrintable(m_fileName), m_elapsedTimer.elapsed());
+        emit finished();
+    }
+}
+
+void OfflineProcessor::stitch()
+{
+    for (std::vector<int>::const_iterator it = m_fileSinkChannelIndexes.begin(); it != m_fileSinkChannelIndexes.end(); ++it) {
+        stitchChannel(*it);
+    }
+}
+
+void OfflineProcessor::stitchChannel(int channelIndex)
+{
+    QDir outputDir(m_outputDir);
+    QString outputFileName = outputDir.filePath(QString("ch%1.sdriq").arg(channelIndex));
+    std::ofstream outputFile;
+    std::vector<char> buffer(1<<20);
+
+    for (unsigned int segmentIndex = 0; segmentIndex < m_segments.size(); segmentIndex++)
+    {
+        QString fileBase = QFileInfo(segmentFileBase(segmentIndex, channelIndex)).fileName();
+        QStringList segmentFiles = outputDir.entryList(QStringList(fileBase + ".*.sdriq"), QDir::Files, QDir::Name);
+
+        if (segmentFiles.size() == 0)
+        {
+            qWarning("OfflineProcessor::stitchChannel: no output for channel %d segment %u", channelIndex, segmentIndex);
+            continue;
+        }
+
+        QString segmentFileName = outputDir.filePath(segmentFiles.at(0));
+        std::ifstream segmentFile(segmentFileName.toStdString().c_str(), std::ios::binary);
+        FileRecord::Header header;
+
+        if (!FileRecord::readHeader(segmentFile, header))
+        {
+            qWarning("OfflineProcessor::stitchChannel: %s: bad header", qPrintable(segmentFileName));
+            continue;
+        }
+
+        if (!outputFile.is_open())
+        {
+            outputFile.open(outputFileName.toStdString().c_str(), std::ios::binary);
+            header.startTimeStamp = m_header.startTimeStamp; // time of the recording start
+            FileRecord::writeHeader(outputFile, header);
+        }
+
+        // skip the overlap converted to the channel sample rate
+        quint64 preRoll = (m_segments[segmentIndex].m_segment.m_preRoll * header.sampleRate) / m_header.sampleRate;
+        segmentFile.seekg(preRoll * sizeof(Sample), std::ios::cur);
+
+        while (segmentFile.good())
+        {
+            segmentFile.read(buffer.data(), buffer.size());
+            outputFile.write(buffer.data(), segmentFile.gcount());
+        }
+
+        segmentFile.close();
+        QFile::remove(segmentFileName);
+    }
+
+    if (outputFile.is_open())
+    {
+        outputFile.close();
+        qInfo("OfflineProcessor::stitchChannel: channel %d output in %s", channelIndex, qPrintable(outputFileName));
+    }
+}
@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRSRV_OFFLINE_OFFLINEPROCESSOR_H_
+#define SDRSRV_OFFLINE_OFFLINEPROCESSOR_H_
+
+#include <vector>
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+
+#include "dsp/filerecord.h"
+
+class DeviceSet;
+class DSPDeviceSourceEngine;
+class MainSettings;
+class OfflineSource;
+class PluginAPI;
+class Preset;
+
+/**
+ * Batch mode of the server: runs the channels of a Rx preset over a .sdriq recording
+ * as fast as the CPU allows. The recording is split in as many segments as workers.
+ * Each segment gets its own device set (thus its own device engine thread and channel
+ * threads) fed by an OfflineSource. Segments but the first start earlier by an overlap
+ * so that channel filters and decoders have settled when the segment proper starts.
+ * File Sink channels outputs are stitched back together after processing with the
+ * overlap removed.
+ */
+class OfflineProcessor : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Segment
+    {
+        quint64 m_start;   //!< First sample of the segment proper
+        quint64 m_end;     //!< One past the last sample of the segment
+        quint64 m_preRoll; //!< Number of overlap samples read before m_start
+
+        Segment() : m_start(0), m_end(0), m_preRoll(0) {}
+        Segment(quint64 start, quint64 end, quint64 preRoll) : m_start(start), m_end(end), m_preRoll(preRoll) {}
+        quint64 readStart() const { return m_start - m_preRoll; }
+        quint64 readCount() const { return m_end - readStart(); }
+    };
+
+    OfflineProcessor(
+        const MainSettings& mainSettings,
+        PluginAPI *pluginAPI,
+        const QString& fileName,
+        const QString& presetName,
+        int nbWorkers,
+        int overlapMs,
+        const QString& outputDir,
+        QObject *parent = nullptr);
+    ~OfflineProcessor();
+
+    bool start(); //!< Returns false if processing could not be started. In this case finished() is not emitted.
+
+    static void computeSegments(quint64 nbSamples, int nbSegments, quint64 overlapSamples, std::vector<Segment>& segments);
+
+signals:
+    void finished();
+
+private:
+    enum SegmentState
+    {
+        SegmentArmed,     //!< Device engine running, source paused
+        SegmentRecording, //!< File Sink channels were asked to record
+        SegmentStreaming, //!< Samples are being pushed
+        SegmentTail,      //!< Source drained, letting channels flush
+        SegmentDone       //!< Device engine stopped
+    };
+
+    struct SegmentProcess
+    {
+        Segment m_segment;
+        SegmentState m_state;
+        int m_tailTicks;
+        DeviceSet *m_deviceSet;
+        DSPDeviceSourceEngine *m_engine;
+        OfflineSource *m_source;
+
+        SegmentProcess() :
+            m_state(SegmentArmed),
+            m_tailTicks(0),
+            m_deviceSet(nullptr),
+            m_engine(nullptr),
+            m_source(nullptr)
+        {}
+    };
+
+    const MainSettings& m_mainSettings;
+    PluginAPI *m_pluginAPI;
+    QString m_fileName;
+    QString m_presetName;
+    int m_nbWorkers;
+    int m_overlapMs;
+    QString m_outputDir;
+    FileRecord::Header m_header;
+    quint64 m_nbSamples;
+    std::vector<SegmentProcess> m_segments;
+    std::vector<int> m_fileSinkChannelIndexes; //!< Indexes of File Sink channels in the preset
+    QTimer m_pollTimer;
+    QElapsedTimer m_elapsedTimer;
+
+    static const int m_tailTicks;
+
+    const Preset *findPreset() const;
+    bool readHeader();
+    void createDeviceSet(int segmentIndex, const Preset *preset);
+    void destroyDeviceSets();
+    void configureFileSinks(int segmentIndex);
+    void startFileSinks(int segmentIndex);
+    QString segmentFileBase(int segmentIndex, int channelIndex) const;
+    void stitch();
+    void stitchChannel(int channelIndex);
+
+private slots:
+    void tick();
+};
+
+#endif // SDRSRV_OFFLINE_OFFLINEPROCESSOR_H_
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "offlinesourcethread.h"
+#include "offlinesource.h"
+
+OfflineSource::OfflineSource(
+        const QString& fileName,
+        quint32 sampleRate,
+        quint64 centerFrequency,
+        quint32 sampleSize,
+        quint64 startSample,
+        quint64 nbSamples) :
+    m_fileName(fileName),
+    m_sampleRate(sampleRate),
+    m_centerFrequency(centerFrequency),
+    m_sampleSize(sampleSize),
+    m_startSample(startSample),
+    m_nbSamples(nbSamples),
+    m_deviceDescription("OfflineSource"),
+    m_running(false),
+    m_streaming(false),
+    m_sourceThread(nullptr)
+{
+    m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(m_sampleRate));
+}
+
+OfflineSource::~OfflineSource()
+{
+    stop();
+}
+
+void OfflineSource::destroy()
+{
+    delete this;
+}
+
+void OfflineSource::init()
+{
+}
+
+bool OfflineSource::start()
+{
+    qDebug("OfflineSource::start: %s [%llu:%llu]", qPrintable(m_fileName), m_startSample, m_startSample + m_nbSamples);
+    m_sourceThread = new OfflineSourceThread(&m_sampleFifo);
+    m_sourceThread->setSegment(m_fileName, m_startSample, m_nbSamples, m_sampleSize);
+    m_running = true;
+
+    return true;
+}
+
+void OfflineSource::stop()
+{
+    if (m_sourceThread)
+    {
+        m_sourceThread->stopWork();
+        delete m_sourceThread;
+        m_sourceThread = nullptr;
+    }
+
+    m_running = false;
+    m_streaming = false;
+}
+
+void OfflineSource::startStreaming()
+{
+    if (m_running && !m_streaming)
+    {
+        m_sourceThread->startWork();
+        m_streaming = true;
+    }
+}
+
+bool OfflineSource::isDrained() const
+{
+    if (!m_sourceThread || !m_streaming) {
+        return false;
+    }
+
+    return m_sourceThread->isFinished() && (const_cast<SampleSinkFifo&>(m_sampleFifo).fill() == 0);
+}
+
+quint64 OfflineSource::getSamplesCount() const
+{
+    return m_sourceThread ? m_sourceThread->getSamplesCount() : 0;
+}
+
+QByteArray OfflineSource::serialize() const
+{
+    return QByteArray();
+}
+
+bool OfflineSource::deserialize(const QByteArray& data)
+{
+    (void) data;
+    return true;
+}
+
+const QString& OfflineSource::getDeviceDescription() const
+{
+    return m_deviceDescription;
+}
+
+int OfflineSource::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+quint64 OfflineSource::getCenterFrequency() const
+{
+    return m_centerFrequency;
+}
+
+bool OfflineSource::handleMessage(const Message& message)
+{
+    (void) message;
+    return false;
+}
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRSRV_OFFLINE_OFFLINESOURCE_H_
+#define SDRSRV_OFFLINE_OFFLINESOURCE_H_
+
+#include <QString>
+#include <QByteArray>
+
+#include "dsp/devicesamplesource.h"
+
+class OfflineSourceThread;
+
+/**
+ * Sample source used by the batch (offline) mode of the server. It is not a plugin:
+ * it is attached directly to the device set created by the offline processor and
+ * plays one segment of a .sdriq file without real time pacing.
+ */
+class OfflineSource : public DeviceSampleSource {
+    Q_OBJECT
+
+public:
+    OfflineSource(const QString& fileName,
+        quint32 sampleRate,
+        quint64 centerFrequency,
+        quint32 sampleSize,
+        quint64 startSample,
+        quint64 nbSamples);
+    virtual ~OfflineSource();
+    virtual void destroy();
+
+    virtual void init();
+    virtual bool start();
+    virtual void stop();
+
+    virtual QByteArray serialize() const;
+    virtual bool deserialize(const QByteArray& data);
+
+    virtual void setMessageQueueToGUI(MessageQueue *queue) { m_guiMessageQueue = queue; }
+    virtual const QString& getDeviceDescription() const;
+    virtual int getSampleRate() const;
+    virtual void setSampleRate(int sampleRate) { (void) sampleRate; }
+    virtual quint64 getCenterFrequency() const;
+    virtual void setCenterFrequency(qint64 centerFrequency) { (void) centerFrequency; }
+
+    virtual bool handleMessage(const Message& message);
+
+    void startStreaming();   //!< Start to push samples. The source is started paused so that channels can be armed first
+    bool isStreaming() const { return m_streaming; }
+    bool isDrained() const;  //!< True when the whole segment has been read and consumed by the device engine
+    quint64 getSamplesCount() const;
+
+private:
+    QString m_fileName;
+    quint32 m_sampleRate;
+    quint64 m_centerFrequency;
+    quint32 m_sampleSize;
+    quint64 m_startSample;
+    quint64 m_nbSamples;
+    QString m_deviceDescription;
+    bool m_running;
+    bool m_streaming;
+    OfflineSourceThread *m_sourceThread;
+};
+
+#endif // SDRSRV_OFFLINE_OFFLINESOURCE_H_
@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <QDebug>
+
+#include "dsp/filerecord.h"
+#include "dsp/samplesinkfifo.h"
+
+#include "offlinesourcethread.h"
+
+const unsigned int OfflineSourceThread::m_chunkSamples = 65536;
+
+OfflineSourceThread::OfflineSourceThread(SampleSinkFifo* sampleFifo, QObject* parent) :
+    QThread(parent),
+    m_running(false),
+    m_finished(false),
+    m_sampleFifo(sampleFifo),
+    m_startSample(0),
+    m_nbSamples(0),
+    m_samplesCount(0),
+    m_sampleSize(SDR_RX_SAMP_SZ),
+    m_sampleBytes(SDR_RX_SAMP_SZ > 16 ? sizeof(int32_t) : sizeof(int16_t))
+{
+}
+
+OfflineSourceThread::~OfflineSourceThread()
+{
+    stopWork();
+}
+
+void OfflineSourceThread::setSegment(const QString& fileName, quint64 startSample, quint64 nbSamples, quint32 sampleSize)
+{
+    m_fileName = fileName;
+    m_startSample = startSample;
+    m_nbSamples = nbSamples;
+    m_sampleSize = sampleSize;
+    m_sampleBytes = m_sampleSize > 16 ? sizeof(int32_t) : sizeof(int16_t);
+    m_fileBuf.resize(m_chunkSamples * 2 * m_sampleBytes);
+    m_convertBuffer.resize(m_chunkSamples);
+}
+
+void OfflineSourceThread::startWork()
+{
+    m_finished = false;
+    m_samplesCount = 0;
+    m_ifstream.open(m_fileName.toStdString().c_str(), std::ios::binary | std::ios::in);
+
+    if (!m_ifstream.is_open())
+    {
+        qCritical("OfflineSourceThread::startWork: cannot open %s", qPrintable(m_fileName));
+        m_finished = true;
+        return;
+    }
+
+    m_ifstream.seekg(sizeof(FileRecord::Header) + m_startSample * 2 * m_sampleBytes, std::ios::beg);
+
+    m_startWaitMutex.lock();
+    start();
+
+    while (!m_running) {
+        m_startWaiter.wait(&m_startWaitMutex, 100);
+    }
+
+    m_startWaitMutex.unlock();
+}
+
+void OfflineSourceThread::stopWork()
+{
+    m_running = false;
+    wait();
+
+    if (m_ifstream.is_open()) {
+        m_ifstream.close();
+    }
+}
+
+void OfflineSourceThread::run()
+{
+    m_running = true;
+    m_startWaiter.wakeAll();
+
+    while (m_running && (m_samplesCount < m_nbSamples))
+    {
+        unsigned int chunk = std::min((quint64) m_chunkSamples, m_nbSamples - m_samplesCount);
+        // at low sample rates the FIFO is smaller than a chunk: never wait for more than half of it
+        chunk = std::min(chunk, std::max(1U, m_sampleFifo->size() / 2));
+
+        // back-pressure: wait for the engine to make room rather than dropping samples
+        if (m_sampleFifo->size() - m_sampleFifo->fill() < chunk)
+        {
+            usleep(1000);
+            continue;
+        }
+
+        m_ifstream.read(m_fileBuf.data(), chunk * 2 * m_sampleBytes);
+        unsigned int nbRead = m_ifstream.gcount() / (2 * m_sampleBytes);
+        writeToSampleFifo(m_fileBuf.data(), nbRead);
+        m_samplesCount += nbRead;
+
+        if (nbRead < chunk) // premature end of file
+        {
+            qWarning("OfflineSourceThread::run: %s: end of file after %llu samples", qPrintable(m_fileName), m_samplesCount);
+            break;
+        }
+    }
+
+    m_finished = true;
+    m_running = false;
+}
+
+void OfflineSourceThread::writeToSampleFifo(const char *buf, unsigned int nbSamples)
+{
+    if (m_sampleSize == SDR_RX_SAMP_SZ)
+    {
+        m_sampleFifo->write((const quint8*) buf, nbSamples*sizeof(Sample));
+        return;
+    }
+
+    SampleVector::iterator it = m_convertBuffer.begin();
+
+    if (m_sampleSize == 16) // 16 bit file into 24 bit DSP
+    {
+        const int16_t *fileBuf = (const int16_t *) buf;
+
+        for (unsigned int is = 0; is < nbSamples; is++, ++it)
+        {
+            it->setReal(fileBuf[2*is] << 8);
+            it->setImag(fileBuf[2*is+1] << 8);
+        }
+    }
+    else // 24 bit file into 16 bit DSP
+    {
+        const int32_t *fileBuf = (const int32_t *) buf;
+
+        for (unsigned int is = 0; is < nbSamples; is++, ++it)
+        {
+            it->setReal(fileBuf[2*is] >> 8);
+            it->setImag(fileBuf[2*is+1] >> 8);
+        }
+    }
+
+    m_sampleFifo->write(m_convertBuffer.begin(), m_convertBuffer.begin() + nbSamples);
+}
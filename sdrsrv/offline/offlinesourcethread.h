@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRSRV_OFFLINE_OFFLINESOURCETHREAD_H_
+#define SDRSRV_OFFLINE_OFFLINESOURCETHREAD_H_
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <fstream>
+
+#include "dsp/dsptypes.h"
+
+class SampleSinkFifo;
+
+/**
+ * Reads a segment of a .sdriq file as fast as the device engine consumes it.
+ * Unlike the File Input worker there is no real time throttling: a chunk is only
+ * written when the FIFO can take it entirely so that no sample is ever dropped.
+ */
+class OfflineSourceThread : public QThread {
+    Q_OBJECT
+
+public:
+    OfflineSourceThread(SampleSinkFifo* sampleFifo, QObject* parent = nullptr);
+    ~OfflineSourceThread();
+
+    void setSegment(const QString& fileName, quint64 startSample, quint64 nbSamples, quint32 sampleSize);
+    void startWork();
+    void stopWork();
+    bool isFinished() const { return m_finished; }
+    quint64 getSamplesCount() const { return m_samplesCount; }
+
+private:
+    QMutex m_startWaitMutex;
+    QWaitCondition m_startWaiter;
+    volatile bool m_running;
+    volatile bool m_finished;
+
+    SampleSinkFifo* m_sampleFifo;
+    std::ifstream m_ifstream;
+    QString m_fileName;
+    quint64 m_startSample;
+    quint64 m_nbSamples;
+    quint64 m_samplesCount;
+    quint32 m_sampleSize;  //!< File effective sample size in bits (I or Q). Ex: 16, 24.
+    quint32 m_sampleBytes; //!< Number of bytes used to store a I or Q sample. Ex: 2. 4.
+    std::vector<char> m_fileBuf;
+    SampleVector m_convertBuffer;
+
+    static const unsigned int m_chunkSamples;
+
+    void run();
+    void writeToSampleFifo(const char *buf, unsigned int nbSamples);
+};
+
+#endif // SDRSRV_OFFLINE_OFFLINESOURCETHREAD_H_
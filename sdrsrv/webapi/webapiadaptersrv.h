@@ -212,6 +212,19 @@ public:
             SWGSDRangel::SWGSuccessResponse& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int instanceRDSStationsGet(
+            quint64 since,
+            QJsonObject& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int instanceRDSStationsDelete(
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int instanceAMBEPoolGet(
+            QJsonObject& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int devicesetGet(
             int deviceSetIndex,
             SWGSDRangel::SWGDeviceSet& response,
@@ -316,6 +329,83 @@ public:
             SWGSDRangel::SWGSuccessResponse& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int devicesetChannelFrameGet(
+            int deviceSetIndex,
+            int channelIndex,
+            const QString& format,
+            int scale,
+            int quality,
+            quint64 since,
+            QByteArray& frame,
+            QString& mimeType,
+            quint64& frameIndex,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetDeviceCompactGet(
+            int deviceSetIndex,
+            bool& compactSamples,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetDeviceCompactPut(
+            int deviceSetIndex,
+            bool compactSamples,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetDeviceFloatGet(
+            int deviceSetIndex,
+            bool& floatSamples,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetDeviceFloatPut(
+            int deviceSetIndex,
+            bool floatSamples,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumArchivePost(
+            int deviceSetIndex,
+            const QString& directory,
+            int fftSize,
+            float rowsPerSecond,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumArchiveDelete(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumArchiveGet(
+            int deviceSetIndex,
+            qint64 fromMs,
+            qint64 toMs,
+            qint64 fromHz,
+            qint64 toHz,
+            int maxRows,
+            int maxBins,
+            QJsonObject& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumPanoramaPost(
+            int deviceSetIndex,
+            const PanoramaEngine::Settings& settings,
+            const QString& wsAddress,
+            quint16 wsPort,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumPanoramaDelete(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumPanoramaGet(
+            int deviceSetIndex,
+            int maxBins,
+            QJsonObject& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int devicesetChannelSettingsPutPatch(
             int deviceSetIndex,
             int channelIndex,
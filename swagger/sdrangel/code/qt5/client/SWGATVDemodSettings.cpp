@@ -94,6 +94,8 @@ SWGATVDemodSettings::SWGATVDemodSettings() {
     m_udp_address_isSet = false;
     udp_port = 0;
     m_udp_port_isSet = false;
+    block_mode = 0;
+    m_block_mode_isSet = false;
 }
 
 SWGATVDemodSettings::~SWGATVDemodSettings() {
@@ -168,6 +170,8 @@ SWGATVDemodSettings::init() {
     m_udp_address_isSet = false;
     udp_port = 0;
     m_udp_port_isSet = false;
+    block_mode = 0;
+    m_block_mode_isSet = false;
 }
 
 void
@@ -288,6 +292,8 @@ SWGATVDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&udp_port, pJson["udpPort"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&block_mode, pJson["blockMode"], "qint32", "");
+    
 }
 
 QString
@@ -403,6 +409,9 @@ SWGATVDemodSettings::asJsonObject() {
     if(m_udp_port_isSet){
         obj->insert("udpPort", QJsonValue(udp_port));
     }
+    if(m_block_mode_isSet){
+        obj->insert("blockMode", QJsonValue(block_mode));
+    }
 
     return obj;
 }
@@ -737,6 +746,16 @@ SWGATVDemodSettings::setUdpPort(qint32 udp_port) {
     this->m_udp_port_isSet = true;
 }
 
+qint32
+SWGATVDemodSettings::getBlockMode() {
+    return block_mode;
+}
+void
+SWGATVDemodSettings::setBlockMode(qint32 block_mode) {
+    this->block_mode = block_mode;
+    this->m_block_mode_isSet = true;
+}
+
 
 bool
 SWGATVDemodSettings::isSet(){
@@ -841,6 +860,9 @@ SWGATVDemodSettings::isSet(){
         if(m_udp_port_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_block_mode_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
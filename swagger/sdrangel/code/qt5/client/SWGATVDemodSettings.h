@@ -141,6 +141,9 @@ public:
     qint32 getUdpPort();
     void setUdpPort(qint32 udp_port);
 
+    qint32 getBlockMode();
+    void setBlockMode(qint32 block_mode);
+
 
     virtual bool isSet() override;
 
@@ -244,6 +247,9 @@ private:
     qint32 udp_port;
     bool m_udp_port_isSet;
 
+    qint32 block_mode;
+    bool m_block_mode_isSet;
+
 };
 
 }
@@ -52,6 +52,8 @@ SWGChannelReport::SWGChannelReport() {
     m_free_dv_mod_report_isSet = false;
     freq_tracker_report = nullptr;
     m_freq_tracker_report_isSet = false;
+    lo_ra_demod_report = nullptr;
+    m_lo_ra_demod_report_isSet = false;
     nfm_demod_report = nullptr;
     m_nfm_demod_report_isSet = false;
     nfm_mod_report = nullptr;
@@ -104,6 +106,8 @@ SWGChannelReport::init() {
     m_free_dv_mod_report_isSet = false;
     freq_tracker_report = new SWGFreqTrackerReport();
     m_freq_tracker_report_isSet = false;
+    lo_ra_demod_report = new SWGLoRaDemodReport();
+    m_lo_ra_demod_report_isSet = false;
     nfm_demod_report = new SWGNFMDemodReport();
     m_nfm_demod_report_isSet = false;
     nfm_mod_report = new SWGNFMModReport();
@@ -162,6 +166,9 @@ SWGChannelReport::cleanup() {
     if(freq_tracker_report != nullptr) { 
         delete freq_tracker_report;
     }
+    if(lo_ra_demod_report != nullptr) { 
+        delete lo_ra_demod_report;
+    }
     if(nfm_demod_report != nullptr) { 
         delete nfm_demod_report;
     }
@@ -229,6 +236,8 @@ SWGChannelReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&freq_tracker_report, pJson["FreqTrackerReport"], "SWGFreqTrackerReport", "SWGFreqTrackerReport");
     
+    ::SWGSDRangel::setValue(&lo_ra_demod_report, pJson["LoRaDemodReport"], "SWGLoRaDemodReport", "SWGLoRaDemodReport");
+    
     ::SWGSDRangel::setValue(&nfm_demod_report, pJson["NFMDemodReport"], "SWGNFMDemodReport", "SWGNFMDemodReport");
     
     ::SWGSDRangel::setValue(&nfm_mod_report, pJson["NFMModReport"], "SWGNFMModReport", "SWGNFMModReport");
@@ -301,6 +310,9 @@ SWGChannelReport::asJsonObject() {
     if((freq_tracker_report != nullptr) && (freq_tracker_report->isSet())){
         toJsonValue(QString("FreqTrackerReport"), freq_tracker_report, obj, QString("SWGFreqTrackerReport"));
     }
+    if((lo_ra_demod_report != nullptr) && (lo_ra_demod_report->isSet())){
+        toJsonValue(QString("LoRaDemodReport"), lo_ra_demod_report, obj, QString("SWGLoRaDemodReport"));
+    }
     if((nfm_demod_report != nullptr) && (nfm_demod_report->isSet())){
         toJsonValue(QString("NFMDemodReport"), nfm_demod_report, obj, QString("SWGNFMDemodReport"));
     }
@@ -455,6 +467,16 @@ SWGChannelReport::setFreqTrackerReport(SWGFreqTrackerReport* freq_tracker_report
     this->m_freq_tracker_report_isSet = true;
 }
 
+SWGLoRaDemodReport*
+SWGChannelReport::getLoRaDemodReport() {
+    return lo_ra_demod_report;
+}
+void
+SWGChannelReport::setLoRaDemodReport(SWGLoRaDemodReport* lo_ra_demod_report) {
+    this->lo_ra_demod_report = lo_ra_demod_report;
+    this->m_lo_ra_demod_report_isSet = true;
+}
+
 SWGNFMDemodReport*
 SWGChannelReport::getNfmDemodReport() {
     return nfm_demod_report;
@@ -596,6 +618,9 @@ SWGChannelReport::isSet(){
         if(freq_tracker_report && freq_tracker_report->isSet()){
             isObjectUpdated = true; break;
         }
+        if(lo_ra_demod_report && lo_ra_demod_report->isSet()){
+            isObjectUpdated = true; break;
+        }
         if(nfm_demod_report && nfm_demod_report->isSet()){
             isObjectUpdated = true; break;
         }
@@ -32,6 +32,7 @@
 #include "SWGFreeDVDemodReport.h"
 #include "SWGFreeDVModReport.h"
 #include "SWGFreqTrackerReport.h"
+#include "SWGLoRaDemodReport.h"
 #include "SWGNFMDemodReport.h"
 #include "SWGNFMModReport.h"
 #include "SWGPacketModReport.h"
@@ -98,6 +99,9 @@ public:
     SWGFreqTrackerReport* getFreqTrackerReport();
     void setFreqTrackerReport(SWGFreqTrackerReport* freq_tracker_report);
 
+    SWGLoRaDemodReport* getLoRaDemodReport();
+    void setLoRaDemodReport(SWGLoRaDemodReport* lo_ra_demod_report);
+
     SWGNFMDemodReport* getNfmDemodReport();
     void setNfmDemodReport(SWGNFMDemodReport* nfm_demod_report);
 
@@ -168,6 +172,9 @@ private:
     SWGFreqTrackerReport* freq_tracker_report;
     bool m_freq_tracker_report_isSet;
 
+    SWGLoRaDemodReport* lo_ra_demod_report;
+    bool m_lo_ra_demod_report_isSet;
+
     SWGNFMDemodReport* nfm_demod_report;
     bool m_nfm_demod_report_isSet;
 
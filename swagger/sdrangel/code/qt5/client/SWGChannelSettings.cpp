@@ -68,6 +68,10 @@ SWGChannelSettings::SWGChannelSettings() {
     m_nfm_mod_settings_isSet = false;
     local_sink_settings = nullptr;
     m_local_sink_settings_isSet = false;
+    shm_sink_settings = nullptr;
+    m_shm_sink_settings_isSet = false;
+    rds_monitor_settings = nullptr;
+    m_rds_monitor_settings_isSet = false;
     local_source_settings = nullptr;
     m_local_source_settings_isSet = false;
     packet_mod_settings = nullptr;
@@ -136,6 +140,10 @@ SWGChannelSettings::init() {
     m_nfm_mod_settings_isSet = false;
     local_sink_settings = new SWGLocalSinkSettings();
     m_local_sink_settings_isSet = false;
+    shm_sink_settings = new SWGShmSinkSettings();
+    m_shm_sink_settings_isSet = false;
+    rds_monitor_settings = new SWGRDSMonitorSettings();
+    m_rds_monitor_settings_isSet = false;
     local_source_settings = new SWGLocalSourceSettings();
     m_local_source_settings_isSet = false;
     packet_mod_settings = new SWGPacketModSettings();
@@ -214,6 +222,12 @@ SWGChannelSettings::cleanup() {
     if(local_sink_settings != nullptr) { 
         delete local_sink_settings;
     }
+    if(shm_sink_settings != nullptr) { 
+        delete shm_sink_settings;
+    }
+    if(rds_monitor_settings != nullptr) { 
+        delete rds_monitor_settings;
+    }
     if(local_source_settings != nullptr) { 
         delete local_source_settings;
     }
@@ -297,6 +311,10 @@ SWGChannelSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&local_sink_settings, pJson["LocalSinkSettings"], "SWGLocalSinkSettings", "SWGLocalSinkSettings");
     
+    ::SWGSDRangel::setValue(&shm_sink_settings, pJson["ShmSinkSettings"], "SWGShmSinkSettings", "SWGShmSinkSettings");
+    
+    ::SWGSDRangel::setValue(&rds_monitor_settings, pJson["RDSMonitorSettings"], "SWGRDSMonitorSettings", "SWGRDSMonitorSettings");
+    
     ::SWGSDRangel::setValue(&local_source_settings, pJson["LocalSourceSettings"], "SWGLocalSourceSettings", "SWGLocalSourceSettings");
     
     ::SWGSDRangel::setValue(&packet_mod_settings, pJson["PacketModSettings"], "SWGPacketModSettings", "SWGPacketModSettings");
@@ -393,6 +411,12 @@ SWGChannelSettings::asJsonObject() {
     if((local_sink_settings != nullptr) && (local_sink_settings->isSet())){
         toJsonValue(QString("LocalSinkSettings"), local_sink_settings, obj, QString("SWGLocalSinkSettings"));
     }
+    if((shm_sink_settings != nullptr) && (shm_sink_settings->isSet())){
+        toJsonValue(QString("ShmSinkSettings"), shm_sink_settings, obj, QString("SWGShmSinkSettings"));
+    }
+    if((rds_monitor_settings != nullptr) && (rds_monitor_settings->isSet())){
+        toJsonValue(QString("RDSMonitorSettings"), rds_monitor_settings, obj, QString("SWGRDSMonitorSettings"));
+    }
     if((local_source_settings != nullptr) && (local_source_settings->isSet())){
         toJsonValue(QString("LocalSourceSettings"), local_source_settings, obj, QString("SWGLocalSourceSettings"));
     }
@@ -627,6 +651,26 @@ SWGChannelSettings::setLocalSinkSettings(SWGLocalSinkSettings* local_sink_settin
     this->m_local_sink_settings_isSet = true;
 }
 
+SWGShmSinkSettings*
+SWGChannelSettings::getShmSinkSettings() {
+    return shm_sink_settings;
+}
+void
+SWGChannelSettings::setShmSinkSettings(SWGShmSinkSettings* shm_sink_settings) {
+    this->shm_sink_settings = shm_sink_settings;
+    this->m_shm_sink_settings_isSet = true;
+}
+
+SWGRDSMonitorSettings*
+SWGChannelSettings::getRdsMonitorSettings() {
+    return rds_monitor_settings;
+}
+void
+SWGChannelSettings::setRdsMonitorSettings(SWGRDSMonitorSettings* rds_monitor_settings) {
+    this->rds_monitor_settings = rds_monitor_settings;
+    this->m_rds_monitor_settings_isSet = true;
+}
+
 SWGLocalSourceSettings*
 SWGChannelSettings::getLocalSourceSettings() {
     return local_source_settings;
@@ -792,6 +836,12 @@ SWGChannelSettings::isSet(){
         if(local_sink_settings && local_sink_settings->isSet()){
             isObjectUpdated = true; break;
         }
+        if(shm_sink_settings && shm_sink_settings->isSet()){
+            isObjectUpdated = true; break;
+        }
+        if(rds_monitor_settings && rds_monitor_settings->isSet()){
+            isObjectUpdated = true; break;
+        }
         if(local_source_settings && local_source_settings->isSet()){
             isObjectUpdated = true; break;
         }
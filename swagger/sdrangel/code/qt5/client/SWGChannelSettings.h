@@ -36,6 +36,8 @@
 #include "SWGFreeDVModSettings.h"
 #include "SWGFreqTrackerSettings.h"
 #include "SWGLocalSinkSettings.h"
+#include "SWGShmSinkSettings.h"
+#include "SWGRDSMonitorSettings.h"
 #include "SWGLocalSourceSettings.h"
 #include "SWGNFMDemodSettings.h"
 #include "SWGNFMModSettings.h"
@@ -128,6 +130,12 @@ public:
     SWGLocalSinkSettings* getLocalSinkSettings();
     void setLocalSinkSettings(SWGLocalSinkSettings* local_sink_settings);
 
+    SWGShmSinkSettings* getShmSinkSettings();
+    void setShmSinkSettings(SWGShmSinkSettings* shm_sink_settings);
+
+    SWGRDSMonitorSettings* getRdsMonitorSettings();
+    void setRdsMonitorSettings(SWGRDSMonitorSettings* rds_monitor_settings);
+
     SWGLocalSourceSettings* getLocalSourceSettings();
     void setLocalSourceSettings(SWGLocalSourceSettings* local_source_settings);
 
@@ -222,6 +230,12 @@ private:
     SWGLocalSinkSettings* local_sink_settings;
     bool m_local_sink_settings_isSet;
 
+    SWGShmSinkSettings* shm_sink_settings;
+    bool m_shm_sink_settings_isSet;
+
+    SWGRDSMonitorSettings* rds_monitor_settings;
+    bool m_rds_monitor_settings_isSet;
+
     SWGLocalSourceSettings* local_source_settings;
     bool m_local_source_settings_isSet;
 
@@ -68,6 +68,8 @@ SWGDATVDemodSettings::SWGDATVDemodSettings() {
     m_audio_volume_isSet = false;
     video_mute = 0;
     m_video_mute_isSet = false;
+    key_frames_only = 0;
+    m_key_frames_only_isSet = false;
     udp_ts_address = nullptr;
     m_udp_ts_address_isSet = false;
     udp_ts_port = 0;
@@ -122,6 +124,8 @@ SWGDATVDemodSettings::init() {
     m_audio_volume_isSet = false;
     video_mute = 0;
     m_video_mute_isSet = false;
+    key_frames_only = 0;
+    m_key_frames_only_isSet = false;
     udp_ts_address = new QString("");
     m_udp_ts_address_isSet = false;
     udp_ts_port = 0;
@@ -214,6 +218,8 @@ SWGDATVDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&video_mute, pJson["videoMute"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&key_frames_only, pJson["keyFramesOnly"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&udp_ts_address, pJson["udpTSAddress"], "QString", "QString");
     
     ::SWGSDRangel::setValue(&udp_ts_port, pJson["udpTSPort"], "qint32", "");
@@ -296,6 +302,9 @@ SWGDATVDemodSettings::asJsonObject() {
     if(m_video_mute_isSet){
         obj->insert("videoMute", QJsonValue(video_mute));
     }
+    if(m_key_frames_only_isSet){
+        obj->insert("keyFramesOnly", QJsonValue(key_frames_only));
+    }
     if(udp_ts_address != nullptr && *udp_ts_address != QString("")){
         toJsonValue(QString("udpTSAddress"), udp_ts_address, obj, QString("QString"));
     }
@@ -509,6 +518,16 @@ SWGDATVDemodSettings::setVideoMute(qint32 video_mute) {
     this->m_video_mute_isSet = true;
 }
 
+qint32
+SWGDATVDemodSettings::getKeyFramesOnly() {
+    return key_frames_only;
+}
+void
+SWGDATVDemodSettings::setKeyFramesOnly(qint32 key_frames_only) {
+    this->key_frames_only = key_frames_only;
+    this->m_key_frames_only_isSet = true;
+}
+
 QString*
 SWGDATVDemodSettings::getUdpTsAddress() {
     return udp_ts_address;
@@ -604,6 +623,9 @@ SWGDATVDemodSettings::isSet(){
         if(m_video_mute_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_key_frames_only_isSet){
+            isObjectUpdated = true; break;
+        }
         if(udp_ts_address && *udp_ts_address != QString("")){
             isObjectUpdated = true; break;
         }
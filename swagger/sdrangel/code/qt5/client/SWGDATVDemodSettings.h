@@ -102,6 +102,9 @@ public:
     qint32 getVideoMute();
     void setVideoMute(qint32 video_mute);
 
+    qint32 getKeyFramesOnly();
+    void setKeyFramesOnly(qint32 key_frames_only);
+
     QString* getUdpTsAddress();
     void setUdpTsAddress(QString* udp_ts_address);
 
@@ -175,6 +178,9 @@ private:
     qint32 video_mute;
     bool m_video_mute_isSet;
 
+    qint32 key_frames_only;
+    bool m_key_frames_only_isSet;
+
     QString* udp_ts_address;
     bool m_udp_ts_address_isSet;
 
@@ -50,6 +50,8 @@ SWGDeviceReport::SWGDeviceReport() {
     m_lime_sdr_output_report_isSet = false;
     local_input_report = nullptr;
     m_local_input_report_isSet = false;
+    shm_input_report = nullptr;
+    m_shm_input_report_isSet = false;
     local_output_report = nullptr;
     m_local_output_report_isSet = false;
     perseus_report = nullptr;
@@ -104,6 +106,8 @@ SWGDeviceReport::init() {
     m_lime_sdr_output_report_isSet = false;
     local_input_report = new SWGLocalInputReport();
     m_local_input_report_isSet = false;
+    shm_input_report = new SWGShmInputReport();
+    m_shm_input_report_isSet = false;
     local_output_report = new SWGLocalOutputReport();
     m_local_output_report_isSet = false;
     perseus_report = new SWGPerseusReport();
@@ -163,6 +167,9 @@ SWGDeviceReport::cleanup() {
     if(local_input_report != nullptr) { 
         delete local_input_report;
     }
+    if(shm_input_report != nullptr) { 
+        delete shm_input_report;
+    }
     if(local_output_report != nullptr) { 
         delete local_output_report;
     }
@@ -234,6 +241,8 @@ SWGDeviceReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&local_input_report, pJson["localInputReport"], "SWGLocalInputReport", "SWGLocalInputReport");
     
+    ::SWGSDRangel::setValue(&shm_input_report, pJson["shmInputReport"], "SWGShmInputReport", "SWGShmInputReport");
+    
     ::SWGSDRangel::setValue(&local_output_report, pJson["localOutputReport"], "SWGLocalOutputReport", "SWGLocalOutputReport");
     
     ::SWGSDRangel::setValue(&perseus_report, pJson["perseusReport"], "SWGPerseusReport", "SWGPerseusReport");
@@ -307,6 +316,9 @@ SWGDeviceReport::asJsonObject() {
     if((local_input_report != nullptr) && (local_input_report->isSet())){
         toJsonValue(QString("localInputReport"), local_input_report, obj, QString("SWGLocalInputReport"));
     }
+    if((shm_input_report != nullptr) && (shm_input_report->isSet())){
+        toJsonValue(QString("shmInputReport"), shm_input_report, obj, QString("SWGShmInputReport"));
+    }
     if((local_output_report != nullptr) && (local_output_report->isSet())){
         toJsonValue(QString("localOutputReport"), local_output_report, obj, QString("SWGLocalOutputReport"));
     }
@@ -457,6 +469,16 @@ SWGDeviceReport::setLocalInputReport(SWGLocalInputReport* local_input_report) {
     this->m_local_input_report_isSet = true;
 }
 
+SWGShmInputReport*
+SWGDeviceReport::getShmInputReport() {
+    return shm_input_report;
+}
+void
+SWGDeviceReport::setShmInputReport(SWGShmInputReport* shm_input_report) {
+    this->shm_input_report = shm_input_report;
+    this->m_shm_input_report_isSet = true;
+}
+
 SWGLocalOutputReport*
 SWGDeviceReport::getLocalOutputReport() {
     return local_output_report;
@@ -615,6 +637,9 @@ SWGDeviceReport::isSet(){
         if(local_input_report && local_input_report->isSet()){
             isObjectUpdated = true; break;
         }
+        if(shm_input_report && shm_input_report->isSet()){
+            isObjectUpdated = true; break;
+        }
         if(local_output_report && local_output_report->isSet()){
             isObjectUpdated = true; break;
         }
@@ -31,6 +31,7 @@
 #include "SWGLimeSdrInputReport.h"
 #include "SWGLimeSdrOutputReport.h"
 #include "SWGLocalInputReport.h"
+#include "SWGShmInputReport.h"
 #include "SWGLocalOutputReport.h"
 #include "SWGPerseusReport.h"
 #include "SWGPlutoSdrInputReport.h"
@@ -95,6 +96,9 @@ public:
     SWGLocalInputReport* getLocalInputReport();
     void setLocalInputReport(SWGLocalInputReport* local_input_report);
 
+    SWGShmInputReport* getShmInputReport();
+    void setShmInputReport(SWGShmInputReport* shm_input_report);
+
     SWGLocalOutputReport* getLocalOutputReport();
     void setLocalOutputReport(SWGLocalOutputReport* local_output_report);
 
@@ -168,6 +172,9 @@ private:
     SWGLocalInputReport* local_input_report;
     bool m_local_input_report_isSet;
 
+    SWGShmInputReport* shm_input_report;
+    bool m_shm_input_report_isSet;
+
     SWGLocalOutputReport* local_output_report;
     bool m_local_output_report_isSet;
 
@@ -66,6 +66,8 @@ SWGDeviceSettings::SWGDeviceSettings() {
     m_lime_sdr_output_settings_isSet = false;
     local_input_settings = nullptr;
     m_local_input_settings_isSet = false;
+    shm_input_settings = nullptr;
+    m_shm_input_settings_isSet = false;
     local_output_settings = nullptr;
     m_local_output_settings_isSet = false;
     perseus_settings = nullptr;
@@ -138,6 +140,8 @@ SWGDeviceSettings::init() {
     m_lime_sdr_output_settings_isSet = false;
     local_input_settings = new SWGLocalInputSettings();
     m_local_input_settings_isSet = false;
+    shm_input_settings = new SWGShmInputSettings();
+    m_shm_input_settings_isSet = false;
     local_output_settings = new SWGLocalOutputSettings();
     m_local_output_settings_isSet = false;
     perseus_settings = new SWGPerseusSettings();
@@ -221,6 +225,9 @@ SWGDeviceSettings::cleanup() {
     if(local_input_settings != nullptr) { 
         delete local_input_settings;
     }
+    if(shm_input_settings != nullptr) { 
+        delete shm_input_settings;
+    }
     if(local_output_settings != nullptr) { 
         delete local_output_settings;
     }
@@ -311,6 +318,8 @@ SWGDeviceSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&local_input_settings, pJson["localInputSettings"], "SWGLocalInputSettings", "SWGLocalInputSettings");
     
+    ::SWGSDRangel::setValue(&shm_input_settings, pJson["shmInputSettings"], "SWGShmInputSettings", "SWGShmInputSettings");
+    
     ::SWGSDRangel::setValue(&local_output_settings, pJson["localOutputSettings"], "SWGLocalOutputSettings", "SWGLocalOutputSettings");
     
     ::SWGSDRangel::setValue(&perseus_settings, pJson["perseusSettings"], "SWGPerseusSettings", "SWGPerseusSettings");
@@ -410,6 +419,9 @@ SWGDeviceSettings::asJsonObject() {
     if((local_input_settings != nullptr) && (local_input_settings->isSet())){
         toJsonValue(QString("localInputSettings"), local_input_settings, obj, QString("SWGLocalInputSettings"));
     }
+    if((shm_input_settings != nullptr) && (shm_input_settings->isSet())){
+        toJsonValue(QString("shmInputSettings"), shm_input_settings, obj, QString("SWGShmInputSettings"));
+    }
     if((local_output_settings != nullptr) && (local_output_settings->isSet())){
         toJsonValue(QString("localOutputSettings"), local_output_settings, obj, QString("SWGLocalOutputSettings"));
     }
@@ -643,6 +655,16 @@ SWGDeviceSettings::setLocalInputSettings(SWGLocalInputSettings* local_input_sett
     this->m_local_input_settings_isSet = true;
 }
 
+SWGShmInputSettings*
+SWGDeviceSettings::getShmInputSettings() {
+    return shm_input_settings;
+}
+void
+SWGDeviceSettings::setShmInputSettings(SWGShmInputSettings* shm_input_settings) {
+    this->shm_input_settings = shm_input_settings;
+    this->m_shm_input_settings_isSet = true;
+}
+
 SWGLocalOutputSettings*
 SWGDeviceSettings::getLocalOutputSettings() {
     return local_output_settings;
@@ -835,6 +857,9 @@ SWGDeviceSettings::isSet(){
         if(local_input_settings && local_input_settings->isSet()){
             isObjectUpdated = true; break;
         }
+        if(shm_input_settings && shm_input_settings->isSet()){
+            isObjectUpdated = true; break;
+        }
         if(local_output_settings && local_output_settings->isSet()){
             isObjectUpdated = true; break;
         }
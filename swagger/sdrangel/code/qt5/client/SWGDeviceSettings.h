@@ -38,6 +38,7 @@
 #include "SWGLimeSdrInputSettings.h"
 #include "SWGLimeSdrOutputSettings.h"
 #include "SWGLocalInputSettings.h"
+#include "SWGShmInputSettings.h"
 #include "SWGLocalOutputSettings.h"
 #include "SWGPerseusSettings.h"
 #include "SWGPlutoSdrInputSettings.h"
@@ -128,6 +129,9 @@ public:
     SWGLocalInputSettings* getLocalInputSettings();
     void setLocalInputSettings(SWGLocalInputSettings* local_input_settings);
 
+    SWGShmInputSettings* getShmInputSettings();
+    void setShmInputSettings(SWGShmInputSettings* shm_input_settings);
+
     SWGLocalOutputSettings* getLocalOutputSettings();
     void setLocalOutputSettings(SWGLocalOutputSettings* local_output_settings);
 
@@ -228,6 +232,9 @@ private:
     SWGLocalInputSettings* local_input_settings;
     bool m_local_input_settings_isSet;
 
+    SWGShmInputSettings* shm_input_settings;
+    bool m_shm_input_settings_isSet;
+
     SWGLocalOutputSettings* local_output_settings;
     bool m_local_output_settings_isSet;
 
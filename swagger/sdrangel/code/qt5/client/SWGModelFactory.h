@@ -105,6 +105,7 @@
 #include "SWGLimeSdrInputSettings.h"
 #include "SWGLimeSdrOutputReport.h"
 #include "SWGLimeSdrOutputSettings.h"
+#include "SWGLoRaDemodReport.h"
 #include "SWGLocalInputReport.h"
 #include "SWGLocalInputSettings.h"
 #include "SWGLocalOutputReport.h"
@@ -137,6 +138,7 @@
 #include "SWGPresetItem.h"
 #include "SWGPresetTransfer.h"
 #include "SWGPresets.h"
+#include "SWGRDSMonitorSettings.h"
 #include "SWGRDSReport.h"
 #include "SWGRDSReport_altFrequencies.h"
 #include "SWGRange.h"
@@ -158,6 +160,9 @@
 #include "SWGSSBModSettings.h"
 #include "SWGSampleRate.h"
 #include "SWGSamplingDevice.h"
+#include "SWGShmInputReport.h"
+#include "SWGShmInputSettings.h"
+#include "SWGShmSinkSettings.h"
 #include "SWGSoapySDRFrequencySetting.h"
 #include "SWGSoapySDRGainSetting.h"
 #include "SWGSoapySDRInputSettings.h"
@@ -456,6 +461,9 @@ namespace SWGSDRangel {
     if(QString("SWGLimeSdrOutputSettings").compare(type) == 0) {
       return new SWGLimeSdrOutputSettings();
     }
+    if(QString("SWGLoRaDemodReport").compare(type) == 0) {
+      return new SWGLoRaDemodReport();
+    }
     if(QString("SWGLocalInputReport").compare(type) == 0) {
       return new SWGLocalInputReport();
     }
@@ -552,6 +560,9 @@ namespace SWGSDRangel {
     if(QString("SWGPresets").compare(type) == 0) {
       return new SWGPresets();
     }
+    if(QString("SWGRDSMonitorSettings").compare(type) == 0) {
+      return new SWGRDSMonitorSettings();
+    }
     if(QString("SWGRDSReport").compare(type) == 0) {
       return new SWGRDSReport();
     }
@@ -615,6 +626,15 @@ namespace SWGSDRangel {
     if(QString("SWGSamplingDevice").compare(type) == 0) {
       return new SWGSamplingDevice();
     }
+    if(QString("SWGShmInputReport").compare(type) == 0) {
+      return new SWGShmInputReport();
+    }
+    if(QString("SWGShmInputSettings").compare(type) == 0) {
+      return new SWGShmInputSettings();
+    }
+    if(QString("SWGShmSinkSettings").compare(type) == 0) {
+      return new SWGShmSinkSettings();
+    }
     if(QString("SWGSoapySDRFrequencySetting").compare(type) == 0) {
       return new SWGSoapySDRFrequencySetting();
     }
@@ -0,0 +1,200 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.15.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGShmInputReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGShmInputReport::SWGShmInputReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGShmInputReport::SWGShmInputReport() {
+    center_frequency = 0L;
+    m_center_frequency_isSet = false;
+    sample_rate = 0;
+    m_sample_rate_isSet = false;
+    connected = 0;
+    m_connected_isSet = false;
+    latency = 0.0f;
+    m_latency_isSet = false;
+    dropped_samples = 0L;
+    m_dropped_samples_isSet = false;
+}
+
+SWGShmInputReport::~SWGShmInputReport() {
+    this->cleanup();
+}
+
+void
+SWGShmInputReport::init() {
+    center_frequency = 0L;
+    m_center_frequency_isSet = false;
+    sample_rate = 0;
+    m_sample_rate_isSet = false;
+    connected = 0;
+    m_connected_isSet = false;
+    latency = 0.0f;
+    m_latency_isSet = false;
+    dropped_samples = 0L;
+    m_dropped_samples_isSet = false;
+}
+
+void
+SWGShmInputReport::cleanup() {
+
+
+
+
+
+}
+
+SWGShmInputReport*
+SWGShmInputReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGShmInputReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&center_frequency, pJson["centerFrequency"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&sample_rate, pJson["sampleRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&connected, pJson["connected"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&latency, pJson["latency"], "float", "");
+    
+    ::SWGSDRangel::setValue(&dropped_samples, pJson["droppedSamples"], "qint64", "");
+    
+}
+
+QString
+SWGShmInputReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGShmInputReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_center_frequency_isSet){
+        obj->insert("centerFrequency", QJsonValue(center_frequency));
+    }
+    if(m_sample_rate_isSet){
+        obj->insert("sampleRate", QJsonValue(sample_rate));
+    }
+    if(m_connected_isSet){
+        obj->insert("connected", QJsonValue(connected));
+    }
+    if(m_latency_isSet){
+        obj->insert("latency", QJsonValue(latency));
+    }
+    if(m_dropped_samples_isSet){
+        obj->insert("droppedSamples", QJsonValue(dropped_samples));
+    }
+
+    return obj;
+}
+
+qint64
+SWGShmInputReport::getCenterFrequency() {
+    return center_frequency;
+}
+void
+SWGShmInputReport::setCenterFrequency(qint64 center_frequency) {
+    this->center_frequency = center_frequency;
+    this->m_center_frequency_isSet = true;
+}
+
+qint32
+SWGShmInputReport::getSampleRate() {
+    return sample_rate;
+}
+void
+SWGShmInputReport::setSampleRate(qint32 sample_rate) {
+    this->sample_rate = sample_rate;
+    this->m_sample_rate_isSet = true;
+}
+
+qint32
+SWGShmInputReport::getConnected() {
+    return connected;
+}
+void
+SWGShmInputReport::setConnected(qint32 connected) {
+    this->connected = connected;
+    this->m_connected_isSet = true;
+}
+
+float
+SWGShmInputReport::getLatency() {
+    return latency;
+}
+void
+SWGShmInputReport::setLatency(float latency) {
+    this->latency = latency;
+    this->m_latency_isSet = true;
+}
+
+qint64
+SWGShmInputReport::getDroppedSamples() {
+    return dropped_samples;
+}
+void
+SWGShmInputReport::setDroppedSamples(qint64 dropped_samples) {
+    this->dropped_samples = dropped_samples;
+    this->m_dropped_samples_isSet = true;
+}
+
+
+bool
+SWGShmInputReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_center_frequency_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_sample_rate_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_connected_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_latency_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_dropped_samples_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+